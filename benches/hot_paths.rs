@@ -0,0 +1,315 @@
+//! Benchmarks for load, serialize, walk, query and edit hot paths.
+//!
+//! Mirrors `shim/bench/otio_shim_bench.cpp` through the safe API, so the two
+//! together show how much of a regression is FFI overhead. Builds synthetic
+//! timelines of each size and prints latency percentiles, throughput and
+//! peak RSS per operation.
+//!
+//! ```text
+//! cargo bench --bench hot_paths -- 1000 10000 100000
+//! ```
+
+use otio_rs::{Clip, Composable, ExternalReference, HasMetadata, RationalTime, Stack, TimeRange, Timeline, Track};
+use std::time::Instant;
+
+const TRACKS: usize = 2;
+const METADATA_KEYS: usize = 8;
+const NEST_EVERY: usize = 100;
+const SAMPLES: usize = 10;
+const CALLS: usize = 1000;
+
+fn frames(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+/// Peak resident set size in KiB, where the platform reports it.
+fn peak_rss_kib() -> Option<u64> {
+    let status = std::fs::read_to_string("/proc/self/status").ok()?;
+    let line = status.lines().find(|line| line.starts_with("VmHWM:"))?;
+    line.split_whitespace().nth(1)?.parse().ok()
+}
+
+/// Time `samples` runs of `body`, in nanoseconds per run.
+#[allow(clippy::cast_precision_loss)]
+fn measure(samples: usize, mut body: impl FnMut()) -> Vec<f64> {
+    (0..samples)
+        .map(|_| {
+            let start = Instant::now();
+            body();
+            start.elapsed().as_nanos() as f64
+        })
+        .collect()
+}
+
+fn duration(ns: f64) -> String {
+    if ns < 1e3 {
+        format!("{ns:.0} ns")
+    } else if ns < 1e6 {
+        format!("{:.2} us", ns / 1e3)
+    } else if ns < 1e9 {
+        format!("{:.2} ms", ns / 1e6)
+    } else {
+        format!("{:.2} s", ns / 1e9)
+    }
+}
+
+/// Print percentiles and throughput; `items` is the work done per sample.
+#[allow(
+    clippy::cast_possible_truncation,
+    clippy::cast_precision_loss,
+    clippy::cast_sign_loss
+)]
+fn report(name: &str, mut ns: Vec<f64>, items: f64) {
+    ns.sort_by(f64::total_cmp);
+    let pct = |p: f64| ns[(p * (ns.len() - 1) as f64).round() as usize];
+    let total: f64 = ns.iter().sum();
+    let per_sec = if total > 0.0 { items * ns.len() as f64 * 1e9 / total } else { 0.0 };
+    println!(
+        "{name:<22} {:>8} {:>12} {:>12} {:>12} {:>14.0}/s",
+        ns.len(),
+        duration(pct(0.5)),
+        duration(pct(0.9)),
+        duration(pct(0.99)),
+        per_sec
+    );
+}
+
+/// Deterministic index stream so runs are comparable.
+struct Lcg(u64);
+
+impl Lcg {
+    #[allow(clippy::cast_possible_truncation)]
+    fn below(&mut self, bound: usize) -> usize {
+        self.0 = self.0.wrapping_mul(6_364_136_223_846_793_005).wrapping_add(1_442_695_040_888_963_407);
+        ((self.0 >> 33) % bound as u64) as usize
+    }
+}
+
+// ============================================================================
+// Synthetic timelines
+// ============================================================================
+
+#[allow(clippy::cast_precision_loss)]
+fn make_clip(index: usize) -> Clip {
+    let name = format!("shot_{index}");
+    let mut clip = Clip::new(&name, frames((index % 48) as f64, 48.0));
+    clip.set_media_reference(ExternalReference::new(&format!("/media/reel_{}/{name}.mov", index / 1000)))
+        .unwrap();
+    for k in 0..METADATA_KEYS {
+        clip.set_metadata(&format!("key_{k}"), &format!("value_{index}_{k}"));
+    }
+    clip
+}
+
+/// `clips` clips over [`TRACKS`] video tracks; every [`NEST_EVERY`]th child is
+/// a stack of two clips.
+fn build_timeline(clips: usize) -> (Timeline, Vec<Track>) {
+    let mut timeline = Timeline::new("bench");
+    let mut tracks: Vec<Track> = (0..TRACKS)
+        .map(|t| timeline.add_video_track(&format!("V{}", t + 1)))
+        .collect();
+    let mut made = 0;
+    let mut child = 0;
+    while made < clips {
+        let track = &mut tracks[child % TRACKS];
+        if child % NEST_EVERY == NEST_EVERY - 1 && clips - made >= 2 {
+            let mut stack = Stack::new("nested");
+            stack.append_clip(make_clip(made)).unwrap();
+            stack.append_clip(make_clip(made + 1)).unwrap();
+            track.append_stack(stack).unwrap();
+            made += 2;
+        } else {
+            track.append_clip(make_clip(made)).unwrap();
+            made += 1;
+        }
+        child += 1;
+    }
+    (timeline, tracks)
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+#[allow(
+    clippy::cast_possible_truncation,
+    clippy::cast_precision_loss,
+    clippy::cast_sign_loss,
+    clippy::too_many_lines
+)]
+fn run_size(clips: usize) {
+    println!("\n== {clips} clips, {TRACKS} tracks, {METADATA_KEYS} metadata keys, stack every {NEST_EVERY} children ==");
+    println!(
+        "{:<22} {:>8} {:>12} {:>12} {:>12} {:>16}",
+        "benchmark", "samples", "p50", "p90", "p99", "throughput"
+    );
+    let items = clips as f64;
+    let mut rng = Lcg(1234);
+
+    let mut built = None;
+    report("build", measure(1, || built = Some(build_timeline(clips))), items);
+    let (timeline, mut tracks) = built.unwrap();
+
+    report(
+        "to_json_string",
+        measure(SAMPLES, || {
+            timeline.to_json_string().unwrap();
+        }),
+        items,
+    );
+    let mut json = Vec::new();
+    report(
+        "to_json_into",
+        measure(SAMPLES, || timeline.to_json_into(&mut json, false).unwrap()),
+        items,
+    );
+    report(
+        "to_json_into compact",
+        measure(SAMPLES, || timeline.to_json_into(&mut json, true).unwrap()),
+        items,
+    );
+    drop(json);
+
+    let dir = tempfile::tempdir().unwrap();
+    let path = dir.path().join("bench.otio");
+    timeline.write_to_file(&path).unwrap();
+    report(
+        "read_from_file",
+        measure(SAMPLES, || {
+            Timeline::read_from_file(&path).unwrap();
+        }),
+        items,
+    );
+
+    let binary = timeline.to_binary().unwrap();
+    report(
+        "to_binary",
+        measure(SAMPLES, || {
+            timeline.to_binary().unwrap();
+        }),
+        items,
+    );
+    report(
+        "from_binary",
+        measure(SAMPLES, || {
+            Timeline::from_binary(&binary).unwrap();
+        }),
+        items,
+    );
+    drop(binary);
+
+    report(
+        "find_clips",
+        measure(SAMPLES, || assert_eq!(timeline.find_clips().count(), clips)),
+        items,
+    );
+    let mut found = Vec::new();
+    report(
+        "find_clips_into",
+        measure(SAMPLES, || {
+            timeline.find_clips_into(&mut found).unwrap();
+            assert_eq!(found.len(), clips);
+        }),
+        items,
+    );
+    drop(found);
+
+    let children: usize = tracks.iter().map(Track::children_count).sum();
+    report(
+        "child_iteration",
+        measure(SAMPLES, || {
+            let walked: usize = tracks.iter().map(|track| track.children().count()).sum();
+            assert_eq!(walked, children);
+        }),
+        children as f64,
+    );
+
+    // Queries; indices are picked up front so only the call is timed
+    let first = &tracks[0];
+    let indices: Vec<usize> = (0..CALLS).map(|_| rng.below(first.children_count())).collect();
+    let mut next = indices.iter();
+    report(
+        "range_of_child_at_idx",
+        measure(CALLS, || {
+            first.range_of_child_at_index(*next.next().unwrap()).unwrap();
+        }),
+        1.0,
+    );
+
+    let stack = timeline.tracks();
+    let Some(Composable::Track(track_ref)) = stack.children().next() else {
+        unreachable!("the timeline has video tracks")
+    };
+    let direct: Vec<_> = track_ref
+        .children()
+        .filter_map(|child| match child {
+            Composable::Clip(clip) => Some(clip),
+            _ => None,
+        })
+        .collect();
+    let targets: Vec<_> = (0..CALLS).map(|_| &direct[rng.below(direct.len())]).collect();
+    let mut next = targets.iter();
+    report(
+        "transformed_time",
+        measure(CALLS, || {
+            next.next()
+                .unwrap()
+                .transformed_time_to_track(RationalTime::new(12.0, 24.0), &track_ref)
+                .unwrap();
+        }),
+        1.0,
+    );
+    drop(targets);
+    drop(direct);
+
+    // Edits run last since they change the timeline
+    let track = &mut tracks[0];
+    let mut edit = |name: &str, op: &mut dyn FnMut(&mut Track, RationalTime)| {
+        let end = track.trimmed_range().unwrap().duration.value * 0.9;
+        let times: Vec<_> = (0..CALLS)
+            .map(|_| RationalTime::new(rng.below(end as usize) as f64, 24.0))
+            .collect();
+        let mut next = times.into_iter();
+        report(name, measure(CALLS, || op(track, next.next().unwrap())), 1.0);
+    };
+    edit("track_slice_at_time", &mut |track, time| track.slice_at_time(time, false).unwrap());
+    edit("track_insert_at_time", &mut |track, time| {
+        track.insert_at_time(Clip::new("insert", frames(0.0, 12.0)), time, false).unwrap();
+    });
+    edit("track_overwrite", &mut |track, time| {
+        let range = TimeRange::new(time, RationalTime::new(12.0, 24.0));
+        track.overwrite(Clip::new("overwrite", frames(0.0, 12.0)), range, false).unwrap();
+    });
+    edit("track_remove_at_time", &mut |track, time| track.remove_at_time(time, true).unwrap());
+
+    // Teardown as the caller sees it: inline, then handed to the reaper
+    drop(tracks);
+    let mut owned = Some(timeline);
+    report("drop", measure(1, || drop(owned.take())), items);
+    let (mut timeline, tracks) = build_timeline(clips);
+    drop(tracks);
+    timeline.set_background_release(true);
+    let mut owned = Some(timeline);
+    report("drop background", measure(1, || drop(owned.take())), items);
+    Timeline::wait_for_background_releases();
+
+    if let Some(kib) = peak_rss_kib() {
+        println!("{:<22} {kib} KiB", "peak RSS");
+    }
+}
+
+fn main() {
+    // `cargo bench` passes its own flags (e.g. `--bench`); sizes are the
+    // plain numeric arguments
+    let mut sizes: Vec<usize> = std::env::args().skip(1).filter_map(|arg| arg.parse().ok()).collect();
+    if sizes.is_empty() {
+        sizes = vec![1000, 10_000, 100_000];
+    }
+    for clips in sizes {
+        run_size(clips);
+    }
+}
@@ -23,9 +23,10 @@ fn main() {
 #[cfg(feature = "vendored")]
 fn build_vendored(out_dir: &Path, manifest_dir: &Path) {
     // Build OTIO + shim via CMake
-    let dst = cmake::Config::new(manifest_dir.join("shim"))
-        .define("CMAKE_BUILD_TYPE", "Release")
-        .build();
+    let mut cmake_config = cmake::Config::new(manifest_dir.join("shim"));
+    cmake_config.define("CMAKE_BUILD_TYPE", "Release");
+    configure_features(&mut cmake_config);
+    let dst = cmake_config.build();
 
     // Link paths
     println!("cargo:rustc-link-search=native={}/lib", dst.display());
@@ -36,6 +37,8 @@ fn build_vendored(out_dir: &Path, manifest_dir: &Path) {
     println!("cargo:rustc-link-lib=static=opentimelineio");
     println!("cargo:rustc-link-lib=static=opentime");
 
+    link_features();
+
     // C++ stdlib (platform-specific)
     link_cpp_stdlib();
 
@@ -57,6 +60,7 @@ fn build_system(out_dir: &Path, manifest_dir: &Path) {
     let mut cmake_config = cmake::Config::new(manifest_dir.join("shim"));
     cmake_config.define("CMAKE_BUILD_TYPE", "Release");
     cmake_config.define("USE_SYSTEM_OTIO", "ON");
+    configure_features(&mut cmake_config);
 
     // Pass OTIO include paths to CMake
     let include_paths: Vec<_> = otio.include_paths.iter()
@@ -88,12 +92,31 @@ fn build_system(out_dir: &Path, manifest_dir: &Path) {
         println!("cargo:rustc-link-lib={}", lib);
     }
 
+    link_features();
+
     // C++ stdlib (platform-specific)
     link_cpp_stdlib();
 
     let _ = out_dir; // suppress unused warning
 }
 
+/// Pass optional shim features to CMake.
+fn configure_features(cmake_config: &mut cmake::Config) {
+    if cfg!(feature = "gzip") {
+        cmake_config.define("OTIO_SHIM_WITH_ZLIB", "ON");
+    }
+    if cfg!(feature = "stats") {
+        cmake_config.define("OTIO_SHIM_WITH_STATS", "ON");
+    }
+}
+
+/// Link what the optional features need; after the shim, which uses them.
+fn link_features() {
+    if cfg!(feature = "gzip") {
+        println!("cargo:rustc-link-lib=z");
+    }
+}
+
 fn link_cpp_stdlib() {
     #[cfg(target_os = "macos")]
     println!("cargo:rustc-link-lib=c++");
@@ -0,0 +1,75 @@
+//! Benchmark for concurrent batch loading.
+//!
+//! Writes a set of synthetic timelines (or uses the `.otio` files in the
+//! directory given as the first argument) and loads them with increasing
+//! thread counts, printing throughput and speedup over one thread.
+//!
+//! ```text
+//! cargo run --release --example parallel_load [DIR] [FILE_COUNT]
+//! ```
+
+use otio_rs::{Clip, ExternalReference, RationalTime, TimeRange, Timeline};
+use std::path::{Path, PathBuf};
+use std::time::Instant;
+
+fn write_synthetic(dir: &Path, count: usize) -> otio_rs::Result<Vec<PathBuf>> {
+    let mut paths = Vec::with_capacity(count);
+    for i in 0..count {
+        let mut timeline = Timeline::new(&format!("Synthetic {i}"));
+        let mut track = timeline.add_video_track("V1");
+        for c in 0..200 {
+            let mut clip = Clip::new(
+                &format!("shot_{c:04}"),
+                TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+            );
+            clip.set_media_reference(ExternalReference::new(&format!("/media/shot_{c:04}.mov")))?;
+            track.append_clip(clip)?;
+        }
+        let path = dir.join(format!("synthetic_{i}.otio"));
+        timeline.write_to_file(&path)?;
+        paths.push(path);
+    }
+    Ok(paths)
+}
+
+fn main() -> otio_rs::Result<()> {
+    let mut args = std::env::args().skip(1);
+    let paths = if let Some(dir) = args.next() {
+        std::fs::read_dir(&dir)
+            .expect("cannot read directory")
+            .filter_map(|entry| entry.ok().map(|e| e.path()))
+            .filter(|path| path.extension().is_some_and(|ext| ext == "otio"))
+            .collect()
+    } else {
+        let count = args.next().and_then(|n| n.parse().ok()).unwrap_or(256);
+        let dir = std::env::temp_dir().join("otio_parallel_load");
+        std::fs::create_dir_all(&dir).expect("cannot create temp directory");
+        write_synthetic(&dir, count)?
+    };
+    println!("Loading {} files", paths.len());
+
+    let max_threads = std::thread::available_parallelism().map_or(1, std::num::NonZeroUsize::get);
+    let mut thread_counts = vec![1];
+    while thread_counts.last().unwrap() * 2 <= max_threads {
+        thread_counts.push(thread_counts.last().unwrap() * 2);
+    }
+    if *thread_counts.last().unwrap() != max_threads {
+        thread_counts.push(max_threads);
+    }
+
+    let mut baseline = None;
+    for threads in thread_counts {
+        let start = Instant::now();
+        let results = Timeline::read_from_files(&paths, threads);
+        let elapsed = start.elapsed().as_secs_f64();
+        let failures = results.iter().filter(|r| r.is_err()).count();
+        let base = *baseline.get_or_insert(elapsed);
+        #[allow(clippy::cast_precision_loss)]
+        let files_per_sec = paths.len() as f64 / elapsed;
+        println!(
+            "{threads:>3} threads: {elapsed:>8.3}s  {files_per_sec:>9.1} files/s  speedup {:>5.2}x  failures {failures}",
+            base / elapsed
+        );
+    }
+    Ok(())
+}
@@ -0,0 +1,670 @@
+// Benchmarks for the shim's hot paths: load, serialize, walk, query and edit.
+//
+// Builds synthetic timelines of increasing size and reports latency
+// percentiles, throughput and peak RSS for each operation, so regressions
+// show up when OTIO or the shim changes. Uses only the public C API.
+//
+//   cmake -S shim -B build -DOTIO_SHIM_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build --target otio_shim_bench
+//   ./build/otio_shim_bench --sizes 1000,10000,100000,1000000 --csv
+
+#include "otio_shim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// ============================================================================
+// Options
+// ============================================================================
+
+struct Options {
+    std::vector<long> sizes{1000, 10000, 100000};
+    int tracks = 2;
+    int metadata_keys = 8;
+    // Every nth child of a track is a nested stack holding two clips
+    int nest_every = 100;
+    // Samples for whole-timeline operations (load, serialize, walk)
+    int samples = 10;
+    // Calls for per-item operations (range queries, transforms, edits)
+    int calls = 1000;
+    bool csv = false;
+};
+
+[[noreturn]] void usage(const char* argv0) {
+    std::fprintf(stderr,
+        "usage: %s [--sizes N,N,...] [--tracks N] [--metadata N] [--nest-every N]\n"
+        "          [--samples N] [--calls N] [--csv]\n",
+        argv0);
+    std::exit(2);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> long {
+            if (i + 1 >= argc) usage(argv[0]);
+            return std::strtol(argv[++i], nullptr, 10);
+        };
+        if (arg == "--sizes") {
+            if (i + 1 >= argc) usage(argv[0]);
+            opts.sizes.clear();
+            for (const char* p = argv[++i]; *p;) {
+                char* end = nullptr;
+                long n = std::strtol(p, &end, 10);
+                if (end == p || n <= 0) usage(argv[0]);
+                opts.sizes.push_back(n);
+                p = *end == ',' ? end + 1 : end;
+            }
+        } else if (arg == "--tracks") {
+            opts.tracks = static_cast<int>(value());
+        } else if (arg == "--metadata") {
+            opts.metadata_keys = static_cast<int>(value());
+        } else if (arg == "--nest-every") {
+            opts.nest_every = static_cast<int>(value());
+        } else if (arg == "--samples") {
+            opts.samples = static_cast<int>(value());
+        } else if (arg == "--calls") {
+            opts.calls = static_cast<int>(value());
+        } else if (arg == "--csv") {
+            opts.csv = true;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (opts.tracks < 1 || opts.samples < 1 || opts.calls < 1 || opts.metadata_keys < 0) {
+        usage(argv[0]);
+    }
+    return opts;
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+// Peak resident set size of the process in KiB, or 0 if unavailable
+long peak_rss_kib() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return usage.ru_maxrss;  // KiB on Linux and the BSDs
+#endif
+#endif
+}
+
+void fail(const char* what, const OtioError& err) {
+    std::fprintf(stderr, "otio_shim_bench: %s failed: %s\n", what, err.message);
+    std::exit(1);
+}
+
+struct Reporter {
+    bool csv;
+    long size = 0;
+
+    void header() const {
+        if (csv) {
+            std::printf("clips,benchmark,samples,p50_ns,p90_ns,p99_ns,items_per_sec,peak_rss_kib\n");
+        }
+    }
+
+    void begin_size(long clips, const Options& opts) {
+        size = clips;
+        if (!csv) {
+            std::printf("\n== %ld clips, %d tracks, %d metadata keys, stack every %d children ==\n",
+                clips, opts.tracks, opts.metadata_keys, opts.nest_every);
+            std::printf("%-22s %8s %12s %12s %12s %14s\n",
+                "benchmark", "samples", "p50", "p90", "p99", "throughput");
+        }
+    }
+
+    // `items` is the number of items each sample processed
+    void report(const char* name, std::vector<double>& ns, double items) const {
+        std::sort(ns.begin(), ns.end());
+        auto pct = [&](double p) {
+            size_t i = static_cast<size_t>(p * static_cast<double>(ns.size() - 1) + 0.5);
+            return ns[i];
+        };
+        double total = 0;
+        for (double v : ns) total += v;
+        double per_sec = total > 0 ? items * static_cast<double>(ns.size()) * 1e9 / total : 0;
+        if (csv) {
+            std::printf("%ld,%s,%zu,%.0f,%.0f,%.0f,%.1f,%ld\n",
+                size, name, ns.size(), pct(0.5), pct(0.9), pct(0.99), per_sec, peak_rss_kib());
+        } else {
+            std::printf("%-22s %8zu %12s %12s %12s %12s/s\n",
+                name, ns.size(), duration(pct(0.5)).c_str(), duration(pct(0.9)).c_str(),
+                duration(pct(0.99)).c_str(), count(per_sec).c_str());
+        }
+        std::fflush(stdout);
+    }
+
+    void end_size() const {
+        if (!csv) std::printf("%-22s %ld KiB\n", "peak RSS", peak_rss_kib());
+    }
+
+    static std::string duration(double ns) {
+        char buf[32];
+        if (ns < 1e3) std::snprintf(buf, sizeof(buf), "%.0f ns", ns);
+        else if (ns < 1e6) std::snprintf(buf, sizeof(buf), "%.2f us", ns / 1e3);
+        else if (ns < 1e9) std::snprintf(buf, sizeof(buf), "%.2f ms", ns / 1e6);
+        else std::snprintf(buf, sizeof(buf), "%.2f s", ns / 1e9);
+        return buf;
+    }
+
+    static std::string count(double n) {
+        char buf[32];
+        if (n < 1e3) std::snprintf(buf, sizeof(buf), "%.1f", n);
+        else if (n < 1e6) std::snprintf(buf, sizeof(buf), "%.1fk", n / 1e3);
+        else std::snprintf(buf, sizeof(buf), "%.1fM", n / 1e6);
+        return buf;
+    }
+};
+
+// Time `samples` runs of `body`, returning nanoseconds per run
+std::vector<double> measure(int samples, const std::function<void()>& body) {
+    std::vector<double> ns;
+    ns.reserve(static_cast<size_t>(samples));
+    for (int i = 0; i < samples; ++i) {
+        auto start = Clock::now();
+        body();
+        ns.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+    return ns;
+}
+
+// ============================================================================
+// Synthetic timelines
+// ============================================================================
+
+OtioTimeRange frames(double start, double duration) {
+    return OtioTimeRange{{start, 24.0}, {duration, 24.0}};
+}
+
+OtioClip* make_clip(long index, int metadata_keys) {
+    std::string name = "shot_" + std::to_string(index);
+    OtioClip* clip = otio_clip_create(name.c_str(), frames(static_cast<double>(index % 48), 48.0));
+    std::string url = "/media/reel_" + std::to_string(index / 1000) + "/" + name + ".mov";
+    OtioError err = {0, {0}};
+    if (otio_clip_set_media_reference(clip, otio_external_ref_create(url.c_str()), &err) != 0) {
+        fail("otio_clip_set_media_reference", err);
+    }
+    for (int k = 0; k < metadata_keys; ++k) {
+        std::string key = "key_" + std::to_string(k);
+        std::string value = "value_" + std::to_string(index) + "_" + std::to_string(k);
+        otio_clip_set_metadata_string(clip, key.c_str(), value.c_str());
+    }
+    return clip;
+}
+
+// `clips` clips spread over `opts.tracks` video tracks; every
+// `opts.nest_every`th child is a stack of two clips instead of a clip
+OtioTimeline* build_timeline(long clips, const Options& opts) {
+    OtioTimeline* tl = otio_timeline_create("bench");
+    std::vector<OtioTrack*> tracks;
+    for (int t = 0; t < opts.tracks; ++t) {
+        std::string name = "V" + std::to_string(t + 1);
+        tracks.push_back(otio_timeline_add_video_track(tl, name.c_str()));
+    }
+    OtioError err = {0, {0}};
+    long made = 0;
+    for (long child = 0; made < clips; ++child) {
+        OtioTrack* track = tracks[static_cast<size_t>(child % opts.tracks)];
+        if (opts.nest_every > 0 && child % opts.nest_every == opts.nest_every - 1 && clips - made >= 2) {
+            OtioStack* stack = otio_stack_create("nested");
+            for (int n = 0; n < 2; ++n) {
+                if (otio_stack_append_clip(stack, make_clip(made++, opts.metadata_keys), &err) != 0) {
+                    fail("otio_stack_append_clip", err);
+                }
+            }
+            if (otio_track_append_stack(track, stack, &err) != 0) fail("otio_track_append_stack", err);
+        } else if (otio_track_append_clip(track, make_clip(made++, opts.metadata_keys), &err) != 0) {
+            fail("otio_track_append_clip", err);
+        }
+    }
+    return tl;
+}
+
+OtioTrack* track_at(OtioTimeline* tl, int index) {
+    return static_cast<OtioTrack*>(otio_stack_child_at(otio_timeline_get_tracks(tl), index));
+}
+
+// Direct clip children of a track, for per-item benchmarks
+std::vector<OtioClip*> direct_clips(OtioTrack* track) {
+    std::vector<OtioClip*> clips;
+    int32_t count = otio_track_children_count(track);
+    for (int32_t i = 0; i < count; ++i) {
+        if (otio_track_child_type(track, i) == OTIO_CHILD_TYPE_CLIP) {
+            clips.push_back(static_cast<OtioClip*>(otio_track_child_at(track, i)));
+        }
+    }
+    return clips;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+void run_size(long clips, const Options& opts, Reporter& out) {
+    out.begin_size(clips, opts);
+    OtioError err = {0, {0}};
+    std::mt19937 rng(1234);
+    const double items = static_cast<double>(clips);
+
+    OtioTimeline* tl = nullptr;
+    {
+        auto ns = measure(1, [&] { tl = build_timeline(clips, opts); });
+        out.report("build", ns, items);
+    }
+
+    // Serialization
+    {
+        auto ns = measure(opts.samples, [&] {
+            char* json = otio_timeline_to_json_string(tl, &err);
+            if (!json) fail("otio_timeline_to_json_string", err);
+            otio_free_string(json);
+        });
+        out.report("to_json_string", ns, items);
+    }
+    {
+        // One buffer for every sample, as a server reusing it across
+        // responses would
+        std::string json;
+        auto append = [](void* user_data, const char* data, size_t len) -> int32_t {
+            static_cast<std::string*>(user_data)->append(data, len);
+            return 0;
+        };
+        for (int32_t flags : {0, OTIO_JSON_COMPACT}) {
+            auto ns = measure(opts.samples, [&] {
+                json.clear();
+                if (otio_timeline_write_json(tl, flags, append, &json, &err) != 0) {
+                    fail("otio_timeline_write_json", err);
+                }
+            });
+            out.report(flags ? "write_json compact" : "write_json", ns, items);
+        }
+    }
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("otio_shim_bench_" + std::to_string(clips) + ".otio");
+    if (otio_timeline_write_to_file(tl, path.string().c_str(), &err) != 0) {
+        fail("otio_timeline_write_to_file", err);
+    }
+    {
+        auto ns = measure(opts.samples, [&] {
+            OtioTimeline* loaded = otio_timeline_read_from_file(path.string().c_str(), &err);
+            if (!loaded) fail("otio_timeline_read_from_file", err);
+            otio_timeline_free(loaded);
+        });
+        out.report("read_from_file", ns, items);
+    }
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    size_t binary_len = 0;
+    uint8_t* binary = otio_timeline_to_binary(tl, nullptr, nullptr, 0, &binary_len, &err);
+    if (!binary) fail("otio_timeline_to_binary", err);
+    {
+        auto ns = measure(opts.samples, [&] {
+            size_t len = 0;
+            uint8_t* bytes = otio_timeline_to_binary(tl, nullptr, nullptr, 0, &len, &err);
+            if (!bytes) fail("otio_timeline_to_binary", err);
+            otio_free_bytes(bytes);
+        });
+        out.report("to_binary", ns, items);
+    }
+    {
+        auto ns = measure(opts.samples, [&] {
+            OtioTimeline* loaded = otio_timeline_from_binary(binary, binary_len, &err);
+            if (!loaded) fail("otio_timeline_from_binary", err);
+            otio_timeline_free(loaded);
+        });
+        out.report("from_binary", ns, items);
+    }
+    otio_free_bytes(binary);
+
+    // In-memory forks, next to the serialize-and-parse they replace
+    for (int32_t mode : {OTIO_CLONE_DEEP, OTIO_CLONE_SHARED}) {
+        auto ns = measure(opts.samples, [&] {
+            OtioTimeline* copy = otio_timeline_clone(tl, mode, &err);
+            if (!copy) fail("otio_timeline_clone", err);
+            otio_timeline_free(copy);
+        });
+        out.report(mode == OTIO_CLONE_SHARED ? "clone_shared" : "clone_deep", ns, items);
+    }
+    {
+        // Revisions compared on the object graph: unchanged, then with one
+        // clip's metadata edited in the middle of the cut
+        OtioTimeline* revision = otio_timeline_clone(tl, OTIO_CLONE_DEEP, &err);
+        if (!revision) fail("otio_timeline_clone", err);
+        auto diff_row = [&](const char* name) {
+            auto ns = measure(opts.samples, [&] {
+                OtioTimelineDiff* diff = otio_timeline_diff(tl, revision, &err);
+                if (!diff) fail("otio_timeline_diff", err);
+                otio_timeline_diff_free(diff);
+            });
+            out.report(name, ns, items);
+        };
+        diff_row("diff_identical");
+        std::vector<OtioClip*> found(static_cast<size_t>(clips));
+        int32_t total = otio_timeline_find_clips_into(revision, found.data(),
+            static_cast<int32_t>(found.size()), &err);
+        if (total > 0) {
+            otio_clip_set_metadata_string(found[static_cast<size_t>(total / 2)], "status", "review");
+            diff_row("diff_one_edit");
+        }
+        otio_timeline_free(revision);
+    }
+    {
+        // Content hashes: everything rehashed, then with the cache on and one
+        // clip edited before each sample
+        uint64_t fingerprint = 0;
+        auto ns = measure(opts.samples, [&] {
+            if (otio_object_fingerprint(tl, &fingerprint, &err) != 0) fail("otio_object_fingerprint", err);
+        });
+        out.report("fingerprint_cold", ns, items);
+
+        // Edited on a copy, so the rows below see the same timeline
+        OtioTimeline* edited_tl = otio_timeline_clone(tl, OTIO_CLONE_DEEP, &err);
+        if (!edited_tl) fail("otio_timeline_clone", err);
+        OtioFingerprintCache* cache = otio_timeline_enable_fingerprint_cache(edited_tl, &err);
+        if (!cache) fail("otio_timeline_enable_fingerprint_cache", err);
+        std::vector<OtioClip*> found(static_cast<size_t>(clips));
+        int32_t total = otio_timeline_find_clips_into(edited_tl, found.data(),
+            static_cast<int32_t>(found.size()), &err);
+        if (total > 0 && otio_object_fingerprint(edited_tl, &fingerprint, &err) == 0) {
+            OtioClip* edited = found[static_cast<size_t>(total / 2)];
+            int64_t revision = 0;
+            ns = measure(opts.samples, [&] {
+                otio_metadata_set_int64(edited, "revision", ++revision, &err);
+                if (otio_object_fingerprint(edited_tl, &fingerprint, &err) != 0) {
+                    fail("otio_object_fingerprint", err);
+                }
+            });
+            out.report("fingerprint_after_edit", ns, items);
+        }
+        otio_fingerprint_cache_free(cache);
+        otio_timeline_free(edited_tl);
+    }
+
+    // Walks
+    {
+        auto ns = measure(opts.samples, [&] {
+            OtioClipIterator* iter = otio_timeline_find_clips(tl);
+            long found = 0;
+            while (otio_clip_iterator_next(iter)) ++found;
+            otio_clip_iterator_free(iter);
+            if (found != clips) {
+                std::fprintf(stderr, "otio_shim_bench: find_clips found %ld of %ld\n", found, clips);
+                std::exit(1);
+            }
+        });
+        out.report("find_clips", ns, items);
+    }
+    {
+        std::vector<OtioClip*> found(static_cast<size_t>(clips));
+        auto ns = measure(opts.samples, [&] {
+            int32_t total = otio_timeline_find_clips_into(tl, found.data(),
+                static_cast<int32_t>(found.size()), &err);
+            if (total != clips) {
+                std::fprintf(stderr, "otio_shim_bench: find_clips_into found %d of %ld\n", total, clips);
+                std::exit(1);
+            }
+        });
+        out.report("find_clips_into", ns, items);
+    }
+    {
+        long children = 0;
+        auto ns = measure(opts.samples, [&] {
+            children = 0;
+            for (int t = 0; t < opts.tracks; ++t) {
+                OtioTrack* track = track_at(tl, t);
+                int32_t count = otio_track_children_count(track);
+                for (int32_t i = 0; i < count; ++i) {
+                    if (otio_track_child_type(track, i) >= 0 && otio_track_child_at(track, i)) ++children;
+                }
+            }
+        });
+        out.report("child_iteration", ns, static_cast<double>(children));
+    }
+
+    // Queries; indices and clips are picked up front so only the call is timed
+    OtioTrack* track = track_at(tl, 0);
+    int32_t child_count = otio_track_children_count(track);
+    {
+        std::uniform_int_distribution<int32_t> pick(0, child_count - 1);
+        std::vector<int32_t> indices(static_cast<size_t>(opts.calls));
+        for (auto& i : indices) i = pick(rng);
+        size_t next = 0;
+        auto ns = measure(opts.calls, [&] {
+            otio_track_range_of_child_at_index(track, indices[next++], &err);
+            if (err.code != 0) fail("otio_track_range_of_child_at_index", err);
+        });
+        out.report("range_of_child_at_idx", ns, 1);
+    }
+    std::vector<OtioClip*> clip_handles = direct_clips(track);
+    if (!clip_handles.empty()) {
+        std::uniform_int_distribution<size_t> pick(0, clip_handles.size() - 1);
+        std::vector<OtioClip*> targets(static_cast<size_t>(opts.calls));
+        for (auto& c : targets) c = clip_handles[pick(rng)];
+        size_t next = 0;
+        auto ns = measure(opts.calls, [&] {
+            otio_item_transformed_time(targets[next++], OTIO_CHILD_TYPE_CLIP, {12.0, 24.0},
+                track, OTIO_CHILD_TYPE_TRACK, &err);
+            if (err.code != 0) fail("otio_item_transformed_time", err);
+        });
+        out.report("transformed_time", ns, 1);
+    }
+    if (!clip_handles.empty()) {
+        // A render dispatcher's pattern: every frame of a clip, in one call
+        constexpr int32_t kFrames = 1000;
+        std::vector<OtioRationalTime> mapped(kFrames);
+        OtioClip* target = clip_handles.back();
+        auto ns = measure(opts.samples, [&] {
+            if (otio_item_transformed_frames(track, OTIO_CHILD_TYPE_TRACK, {0.0, 24.0}, kFrames,
+                    target, OTIO_CHILD_TYPE_CLIP, mapped.data(), &err) != 0) {
+                fail("otio_item_transformed_frames", err);
+            }
+        });
+        out.report("transformed_frames", ns, kFrames);
+    }
+    {
+        OtioTimeRange range = otio_track_trimmed_range(track, &err);
+        if (err.code != 0) fail("otio_track_trimmed_range", err);
+        auto ns = measure(opts.samples, [&] {
+            OtioRenderManifest* manifest = otio_track_build_render_manifest(track, range, &err);
+            if (!manifest) fail("otio_track_build_render_manifest", err);
+            otio_render_manifest_free(manifest);
+        });
+        out.report("render_manifest", ns, range.duration.value);
+    }
+    {
+        // Every track of the timeline, serially and on all cores
+        OtioStack* stack = otio_timeline_get_tracks(tl);
+        OtioTimeRange range = otio_track_trimmed_range(track, &err);
+        if (err.code != 0) fail("otio_track_trimmed_range", err);
+        auto build = [&](const char* name, int32_t threads) {
+            auto ns = measure(opts.samples, [&] {
+                OtioRenderManifest* manifest =
+                    otio_stack_build_render_manifest_parallel(stack, range, threads, &err);
+                if (!manifest) fail("otio_stack_build_render_manifest_parallel", err);
+                otio_render_manifest_free(manifest);
+            });
+            out.report(name, ns, range.duration.value);
+        };
+        build("stack_manifest", 1);
+        build("stack_manifest_parallel", 0);
+    }
+    {
+        // A frame-existence checker's pattern: every URL of a long sequence
+        constexpr int32_t kImages = 100000;
+        OtioImageSeqRef* seq = otio_image_seq_ref_create("/renders/", "shot_", ".exr", 1001, 1,
+            24.0, 4);
+        if (otio_image_seq_ref_set_available_range(seq, {{0.0, 24.0}, {kImages, 24.0}}, &err) != 0) {
+            fail("otio_image_seq_ref_set_available_range", err);
+        }
+        auto single = measure(opts.samples, [&] {
+            for (int32_t i = 0; i < kImages; ++i) {
+                char* url = otio_image_seq_ref_target_url_for_image_number(seq, i, &err);
+                if (!url) fail("otio_image_seq_ref_target_url_for_image_number", err);
+                otio_free_string(url);
+            }
+        });
+        out.report("image_urls_single", single, kImages);
+        std::vector<char> buffer;
+        std::vector<int64_t> offsets(kImages + 1);
+        auto batch = measure(opts.samples, [&] {
+            int64_t size = otio_image_seq_ref_target_urls(seq, 0, kImages,
+                buffer.data(), static_cast<int64_t>(buffer.size()), offsets.data(), &err);
+            if (size < 0) fail("otio_image_seq_ref_target_urls", err);
+            if (size > static_cast<int64_t>(buffer.size())) {
+                buffer.resize(static_cast<size_t>(size));
+                otio_image_seq_ref_target_urls(seq, 0, kImages, buffer.data(), size,
+                    offsets.data(), &err);
+            }
+        });
+        out.report("image_urls_batch", batch, kImages);
+        otio_image_seq_ref_free(seq);
+    }
+
+    // Edits run last since they change the timeline. Clip edits go first:
+    // they keep every handle alive, unlike the track edits that follow.
+    if (!clip_handles.empty()) {
+        std::uniform_int_distribution<size_t> pick(0, clip_handles.size() - 1);
+        auto clip_edit = [&](const char* name, const std::function<int(OtioClip*)>& edit) {
+            std::vector<OtioClip*> targets(static_cast<size_t>(opts.calls));
+            for (auto& c : targets) c = clip_handles[pick(rng)];
+            size_t next = 0;
+            auto ns = measure(opts.calls, [&] {
+                if (edit(targets[next++]) != 0) fail(name, err);
+            });
+            out.report(name, ns, 1);
+        };
+        clip_edit("clip_slip", [&](OtioClip* c) { return otio_clip_slip(c, {1.0, 24.0}, &err); });
+        // Alternate shortening and lengthening so clips keep their duration
+        int trims = 0;
+        clip_edit("clip_trim", [&](OtioClip* c) {
+            double delta = trims++ % 2 == 0 ? -1.0 : 1.0;
+            return otio_clip_trim(c, {0.0, 24.0}, {delta, 24.0}, &err);
+        });
+    }
+
+    auto track_edit = [&](const char* name, const std::function<int(OtioRationalTime)>& edit) {
+        OtioTimeRange duration = otio_track_trimmed_range(track, &err);
+        if (err.code != 0) fail("otio_track_trimmed_range", err);
+        // Stay clear of the end so the edit always lands inside the track
+        std::uniform_real_distribution<double> pick(0.0, duration.duration.value * 0.9);
+        std::vector<OtioRationalTime> times(static_cast<size_t>(opts.calls));
+        for (auto& t : times) t = {std::floor(pick(rng)), duration.duration.rate};
+        size_t next = 0;
+        auto ns = measure(opts.calls, [&] {
+            if (edit(times[next++]) != 0) fail(name, err);
+        });
+        out.report(name, ns, 1);
+    };
+    track_edit("track_slice_at_time", [&](OtioRationalTime t) {
+        return otio_track_slice_at_time(track, t, 0, &err);
+    });
+    // Clip construction is part of the timed call for insert and overwrite;
+    // it is small next to the edit itself
+    track_edit("track_insert_at_time", [&](OtioRationalTime t) {
+        return otio_track_insert_at_time(track, otio_clip_create("insert", frames(0, 12)), t, 0, &err);
+    });
+    track_edit("track_overwrite", [&](OtioRationalTime t) {
+        return otio_track_overwrite(track, otio_clip_create("overwrite", frames(0, 12)),
+            OtioTimeRange{t, {12.0, t.rate}}, 0, &err);
+    });
+    track_edit("track_remove_at_time", [&](OtioRationalTime t) {
+        return otio_track_remove_at_time(track, t, 1, &err);
+    });
+    {
+        // The same slices queued and committed as one batch
+        OtioTimeRange duration = otio_track_trimmed_range(track, &err);
+        std::uniform_real_distribution<double> pick(0.0, duration.duration.value * 0.9);
+        OtioTrackEdit* edit = otio_track_begin_edit(track, &err);
+        if (!edit) fail("otio_track_begin_edit", err);
+        for (int i = 0; i < opts.calls; ++i) {
+            otio_track_edit_slice_at_time(edit, {std::floor(pick(rng)), duration.duration.rate}, 0, &err);
+        }
+        auto ns = measure(1, [&] {
+            if (otio_track_edit_commit(edit, &err) != 0) fail("otio_track_edit_commit", err);
+        });
+        out.report("track_edit_commit", ns, opts.calls);
+        otio_track_edit_free(edit);
+    }
+    {
+        // Clip edits with a journal attached, then undone one step at a time
+        OtioUndoJournal* journal = otio_timeline_enable_undo(tl, opts.calls, &err);
+        if (!journal) fail("otio_timeline_enable_undo", err);
+        OtioClip* target = clip_handles.empty() ? nullptr : clip_handles.front();
+        if (target) {
+            auto ns = measure(opts.calls, [&] { otio_clip_set_metadata_string(target, "status", "review"); });
+            out.report("metadata_set_journaled", ns, 1);
+            ns = measure(opts.calls, [&] {
+                if (otio_undo_journal_undo(journal, &err) != 1) fail("otio_undo_journal_undo", err);
+            });
+            out.report("undo_metadata", ns, 1);
+        }
+        track_edit("track_slice_journaled", [&](OtioRationalTime t) {
+            return otio_track_slice_at_time(track, t, 0, &err);
+        });
+        auto ns = measure(opts.calls, [&] {
+            if (otio_undo_journal_undo(journal, &err) != 1) fail("otio_undo_journal_undo", err);
+        });
+        out.report("undo_slice", ns, 1);
+        otio_undo_journal_free(journal);
+    }
+
+    // Teardown as the caller sees it: inline, then handed to the reaper
+    {
+        auto ns = measure(1, [&] { otio_timeline_free(tl); });
+        out.report("free", ns, items);
+    }
+    tl = build_timeline(clips, opts);
+    otio_timeline_set_background_release(tl, 1);
+    {
+        auto ns = measure(1, [&] { otio_timeline_free(tl); });
+        out.report("free background", ns, items);
+    }
+    otio_wait_for_background_releases();
+    out.end_size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opts = parse_options(argc, argv);
+    Reporter out{opts.csv};
+    out.header();
+    for (long clips : opts.sizes) {
+        run_size(clips, opts, out);
+    }
+    return 0;
+}
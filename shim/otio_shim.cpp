@@ -20,8 +20,38 @@
 #include "opentimelineio/imageSequenceReference.h"
 #include "opentimelineio/algo/editAlgorithm.h"
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef OTIO_SHIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
 
@@ -29,6 +59,119 @@ namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
 template <typename T>
 using Retainer = otio::SerializableObject::Retainer<T>;
 
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+// Per-thread call counts, times and byte counts of the hot paths, read by
+// otio_stats_snapshot. Only built with OTIO_SHIM_WITH_STATS; otherwise the
+// macros below expand to nothing. Each thread only ever writes its own
+// counters (a relaxed load and store, no read-modify-write), and readers sum
+// them under the registry lock. Reset records the current totals as a
+// baseline instead of clearing the counters under their owners.
+
+#ifdef OTIO_SHIM_HAVE_STATS
+
+enum StatField { kStatCalls, kStatNanoseconds, kStatBytes, kStatFields };
+
+using StatTable = uint64_t[OTIO_STAT_COUNT][kStatFields];
+
+struct ThreadStats {
+    std::atomic<uint64_t> values[OTIO_STAT_COUNT][kStatFields] = {};
+
+    ThreadStats();
+    ~ThreadStats();
+
+    void add(int32_t id, StatField field, uint64_t n) {
+        auto& value = values[id][field];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+struct StatsRegistry {
+    std::mutex mutex;
+    std::vector<ThreadStats*> threads;
+    StatTable retired = {};   // Totals of threads that have exited
+    StatTable baseline = {};  // Totals at the last reset
+
+    // Sum of every thread's counters, live or exited
+    void totals(StatTable& out) {
+        std::memcpy(out, retired, sizeof(StatTable));
+        for (const ThreadStats* thread : threads) {
+            for (int32_t id = 0; id < OTIO_STAT_COUNT; ++id) {
+                for (int32_t field = 0; field < kStatFields; ++field) {
+                    out[id][field] += thread->values[id][field].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+};
+
+// Never destroyed: threads can exit after static destructors have run
+static StatsRegistry& stats_registry() {
+    static StatsRegistry* registry = new StatsRegistry();
+    return *registry;
+}
+
+ThreadStats::ThreadStats() {
+    auto& registry = stats_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(this);
+}
+
+ThreadStats::~ThreadStats() {
+    auto& registry = stats_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (int32_t id = 0; id < OTIO_STAT_COUNT; ++id) {
+        for (int32_t field = 0; field < kStatFields; ++field) {
+            registry.retired[id][field] += values[id][field].load(std::memory_order_relaxed);
+        }
+    }
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+static ThreadStats& thread_stats() {
+    static thread_local ThreadStats stats;
+    return stats;
+}
+
+// Counts a call to id and the time until the end of the scope
+class StatTimer {
+public:
+    explicit StatTimer(int32_t id) : id_(id), start_(std::chrono::steady_clock::now()) {}
+    ~StatTimer() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        auto& stats = thread_stats();
+        stats.add(id_, kStatCalls, 1);
+        stats.add(id_, kStatNanoseconds, static_cast<uint64_t>(elapsed.count()));
+    }
+    StatTimer(const StatTimer&) = delete;
+    StatTimer& operator=(const StatTimer&) = delete;
+
+private:
+    int32_t id_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define OTIO_STATS_SCOPE(id) StatTimer otio_stat_timer_(id)
+#define OTIO_STATS_ADD(id) thread_stats().add(id, kStatCalls, 1)
+#define OTIO_STATS_BYTES(id, n) thread_stats().add(id, kStatBytes, static_cast<uint64_t>(n))
+
+#else
+
+#define OTIO_STATS_SCOPE(id) ((void)0)
+#define OTIO_STATS_ADD(id) ((void)0)
+#define OTIO_STATS_BYTES(id, n) ((void)0)
+
+#endif
+
+// dynamic_cast, counted
+template <typename T, typename U>
+static T counted_dynamic_cast(U* ptr) {
+    OTIO_STATS_ADD(OTIO_STAT_DYNAMIC_CAST);
+    return dynamic_cast<T>(ptr);
+}
+
 // ============================================================================
 // Helper Macros - Reduce boilerplate and ensure consistent error handling
 // ============================================================================
@@ -52,9 +195,11 @@ using Retainer = otio::SerializableObject::Retainer<T>;
         body \
         return 0; \
     } catch (const std::exception& e) { \
+        OTIO_STATS_ADD(OTIO_STAT_EXCEPTION); \
         set_error(err, 1, e.what()); \
         return -1; \
     } catch (...) { \
+        OTIO_STATS_ADD(OTIO_STAT_EXCEPTION); \
         set_error(err, 1, "Unknown exception"); \
         return -1; \
     }
@@ -64,6 +209,7 @@ using Retainer = otio::SerializableObject::Retainer<T>;
     try { \
         body \
     } catch (...) { \
+        OTIO_STATS_ADD(OTIO_STAT_EXCEPTION); \
         return nullptr; \
     }
 
@@ -72,6 +218,7 @@ using Retainer = otio::SerializableObject::Retainer<T>;
     try { \
         body \
     } catch (...) { \
+        OTIO_STATS_ADD(OTIO_STAT_EXCEPTION); \
         return (default_val); \
     }
 
@@ -110,13 +257,31 @@ static void set_error(OtioError* err, int code, const char* msg) {
 
 // Safe strdup that returns empty string on failure
 static char* safe_strdup(const char* s) {
+    OTIO_STATS_ADD(OTIO_STAT_STRDUP);
     if (!s) return strdup("");
+    OTIO_STATS_BYTES(OTIO_STAT_STRDUP, strlen(s) + 1);
     char* result = strdup(s);
     return result ? result : strdup("");
 }
 
 static char* safe_strdup(const std::string& s) {
-    return safe_strdup(s.c_str());
+    OTIO_STATS_ADD(OTIO_STAT_STRDUP);
+    OTIO_STATS_BYTES(OTIO_STAT_STRDUP, s.size() + 1);
+    // Length is already known, so skip strdup's strlen pass
+    char* result = static_cast<char*>(malloc(s.size() + 1));
+    if (!result) return strdup("");
+    memcpy(result, s.data(), s.size());
+    result[s.size()] = '\0';
+    return result;
+}
+
+// Views of strings OTIO only hands out by value (name(), target_url(), ...)
+// are backed by a per-thread buffer; assign() reuses its capacity, so
+// repeated calls stop allocating once it has grown to the longest string.
+static OtioStringView scratch_string_view(const std::string& s) {
+    static thread_local std::string scratch;
+    scratch.assign(s);
+    return OtioStringView{scratch.data(), scratch.size()};
 }
 
 // ============================================================================
@@ -139,516 +304,1093 @@ static char* get_metadata_string_impl(T* obj, const char* key) {
     )
 }
 
+template<typename T>
+static OtioStringView get_metadata_string_view_impl(T* obj, const char* key) {
+    OtioStringView none = {nullptr, 0};
+    if (!obj || !key) return none;
+    try {
+        auto& meta = obj->metadata();
+        auto it = meta.find(std::string(key));
+        if (it != meta.end() && it->second.type() == typeid(std::string)) {
+            const std::string& value = std::any_cast<const std::string&>(it->second);
+            return OtioStringView{value.data(), value.size()};
+        }
+    } catch (...) {
+    }
+    return none;
+}
+
+static void note_metadata_changed(otio::Composable* item, const std::string& key);
+static void note_timeline_changed(otio::Timeline* tl);
+static bool journal_wanted(const otio::SerializableObject* obj);
+static std::optional<std::any> metadata_value_of(const otio::AnyDictionary& meta, const std::string& key);
+static void journal_metadata_change(otio::SerializableObjectWithMetadata* owner, const std::string& key,
+    std::optional<std::any> previous);
+
 template<typename T>
 static void set_metadata_string_impl(T* obj, const char* key, const char* value) {
     if (!obj || !key || !value) return;
     try {
-        obj->metadata()[std::string(key)] = std::string(value);
+        std::string k(key);
+        const bool journaled = journal_wanted(obj);
+        std::optional<std::any> previous;
+        if (journaled) previous = metadata_value_of(obj->metadata(), k);
+        obj->metadata()[k] = std::string(value);
+        if constexpr (std::is_base_of<otio::Composable, T>::value) {
+            note_metadata_changed(obj, k);
+        } else if constexpr (std::is_same<otio::Timeline, T>::value) {
+            note_timeline_changed(obj);
+        }
+        if (journaled) journal_metadata_change(obj, k, std::move(previous));
     } catch (...) {
         // Ignore errors in metadata setting
     }
 }
 
+// Reads the little-endian encoding of otio_metadata_import_value
+struct MetadataReader {
+    const uint8_t* data;
+    size_t len;
+    size_t pos = 0;
+
+    void need(size_t n) const {
+        if (len - pos < n) throw std::invalid_argument("Truncated metadata encoding");
+    }
+    uint8_t byte() {
+        need(1);
+        return data[pos++];
+    }
+    uint64_t u64() {
+        need(8);
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(data[pos + i]) << (8 * i);
+        pos += 8;
+        return v;
+    }
+    uint32_t u32() {
+        need(4);
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(data[pos + i]) << (8 * i);
+        pos += 4;
+        return v;
+    }
+    std::string bytes() {
+        uint32_t n = u32();
+        need(n);
+        std::string s(reinterpret_cast<const char*>(data + pos), n);
+        pos += n;
+        return s;
+    }
+};
+
 // ============================================================================
-// Template helpers for child operations
+// Object type tags
 // ============================================================================
 
-template<typename Container>
-static int32_t children_count_impl(Container* container) {
-    if (!container) return 0;
-    try {
-        return static_cast<int32_t>(container->children().size());
-    } catch (...) {
-        return 0;
+// Maps an object's dynamic type to its OTIO_OBJECT_TYPE_* tag. The schema
+// classes are matched by comparing typeid against a fixed table, one vtable
+// read instead of a dynamic_cast per candidate. Subclasses of them (from
+// plugins or other bindings) are classified with dynamic_cast the first time
+// their type is seen and remembered per type, never per object.
+class ObjectTypeTable {
+public:
+    int32_t tag_of(const otio::SerializableObject* obj) {
+        const std::type_info& type = typeid(*obj);
+        for (const auto& entry : exact_) {
+            if (*entry.type == type) return entry.tag;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : derived_) {
+            if (*entry.type == type) return entry.tag;
+        }
+        int32_t tag = classify(obj);
+        derived_.push_back({&type, tag});
+        return tag;
     }
-}
 
-template<typename Container>
-static int32_t child_type_impl(Container* container, int32_t index) {
-    if (!container) return -1;
-    try {
-        auto& children = container->children();
-        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
-            return -1;
+private:
+    struct Entry {
+        const std::type_info* type;
+        int32_t tag;
+    };
+
+    // Most derived first: FreezeFrame is a LinearTimeWarp is an Effect
+    static int32_t classify(const otio::SerializableObject* obj) {
+        if (counted_dynamic_cast<const otio::Clip*>(obj)) return OTIO_CHILD_TYPE_CLIP;
+        if (counted_dynamic_cast<const otio::Gap*>(obj)) return OTIO_CHILD_TYPE_GAP;
+        if (counted_dynamic_cast<const otio::Transition*>(obj)) return OTIO_CHILD_TYPE_TRANSITION;
+        if (counted_dynamic_cast<const otio::Track*>(obj)) return OTIO_CHILD_TYPE_TRACK;
+        if (counted_dynamic_cast<const otio::Stack*>(obj)) return OTIO_CHILD_TYPE_STACK;
+        if (counted_dynamic_cast<const otio::Timeline*>(obj)) return OTIO_OBJECT_TYPE_TIMELINE;
+        if (counted_dynamic_cast<const otio::Marker*>(obj)) return OTIO_OBJECT_TYPE_MARKER;
+        if (counted_dynamic_cast<const otio::FreezeFrame*>(obj)) return OTIO_OBJECT_TYPE_FREEZE_FRAME;
+        if (counted_dynamic_cast<const otio::LinearTimeWarp*>(obj)) return OTIO_OBJECT_TYPE_LINEAR_TIME_WARP;
+        if (counted_dynamic_cast<const otio::Effect*>(obj)) return OTIO_OBJECT_TYPE_EFFECT;
+        if (counted_dynamic_cast<const otio::ExternalReference*>(obj)) return OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE;
+        if (counted_dynamic_cast<const otio::MissingReference*>(obj)) return OTIO_OBJECT_TYPE_MISSING_REFERENCE;
+        if (counted_dynamic_cast<const otio::GeneratorReference*>(obj)) return OTIO_OBJECT_TYPE_GENERATOR_REFERENCE;
+        if (counted_dynamic_cast<const otio::ImageSequenceReference*>(obj)) {
+            return OTIO_OBJECT_TYPE_IMAGE_SEQUENCE_REFERENCE;
         }
-        auto child = children[index].value;
-        if (dynamic_cast<otio::Clip*>(child)) return OTIO_CHILD_TYPE_CLIP;
-        if (dynamic_cast<otio::Gap*>(child)) return OTIO_CHILD_TYPE_GAP;
-        if (dynamic_cast<otio::Stack*>(child)) return OTIO_CHILD_TYPE_STACK;
-        if (dynamic_cast<otio::Track*>(child)) return OTIO_CHILD_TYPE_TRACK;
-        if (dynamic_cast<otio::Transition*>(child)) return OTIO_CHILD_TYPE_TRANSITION;
-        return -1;
-    } catch (...) {
         return -1;
     }
+
+    // Ordered by how often each schema shows up in a child walk
+    const Entry exact_[14] = {
+        {&typeid(otio::Clip), OTIO_CHILD_TYPE_CLIP},
+        {&typeid(otio::Gap), OTIO_CHILD_TYPE_GAP},
+        {&typeid(otio::Transition), OTIO_CHILD_TYPE_TRANSITION},
+        {&typeid(otio::Track), OTIO_CHILD_TYPE_TRACK},
+        {&typeid(otio::Stack), OTIO_CHILD_TYPE_STACK},
+        {&typeid(otio::ExternalReference), OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE},
+        {&typeid(otio::Marker), OTIO_OBJECT_TYPE_MARKER},
+        {&typeid(otio::Effect), OTIO_OBJECT_TYPE_EFFECT},
+        {&typeid(otio::LinearTimeWarp), OTIO_OBJECT_TYPE_LINEAR_TIME_WARP},
+        {&typeid(otio::FreezeFrame), OTIO_OBJECT_TYPE_FREEZE_FRAME},
+        {&typeid(otio::Timeline), OTIO_OBJECT_TYPE_TIMELINE},
+        {&typeid(otio::MissingReference), OTIO_OBJECT_TYPE_MISSING_REFERENCE},
+        {&typeid(otio::GeneratorReference), OTIO_OBJECT_TYPE_GENERATOR_REFERENCE},
+        {&typeid(otio::ImageSequenceReference), OTIO_OBJECT_TYPE_IMAGE_SEQUENCE_REFERENCE},
+    };
+    std::mutex mutex_;
+    std::vector<Entry> derived_;
+};
+
+// OTIO_OBJECT_TYPE_* tag of obj, or -1 for null and unrecognised schemas
+static int32_t object_type_of(const otio::SerializableObject* obj) {
+    static ObjectTypeTable table;
+    return obj ? table.tag_of(obj) : -1;
 }
 
-template<typename Container>
-static void* child_at_impl(Container* container, int32_t index) {
-    if (!container) return nullptr;
-    try {
-        auto& children = container->children();
-        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
-            return nullptr;
-        }
-        return children[index].value;
-    } catch (...) {
-        return nullptr;
+// ============================================================================
+// Mutation tracking
+// ============================================================================
+
+// Derived data the shim keeps about a composition (time indexes, caches)
+// registers a MutationListener on it. Shim entry points that change timing or
+// structure report the change, and listeners on the changed object and on
+// every ancestor are notified. Metadata and media reference changes made
+// through the shim are reported the same way. Edits made directly through
+// OTIO, and changes to a media reference after it was attached to a clip, are
+// not seen.
+
+// Every change reported here also forgets the memoized fingerprints of the
+// changed object and its ancestors (see Fingerprints).
+static void forget_fingerprints(otio::Composable* obj);
+
+// first_child value meaning only the object's own fields changed
+static constexpr size_t OTIO_MUTATION_SELF = static_cast<size_t>(-1);
+
+class MutationListener {
+public:
+    virtual ~MutationListener() = default;
+
+    // Children from first_child on may have moved or changed. Called with the
+    // registry lock held, so it must not add or remove listeners.
+    virtual void on_mutation(size_t first_child) = 0;
+
+    // Children were added, removed or replaced somewhere below the target,
+    // not just retimed. Called right after on_mutation.
+    virtual void on_structure_changed() {}
+
+    // A metadata value of item (metadata_key) or, with a null key, the media
+    // references of item changed. item is the target or a descendant of it.
+    virtual void on_attributes_changed(otio::Composable* item, const std::string* metadata_key) {
+        (void)item;
+        (void)metadata_key;
+    }
+
+    // The change reported to on_mutation started at obj, the target or a
+    // descendant of it: its own fields changed, or with children set, its
+    // children or their timing. Called right after on_mutation.
+    virtual void on_edited(otio::Composable* obj, bool children) {
+        (void)obj;
+        (void)children;
     }
+};
+
+struct MutationRegistry {
+    std::mutex mutex;
+    std::unordered_multimap<const otio::SerializableObject*, MutationListener*> listeners;
+};
+
+static MutationRegistry& mutation_registry() {
+    static MutationRegistry registry;
+    return registry;
 }
 
-template<typename Container, typename Child>
-static int append_child_impl(Container* container, Child* child, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
-    OTIO_NULL_CHECK_ERR(child, err, -1, "Child is null");
-    try {
-        otio::ErrorStatus status;
-        container->append_child(child, &status);
-        OTIO_CHECK_STATUS(status, err);
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+static void add_mutation_listener(const otio::SerializableObject* target, MutationListener* listener) {
+    auto& registry = mutation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.listeners.emplace(target, listener);
+}
+
+static void remove_mutation_listener(const otio::SerializableObject* target, MutationListener* listener) {
+    auto& registry = mutation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto range = registry.listeners.equal_range(target);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == listener) {
+            registry.listeners.erase(it);
+            return;
+        }
     }
 }
 
-template<typename Container, typename Child>
-static int insert_child_impl(Container* container, int32_t index, Child* child, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
-    OTIO_NULL_CHECK_ERR(child, err, -1, "Child is null");
-    try {
-        otio::ErrorStatus status;
-        container->insert_child(index, child, &status);
-        OTIO_CHECK_STATUS(status, err);
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+// Notify obj's listeners with first_child, then each ancestor's listeners
+// with the index of the child on the path down to obj.
+static void notify_mutation(otio::Composable* obj, size_t first_child, bool structural) {
+    forget_fingerprints(obj);
+    auto& registry = mutation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (registry.listeners.empty()) return;
+
+    bool children = first_child != OTIO_MUTATION_SELF;
+    auto notify = [&registry, structural, obj, children](const otio::SerializableObject* target, size_t index) {
+        auto range = registry.listeners.equal_range(target);
+        for (auto it = range.first; it != range.second; ++it) {
+            it->second->on_mutation(index);
+            if (structural) it->second->on_structure_changed();
+            it->second->on_edited(obj, children);
+        }
+    };
+    notify(obj, first_child);
+    otio::Composable* node = obj;
+    while (otio::Composition* parent = node->parent()) {
+        if (registry.listeners.count(parent) != 0) {
+            otio::ErrorStatus status;
+            int index = parent->index_of_child(node, &status);
+            notify(parent, index < 0 ? 0 : static_cast<size_t>(index));
+        }
+        node = parent;
     }
 }
 
-template<typename Container>
-static int remove_child_impl(Container* container, int32_t index, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
-    try {
-        auto& children = container->children();
-        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
-            set_error(err, 1, "Index out of bounds");
-            return -1;
+// The children of comp from first_index on were added, removed or edited.
+static void note_children_changed(otio::Composition* comp, size_t first_index) {
+    if (comp) notify_mutation(comp, first_index, true);
+}
+
+// The timing of obj itself changed (offsets, media reference, ...).
+static void note_mutation(otio::Composable* obj) {
+    if (obj) notify_mutation(obj, OTIO_MUTATION_SELF, false);
+}
+
+// Report an attribute change to the listeners on item and its ancestors
+static void notify_attributes(otio::Composable* item, const std::string* metadata_key) {
+    forget_fingerprints(item);
+    auto& registry = mutation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (registry.listeners.empty()) return;
+    for (otio::Composable* node = item; node; node = node->parent()) {
+        auto range = registry.listeners.equal_range(node);
+        for (auto it = range.first; it != range.second; ++it) {
+            it->second->on_attributes_changed(item, metadata_key);
         }
-        otio::ErrorStatus status;
-        container->remove_child(index, &status);
-        OTIO_CHECK_STATUS(status, err);
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
     }
 }
 
-template<typename Container>
-static int clear_children_impl(Container* container, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
-    try {
-        container->clear_children();
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+static void note_metadata_changed(otio::Composable* item, const std::string& key) {
+    if (item) notify_attributes(item, &key);
+}
+
+// A field of the timeline itself (not of its tracks) changed. Listeners on
+// the timeline object get on_mutation(OTIO_MUTATION_SELF).
+static void note_timeline_changed(otio::Timeline* tl) {
+    auto& registry = mutation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto range = registry.listeners.equal_range(tl);
+    for (auto it = range.first; it != range.second; ++it) {
+        it->second->on_mutation(OTIO_MUTATION_SELF);
+    }
+}
+
+// The media references of clip were replaced; this also changes its timing.
+static void note_media_references_changed(otio::Clip* clip) {
+    if (!clip) return;
+    note_mutation(clip);
+    notify_attributes(clip, nullptr);
+}
+
+// A field of obj changed that only fingerprints cover (a transition's type,
+// a track's kind, the markers and effects of an item).
+static void note_content_changed(otio::Composable* obj) {
+    forget_fingerprints(obj);
+}
+
+// An edit algorithm changed item and possibly its neighbours.
+static void note_item_edited(otio::Item* item) {
+    auto parent = item ? item->parent() : nullptr;
+    if (!parent) {
+        note_mutation(item);
+        return;
     }
+    otio::ErrorStatus status;
+    int index = parent->index_of_child(item, &status);
+    note_children_changed(parent, index > 0 ? static_cast<size_t>(index - 1) : 0);
 }
 
 // ============================================================================
-// Parent navigation helpers (templates - must be before extern "C")
+// Undo journal
 // ============================================================================
 
-// Helper to determine parent type
+// A timeline with an undo journal gets, for each edit made through the shim,
+// a record that undoes it. Where the inverse is small it is stored as such (a
+// splice of children, one metadata value, one field); the edit algorithms,
+// which retime neighbours in place, record the children of the composition
+// they edited and their source ranges. Nothing is serialized and untouched
+// subtrees are shared, not copied. Applying a record returns the record that
+// reapplies the edit, so undo and redo are the same operation. The entry
+// points that notify mutation listeners record, with the same blind spots.
+
+struct JournalRecord {
+    virtual ~JournalRecord() = default;
+
+    // Make the recorded change and return its inverse. Throws if the
+    // timeline no longer matches the record.
+    virtual std::unique_ptr<JournalRecord> apply() = 0;
+};
+
+using JournalStep = std::vector<std::unique_ptr<JournalRecord>>;
+
+// The object a record changes. Composables are retained, so a record
+// outlives their removal from the tree. A timeline is only borrowed: Rust
+// owns timelines with a refcount of 0, so retaining one would delete it on
+// release, and the journal already borrows it for its whole life.
 template<typename T>
-static int32_t get_parent_type_impl(T* obj) {
-    if (!obj) return OTIO_PARENT_TYPE_NONE;
-    try {
-        auto parent = obj->parent();
-        if (!parent) return OTIO_PARENT_TYPE_NONE;
-        if (dynamic_cast<otio::Track*>(parent)) return OTIO_PARENT_TYPE_TRACK;
-        if (dynamic_cast<otio::Stack*>(parent)) return OTIO_PARENT_TYPE_STACK;
-        return OTIO_PARENT_TYPE_NONE;
-    } catch (...) {
-        return OTIO_PARENT_TYPE_NONE;
+struct RecordedObject {
+    T* value;
+    Retainer<T> keep;
+
+    explicit RecordedObject(T* o)
+        : value(o), keep(object_type_of(o) == OTIO_OBJECT_TYPE_TIMELINE ? nullptr : o) {}
+};
+
+struct OtioUndoJournal {
+    // Borrowed: the timeline outlives the journal. Rust owns timelines with
+    // a refcount of 0, so a Retainer here would delete it on release.
+    otio::Timeline* timeline;
+    Retainer<otio::Stack> tracks;
+    size_t depth;
+    std::mutex mutex;
+    int32_t open_groups = 0;
+    JournalStep group;
+    std::deque<JournalStep> undo;
+    std::deque<JournalStep> redo;
+
+    void add_step(JournalStep step) {
+        redo.clear();
+        undo.push_back(std::move(step));
+        while (undo.size() > depth) undo.pop_front();
     }
-}
 
-template<typename T>
-static void* get_parent_impl(T* obj) {
-    if (!obj) return nullptr;
-    try {
-        return obj->parent();
-    } catch (...) {
-        return nullptr;
+    void push(std::unique_ptr<JournalRecord> record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (open_groups > 0) {
+            group.push_back(std::move(record));
+            return;
+        }
+        JournalStep step;
+        step.push_back(std::move(record));
+        add_step(std::move(step));
     }
+};
+
+// Journals by timeline and by the timeline's root stack. active lets edits
+// skip the lock while no journal exists.
+struct UndoRegistry {
+    std::mutex mutex;
+    std::unordered_map<const otio::SerializableObject*, OtioUndoJournal*> journals;
+    std::atomic<bool> active{false};
+};
+
+static UndoRegistry& undo_registry() {
+    static UndoRegistry registry;
+    return registry;
 }
 
-// Helper to recursively find clips in a composition
-static void find_clips_recursive(otio::Composition* comp, std::vector<otio::Clip*>& clips) {
-    if (!comp) return;
-    for (auto& child : comp->children()) {
-        if (auto clip = dynamic_cast<otio::Clip*>(child.value)) {
-            clips.push_back(clip);
-        } else if (auto nested = dynamic_cast<otio::Composition*>(child.value)) {
-            find_clips_recursive(nested, clips);
+// The journal of the timeline obj belongs to; called with the registry lock
+static OtioUndoJournal* find_journal(UndoRegistry& registry, const otio::SerializableObject* obj) {
+    if (auto node = counted_dynamic_cast<const otio::Composable*>(obj)) {
+        while (node->parent()) node = node->parent();
+        obj = node;
+    }
+    auto it = registry.journals.find(obj);
+    return it == registry.journals.end() ? nullptr : it->second;
+}
+
+// Whether edits of obj are journaled, so the caller should capture state
+static bool journal_wanted(const otio::SerializableObject* obj) {
+    auto& registry = undo_registry();
+    if (!obj || !registry.active.load(std::memory_order_acquire)) return false;
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return find_journal(registry, obj) != nullptr;
+}
+
+// Record an edit of obj, which has just succeeded
+static void journal_push(const otio::SerializableObject* obj, std::unique_ptr<JournalRecord> record) {
+    if (!record) return;
+    auto& registry = undo_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (OtioUndoJournal* journal = find_journal(registry, obj)) journal->push(std::move(record));
+}
+
+// Keeps the records of a multi-op edit (a patch) in one step
+class JournalGroup {
+public:
+    explicit JournalGroup(const otio::SerializableObject* obj) {
+        if (!journal_wanted(obj)) return;
+        auto& registry = undo_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if ((journal_ = find_journal(registry, obj))) {
+            std::lock_guard<std::mutex> journal_lock(journal_->mutex);
+            ++journal_->open_groups;
         }
     }
-}
 
-// ============================================================================
-// C API Implementation
-// ============================================================================
+    ~JournalGroup() {
+        if (!journal_) return;
+        std::lock_guard<std::mutex> lock(journal_->mutex);
+        if (--journal_->open_groups == 0 && !journal_->group.empty()) {
+            journal_->add_step(std::move(journal_->group));
+            journal_->group.clear();
+        }
+    }
 
-extern "C" {
+    JournalGroup(const JournalGroup&) = delete;
+    JournalGroup& operator=(const JournalGroup&) = delete;
 
-// ----------------------------------------------------------------------------
-// Timeline
-// ----------------------------------------------------------------------------
+private:
+    OtioUndoJournal* journal_ = nullptr;
+};
 
-OtioTimeline* otio_timeline_create(const char* name) {
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        auto tl = new otio::Timeline(name);
-        tl->set_tracks(new otio::Stack());
-        Retainer<otio::Timeline> retainer(tl);
-        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
-    )
-}
+// Replace the children of comp at [index, index + removed.size()) with
+// inserted. Inverse of an insert, a removal or a replacement.
+struct SpliceRecord : JournalRecord {
+    Retainer<otio::Composition> comp;
+    size_t index;
+    size_t remove;
+    std::vector<Retainer<otio::Composable>> insert;
 
-void otio_timeline_free(OtioTimeline* tl) {
-    if (tl) {
-        try {
-            OTIO_CAST(Timeline, timeline, tl);
-            Retainer<otio::Timeline> retainer(timeline);
-        } catch (...) {
-            // Ignore exceptions during cleanup
+    SpliceRecord(otio::Composition* c, size_t at, size_t count, std::vector<Retainer<otio::Composable>> children)
+        : comp(c), index(at), remove(count), insert(std::move(children)) {}
+
+    std::unique_ptr<JournalRecord> apply() override {
+        otio::Composition* target = comp.value;
+        const auto& children = target->children();
+        if (index + remove > children.size()) {
+            throw std::out_of_range("Children of " + target->name() + " do not match the journal");
+        }
+        std::vector<Retainer<otio::Composable>> removed(
+            children.begin() + static_cast<std::ptrdiff_t>(index),
+            children.begin() + static_cast<std::ptrdiff_t>(index + remove));
+        otio::ErrorStatus status;
+        if (remove + insert.size() == 1) {
+            // The common single-child undo shifts the vector once
+            if (remove == 1) {
+                target->remove_child(static_cast<int>(index), &status);
+            } else {
+                target->insert_child(static_cast<int>(index), insert.front().value, &status);
+            }
+        } else {
+            std::vector<Retainer<otio::Composable>> keep(children.begin(), children.end());
+            std::vector<otio::Composable*> order;
+            order.reserve(keep.size() - remove + insert.size());
+            for (size_t i = 0; i < index; ++i) order.push_back(keep[i].value);
+            for (const auto& child : insert) order.push_back(child.value);
+            for (size_t i = index + remove; i < keep.size(); ++i) order.push_back(keep[i].value);
+            target->clear_children();
+            target->set_children(order, &status);
+            if (otio::is_error(status)) {
+                std::vector<otio::Composable*> original;
+                original.reserve(keep.size());
+                for (const auto& child : keep) original.push_back(child.value);
+                target->clear_children();
+                otio::ErrorStatus restore_status;
+                target->set_children(original, &restore_status);
+            }
         }
+        if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+        note_children_changed(target, index);
+        return std::make_unique<SpliceRecord>(target, index, insert.size(), std::move(removed));
     }
-}
+};
 
-int otio_timeline_set_global_start_time(OtioTimeline* tl, OtioRationalTime time, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
-    OTIO_TRY_INT(err,
-        OTIO_CAST(Timeline, timeline, tl);
-        timeline->set_global_start_time(to_otio_rt(time));
-    )
+// Children [first, first + count) of comp were just added
+static std::unique_ptr<JournalRecord> journal_inserted(otio::Composition* comp, size_t first, size_t count) {
+    if (count == 0 || !journal_wanted(comp)) return nullptr;
+    return std::make_unique<SpliceRecord>(comp, first, count, std::vector<Retainer<otio::Composable>>{});
 }
 
-OtioTrack* otio_timeline_add_video_track(OtioTimeline* tl, const char* name) {
-    OTIO_NULL_CHECK(tl, nullptr);
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Timeline, timeline, tl);
-        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::video);
-        otio::ErrorStatus err;
-        timeline->tracks()->append_child(track, &err);
-        return reinterpret_cast<OtioTrack*>(track);
-    )
-}
-
-OtioTrack* otio_timeline_add_audio_track(OtioTimeline* tl, const char* name) {
-    OTIO_NULL_CHECK(tl, nullptr);
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Timeline, timeline, tl);
-        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::audio);
-        otio::ErrorStatus err;
-        timeline->tracks()->append_child(track, &err);
-        return reinterpret_cast<OtioTrack*>(track);
-    )
-}
+// The children of a composition and the source ranges of the items among
+// them: what the edit algorithms change
+struct ChildrenSnapshot {
+    std::vector<Retainer<otio::Composable>> children;
+    std::vector<std::optional<otio::TimeRange>> source_ranges;
 
-OtioStack* otio_timeline_get_tracks(OtioTimeline* tl) {
-    OTIO_NULL_CHECK(tl, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Timeline, timeline, tl);
-        return reinterpret_cast<OtioStack*>(timeline->tracks());
-    )
-}
+    explicit ChildrenSnapshot(const otio::Composition* comp)
+        : children(comp->children().begin(), comp->children().end()) {
+        source_ranges.reserve(children.size());
+        for (const auto& child : children) {
+            auto item = counted_dynamic_cast<otio::Item*>(child.value);
+            source_ranges.push_back(item ? item->source_range() : std::nullopt);
+        }
+    }
 
-// ----------------------------------------------------------------------------
-// Track
-// ----------------------------------------------------------------------------
+    bool restore(otio::Composition* comp) const {
+        std::vector<otio::Composable*> original;
+        original.reserve(children.size());
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (auto item = counted_dynamic_cast<otio::Item*>(children[i].value)) {
+                item->set_source_range(source_ranges[i]);
+            }
+            original.push_back(children[i].value);
+        }
+        comp->clear_children();
+        otio::ErrorStatus status;
+        comp->set_children(original, &status);
+        return !otio::is_error(status);
+    }
+};
 
-OtioTrack* otio_track_create_video(const char* name) {
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::video);
-        Retainer<otio::Track> retainer(track);
-        return reinterpret_cast<OtioTrack*>(retainer.take_value());
-    )
-}
+// Restores a whole child list, so recording and applying it costs the width
+// of the composition
+struct ChildrenRecord : JournalRecord {
+    Retainer<otio::Composition> comp;
+    ChildrenSnapshot snapshot;
 
-OtioTrack* otio_track_create_audio(const char* name) {
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::audio);
-        Retainer<otio::Track> retainer(track);
-        return reinterpret_cast<OtioTrack*>(retainer.take_value());
-    )
-}
+    ChildrenRecord(otio::Composition* c, ChildrenSnapshot s) : comp(c), snapshot(std::move(s)) {}
 
-void otio_track_free(OtioTrack* track) {
-    if (track) {
-        try {
-            OTIO_CAST(Track, t, track);
-            Retainer<otio::Track> retainer(t);
-        } catch (...) {
-            // Ignore exceptions during cleanup
+    std::unique_ptr<JournalRecord> apply() override {
+        ChildrenSnapshot current(comp.value);
+        if (!snapshot.restore(comp.value)) {
+            current.restore(comp.value);
+            throw std::runtime_error("Children of " + comp.value->name() + " could not be restored");
         }
+        note_children_changed(comp.value, 0);
+        return std::make_unique<ChildrenRecord>(comp.value, std::move(current));
     }
-}
+};
 
-int otio_track_append_clip(OtioTrack* track, OtioClip* clip, OtioError* err) {
-    return append_child_impl<otio::Track, otio::Clip>(
-        reinterpret_cast<otio::Track*>(track),
-        reinterpret_cast<otio::Clip*>(clip), err);
+// Capture comp's children before an edit algorithm changes them
+static std::unique_ptr<JournalRecord> journal_children(otio::Composition* comp) {
+    if (!journal_wanted(comp)) return nullptr;
+    return std::make_unique<ChildrenRecord>(comp, ChildrenSnapshot(comp));
 }
 
-int otio_track_append_gap(OtioTrack* track, OtioGap* gap, OtioError* err) {
-    return append_child_impl<otio::Track, otio::Gap>(
-        reinterpret_cast<otio::Track*>(track),
-        reinterpret_cast<otio::Gap*>(gap), err);
+// An item outside a composition is in no timeline, so it has no journal
+static std::unique_ptr<JournalRecord> journal_item_edit(otio::Item* item) {
+    return item->parent() ? journal_children(item->parent()) : nullptr;
 }
 
-int otio_track_append_stack(OtioTrack* track, OtioStack* stack, OtioError* err) {
-    return append_child_impl<otio::Track, otio::Stack>(
-        reinterpret_cast<otio::Track*>(track),
-        reinterpret_cast<otio::Stack*>(stack), err);
+static std::optional<std::any> metadata_value_of(const otio::AnyDictionary& meta, const std::string& key) {
+    auto it = meta.find(key);
+    if (it == meta.end()) return std::nullopt;
+    return it->second;
 }
 
-int32_t otio_track_children_count(OtioTrack* track) {
-    return children_count_impl(reinterpret_cast<otio::Track*>(track));
-}
+// One metadata value of a composable or the timeline; nullopt for no key
+struct MetadataRecord : JournalRecord {
+    RecordedObject<otio::SerializableObjectWithMetadata> owner;
+    std::string key;
+    std::optional<std::any> value;
 
-int32_t otio_track_child_type(OtioTrack* track, int32_t index) {
-    return child_type_impl(reinterpret_cast<otio::Track*>(track), index);
-}
+    MetadataRecord(otio::SerializableObjectWithMetadata* o, std::string k, std::optional<std::any> v)
+        : owner(o), key(std::move(k)), value(std::move(v)) {}
 
-void* otio_track_child_at(OtioTrack* track, int32_t index) {
-    return child_at_impl(reinterpret_cast<otio::Track*>(track), index);
-}
+    std::unique_ptr<JournalRecord> apply() override {
+        auto& meta = owner.value->metadata();
+        std::optional<std::any> current = metadata_value_of(meta, key);
+        if (value) {
+            meta[key] = *value;
+        } else {
+            meta.erase(key);
+        }
+        int32_t type = object_type_of(owner.value);
+        if (type >= 0 && type < OTIO_OBJECT_TYPE_TIMELINE) {
+            note_metadata_changed(static_cast<otio::Composable*>(owner.value), key);
+        } else if (type == OTIO_OBJECT_TYPE_TIMELINE) {
+            note_timeline_changed(static_cast<otio::Timeline*>(owner.value));
+        }
+        return std::make_unique<MetadataRecord>(owner.value, key, std::move(current));
+    }
+};
 
-int otio_track_remove_child(OtioTrack* track, int32_t index, OtioError* err) {
-    return remove_child_impl(reinterpret_cast<otio::Track*>(track), index, err);
+// key of owner was just set; previous is its value before
+static void journal_metadata_change(otio::SerializableObjectWithMetadata* owner, const std::string& key,
+    std::optional<std::any> previous) {
+    journal_push(owner, std::make_unique<MetadataRecord>(owner, key, std::move(previous)));
 }
 
-int otio_track_insert_clip(OtioTrack* track, int32_t index, OtioClip* clip, OtioError* err) {
-    return insert_child_impl<otio::Track, otio::Clip>(
-        reinterpret_cast<otio::Track*>(track), index,
-        reinterpret_cast<otio::Clip*>(clip), err);
-}
+// One field (or a few read and written together) of object, swapped with
+// the recorded value
+template<typename Object, typename Value>
+struct FieldRecord : JournalRecord {
+    using Get = Value (*)(Object*);
+    using Set = void (*)(Object*, const Value&);
 
-int otio_track_insert_gap(OtioTrack* track, int32_t index, OtioGap* gap, OtioError* err) {
-    return insert_child_impl<otio::Track, otio::Gap>(
-        reinterpret_cast<otio::Track*>(track), index,
-        reinterpret_cast<otio::Gap*>(gap), err);
-}
+    RecordedObject<Object> object;
+    Value value;
+    Get get;
+    Set set;
 
-int otio_track_insert_stack(OtioTrack* track, int32_t index, OtioStack* stack, OtioError* err) {
-    return insert_child_impl<otio::Track, otio::Stack>(
-        reinterpret_cast<otio::Track*>(track), index,
-        reinterpret_cast<otio::Stack*>(stack), err);
+    FieldRecord(Object* o, Value v, Get g, Set s) : object(o), value(std::move(v)), get(g), set(s) {}
+
+    std::unique_ptr<JournalRecord> apply() override {
+        Value current = get(object.value);
+        set(object.value, value);
+        return std::make_unique<FieldRecord>(object.value, std::move(current), get, set);
+    }
+};
+
+// Capture a field of object before a setter changes it. set must also
+// notify listeners, as the setter does.
+template<typename Object, typename Value>
+static std::unique_ptr<JournalRecord> journal_field(Object* object, Value (*get)(Object*),
+    void (*set)(Object*, const Value&)) {
+    if (!journal_wanted(object)) return nullptr;
+    return std::make_unique<FieldRecord<Object, Value>>(object, get(object), get, set);
+}
+
+// The media references of a clip. keep holds the references that are not
+// attached while the record waits.
+struct ClipMediaReferences {
+    otio::Clip::MediaReferences references;
+    std::string active_key;
+    std::vector<Retainer<otio::MediaReference>> keep;
+};
+
+static ClipMediaReferences get_media_references(otio::Clip* clip) {
+    ClipMediaReferences state{clip->media_references(), clip->active_media_reference_key(), {}};
+    for (const auto& entry : state.references) state.keep.emplace_back(entry.second);
+    return state;
 }
 
-int otio_track_clear_children(OtioTrack* track, OtioError* err) {
-    return clear_children_impl(reinterpret_cast<otio::Track*>(track), err);
+static void set_media_references(otio::Clip* clip, const ClipMediaReferences& state) {
+    otio::ErrorStatus status;
+    clip->set_media_references(state.references, state.active_key, &status);
+    if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+    note_media_references_changed(clip);
 }
 
-// Helper to get composable type from pointer
-static int32_t get_composable_type(otio::Composable* comp) {
-    if (!comp) return -1;
-    if (dynamic_cast<otio::Clip*>(comp)) return OTIO_CHILD_TYPE_CLIP;
-    if (dynamic_cast<otio::Gap*>(comp)) return OTIO_CHILD_TYPE_GAP;
-    if (dynamic_cast<otio::Stack*>(comp)) return OTIO_CHILD_TYPE_STACK;
-    if (dynamic_cast<otio::Track*>(comp)) return OTIO_CHILD_TYPE_TRACK;
-    if (dynamic_cast<otio::Transition*>(comp)) return OTIO_CHILD_TYPE_TRANSITION;
-    return -1;
+static std::unique_ptr<JournalRecord> journal_media_references(otio::Clip* clip) {
+    return journal_field(clip, &get_media_references, &set_media_references);
 }
 
-OtioNeighbors otio_track_neighbors_of(OtioTrack* track, int32_t child_index,
-                                       int32_t gap_policy, OtioError* err) {
-    OtioNeighbors result = {nullptr, -1, nullptr, -1};
-    OTIO_NULL_CHECK_ERR(track, err, result, "Track is null");
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto& children = t->children();
-        if (child_index < 0 || static_cast<size_t>(child_index) >= children.size()) {
-            set_error(err, 1, "Index out of bounds");
-            return result;
+// ============================================================================
+// Cloning
+// ============================================================================
+
+// Copies a composition graph in memory, object by object. Timelines,
+// stacks, tracks, clips, gaps and external references are rebuilt from
+// their fields; other schemas (transitions, markers, effects, the rarer
+// references, and subclasses from plugins) go through OTIO's clone, which
+// also stays in memory. In shared mode markers, effects and media
+// references are retained by both trees instead of copied. Metadata is
+// always copied, since OTIO stores it by value.
+struct ObjectCloner {
+    bool shared;
+
+    template<typename T>
+    static Retainer<T> generic_copy(const T* obj) {
+        otio::ErrorStatus status;
+        Retainer<otio::SerializableObject> copy(obj->clone(&status));
+        auto typed = counted_dynamic_cast<T*>(copy.value);
+        if (otio::is_error(status) || !typed) {
+            throw std::runtime_error("Cannot clone " + obj->schema_name() + ": " + status.full_description);
         }
+        return Retainer<T>(typed);
+    }
+
+    template<typename T>
+    Retainer<T> attachment(T* obj) const {
+        return shared ? Retainer<T>(obj) : generic_copy(obj);
+    }
+
+    Retainer<otio::MediaReference> media_reference(otio::MediaReference* ref) const {
+        if (!ref || shared) return Retainer<otio::MediaReference>(ref);
+        if (typeid(*ref) != typeid(otio::ExternalReference)) return generic_copy(ref);
+        auto external = static_cast<otio::ExternalReference*>(ref);
+        Retainer<otio::ExternalReference> copy(
+            new otio::ExternalReference(external->target_url(), external->available_range(), external->metadata()));
+        copy.value->set_name(external->name());
+        copy.value->set_available_image_bounds(external->available_image_bounds());
+        copy.value->dynamic_fields() = external->dynamic_fields();
+        return Retainer<otio::MediaReference>(copy.value);
+    }
+
+    // Everything an item holds besides its name (set by the constructor),
+    // its media and its children
+    void copy_item(otio::Item* from, otio::Item* to) const {
+        to->metadata() = from->metadata();
+        to->dynamic_fields() = from->dynamic_fields();
+        to->set_source_range(from->source_range());
+        to->set_enabled(from->enabled());
+        to->effects().reserve(from->effects().size());
+        for (const auto& effect : from->effects()) to->effects().push_back(attachment(effect.value));
+        to->markers().reserve(from->markers().size());
+        for (const auto& marker : from->markers()) to->markers().push_back(attachment(marker.value));
+    }
 
+    Retainer<otio::Clip> clip(otio::Clip* from) const {
+        Retainer<otio::Clip> copy(new otio::Clip(from->name()));
+        copy_item(from, copy.value);
+        otio::Clip::MediaReferences references;
+        std::vector<Retainer<otio::MediaReference>> keep;
+        for (const auto& entry : from->media_references()) {
+            keep.push_back(media_reference(entry.second));
+            references[entry.first] = keep.back().value;
+        }
         otio::ErrorStatus status;
-        auto policy = static_cast<otio::Track::NeighborGapPolicy>(gap_policy);
-        auto [left, right] = t->neighbors_of(children[child_index].value, &status, policy);
+        copy.value->set_media_references(references, from->active_media_reference_key(), &status);
+        if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+        return copy;
+    }
 
-        if (otio::is_error(status)) {
-            set_error(err, static_cast<int>(status.outcome), status.details.c_str());
-            return result;
+    Retainer<otio::Composition> composition(otio::Composition* from) const {
+        otio::Composition* empty = nullptr;
+        if (typeid(*from) == typeid(otio::Track)) {
+            empty = new otio::Track(from->name(), std::nullopt, static_cast<otio::Track*>(from)->kind());
+        } else {
+            empty = new otio::Stack(from->name());
         }
+        Retainer<otio::Composition> copy(empty);
+        copy_item(from, copy.value);
+        const auto& children = from->children();
+        std::vector<Retainer<otio::Composable>> copies;
+        copies.reserve(children.size());
+        for (const auto& child : children) copies.push_back(composable(child.value));
+        std::vector<otio::Composable*> order;
+        order.reserve(copies.size());
+        for (const auto& child : copies) order.push_back(child.value);
+        otio::ErrorStatus status;
+        copy.value->set_children(order, &status);
+        if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+        return copy;
+    }
 
-        if (left) {
-            result.left = left.value;
-            result.left_type = get_composable_type(left.value);
+    Retainer<otio::Composable> composable(otio::Composable* from) const {
+        const std::type_info& type = typeid(*from);
+        if (type == typeid(otio::Clip)) {
+            return Retainer<otio::Composable>(clip(static_cast<otio::Clip*>(from)).value);
         }
-        if (right) {
-            result.right = right.value;
-            result.right_type = get_composable_type(right.value);
+        if (type == typeid(otio::Gap)) {
+            Retainer<otio::Gap> copy(new otio::Gap(otio::TimeRange(), from->name()));
+            copy_item(static_cast<otio::Gap*>(from), copy.value);
+            return Retainer<otio::Composable>(copy.value);
         }
-        return result;
+        if (type == typeid(otio::Track) || type == typeid(otio::Stack)) {
+            return Retainer<otio::Composable>(composition(static_cast<otio::Composition*>(from)).value);
+        }
+        return generic_copy(from);
+    }
+
+    Retainer<otio::Timeline> timeline(otio::Timeline* from) const {
+        if (typeid(*from) != typeid(otio::Timeline)) return generic_copy(from);
+        Retainer<otio::Timeline> copy(new otio::Timeline(from->name(), from->global_start_time(), from->metadata()));
+        copy.value->dynamic_fields() = from->dynamic_fields();
+        if (otio::Stack* tracks = from->tracks()) {
+            auto stack = composable(tracks);
+            auto typed = counted_dynamic_cast<otio::Stack*>(stack.value);
+            if (!typed) throw std::runtime_error("Cannot clone the tracks of " + from->name());
+            copy.value->set_tracks(typed);
+        }
+        return copy;
+    }
+};
+
+// Clone a composable into an unparented object of the same handle type
+template<typename T>
+static T* clone_composable(T* obj, int32_t mode, OtioError* err) {
+    try {
+        ObjectCloner cloner{mode == OTIO_CLONE_SHARED};
+        auto copy = cloner.composable(obj);
+        auto typed = counted_dynamic_cast<T*>(copy.value);
+        if (!typed) throw std::runtime_error("Clone of " + obj->name() + " has a different schema");
+        copy.take_value();
+        return typed;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return result;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return result;
+        return nullptr;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Clip
-// ----------------------------------------------------------------------------
-
-OtioClip* otio_clip_create(const char* name, OtioTimeRange source_range) {
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        auto clip = new otio::Clip(name, nullptr, to_otio_tr(source_range));
-        Retainer<otio::Clip> retainer(clip);
-        return reinterpret_cast<OtioClip*>(retainer.take_value());
-    )
+// Shared markers and effects are copied before they are handed out for
+// editing, so that the edit stays in one tree (copy on write). Another
+// tree can only drop its reference meanwhile, never add one (that takes a
+// tree already holding the object), so a fork freed on another thread at
+// most costs a copy that was not needed.
+template<typename T>
+static T* unshared_attachment(Retainer<T>& slot) {
+    if (slot.value && slot.value->current_ref_count() > 1) slot = ObjectCloner::generic_copy(slot.value);
+    return slot.value;
 }
 
-int otio_clip_set_media_reference(OtioClip* clip, OtioExternalRef* ref, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
-    OTIO_TRY_INT(err,
-        OTIO_CAST(Clip, c, clip);
-        OTIO_CAST(ExternalReference, r, ref);
-        c->set_media_reference(r);
-    )
-}
+// ============================================================================
+// Fingerprints
+// ============================================================================
 
-char* otio_clip_get_name(OtioClip* clip) {
-    OTIO_NULL_CHECK(clip, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Clip, c, clip);
-        return safe_strdup(c->name());
-    )
-}
+// Streaming 64-bit hash with the rounds and final avalanche of xxHash64.
+// Values are fed as whole 64-bit words (bytes little-endian), and strings
+// are prefixed with their length so adjacent fields can't run together.
+struct Fingerprint {
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
 
-OtioTimeRange otio_clip_get_source_range(OtioClip* clip) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!clip) return zero;
-    try {
-        OTIO_CAST(Clip, c, clip);
-        auto sr = c->source_range();
-        if (sr.has_value()) {
-            auto& range = sr.value();
-            return OtioTimeRange{
-                OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-                OtioRationalTime{range.duration().value(), range.duration().rate()}
-            };
-        }
-    } catch (...) {
+    uint64_t state = kPrime5;
+
+    static uint64_t rotl(uint64_t v, int r) { return (v << r) | (v >> (64 - r)); }
+
+    void word(uint64_t v) {
+        state ^= rotl(v * kPrime2, 31) * kPrime1;
+        state = rotl(state, 27) * kPrime1 + kPrime4;
     }
-    return zero;
-}
 
-OtioTimeRange otio_clip_available_range(OtioClip* clip, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    OTIO_NULL_CHECK_ERR(clip, err, zero, "Clip is null");
-    try {
-        OTIO_CAST(Clip, c, clip);
-        otio::ErrorStatus status;
-        auto range = c->available_range(&status);
-        if (otio::is_error(status)) {
-            set_error(err, static_cast<int>(status.outcome), status.details.c_str());
-            return zero;
+    void bytes(const char* data, size_t size) {
+        word(size);
+        while (size > 0) {
+            const size_t n = std::min<size_t>(size, 8);
+            uint64_t v = 0;
+            for (size_t i = 0; i < n; ++i) v |= uint64_t(static_cast<unsigned char>(data[i])) << (8 * i);
+            word(v);
+            data += n;
+            size -= n;
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return zero;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return zero;
     }
-}
 
-// ----------------------------------------------------------------------------
-// Clip Multi-Reference Support
-// ----------------------------------------------------------------------------
+    void text(const std::string& s) { bytes(s.data(), s.size()); }
 
-struct OtioStringIterator {
-    std::vector<std::string> strings;
-    size_t index;
-    OtioStringIterator() : index(0) {}
+    // -0 hashes as 0 and every NaN alike, as they compare in OTIO
+    void number(double d) {
+        if (d == 0) d = 0;
+        if (std::isnan(d)) d = std::numeric_limits<double>::quiet_NaN();
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof bits);
+        word(bits);
+    }
+
+    void time(const otio::RationalTime& t) {
+        number(t.value());
+        number(t.rate());
+    }
+
+    void span(const otio::TimeRange& r) {
+        time(r.start_time());
+        time(r.duration());
+    }
+
+    void span(const std::optional<otio::TimeRange>& r) {
+        word(r ? 1 : 0);
+        if (r) span(*r);
+    }
+
+    uint64_t digest() const {
+        uint64_t h = state;
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
 };
 
-OtioStringIterator* otio_clip_media_reference_keys(OtioClip* clip) {
-    OTIO_NULL_CHECK(clip, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Clip, c, clip);
-        auto iter = new OtioStringIterator();
-        const auto& refs = c->media_references();
-        for (const auto& pair : refs) {
-            iter->strings.push_back(pair.first);
+// Digest of what feed adds to a fresh fingerprint
+template<typename F>
+static uint64_t digest_of(F&& feed) {
+    Fingerprint fp;
+    feed(fp);
+    return fp.digest();
+}
+
+// Digest of a composition's children in order. It sums one term per
+// position, so that a memoized digest can be updated for one changed child
+// without reading its siblings.
+struct ChildrenDigest {
+    uint64_t sum = 0;
+    uint64_t count = 0;
+
+    static uint64_t term(uint64_t index, uint64_t subtree) {
+        return digest_of([&](Fingerprint& fp) {
+            fp.word(index);
+            fp.word(subtree);
+        });
+    }
+
+    void add(uint64_t subtree) { sum += term(count++, subtree); }
+
+    void replace(uint64_t index, uint64_t from, uint64_t to) { sum += term(index, to) - term(index, from); }
+
+    uint64_t digest() const {
+        return digest_of([&](Fingerprint& fp) {
+            fp.word(count);
+            fp.word(sum);
+        });
+    }
+};
+
+// Memoized subtree fingerprints of a timeline's items. The mutation hooks
+// forget the entry of an edited item and mark, in each ancestor's entry,
+// the child on the path down to it; see lock_fingerprint_cache and
+// FingerprintWalker for their use.
+struct OtioFingerprintCache {
+    struct Entry {
+        Retainer<otio::Composable> item;  // Keeps the key's address from being reused
+        uint64_t subtree;
+        uint64_t range;
+        // Compositions only: the children's digest, their fingerprints and
+        // positions as of the digest, and the children forgotten since
+        ChildrenDigest children;
+        std::vector<uint64_t> child_prints;
+        std::unordered_map<const otio::Composable*, size_t> positions;
+        std::unordered_set<const otio::Composable*> dirty;
+    };
+
+    static constexpr size_t kMinCompactAt = 1024;
+
+    // Borrowed: the timeline outlives the cache. Rust owns timelines with a
+    // refcount of 0, so a Retainer here would delete it on release.
+    otio::Timeline* timeline;
+    Retainer<otio::Stack> tracks;
+    std::mutex mutex;
+    std::unordered_map<const otio::Composable*, Entry> memo;
+    size_t compact_at = kMinCompactAt;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    void forget(otio::Composable* obj) {
+        if (memo.empty()) return;
+        memo.erase(obj);
+        for (otio::Composable* node = obj; otio::Composition* parent = node->parent(); node = parent) {
+            auto it = memo.find(parent);
+            if (it != memo.end()) it->second.dirty.insert(node);
         }
-        return iter;
-    )
-}
+    }
 
-int32_t otio_string_iterator_count(OtioStringIterator* iter) {
-    if (!iter) return 0;
-    return static_cast<int32_t>(iter->strings.size());
+    // Drop the entries of items no longer under the tracks, once the memo
+    // has grown to twice its size after the previous compaction
+    void compact() {
+        if (memo.size() < compact_at) return;
+        for (auto it = memo.begin(); it != memo.end();) {
+            const otio::Composable* top = it->first;
+            while (top->parent()) top = top->parent();
+            it = top == tracks.value ? std::next(it) : memo.erase(it);
+        }
+        compact_at = std::max(kMinCompactAt, 2 * memo.size());
+    }
+};
+
+struct FingerprintRegistry {
+    std::mutex mutex;
+    std::unordered_map<const otio::Composable*, OtioFingerprintCache*> caches;  // By tracks
+    std::atomic<size_t> active{0};
+};
+
+static FingerprintRegistry& fingerprint_registry() {
+    static FingerprintRegistry registry;
+    return registry;
 }
 
-char* otio_string_iterator_next(OtioStringIterator* iter) {
-    if (!iter || iter->index >= iter->strings.size()) return nullptr;
-    return safe_strdup(iter->strings[iter->index++]);
+// Called by the mutation hooks for every change made through the shim
+static void forget_fingerprints(otio::Composable* obj) {
+    auto& registry = fingerprint_registry();
+    if (!obj || registry.active.load(std::memory_order_relaxed) == 0) return;
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& entry : registry.caches) {
+        std::lock_guard<std::mutex> cache_lock(entry.second->mutex);
+        entry.second->forget(obj);
+    }
 }
 
-void otio_string_iterator_reset(OtioStringIterator* iter) {
-    if (iter) iter->index = 0;
+// ============================================================================
+// Child range arithmetic
+// ============================================================================
+
+// Walks a composition's children in order, producing the same ranges as
+// Track/Stack::range_of_child_at_index without re-summing the preceding
+// siblings for every child.
+struct ChildRangeCursor {
+    bool is_track;
+    std::optional<otio::RationalTime> offset;  // Preceding non-overlapping durations
+
+    explicit ChildRangeCursor(const otio::Composition* comp)
+        : is_track(object_type_of(comp) == OTIO_CHILD_TYPE_TRACK) {}
+
+    bool next(otio::Composable* child, otio::TimeRange& range, otio::ErrorStatus* status) {
+        otio::RationalTime duration = child->duration(status);
+        if (otio::is_error(*status)) return false;
+        otio::RationalTime start(0, duration.rate());
+        if (is_track) {
+            if (offset) start += *offset;
+            if (object_type_of(child) == OTIO_CHILD_TYPE_TRANSITION) {
+                start -= static_cast<otio::Transition*>(child)->in_offset();
+            }
+            if (!child->overlapping()) offset = offset ? *offset + duration : duration;
+        }
+        range = otio::TimeRange(start, duration);
+        return true;
+    }
+};
+
+// ============================================================================
+// Template helpers for child operations
+// ============================================================================
+
+template<typename Container>
+static int32_t children_count_impl(Container* container) {
+    if (!container) return 0;
+    try {
+        return static_cast<int32_t>(container->children().size());
+    } catch (...) {
+        return 0;
+    }
 }
 
-void otio_string_iterator_free(OtioStringIterator* iter) {
-    delete iter;
+template<typename Container>
+static int32_t child_type_impl(Container* container, int32_t index) {
+    if (!container) return -1;
+    try {
+        auto& children = container->children();
+        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
+            return -1;
+        }
+        return object_type_of(children[index].value);
+    } catch (...) {
+        return -1;
+    }
 }
 
-char* otio_clip_active_media_reference_key(OtioClip* clip) {
-    OTIO_NULL_CHECK(clip, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Clip, c, clip);
-        return safe_strdup(c->active_media_reference_key());
-    )
+template<typename Container>
+static void* child_at_impl(Container* container, int32_t index) {
+    if (!container) return nullptr;
+    try {
+        auto& children = container->children();
+        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
+            return nullptr;
+        }
+        return children[index].value;
+    } catch (...) {
+        return nullptr;
+    }
 }
 
-int otio_clip_set_active_media_reference_key(OtioClip* clip, const char* key, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+template<typename Container, typename Child>
+static int append_child_impl(Container* container, Child* child, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
+    OTIO_NULL_CHECK_ERR(child, err, -1, "Child is null");
     try {
-        OTIO_CAST(Clip, c, clip);
-        c->set_active_media_reference_key(key);
+        otio::ErrorStatus status;
+        container->append_child(child, &status);
+        OTIO_CHECK_STATUS(status, err);
+        const size_t index = container->children().size() - 1;
+        note_children_changed(container, index);
+        journal_push(container, journal_inserted(container, index, 1));
         return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
@@ -659,37 +1401,21 @@ int otio_clip_set_active_media_reference_key(OtioClip* clip, const char* key, Ot
     }
 }
 
-int otio_clip_add_media_reference(OtioClip* clip, const char* key,
-                                   void* ref, int32_t ref_type, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
-    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
+template<typename Container, typename Child>
+static int insert_child_impl(Container* container, int32_t index, Child* child, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
+    OTIO_NULL_CHECK_ERR(child, err, -1, "Child is null");
     try {
-        OTIO_CAST(Clip, c, clip);
-        otio::MediaReference* media_ref = nullptr;
-        switch (ref_type) {
-            case 0: // OTIO_REF_TYPE_EXTERNAL
-                media_ref = reinterpret_cast<otio::ExternalReference*>(ref);
-                break;
-            case 1: // OTIO_REF_TYPE_MISSING
-                media_ref = reinterpret_cast<otio::MissingReference*>(ref);
-                break;
-            case 2: // OTIO_REF_TYPE_GENERATOR
-                media_ref = reinterpret_cast<otio::GeneratorReference*>(ref);
-                break;
-            case 3: // OTIO_REF_TYPE_IMAGE_SEQUENCE
-                media_ref = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-                break;
-            default:
-                set_error(err, 1, "Unknown reference type");
-                return -1;
+        otio::ErrorStatus status;
+        container->insert_child(index, child, &status);
+        OTIO_CHECK_STATUS(status, err);
+        // Out-of-range indices append; negative ones count from the end
+        size_t first = index < 0 ? 0 : static_cast<size_t>(index);
+        note_children_changed(container, std::min(first, container->children().size() - 1));
+        if (journal_wanted(container)) {
+            int at = container->index_of_child(child, &status);
+            if (at >= 0) journal_push(container, journal_inserted(container, static_cast<size_t>(at), 1));
         }
-        // Get existing references and add the new one
-        auto refs = c->media_references();
-        refs[key] = media_ref;
-        // Keep the current active key
-        std::string active_key = c->active_media_reference_key();
-        c->set_media_references(refs, active_key);
         return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
@@ -700,1666 +1426,6330 @@ int otio_clip_add_media_reference(OtioClip* clip, const char* key,
     }
 }
 
-int otio_clip_has_media_reference(OtioClip* clip, const char* key) {
-    if (!clip || !key) return 0;
+template<typename Container>
+static int remove_child_impl(Container* container, int32_t index, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
     try {
-        OTIO_CAST(Clip, c, clip);
-        const auto& refs = c->media_references();
-        return refs.find(key) != refs.end() ? 1 : 0;
+        auto& children = container->children();
+        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
+            set_error(err, 1, "Index out of bounds");
+            return -1;
+        }
+        Retainer<otio::Composable> removed(children[index].value);
+        otio::ErrorStatus status;
+        container->remove_child(index, &status);
+        OTIO_CHECK_STATUS(status, err);
+        note_children_changed(container, static_cast<size_t>(index));
+        if (journal_wanted(container)) {
+            journal_push(container, std::make_unique<SpliceRecord>(container, static_cast<size_t>(index), 0,
+                std::vector<Retainer<otio::Composable>>{removed}));
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+template<typename Container>
+static int clear_children_impl(Container* container, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
+    try {
+        std::vector<Retainer<otio::Composable>> removed;
+        const bool journaled = journal_wanted(container);
+        if (journaled) removed.assign(container->children().begin(), container->children().end());
+        container->clear_children();
+        note_children_changed(container, 0);
+        if (journaled && !removed.empty()) {
+            journal_push(container, std::make_unique<SpliceRecord>(container, 0, 0, std::move(removed)));
+        }
         return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Gap
-// ----------------------------------------------------------------------------
+// Cast a child handle to Composable according to its OTIO_CHILD_TYPE_* type
+static otio::Composable* cast_to_composable(void* ptr, int32_t type) {
+    if (!ptr) return nullptr;
+    switch (type) {
+        case OTIO_CHILD_TYPE_CLIP:
+            return reinterpret_cast<otio::Clip*>(ptr);
+        case OTIO_CHILD_TYPE_GAP:
+            return reinterpret_cast<otio::Gap*>(ptr);
+        case OTIO_CHILD_TYPE_STACK:
+            return reinterpret_cast<otio::Stack*>(ptr);
+        case OTIO_CHILD_TYPE_TRACK:
+            return reinterpret_cast<otio::Track*>(ptr);
+        case OTIO_CHILD_TYPE_TRANSITION:
+            return reinterpret_cast<otio::Transition*>(ptr);
+        default:
+            return nullptr;
+    }
+}
 
-OtioGap* otio_gap_create(OtioRationalTime duration) {
-    OTIO_TRY_PTR(
-        auto gap = new otio::Gap(otio::TimeRange(
-            otio::RationalTime(0, duration.rate),
-            to_otio_rt(duration)
-        ));
-        Retainer<otio::Gap> retainer(gap);
-        return reinterpret_cast<OtioGap*>(retainer.take_value());
-    )
+// Check a whole batch before any child is attached, so a bad entry leaves
+// the container untouched.
+static bool collect_new_children(const otio::Composition* container, void* const* items,
+    const int32_t* types, int32_t count, std::vector<otio::Composable*>& out, OtioError* err) {
+    if (count < 0 || (count > 0 && (!items || !types))) {
+        set_error(err, 1, "Invalid child arrays");
+        return false;
+    }
+    out.reserve(static_cast<size_t>(count));
+    std::unordered_set<const otio::Composable*> seen;
+    for (int32_t i = 0; i < count; ++i) {
+        otio::Composable* child = cast_to_composable(items[i], types[i]);
+        const std::string at = " at index " + std::to_string(i);
+        if (!child) {
+            set_error(err, 1, ("Invalid child" + at).c_str());
+            return false;
+        }
+        if (child->parent() || child == container) {
+            set_error(err, 1, ("Child" + at + " already has a parent").c_str());
+            return false;
+        }
+        if (!seen.insert(child).second) {
+            set_error(err, 1, ("Child" + at + " appears twice").c_str());
+            return false;
+        }
+        out.push_back(child);
+    }
+    return true;
 }
 
-char* otio_gap_get_name(OtioGap* gap) {
-    OTIO_NULL_CHECK(gap, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Gap, g, gap);
-        return safe_strdup(g->name());
-    )
+template<typename Container>
+static int append_children_impl(Container* container, void* const* items, const int32_t* types,
+    int32_t count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
+    try {
+        std::vector<otio::Composable*> added;
+        if (!collect_new_children(container, items, types, count, added, err)) return -1;
+        if (added.empty()) return 0;
+        const size_t first = container->children().size();
+        // Appending is amortized O(1) per child already; the win is one call
+        for (auto child : added) {
+            otio::ErrorStatus status;
+            container->append_child(child, &status);
+            if (otio::is_error(status)) {
+                note_children_changed(container, first);
+                journal_push(container,
+                    journal_inserted(container, first, container->children().size() - first));
+                set_error(err, 1, status.full_description.c_str());
+                return -1;
+            }
+        }
+        note_children_changed(container, first);
+        journal_push(container, journal_inserted(container, first, added.size()));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
 }
 
-// ----------------------------------------------------------------------------
-// ExternalReference
-// ----------------------------------------------------------------------------
+template<typename Container>
+static int insert_children_impl(Container* container, int32_t index, void* const* items,
+    const int32_t* types, int32_t count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(container, err, -1, "Container is null");
+    try {
+        std::vector<otio::Composable*> added;
+        if (!collect_new_children(container, items, types, count, added, err)) return -1;
+        if (added.empty()) return 0;
+
+        // Same index rules as insert_child: negative counts from the end,
+        // past the end appends
+        const auto& children = container->children();
+        const int64_t size = static_cast<int64_t>(children.size());
+        int64_t at = index < 0 ? size + index : index;
+        const size_t pos = static_cast<size_t>(std::clamp<int64_t>(at, 0, size));
+
+        // Build the new order once instead of shifting the vector per child.
+        // The retainers keep existing children alive while detached.
+        std::vector<Retainer<otio::Composable>> keep(children.begin(), children.end());
+        std::vector<otio::Composable*> order;
+        order.reserve(keep.size() + added.size());
+        for (size_t i = 0; i < pos; ++i) order.push_back(keep[i].value);
+        order.insert(order.end(), added.begin(), added.end());
+        for (size_t i = pos; i < keep.size(); ++i) order.push_back(keep[i].value);
 
-OtioExternalRef* otio_external_ref_create(const char* target_url) {
-    OTIO_NULL_CHECK(target_url, nullptr);
-    OTIO_TRY_PTR(
-        auto ref = new otio::ExternalReference(target_url);
-        Retainer<otio::ExternalReference> retainer(ref);
-        return reinterpret_cast<OtioExternalRef*>(retainer.take_value());
-    )
+        container->clear_children();
+        otio::ErrorStatus status;
+        container->set_children(order, &status);
+        if (otio::is_error(status)) {
+            // Restore the original children; the new ones stay unparented
+            std::vector<otio::Composable*> original;
+            original.reserve(keep.size());
+            for (const auto& child : keep) original.push_back(child.value);
+            container->clear_children();
+            otio::ErrorStatus restore_status;
+            container->set_children(original, &restore_status);
+            note_children_changed(container, 0);
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        note_children_changed(container, pos);
+        journal_push(container, journal_inserted(container, pos, added.size()));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
 }
 
-int otio_external_ref_set_available_range(OtioExternalRef* ref, OtioTimeRange range, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
-    OTIO_TRY_INT(err,
-        OTIO_CAST(ExternalReference, r, ref);
-        r->set_available_range(to_otio_tr(range));
-    )
-}
+// ============================================================================
+// Parent navigation helpers (templates - must be before extern "C")
+// ============================================================================
 
-void otio_external_ref_free(OtioExternalRef* ref) {
-    // ExternalReferences are typically owned by clips via set_media_reference.
-    // This function exists for API completeness but the reference is managed
-    // by OTIO's reference counting when attached to a clip.
-    (void)ref;
+// Helper to determine parent type
+template<typename T>
+static int32_t get_parent_type_impl(T* obj) {
+    if (!obj) return OTIO_PARENT_TYPE_NONE;
+    try {
+        auto parent = obj->parent();
+        if (!parent) return OTIO_PARENT_TYPE_NONE;
+        switch (object_type_of(parent)) {
+            case OTIO_CHILD_TYPE_TRACK: return OTIO_PARENT_TYPE_TRACK;
+            case OTIO_CHILD_TYPE_STACK: return OTIO_PARENT_TYPE_STACK;
+            default: return OTIO_PARENT_TYPE_NONE;
+        }
+    } catch (...) {
+        return OTIO_PARENT_TYPE_NONE;
+    }
 }
 
-// ----------------------------------------------------------------------------
-// Stack
-// ----------------------------------------------------------------------------
-
-OtioStack* otio_stack_create(const char* name) {
-    OTIO_NULL_CHECK(name, nullptr);
-    OTIO_TRY_PTR(
-        auto stack = new otio::Stack(name);
-        Retainer<otio::Stack> retainer(stack);
-        return reinterpret_cast<OtioStack*>(retainer.take_value());
-    )
+template<typename T>
+static void* get_parent_impl(T* obj) {
+    if (!obj) return nullptr;
+    try {
+        return obj->parent();
+    } catch (...) {
+        return nullptr;
+    }
 }
 
-void otio_stack_free(OtioStack* stack) {
-    if (stack) {
-        try {
-            OTIO_CAST(Stack, s, stack);
-            Retainer<otio::Stack> retainer(s);
-        } catch (...) {
-            // Ignore exceptions during cleanup
+// Helper to recursively visit the clips of a composition in document order
+template<typename Visit>
+static void for_each_clip(otio::Composition* comp, Visit& visit) {
+    if (!comp) return;
+    for (auto& child : comp->children()) {
+        switch (object_type_of(child.value)) {
+            case OTIO_CHILD_TYPE_CLIP:
+                visit(static_cast<otio::Clip*>(child.value));
+                break;
+            case OTIO_CHILD_TYPE_TRACK:
+            case OTIO_CHILD_TYPE_STACK:
+                for_each_clip(static_cast<otio::Composition*>(child.value), visit);
+                break;
+            case -1:
+                // Composition subclass without a tag of its own
+                if (auto nested = counted_dynamic_cast<otio::Composition*>(child.value)) {
+                    for_each_clip(nested, visit);
+                }
+                break;
+            default:
+                break;
         }
     }
 }
 
-int otio_stack_append_track(OtioStack* stack, OtioTrack* track, OtioError* err) {
-    return append_child_impl<otio::Stack, otio::Track>(
-        reinterpret_cast<otio::Stack*>(stack),
-        reinterpret_cast<otio::Track*>(track), err);
+static void find_clips_recursive(otio::Composition* comp, std::vector<otio::Clip*>& clips) {
+    auto push = [&](otio::Clip* clip) { clips.push_back(clip); };
+    for_each_clip(comp, push);
 }
 
-int otio_stack_append_clip(OtioStack* stack, OtioClip* clip, OtioError* err) {
-    return append_child_impl<otio::Stack, otio::Clip>(
-        reinterpret_cast<otio::Stack*>(stack),
-        reinterpret_cast<otio::Clip*>(clip), err);
-}
+// Writes handles into a caller array with the count protocol of the *_into
+// exports: every handle is counted, only the first capacity are stored.
+template<typename Handle>
+struct HandleSink {
+    Handle** out;
+    int32_t capacity;
+    int32_t total = 0;
 
-int otio_stack_append_gap(OtioStack* stack, OtioGap* gap, OtioError* err) {
-    return append_child_impl<otio::Stack, otio::Gap>(
-        reinterpret_cast<otio::Stack*>(stack),
-        reinterpret_cast<otio::Gap*>(gap), err);
+    HandleSink(Handle** out_, int32_t capacity_) : out(out_), capacity(out_ ? capacity_ : 0) {}
+
+    void operator()(void* handle) {
+        if (total < capacity) out[total] = static_cast<Handle*>(handle);
+        ++total;
+    }
+};
+
+// ============================================================================
+// Worker pool
+// ============================================================================
+
+// Run body(i) for every i in [0, count) on up to thread_count threads, the
+// calling thread included; thread_count <= 0 means one per hardware thread.
+// Indices are handed out one at a time, so a few huge items don't leave the
+// other workers idle. body must not throw.
+static size_t worker_count(int32_t thread_count) {
+    return thread_count > 0
+        ? static_cast<size_t>(thread_count)
+        : std::max(1u, std::thread::hardware_concurrency());
+}
+
+static void parallel_for(size_t count, int32_t thread_count, const std::function<void(size_t)>& body) {
+    const size_t workers = std::min(worker_count(thread_count), count);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) body(i);
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    try {
+        while (threads.size() < workers - 1) threads.emplace_back(run);
+    } catch (const std::system_error&) {
+        // Out of threads; whoever did start (and this thread) drains the rest
+    }
+    run();
+    for (auto& t : threads) t.join();
 }
 
-int otio_stack_append_stack(OtioStack* stack, OtioStack* child, OtioError* err) {
-    return append_child_impl<otio::Stack, otio::Stack>(
-        reinterpret_cast<otio::Stack*>(stack),
-        reinterpret_cast<otio::Stack*>(child), err);
+// ============================================================================
+// Background release
+// ============================================================================
+
+// Tearing down a large timeline deletes every object, string and metadata
+// value one at a time. Timelines marked for background release are instead
+// handed to a single reaper thread when freed, so the caller only pays for
+// a queue push. Objects still retained elsewhere (caches, indexes, other
+// handles) stay alive exactly as with an immediate release. After draining
+// the queue the reaper returns freed memory to the system where the
+// allocator supports it, which limits the fragmentation that piles up in
+// long-running processes.
+class ReleaseQueue {
+public:
+    static ReleaseQueue& instance() {
+        // Never destroyed: the reaper may still be running at exit
+        static ReleaseQueue* queue = new ReleaseQueue();
+        return *queue;
+    }
+
+    void mark(const otio::Timeline* tl, bool enabled) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (enabled) {
+            _marked.insert(tl);
+        } else {
+            _marked.erase(tl);
+        }
+    }
+
+    // Take over tl if it is marked; false means the caller releases it
+    bool release(otio::Timeline* tl) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_marked.erase(tl) == 0) return false;
+        if (!_started) {
+            try {
+                std::thread(&ReleaseQueue::run, this).detach();
+            } catch (const std::system_error&) {
+                return false;
+            }
+            _started = true;
+        }
+        _pending.emplace_back(tl);
+        lock.unlock();
+        _wake.notify_one();
+        return true;
+    }
+
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _pending.empty() && !_busy; });
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            _wake.wait(lock, [this] { return !_pending.empty(); });
+            _busy = true;
+            while (!_pending.empty()) {
+                Retainer<otio::Timeline> next(std::move(_pending.front()));
+                _pending.pop_front();
+                lock.unlock();
+                next = Retainer<otio::Timeline>();  // The teardown, outside the lock
+                lock.lock();
+            }
+#if defined(__GLIBC__)
+            lock.unlock();
+            malloc_trim(0);
+            lock.lock();
+#endif
+            // More may have arrived while trimming
+            if (!_pending.empty()) continue;
+            _busy = false;
+            _idle.notify_all();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::unordered_set<const otio::Timeline*> _marked;
+    std::deque<Retainer<otio::Timeline>> _pending;
+    bool _started = false;
+    bool _busy = false;
+};
+
+// ============================================================================
+// JSON pruning helpers for selective loading
+// ============================================================================
+
+// The selective loader rewrites the document before handing it to OTIO's parser: the
+// children of unselected root-stack tracks become [] and objects with a
+// skipped schema are dropped from arrays. The scanner below only finds value
+// boundaries; malformed input is left for the real parser to report.
+
+struct JsonSpan {
+    size_t begin;
+    size_t end;
+};
+
+struct JsonMember {
+    JsonSpan key;   // Without the quotes
+    JsonSpan value;
+};
+
+static size_t json_skip_ws(const std::string& s, size_t i) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r')) ++i;
+    return i;
 }
 
-int32_t otio_stack_children_count(OtioStack* stack) {
-    return children_count_impl(reinterpret_cast<otio::Stack*>(stack));
+// Advance past the string starting at s[i] == '"'; npos if unterminated
+static size_t json_skip_string(const std::string& s, size_t i) {
+    for (++i; i < s.size(); ++i) {
+        if (s[i] == '\\') {
+            ++i;
+        } else if (s[i] == '"') {
+            return i + 1;
+        }
+    }
+    return std::string::npos;
+}
+
+// Advance past the value starting at s[i]; npos if unterminated
+static size_t json_skip_value(const std::string& s, size_t i) {
+    if (i >= s.size()) return std::string::npos;
+    if (s[i] == '"') return json_skip_string(s, i);
+    if (s[i] == '{' || s[i] == '[') {
+        int depth = 0;
+        while (i < s.size()) {
+            char c = s[i];
+            if (c == '"') {
+                i = json_skip_string(s, i);
+                if (i == std::string::npos) return i;
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return i + 1;
+            }
+            ++i;
+        }
+        return std::string::npos;
+    }
+    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ']' &&
+           s[i] != ' ' && s[i] != '\t' && s[i] != '\n' && s[i] != '\r') {
+        ++i;
+    }
+    return i;
+}
+
+static bool json_object_members(const std::string& s, JsonSpan obj, std::vector<JsonMember>& out) {
+    size_t i = json_skip_ws(s, obj.begin + 1);
+    if (i < obj.end && s[i] == '}') return true;
+    while (i < obj.end && s[i] == '"') {
+        size_t key_end = json_skip_string(s, i);
+        if (key_end == std::string::npos) return false;
+        JsonSpan key{i + 1, key_end - 1};
+        i = json_skip_ws(s, key_end);
+        if (i >= obj.end || s[i] != ':') return false;
+        i = json_skip_ws(s, i + 1);
+        size_t value_end = json_skip_value(s, i);
+        if (value_end == std::string::npos || value_end > obj.end) return false;
+        out.push_back(JsonMember{key, JsonSpan{i, value_end}});
+        i = json_skip_ws(s, value_end);
+        if (i < obj.end && s[i] == '}') return true;
+        if (i >= obj.end || s[i] != ',') return false;
+        i = json_skip_ws(s, i + 1);
+    }
+    return false;
+}
+
+static bool json_array_elements(const std::string& s, JsonSpan arr, std::vector<JsonSpan>& out) {
+    size_t i = json_skip_ws(s, arr.begin + 1);
+    if (i < arr.end && s[i] == ']') return true;
+    while (i < arr.end) {
+        size_t value_end = json_skip_value(s, i);
+        if (value_end == std::string::npos || value_end > arr.end) return false;
+        out.push_back(JsonSpan{i, value_end});
+        i = json_skip_ws(s, value_end);
+        if (i < arr.end && s[i] == ']') return true;
+        if (i >= arr.end || s[i] != ',') return false;
+        i = json_skip_ws(s, i + 1);
+    }
+    return false;
 }
 
-int32_t otio_stack_child_type(OtioStack* stack, int32_t index) {
-    return child_type_impl(reinterpret_cast<otio::Stack*>(stack), index);
+static bool json_span_equals(const std::string& s, JsonSpan span, const char* text) {
+    size_t len = strlen(text);
+    return span.end - span.begin == len && s.compare(span.begin, len, text) == 0;
 }
 
-void* otio_stack_child_at(OtioStack* stack, int32_t index) {
-    return child_at_impl(reinterpret_cast<otio::Stack*>(stack), index);
+// Value of a string member of an object, without the quotes
+static bool json_find_string_member(const std::string& s, JsonSpan obj, const char* key, JsonSpan& value) {
+    if (s[obj.begin] != '{') return false;
+    std::vector<JsonMember> members;
+    if (!json_object_members(s, obj, members)) return false;
+    for (const auto& m : members) {
+        if (json_span_equals(s, m.key, key) && s[m.value.begin] == '"') {
+            value = JsonSpan{m.value.begin + 1, m.value.end - 1};
+            return true;
+        }
+    }
+    return false;
 }
 
-int otio_stack_remove_child(OtioStack* stack, int32_t index, OtioError* err) {
-    return remove_child_impl(reinterpret_cast<otio::Stack*>(stack), index, err);
+struct LoadRules {
+    int32_t track_kinds = 0;
+    bool all_indices = true;
+    std::vector<int32_t> track_indices;
+    std::vector<std::string> skip_schemas;
+};
+
+static LoadRules load_rules_from_filter(const OtioLoadFilter* filter) {
+    LoadRules rules;
+    if (!filter) return rules;
+    rules.track_kinds = filter->track_kinds;
+    if (filter->track_indices) {
+        rules.all_indices = false;
+        rules.track_indices.assign(filter->track_indices, filter->track_indices + std::max(filter->track_index_count, 0));
+    }
+    for (int32_t i = 0; filter->skip_schemas && i < filter->skip_schema_count; ++i) {
+        if (filter->skip_schemas[i]) rules.skip_schemas.emplace_back(filter->skip_schemas[i]);
+    }
+    return rules;
 }
 
-int otio_stack_insert_track(OtioStack* stack, int32_t index, OtioTrack* track, OtioError* err) {
-    return insert_child_impl<otio::Stack, otio::Track>(
-        reinterpret_cast<otio::Stack*>(stack), index,
-        reinterpret_cast<otio::Track*>(track), err);
+// "Marker" matches any Marker version, "Marker.2" only that one
+static bool schema_is_skipped(const LoadRules& rules, const std::string& s, JsonSpan schema) {
+    std::string full = s.substr(schema.begin, schema.end - schema.begin);
+    std::string name = full.substr(0, full.find('.'));
+    for (const auto& skip : rules.skip_schemas) {
+        if (skip == full || skip == name) return true;
+    }
+    return false;
 }
 
-int otio_stack_insert_clip(OtioStack* stack, int32_t index, OtioClip* clip, OtioError* err) {
-    return insert_child_impl<otio::Stack, otio::Clip>(
-        reinterpret_cast<otio::Stack*>(stack), index,
-        reinterpret_cast<otio::Clip*>(clip), err);
+static bool track_is_selected(const LoadRules& rules, const std::string& s, JsonSpan track, int32_t index) {
+    // Anything other than a Track in the timeline's stack is always loaded
+    JsonSpan schema{};
+    if (!json_find_string_member(s, track, "OTIO_SCHEMA", schema) ||
+        s.compare(schema.begin, 6, "Track.") != 0) {
+        return true;
+    }
+    if (!rules.all_indices &&
+        std::find(rules.track_indices.begin(), rules.track_indices.end(), index) == rules.track_indices.end()) {
+        return false;
+    }
+    if (rules.track_kinds == 0) return true;
+    JsonSpan kind{};
+    if (!json_find_string_member(s, track, "kind", kind)) return false;
+    if (json_span_equals(s, kind, otio::Track::Kind::video)) {
+        return (rules.track_kinds & (1 << OTIO_TRACK_KIND_VIDEO)) != 0;
+    }
+    if (json_span_equals(s, kind, otio::Track::Kind::audio)) {
+        return (rules.track_kinds & (1 << OTIO_TRACK_KIND_AUDIO)) != 0;
+    }
+    return false;
 }
 
-int otio_stack_insert_gap(OtioStack* stack, int32_t index, OtioGap* gap, OtioError* err) {
-    return insert_child_impl<otio::Stack, otio::Gap>(
-        reinterpret_cast<otio::Stack*>(stack), index,
-        reinterpret_cast<otio::Gap*>(gap), err);
+enum class JsonRole { Other, Timeline, RootStack, TrackList, SkippedTrack };
+
+struct SkippedTrack {
+    int32_t index;
+    std::string json;
+};
+
+static bool write_pruned(const std::string& s, JsonSpan v, const LoadRules& rules, JsonRole role,
+                         std::string& out, std::vector<SkippedTrack>* skipped) {
+    // Nothing to rewrite below this point
+    if (role == JsonRole::Other && rules.skip_schemas.empty()) {
+        out.append(s, v.begin, v.end - v.begin);
+        return true;
+    }
+    if (s[v.begin] == '{') {
+        std::vector<JsonMember> members;
+        if (!json_object_members(s, v, members)) return false;
+        out += '{';
+        for (size_t i = 0; i < members.size(); ++i) {
+            const auto& m = members[i];
+            if (i > 0) out += ',';
+            out.append(s, m.key.begin - 1, m.key.end - m.key.begin + 2);
+            out += ':';
+            JsonRole member_role = JsonRole::Other;
+            if (role == JsonRole::Timeline && json_span_equals(s, m.key, "tracks")) {
+                member_role = JsonRole::RootStack;
+            } else if (role == JsonRole::RootStack && json_span_equals(s, m.key, "children")) {
+                member_role = JsonRole::TrackList;
+            } else if (role == JsonRole::SkippedTrack && json_span_equals(s, m.key, "children")) {
+                out += "[]";
+                continue;
+            }
+            if (!write_pruned(s, m.value, rules, member_role, out, skipped)) return false;
+        }
+        out += '}';
+        return true;
+    }
+    if (s[v.begin] == '[') {
+        std::vector<JsonSpan> elements;
+        if (!json_array_elements(s, v, elements)) return false;
+        out += '[';
+        bool first = true;
+        for (size_t i = 0; i < elements.size(); ++i) {
+            const auto& e = elements[i];
+            JsonRole element_role = JsonRole::Other;
+            if (role == JsonRole::TrackList) {
+                // Tracks are never dropped so indices stay stable
+                auto index = static_cast<int32_t>(i);
+                if (!track_is_selected(rules, s, e, index)) {
+                    element_role = JsonRole::SkippedTrack;
+                    if (skipped) skipped->push_back(SkippedTrack{index, s.substr(e.begin, e.end - e.begin)});
+                }
+            } else {
+                JsonSpan schema{};
+                if (json_find_string_member(s, e, "OTIO_SCHEMA", schema) && schema_is_skipped(rules, s, schema)) {
+                    continue;
+                }
+            }
+            if (!first) out += ',';
+            first = false;
+            if (!write_pruned(s, e, rules, element_role, out, skipped)) return false;
+        }
+        out += ']';
+        return true;
+    }
+    out.append(s, v.begin, v.end - v.begin);
+    return true;
 }
 
-int otio_stack_insert_stack(OtioStack* stack, int32_t index, OtioStack* child, OtioError* err) {
-    return insert_child_impl<otio::Stack, otio::Stack>(
-        reinterpret_cast<otio::Stack*>(stack), index,
-        reinterpret_cast<otio::Stack*>(child), err);
+template<typename T>
+static Retainer<T> parse_pruned(const std::string& source, const LoadRules& rules, JsonRole role,
+                                std::vector<SkippedTrack>* skipped, const char* type_error, OtioError* err) {
+    size_t begin = json_skip_ws(source, 0);
+    size_t end = json_skip_value(source, begin);
+    std::string pruned;
+    if (end == std::string::npos || !write_pruned(source, JsonSpan{begin, end}, rules, role, pruned, skipped)) {
+        set_error(err, 1, "Malformed JSON document");
+        return Retainer<T>();
+    }
+    OTIO_STATS_SCOPE(OTIO_STAT_PARSE);
+    OTIO_STATS_BYTES(OTIO_STAT_PARSE, pruned.size());
+    otio::ErrorStatus status;
+    auto result = otio::SerializableObject::from_json_string(pruned, &status);
+    if (otio::is_error(status) || !result) {
+        set_error(err, 1, status.full_description.c_str());
+        return Retainer<T>();
+    }
+    Retainer<otio::SerializableObject> object(result);
+    auto typed = counted_dynamic_cast<T*>(result);
+    if (!typed) {
+        set_error(err, 1, type_error);
+        return Retainer<T>();
+    }
+    return Retainer<T>(typed);
 }
 
-int otio_stack_clear_children(OtioStack* stack, OtioError* err) {
-    return clear_children_impl(reinterpret_cast<otio::Stack*>(stack), err);
+// ============================================================================
+// Compressed files
+// ============================================================================
+
+// Files are sniffed by their first bytes, so readers accept gzip-compressed
+// documents under any name. zlib is optional (OTIO_SHIM_WITH_ZLIB); without
+// it compressed files are reported as unsupported rather than misparsed.
+
+static constexpr size_t kFileChunk = 64 * 1024;
+
+static OtioTimeline* timeline_from_json(const std::string& json, const char* type_error, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_PARSE);
+    OTIO_STATS_BYTES(OTIO_STAT_PARSE, json.size());
+    otio::ErrorStatus status;
+    auto result = otio::SerializableObject::from_json_string(json, &status);
+    if (otio::is_error(status) || !result) {
+        set_error(err, 1, status.full_description.c_str());
+        return nullptr;
+    }
+    auto timeline = counted_dynamic_cast<otio::Timeline*>(result);
+    if (!timeline) {
+        set_error(err, 1, type_error);
+        Retainer<otio::SerializableObject> retainer(result);
+        return nullptr;
+    }
+    Retainer<otio::Timeline> retainer(timeline);
+    return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+}
+
+static bool file_is_gzip(std::istream& file) {
+    char magic[2] = {0, 0};
+    file.read(magic, sizeof magic);
+    bool gzip = file.gcount() == 2 && static_cast<unsigned char>(magic[0]) == 0x1f &&
+                static_cast<unsigned char>(magic[1]) == 0x8b;
+    file.clear();
+    file.seekg(0);
+    return gzip;
+}
+
+#ifdef OTIO_SHIM_HAVE_ZLIB
+// Inflate a gzip stream chunk by chunk into out; concatenated members (as
+// written by `cat a.gz b.gz`) are read as one document.
+static bool inflate_gzip(std::istream& file, std::string& out, OtioError* err) {
+    z_stream zs{};
+    // 15 window bits, +16 to expect a gzip header
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) {
+        set_error(err, 1, "Could not initialize gzip decompression");
+        return false;
+    }
+    std::vector<char> in(kFileChunk);
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END || zs.avail_in > 0 || file) {
+        if (zs.avail_in == 0) {
+            file.read(in.data(), static_cast<std::streamsize>(in.size()));
+            zs.next_in = reinterpret_cast<Bytef*>(in.data());
+            zs.avail_in = static_cast<uInt>(file.gcount());
+            if (zs.avail_in == 0) break;
+        }
+        if (ret == Z_STREAM_END) inflateReset(&zs);
+        size_t used = out.size();
+        out.resize(used + kFileChunk);
+        zs.next_out = reinterpret_cast<Bytef*>(&out[used]);
+        zs.avail_out = static_cast<uInt>(kFileChunk);
+        ret = inflate(&zs, Z_NO_FLUSH);
+        out.resize(out.size() - zs.avail_out);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) break;
+    }
+    inflateEnd(&zs);
+    if (ret != Z_STREAM_END || file.bad()) {
+        set_error(err, 1, "Truncated or corrupt gzip file");
+        return false;
+    }
+    return true;
 }
 
-char* otio_stack_get_name(OtioStack* stack) {
-    OTIO_NULL_CHECK(stack, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Stack, s, stack);
-        return safe_strdup(s->name());
-    )
+// Deflate data to a gzip file a chunk at a time, so the compressed document
+// is never held in memory whole.
+static bool write_gzip_file(const char* path, const std::string& data, int32_t level, OtioError* err) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        set_error(err, 1, "Could not open file for writing");
+        return false;
+    }
+    z_stream zs{};
+    if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        set_error(err, 1, "Could not initialize gzip compression");
+        return false;
+    }
+    std::vector<char> out(kFileChunk);
+    size_t pos = 0;
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END) {
+        if (zs.avail_in == 0 && pos < data.size()) {
+            size_t n = std::min(data.size() - pos, kFileChunk * 16);
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + pos));
+            zs.avail_in = static_cast<uInt>(n);
+            pos += n;
+        }
+        zs.next_out = reinterpret_cast<Bytef*>(out.data());
+        zs.avail_out = static_cast<uInt>(out.size());
+        ret = deflate(&zs, pos == data.size() ? Z_FINISH : Z_NO_FLUSH);
+        if (ret == Z_STREAM_ERROR) break;
+        file.write(out.data(), static_cast<std::streamsize>(out.size() - zs.avail_out));
+        if (!file) break;
+    }
+    deflateEnd(&zs);
+    if (ret != Z_STREAM_END || !file.flush()) {
+        set_error(err, 1, "Could not write gzip file");
+        return false;
+    }
+    return true;
 }
+#endif
 
-char* otio_track_get_name(OtioTrack* track) {
-    OTIO_NULL_CHECK(track, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Track, t, track);
-        return safe_strdup(t->name());
-    )
+// Whole contents of path, decompressed if it is a gzip file
+static bool read_document_file(const char* path, std::string& out, OtioError* err) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        set_error(err, 1, "Could not open file");
+        return false;
+    }
+    if (file_is_gzip(file)) {
+#ifdef OTIO_SHIM_HAVE_ZLIB
+        return inflate_gzip(file, out, err);
+#else
+        set_error(err, 1, "File is gzip-compressed, but otio_shim was built without zlib");
+        return false;
+#endif
+    }
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+        set_error(err, 1, "Could not read file");
+        return false;
+    }
+    return true;
 }
 
-// ----------------------------------------------------------------------------
-// Serialization
-// ----------------------------------------------------------------------------
+// ============================================================================
+// Binary serialization helpers
+// ============================================================================
 
-int otio_timeline_write_to_file(OtioTimeline* tl, const char* path, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
-    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
-    OTIO_TRY_INT(err,
-        OTIO_CAST(Timeline, timeline, tl);
-        otio::ErrorStatus status;
-        bool success = timeline->to_json_file(path, &status);
-        if (!success || otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
+// OTIO's encoder and decoder are internal, so the binary form is a lossless
+// transcoding of the JSON document OTIO writes. Strings are kept exactly as
+// they appear in the JSON text, escapes included, and interned; RationalTime
+// objects and other doubles are stored as raw IEEE bits, which keeps them
+// exact and small. Decoding writes the JSON text back out, doubles as their
+// shortest round-trip decimal form, and OTIO's reader then parses that text
+// as usual, so the format saves size and I/O, not the JSON parse. See
+// otio_shim.h for the layout.
+
+static const char kBinaryMagic[8] = {'O', 'T', 'I', 'O', 'B', 'I', 'N', 1};
+
+enum BinaryTag : uint8_t {
+    kBinNull = 0,
+    kBinFalse = 1,
+    kBinTrue = 2,
+    kBinInt = 3,
+    kBinDouble = 4,
+    kBinString = 5,
+    kBinStringRef = 6,
+    kBinPath = 7,
+    kBinObject = 8,
+    kBinArray = 9,
+    kBinEnd = 10,
+    kBinRationalTime = 11,
+    kBinNumber = 12,
+};
+
+// Nesting limit when decoding, so a hostile buffer can't exhaust the stack
+static constexpr int kMaxBinaryDepth = 512;
+
+class BinaryEncoder {
+public:
+    explicit BinaryEncoder(const std::string& json) : _s(json) {
+        _out.reserve(json.size() / 3);
+        _out.append(kBinaryMagic, sizeof kBinaryMagic);
+    }
+
+    std::string take(OtioError* err) {
+        size_t i = json_skip_ws(_s, 0);
+        i = value(i);
+        if (i == std::string::npos || json_skip_ws(_s, i) != _s.size()) {
+            set_error(err, 1, "Malformed JSON document");
+            return std::string();
         }
-    )
+        return std::move(_out);
+    }
+
+private:
+    const std::string& _s;
+    std::string _out;
+    std::unordered_map<std::string_view, uint32_t> _strings;
+
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            _out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        _out.push_back(static_cast<char>(v));
+    }
+
+    void raw_double(double d) {
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof bits);
+        for (int i = 0; i < 8; ++i) _out.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+    }
+
+    void interned(std::string_view text) {
+        auto found = _strings.find(text);
+        if (found != _strings.end()) {
+            _out.push_back(static_cast<char>(kBinStringRef));
+            varint(found->second);
+            return;
+        }
+        _strings.emplace(text, static_cast<uint32_t>(_strings.size()));
+        _out.push_back(static_cast<char>(kBinString));
+        varint(text.size());
+        _out.append(text.data(), text.size());
+    }
+
+    // Contents of the string token at s[i] == '"'; npos if unterminated
+    size_t string(size_t i, bool split_path) {
+        size_t end = json_skip_string(_s, i);
+        if (end == std::string::npos) return end;
+        std::string_view text(_s.data() + i + 1, end - i - 2);
+        // URLs and file paths share their directories; intern those apart
+        size_t slash = split_path ? text.rfind('/') : std::string_view::npos;
+        if (slash != std::string_view::npos && slash > 0 && slash + 1 < text.size()) {
+            _out.push_back(static_cast<char>(kBinPath));
+            interned(text.substr(0, slash + 1));
+            interned(text.substr(slash + 1));
+        } else {
+            interned(text);
+        }
+        return end;
+    }
+
+    static bool is_double_token(std::string_view token) {
+        return token.find_first_of(".eEnNiI") != std::string_view::npos;
+    }
+
+    static bool parse_double(std::string_view token, double* out) {
+        if (token == "NaN") {
+            *out = std::numeric_limits<double>::quiet_NaN();
+        } else if (token == "Infinity" || token == "-Infinity") {
+            *out = token[0] == '-' ? -std::numeric_limits<double>::infinity()
+                                   : std::numeric_limits<double>::infinity();
+        } else {
+            auto result = std::from_chars(token.data(), token.data() + token.size(), *out);
+            return result.ec == std::errc() && result.ptr == token.data() + token.size();
+        }
+        return true;
+    }
+
+    size_t scalar(size_t i) {
+        size_t end = json_skip_value(_s, i);
+        if (end == std::string::npos || end == i) return std::string::npos;
+        std::string_view token(_s.data() + i, end - i);
+        if (token == "null") {
+            _out.push_back(static_cast<char>(kBinNull));
+        } else if (token == "true") {
+            _out.push_back(static_cast<char>(kBinTrue));
+        } else if (token == "false") {
+            _out.push_back(static_cast<char>(kBinFalse));
+        } else if (is_double_token(token)) {
+            double d;
+            if (!parse_double(token, &d)) return std::string::npos;
+            _out.push_back(static_cast<char>(kBinDouble));
+            raw_double(d);
+        } else {
+            int64_t n;
+            auto result = std::from_chars(token.data(), token.data() + token.size(), n);
+            if (result.ec == std::errc() && result.ptr == token.data() + token.size()) {
+                _out.push_back(static_cast<char>(kBinInt));
+                varint((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+            } else {
+                // Integers beyond int64 keep their text
+                _out.push_back(static_cast<char>(kBinNumber));
+                varint(token.size());
+                _out.append(token.data(), token.size());
+            }
+        }
+        return end;
+    }
+
+    // Match literal at s[i] after whitespace; npos if it isn't there
+    size_t expect(size_t i, const char* literal) {
+        i = json_skip_ws(_s, i);
+        size_t len = strlen(literal);
+        return _s.compare(i, len, literal) == 0 ? i + len : std::string::npos;
+    }
+
+    size_t double_member(size_t i, const char* key, double* out) {
+        i = expect(i, key);
+        if (i != std::string::npos) i = expect(i, ":");
+        if (i == std::string::npos) return i;
+        i = json_skip_ws(_s, i);
+        size_t end = json_skip_value(_s, i);
+        if (end == std::string::npos) return end;
+        std::string_view token(_s.data() + i, end - i);
+        return is_double_token(token) && parse_double(token, out) ? end : std::string::npos;
+    }
+
+    // {"OTIO_SCHEMA": "RationalTime.1", "rate": r, "value": v}, members in
+    // the order OTIO writes them
+    size_t rational_time(size_t i) {
+        double rate, value;
+        i = expect(i, "{");
+        if (i != std::string::npos) i = expect(i, "\"OTIO_SCHEMA\"");
+        if (i != std::string::npos) i = expect(i, ":");
+        if (i != std::string::npos) i = expect(i, "\"RationalTime.1\"");
+        if (i != std::string::npos) i = expect(i, ",");
+        if (i != std::string::npos) i = double_member(i, "\"rate\"", &rate);
+        if (i != std::string::npos) i = expect(i, ",");
+        if (i != std::string::npos) i = double_member(i, "\"value\"", &value);
+        if (i != std::string::npos) i = expect(i, "}");
+        if (i == std::string::npos) return i;
+        _out.push_back(static_cast<char>(kBinRationalTime));
+        raw_double(rate);
+        raw_double(value);
+        return i;
+    }
+
+    size_t value(size_t i) {
+        if (i >= _s.size()) return std::string::npos;
+        char c = _s[i];
+        if (c == '"') return string(i, true);
+        if (c == '[') {
+            _out.push_back(static_cast<char>(kBinArray));
+            i = json_skip_ws(_s, i + 1);
+            if (i < _s.size() && _s[i] == ']') {
+                _out.push_back(static_cast<char>(kBinEnd));
+                return i + 1;
+            }
+            while (true) {
+                i = value(i);
+                if (i == std::string::npos) return i;
+                i = json_skip_ws(_s, i);
+                if (i < _s.size() && _s[i] == ']') break;
+                if (i >= _s.size() || _s[i] != ',') return std::string::npos;
+                i = json_skip_ws(_s, i + 1);
+            }
+            _out.push_back(static_cast<char>(kBinEnd));
+            return i + 1;
+        }
+        if (c == '{') {
+            size_t end = rational_time(i);
+            if (end != std::string::npos) return end;
+            _out.push_back(static_cast<char>(kBinObject));
+            i = json_skip_ws(_s, i + 1);
+            if (i < _s.size() && _s[i] == '}') {
+                _out.push_back(static_cast<char>(kBinEnd));
+                return i + 1;
+            }
+            while (true) {
+                if (i >= _s.size() || _s[i] != '"') return std::string::npos;
+                i = string(i, false);
+                if (i != std::string::npos) i = expect(i, ":");
+                if (i == std::string::npos) return i;
+                i = value(json_skip_ws(_s, i));
+                if (i == std::string::npos) return i;
+                i = json_skip_ws(_s, i);
+                if (i < _s.size() && _s[i] == '}') break;
+                if (i >= _s.size() || _s[i] != ',') return std::string::npos;
+                i = json_skip_ws(_s, i + 1);
+            }
+            _out.push_back(static_cast<char>(kBinEnd));
+            return i + 1;
+        }
+        return scalar(i);
+    }
+};
+
+class BinaryDecoder {
+public:
+    BinaryDecoder(const uint8_t* data, size_t len) : _data(data), _len(len) {}
+
+    // The JSON document, compact; throws std::invalid_argument on bad input
+    std::string json() {
+        if (_len < sizeof kBinaryMagic || std::memcmp(_data, kBinaryMagic, sizeof kBinaryMagic) != 0) {
+            throw std::invalid_argument("Not an OTIO binary document");
+        }
+        _pos = sizeof kBinaryMagic;
+        std::string out;
+        out.reserve(_len * 3);
+        value(out, byte(), 0);
+        if (_pos != _len) malformed();
+        return out;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _len;
+    size_t _pos = 0;
+    std::vector<std::string_view> _strings;
+
+    [[noreturn]] static void malformed() {
+        throw std::invalid_argument("Malformed OTIO binary document");
+    }
+
+    uint8_t byte() {
+        if (_pos >= _len) malformed();
+        return _data[_pos++];
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        malformed();
+    }
+
+    double raw_double() {
+        if (_len - _pos < 8) malformed();
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) bits |= static_cast<uint64_t>(_data[_pos + i]) << (8 * i);
+        _pos += 8;
+        double d;
+        std::memcpy(&d, &bits, sizeof d);
+        return d;
+    }
+
+    std::string_view bytes() {
+        uint64_t n = varint();
+        if (n > _len - _pos) malformed();
+        std::string_view text(reinterpret_cast<const char*>(_data + _pos), static_cast<size_t>(n));
+        _pos += static_cast<size_t>(n);
+        return text;
+    }
+
+    std::string_view string_item(uint8_t tag) {
+        if (tag == kBinString) {
+            _strings.push_back(bytes());
+            return _strings.back();
+        }
+        if (tag != kBinStringRef) malformed();
+        uint64_t index = varint();
+        if (index >= _strings.size()) malformed();
+        return _strings[static_cast<size_t>(index)];
+    }
+
+    void string(std::string& out, uint8_t tag) {
+        out += '"';
+        if (tag == kBinPath) {
+            out.append(string_item(byte()));
+            out.append(string_item(byte()));
+        } else {
+            out.append(string_item(tag));
+        }
+        out += '"';
+    }
+
+    // Shortest text that reads back as the same double, and as a double
+    static void write_double(std::string& out, double d) {
+        if (std::isnan(d)) {
+            out += "NaN";
+            return;
+        }
+        if (std::isinf(d)) {
+            out += d < 0 ? "-Infinity" : "Infinity";
+            return;
+        }
+        char buf[32];
+        auto result = std::to_chars(buf, buf + sizeof buf, d);
+        std::string_view text(buf, static_cast<size_t>(result.ptr - buf));
+        out.append(text);
+        if (text.find_first_of(".e") == std::string_view::npos) out += ".0";
+    }
+
+    void value(std::string& out, uint8_t tag, int depth) {
+        if (depth > kMaxBinaryDepth) malformed();
+        switch (tag) {
+            case kBinNull:
+                out += "null";
+                break;
+            case kBinFalse:
+                out += "false";
+                break;
+            case kBinTrue:
+                out += "true";
+                break;
+            case kBinInt: {
+                uint64_t z = varint();
+                int64_t n = static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+                char buf[24];
+                auto result = std::to_chars(buf, buf + sizeof buf, n);
+                out.append(buf, static_cast<size_t>(result.ptr - buf));
+                break;
+            }
+            case kBinDouble:
+                write_double(out, raw_double());
+                break;
+            case kBinNumber:
+                out.append(bytes());
+                break;
+            case kBinString:
+            case kBinStringRef:
+            case kBinPath:
+                string(out, tag);
+                break;
+            case kBinRationalTime: {
+                double rate = raw_double();
+                double rt_value = raw_double();
+                out += "{\"OTIO_SCHEMA\":\"RationalTime.1\",\"rate\":";
+                write_double(out, rate);
+                out += ",\"value\":";
+                write_double(out, rt_value);
+                out += '}';
+                break;
+            }
+            case kBinArray: {
+                out += '[';
+                bool first = true;
+                for (uint8_t next = byte(); next != kBinEnd; next = byte()) {
+                    if (!first) out += ',';
+                    first = false;
+                    value(out, next, depth + 1);
+                }
+                out += ']';
+                break;
+            }
+            case kBinObject: {
+                out += '{';
+                bool first = true;
+                for (uint8_t next = byte(); next != kBinEnd; next = byte()) {
+                    if (!first) out += ',';
+                    first = false;
+                    string(out, next);
+                    out += ':';
+                    value(out, byte(), depth + 1);
+                }
+                out += '}';
+                break;
+            }
+            default:
+                malformed();
+        }
+    }
+};
+
+static otio::schema_version_map schema_version_map_from(const char** schema_names,
+                                                        const int64_t* schema_versions, int32_t count) {
+    otio::schema_version_map version_map;
+    for (int32_t i = 0; schema_names && schema_versions && i < count; i++) {
+        if (schema_names[i]) version_map[schema_names[i]] = schema_versions[i];
+    }
+    return version_map;
+}
+
+// Binary form of tl, written through OTIO's JSON encoder with
+// schema_versions applied. Empty with err set on failure.
+static std::string encode_timeline_binary(OtioTimeline* tl, const char** schema_names,
+                                          const int64_t* schema_versions, int32_t count, OtioError* err) {
+    auto version_map = schema_version_map_from(schema_names, schema_versions, count);
+    otio::ErrorStatus status;
+    std::string json;
+    {
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        json = reinterpret_cast<otio::Timeline*>(tl)->to_json_string(
+            &status, version_map.empty() ? nullptr : &version_map, 0);
+        OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+    }
+    if (otio::is_error(status)) {
+        set_error(err, 1, status.full_description.c_str());
+        return std::string();
+    }
+    OTIO_STATS_SCOPE(OTIO_STAT_BINARY);
+    std::string encoded = BinaryEncoder(json).take(err);
+    OTIO_STATS_BYTES(OTIO_STAT_BINARY, encoded.size());
+    return encoded;
+}
+
+static OtioTimeline* decode_timeline_binary(const uint8_t* data, size_t len, OtioError* err) {
+    std::string json;
+    {
+        OTIO_STATS_SCOPE(OTIO_STAT_BINARY);
+        OTIO_STATS_BYTES(OTIO_STAT_BINARY, len);
+        json = BinaryDecoder(data, len).json();
+    }
+    return timeline_from_json(json, "Binary document does not contain a Timeline", err);
+}
+
+// Drop the whitespace outside strings, in place. OTIO's writer always
+// pretty-prints, so this is how the compact form is produced.
+static void compact_json(std::string& json) {
+    size_t out = 0;
+    size_t i = 0;
+    while (i < json.size()) {
+        char c = json[i];
+        if (c == '"') {
+            size_t end = json_skip_string(json, i);
+            if (end == std::string::npos) end = json.size();
+            // out <= i, so a forward copy never overwrites unread input
+            std::copy(json.begin() + i, json.begin() + end, json.begin() + out);
+            out += end - i;
+            i = end;
+            continue;
+        }
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') json[out++] = c;
+        ++i;
+    }
+    json.resize(out);
+}
+
+// ============================================================================
+// C API Implementation
+// ============================================================================
+
+extern "C" {
+
+// ----------------------------------------------------------------------------
+// Timeline
+// ----------------------------------------------------------------------------
+
+OtioTimeline* otio_timeline_create(const char* name) {
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        auto tl = new otio::Timeline(name);
+        tl->set_tracks(new otio::Stack());
+        Retainer<otio::Timeline> retainer(tl);
+        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+    )
+}
+
+void otio_timeline_free(OtioTimeline* tl) {
+    if (tl) {
+        try {
+            OTIO_CAST(Timeline, timeline, tl);
+            if (ReleaseQueue::instance().release(timeline)) return;
+            Retainer<otio::Timeline> retainer(timeline);
+        } catch (...) {
+            // Ignore exceptions during cleanup
+        }
+    }
+}
+
+void otio_timeline_set_background_release(OtioTimeline* tl, int32_t enabled) {
+    if (!tl) return;
+    try {
+        ReleaseQueue::instance().mark(reinterpret_cast<otio::Timeline*>(tl), enabled != 0);
+    } catch (...) {
+        // Without the mark the timeline is released immediately
+    }
+}
+
+void otio_wait_for_background_releases(void) {
+    ReleaseQueue::instance().wait_idle();
+}
+
+static std::optional<otio::RationalTime> get_global_start_time(otio::Timeline* tl) {
+    return tl->global_start_time();
+}
+
+static void set_global_start_time(otio::Timeline* tl, const std::optional<otio::RationalTime>& time) {
+    tl->set_global_start_time(time);
+    note_timeline_changed(tl);
+}
+
+int otio_timeline_set_global_start_time(OtioTimeline* tl, OtioRationalTime time, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Timeline, timeline, tl);
+        auto undo = journal_field(timeline, &get_global_start_time, &set_global_start_time);
+        set_global_start_time(timeline, to_otio_rt(time));
+        journal_push(timeline, std::move(undo));
+    )
+}
+
+OtioTrack* otio_timeline_add_video_track(OtioTimeline* tl, const char* name) {
+    OTIO_NULL_CHECK(tl, nullptr);
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Timeline, timeline, tl);
+        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::video);
+        otio::ErrorStatus err;
+        timeline->tracks()->append_child(track, &err);
+        const size_t index = timeline->tracks()->children().size() - 1;
+        note_children_changed(timeline->tracks(), index);
+        journal_push(timeline->tracks(), journal_inserted(timeline->tracks(), index, 1));
+        return reinterpret_cast<OtioTrack*>(track);
+    )
+}
+
+OtioTrack* otio_timeline_add_audio_track(OtioTimeline* tl, const char* name) {
+    OTIO_NULL_CHECK(tl, nullptr);
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Timeline, timeline, tl);
+        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::audio);
+        otio::ErrorStatus err;
+        timeline->tracks()->append_child(track, &err);
+        const size_t index = timeline->tracks()->children().size() - 1;
+        note_children_changed(timeline->tracks(), index);
+        journal_push(timeline->tracks(), journal_inserted(timeline->tracks(), index, 1));
+        return reinterpret_cast<OtioTrack*>(track);
+    )
+}
+
+OtioStack* otio_timeline_get_tracks(OtioTimeline* tl) {
+    OTIO_NULL_CHECK(tl, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Timeline, timeline, tl);
+        return reinterpret_cast<OtioStack*>(timeline->tracks());
+    )
+}
+
+// ----------------------------------------------------------------------------
+// Track
+// ----------------------------------------------------------------------------
+
+OtioTrack* otio_track_create_video(const char* name) {
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::video);
+        Retainer<otio::Track> retainer(track);
+        return reinterpret_cast<OtioTrack*>(retainer.take_value());
+    )
+}
+
+OtioTrack* otio_track_create_audio(const char* name) {
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        auto track = new otio::Track(name, std::nullopt, otio::Track::Kind::audio);
+        Retainer<otio::Track> retainer(track);
+        return reinterpret_cast<OtioTrack*>(retainer.take_value());
+    )
+}
+
+void otio_track_free(OtioTrack* track) {
+    if (track) {
+        try {
+            OTIO_CAST(Track, t, track);
+            Retainer<otio::Track> retainer(t);
+        } catch (...) {
+            // Ignore exceptions during cleanup
+        }
+    }
+}
+
+int otio_track_append_clip(OtioTrack* track, OtioClip* clip, OtioError* err) {
+    return append_child_impl<otio::Track, otio::Clip>(
+        reinterpret_cast<otio::Track*>(track),
+        reinterpret_cast<otio::Clip*>(clip), err);
+}
+
+int otio_track_append_gap(OtioTrack* track, OtioGap* gap, OtioError* err) {
+    return append_child_impl<otio::Track, otio::Gap>(
+        reinterpret_cast<otio::Track*>(track),
+        reinterpret_cast<otio::Gap*>(gap), err);
+}
+
+int otio_track_append_stack(OtioTrack* track, OtioStack* stack, OtioError* err) {
+    return append_child_impl<otio::Track, otio::Stack>(
+        reinterpret_cast<otio::Track*>(track),
+        reinterpret_cast<otio::Stack*>(stack), err);
+}
+
+int32_t otio_track_children_count(OtioTrack* track) {
+    return children_count_impl(reinterpret_cast<otio::Track*>(track));
+}
+
+int32_t otio_track_child_type(OtioTrack* track, int32_t index) {
+    return child_type_impl(reinterpret_cast<otio::Track*>(track), index);
+}
+
+void* otio_track_child_at(OtioTrack* track, int32_t index) {
+    return child_at_impl(reinterpret_cast<otio::Track*>(track), index);
+}
+
+int otio_track_remove_child(OtioTrack* track, int32_t index, OtioError* err) {
+    return remove_child_impl(reinterpret_cast<otio::Track*>(track), index, err);
+}
+
+int otio_track_insert_clip(OtioTrack* track, int32_t index, OtioClip* clip, OtioError* err) {
+    return insert_child_impl<otio::Track, otio::Clip>(
+        reinterpret_cast<otio::Track*>(track), index,
+        reinterpret_cast<otio::Clip*>(clip), err);
+}
+
+int otio_track_insert_gap(OtioTrack* track, int32_t index, OtioGap* gap, OtioError* err) {
+    return insert_child_impl<otio::Track, otio::Gap>(
+        reinterpret_cast<otio::Track*>(track), index,
+        reinterpret_cast<otio::Gap*>(gap), err);
+}
+
+int otio_track_insert_stack(OtioTrack* track, int32_t index, OtioStack* stack, OtioError* err) {
+    return insert_child_impl<otio::Track, otio::Stack>(
+        reinterpret_cast<otio::Track*>(track), index,
+        reinterpret_cast<otio::Stack*>(stack), err);
+}
+
+int otio_track_clear_children(OtioTrack* track, OtioError* err) {
+    return clear_children_impl(reinterpret_cast<otio::Track*>(track), err);
+}
+
+int otio_track_append_children(OtioTrack* track, void* const* items, const int32_t* types,
+    int32_t count, OtioError* err) {
+    return append_children_impl(reinterpret_cast<otio::Track*>(track), items, types, count, err);
+}
+
+int otio_track_insert_children(OtioTrack* track, int32_t index, void* const* items,
+    const int32_t* types, int32_t count, OtioError* err) {
+    return insert_children_impl(reinterpret_cast<otio::Track*>(track), index, items, types, count, err);
+}
+
+int otio_track_append_clip_descriptors(OtioTrack* track, const OtioClipDescriptor* descriptors,
+    int32_t count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    if (count < 0 || (count > 0 && !descriptors)) {
+        set_error(err, 1, "Invalid descriptor array");
+        return -1;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        const auto& d = descriptors[i];
+        bool valid = d.name && d.metadata_count >= 0 && (d.metadata_count == 0 || d.metadata);
+        for (int32_t m = 0; valid && m < d.metadata_count; ++m) {
+            valid = d.metadata[m].key && d.metadata[m].value;
+        }
+        if (!valid) {
+            set_error(err, 1, ("Invalid clip descriptor at index " + std::to_string(i)).c_str());
+            return -1;
+        }
+    }
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        // Build everything first; the retainers free the clips if anything throws
+        std::vector<Retainer<otio::Clip>> clips;
+        clips.reserve(static_cast<size_t>(count));
+        for (int32_t i = 0; i < count; ++i) {
+            const auto& d = descriptors[i];
+            otio::AnyDictionary metadata;
+            for (int32_t m = 0; m < d.metadata_count; ++m) {
+                metadata[d.metadata[m].key] = std::string(d.metadata[m].value);
+            }
+            otio::ExternalReference* ref = nullptr;
+            if (d.target_url) {
+                std::optional<otio::TimeRange> available;
+                if (d.has_available_range) available = to_otio_tr(d.available_range);
+                ref = new otio::ExternalReference(d.target_url, available);
+            }
+            clips.emplace_back(new otio::Clip(d.name, ref, to_otio_tr(d.source_range), metadata));
+        }
+
+        const size_t first = t->children().size();
+        for (const auto& clip : clips) {
+            otio::ErrorStatus status;
+            t->append_child(clip.value, &status);
+            if (otio::is_error(status)) {
+                note_children_changed(t, first);
+                journal_push(t, journal_inserted(t, first, t->children().size() - first));
+                set_error(err, 1, status.full_description.c_str());
+                return -1;
+            }
+        }
+        note_children_changed(t, first);
+        journal_push(t, journal_inserted(t, first, clips.size()));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+// Helper to get composable type from pointer
+static int32_t get_composable_type(otio::Composable* comp) {
+    return object_type_of(comp);
+}
+
+OtioNeighbors otio_track_neighbors_of(OtioTrack* track, int32_t child_index,
+                                       int32_t gap_policy, OtioError* err) {
+    OtioNeighbors result = {nullptr, -1, nullptr, -1};
+    OTIO_NULL_CHECK_ERR(track, err, result, "Track is null");
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto& children = t->children();
+        if (child_index < 0 || static_cast<size_t>(child_index) >= children.size()) {
+            set_error(err, 1, "Index out of bounds");
+            return result;
+        }
+
+        otio::ErrorStatus status;
+        auto policy = static_cast<otio::Track::NeighborGapPolicy>(gap_policy);
+        auto [left, right] = t->neighbors_of(children[child_index].value, &status, policy);
+
+        if (otio::is_error(status)) {
+            set_error(err, static_cast<int>(status.outcome), status.details.c_str());
+            return result;
+        }
+
+        if (left) {
+            result.left = left.value;
+            result.left_type = get_composable_type(left.value);
+        }
+        if (right) {
+            result.right = right.value;
+            result.right_type = get_composable_type(right.value);
+        }
+        return result;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return result;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return result;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Clip
+// ----------------------------------------------------------------------------
+
+OtioClip* otio_clip_create(const char* name, OtioTimeRange source_range) {
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        auto clip = new otio::Clip(name, nullptr, to_otio_tr(source_range));
+        Retainer<otio::Clip> retainer(clip);
+        return reinterpret_cast<OtioClip*>(retainer.take_value());
+    )
+}
+
+int otio_clip_set_media_reference(OtioClip* clip, OtioExternalRef* ref, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Clip, c, clip);
+        OTIO_CAST(ExternalReference, r, ref);
+        auto undo = journal_media_references(c);
+        c->set_media_reference(r);
+        note_media_references_changed(c);
+        journal_push(c, std::move(undo));
+    )
+}
+
+char* otio_clip_get_name(OtioClip* clip) {
+    OTIO_NULL_CHECK(clip, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Clip, c, clip);
+        return safe_strdup(c->name());
+    )
+}
+
+OtioTimeRange otio_clip_get_source_range(OtioClip* clip) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!clip) return zero;
+    try {
+        OTIO_CAST(Clip, c, clip);
+        auto sr = c->source_range();
+        if (sr.has_value()) {
+            auto& range = sr.value();
+            return OtioTimeRange{
+                OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+                OtioRationalTime{range.duration().value(), range.duration().rate()}
+            };
+        }
+    } catch (...) {
+    }
+    return zero;
+}
+
+OtioTimeRange otio_clip_available_range(OtioClip* clip, OtioError* err) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    OTIO_NULL_CHECK_ERR(clip, err, zero, "Clip is null");
+    try {
+        OTIO_CAST(Clip, c, clip);
+        otio::ErrorStatus status;
+        auto range = c->available_range(&status);
+        if (otio::is_error(status)) {
+            set_error(err, static_cast<int>(status.outcome), status.details.c_str());
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return zero;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return zero;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Clip Multi-Reference Support
+// ----------------------------------------------------------------------------
+
+struct OtioStringIterator {
+    std::vector<std::string> strings;
+    size_t index;
+    OtioStringIterator() : index(0) {}
+};
+
+OtioStringIterator* otio_clip_media_reference_keys(OtioClip* clip) {
+    OTIO_NULL_CHECK(clip, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Clip, c, clip);
+        auto iter = new OtioStringIterator();
+        const auto& refs = c->media_references();
+        for (const auto& pair : refs) {
+            iter->strings.push_back(pair.first);
+        }
+        return iter;
+    )
+}
+
+int32_t otio_string_iterator_count(OtioStringIterator* iter) {
+    if (!iter) return 0;
+    return static_cast<int32_t>(iter->strings.size());
+}
+
+char* otio_string_iterator_next(OtioStringIterator* iter) {
+    if (!iter || iter->index >= iter->strings.size()) return nullptr;
+    return safe_strdup(iter->strings[iter->index++]);
+}
+
+void otio_string_iterator_reset(OtioStringIterator* iter) {
+    if (iter) iter->index = 0;
+}
+
+void otio_string_iterator_free(OtioStringIterator* iter) {
+    delete iter;
+}
+
+int32_t otio_clip_media_reference_keys_into(OtioClip* clip, OtioStringView* keys, int32_t capacity,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    try {
+        OTIO_CAST(Clip, c, clip);
+        // media_references() returns a copy of the map, so the views are
+        // backed by per-thread strings whose capacity is kept between calls
+        static thread_local std::vector<std::string> scratch;
+        const auto refs = c->media_references();
+        if (scratch.size() < refs.size()) scratch.resize(refs.size());
+        const int32_t limit = keys ? capacity : 0;
+        int32_t total = 0;
+        for (const auto& pair : refs) {
+            if (total < limit) {
+                auto& key = scratch[static_cast<size_t>(total)];
+                key.assign(pair.first);
+                keys[total] = OtioStringView{key.data(), key.size()};
+            }
+            ++total;
+        }
+        return total;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+char* otio_clip_active_media_reference_key(OtioClip* clip) {
+    OTIO_NULL_CHECK(clip, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Clip, c, clip);
+        return safe_strdup(c->active_media_reference_key());
+    )
+}
+
+int otio_clip_set_active_media_reference_key(OtioClip* clip, const char* key, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+    try {
+        OTIO_CAST(Clip, c, clip);
+        auto undo = journal_media_references(c);
+        c->set_active_media_reference_key(key);
+        note_mutation(c);
+        journal_push(c, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+int otio_clip_add_media_reference(OtioClip* clip, const char* key,
+                                   void* ref, int32_t ref_type, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
+    try {
+        OTIO_CAST(Clip, c, clip);
+        otio::MediaReference* media_ref = nullptr;
+        switch (ref_type) {
+            case 0: // OTIO_REF_TYPE_EXTERNAL
+                media_ref = reinterpret_cast<otio::ExternalReference*>(ref);
+                break;
+            case 1: // OTIO_REF_TYPE_MISSING
+                media_ref = reinterpret_cast<otio::MissingReference*>(ref);
+                break;
+            case 2: // OTIO_REF_TYPE_GENERATOR
+                media_ref = reinterpret_cast<otio::GeneratorReference*>(ref);
+                break;
+            case 3: // OTIO_REF_TYPE_IMAGE_SEQUENCE
+                media_ref = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+                break;
+            default:
+                set_error(err, 1, "Unknown reference type");
+                return -1;
+        }
+        // Get existing references and add the new one
+        auto undo = journal_media_references(c);
+        auto refs = c->media_references();
+        refs[key] = media_ref;
+        // Keep the current active key
+        std::string active_key = c->active_media_reference_key();
+        c->set_media_references(refs, active_key);
+        note_media_references_changed(c);
+        journal_push(c, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+int otio_clip_has_media_reference(OtioClip* clip, const char* key) {
+    if (!clip || !key) return 0;
+    try {
+        OTIO_CAST(Clip, c, clip);
+        const auto& refs = c->media_references();
+        return refs.find(key) != refs.end() ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Gap
+// ----------------------------------------------------------------------------
+
+OtioGap* otio_gap_create(OtioRationalTime duration) {
+    OTIO_TRY_PTR(
+        auto gap = new otio::Gap(otio::TimeRange(
+            otio::RationalTime(0, duration.rate),
+            to_otio_rt(duration)
+        ));
+        Retainer<otio::Gap> retainer(gap);
+        return reinterpret_cast<OtioGap*>(retainer.take_value());
+    )
+}
+
+char* otio_gap_get_name(OtioGap* gap) {
+    OTIO_NULL_CHECK(gap, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Gap, g, gap);
+        return safe_strdup(g->name());
+    )
+}
+
+// ----------------------------------------------------------------------------
+// ExternalReference
+// ----------------------------------------------------------------------------
+
+OtioExternalRef* otio_external_ref_create(const char* target_url) {
+    OTIO_NULL_CHECK(target_url, nullptr);
+    OTIO_TRY_PTR(
+        auto ref = new otio::ExternalReference(target_url);
+        Retainer<otio::ExternalReference> retainer(ref);
+        return reinterpret_cast<OtioExternalRef*>(retainer.take_value());
+    )
+}
+
+int otio_external_ref_set_available_range(OtioExternalRef* ref, OtioTimeRange range, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "Reference is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(ExternalReference, r, ref);
+        r->set_available_range(to_otio_tr(range));
+    )
+}
+
+void otio_external_ref_free(OtioExternalRef* ref) {
+    // ExternalReferences are typically owned by clips via set_media_reference.
+    // This function exists for API completeness but the reference is managed
+    // by OTIO's reference counting when attached to a clip.
+    (void)ref;
+}
+
+// ----------------------------------------------------------------------------
+// Stack
+// ----------------------------------------------------------------------------
+
+OtioStack* otio_stack_create(const char* name) {
+    OTIO_NULL_CHECK(name, nullptr);
+    OTIO_TRY_PTR(
+        auto stack = new otio::Stack(name);
+        Retainer<otio::Stack> retainer(stack);
+        return reinterpret_cast<OtioStack*>(retainer.take_value());
+    )
+}
+
+void otio_stack_free(OtioStack* stack) {
+    if (stack) {
+        try {
+            OTIO_CAST(Stack, s, stack);
+            Retainer<otio::Stack> retainer(s);
+        } catch (...) {
+            // Ignore exceptions during cleanup
+        }
+    }
+}
+
+int otio_stack_append_track(OtioStack* stack, OtioTrack* track, OtioError* err) {
+    return append_child_impl<otio::Stack, otio::Track>(
+        reinterpret_cast<otio::Stack*>(stack),
+        reinterpret_cast<otio::Track*>(track), err);
+}
+
+int otio_stack_append_clip(OtioStack* stack, OtioClip* clip, OtioError* err) {
+    return append_child_impl<otio::Stack, otio::Clip>(
+        reinterpret_cast<otio::Stack*>(stack),
+        reinterpret_cast<otio::Clip*>(clip), err);
+}
+
+int otio_stack_append_gap(OtioStack* stack, OtioGap* gap, OtioError* err) {
+    return append_child_impl<otio::Stack, otio::Gap>(
+        reinterpret_cast<otio::Stack*>(stack),
+        reinterpret_cast<otio::Gap*>(gap), err);
+}
+
+int otio_stack_append_stack(OtioStack* stack, OtioStack* child, OtioError* err) {
+    return append_child_impl<otio::Stack, otio::Stack>(
+        reinterpret_cast<otio::Stack*>(stack),
+        reinterpret_cast<otio::Stack*>(child), err);
+}
+
+int32_t otio_stack_children_count(OtioStack* stack) {
+    return children_count_impl(reinterpret_cast<otio::Stack*>(stack));
+}
+
+int32_t otio_stack_child_type(OtioStack* stack, int32_t index) {
+    return child_type_impl(reinterpret_cast<otio::Stack*>(stack), index);
+}
+
+void* otio_stack_child_at(OtioStack* stack, int32_t index) {
+    return child_at_impl(reinterpret_cast<otio::Stack*>(stack), index);
+}
+
+int otio_stack_remove_child(OtioStack* stack, int32_t index, OtioError* err) {
+    return remove_child_impl(reinterpret_cast<otio::Stack*>(stack), index, err);
+}
+
+int otio_stack_insert_track(OtioStack* stack, int32_t index, OtioTrack* track, OtioError* err) {
+    return insert_child_impl<otio::Stack, otio::Track>(
+        reinterpret_cast<otio::Stack*>(stack), index,
+        reinterpret_cast<otio::Track*>(track), err);
+}
+
+int otio_stack_insert_clip(OtioStack* stack, int32_t index, OtioClip* clip, OtioError* err) {
+    return insert_child_impl<otio::Stack, otio::Clip>(
+        reinterpret_cast<otio::Stack*>(stack), index,
+        reinterpret_cast<otio::Clip*>(clip), err);
+}
+
+int otio_stack_insert_gap(OtioStack* stack, int32_t index, OtioGap* gap, OtioError* err) {
+    return insert_child_impl<otio::Stack, otio::Gap>(
+        reinterpret_cast<otio::Stack*>(stack), index,
+        reinterpret_cast<otio::Gap*>(gap), err);
+}
+
+int otio_stack_insert_stack(OtioStack* stack, int32_t index, OtioStack* child, OtioError* err) {
+    return insert_child_impl<otio::Stack, otio::Stack>(
+        reinterpret_cast<otio::Stack*>(stack), index,
+        reinterpret_cast<otio::Stack*>(child), err);
+}
+
+int otio_stack_clear_children(OtioStack* stack, OtioError* err) {
+    return clear_children_impl(reinterpret_cast<otio::Stack*>(stack), err);
+}
+
+int otio_stack_append_children(OtioStack* stack, void* const* items, const int32_t* types,
+    int32_t count, OtioError* err) {
+    return append_children_impl(reinterpret_cast<otio::Stack*>(stack), items, types, count, err);
+}
+
+int otio_stack_insert_children(OtioStack* stack, int32_t index, void* const* items,
+    const int32_t* types, int32_t count, OtioError* err) {
+    return insert_children_impl(reinterpret_cast<otio::Stack*>(stack), index, items, types, count, err);
+}
+
+char* otio_stack_get_name(OtioStack* stack) {
+    OTIO_NULL_CHECK(stack, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Stack, s, stack);
+        return safe_strdup(s->name());
+    )
+}
+
+char* otio_track_get_name(OtioTrack* track) {
+    OTIO_NULL_CHECK(track, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Track, t, track);
+        return safe_strdup(t->name());
+    )
+}
+
+// ----------------------------------------------------------------------------
+// Serialization
+// ----------------------------------------------------------------------------
+
+int otio_timeline_write_to_file(OtioTimeline* tl, const char* path, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Timeline, timeline, tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        bool success = timeline->to_json_file(path, &status);
+        if (!success || otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+    )
+}
+
+OtioTimeline* otio_timeline_read_from_file(const char* path, OtioError* err) {
+    if (!path) {
+        set_error(err, 1, "Path is null");
+        return nullptr;
+    }
+    try {
+        std::ifstream file(path, std::ios::binary);
+        if (file && file_is_gzip(file)) {
+            file.close();
+            std::string source;
+            if (!read_document_file(path, source, err)) return nullptr;
+            return timeline_from_json(source, "File does not contain a Timeline", err);
+        }
+        file.close();
+        OTIO_STATS_SCOPE(OTIO_STAT_PARSE);
+        otio::ErrorStatus status;
+        auto result = otio::SerializableObject::from_json_file(path, &status);
+        if (otio::is_error(status) || !result) {
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        auto timeline = counted_dynamic_cast<otio::Timeline*>(result);
+        if (!timeline) {
+            set_error(err, 1, "File does not contain a Timeline");
+            Retainer<otio::SerializableObject> retainer(result);
+            return nullptr;
+        }
+        Retainer<otio::Timeline> retainer(timeline);
+        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+char* otio_timeline_to_json_string(OtioTimeline* tl, OtioError* err) {
+    if (!tl) {
+        set_error(err, 1, "Timeline is null");
+        return nullptr;
+    }
+    try {
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        std::string json = timeline->to_json_string(&status);
+        OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        return safe_strdup(json);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+int otio_timeline_write_json(OtioTimeline* tl, int32_t flags, OtioWriteCallback write,
+                             void* user_data, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(write, err, -1, "Write callback is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Timeline, timeline, tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        std::string json = timeline->to_json_string(&status, nullptr, (flags & OTIO_JSON_COMPACT) ? 0 : 4);
+        OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        if (flags & OTIO_JSON_COMPACT) compact_json(json);
+        // Handed over in pieces so a chunked sink never sees one huge write
+        for (size_t pos = 0; pos < json.size(); pos += kFileChunk) {
+            size_t n = std::min(json.size() - pos, kFileChunk);
+            if (write(user_data, json.data() + pos, n) != 0) {
+                set_error(err, 1, "Write callback failed");
+                return -1;
+            }
+        }
+    )
+}
+
+OtioTimeline* otio_timeline_from_json_string(const char* json, OtioError* err) {
+    if (!json) {
+        set_error(err, 1, "JSON string is null");
+        return nullptr;
+    }
+    return otio_timeline_from_json_buffer(json, strlen(json), err);
+}
+
+OtioTimeline* otio_timeline_from_json_buffer(const char* data, size_t len, OtioError* err) {
+    if (!data && len != 0) {
+        set_error(err, 1, "JSON buffer is null");
+        return nullptr;
+    }
+    try {
+        OTIO_STATS_SCOPE(OTIO_STAT_PARSE);
+        OTIO_STATS_BYTES(OTIO_STAT_PARSE, len);
+        otio::ErrorStatus status;
+        // OTIO's parser only accepts a std::string, so this is the one copy
+        auto result = otio::SerializableObject::from_json_string(
+            len ? std::string(data, len) : std::string(), &status);
+        if (otio::is_error(status) || !result) {
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        auto timeline = counted_dynamic_cast<otio::Timeline*>(result);
+        if (!timeline) {
+            set_error(err, 1, "JSON does not contain a Timeline");
+            Retainer<otio::SerializableObject> retainer(result);
+            return nullptr;
+        }
+        Retainer<otio::Timeline> retainer(timeline);
+        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Serialization with schema version targeting
+// ----------------------------------------------------------------------------
+
+int otio_timeline_write_to_file_with_schema_versions(
+    OtioTimeline* tl,
+    const char* path,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
+
+    // Build schema version map from arrays
+    otio::schema_version_map version_map;
+    if (schema_names && schema_versions && count > 0) {
+        for (int32_t i = 0; i < count; i++) {
+            if (schema_names[i]) {
+                version_map[schema_names[i]] = schema_versions[i];
+            }
+        }
+    }
+
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Timeline, timeline, tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        bool success = timeline->to_json_file(
+            path,
+            &status,
+            version_map.empty() ? nullptr : &version_map
+        );
+        if (!success || otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+    )
+}
+
+char* otio_timeline_to_json_string_with_schema_versions(
+    OtioTimeline* tl,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+
+    // Build schema version map from arrays
+    otio::schema_version_map version_map;
+    if (schema_names && schema_versions && count > 0) {
+        for (int32_t i = 0; i < count; i++) {
+            if (schema_names[i]) {
+                version_map[schema_names[i]] = schema_versions[i];
+            }
+        }
+    }
+
+    try {
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        std::string json = timeline->to_json_string(
+            &status,
+            version_map.empty() ? nullptr : &version_map
+        );
+        OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        return safe_strdup(json);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Binary serialization
+// ----------------------------------------------------------------------------
+
+uint8_t* otio_timeline_to_binary(
+    OtioTimeline* tl,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    size_t* len,
+    OtioError* err
+) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(len, err, nullptr, "Length pointer is null");
+    try {
+        std::string encoded = encode_timeline_binary(tl, schema_names, schema_versions, count, err);
+        if (encoded.empty()) return nullptr;
+        auto result = static_cast<uint8_t*>(malloc(encoded.size()));
+        if (!result) {
+            set_error(err, 1, "Out of memory");
+            return nullptr;
+        }
+        memcpy(result, encoded.data(), encoded.size());
+        *len = encoded.size();
+        return result;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+OtioTimeline* otio_timeline_from_binary(const uint8_t* data, size_t len, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(data, err, nullptr, "Binary buffer is null");
+    try {
+        return decode_timeline_binary(data, len, err);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+void otio_free_bytes(uint8_t* data) {
+    free(data);
+}
+
+int otio_timeline_write_to_binary_file(
+    OtioTimeline* tl,
+    const char* path,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
+    OTIO_TRY_INT(err,
+        std::string encoded = encode_timeline_binary(tl, schema_names, schema_versions, count, err);
+        if (encoded.empty()) return -1;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(encoded.data(), static_cast<std::streamsize>(encoded.size())) || !file.flush()) {
+            set_error(err, 1, "Could not write binary file");
+            return -1;
+        }
+    )
+}
+
+OtioTimeline* otio_timeline_read_from_binary_file(const char* path, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(path, err, nullptr, "Path is null");
+    try {
+        std::string data;
+        if (!read_document_file(path, data, err)) return nullptr;
+        return decode_timeline_binary(reinterpret_cast<const uint8_t*>(data.data()), data.size(), err);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Compressed files
+// ----------------------------------------------------------------------------
+
+int32_t otio_gzip_supported(void) {
+#ifdef OTIO_SHIM_HAVE_ZLIB
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int otio_timeline_write_to_gzip_file(
+    OtioTimeline* tl,
+    const char* path,
+    int32_t level,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
+    if (level < -1 || level > 9) {
+        set_error(err, 1, "Compression level must be between -1 and 9");
+        return -1;
+    }
+#ifdef OTIO_SHIM_HAVE_ZLIB
+    auto version_map = schema_version_map_from(schema_names, schema_versions, count);
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Timeline, timeline, tl);
+        OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+        otio::ErrorStatus status;
+        std::string json = timeline->to_json_string(&status, version_map.empty() ? nullptr : &version_map);
+        OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        if (!write_gzip_file(path, json, level, err)) return -1;
+    )
+#else
+    (void)schema_names;
+    (void)schema_versions;
+    (void)count;
+    set_error(err, 1, "otio_shim was built without zlib");
+    return -1;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// String memory management
+// ----------------------------------------------------------------------------
+
+void otio_free_string(char* str) {
+    free(str);
+}
+
+// ----------------------------------------------------------------------------
+// Metadata - using template helpers
+// ----------------------------------------------------------------------------
+
+void otio_timeline_set_metadata_string(OtioTimeline* tl, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Timeline*>(tl), key, value);
+}
+
+char* otio_timeline_get_metadata_string(OtioTimeline* tl, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Timeline*>(tl), key);
+}
+
+void otio_track_set_metadata_string(OtioTrack* track, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Track*>(track), key, value);
+}
+
+char* otio_track_get_metadata_string(OtioTrack* track, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Track*>(track), key);
+}
+
+void otio_clip_set_metadata_string(OtioClip* clip, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Clip*>(clip), key, value);
+}
+
+char* otio_clip_get_metadata_string(OtioClip* clip, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Clip*>(clip), key);
+}
+
+void otio_gap_set_metadata_string(OtioGap* gap, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Gap*>(gap), key, value);
+}
+
+char* otio_gap_get_metadata_string(OtioGap* gap, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Gap*>(gap), key);
+}
+
+void otio_stack_set_metadata_string(OtioStack* stack, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Stack*>(stack), key, value);
+}
+
+char* otio_stack_get_metadata_string(OtioStack* stack, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Stack*>(stack), key);
+}
+
+void otio_external_ref_set_metadata_string(OtioExternalRef* ref, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::ExternalReference*>(ref), key, value);
+}
+
+char* otio_external_ref_get_metadata_string(OtioExternalRef* ref, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::ExternalReference*>(ref), key);
+}
+
+// ----------------------------------------------------------------------------
+// Marker
+// ----------------------------------------------------------------------------
+
+OtioMarker* otio_marker_create(const char* name, OtioTimeRange marked_range, const char* color) {
+    OTIO_NULL_CHECK(name, nullptr);
+    const char* c = color ? color : otio::Marker::Color::green;
+    OTIO_TRY_PTR(
+        auto marker = new otio::Marker(name, to_otio_tr(marked_range), c);
+        Retainer<otio::Marker> retainer(marker);
+        return reinterpret_cast<OtioMarker*>(retainer.take_value());
+    )
+}
+
+void otio_marker_free(OtioMarker* marker) {
+    if (marker) {
+        try {
+            OTIO_CAST(Marker, m, marker);
+            Retainer<otio::Marker> retainer(m);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_marker_get_name(OtioMarker* marker) {
+    OTIO_NULL_CHECK(marker, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Marker, m, marker);
+        return safe_strdup(m->name());
+    )
+}
+
+char* otio_marker_get_color(OtioMarker* marker) {
+    OTIO_NULL_CHECK(marker, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Marker, m, marker);
+        return safe_strdup(m->color());
+    )
+}
+
+void otio_marker_set_color(OtioMarker* marker, const char* color) {
+    if (!marker || !color) return;
+    try {
+        OTIO_CAST(Marker, m, marker);
+        m->set_color(std::string(color));
+    } catch (...) {
+    }
+}
+
+OtioTimeRange otio_marker_get_marked_range(OtioMarker* marker) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!marker) return zero;
+    try {
+        OTIO_CAST(Marker, m, marker);
+        auto range = m->marked_range();
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (...) {
+        return zero;
+    }
+}
+
+int otio_marker_set_marked_range(OtioMarker* marker, OtioTimeRange range, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
+    OTIO_TRY_INT(err,
+        OTIO_CAST(Marker, m, marker);
+        m->set_marked_range(to_otio_tr(range));
+    )
+}
+
+char* otio_marker_get_comment(OtioMarker* marker) {
+    OTIO_NULL_CHECK(marker, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Marker, m, marker);
+        return safe_strdup(m->comment());
+    )
+}
+
+void otio_marker_set_comment(OtioMarker* marker, const char* comment) {
+    if (!marker || !comment) return;
+    try {
+        OTIO_CAST(Marker, m, marker);
+        m->set_comment(std::string(comment));
+    } catch (...) {
+    }
+}
+
+void otio_marker_set_metadata_string(OtioMarker* marker, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Marker*>(marker), key, value);
+}
+
+char* otio_marker_get_metadata_string(OtioMarker* marker, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Marker*>(marker), key);
+}
+
+int otio_marker_is_shared(OtioMarker* marker) {
+    OTIO_NULL_CHECK(marker, 0);
+    try {
+        OTIO_CAST(Marker, m, marker);
+        return m->current_ref_count() > 1 ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Effect
+// ----------------------------------------------------------------------------
+
+OtioEffect* otio_effect_create(const char* name, const char* effect_name) {
+    const char* n = name ? name : "";
+    const char* en = effect_name ? effect_name : "";
+    OTIO_TRY_PTR(
+        auto effect = new otio::Effect(n, en);
+        Retainer<otio::Effect> retainer(effect);
+        return reinterpret_cast<OtioEffect*>(retainer.take_value());
+    )
+}
+
+void otio_effect_free(OtioEffect* effect) {
+    if (effect) {
+        try {
+            OTIO_CAST(Effect, e, effect);
+            Retainer<otio::Effect> retainer(e);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_effect_get_name(OtioEffect* effect) {
+    OTIO_NULL_CHECK(effect, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Effect, e, effect);
+        return safe_strdup(e->name());
+    )
+}
+
+char* otio_effect_get_effect_name(OtioEffect* effect) {
+    OTIO_NULL_CHECK(effect, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Effect, e, effect);
+        return safe_strdup(e->effect_name());
+    )
+}
+
+void otio_effect_set_effect_name(OtioEffect* effect, const char* effect_name) {
+    if (!effect || !effect_name) return;
+    try {
+        OTIO_CAST(Effect, e, effect);
+        e->set_effect_name(std::string(effect_name));
+    } catch (...) {
+    }
+}
+
+void otio_effect_set_metadata_string(OtioEffect* effect, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Effect*>(effect), key, value);
+}
+
+char* otio_effect_get_metadata_string(OtioEffect* effect, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Effect*>(effect), key);
+}
+
+// ----------------------------------------------------------------------------
+// Transition
+// ----------------------------------------------------------------------------
+
+OtioTransition* otio_transition_create(const char* name, const char* transition_type,
+                                       OtioRationalTime in_offset, OtioRationalTime out_offset) {
+    const char* n = name ? name : "";
+    const char* tt = transition_type ? transition_type : otio::Transition::Type::SMPTE_Dissolve;
+    OTIO_TRY_PTR(
+        auto transition = new otio::Transition(n, tt, to_otio_rt(in_offset), to_otio_rt(out_offset));
+        Retainer<otio::Transition> retainer(transition);
+        return reinterpret_cast<OtioTransition*>(retainer.take_value());
+    )
+}
+
+void otio_transition_free(OtioTransition* transition) {
+    if (transition) {
+        try {
+            OTIO_CAST(Transition, t, transition);
+            Retainer<otio::Transition> retainer(t);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_transition_get_name(OtioTransition* transition) {
+    OTIO_NULL_CHECK(transition, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Transition, t, transition);
+        return safe_strdup(t->name());
+    )
+}
+
+char* otio_transition_get_transition_type(OtioTransition* transition) {
+    OTIO_NULL_CHECK(transition, nullptr);
+    OTIO_TRY_PTR(
+        OTIO_CAST(Transition, t, transition);
+        return safe_strdup(t->transition_type());
+    )
+}
+
+void otio_transition_set_transition_type(OtioTransition* transition, const char* transition_type) {
+    if (!transition || !transition_type) return;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        t->set_transition_type(std::string(transition_type));
+        note_content_changed(t);
+    } catch (...) {
+    }
+}
+
+OtioRationalTime otio_transition_get_in_offset(OtioTransition* transition) {
+    OtioRationalTime zero = {0, 1};
+    if (!transition) return zero;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        auto rt = t->in_offset();
+        return OtioRationalTime{rt.value(), rt.rate()};
+    } catch (...) {
+        return zero;
+    }
+}
+
+static otio::RationalTime get_in_offset(otio::Transition* t) {
+    return t->in_offset();
+}
+
+static void set_in_offset(otio::Transition* t, const otio::RationalTime& offset) {
+    t->set_in_offset(offset);
+    note_mutation(t);
+}
+
+void otio_transition_set_in_offset(OtioTransition* transition, OtioRationalTime offset) {
+    if (!transition) return;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        auto undo = journal_field(t, &get_in_offset, &set_in_offset);
+        set_in_offset(t, to_otio_rt(offset));
+        journal_push(t, std::move(undo));
+    } catch (...) {
+    }
+}
+
+OtioRationalTime otio_transition_get_out_offset(OtioTransition* transition) {
+    OtioRationalTime zero = {0, 1};
+    if (!transition) return zero;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        auto rt = t->out_offset();
+        return OtioRationalTime{rt.value(), rt.rate()};
+    } catch (...) {
+        return zero;
+    }
+}
+
+static otio::RationalTime get_out_offset(otio::Transition* t) {
+    return t->out_offset();
+}
+
+static void set_out_offset(otio::Transition* t, const otio::RationalTime& offset) {
+    t->set_out_offset(offset);
+    note_mutation(t);
+}
+
+void otio_transition_set_out_offset(OtioTransition* transition, OtioRationalTime offset) {
+    if (!transition) return;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        auto undo = journal_field(t, &get_out_offset, &set_out_offset);
+        set_out_offset(t, to_otio_rt(offset));
+        journal_push(t, std::move(undo));
+    } catch (...) {
+    }
+}
+
+OtioRationalTime otio_transition_get_duration(OtioTransition* transition) {
+    OtioRationalTime zero = {0, 1};
+    if (!transition) return zero;
+    try {
+        OTIO_CAST(Transition, t, transition);
+        otio::ErrorStatus status;
+        auto rt = t->duration(&status);
+        if (otio::is_error(status)) return zero;
+        return OtioRationalTime{rt.value(), rt.rate()};
+    } catch (...) {
+        return zero;
+    }
+}
+
+void otio_transition_set_metadata_string(OtioTransition* transition, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::Transition*>(transition), key, value);
+}
+
+char* otio_transition_get_metadata_string(OtioTransition* transition, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::Transition*>(transition), key);
+}
+
+int otio_track_append_transition(OtioTrack* track, OtioTransition* transition, OtioError* err) {
+    return append_child_impl<otio::Track, otio::Transition>(
+        reinterpret_cast<otio::Track*>(track),
+        reinterpret_cast<otio::Transition*>(transition), err);
+}
+
+int otio_track_insert_transition(OtioTrack* track, int32_t index, OtioTransition* transition, OtioError* err) {
+    return insert_child_impl<otio::Track, otio::Transition>(
+        reinterpret_cast<otio::Track*>(track), index,
+        reinterpret_cast<otio::Transition*>(transition), err);
+}
+
+// ----------------------------------------------------------------------------
+// MissingReference
+// ----------------------------------------------------------------------------
+
+OtioMissingRef* otio_missing_ref_create(void) {
+    OTIO_TRY_PTR(
+        auto ref = new otio::MissingReference();
+        Retainer<otio::MissingReference> retainer(ref);
+        return reinterpret_cast<OtioMissingRef*>(retainer.take_value());
+    )
+}
+
+void otio_missing_ref_free(OtioMissingRef* ref) {
+    if (ref) {
+        try {
+            auto typed = reinterpret_cast<otio::MissingReference*>(ref);
+            Retainer<otio::MissingReference> retainer(typed);
+        } catch (...) {
+        }
+    }
+}
+
+void otio_missing_ref_set_metadata_string(OtioMissingRef* ref, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::MissingReference*>(ref), key, value);
+}
+
+char* otio_missing_ref_get_metadata_string(OtioMissingRef* ref, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::MissingReference*>(ref), key);
+}
+
+// ----------------------------------------------------------------------------
+// ImageSequenceReference
+// ----------------------------------------------------------------------------
+
+OtioImageSeqRef* otio_image_seq_ref_create(const char* target_url_base,
+    const char* name_prefix, const char* name_suffix,
+    int32_t start_frame, int32_t frame_step, double rate, int32_t frame_zero_padding) {
+    const char* url = target_url_base ? target_url_base : "";
+    const char* prefix = name_prefix ? name_prefix : "";
+    const char* suffix = name_suffix ? name_suffix : "";
+    OTIO_TRY_PTR(
+        auto ref = new otio::ImageSequenceReference(
+            url, prefix, suffix, start_frame, frame_step, rate, frame_zero_padding);
+        Retainer<otio::ImageSequenceReference> retainer(ref);
+        return reinterpret_cast<OtioImageSeqRef*>(retainer.take_value());
+    )
+}
+
+void otio_image_seq_ref_free(OtioImageSeqRef* ref) {
+    if (ref) {
+        try {
+            auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+            Retainer<otio::ImageSequenceReference> retainer(typed);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_image_seq_ref_get_target_url_base(OtioImageSeqRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return safe_strdup(typed->target_url_base());
+    )
+}
+
+char* otio_image_seq_ref_get_name_prefix(OtioImageSeqRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return safe_strdup(typed->name_prefix());
+    )
+}
+
+char* otio_image_seq_ref_get_name_suffix(OtioImageSeqRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return safe_strdup(typed->name_suffix());
+    )
+}
+
+int32_t otio_image_seq_ref_get_start_frame(OtioImageSeqRef* ref) {
+    if (!ref) return 1;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->start_frame();
+    } catch (...) {
+        return 1;
+    }
+}
+
+int32_t otio_image_seq_ref_get_end_frame(OtioImageSeqRef* ref) {
+    if (!ref) return 1;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->end_frame();
+    } catch (...) {
+        return 1;
+    }
+}
+
+int32_t otio_image_seq_ref_get_frame_step(OtioImageSeqRef* ref) {
+    if (!ref) return 1;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->frame_step();
+    } catch (...) {
+        return 1;
+    }
+}
+
+double otio_image_seq_ref_get_rate(OtioImageSeqRef* ref) {
+    if (!ref) return 1.0;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->rate();
+    } catch (...) {
+        return 1.0;
+    }
+}
+
+int32_t otio_image_seq_ref_get_frame_zero_padding(OtioImageSeqRef* ref) {
+    if (!ref) return 0;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->frame_zero_padding();
+    } catch (...) {
+        return 0;
+    }
+}
+
+int32_t otio_image_seq_ref_get_missing_frame_policy(OtioImageSeqRef* ref) {
+    if (!ref) return OTIO_MISSING_FRAME_ERROR;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return static_cast<int32_t>(typed->missing_frame_policy());
+    } catch (...) {
+        return OTIO_MISSING_FRAME_ERROR;
+    }
+}
+
+void otio_image_seq_ref_set_target_url_base(OtioImageSeqRef* ref, const char* url_base) {
+    if (!ref || !url_base) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_target_url_base(std::string(url_base));
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_name_prefix(OtioImageSeqRef* ref, const char* prefix) {
+    if (!ref || !prefix) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_name_prefix(std::string(prefix));
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_name_suffix(OtioImageSeqRef* ref, const char* suffix) {
+    if (!ref || !suffix) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_name_suffix(std::string(suffix));
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_start_frame(OtioImageSeqRef* ref, int32_t frame) {
+    if (!ref) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_start_frame(frame);
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_frame_step(OtioImageSeqRef* ref, int32_t step) {
+    if (!ref) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_frame_step(step);
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_rate(OtioImageSeqRef* ref, double rate) {
+    if (!ref) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_rate(rate);
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_frame_zero_padding(OtioImageSeqRef* ref, int32_t padding) {
+    if (!ref) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_frame_zero_padding(padding);
+    } catch (...) {
+    }
+}
+
+void otio_image_seq_ref_set_missing_frame_policy(OtioImageSeqRef* ref, int32_t policy) {
+    if (!ref) return;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        otio::ImageSequenceReference::MissingFramePolicy p;
+        switch (policy) {
+            case OTIO_MISSING_FRAME_HOLD:
+                p = otio::ImageSequenceReference::MissingFramePolicy::hold;
+                break;
+            case OTIO_MISSING_FRAME_BLACK:
+                p = otio::ImageSequenceReference::MissingFramePolicy::black;
+                break;
+            default:
+                p = otio::ImageSequenceReference::MissingFramePolicy::error;
+                break;
+        }
+        typed->set_missing_frame_policy(p);
+    } catch (...) {
+    }
+}
+
+int32_t otio_image_seq_ref_number_of_images(OtioImageSeqRef* ref) {
+    if (!ref) return 0;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        return typed->number_of_images_in_sequence();
+    } catch (...) {
+        return 0;
+    }
+}
+
+int32_t otio_image_seq_ref_frame_for_time(OtioImageSeqRef* ref, OtioRationalTime time, OtioError* err) {
+    if (!ref) {
+        set_error(err, 1, "ImageSequenceReference is null");
+        return 0;
+    }
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        otio::ErrorStatus status;
+        int32_t frame = typed->frame_for_time(to_otio_rt(time), &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return 0;
+        }
+        return frame;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return 0;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return 0;
+    }
+}
+
+char* otio_image_seq_ref_target_url_for_image_number(OtioImageSeqRef* ref, int32_t image_number, OtioError* err) {
+    if (!ref) {
+        set_error(err, 1, "ImageSequenceReference is null");
+        return nullptr;
+    }
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        otio::ErrorStatus status;
+        std::string url = typed->target_url_for_image_number(image_number, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        return safe_strdup(url);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+// The parts of target_url_for_image_number() that do not depend on the
+// image, computed once so that each URL is two copies and a digit write.
+struct ImageUrlTemplate {
+    std::string head;
+    std::string suffix;
+    int64_t start_frame;
+    int64_t frame_step;
+    size_t padding;
+
+    explicit ImageUrlTemplate(const otio::ImageSequenceReference& ref)
+        : head(ref.target_url_base()),
+          suffix(ref.name_suffix()),
+          start_frame(ref.start_frame()),
+          frame_step(ref.frame_step()),
+          padding(static_cast<size_t>(std::max(ref.frame_zero_padding(), 0))) {
+        // Same separator rule as OTIO: add a slash unless the base ends in one
+        if (!head.empty() && head.back() != '/') head += '/';
+        head += ref.name_prefix();
+    }
+
+    // Digits of the file frame number of `image`, and whether it is negative
+    size_t digits(int32_t image, char (&scratch)[24], bool& negative) const {
+        int64_t frame = start_frame + static_cast<int64_t>(image) * frame_step;
+        negative = frame < 0;
+        uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(frame) : static_cast<uint64_t>(frame);
+        return static_cast<size_t>(std::to_chars(scratch, scratch + sizeof(scratch), magnitude).ptr - scratch);
+    }
+
+    size_t length(int32_t image) const {
+        char scratch[24];
+        bool negative = false;
+        size_t count = digits(image, scratch, negative);
+        return head.size() + (negative ? 1 : 0) + std::max(count, padding) + suffix.size();
+    }
+
+    size_t write(int32_t image, char* out) const {
+        char scratch[24];
+        bool negative = false;
+        size_t count = digits(image, scratch, negative);
+        char* p = out;
+        std::memcpy(p, head.data(), head.size());
+        p += head.size();
+        if (negative) *p++ = '-';
+        if (count < padding) {
+            std::memset(p, '0', padding - count);
+            p += padding - count;
+        }
+        std::memcpy(p, scratch, count);
+        p += count;
+        std::memcpy(p, suffix.data(), suffix.size());
+        return static_cast<size_t>(p - out) + suffix.size();
+    }
+};
+
+int64_t otio_image_seq_ref_target_urls(OtioImageSeqRef* ref, int32_t first_image, int32_t count,
+    char* buffer, int64_t buffer_size, int64_t* offsets, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "ImageSequenceReference is null");
+    if (count < 0) {
+        set_error(err, 1, "Image count is negative");
+        return -1;
+    }
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        // The checks target_url_for_image_number() makes per call, made once
+        auto available = typed->available_range();
+        if (typed->rate() == 0) {
+            set_error(err, 1, "Zero rate sequence has no frames.");
+            return -1;
+        }
+        if (!available || available->duration().value() == 0) {
+            set_error(err, 1, "Zero duration sequences has no frames.");
+            return -1;
+        }
+        if (count > 0
+            && static_cast<int64_t>(first_image) + count > typed->number_of_images_in_sequence()) {
+            set_error(err, 1, "Out of bounds index");
+            return -1;
+        }
+
+        ImageUrlTemplate url(*typed);
+        int64_t total = 0;
+        for (int32_t i = 0; i < count; ++i) {
+            if (offsets) offsets[i] = total;
+            total += static_cast<int64_t>(url.length(first_image + i));
+        }
+        if (offsets) offsets[count] = total;
+        if (buffer && buffer_size >= total) {
+            char* out = buffer;
+            for (int32_t i = 0; i < count; ++i) out += url.write(first_image + i, out);
+        }
+        return total;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+int otio_image_seq_ref_set_available_range(OtioImageSeqRef* ref, OtioTimeRange range, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "ImageSequenceReference is null");
+    OTIO_TRY_INT(err,
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        typed->set_available_range(to_otio_tr(range));
+    )
+}
+
+OtioTimeRange otio_image_seq_ref_get_available_range(OtioImageSeqRef* ref) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!ref) return zero;
+    try {
+        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        auto range_opt = typed->available_range();
+        if (!range_opt.has_value()) return zero;
+        auto range = range_opt.value();
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (...) {
+        return zero;
+    }
+}
+
+int otio_clip_set_image_sequence_reference(OtioClip* clip, OtioImageSeqRef* ref, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto r = reinterpret_cast<otio::ImageSequenceReference*>(ref);
+        auto undo = journal_media_references(c);
+        c->set_media_reference(r);
+        note_media_references_changed(c);
+        journal_push(c, std::move(undo));
+    )
+}
+
+void otio_image_seq_ref_set_metadata_string(OtioImageSeqRef* ref, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::ImageSequenceReference*>(ref), key, value);
+}
+
+char* otio_image_seq_ref_get_metadata_string(OtioImageSeqRef* ref, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::ImageSequenceReference*>(ref), key);
+}
+
+// ----------------------------------------------------------------------------
+// GeneratorReference
+// ----------------------------------------------------------------------------
+
+OtioGeneratorRef* otio_generator_ref_create(const char* name, const char* generator_kind) {
+    const char* n = name ? name : "";
+    const char* gk = generator_kind ? generator_kind : "";
+    OTIO_TRY_PTR(
+        auto ref = new otio::GeneratorReference(n, gk);
+        Retainer<otio::GeneratorReference> retainer(ref);
+        return reinterpret_cast<OtioGeneratorRef*>(retainer.take_value());
+    )
+}
+
+void otio_generator_ref_free(OtioGeneratorRef* ref) {
+    if (ref) {
+        try {
+            auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+            Retainer<otio::GeneratorReference> retainer(typed);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_generator_ref_get_name(OtioGeneratorRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+        return safe_strdup(typed->name());
+    )
+}
+
+char* otio_generator_ref_get_generator_kind(OtioGeneratorRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+        return safe_strdup(typed->generator_kind());
+    )
+}
+
+void otio_generator_ref_set_generator_kind(OtioGeneratorRef* ref, const char* kind) {
+    if (!ref || !kind) return;
+    try {
+        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+        typed->set_generator_kind(std::string(kind));
+    } catch (...) {
+    }
+}
+
+int otio_generator_ref_set_available_range(OtioGeneratorRef* ref, OtioTimeRange range, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(ref, err, -1, "GeneratorReference is null");
+    OTIO_TRY_INT(err,
+        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+        typed->set_available_range(to_otio_tr(range));
+    )
+}
+
+OtioTimeRange otio_generator_ref_get_available_range(OtioGeneratorRef* ref) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!ref) return zero;
+    try {
+        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
+        auto range_opt = typed->available_range();
+        if (!range_opt.has_value()) return zero;
+        auto range = range_opt.value();
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (...) {
+        return zero;
+    }
+}
+
+void otio_generator_ref_set_metadata_string(OtioGeneratorRef* ref, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::GeneratorReference*>(ref), key, value);
+}
+
+char* otio_generator_ref_get_metadata_string(OtioGeneratorRef* ref, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::GeneratorReference*>(ref), key);
+}
+
+// ----------------------------------------------------------------------------
+// LinearTimeWarp
+// ----------------------------------------------------------------------------
+
+OtioLinearTimeWarp* otio_linear_time_warp_create(const char* name, double time_scalar) {
+    const char* n = name ? name : "";
+    OTIO_TRY_PTR(
+        auto effect = new otio::LinearTimeWarp(n, "", time_scalar);
+        Retainer<otio::LinearTimeWarp> retainer(effect);
+        return reinterpret_cast<OtioLinearTimeWarp*>(retainer.take_value());
+    )
+}
+
+void otio_linear_time_warp_free(OtioLinearTimeWarp* effect) {
+    if (effect) {
+        try {
+            auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
+            Retainer<otio::LinearTimeWarp> retainer(typed);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_linear_time_warp_get_name(OtioLinearTimeWarp* effect) {
+    OTIO_NULL_CHECK(effect, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
+        return safe_strdup(typed->name());
+    )
+}
+
+double otio_linear_time_warp_get_time_scalar(OtioLinearTimeWarp* effect) {
+    if (!effect) return 1.0;
+    try {
+        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
+        return typed->time_scalar();
+    } catch (...) {
+        return 1.0;
+    }
+}
+
+void otio_linear_time_warp_set_time_scalar(OtioLinearTimeWarp* effect, double scalar) {
+    if (!effect) return;
+    try {
+        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
+        typed->set_time_scalar(scalar);
+    } catch (...) {
+    }
+}
+
+void otio_linear_time_warp_set_metadata_string(OtioLinearTimeWarp* effect, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::LinearTimeWarp*>(effect), key, value);
+}
+
+char* otio_linear_time_warp_get_metadata_string(OtioLinearTimeWarp* effect, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::LinearTimeWarp*>(effect), key);
+}
+
+// ----------------------------------------------------------------------------
+// FreezeFrame
+// ----------------------------------------------------------------------------
+
+OtioFreezeFrame* otio_freeze_frame_create(const char* name) {
+    const char* n = name ? name : "";
+    OTIO_TRY_PTR(
+        auto effect = new otio::FreezeFrame(n);
+        Retainer<otio::FreezeFrame> retainer(effect);
+        return reinterpret_cast<OtioFreezeFrame*>(retainer.take_value());
+    )
+}
+
+void otio_freeze_frame_free(OtioFreezeFrame* effect) {
+    if (effect) {
+        try {
+            auto typed = reinterpret_cast<otio::FreezeFrame*>(effect);
+            Retainer<otio::FreezeFrame> retainer(typed);
+        } catch (...) {
+        }
+    }
+}
+
+char* otio_freeze_frame_get_name(OtioFreezeFrame* effect) {
+    OTIO_NULL_CHECK(effect, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::FreezeFrame*>(effect);
+        return safe_strdup(typed->name());
+    )
+}
+
+void otio_freeze_frame_set_metadata_string(OtioFreezeFrame* effect, const char* key, const char* value) {
+    set_metadata_string_impl(reinterpret_cast<otio::FreezeFrame*>(effect), key, value);
+}
+
+char* otio_freeze_frame_get_metadata_string(OtioFreezeFrame* effect, const char* key) {
+    return get_metadata_string_impl(reinterpret_cast<otio::FreezeFrame*>(effect), key);
+}
+
+// ----------------------------------------------------------------------------
+// Clip Marker/Effect attachment
+// ----------------------------------------------------------------------------
+
+int otio_clip_add_marker(OtioClip* clip, OtioMarker* marker, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto m = reinterpret_cast<otio::Marker*>(marker);
+        c->markers().push_back(m);
+        note_content_changed(c);
+    )
+}
+
+int32_t otio_clip_markers_count(OtioClip* clip) {
+    if (!clip) return 0;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        return static_cast<int32_t>(c->markers().size());
+    } catch (...) {
+        return 0;
+    }
+}
+
+OtioMarker* otio_clip_marker_at(OtioClip* clip, int32_t index) {
+    if (!clip) return nullptr;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto& markers = c->markers();
+        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
+        return reinterpret_cast<OtioMarker*>(markers[index].value);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+OtioMarker* otio_clip_marker_at_mut(OtioClip* clip, int32_t index) {
+    if (!clip) return nullptr;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto& markers = c->markers();
+        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
+        // The marker can be edited through the handle, which fingerprints
+        // cannot see
+        note_content_changed(c);
+        return reinterpret_cast<OtioMarker*>(unshared_attachment(markers[index]));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+int otio_clip_add_effect(OtioClip* clip, OtioEffect* effect, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(effect, err, -1, "Effect is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto e = reinterpret_cast<otio::Effect*>(effect);
+        c->effects().push_back(e);
+        note_content_changed(c);
+    )
+}
+
+int32_t otio_clip_effects_count(OtioClip* clip) {
+    if (!clip) return 0;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        return static_cast<int32_t>(c->effects().size());
+    } catch (...) {
+        return 0;
+    }
+}
+
+OtioEffect* otio_clip_effect_at(OtioClip* clip, int32_t index) {
+    if (!clip) return nullptr;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto& effects = c->effects();
+        if (index < 0 || static_cast<size_t>(index) >= effects.size()) return nullptr;
+        return reinterpret_cast<OtioEffect*>(effects[index].value);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+OtioEffect* otio_clip_effect_at_mut(OtioClip* clip, int32_t index) {
+    if (!clip) return nullptr;
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto& effects = c->effects();
+        if (index < 0 || static_cast<size_t>(index) >= effects.size()) return nullptr;
+        // The effect can be edited through the handle, which fingerprints
+        // cannot see
+        note_content_changed(c);
+        return reinterpret_cast<OtioEffect*>(unshared_attachment(effects[index]));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+int otio_clip_add_linear_time_warp(OtioClip* clip, OtioLinearTimeWarp* effect, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_NULL_CHECK_ERR(effect, err, -1, "LinearTimeWarp is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto e = reinterpret_cast<otio::LinearTimeWarp*>(effect);
+        c->effects().push_back(e);
+        note_content_changed(c);
+    )
+}
+
+int otio_clip_set_missing_reference(OtioClip* clip, OtioMissingRef* ref, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto r = reinterpret_cast<otio::MissingReference*>(ref);
+        auto undo = journal_media_references(c);
+        c->set_media_reference(r);
+        note_media_references_changed(c);
+        journal_push(c, std::move(undo));
+    )
+}
+
+int otio_clip_set_generator_reference(OtioClip* clip, OtioGeneratorRef* ref, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    OTIO_TRY_INT(err,
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto r = reinterpret_cast<otio::GeneratorReference*>(ref);
+        auto undo = journal_media_references(c);
+        c->set_media_reference(r);
+        note_media_references_changed(c);
+        journal_push(c, std::move(undo));
+    )
+}
+
+// ----------------------------------------------------------------------------
+// Track Marker attachment
+// ----------------------------------------------------------------------------
+
+int otio_track_add_marker(OtioTrack* track, OtioMarker* marker, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
+    OTIO_TRY_INT(err,
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto m = reinterpret_cast<otio::Marker*>(marker);
+        t->markers().push_back(m);
+        note_content_changed(t);
+    )
+}
+
+int32_t otio_track_markers_count(OtioTrack* track) {
+    if (!track) return 0;
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        return static_cast<int32_t>(t->markers().size());
+    } catch (...) {
+        return 0;
+    }
+}
+
+OtioMarker* otio_track_marker_at(OtioTrack* track, int32_t index) {
+    if (!track) return nullptr;
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto& markers = t->markers();
+        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
+        return reinterpret_cast<OtioMarker*>(markers[index].value);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+OtioMarker* otio_track_marker_at_mut(OtioTrack* track, int32_t index) {
+    if (!track) return nullptr;
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto& markers = t->markers();
+        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
+        // The marker can be edited through the handle, which fingerprints
+        // cannot see
+        note_content_changed(t);
+        return reinterpret_cast<OtioMarker*>(unshared_attachment(markers[index]));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Track kind
+// ----------------------------------------------------------------------------
+
+int32_t otio_track_get_kind(OtioTrack* track) {
+    if (!track) return OTIO_TRACK_KIND_VIDEO;
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto kind = t->kind();
+        if (kind == otio::Track::Kind::audio) return OTIO_TRACK_KIND_AUDIO;
+        return OTIO_TRACK_KIND_VIDEO;
+    } catch (...) {
+        return OTIO_TRACK_KIND_VIDEO;
+    }
+}
+
+void otio_track_set_kind(OtioTrack* track, int32_t kind) {
+    if (!track) return;
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        if (kind == OTIO_TRACK_KIND_AUDIO) {
+            t->set_kind(otio::Track::Kind::audio);
+        } else {
+            t->set_kind(otio::Track::Kind::video);
+        }
+        note_content_changed(t);
+    } catch (...) {
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Range cache
+// ----------------------------------------------------------------------------
+
+struct OtioRangeCache : MutationListener {
+    otio::Composition* target;  // Borrowed: outlives the cache
+    std::mutex mutex;
+    // Valid prefix of child ranges, and the cursor offset after each of them
+    std::vector<otio::TimeRange> ranges;
+    std::vector<std::optional<otio::RationalTime>> offsets;
+    std::optional<otio::TimeRange> trimmed;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> recomputed{0};
+
+    explicit OtioRangeCache(otio::Composition* comp) : target(comp) {}
+
+    void on_mutation(size_t first_child) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        trimmed.reset();
+        if (first_child < ranges.size()) {
+            ranges.resize(first_child);
+            offsets.resize(first_child);
+        }
+    }
+};
+
+struct RangeCacheRegistry {
+    std::mutex mutex;
+    std::unordered_map<const otio::Composition*, OtioRangeCache*> caches;
+    // Bumped, under the mutex, whenever a cache is added or removed
+    std::atomic<uint64_t> generation{1};
+    std::atomic<size_t> live{0};
+};
+
+static RangeCacheRegistry& range_cache_registry() {
+    static RangeCacheRegistry registry;
+    return registry;
+}
+
+// Every range query looks up its composition's cache, so each thread
+// remembers its last lookup and only goes to the locked map when a cache was
+// added or removed since, or for another composition.
+static OtioRangeCache* find_range_cache(const otio::Composition* comp) {
+    auto& registry = range_cache_registry();
+    if (registry.live.load(std::memory_order_acquire) == 0) return nullptr;
+    struct Memo {
+        const otio::Composition* comp = nullptr;
+        OtioRangeCache* cache = nullptr;
+        uint64_t generation = 0;
+    };
+    static thread_local Memo memo;
+    uint64_t generation = registry.generation.load(std::memory_order_acquire);
+    if (memo.comp == comp && memo.generation == generation) return memo.cache;
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.caches.find(comp);
+    memo = Memo{comp, it == registry.caches.end() ? nullptr : it->second,
+        registry.generation.load(std::memory_order_relaxed)};
+    return memo.cache;
+}
+
+// Serve a child range from comp's cache, extending the valid prefix up to
+// index on a miss. Returns false when comp has no cache.
+static bool cached_range_of_child(otio::Composition* comp, size_t index,
+    otio::TimeRange& range, otio::ErrorStatus* status) {
+    OtioRangeCache* cache = find_range_cache(comp);
+    if (!cache) return false;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (index < cache->ranges.size()) {
+        ++cache->hits;
+        range = cache->ranges[index];
+        return true;
+    }
+    ++cache->misses;
+    ChildRangeCursor cursor(comp);
+    if (!cache->offsets.empty()) cursor.offset = cache->offsets.back();
+    auto& children = comp->children();
+    for (size_t i = cache->ranges.size(); i <= index; ++i) {
+        otio::TimeRange child_range;
+        if (!cursor.next(children[i].value, child_range, status)) return true;
+        cache->ranges.push_back(child_range);
+        cache->offsets.push_back(cursor.offset);
+        ++cache->recomputed;
+    }
+    range = cache->ranges[index];
+    return true;
+}
+
+// Serve comp's trimmed range from its cache. Returns false when comp has no cache.
+static bool cached_trimmed_range(otio::Composition* comp, otio::TimeRange& range, otio::ErrorStatus* status) {
+    OtioRangeCache* cache = find_range_cache(comp);
+    if (!cache) return false;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (cache->trimmed) {
+        ++cache->hits;
+        range = *cache->trimmed;
+        return true;
+    }
+    ++cache->misses;
+    range = comp->trimmed_range(status);
+    if (!otio::is_error(*status)) cache->trimmed = range;
+    return true;
+}
+
+static OtioRangeCache* enable_range_cache(otio::Composition* comp, OtioError* err) {
+    try {
+        std::unique_ptr<OtioRangeCache> cache(new OtioRangeCache(comp));
+        {
+            auto& registry = range_cache_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            if (!registry.caches.emplace(comp, cache.get()).second) {
+                set_error(err, 1, "Range cache already enabled");
+                return nullptr;
+            }
+            registry.generation.fetch_add(1, std::memory_order_release);
+            registry.live.fetch_add(1, std::memory_order_release);
+        }
+        add_mutation_listener(comp, cache.get());
+        return cache.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
+}
+
+OtioRangeCache* otio_track_enable_range_cache(OtioTrack* track, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    return enable_range_cache(reinterpret_cast<otio::Track*>(track), err);
+}
+
+OtioRangeCache* otio_stack_enable_range_cache(OtioStack* stack, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    return enable_range_cache(reinterpret_cast<otio::Stack*>(stack), err);
+}
+
+void otio_range_cache_free(OtioRangeCache* cache) {
+    if (!cache) return;
+    try {
+        {
+            auto& registry = range_cache_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.caches.erase(cache->target);
+            registry.generation.fetch_add(1, std::memory_order_release);
+            registry.live.fetch_sub(1, std::memory_order_release);
+        }
+        remove_mutation_listener(cache->target, cache);
+        delete cache;
+    } catch (...) {
+    }
+}
+
+void otio_range_cache_get_stats(OtioRangeCache* cache, OtioRangeCacheStats* stats) {
+    if (!cache || !stats) return;
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->recomputed = cache->recomputed;
+}
+
+// ----------------------------------------------------------------------------
+// Time transforms
+// ----------------------------------------------------------------------------
+
+OtioTimeRange otio_track_range_of_child_at_index(OtioTrack* track, int32_t index, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!track) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Track is null", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto& children = t->children();
+        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
+            if (err) {
+                err->code = -1;
+                strncpy(err->message, "Index out of bounds", sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        otio::ErrorStatus status;
+        otio::TimeRange range;
+        if (!cached_range_of_child(t, static_cast<size_t>(index), range, &status)) {
+            range = t->range_of_child_at_index(index, &status);
+        }
+        if (otio::is_error(status)) {
+            if (err) {
+                err->code = static_cast<int>(status.outcome);
+                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        }
+        return zero;
+    } catch (...) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+}
+
+OtioTimeRange otio_stack_range_of_child_at_index(OtioStack* stack, int32_t index, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!stack) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Stack is null", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+    try {
+        auto s = reinterpret_cast<otio::Stack*>(stack);
+        auto& children = s->children();
+        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
+            if (err) {
+                err->code = -1;
+                strncpy(err->message, "Index out of bounds", sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        otio::ErrorStatus status;
+        otio::TimeRange range;
+        if (!cached_range_of_child(s, static_cast<size_t>(index), range, &status)) {
+            range = s->range_of_child_at_index(index, &status);
+        }
+        if (otio::is_error(status)) {
+            if (err) {
+                err->code = static_cast<int>(status.outcome);
+                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        }
+        return zero;
+    } catch (...) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+}
+
+OtioTimeRange otio_track_trimmed_range(OtioTrack* track, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!track) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Track is null", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        otio::ErrorStatus status;
+        otio::TimeRange range;
+        if (!cached_trimmed_range(t, range, &status)) range = t->trimmed_range(&status);
+        if (otio::is_error(status)) {
+            if (err) {
+                err->code = static_cast<int>(status.outcome);
+                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        }
+        return zero;
+    } catch (...) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+}
+
+OtioTimeRange otio_stack_trimmed_range(OtioStack* stack, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!stack) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Stack is null", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+    try {
+        auto s = reinterpret_cast<otio::Stack*>(stack);
+        otio::ErrorStatus status;
+        otio::TimeRange range;
+        if (!cached_trimmed_range(s, range, &status)) range = s->trimmed_range(&status);
+        if (otio::is_error(status)) {
+            if (err) {
+                err->code = static_cast<int>(status.outcome);
+                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        }
+        return zero;
+    } catch (...) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// ExternalReference additional accessors
+// ----------------------------------------------------------------------------
+
+char* otio_external_ref_get_target_url(OtioExternalRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
+        return safe_strdup(typed->target_url());
+    )
+}
+
+OtioTimeRange otio_external_ref_get_available_range(OtioExternalRef* ref) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!ref) return zero;
+    try {
+        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
+        auto range_opt = typed->available_range();
+        if (!range_opt.has_value()) return zero;
+        auto range = range_opt.value();
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (...) {
+        return zero;
+    }
+}
+
+char* otio_external_ref_get_name(OtioExternalRef* ref) {
+    OTIO_NULL_CHECK(ref, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
+        return safe_strdup(typed->name());
+    )
+}
+
+void otio_external_ref_set_name(OtioExternalRef* ref, const char* name) {
+    if (!ref || !name) return;
+    try {
+        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
+        typed->set_name(std::string(name));
+    } catch (...) {
+        // Ignore exceptions
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Timeline additional accessors
+// ----------------------------------------------------------------------------
+
+char* otio_timeline_get_name(OtioTimeline* tl) {
+    OTIO_NULL_CHECK(tl, nullptr);
+    OTIO_TRY_PTR(
+        auto typed = reinterpret_cast<otio::Timeline*>(tl);
+        return safe_strdup(typed->name());
+    )
+}
+
+OtioRationalTime otio_timeline_get_global_start_time(OtioTimeline* tl) {
+    OtioRationalTime zero = {0, 1};
+    if (!tl) return zero;
+    try {
+        auto typed = reinterpret_cast<otio::Timeline*>(tl);
+        auto time_opt = typed->global_start_time();
+        if (!time_opt.has_value()) return zero;
+        auto time = time_opt.value();
+        return OtioRationalTime{time.value(), time.rate()};
+    } catch (...) {
+        return zero;
+    }
+}
+
+OtioTimeRange otio_timeline_get_duration(OtioTimeline* tl, OtioError* err) {
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!tl) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Timeline is null", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+    try {
+        auto typed = reinterpret_cast<otio::Timeline*>(tl);
+        otio::ErrorStatus status;
+        auto duration = typed->duration(&status);
+        if (otio::is_error(status)) {
+            if (err) {
+                err->code = static_cast<int>(status.outcome);
+                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            }
+            return zero;
+        }
+        // Return as a TimeRange with start at 0
+        return OtioTimeRange{
+            OtioRationalTime{0, duration.rate()},
+            OtioRationalTime{duration.value(), duration.rate()}
+        };
+    } catch (const std::exception& e) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        }
+        return zero;
+    } catch (...) {
+        if (err) {
+            err->code = -1;
+            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        }
+        return zero;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Edit Algorithms
+// ----------------------------------------------------------------------------
+
+int otio_track_overwrite(OtioTrack* track, OtioClip* clip,
+    OtioTimeRange range, int remove_transitions, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_children(t);
+        otio::ErrorStatus status;
+        otio::algo::overwrite(c, t, to_otio_tr(range), remove_transitions != 0, nullptr, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        note_children_changed(t, 0);
+        journal_push(t, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+int otio_track_insert_at_time(OtioTrack* track, OtioClip* clip,
+    OtioRationalTime time, int remove_transitions, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_children(t);
+        otio::ErrorStatus status;
+        otio::algo::insert(c, t, to_otio_rt(time), remove_transitions != 0, nullptr, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        note_children_changed(t, 0);
+        journal_push(t, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+int otio_track_slice_at_time(OtioTrack* track, OtioRationalTime time,
+    int remove_transitions, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    try {
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto undo = journal_children(t);
+        otio::ErrorStatus status;
+        otio::algo::slice(t, to_otio_rt(time), remove_transitions != 0, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return -1;
+        }
+        note_children_changed(t, 0);
+        journal_push(t, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
 }
 
-OtioTimeline* otio_timeline_read_from_file(const char* path, OtioError* err) {
-    if (!path) {
-        set_error(err, 1, "Path is null");
-        return nullptr;
-    }
+int otio_clip_slip(OtioClip* clip, OtioRationalTime delta, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
     try {
-        otio::ErrorStatus status;
-        auto result = otio::SerializableObject::from_json_file(path, &status);
-        if (otio::is_error(status) || !result) {
-            set_error(err, 1, status.full_description.c_str());
-            return nullptr;
-        }
-        auto timeline = dynamic_cast<otio::Timeline*>(result);
-        if (!timeline) {
-            set_error(err, 1, "File does not contain a Timeline");
-            Retainer<otio::SerializableObject> retainer(result);
-            return nullptr;
-        }
-        Retainer<otio::Timeline> retainer(timeline);
-        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_item_edit(c);
+        otio::algo::slip(c, to_otio_rt(delta));
+        note_item_edited(c);
+        journal_push(c, std::move(undo));
+        return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return nullptr;
+        return -1;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return nullptr;
+        return -1;
     }
 }
 
-char* otio_timeline_to_json_string(OtioTimeline* tl, OtioError* err) {
-    if (!tl) {
-        set_error(err, 1, "Timeline is null");
-        return nullptr;
+int otio_clip_slide(OtioClip* clip, OtioRationalTime delta, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_item_edit(c);
+        otio::algo::slide(c, to_otio_rt(delta));
+        note_item_edited(c);
+        journal_push(c, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
+}
+
+int otio_clip_trim(OtioClip* clip, OtioRationalTime delta_in,
+    OtioRationalTime delta_out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
     try {
-        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_item_edit(c);
         otio::ErrorStatus status;
-        std::string json = timeline->to_json_string(&status);
+        otio::algo::trim(c, to_otio_rt(delta_in), to_otio_rt(delta_out), nullptr, &status);
         if (otio::is_error(status)) {
             set_error(err, 1, status.full_description.c_str());
-            return nullptr;
+            return -1;
         }
-        return safe_strdup(json);
+        note_item_edited(c);
+        journal_push(c, std::move(undo));
+        return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return nullptr;
+        return -1;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return nullptr;
+        return -1;
     }
 }
 
-OtioTimeline* otio_timeline_from_json_string(const char* json, OtioError* err) {
-    if (!json) {
-        set_error(err, 1, "JSON string is null");
-        return nullptr;
-    }
+int otio_clip_ripple(OtioClip* clip, OtioRationalTime delta_in,
+    OtioRationalTime delta_out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
     try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_item_edit(c);
         otio::ErrorStatus status;
-        auto result = otio::SerializableObject::from_json_string(json, &status);
-        if (otio::is_error(status) || !result) {
+        otio::algo::ripple(c, to_otio_rt(delta_in), to_otio_rt(delta_out), &status);
+        if (otio::is_error(status)) {
             set_error(err, 1, status.full_description.c_str());
-            return nullptr;
-        }
-        auto timeline = dynamic_cast<otio::Timeline*>(result);
-        if (!timeline) {
-            set_error(err, 1, "JSON does not contain a Timeline");
-            Retainer<otio::SerializableObject> retainer(result);
-            return nullptr;
+            return -1;
         }
-        Retainer<otio::Timeline> retainer(timeline);
-        return reinterpret_cast<OtioTimeline*>(retainer.take_value());
+        note_item_edited(c);
+        journal_push(c, std::move(undo));
+        return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return nullptr;
+        return -1;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return nullptr;
+        return -1;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Serialization with schema version targeting
-// ----------------------------------------------------------------------------
-
-int otio_timeline_write_to_file_with_schema_versions(
-    OtioTimeline* tl,
-    const char* path,
-    const char** schema_names,
-    const int64_t* schema_versions,
-    int32_t count,
-    OtioError* err
-) {
-    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
-    OTIO_NULL_CHECK_ERR(path, err, -1, "Path is null");
-
-    // Build schema version map from arrays
-    otio::schema_version_map version_map;
-    if (schema_names && schema_versions && count > 0) {
-        for (int32_t i = 0; i < count; i++) {
-            if (schema_names[i]) {
-                version_map[schema_names[i]] = schema_versions[i];
-            }
-        }
-    }
-
-    OTIO_TRY_INT(err,
-        OTIO_CAST(Timeline, timeline, tl);
+int otio_clip_roll(OtioClip* clip, OtioRationalTime delta_in,
+    OtioRationalTime delta_out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+    try {
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        auto undo = journal_item_edit(c);
         otio::ErrorStatus status;
-        bool success = timeline->to_json_file(
-            path,
-            &status,
-            version_map.empty() ? nullptr : &version_map
-        );
-        if (!success || otio::is_error(status)) {
+        otio::algo::roll(c, to_otio_rt(delta_in), to_otio_rt(delta_out), &status);
+        if (otio::is_error(status)) {
             set_error(err, 1, status.full_description.c_str());
             return -1;
         }
-    )
-}
-
-char* otio_timeline_to_json_string_with_schema_versions(
-    OtioTimeline* tl,
-    const char** schema_names,
-    const int64_t* schema_versions,
-    int32_t count,
-    OtioError* err
-) {
-    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
-
-    // Build schema version map from arrays
-    otio::schema_version_map version_map;
-    if (schema_names && schema_versions && count > 0) {
-        for (int32_t i = 0; i < count; i++) {
-            if (schema_names[i]) {
-                version_map[schema_names[i]] = schema_versions[i];
-            }
-        }
+        note_item_edited(c);
+        journal_push(c, std::move(undo));
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
+}
 
+int otio_track_remove_at_time(OtioTrack* track, OtioRationalTime time,
+    int fill_with_gap, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
     try {
-        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto undo = journal_children(t);
         otio::ErrorStatus status;
-        std::string json = timeline->to_json_string(
-            &status,
-            version_map.empty() ? nullptr : &version_map
-        );
+        otio::algo::remove(t, to_otio_rt(time), fill_with_gap != 0, nullptr, &status);
         if (otio::is_error(status)) {
             set_error(err, 1, status.full_description.c_str());
-            return nullptr;
+            return -1;
         }
-        return safe_strdup(json);
+        note_children_changed(t, 0);
+        journal_push(t, std::move(undo));
+        return 0;
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return nullptr;
+        return -1;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return nullptr;
+        return -1;
     }
 }
 
 // ----------------------------------------------------------------------------
-// String memory management
-// ----------------------------------------------------------------------------
-
-void otio_free_string(char* str) {
-    free(str);
-}
-
-// ----------------------------------------------------------------------------
-// Metadata - using template helpers
+// Edit transactions
 // ----------------------------------------------------------------------------
 
-void otio_timeline_set_metadata_string(OtioTimeline* tl, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Timeline*>(tl), key, value);
-}
-
-char* otio_timeline_get_metadata_string(OtioTimeline* tl, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Timeline*>(tl), key);
-}
-
-void otio_track_set_metadata_string(OtioTrack* track, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Track*>(track), key, value);
-}
-
-char* otio_track_get_metadata_string(OtioTrack* track, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Track*>(track), key);
-}
-
-void otio_clip_set_metadata_string(OtioClip* clip, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Clip*>(clip), key, value);
-}
-
-char* otio_clip_get_metadata_string(OtioClip* clip, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Clip*>(clip), key);
-}
-
-void otio_gap_set_metadata_string(OtioGap* gap, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Gap*>(gap), key, value);
-}
-
-char* otio_gap_get_metadata_string(OtioGap* gap, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Gap*>(gap), key);
-}
-
-void otio_stack_set_metadata_string(OtioStack* stack, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Stack*>(stack), key, value);
-}
-
-char* otio_stack_get_metadata_string(OtioStack* stack, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Stack*>(stack), key);
-}
+struct TrackEditOp {
+    enum Kind { Overwrite, Insert, Slice, Remove } kind;
+    Retainer<otio::Clip> clip;  // Overwrite and insert
+    otio::TimeRange range;      // Slice, insert and remove use the start
+    bool flag;                  // remove_transitions, or fill_with_gap for Remove
+};
 
-void otio_external_ref_set_metadata_string(OtioExternalRef* ref, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::ExternalReference*>(ref), key, value);
-}
+struct OtioTrackEdit {
+    // Borrowed: the track outlives the edit. A track owned from Rust has a
+    // refcount of 0, so a Retainer here would delete it on release.
+    otio::Track* track;
+    std::vector<TrackEditOp> ops;
+};
 
-char* otio_external_ref_get_metadata_string(OtioExternalRef* ref, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::ExternalReference*>(ref), key);
+static void apply_track_edit(otio::Track* track, const TrackEditOp& op, otio::ErrorStatus* status) {
+    OTIO_STATS_SCOPE(OTIO_STAT_EDIT);
+    switch (op.kind) {
+        case TrackEditOp::Overwrite:
+            otio::algo::overwrite(op.clip.value, track, op.range, op.flag, nullptr, status);
+            break;
+        case TrackEditOp::Insert:
+            otio::algo::insert(op.clip.value, track, op.range.start_time(), op.flag, nullptr, status);
+            break;
+        case TrackEditOp::Slice:
+            otio::algo::slice(track, op.range.start_time(), op.flag, status);
+            break;
+        case TrackEditOp::Remove:
+            otio::algo::remove(track, op.range.start_time(), op.flag, nullptr, status);
+            break;
+    }
 }
 
-// ----------------------------------------------------------------------------
-// Marker
-// ----------------------------------------------------------------------------
-
-OtioMarker* otio_marker_create(const char* name, OtioTimeRange marked_range, const char* color) {
-    OTIO_NULL_CHECK(name, nullptr);
-    const char* c = color ? color : otio::Marker::Color::green;
-    OTIO_TRY_PTR(
-        auto marker = new otio::Marker(name, to_otio_tr(marked_range), c);
-        Retainer<otio::Marker> retainer(marker);
-        return reinterpret_cast<OtioMarker*>(retainer.take_value());
-    )
-}
+// Length of a child in its track's sequence; transitions overlap their
+// neighbours and take none
+static otio::RationalTime track_edit_duration(otio::Composable* child) {
+    auto item = counted_dynamic_cast<otio::Item*>(child);
+    if (!item) return otio::RationalTime();
+    otio::ErrorStatus status;
+    auto range = item->trimmed_range(&status);
+    if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+    return range.duration();
+}
+
+// Edits queued in time order, each starting at or after the previous one,
+// never reach back before the start of the previous edit. The sweep keeps a
+// window of the children around the current edit and runs the OTIO
+// algorithm on a scratch track holding only that window: children left
+// behind the window are final, and children ahead of it are not looked at
+// yet. Each edit then costs in proportion to the children it touches rather
+// than the whole track, and the track's children are set once at the end.
+struct TrackEditSweep {
+    const std::vector<Retainer<otio::Composable>>& input;  // Children before the edits
+    size_t next = 0;                                         // First input child not pulled yet
+    std::vector<Retainer<otio::Composable>> done;            // Children no later edit can reach
+    otio::RationalTime done_end;                             // Track time at the end of `done`
+    std::vector<Retainer<otio::Composable>> window;
+    Retainer<otio::Track> scratch;
+
+    TrackEditSweep(const std::vector<Retainer<otio::Composable>>& children, const otio::Track* track)
+        : input(children), scratch(new otio::Track(track->name(), std::nullopt, track->kind())) {
+        done.reserve(children.size());
+    }
 
-void otio_marker_free(OtioMarker* marker) {
-    if (marker) {
-        try {
-            OTIO_CAST(Marker, m, marker);
-            Retainer<otio::Marker> retainer(m);
-        } catch (...) {
+    // Leave no child parented to the scratch track
+    ~TrackEditSweep() { scratch.value->clear_children(); }
+
+    void apply(const TrackEditOp& op, otio::ErrorStatus* status) {
+        const otio::RationalTime start = op.range.start_time();
+        const otio::RationalTime end = op.kind == TrackEditOp::Overwrite
+            ? op.range.end_time_exclusive() : start;
+
+        // Move everything before the last item that ends before the edit to
+        // `done`; that item stays as the edit's left neighbour
+        size_t keep = 0;
+        otio::RationalTime position = done_end;
+        for (size_t i = 0; i < window.size(); ++i) {
+            position = position + track_edit_duration(window[i].value);
+            if (counted_dynamic_cast<otio::Item*>(window[i].value) && position < start) keep = i;
         }
+        for (size_t i = 0; i < keep; ++i) {
+            done_end = done_end + track_edit_duration(window[i].value);
+            done.push_back(std::move(window[i]));
+        }
+        window.erase(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(keep));
+
+        // Pull children up to the first item starting after the edit, and
+        // the transitions that follow it, as the right neighbour
+        bool ahead = false;
+        position = done_end;
+        for (const auto& child : window) {
+            if (counted_dynamic_cast<otio::Item*>(child.value) && end < position) ahead = true;
+            position = position + track_edit_duration(child.value);
+        }
+        while (next < input.size()) {
+            otio::Composable* child = input[next].value;
+            const bool item = counted_dynamic_cast<otio::Item*>(child) != nullptr;
+            if (ahead && item) break;
+            if (item && end < position) ahead = true;
+            position = position + track_edit_duration(child);
+            window.push_back(input[next++]);
+        }
+
+        std::vector<otio::Composable*> children;
+        children.reserve(window.size());
+        for (const auto& child : window) children.push_back(child.value);
+        scratch.value->set_children(children, status);
+        if (otio::is_error(*status)) return;
+        TrackEditOp local = op;
+        local.range = otio::TimeRange(start - done_end, op.range.duration());
+        apply_track_edit(scratch.value, local, status);
+        window.assign(scratch.value->children().begin(), scratch.value->children().end());
+        scratch.value->clear_children();
     }
-}
 
-char* otio_marker_get_name(OtioMarker* marker) {
-    OTIO_NULL_CHECK(marker, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Marker, m, marker);
-        return safe_strdup(m->name());
-    )
-}
+    // The track's children after the edits
+    std::vector<otio::Composable*> finish() const {
+        std::vector<otio::Composable*> children;
+        children.reserve(done.size() + window.size() + input.size() - next);
+        for (const auto& child : done) children.push_back(child.value);
+        for (const auto& child : window) children.push_back(child.value);
+        for (size_t i = next; i < input.size(); ++i) children.push_back(input[i].value);
+        return children;
+    }
+};
 
-char* otio_marker_get_color(OtioMarker* marker) {
-    OTIO_NULL_CHECK(marker, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Marker, m, marker);
-        return safe_strdup(m->color());
-    )
+// Whether the sweep applies the edits exactly as running them in turn.
+// A trimmed track measures "past the end" from its source range, which
+// the scratch track does not have.
+static bool track_edit_sweepable(const otio::Track* track, const std::vector<TrackEditOp>& ops) {
+    if (track->source_range()) return false;
+    otio::RationalTime previous;
+    for (const auto& op : ops) {
+        if (op.range.start_time() < previous) return false;
+        previous = op.range.start_time();
+    }
+    return true;
 }
 
-void otio_marker_set_color(OtioMarker* marker, const char* color) {
-    if (!marker || !color) return;
+OtioTrackEdit* otio_track_begin_edit(OtioTrack* track, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
     try {
-        OTIO_CAST(Marker, m, marker);
-        m->set_color(std::string(color));
+        auto edit = std::make_unique<OtioTrackEdit>();
+        edit->track = reinterpret_cast<otio::Track*>(track);
+        return edit.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
     }
 }
 
-OtioTimeRange otio_marker_get_marked_range(OtioMarker* marker) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!marker) return zero;
+void otio_track_edit_free(OtioTrackEdit* edit) {
+    delete edit;
+}
+
+static int queue_track_edit(OtioTrackEdit* edit, TrackEditOp::Kind kind, OtioClip* clip,
+    otio::TimeRange range, int flag, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(edit, err, -1, "Edit is null");
+    auto c = reinterpret_cast<otio::Clip*>(clip);
+    if ((kind == TrackEditOp::Overwrite || kind == TrackEditOp::Insert) && !c) {
+        set_error(err, 1, "Clip is null");
+        return -1;
+    }
+    if (c && c->parent()) {
+        set_error(err, 1, "Clip is already in a composition");
+        return -1;
+    }
     try {
-        OTIO_CAST(Marker, m, marker);
-        auto range = m->marked_range();
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
+        edit->ops.push_back(TrackEditOp{kind, Retainer<otio::Clip>(c), range, flag != 0});
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
-        return zero;
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-int otio_marker_set_marked_range(OtioMarker* marker, OtioTimeRange range, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
-    OTIO_TRY_INT(err,
-        OTIO_CAST(Marker, m, marker);
-        m->set_marked_range(to_otio_tr(range));
-    )
+int otio_track_edit_overwrite(OtioTrackEdit* edit, OtioClip* clip, OtioTimeRange range,
+    int remove_transitions, OtioError* err) {
+    return queue_track_edit(edit, TrackEditOp::Overwrite, clip, to_otio_tr(range),
+        remove_transitions, err);
 }
 
-char* otio_marker_get_comment(OtioMarker* marker) {
-    OTIO_NULL_CHECK(marker, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Marker, m, marker);
-        return safe_strdup(m->comment());
-    )
+int otio_track_edit_insert_at_time(OtioTrackEdit* edit, OtioClip* clip, OtioRationalTime time,
+    int remove_transitions, OtioError* err) {
+    return queue_track_edit(edit, TrackEditOp::Insert, clip, otio::TimeRange(to_otio_rt(time)),
+        remove_transitions, err);
 }
 
-void otio_marker_set_comment(OtioMarker* marker, const char* comment) {
-    if (!marker || !comment) return;
-    try {
-        OTIO_CAST(Marker, m, marker);
-        m->set_comment(std::string(comment));
-    } catch (...) {
-    }
+int otio_track_edit_slice_at_time(OtioTrackEdit* edit, OtioRationalTime time,
+    int remove_transitions, OtioError* err) {
+    return queue_track_edit(edit, TrackEditOp::Slice, nullptr, otio::TimeRange(to_otio_rt(time)),
+        remove_transitions, err);
 }
 
-void otio_marker_set_metadata_string(OtioMarker* marker, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Marker*>(marker), key, value);
+int otio_track_edit_remove_at_time(OtioTrackEdit* edit, OtioRationalTime time, int fill_with_gap,
+    OtioError* err) {
+    return queue_track_edit(edit, TrackEditOp::Remove, nullptr, otio::TimeRange(to_otio_rt(time)),
+        fill_with_gap, err);
 }
 
-char* otio_marker_get_metadata_string(OtioMarker* marker, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Marker*>(marker), key);
+int32_t otio_track_edit_count(OtioTrackEdit* edit) {
+    return edit ? static_cast<int32_t>(edit->ops.size()) : 0;
+}
+
+int otio_track_edit_commit(OtioTrackEdit* edit, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(edit, err, -1, "Edit is null");
+    otio::Track* track = edit->track;
+    std::optional<ChildrenSnapshot> snapshot;
+    // The algorithms trim queued clips in place, so a retry needs them back
+    std::vector<std::optional<otio::TimeRange>> clip_ranges;
+    auto roll_back = [&]() {
+        for (size_t i = 0; i < clip_ranges.size(); ++i) {
+            if (auto clip = edit->ops[i].clip.value) clip->set_source_range(clip_ranges[i]);
+        }
+        return !snapshot || snapshot->restore(track);
+    };
+    auto fail = [&](std::string message) {
+        if (!roll_back()) message += "; the track could not be restored";
+        set_error(err, 1, message.c_str());
+        return -1;
+    };
+    size_t index = 0;
+    try {
+        if (edit->ops.empty()) return 0;
+        clip_ranges.reserve(edit->ops.size());
+        for (const auto& op : edit->ops) {
+            clip_ranges.push_back(op.clip.value ? op.clip.value->source_range() : std::nullopt);
+        }
+        snapshot.emplace(track);
+        if (track_edit_sweepable(track, edit->ops)) {
+            track->clear_children();
+            TrackEditSweep sweep(snapshot->children, track);
+            for (; index < edit->ops.size(); ++index) {
+                otio::ErrorStatus status;
+                sweep.apply(edit->ops[index], &status);
+                if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+            }
+            auto children = sweep.finish();
+            otio::ErrorStatus status;
+            track->set_children(children, &status);
+            if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+        } else {
+            for (; index < edit->ops.size(); ++index) {
+                otio::ErrorStatus status;
+                apply_track_edit(track, edit->ops[index], &status);
+                if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+            }
+        }
+    } catch (const std::exception& e) {
+        return fail("Edit " + std::to_string(index) + " failed: " + e.what());
+    } catch (...) {
+        return fail("Unknown exception");
+    }
+    // One notification for the whole batch: caches and indexes recompute
+    // once, and change tracking and the undo journal record the track once
+    edit->ops.clear();
+    note_children_changed(track, 0);
+    try {
+        if (journal_wanted(track)) {
+            journal_push(track, std::make_unique<ChildrenRecord>(track, std::move(*snapshot)));
+        }
+    } catch (...) {
+        // The edit stands without an undo record
+    }
+    return 0;
 }
 
 // ----------------------------------------------------------------------------
-// Effect
+// Time coordinate transforms
 // ----------------------------------------------------------------------------
 
-OtioEffect* otio_effect_create(const char* name, const char* effect_name) {
-    const char* n = name ? name : "";
-    const char* en = effect_name ? effect_name : "";
-    OTIO_TRY_PTR(
-        auto effect = new otio::Effect(n, en);
-        Retainer<otio::Effect> retainer(effect);
-        return reinterpret_cast<OtioEffect*>(retainer.take_value());
-    )
-}
-
-void otio_effect_free(OtioEffect* effect) {
-    if (effect) {
-        try {
-            OTIO_CAST(Effect, e, effect);
-            Retainer<otio::Effect> retainer(e);
-        } catch (...) {
-        }
+// Helper to cast void* to Item* based on type
+static otio::Item* cast_to_item(void* ptr, int32_t type) {
+    if (!ptr) return nullptr;
+    switch (type) {
+        case OTIO_CHILD_TYPE_CLIP:
+            return reinterpret_cast<otio::Clip*>(ptr);
+        case OTIO_CHILD_TYPE_GAP:
+            return reinterpret_cast<otio::Gap*>(ptr);
+        case OTIO_CHILD_TYPE_TRACK:
+            return reinterpret_cast<otio::Track*>(ptr);
+        case OTIO_CHILD_TYPE_STACK:
+            return reinterpret_cast<otio::Stack*>(ptr);
+        default:
+            return nullptr;
     }
 }
 
-char* otio_effect_get_name(OtioEffect* effect) {
-    OTIO_NULL_CHECK(effect, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Effect, e, effect);
-        return safe_strdup(e->name());
-    )
-}
+OtioRationalTime otio_item_transformed_time(void* item, int32_t item_type,
+    OtioRationalTime time, void* to_item, int32_t to_item_type, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_TRANSFORMED_TIME);
+    OtioRationalTime zero = {0, 1};
 
-char* otio_effect_get_effect_name(OtioEffect* effect) {
-    OTIO_NULL_CHECK(effect, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Effect, e, effect);
-        return safe_strdup(e->effect_name());
-    )
-}
+    otio::Item* from_item = cast_to_item(item, item_type);
+    otio::Item* target_item = cast_to_item(to_item, to_item_type);
+
+    if (!from_item) {
+        set_error(err, 1, "Source item is null or invalid type");
+        return zero;
+    }
+    if (!target_item) {
+        set_error(err, 1, "Target item is null or invalid type");
+        return zero;
+    }
 
-void otio_effect_set_effect_name(OtioEffect* effect, const char* effect_name) {
-    if (!effect || !effect_name) return;
     try {
-        OTIO_CAST(Effect, e, effect);
-        e->set_effect_name(std::string(effect_name));
+        otio::ErrorStatus status;
+        auto result = from_item->transformed_time(to_otio_rt(time), target_item, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return zero;
+        }
+        return OtioRationalTime{result.value(), result.rate()};
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return zero;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return zero;
     }
 }
 
-void otio_effect_set_metadata_string(OtioEffect* effect, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Effect*>(effect), key, value);
-}
+OtioTimeRange otio_item_transformed_time_range(void* item, int32_t item_type,
+    OtioTimeRange range, void* to_item, int32_t to_item_type, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_TRANSFORMED_TIME);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
 
-char* otio_effect_get_metadata_string(OtioEffect* effect, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Effect*>(effect), key);
-}
+    otio::Item* from_item = cast_to_item(item, item_type);
+    otio::Item* target_item = cast_to_item(to_item, to_item_type);
 
-// ----------------------------------------------------------------------------
-// Transition
-// ----------------------------------------------------------------------------
+    if (!from_item) {
+        set_error(err, 1, "Source item is null or invalid type");
+        return zero;
+    }
+    if (!target_item) {
+        set_error(err, 1, "Target item is null or invalid type");
+        return zero;
+    }
 
-OtioTransition* otio_transition_create(const char* name, const char* transition_type,
-                                       OtioRationalTime in_offset, OtioRationalTime out_offset) {
-    const char* n = name ? name : "";
-    const char* tt = transition_type ? transition_type : otio::Transition::Type::SMPTE_Dissolve;
-    OTIO_TRY_PTR(
-        auto transition = new otio::Transition(n, tt, to_otio_rt(in_offset), to_otio_rt(out_offset));
-        Retainer<otio::Transition> retainer(transition);
-        return reinterpret_cast<OtioTransition*>(retainer.take_value());
-    )
+    try {
+        otio::ErrorStatus status;
+        auto result = from_item->transformed_time_range(to_otio_tr(range), target_item, &status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{result.start_time().value(), result.start_time().rate()},
+            OtioRationalTime{result.duration().value(), result.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return zero;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return zero;
+    }
 }
 
-void otio_transition_free(OtioTransition* transition) {
-    if (transition) {
-        try {
-            OTIO_CAST(Transition, t, transition);
-            Retainer<otio::Transition> retainer(t);
-        } catch (...) {
-        }
+// One offset Item::transformed_time adds or subtracts on its way from an
+// item up to the common ancestor and back down to the target.
+struct TimeTransformStep {
+    otio::RationalTime offset;
+    bool subtract;
+};
+
+// Collect the steps of from->transformed_time(t, to) once, following the
+// same walk. The ranges of children are what make a single transform
+// expensive (a track sums its earlier children for each one), so a batch
+// only pays for them once.
+static bool compose_time_transform(const otio::Item* from, const otio::Item* to,
+    std::vector<TimeTransformStep>& steps, OtioError* err) {
+    const otio::Item* root = from;
+    while (root->parent()) root = root->parent();
+
+    otio::ErrorStatus status;
+    auto step = [&](const otio::Item* item, bool up) {
+        auto parent = item->parent();
+        auto trimmed = item->trimmed_range(&status).start_time();
+        if (otio::is_error(status)) return false;
+        auto in_parent = parent->range_of_child(item, &status).start_time();
+        if (otio::is_error(status)) return false;
+        steps.push_back(TimeTransformStep{trimmed, up});
+        steps.push_back(TimeTransformStep{in_parent, !up});
+        return true;
+    };
+
+    const otio::Item* item = from;
+    while (item != root && item != to) {
+        if (!step(item, true)) break;
+        item = item->parent();
+    }
+    const otio::Item* ancestor = item;
+    for (item = to; !otio::is_error(status) && item != root && item != ancestor;) {
+        if (!step(item, false)) break;
+        item = item->parent();
     }
+    if (otio::is_error(status)) {
+        set_error(err, 1, status.full_description.c_str());
+        return false;
+    }
+    return true;
 }
 
-char* otio_transition_get_name(OtioTransition* transition) {
-    OTIO_NULL_CHECK(transition, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Transition, t, transition);
-        return safe_strdup(t->name());
-    )
+// Applied with RationalTime's own operators, in order, so mixed rates and
+// rounding come out exactly as from transformed_time
+static inline otio::RationalTime apply_time_transform(otio::RationalTime time,
+    const std::vector<TimeTransformStep>& steps) {
+    for (const auto& step : steps) {
+        time = step.subtract ? time - step.offset : time + step.offset;
+    }
+    return time;
 }
 
-char* otio_transition_get_transition_type(OtioTransition* transition) {
-    OTIO_NULL_CHECK(transition, nullptr);
-    OTIO_TRY_PTR(
-        OTIO_CAST(Transition, t, transition);
-        return safe_strdup(t->transition_type());
-    )
+static bool transform_items(void* item, int32_t item_type, void* to_item, int32_t to_item_type,
+    std::vector<TimeTransformStep>& steps, OtioError* err) {
+    otio::Item* from_item = cast_to_item(item, item_type);
+    otio::Item* target_item = cast_to_item(to_item, to_item_type);
+    if (!from_item) {
+        set_error(err, 1, "Source item is null or invalid type");
+        return false;
+    }
+    if (!target_item) {
+        set_error(err, 1, "Target item is null or invalid type");
+        return false;
+    }
+    return compose_time_transform(from_item, target_item, steps, err);
 }
 
-void otio_transition_set_transition_type(OtioTransition* transition, const char* transition_type) {
-    if (!transition || !transition_type) return;
+int otio_item_transformed_times(void* item, int32_t item_type, const OtioRationalTime* times,
+    int32_t count, void* to_item, int32_t to_item_type, OtioRationalTime* out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_TRANSFORMED_TIME);
+    if (count > 0 && (!times || !out)) {
+        set_error(err, 1, "Time arrays are null");
+        return -1;
+    }
     try {
-        OTIO_CAST(Transition, t, transition);
-        t->set_transition_type(std::string(transition_type));
+        std::vector<TimeTransformStep> steps;
+        if (!transform_items(item, item_type, to_item, to_item_type, steps, err)) return -1;
+        for (int32_t i = 0; i < count; ++i) {
+            auto result = apply_time_transform(to_otio_rt(times[i]), steps);
+            out[i] = OtioRationalTime{result.value(), result.rate()};
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-OtioRationalTime otio_transition_get_in_offset(OtioTransition* transition) {
-    OtioRationalTime zero = {0, 1};
-    if (!transition) return zero;
+int otio_item_transformed_frames(void* item, int32_t item_type, OtioRationalTime start,
+    int32_t count, void* to_item, int32_t to_item_type, OtioRationalTime* out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_TRANSFORMED_TIME);
+    if (count > 0 && !out) {
+        set_error(err, 1, "Output array is null");
+        return -1;
+    }
     try {
-        OTIO_CAST(Transition, t, transition);
-        auto rt = t->in_offset();
-        return OtioRationalTime{rt.value(), rt.rate()};
+        std::vector<TimeTransformStep> steps;
+        if (!transform_items(item, item_type, to_item, to_item_type, steps, err)) return -1;
+        for (int32_t i = 0; i < count; ++i) {
+            auto result = apply_time_transform(otio::RationalTime(start.value + i, start.rate), steps);
+            out[i] = OtioRationalTime{result.value(), result.rate()};
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
-        return zero;
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-void otio_transition_set_in_offset(OtioTransition* transition, OtioRationalTime offset) {
-    if (!transition) return;
+OtioTimeRange otio_clip_range_in_parent(OtioClip* clip, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!clip) {
+        set_error(err, 1, "Clip is null");
+        return zero;
+    }
     try {
-        OTIO_CAST(Transition, t, transition);
-        t->set_in_offset(to_otio_rt(offset));
+        auto c = reinterpret_cast<otio::Clip*>(clip);
+        otio::ErrorStatus status;
+        auto range = c->range_in_parent(&status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return zero;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return zero;
     }
 }
 
-OtioRationalTime otio_transition_get_out_offset(OtioTransition* transition) {
-    OtioRationalTime zero = {0, 1};
-    if (!transition) return zero;
+OtioTimeRange otio_gap_range_in_parent(OtioGap* gap, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_RANGE);
+    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    if (!gap) {
+        set_error(err, 1, "Gap is null");
+        return zero;
+    }
     try {
-        OTIO_CAST(Transition, t, transition);
-        auto rt = t->out_offset();
-        return OtioRationalTime{rt.value(), rt.rate()};
+        auto g = reinterpret_cast<otio::Gap*>(gap);
+        otio::ErrorStatus status;
+        auto range = g->range_in_parent(&status);
+        if (otio::is_error(status)) {
+            set_error(err, 1, status.full_description.c_str());
+            return zero;
+        }
+        return OtioTimeRange{
+            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
+            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        };
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return zero;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
         return zero;
     }
 }
 
-void otio_transition_set_out_offset(OtioTransition* transition, OtioRationalTime offset) {
-    if (!transition) return;
+// ----------------------------------------------------------------------------
+// Object type tags
+// ----------------------------------------------------------------------------
+
+int32_t otio_object_type(void* obj) {
     try {
-        OTIO_CAST(Transition, t, transition);
-        t->set_out_offset(to_otio_rt(offset));
+        return object_type_of(static_cast<otio::SerializableObject*>(obj));
     } catch (...) {
+        return -1;
     }
 }
 
-OtioRationalTime otio_transition_get_duration(OtioTransition* transition) {
-    OtioRationalTime zero = {0, 1};
-    if (!transition) return zero;
-    try {
-        OTIO_CAST(Transition, t, transition);
-        otio::ErrorStatus status;
-        auto rt = t->duration(&status);
-        if (otio::is_error(status)) return zero;
-        return OtioRationalTime{rt.value(), rt.rate()};
-    } catch (...) {
-        return zero;
-    }
+// ----------------------------------------------------------------------------
+// Parent navigation
+// ----------------------------------------------------------------------------
+
+int32_t otio_clip_get_parent_type(OtioClip* clip) {
+    return get_parent_type_impl(reinterpret_cast<otio::Clip*>(clip));
 }
 
-void otio_transition_set_metadata_string(OtioTransition* transition, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::Transition*>(transition), key, value);
+void* otio_clip_get_parent(OtioClip* clip) {
+    return get_parent_impl(reinterpret_cast<otio::Clip*>(clip));
 }
 
-char* otio_transition_get_metadata_string(OtioTransition* transition, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::Transition*>(transition), key);
+int32_t otio_gap_get_parent_type(OtioGap* gap) {
+    return get_parent_type_impl(reinterpret_cast<otio::Gap*>(gap));
 }
 
-int otio_track_append_transition(OtioTrack* track, OtioTransition* transition, OtioError* err) {
-    return append_child_impl<otio::Track, otio::Transition>(
-        reinterpret_cast<otio::Track*>(track),
-        reinterpret_cast<otio::Transition*>(transition), err);
+void* otio_gap_get_parent(OtioGap* gap) {
+    return get_parent_impl(reinterpret_cast<otio::Gap*>(gap));
 }
 
-int otio_track_insert_transition(OtioTrack* track, int32_t index, OtioTransition* transition, OtioError* err) {
-    return insert_child_impl<otio::Track, otio::Transition>(
-        reinterpret_cast<otio::Track*>(track), index,
-        reinterpret_cast<otio::Transition*>(transition), err);
+int32_t otio_transition_get_parent_type(OtioTransition* transition) {
+    return get_parent_type_impl(reinterpret_cast<otio::Transition*>(transition));
+}
+
+void* otio_transition_get_parent(OtioTransition* transition) {
+    return get_parent_impl(reinterpret_cast<otio::Transition*>(transition));
+}
+
+int32_t otio_track_get_parent_type(OtioTrack* track) {
+    return get_parent_type_impl(reinterpret_cast<otio::Track*>(track));
+}
+
+void* otio_track_get_parent(OtioTrack* track) {
+    return get_parent_impl(reinterpret_cast<otio::Track*>(track));
+}
+
+int32_t otio_stack_get_parent_type(OtioStack* stack) {
+    return get_parent_type_impl(reinterpret_cast<otio::Stack*>(stack));
+}
+
+void* otio_stack_get_parent(OtioStack* stack) {
+    return get_parent_impl(reinterpret_cast<otio::Stack*>(stack));
 }
 
 // ----------------------------------------------------------------------------
-// MissingReference
+// Track Iterator (filtered track lists)
 // ----------------------------------------------------------------------------
 
-OtioMissingRef* otio_missing_ref_create(void) {
-    OTIO_TRY_PTR(
-        auto ref = new otio::MissingReference();
-        Retainer<otio::MissingReference> retainer(ref);
-        return reinterpret_cast<OtioMissingRef*>(retainer.take_value());
-    )
+struct OtioTrackIterator {
+    std::vector<otio::Track*> tracks;
+    size_t index;
+
+    OtioTrackIterator() : index(0) {}
+};
+
+OtioTrackIterator* otio_timeline_video_tracks(OtioTimeline* tl) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    if (!tl) return nullptr;
+    try {
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto iter = new OtioTrackIterator();
+        for (auto* track : timeline->video_tracks()) {
+            iter->tracks.push_back(track);
+        }
+        return iter;
+    } catch (...) {
+        return nullptr;
+    }
 }
 
-void otio_missing_ref_free(OtioMissingRef* ref) {
-    if (ref) {
-        try {
-            auto typed = reinterpret_cast<otio::MissingReference*>(ref);
-            Retainer<otio::MissingReference> retainer(typed);
-        } catch (...) {
+OtioTrackIterator* otio_timeline_audio_tracks(OtioTimeline* tl) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    if (!tl) return nullptr;
+    try {
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto iter = new OtioTrackIterator();
+        for (auto* track : timeline->audio_tracks()) {
+            iter->tracks.push_back(track);
         }
+        return iter;
+    } catch (...) {
+        return nullptr;
     }
 }
 
-void otio_missing_ref_set_metadata_string(OtioMissingRef* ref, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::MissingReference*>(ref), key, value);
+int32_t otio_track_iterator_count(OtioTrackIterator* iter) {
+    if (!iter) return 0;
+    return static_cast<int32_t>(iter->tracks.size());
 }
 
-char* otio_missing_ref_get_metadata_string(OtioMissingRef* ref, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::MissingReference*>(ref), key);
+OtioTrack* otio_track_iterator_next(OtioTrackIterator* iter) {
+    if (!iter || iter->index >= iter->tracks.size()) return nullptr;
+    return reinterpret_cast<OtioTrack*>(iter->tracks[iter->index++]);
 }
 
-// ----------------------------------------------------------------------------
-// ImageSequenceReference
-// ----------------------------------------------------------------------------
+void otio_track_iterator_reset(OtioTrackIterator* iter) {
+    if (iter) iter->index = 0;
+}
 
-OtioImageSeqRef* otio_image_seq_ref_create(const char* target_url_base,
-    const char* name_prefix, const char* name_suffix,
-    int32_t start_frame, int32_t frame_step, double rate, int32_t frame_zero_padding) {
-    const char* url = target_url_base ? target_url_base : "";
-    const char* prefix = name_prefix ? name_prefix : "";
-    const char* suffix = name_suffix ? name_suffix : "";
-    OTIO_TRY_PTR(
-        auto ref = new otio::ImageSequenceReference(
-            url, prefix, suffix, start_frame, frame_step, rate, frame_zero_padding);
-        Retainer<otio::ImageSequenceReference> retainer(ref);
-        return reinterpret_cast<OtioImageSeqRef*>(retainer.take_value());
-    )
+void otio_track_iterator_free(OtioTrackIterator* iter) {
+    delete iter;
 }
 
-void otio_image_seq_ref_free(OtioImageSeqRef* ref) {
-    if (ref) {
-        try {
-            auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-            Retainer<otio::ImageSequenceReference> retainer(typed);
-        } catch (...) {
+static int32_t timeline_tracks_into(OtioTimeline* tl, const char* kind, OtioTrack** tracks,
+    int32_t capacity, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    try {
+        auto root = reinterpret_cast<otio::Timeline*>(tl)->tracks();
+        HandleSink<OtioTrack> sink(tracks, capacity);
+        if (!root) return 0;
+        // Same selection as Timeline::video_tracks, without its vector
+        for (auto& child : root->children()) {
+            auto track = counted_dynamic_cast<otio::Track*>(child.value);
+            if (track && track->kind() == kind) sink(track);
         }
+        return sink.total;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-char* otio_image_seq_ref_get_target_url_base(OtioImageSeqRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return safe_strdup(typed->target_url_base());
-    )
+int32_t otio_timeline_video_tracks_into(OtioTimeline* tl, OtioTrack** tracks, int32_t capacity,
+    OtioError* err) {
+    return timeline_tracks_into(tl, otio::Track::Kind::video, tracks, capacity, err);
 }
 
-char* otio_image_seq_ref_get_name_prefix(OtioImageSeqRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return safe_strdup(typed->name_prefix());
-    )
+int32_t otio_timeline_audio_tracks_into(OtioTimeline* tl, OtioTrack** tracks, int32_t capacity,
+    OtioError* err) {
+    return timeline_tracks_into(tl, otio::Track::Kind::audio, tracks, capacity, err);
 }
 
-char* otio_image_seq_ref_get_name_suffix(OtioImageSeqRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return safe_strdup(typed->name_suffix());
-    )
-}
+// ----------------------------------------------------------------------------
+// Clip Iterator (find_clips search)
+// ----------------------------------------------------------------------------
+
+struct OtioClipIterator {
+    std::vector<otio::Clip*> clips;
+    size_t index;
+
+    OtioClipIterator() : index(0) {}
+};
 
-int32_t otio_image_seq_ref_get_start_frame(OtioImageSeqRef* ref) {
-    if (!ref) return 1;
+OtioClipIterator* otio_track_find_clips(OtioTrack* track) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    if (!track) return nullptr;
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->start_frame();
+        auto t = reinterpret_cast<otio::Track*>(track);
+        auto iter = new OtioClipIterator();
+
+        // Iterate through children and collect clips
+        for (auto& child : t->children()) {
+            if (object_type_of(child.value) == OTIO_CHILD_TYPE_CLIP) {
+                iter->clips.push_back(static_cast<otio::Clip*>(child.value));
+            }
+        }
+        return iter;
     } catch (...) {
-        return 1;
+        return nullptr;
     }
 }
 
-int32_t otio_image_seq_ref_get_end_frame(OtioImageSeqRef* ref) {
-    if (!ref) return 1;
+OtioClipIterator* otio_stack_find_clips(OtioStack* stack) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    if (!stack) return nullptr;
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->end_frame();
+        auto s = reinterpret_cast<otio::Stack*>(stack);
+        auto iter = new OtioClipIterator();
+        find_clips_recursive(s, iter->clips);
+        return iter;
     } catch (...) {
-        return 1;
+        return nullptr;
     }
 }
 
-int32_t otio_image_seq_ref_get_frame_step(OtioImageSeqRef* ref) {
-    if (!ref) return 1;
+OtioClipIterator* otio_timeline_find_clips(OtioTimeline* timeline) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    if (!timeline) return nullptr;
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->frame_step();
+        auto tl = reinterpret_cast<otio::Timeline*>(timeline);
+        auto iter = new OtioClipIterator();
+        find_clips_recursive(tl->tracks(), iter->clips);
+        return iter;
     } catch (...) {
-        return 1;
+        return nullptr;
     }
 }
 
-double otio_image_seq_ref_get_rate(OtioImageSeqRef* ref) {
-    if (!ref) return 1.0;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->rate();
-    } catch (...) {
-        return 1.0;
-    }
+int32_t otio_clip_iterator_count(OtioClipIterator* iter) {
+    if (!iter) return 0;
+    return static_cast<int32_t>(iter->clips.size());
 }
 
-int32_t otio_image_seq_ref_get_frame_zero_padding(OtioImageSeqRef* ref) {
-    if (!ref) return 0;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->frame_zero_padding();
-    } catch (...) {
-        return 0;
-    }
+OtioClip* otio_clip_iterator_next(OtioClipIterator* iter) {
+    if (!iter || iter->index >= iter->clips.size()) return nullptr;
+    return reinterpret_cast<OtioClip*>(iter->clips[iter->index++]);
 }
 
-int32_t otio_image_seq_ref_get_missing_frame_policy(OtioImageSeqRef* ref) {
-    if (!ref) return OTIO_MISSING_FRAME_ERROR;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return static_cast<int32_t>(typed->missing_frame_policy());
-    } catch (...) {
-        return OTIO_MISSING_FRAME_ERROR;
-    }
+void otio_clip_iterator_reset(OtioClipIterator* iter) {
+    if (iter) iter->index = 0;
 }
 
-void otio_image_seq_ref_set_target_url_base(OtioImageSeqRef* ref, const char* url_base) {
-    if (!ref || !url_base) return;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_target_url_base(std::string(url_base));
-    } catch (...) {
-    }
+void otio_clip_iterator_free(OtioClipIterator* iter) {
+    delete iter;
 }
 
-void otio_image_seq_ref_set_name_prefix(OtioImageSeqRef* ref, const char* prefix) {
-    if (!ref || !prefix) return;
+static int32_t find_clips_into(otio::Composition* comp, bool recursive, OtioClip** clips,
+    int32_t capacity, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_name_prefix(std::string(prefix));
+        HandleSink<OtioClip> sink(clips, capacity);
+        if (recursive) {
+            for_each_clip(comp, sink);
+        } else if (comp) {
+            for (auto& child : comp->children()) {
+                if (object_type_of(child.value) == OTIO_CHILD_TYPE_CLIP) sink(child.value);
+            }
+        }
+        return sink.total;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-void otio_image_seq_ref_set_name_suffix(OtioImageSeqRef* ref, const char* suffix) {
-    if (!ref || !suffix) return;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_name_suffix(std::string(suffix));
-    } catch (...) {
-    }
+int32_t otio_track_find_clips_into(OtioTrack* track, OtioClip** clips, int32_t capacity,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+    return find_clips_into(reinterpret_cast<otio::Track*>(track), false, clips, capacity, err);
 }
 
-void otio_image_seq_ref_set_start_frame(OtioImageSeqRef* ref, int32_t frame) {
-    if (!ref) return;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_start_frame(frame);
-    } catch (...) {
-    }
+int32_t otio_stack_find_clips_into(OtioStack* stack, OtioClip** clips, int32_t capacity,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, -1, "Stack is null");
+    return find_clips_into(reinterpret_cast<otio::Stack*>(stack), true, clips, capacity, err);
 }
 
-void otio_image_seq_ref_set_frame_step(OtioImageSeqRef* ref, int32_t step) {
-    if (!ref) return;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_frame_step(step);
-    } catch (...) {
-    }
+int32_t otio_timeline_find_clips_into(OtioTimeline* timeline, OtioClip** clips, int32_t capacity,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(timeline, err, -1, "Timeline is null");
+    return find_clips_into(reinterpret_cast<otio::Timeline*>(timeline)->tracks(), true, clips,
+        capacity, err);
 }
 
-void otio_image_seq_ref_set_rate(OtioImageSeqRef* ref, double rate) {
-    if (!ref) return;
+// ----------------------------------------------------------------------------
+// Flattened item export
+// ----------------------------------------------------------------------------
+
+int32_t otio_timeline_flatten_items(OtioTimeline* tl, OtioFlattenedItems* out, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_rate(rate);
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto root = timeline->tracks();
+        if (!root) return 0;
+
+        // One frame per composition being walked. Track child offsets are
+        // accumulated here instead of calling range_of_child_at_index, which
+        // re-sums every preceding sibling on each call.
+        struct Frame {
+            otio::Composition* comp;
+            bool is_track;
+            size_t next;
+            int32_t entry;
+            int32_t depth;
+            std::optional<otio::RationalTime> origin;  // comp's time zero in root space
+            std::optional<otio::RationalTime> offset;  // preceding non-overlapping durations
+        };
+        std::vector<Frame> frames;
+        frames.push_back(Frame{root, false, 0, -1, 0, std::nullopt, std::nullopt});
+
+        const int32_t capacity = out ? out->capacity : 0;
+        int32_t count = 0;
+        otio::ErrorStatus status;
+
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            auto& children = frame.comp->children();
+            if (frame.next >= children.size()) {
+                frames.pop_back();
+                continue;
+            }
+            otio::Composable* child = children[frame.next++].value;
+            int32_t type = get_composable_type(child);
+
+            otio::TimeRange trimmed;
+            otio::RationalTime duration;
+            if (type == OTIO_CHILD_TYPE_TRANSITION || type < 0) {
+                duration = child->duration(&status);
+            } else {
+                trimmed = static_cast<otio::Item*>(child)->trimmed_range(&status);
+                duration = trimmed.duration();
+            }
+            if (otio::is_error(status)) {
+                set_error(err, 1, status.full_description.c_str());
+                return -1;
+            }
+
+            // Same arithmetic as Track/Stack::range_of_child_at_index
+            otio::RationalTime start(0, duration.rate());
+            if (frame.is_track) {
+                if (frame.offset) start += *frame.offset;
+                if (type == OTIO_CHILD_TYPE_TRANSITION) {
+                    start -= static_cast<otio::Transition*>(child)->in_offset();
+                }
+                if (!child->overlapping()) {
+                    frame.offset = frame.offset ? *frame.offset + duration : duration;
+                }
+            }
+            otio::RationalTime abs_start = frame.origin ? *frame.origin + start : start;
+
+            const int32_t index = count++;
+            if (index < capacity) {
+                if (out->handles) out->handles[index] = child;
+                if (out->types) out->types[index] = type;
+                if (out->depths) out->depths[index] = frame.depth;
+                if (out->parent_indices) out->parent_indices[index] = frame.entry;
+                if (out->ranges) {
+                    out->ranges[index] = OtioTimeRange{
+                        OtioRationalTime{abs_start.value(), abs_start.rate()},
+                        OtioRationalTime{duration.value(), duration.rate()}
+                    };
+                }
+            }
+
+            if (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+                // Children are expressed relative to the trimmed start of their parent
+                otio::RationalTime origin = abs_start - trimmed.start_time();
+                int32_t depth = frame.depth + 1;
+                frames.push_back(Frame{static_cast<otio::Composition*>(child),
+                    type == OTIO_CHILD_TYPE_TRACK, 0, index, depth, origin, std::nullopt});
+            }
+        }
+        return count;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-void otio_image_seq_ref_set_frame_zero_padding(OtioImageSeqRef* ref, int32_t padding) {
-    if (!ref) return;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_frame_zero_padding(padding);
-    } catch (...) {
-    }
+// ----------------------------------------------------------------------------
+// Borrowed string views
+// ----------------------------------------------------------------------------
+
+OTIO_METADATA_VIEW_IMPL(Timeline, timeline)
+OTIO_METADATA_VIEW_IMPL(Track, track)
+OTIO_METADATA_VIEW_IMPL(Clip, clip)
+OTIO_METADATA_VIEW_IMPL(Gap, gap)
+OTIO_METADATA_VIEW_IMPL(Stack, stack)
+OTIO_METADATA_VIEW_IMPL(Marker, marker)
+OTIO_METADATA_VIEW_IMPL(Effect, effect)
+OTIO_METADATA_VIEW_IMPL(Transition, transition)
+OTIO_METADATA_VIEW_IMPL(LinearTimeWarp, linear_time_warp)
+OTIO_METADATA_VIEW_IMPL(FreezeFrame, freeze_frame)
+
+// The media reference handles don't follow the Otio<Type> naming scheme
+OtioStringView otio_external_ref_get_metadata_string_view(OtioExternalRef* ref, const char* key) {
+    return get_metadata_string_view_impl(reinterpret_cast<otio::ExternalReference*>(ref), key);
 }
 
-void otio_image_seq_ref_set_missing_frame_policy(OtioImageSeqRef* ref, int32_t policy) {
-    if (!ref) return;
+OtioStringView otio_missing_ref_get_metadata_string_view(OtioMissingRef* ref, const char* key) {
+    return get_metadata_string_view_impl(reinterpret_cast<otio::MissingReference*>(ref), key);
+}
+
+OtioStringView otio_image_seq_ref_get_metadata_string_view(OtioImageSeqRef* ref, const char* key) {
+    return get_metadata_string_view_impl(reinterpret_cast<otio::ImageSequenceReference*>(ref), key);
+}
+
+OtioStringView otio_generator_ref_get_metadata_string_view(OtioGeneratorRef* ref, const char* key) {
+    return get_metadata_string_view_impl(reinterpret_cast<otio::GeneratorReference*>(ref), key);
+}
+
+OTIO_STRING_VIEW_GETTER(Timeline, timeline, name)
+OTIO_STRING_VIEW_GETTER(Track, track, name)
+OTIO_STRING_VIEW_GETTER(Clip, clip, name)
+OTIO_STRING_VIEW_GETTER(Gap, gap, name)
+OTIO_STRING_VIEW_GETTER(Stack, stack, name)
+OTIO_STRING_VIEW_GETTER(Transition, transition, name)
+OTIO_STRING_VIEW_GETTER(Marker, marker, name)
+OTIO_STRING_VIEW_GETTER(Marker, marker, color)
+OTIO_STRING_VIEW_GETTER(Marker, marker, comment)
+
+OtioStringView otio_external_ref_get_name_view(OtioExternalRef* ref) {
+    OTIO_NULL_CHECK(ref, (OtioStringView{nullptr, 0}));
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        otio::ImageSequenceReference::MissingFramePolicy p;
-        switch (policy) {
-            case OTIO_MISSING_FRAME_HOLD:
-                p = otio::ImageSequenceReference::MissingFramePolicy::hold;
-                break;
-            case OTIO_MISSING_FRAME_BLACK:
-                p = otio::ImageSequenceReference::MissingFramePolicy::black;
-                break;
-            default:
-                p = otio::ImageSequenceReference::MissingFramePolicy::error;
-                break;
-        }
-        typed->set_missing_frame_policy(p);
+        return scratch_string_view(reinterpret_cast<otio::ExternalReference*>(ref)->name());
     } catch (...) {
+        return OtioStringView{nullptr, 0};
     }
 }
 
-int32_t otio_image_seq_ref_number_of_images(OtioImageSeqRef* ref) {
-    if (!ref) return 0;
+OtioStringView otio_external_ref_get_target_url_view(OtioExternalRef* ref) {
+    OTIO_NULL_CHECK(ref, (OtioStringView{nullptr, 0}));
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        return typed->number_of_images_in_sequence();
+        return scratch_string_view(reinterpret_cast<otio::ExternalReference*>(ref)->target_url());
     } catch (...) {
-        return 0;
+        return OtioStringView{nullptr, 0};
     }
 }
 
-int32_t otio_image_seq_ref_frame_for_time(OtioImageSeqRef* ref, OtioRationalTime time, OtioError* err) {
-    if (!ref) {
-        set_error(err, 1, "ImageSequenceReference is null");
-        return 0;
+OtioStringView otio_string_iterator_next_view(OtioStringIterator* iter) {
+    if (!iter || iter->index >= iter->strings.size()) return OtioStringView{nullptr, 0};
+    const std::string& value = iter->strings[iter->index++];
+    return OtioStringView{value.data(), value.size()};
+}
+
+// ----------------------------------------------------------------------------
+// Selective (lazy) loading
+// ----------------------------------------------------------------------------
+
+struct PendingTrack {
+    int32_t index;
+    Retainer<otio::Track> shell;
+    std::string json;
+};
+
+struct OtioLazyTimeline {
+    Retainer<otio::Timeline> timeline;
+    LoadRules rules;
+    std::vector<PendingTrack> pending;
+};
+
+static OtioLazyTimeline* lazy_timeline_from_source(const std::string& source, const OtioLoadFilter* filter, OtioError* err) {
+    auto lazy = std::make_unique<OtioLazyTimeline>();
+    lazy->rules = load_rules_from_filter(filter);
+    std::vector<SkippedTrack> skipped;
+    lazy->timeline = parse_pruned<otio::Timeline>(
+        source, lazy->rules, JsonRole::Timeline, &skipped, "JSON does not contain a Timeline", err);
+    if (!lazy->timeline.value) return nullptr;
+
+    const auto& tracks = lazy->timeline.value->tracks()->children();
+    for (auto& s : skipped) {
+        auto shell = static_cast<size_t>(s.index) < tracks.size()
+            ? counted_dynamic_cast<otio::Track*>(tracks[s.index].value) : nullptr;
+        if (!shell) {
+            set_error(err, 1, "Timeline stack child is not a Track");
+            return nullptr;
+        }
+        lazy->pending.push_back(PendingTrack{s.index, Retainer<otio::Track>(shell), std::move(s.json)});
     }
+    return lazy.release();
+}
+
+OtioLazyTimeline* otio_lazy_timeline_read_from_file(const char* path, const OtioLoadFilter* filter, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(path, err, nullptr, "Path is null");
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        otio::ErrorStatus status;
-        int32_t frame = typed->frame_for_time(to_otio_rt(time), &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return 0;
-        }
-        return frame;
+        std::string source;
+        if (!read_document_file(path, source, err)) return nullptr;
+        return lazy_timeline_from_source(source, filter, err);
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return 0;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return 0;
+        return nullptr;
     }
 }
 
-char* otio_image_seq_ref_target_url_for_image_number(OtioImageSeqRef* ref, int32_t image_number, OtioError* err) {
-    if (!ref) {
-        set_error(err, 1, "ImageSequenceReference is null");
+OtioLazyTimeline* otio_lazy_timeline_from_json_buffer(const char* data, size_t len, const OtioLoadFilter* filter, OtioError* err) {
+    if (!data && len != 0) {
+        set_error(err, 1, "JSON buffer is null");
         return nullptr;
     }
     try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        otio::ErrorStatus status;
-        std::string url = typed->target_url_for_image_number(image_number, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return nullptr;
-        }
-        return safe_strdup(url);
+        return lazy_timeline_from_source(len ? std::string(data, len) : std::string(), filter, err);
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
         return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
         return nullptr;
-    }
-}
-
-int otio_image_seq_ref_set_available_range(OtioImageSeqRef* ref, OtioTimeRange range, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(ref, err, -1, "ImageSequenceReference is null");
-    OTIO_TRY_INT(err,
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        typed->set_available_range(to_otio_tr(range));
-    )
-}
-
-OtioTimeRange otio_image_seq_ref_get_available_range(OtioImageSeqRef* ref) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!ref) return zero;
-    try {
-        auto typed = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        auto range_opt = typed->available_range();
-        if (!range_opt.has_value()) return zero;
-        auto range = range_opt.value();
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (...) {
-        return zero;
-    }
-}
-
-int otio_clip_set_image_sequence_reference(OtioClip* clip, OtioImageSeqRef* ref, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto r = reinterpret_cast<otio::ImageSequenceReference*>(ref);
-        c->set_media_reference(r);
-    )
+    }
 }
 
-void otio_image_seq_ref_set_metadata_string(OtioImageSeqRef* ref, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::ImageSequenceReference*>(ref), key, value);
+void otio_lazy_timeline_free(OtioLazyTimeline* lazy) {
+    delete lazy;
 }
 
-char* otio_image_seq_ref_get_metadata_string(OtioImageSeqRef* ref, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::ImageSequenceReference*>(ref), key);
+OtioTimeline* otio_lazy_timeline_get_timeline(OtioLazyTimeline* lazy) {
+    OTIO_NULL_CHECK(lazy, nullptr);
+    return reinterpret_cast<OtioTimeline*>(lazy->timeline.value);
 }
 
-// ----------------------------------------------------------------------------
-// GeneratorReference
-// ----------------------------------------------------------------------------
+OtioTimeline* otio_lazy_timeline_take_timeline(OtioLazyTimeline* lazy) {
+    OTIO_NULL_CHECK(lazy, nullptr);
+    return reinterpret_cast<OtioTimeline*>(lazy->timeline.take_value());
+}
 
-OtioGeneratorRef* otio_generator_ref_create(const char* name, const char* generator_kind) {
-    const char* n = name ? name : "";
-    const char* gk = generator_kind ? generator_kind : "";
-    OTIO_TRY_PTR(
-        auto ref = new otio::GeneratorReference(n, gk);
-        Retainer<otio::GeneratorReference> retainer(ref);
-        return reinterpret_cast<OtioGeneratorRef*>(retainer.take_value());
-    )
+int32_t otio_lazy_timeline_pending_count(OtioLazyTimeline* lazy) {
+    OTIO_NULL_CHECK(lazy, 0);
+    return static_cast<int32_t>(lazy->pending.size());
 }
 
-void otio_generator_ref_free(OtioGeneratorRef* ref) {
-    if (ref) {
-        try {
-            auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-            Retainer<otio::GeneratorReference> retainer(typed);
-        } catch (...) {
+int32_t otio_lazy_timeline_is_track_loaded(OtioLazyTimeline* lazy, int32_t index) {
+    OTIO_NULL_CHECK(lazy, -1);
+    for (const auto& p : lazy->pending) {
+        if (p.index == index) return 0;
+    }
+    if (!lazy->timeline.value) return -1;
+    auto count = lazy->timeline.value->tracks()->children().size();
+    return index >= 0 && static_cast<size_t>(index) < count ? 1 : -1;
+}
+
+int otio_lazy_timeline_hydrate_track(OtioLazyTimeline* lazy, int32_t index, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(lazy, err, -1, "Lazy timeline is null");
+    auto it = std::find_if(lazy->pending.begin(), lazy->pending.end(),
+                           [index](const PendingTrack& p) { return p.index == index; });
+    if (it == lazy->pending.end()) {
+        if (otio_lazy_timeline_is_track_loaded(lazy, index) == 1) return 0;
+        set_error(err, 1, "Track index out of bounds");
+        return -1;
+    }
+    try {
+        auto& shell = it->shell;
+        if (!shell.value->children().empty()) {
+            set_error(err, 1, "Pending track was modified before hydration");
+            return -1;
         }
+        auto parsed = parse_pruned<otio::Track>(
+            it->json, lazy->rules, JsonRole::Other, nullptr, "Pending JSON does not contain a Track", err);
+        if (!parsed) return -1;
+
+        // Keep the children alive while they move from the parsed copy
+        std::vector<Retainer<otio::Composable>> children = parsed.value->children();
+        parsed.value->clear_children();
+        std::vector<otio::Composable*> raw;
+        raw.reserve(children.size());
+        for (const auto& child : children) raw.push_back(child.value);
+        otio::ErrorStatus status;
+        shell.value->set_children(raw, &status);
+        OTIO_CHECK_STATUS(status, err);
+        note_children_changed(shell.value, 0);
+        lazy->pending.erase(it);
+        return 0;
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-char* otio_generator_ref_get_name(OtioGeneratorRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-        return safe_strdup(typed->name());
-    )
-}
+// ----------------------------------------------------------------------------
+// Batch loading
+// ----------------------------------------------------------------------------
 
-char* otio_generator_ref_get_generator_kind(OtioGeneratorRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-        return safe_strdup(typed->generator_kind());
-    )
-}
+// Every item is loaded exactly as by the single-document functions above, so
+// item i only touches timelines[i] and errors[i].
 
-void otio_generator_ref_set_generator_kind(OtioGeneratorRef* ref, const char* kind) {
-    if (!ref || !kind) return;
-    try {
-        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-        typed->set_generator_kind(std::string(kind));
-    } catch (...) {
+static int32_t count_batch_failures(OtioTimeline** timelines, int32_t count) {
+    int32_t failures = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        if (!timelines[i]) ++failures;
     }
+    return failures;
 }
 
-int otio_generator_ref_set_available_range(OtioGeneratorRef* ref, OtioTimeRange range, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(ref, err, -1, "GeneratorReference is null");
-    OTIO_TRY_INT(err,
-        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-        typed->set_available_range(to_otio_tr(range));
-    )
-}
-
-OtioTimeRange otio_generator_ref_get_available_range(OtioGeneratorRef* ref) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!ref) return zero;
-    try {
-        auto typed = reinterpret_cast<otio::GeneratorReference*>(ref);
-        auto range_opt = typed->available_range();
-        if (!range_opt.has_value()) return zero;
-        auto range = range_opt.value();
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (...) {
-        return zero;
+static void clear_batch_error(OtioError* errors, size_t i) {
+    if (errors) {
+        errors[i].code = 0;
+        errors[i].message[0] = '\0';
     }
 }
 
-void otio_generator_ref_set_metadata_string(OtioGeneratorRef* ref, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::GeneratorReference*>(ref), key, value);
+int32_t otio_timeline_read_from_files(
+    const char* const* paths,
+    int32_t count,
+    int32_t thread_count,
+    OtioTimeline** timelines,
+    OtioError* errors
+) {
+    if (count < 0 || (count > 0 && (!paths || !timelines))) return -1;
+    parallel_for(static_cast<size_t>(count), thread_count, [&](size_t i) {
+        clear_batch_error(errors, i);
+        timelines[i] = otio_timeline_read_from_file(paths[i], errors ? &errors[i] : nullptr);
+    });
+    return count_batch_failures(timelines, count);
 }
 
-char* otio_generator_ref_get_metadata_string(OtioGeneratorRef* ref, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::GeneratorReference*>(ref), key);
+int32_t otio_timeline_from_json_buffers(
+    const char* const* buffers,
+    const size_t* lengths,
+    int32_t count,
+    int32_t thread_count,
+    OtioTimeline** timelines,
+    OtioError* errors
+) {
+    if (count < 0 || (count > 0 && (!buffers || !lengths || !timelines))) return -1;
+    parallel_for(static_cast<size_t>(count), thread_count, [&](size_t i) {
+        clear_batch_error(errors, i);
+        timelines[i] = otio_timeline_from_json_buffer(buffers[i], lengths[i], errors ? &errors[i] : nullptr);
+    });
+    return count_batch_failures(timelines, count);
 }
 
 // ----------------------------------------------------------------------------
-// LinearTimeWarp
+// Time index
 // ----------------------------------------------------------------------------
 
-OtioLinearTimeWarp* otio_linear_time_warp_create(const char* name, double time_scalar) {
-    const char* n = name ? name : "";
-    OTIO_TRY_PTR(
-        auto effect = new otio::LinearTimeWarp(n, "", time_scalar);
-        Retainer<otio::LinearTimeWarp> retainer(effect);
-        return reinterpret_cast<OtioLinearTimeWarp*>(retainer.take_value());
-    )
-}
+struct TimeIndexEntry {
+    double start;    // Seconds, for ordering and comparisons
+    double end;
+    double max_end;  // Largest end of this and every earlier entry
+    OtioTimeIndexHit hit;
+};
 
-void otio_linear_time_warp_free(OtioLinearTimeWarp* effect) {
-    if (effect) {
-        try {
-            auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
-            Retainer<otio::LinearTimeWarp> retainer(typed);
-        } catch (...) {
+struct OtioTimeIndex : MutationListener {
+    // Borrowed: the caller keeps it alive for the life of the index. A
+    // Retainer here would delete a standalone composition its owner still holds.
+    otio::Composition* target;
+    bool per_track;  // Index the children of target's children (timeline index)
+    std::atomic<bool> stale{true};
+    std::vector<TimeIndexEntry> entries;  // Sorted by start
+
+    OtioTimeIndex(otio::Composition* comp, bool per_track)
+        : target(comp), per_track(per_track) {
+        add_mutation_listener(comp, this);
+    }
+    ~OtioTimeIndex() override { remove_mutation_listener(target, this); }
+
+    void on_mutation(size_t) override { stale = true; }
+};
+
+// Append an entry for every child of comp, offset by origin when given.
+static bool append_time_index_entries(std::vector<TimeIndexEntry>& entries, otio::Composition* comp,
+    const std::optional<otio::RationalTime>& origin, int32_t track_index, otio::ErrorStatus* status) {
+    ChildRangeCursor cursor(comp);
+    auto& children = comp->children();
+    for (size_t i = 0; i < children.size(); ++i) {
+        otio::Composable* child = children[i].value;
+        otio::TimeRange local;
+        if (!cursor.next(child, local, status)) return false;
+        otio::RationalTime start = origin ? *origin + local.start_time() : local.start_time();
+        otio::RationalTime duration = local.duration();
+
+        TimeIndexEntry entry;
+        entry.start = start.to_seconds();
+        entry.end = (start + duration).to_seconds();
+        entry.max_end = entry.end;
+        entry.hit = OtioTimeIndexHit{child, get_composable_type(child), track_index,
+            static_cast<int32_t>(i), OtioTimeRange{
+                OtioRationalTime{start.value(), start.rate()},
+                OtioRationalTime{duration.value(), duration.rate()}}};
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+static bool rebuild_time_index(OtioTimeIndex* index, OtioError* err) {
+    // Edits from here on mark the index stale again
+    index->stale = false;
+    std::vector<TimeIndexEntry> entries;
+    otio::ErrorStatus status;
+    bool ok = append_time_index_entries(entries, index->target, std::nullopt, -1, &status);
+    if (ok && index->per_track) {
+        std::vector<TimeIndexEntry> roots;
+        roots.swap(entries);
+        for (const auto& root : roots) {
+            auto comp = counted_dynamic_cast<otio::Composition*>(static_cast<otio::Composable*>(root.hit.handle));
+            if (!comp) {
+                entries.push_back(root);
+                continue;
+            }
+            // Children are expressed relative to the trimmed start of their parent
+            otio::TimeRange trimmed = comp->trimmed_range(&status);
+            if (otio::is_error(status)) {
+                ok = false;
+                break;
+            }
+            otio::RationalTime origin = to_otio_rt(root.hit.range.start_time) - trimmed.start_time();
+            ok = append_time_index_entries(entries, comp, origin, root.hit.child_index, &status);
+            if (!ok) break;
         }
     }
-}
+    if (!ok) {
+        index->stale = true;
+        set_error(err, 1, status.full_description.c_str());
+        return false;
+    }
 
-char* otio_linear_time_warp_get_name(OtioLinearTimeWarp* effect) {
-    OTIO_NULL_CHECK(effect, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
-        return safe_strdup(typed->name());
-    )
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const TimeIndexEntry& a, const TimeIndexEntry& b) { return a.start < b.start; });
+    for (size_t i = 1; i < entries.size(); ++i) {
+        entries[i].max_end = std::max(entries[i].end, entries[i - 1].max_end);
+    }
+    index->entries.swap(entries);
+    return true;
 }
 
-double otio_linear_time_warp_get_time_scalar(OtioLinearTimeWarp* effect) {
-    if (!effect) return 1.0;
+static OtioTimeIndex* build_time_index(otio::Composition* comp, bool per_track, OtioError* err) {
     try {
-        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
-        return typed->time_scalar();
+        std::unique_ptr<OtioTimeIndex> index(new OtioTimeIndex(comp, per_track));
+        if (!rebuild_time_index(index.get(), err)) return nullptr;
+        return index.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
-        return 1.0;
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
     }
 }
 
-void otio_linear_time_warp_set_time_scalar(OtioLinearTimeWarp* effect, double scalar) {
-    if (!effect) return;
+// Collect entries with end > lo and start < hi; when hi == lo, start <= lo.
+static int32_t time_index_collect(OtioTimeIndex* index, double lo, double hi,
+    OtioTimeIndexHit* hits, int32_t capacity, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(index, err, -1, "Time index is null");
     try {
-        auto typed = reinterpret_cast<otio::LinearTimeWarp*>(effect);
-        typed->set_time_scalar(scalar);
+        if (index->stale && !rebuild_time_index(index, err)) return -1;
+        const auto& entries = index->entries;
+        const bool point = !(hi > lo);
+        auto past = std::partition_point(entries.begin(), entries.end(),
+            [&](const TimeIndexEntry& e) { return point ? e.start <= lo : e.start < hi; });
+
+        // Everything before `past` starts early enough; walk back until no
+        // earlier entry can still reach lo.
+        std::vector<const TimeIndexEntry*> found;
+        for (auto it = past; it != entries.begin();) {
+            --it;
+            if (!(it->max_end > lo)) break;
+            if (it->end > lo) found.push_back(&*it);
+        }
+
+        const size_t limit = hits && capacity > 0 ? static_cast<size_t>(capacity) : 0;
+        size_t written = 0;
+        for (auto it = found.rbegin(); it != found.rend() && written < limit; ++it) {
+            hits[written++] = (*it)->hit;
+        }
+        return static_cast<int32_t>(found.size());
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-void otio_linear_time_warp_set_metadata_string(OtioLinearTimeWarp* effect, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::LinearTimeWarp*>(effect), key, value);
-}
-
-char* otio_linear_time_warp_get_metadata_string(OtioLinearTimeWarp* effect, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::LinearTimeWarp*>(effect), key);
+OtioTimeIndex* otio_track_build_time_index(OtioTrack* track, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    return build_time_index(reinterpret_cast<otio::Track*>(track), false, err);
 }
 
-// ----------------------------------------------------------------------------
-// FreezeFrame
-// ----------------------------------------------------------------------------
-
-OtioFreezeFrame* otio_freeze_frame_create(const char* name) {
-    const char* n = name ? name : "";
-    OTIO_TRY_PTR(
-        auto effect = new otio::FreezeFrame(n);
-        Retainer<otio::FreezeFrame> retainer(effect);
-        return reinterpret_cast<OtioFreezeFrame*>(retainer.take_value());
-    )
+OtioTimeIndex* otio_stack_build_time_index(OtioStack* stack, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    return build_time_index(reinterpret_cast<otio::Stack*>(stack), false, err);
 }
 
-void otio_freeze_frame_free(OtioFreezeFrame* effect) {
-    if (effect) {
-        try {
-            auto typed = reinterpret_cast<otio::FreezeFrame*>(effect);
-            Retainer<otio::FreezeFrame> retainer(typed);
-        } catch (...) {
-        }
-    }
+OtioTimeIndex* otio_timeline_build_time_index(OtioTimeline* tl, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    auto root = reinterpret_cast<otio::Timeline*>(tl)->tracks();
+    OTIO_NULL_CHECK_ERR(root, err, nullptr, "Timeline has no tracks");
+    return build_time_index(root, true, err);
 }
 
-char* otio_freeze_frame_get_name(OtioFreezeFrame* effect) {
-    OTIO_NULL_CHECK(effect, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::FreezeFrame*>(effect);
-        return safe_strdup(typed->name());
-    )
+void otio_time_index_free(OtioTimeIndex* index) {
+    delete index;
 }
 
-void otio_freeze_frame_set_metadata_string(OtioFreezeFrame* effect, const char* key, const char* value) {
-    set_metadata_string_impl(reinterpret_cast<otio::FreezeFrame*>(effect), key, value);
+int32_t otio_time_index_query(OtioTimeIndex* index, OtioRationalTime time,
+    OtioTimeIndexHit* hits, int32_t capacity, OtioError* err) {
+    double t = to_otio_rt(time).to_seconds();
+    return time_index_collect(index, t, t, hits, capacity, err);
 }
 
-char* otio_freeze_frame_get_metadata_string(OtioFreezeFrame* effect, const char* key) {
-    return get_metadata_string_impl(reinterpret_cast<otio::FreezeFrame*>(effect), key);
+int32_t otio_time_index_query_range(OtioTimeIndex* index, OtioTimeRange range,
+    OtioTimeIndexHit* hits, int32_t capacity, OtioError* err) {
+    auto tr = to_otio_tr(range);
+    return time_index_collect(index, tr.start_time().to_seconds(),
+        tr.end_time_exclusive().to_seconds(), hits, capacity, err);
 }
 
 // ----------------------------------------------------------------------------
-// Clip Marker/Effect attachment
+// Search cursors
 // ----------------------------------------------------------------------------
 
-int otio_clip_add_marker(OtioClip* clip, OtioMarker* marker, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto m = reinterpret_cast<otio::Marker*>(marker);
-        c->markers().push_back(m);
-    )
-}
+struct SearchFrame {
+    otio::Composition* comp;
+    size_t next;
+    ChildRangeCursor ranges;
+    otio::RationalTime origin;  // comp's local time zero in root coordinates
+    int32_t track_kind;         // Kind of the nearest enclosing track, -1 if none
+};
 
-int32_t otio_clip_markers_count(OtioClip* clip) {
-    if (!clip) return 0;
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        return static_cast<int32_t>(c->markers().size());
-    } catch (...) {
-        return 0;
+struct OtioSearchCursor : MutationListener {
+    otio::Composition* root;  // Borrowed: outlives the cursor
+    int32_t child_types = 0;
+    bool has_range = false;
+    double range_lo = 0;  // Seconds
+    double range_hi = 0;
+    int32_t track_kinds = 0;
+    std::optional<std::string> metadata_key;
+    std::optional<std::string> metadata_value;
+    std::optional<std::string> name_prefix;
+    std::optional<std::string> target_url;
+    bool shallow = false;
+
+    std::vector<SearchFrame> frames;
+    std::atomic<bool> stale{false};
+
+    explicit OtioSearchCursor(otio::Composition* comp) : root(comp) {
+        add_mutation_listener(comp, this);
     }
+    ~OtioSearchCursor() override { remove_mutation_listener(root, this); }
+
+    void on_mutation(size_t) override { stale = true; }
+};
+
+static int32_t search_track_kind(const otio::Track* track) {
+    const std::string& kind = track->kind();
+    if (kind == otio::Track::Kind::video) return OTIO_TRACK_KIND_VIDEO;
+    if (kind == otio::Track::Kind::audio) return OTIO_TRACK_KIND_AUDIO;
+    return -1;
 }
 
-OtioMarker* otio_clip_marker_at(OtioClip* clip, int32_t index) {
-    if (!clip) return nullptr;
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto& markers = c->markers();
-        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
-        return reinterpret_cast<OtioMarker*>(markers[index].value);
-    } catch (...) {
-        return nullptr;
-    }
+static void search_reset(OtioSearchCursor* cursor) {
+    otio::Composition* root = cursor->root;
+    int32_t kind = object_type_of(root) == OTIO_CHILD_TYPE_TRACK
+        ? search_track_kind(static_cast<otio::Track*>(root)) : -1;
+    cursor->frames.clear();
+    cursor->frames.push_back(SearchFrame{root, 0, ChildRangeCursor(root), otio::RationalTime(), kind});
+    cursor->stale = false;
 }
 
-int otio_clip_add_effect(OtioClip* clip, OtioEffect* effect, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(effect, err, -1, "Effect is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto e = reinterpret_cast<otio::Effect*>(effect);
-        c->effects().push_back(e);
-    )
+// Cheapest predicates first; the range is checked by the walk itself
+static bool search_matches(const OtioSearchCursor* cursor, otio::Composable* child, int32_t type,
+    int32_t track_kind) {
+    if (cursor->child_types != 0 && (type < 0 || (cursor->child_types & (1 << type)) == 0)) {
+        return false;
+    }
+    if (cursor->track_kinds != 0 && (track_kind < 0 || (cursor->track_kinds & (1 << track_kind)) == 0)) {
+        return false;
+    }
+    if (cursor->name_prefix) {
+        const std::string& name = child->name();
+        if (name.compare(0, cursor->name_prefix->size(), *cursor->name_prefix) != 0) return false;
+    }
+    if (cursor->target_url) {
+        if (type != OTIO_CHILD_TYPE_CLIP) return false;
+        otio::MediaReference* ref = static_cast<otio::Clip*>(child)->media_reference();
+        if (object_type_of(ref) != OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE ||
+            static_cast<otio::ExternalReference*>(ref)->target_url() != *cursor->target_url) {
+            return false;
+        }
+    }
+    if (cursor->metadata_key) {
+        auto& meta = child->metadata();
+        auto it = meta.find(*cursor->metadata_key);
+        if (it == meta.end()) return false;
+        if (cursor->metadata_value && (it->second.type() != typeid(std::string) ||
+            std::any_cast<const std::string&>(it->second) != *cursor->metadata_value)) {
+            return false;
+        }
+    }
+    return true;
 }
 
-int32_t otio_clip_effects_count(OtioClip* clip) {
-    if (!clip) return 0;
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        return static_cast<int32_t>(c->effects().size());
-    } catch (...) {
-        return 0;
+static void* search_next(OtioSearchCursor* cursor, int32_t* child_type, otio::ErrorStatus* status) {
+    auto& frames = cursor->frames;
+    while (!frames.empty()) {
+        SearchFrame& frame = frames.back();
+        auto& children = frame.comp->children();
+        if (frame.next >= children.size()) {
+            frames.pop_back();
+            continue;
+        }
+        otio::Composable* child = children[frame.next++].value;
+        int32_t type = object_type_of(child);
+
+        // Same overlap rule as the time index: half-open ranges, and a
+        // zero-length search range behaves like a point
+        otio::RationalTime start;
+        if (cursor->has_range) {
+            otio::TimeRange local;
+            if (!frame.ranges.next(child, local, status)) return nullptr;
+            start = frame.origin + local.start_time();
+            double lo = start.to_seconds();
+            double hi = (start + local.duration()).to_seconds();
+            bool point = !(cursor->range_hi > cursor->range_lo);
+            bool overlaps = hi > cursor->range_lo &&
+                (point ? lo <= cursor->range_lo : lo < cursor->range_hi);
+            if (!overlaps) continue;
+        }
+
+        int32_t track_kind = type == OTIO_CHILD_TYPE_TRACK
+            ? search_track_kind(static_cast<otio::Track*>(child)) : frame.track_kind;
+        bool matched = search_matches(cursor, child, type, track_kind);
+
+        otio::Composition* nested = nullptr;
+        if (!cursor->shallow) {
+            if (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+                nested = static_cast<otio::Composition*>(child);
+            } else if (type < 0) {
+                nested = counted_dynamic_cast<otio::Composition*>(child);
+            }
+        }
+        if (nested) {
+            otio::RationalTime origin;
+            if (cursor->has_range) {
+                // Children are expressed relative to the trimmed start of their parent
+                otio::TimeRange trimmed = nested->trimmed_range(status);
+                if (otio::is_error(*status)) return nullptr;
+                origin = start - trimmed.start_time();
+            }
+            // frame is invalidated from here on
+            frames.push_back(SearchFrame{nested, 0, ChildRangeCursor(nested), origin, track_kind});
+        }
+        if (matched) {
+            if (child_type) *child_type = type;
+            return child;
+        }
     }
+    return nullptr;
 }
 
-OtioEffect* otio_clip_effect_at(OtioClip* clip, int32_t index) {
-    if (!clip) return nullptr;
+static OtioSearchCursor* open_search(otio::Composition* comp, const OtioSearchFilter* filter, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
     try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto& effects = c->effects();
-        if (index < 0 || static_cast<size_t>(index) >= effects.size()) return nullptr;
-        return reinterpret_cast<OtioEffect*>(effects[index].value);
+        std::unique_ptr<OtioSearchCursor> cursor(new OtioSearchCursor(comp));
+        if (filter) {
+            cursor->child_types = filter->child_types;
+            cursor->track_kinds = filter->track_kinds;
+            cursor->shallow = filter->shallow != 0;
+            if (filter->has_search_range) {
+                otio::TimeRange range = to_otio_tr(filter->search_range);
+                cursor->has_range = true;
+                cursor->range_lo = range.start_time().to_seconds();
+                cursor->range_hi = range.end_time_exclusive().to_seconds();
+            }
+            if (filter->metadata_key) cursor->metadata_key = filter->metadata_key;
+            if (filter->metadata_value) {
+                if (!filter->metadata_key) {
+                    set_error(err, 1, "metadata_value requires metadata_key");
+                    return nullptr;
+                }
+                cursor->metadata_value = filter->metadata_value;
+            }
+            if (filter->name_prefix) cursor->name_prefix = filter->name_prefix;
+            if (filter->target_url) cursor->target_url = filter->target_url;
+        }
+        search_reset(cursor.get());
+        return cursor.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
         return nullptr;
     }
 }
 
-int otio_clip_add_linear_time_warp(OtioClip* clip, OtioLinearTimeWarp* effect, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_NULL_CHECK_ERR(effect, err, -1, "LinearTimeWarp is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto e = reinterpret_cast<otio::LinearTimeWarp*>(effect);
-        c->effects().push_back(e);
-    )
+OtioSearchCursor* otio_track_search(OtioTrack* track, const OtioSearchFilter* filter, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    return open_search(reinterpret_cast<otio::Track*>(track), filter, err);
 }
 
-int otio_clip_set_missing_reference(OtioClip* clip, OtioMissingRef* ref, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto r = reinterpret_cast<otio::MissingReference*>(ref);
-        c->set_media_reference(r);
-    )
+OtioSearchCursor* otio_stack_search(OtioStack* stack, const OtioSearchFilter* filter, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    return open_search(reinterpret_cast<otio::Stack*>(stack), filter, err);
 }
 
-int otio_clip_set_generator_reference(OtioClip* clip, OtioGeneratorRef* ref, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    OTIO_TRY_INT(err,
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        auto r = reinterpret_cast<otio::GeneratorReference*>(ref);
-        c->set_media_reference(r);
-    )
+OtioSearchCursor* otio_timeline_search(OtioTimeline* tl, const OtioSearchFilter* filter, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    return open_search(reinterpret_cast<otio::Timeline*>(tl)->tracks(), filter, err);
 }
 
-// ----------------------------------------------------------------------------
-// Track Marker attachment
-// ----------------------------------------------------------------------------
-
-int otio_track_add_marker(OtioTrack* track, OtioMarker* marker, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
-    OTIO_NULL_CHECK_ERR(marker, err, -1, "Marker is null");
-    OTIO_TRY_INT(err,
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto m = reinterpret_cast<otio::Marker*>(marker);
-        t->markers().push_back(m);
-    )
+void otio_search_cursor_free(OtioSearchCursor* cursor) {
+    delete cursor;
 }
 
-int32_t otio_track_markers_count(OtioTrack* track) {
-    if (!track) return 0;
+void* otio_search_cursor_next(OtioSearchCursor* cursor, int32_t* child_type, OtioError* err) {
+    OTIO_STATS_SCOPE(OTIO_STAT_ITERATE);
+    OTIO_NULL_CHECK_ERR(cursor, err, nullptr, "Search cursor is null");
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        return static_cast<int32_t>(t->markers().size());
+        if (cursor->stale && !cursor->frames.empty()) {
+            cursor->frames.clear();
+            set_error(err, 1, "Composition was edited during the search");
+            return nullptr;
+        }
+        otio::ErrorStatus status;
+        void* item = search_next(cursor, child_type, &status);
+        if (otio::is_error(status)) {
+            cursor->frames.clear();
+            set_error(err, 1, status.full_description.c_str());
+            return nullptr;
+        }
+        return item;
+    } catch (const std::exception& e) {
+        cursor->frames.clear();
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
-        return 0;
+        cursor->frames.clear();
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
     }
 }
 
-OtioMarker* otio_track_marker_at(OtioTrack* track, int32_t index) {
-    if (!track) return nullptr;
+void otio_search_cursor_reset(OtioSearchCursor* cursor) {
+    if (!cursor) return;
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto& markers = t->markers();
-        if (index < 0 || static_cast<size_t>(index) >= markers.size()) return nullptr;
-        return reinterpret_cast<OtioMarker*>(markers[index].value);
+        search_reset(cursor);
     } catch (...) {
-        return nullptr;
+        cursor->frames.clear();
     }
 }
 
 // ----------------------------------------------------------------------------
-// Track kind
+// Asset index
 // ----------------------------------------------------------------------------
 
-int32_t otio_track_get_kind(OtioTrack* track) {
-    if (!track) return OTIO_TRACK_KIND_VIDEO;
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto kind = t->kind();
-        if (kind == otio::Track::Kind::audio) return OTIO_TRACK_KIND_AUDIO;
-        return OTIO_TRACK_KIND_VIDEO;
-    } catch (...) {
-        return OTIO_TRACK_KIND_VIDEO;
+using AssetPostings = std::unordered_map<std::string, std::vector<otio::Composable*>>;
+
+// What an item is currently filed under, so it can be removed again
+struct AssetIndexItem {
+    std::vector<std::string> urls;
+    std::vector<std::optional<std::string>> values;  // One per indexed key
+};
+
+struct OtioAssetIndex : MutationListener {
+    otio::Composition* root;  // Borrowed: the timeline outlives the index
+    std::vector<std::string> keys;
+
+    // Notifications arrive on whichever thread edits the timeline
+    std::mutex mutex;
+    bool stale = true;
+    AssetPostings by_url;
+    std::vector<AssetPostings> by_key;  // Parallel to keys
+    std::unordered_map<otio::Composable*, AssetIndexItem> items;
+
+    OtioAssetIndex(otio::Composition* comp, std::vector<std::string> indexed_keys)
+        : root(comp), keys(std::move(indexed_keys)), by_key(keys.size()) {
+        add_mutation_listener(comp, this);
     }
-}
+    ~OtioAssetIndex() override { remove_mutation_listener(root, this); }
 
-void otio_track_set_kind(OtioTrack* track, int32_t kind) {
-    if (!track) return;
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        if (kind == OTIO_TRACK_KIND_AUDIO) {
-            t->set_kind(otio::Track::Kind::audio);
-        } else {
-            t->set_kind(otio::Track::Kind::video);
-        }
-    } catch (...) {
+    // Retiming leaves the index valid; only a changed set of items doesn't
+    void on_mutation(size_t) override {}
+
+    void on_structure_changed() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        stale = true;
     }
-}
 
-// ----------------------------------------------------------------------------
-// Time transforms
-// ----------------------------------------------------------------------------
+    void on_attributes_changed(otio::Composable* item, const std::string* metadata_key) override;
+};
 
-OtioTimeRange otio_track_range_of_child_at_index(OtioTrack* track, int32_t index, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!track) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Track is null", sizeof(err->message) - 1);
+static void asset_postings_remove(AssetPostings& postings, const std::string& value, otio::Composable* item) {
+    auto it = postings.find(value);
+    if (it == postings.end()) return;
+    auto& list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), item), list.end());
+    if (list.empty()) postings.erase(it);
+}
+
+// File item under its current URLs and metadata values, replacing any
+// previous entry for it. Caller holds index->mutex.
+static void asset_index_item(OtioAssetIndex* index, otio::Composable* item) {
+    auto old = index->items.find(item);
+    if (old != index->items.end()) {
+        for (const auto& url : old->second.urls) asset_postings_remove(index->by_url, url, item);
+        for (size_t k = 0; k < index->keys.size(); ++k) {
+            if (old->second.values[k]) asset_postings_remove(index->by_key[k], *old->second.values[k], item);
         }
-        return zero;
+        index->items.erase(old);
     }
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto& children = t->children();
-        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
-            if (err) {
-                err->code = -1;
-                strncpy(err->message, "Index out of bounds", sizeof(err->message) - 1);
-            }
-            return zero;
-        }
-        otio::ErrorStatus status;
-        auto range = t->range_of_child_at_index(index, &status);
-        if (otio::is_error(status)) {
-            if (err) {
-                err->code = static_cast<int>(status.outcome);
-                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
-            }
-            return zero;
+
+    AssetIndexItem entry;
+    bool any = false;
+    if (object_type_of(item) == OTIO_CHILD_TYPE_CLIP) {
+        for (const auto& ref : static_cast<otio::Clip*>(item)->media_references()) {
+            if (object_type_of(ref.second) != OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE) continue;
+            const std::string& url = static_cast<otio::ExternalReference*>(ref.second)->target_url();
+            if (std::find(entry.urls.begin(), entry.urls.end(), url) != entry.urls.end()) continue;
+            entry.urls.push_back(url);
+            index->by_url[url].push_back(item);
+            any = true;
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+    }
+    entry.values.resize(index->keys.size());
+    auto& meta = item->metadata();
+    for (size_t k = 0; k < index->keys.size(); ++k) {
+        auto it = meta.find(index->keys[k]);
+        if (it == meta.end() || it->second.type() != typeid(std::string)) continue;
+        const std::string& value = std::any_cast<const std::string&>(it->second);
+        entry.values[k] = value;
+        index->by_key[k][value].push_back(item);
+        any = true;
+    }
+    if (any) index->items.emplace(item, std::move(entry));
+}
+
+void OtioAssetIndex::on_attributes_changed(otio::Composable* item, const std::string* metadata_key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // A stale index is rebuilt in full anyway; the root itself is not indexed
+    if (stale || item == root) return;
+    if (metadata_key && std::find(keys.begin(), keys.end(), *metadata_key) == keys.end()) return;
+    asset_index_item(this, item);
+}
+
+// Caller holds index->mutex
+static void rebuild_asset_index(OtioAssetIndex* index) {
+    index->by_url.clear();
+    for (auto& postings : index->by_key) postings.clear();
+    index->items.clear();
+
+    // Depth-first, parents before children, so items are filed in document order
+    struct Frame {
+        otio::Composition* comp;
+        size_t next;
+    };
+    std::vector<Frame> frames{{index->root, 0}};
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        auto& children = frame.comp->children();
+        if (frame.next >= children.size()) {
+            frames.pop_back();
+            continue;
         }
-        return zero;
-    } catch (...) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        otio::Composable* child = children[frame.next++].value;
+        asset_index_item(index, child);
+        int32_t type = object_type_of(child);
+        otio::Composition* nested = nullptr;
+        if (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+            nested = static_cast<otio::Composition*>(child);
+        } else if (type < 0) {
+            nested = counted_dynamic_cast<otio::Composition*>(child);
         }
-        return zero;
+        // frame is invalidated from here on
+        if (nested) frames.push_back(Frame{nested, 0});
     }
+    index->stale = false;
 }
 
-OtioTimeRange otio_stack_range_of_child_at_index(OtioStack* stack, int32_t index, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!stack) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Stack is null", sizeof(err->message) - 1);
-        }
-        return zero;
+static int32_t asset_index_lookup(const AssetPostings& postings, const std::string& value,
+    OtioIndexedItem* items, int32_t capacity) {
+    auto it = postings.find(value);
+    if (it == postings.end()) return 0;
+    const auto& list = it->second;
+    size_t written = items ? std::min(list.size(), static_cast<size_t>(std::max(capacity, 0))) : 0;
+    for (size_t i = 0; i < written; ++i) {
+        items[i] = OtioIndexedItem{list[i], object_type_of(list[i])};
+    }
+    return static_cast<int32_t>(list.size());
+}
+
+OtioAssetIndex* otio_timeline_build_asset_index(OtioTimeline* tl, const char* const* metadata_keys,
+    int32_t key_count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    if (key_count < 0 || (key_count > 0 && !metadata_keys)) {
+        set_error(err, 1, "Invalid metadata key array");
+        return nullptr;
     }
     try {
-        auto s = reinterpret_cast<otio::Stack*>(stack);
-        auto& children = s->children();
-        if (index < 0 || static_cast<size_t>(index) >= children.size()) {
-            if (err) {
-                err->code = -1;
-                strncpy(err->message, "Index out of bounds", sizeof(err->message) - 1);
+        std::vector<std::string> keys;
+        for (int32_t i = 0; i < key_count; ++i) {
+            if (!metadata_keys[i]) {
+                set_error(err, 1, "Metadata key is null");
+                return nullptr;
             }
-            return zero;
-        }
-        otio::ErrorStatus status;
-        auto range = s->range_of_child_at_index(index, &status);
-        if (otio::is_error(status)) {
-            if (err) {
-                err->code = static_cast<int>(status.outcome);
-                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+            if (std::find(keys.begin(), keys.end(), metadata_keys[i]) == keys.end()) {
+                keys.emplace_back(metadata_keys[i]);
             }
-            return zero;
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+        auto comp = reinterpret_cast<otio::Timeline*>(tl)->tracks();
+        std::unique_ptr<OtioAssetIndex> index(new OtioAssetIndex(comp, std::move(keys)));
+        {
+            std::lock_guard<std::mutex> lock(index->mutex);
+            rebuild_asset_index(index.get());
         }
-        return zero;
+        return index.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
-        }
-        return zero;
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
     }
 }
 
-OtioTimeRange otio_track_trimmed_range(OtioTrack* track, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!track) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Track is null", sizeof(err->message) - 1);
-        }
-        return zero;
+void otio_asset_index_free(OtioAssetIndex* index) {
+    delete index;
+}
+
+int32_t otio_asset_index_find_url(OtioAssetIndex* index, const char* url,
+    OtioIndexedItem* items, int32_t capacity, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(index, err, -1, "Asset index is null");
+    OTIO_NULL_CHECK_ERR(url, err, -1, "URL is null");
+    try {
+        std::lock_guard<std::mutex> lock(index->mutex);
+        if (index->stale) rebuild_asset_index(index);
+        return asset_index_lookup(index->by_url, url, items, capacity);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
+}
+
+int32_t otio_asset_index_find_metadata(OtioAssetIndex* index, const char* key, const char* value,
+    OtioIndexedItem* items, int32_t capacity, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(index, err, -1, "Asset index is null");
+    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+    OTIO_NULL_CHECK_ERR(value, err, -1, "Value is null");
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        otio::ErrorStatus status;
-        auto range = t->trimmed_range(&status);
-        if (otio::is_error(status)) {
-            if (err) {
-                err->code = static_cast<int>(status.outcome);
-                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
-            }
-            return zero;
+        auto k = std::find(index->keys.begin(), index->keys.end(), key);
+        if (k == index->keys.end()) {
+            set_error(err, 1, "Metadata key is not indexed");
+            return -1;
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
+        std::lock_guard<std::mutex> lock(index->mutex);
+        if (index->stale) rebuild_asset_index(index);
+        return asset_index_lookup(index->by_key[static_cast<size_t>(k - index->keys.begin())],
+            value, items, capacity);
     } catch (const std::exception& e) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, e.what(), sizeof(err->message) - 1);
-        }
-        return zero;
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        set_error(err, 1, "Unknown exception");
+        return -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Typed metadata
+// ----------------------------------------------------------------------------
+
+static otio::SerializableObjectWithMetadata* metadata_owner(void* obj) {
+    auto so = static_cast<otio::SerializableObject*>(obj);
+    if (!so) return nullptr;
+    // Every tagged schema carries metadata
+    if (object_type_of(so) >= 0) return static_cast<otio::SerializableObjectWithMetadata*>(so);
+    return counted_dynamic_cast<otio::SerializableObjectWithMetadata*>(so);
+}
+
+static const std::any* find_metadata_value(void* obj, const char* key) {
+    auto owner = metadata_owner(obj);
+    if (!owner || !key) return nullptr;
+    auto& meta = owner->metadata();
+    auto it = meta.find(std::string(key));
+    return it == meta.end() ? nullptr : &it->second;
+}
+
+static bool metadata_int_of(const std::any& value, int64_t* out) {
+    const auto& type = value.type();
+    if (type == typeid(int64_t)) {
+        *out = std::any_cast<int64_t>(value);
+    } else if (type == typeid(int)) {
+        *out = std::any_cast<int>(value);
+    } else if (type == typeid(uint64_t)) {
+        uint64_t u = std::any_cast<uint64_t>(value);
+        if (u > static_cast<uint64_t>(INT64_MAX)) return false;
+        *out = static_cast<int64_t>(u);
+    } else if (type == typeid(unsigned int)) {
+        *out = std::any_cast<unsigned int>(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool metadata_double_of(const std::any& value, double* out) {
+    if (value.type() == typeid(double)) {
+        *out = std::any_cast<double>(value);
+    } else if (value.type() == typeid(float)) {
+        *out = std::any_cast<float>(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static int32_t metadata_kind_of(const std::any& value) {
+    const auto& type = value.type();
+    int64_t i;
+    double d;
+    if (!value.has_value() || type == typeid(std::nullptr_t)) return OTIO_METADATA_NULL;
+    if (type == typeid(bool)) return OTIO_METADATA_BOOL;
+    if (metadata_int_of(value, &i)) return OTIO_METADATA_INT;
+    if (metadata_double_of(value, &d)) return OTIO_METADATA_DOUBLE;
+    if (type == typeid(std::string)) return OTIO_METADATA_STRING;
+    if (type == typeid(otio::AnyDictionary)) return OTIO_METADATA_DICT;
+    if (type == typeid(otio::AnyVector)) return OTIO_METADATA_ARRAY;
+    return OTIO_METADATA_OTHER;
+}
+
+// Store value under key and tell listeners when obj is part of a tree.
+static int32_t store_metadata_value(void* obj, const char* key, std::any value, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+    auto owner = metadata_owner(obj);
+    if (!owner) {
+        set_error(err, 1, "Object has no metadata");
+        return -1;
+    }
+    std::string k(key);
+    const bool journaled = journal_wanted(owner);
+    std::optional<std::any> previous;
+    if (journaled) previous = metadata_value_of(owner->metadata(), k);
+    owner->metadata()[k] = std::move(value);
+    int32_t type = object_type_of(owner);
+    if (type >= 0 && type < OTIO_OBJECT_TYPE_TIMELINE) {
+        note_metadata_changed(static_cast<otio::Composable*>(owner), k);
+    } else if (type == OTIO_OBJECT_TYPE_TIMELINE) {
+        note_timeline_changed(static_cast<otio::Timeline*>(owner));
+    }
+    if (journaled) journal_metadata_change(owner, k, std::move(previous));
+    return 0;
+}
+
+static void put_u32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+static void put_u64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+static void put_bytes(std::string& out, const std::string& bytes) {
+    if (bytes.size() > UINT32_MAX) throw std::length_error("Metadata string is too long to encode");
+    put_u32(out, static_cast<uint32_t>(bytes.size()));
+    out.append(bytes);
+}
+
+static std::string metadata_other_name(const std::any& value) {
+    const auto& type = value.type();
+    if (type == typeid(otio::RationalTime)) return "RationalTime";
+    if (type == typeid(otio::TimeRange)) return "TimeRange";
+    if (type == typeid(otio::TimeTransform)) return "TimeTransform";
+    if (type == typeid(otio::SerializableObject::Retainer<>)) {
+        auto& so = std::any_cast<const otio::SerializableObject::Retainer<>&>(value);
+        if (so) return so.value->schema_name();
+    }
+    return "unknown";
+}
+
+static void encode_metadata_dict(std::string& out, const otio::AnyDictionary& dict);
+
+static void encode_metadata_value(std::string& out, const std::any& value) {
+    int32_t kind = metadata_kind_of(value);
+    out.push_back(static_cast<char>(kind));
+    switch (kind) {
+        case OTIO_METADATA_BOOL:
+            out.push_back(std::any_cast<bool>(value) ? 1 : 0);
+            break;
+        case OTIO_METADATA_INT: {
+            int64_t i = 0;
+            metadata_int_of(value, &i);
+            put_u64(out, static_cast<uint64_t>(i));
+            break;
         }
-        return zero;
+        case OTIO_METADATA_DOUBLE: {
+            double d = 0;
+            metadata_double_of(value, &d);
+            uint64_t bits;
+            std::memcpy(&bits, &d, sizeof bits);
+            put_u64(out, bits);
+            break;
+        }
+        case OTIO_METADATA_STRING:
+            put_bytes(out, std::any_cast<const std::string&>(value));
+            break;
+        case OTIO_METADATA_DICT:
+            // The dictionary's own tag was written above
+            out.pop_back();
+            encode_metadata_dict(out, std::any_cast<const otio::AnyDictionary&>(value));
+            break;
+        case OTIO_METADATA_ARRAY: {
+            auto& array = std::any_cast<const otio::AnyVector&>(value);
+            put_u32(out, static_cast<uint32_t>(array.size()));
+            for (const auto& element : array) encode_metadata_value(out, element);
+            break;
+        }
+        case OTIO_METADATA_OTHER:
+            put_bytes(out, metadata_other_name(value));
+            break;
+        default:
+            break;
+    }
+}
+
+static void encode_metadata_dict(std::string& out, const otio::AnyDictionary& dict) {
+    out.push_back(static_cast<char>(OTIO_METADATA_DICT));
+    put_u32(out, static_cast<uint32_t>(dict.size()));
+    for (const auto& entry : dict) {
+        put_bytes(out, entry.first);
+        encode_metadata_value(out, entry.second);
     }
 }
 
-OtioTimeRange otio_stack_trimmed_range(OtioStack* stack, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!stack) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Stack is null", sizeof(err->message) - 1);
+// Hand an encoding to the caller, or only its size if buffer is too small.
+static int64_t copy_encoded(const std::string& encoded, uint8_t* buffer, size_t capacity) {
+    if (buffer && encoded.size() <= capacity) std::memcpy(buffer, encoded.data(), encoded.size());
+    return static_cast<int64_t>(encoded.size());
+}
+
+// Nesting limit, so a hostile buffer can't exhaust the stack
+static constexpr int kMaxMetadataDepth = 256;
+
+static std::any decode_metadata_value(MetadataReader& in, int depth) {
+    if (depth > kMaxMetadataDepth) throw std::invalid_argument("Metadata encoding is nested too deeply");
+    switch (in.byte()) {
+        case OTIO_METADATA_NULL:
+            return std::any();
+        case OTIO_METADATA_BOOL:
+            return std::any(in.byte() != 0);
+        case OTIO_METADATA_INT:
+            return std::any(static_cast<int64_t>(in.u64()));
+        case OTIO_METADATA_DOUBLE: {
+            uint64_t bits = in.u64();
+            double d;
+            std::memcpy(&d, &bits, sizeof d);
+            return std::any(d);
         }
-        return zero;
-    }
-    try {
-        auto s = reinterpret_cast<otio::Stack*>(stack);
-        otio::ErrorStatus status;
-        auto range = s->trimmed_range(&status);
-        if (otio::is_error(status)) {
-            if (err) {
-                err->code = static_cast<int>(status.outcome);
-                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
+        case OTIO_METADATA_STRING:
+            return std::any(in.bytes());
+        case OTIO_METADATA_DICT: {
+            otio::AnyDictionary dict;
+            for (uint32_t n = in.u32(); n > 0; --n) {
+                std::string key = in.bytes();
+                dict[key] = decode_metadata_value(in, depth + 1);
             }
-            return zero;
-        }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, e.what(), sizeof(err->message) - 1);
+            return std::any(std::move(dict));
         }
-        return zero;
-    } catch (...) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
+        case OTIO_METADATA_ARRAY: {
+            otio::AnyVector array;
+            for (uint32_t n = in.u32(); n > 0; --n) {
+                array.push_back(decode_metadata_value(in, depth + 1));
+            }
+            return std::any(std::move(array));
         }
-        return zero;
+        case OTIO_METADATA_OTHER:
+            throw std::invalid_argument("Values of other types cannot be decoded");
+        default:
+            throw std::invalid_argument("Unknown metadata tag");
     }
 }
 
-// ----------------------------------------------------------------------------
-// ExternalReference additional accessors
-// ----------------------------------------------------------------------------
-
-char* otio_external_ref_get_target_url(OtioExternalRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
-        return safe_strdup(typed->target_url());
-    )
+int32_t otio_metadata_kind(void* obj, const char* key) {
+    try {
+        auto value = find_metadata_value(obj, key);
+        return value ? metadata_kind_of(*value) : -1;
+    } catch (...) {
+        return -1;
+    }
 }
 
-OtioTimeRange otio_external_ref_get_available_range(OtioExternalRef* ref) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!ref) return zero;
+int32_t otio_metadata_get_int64(void* obj, const char* key, int64_t* out) {
+    if (!out) return 0;
     try {
-        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
-        auto range_opt = typed->available_range();
-        if (!range_opt.has_value()) return zero;
-        auto range = range_opt.value();
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
+        auto value = find_metadata_value(obj, key);
+        return value && metadata_int_of(*value, out) ? 1 : 0;
     } catch (...) {
-        return zero;
+        return 0;
     }
 }
 
-char* otio_external_ref_get_name(OtioExternalRef* ref) {
-    OTIO_NULL_CHECK(ref, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
-        return safe_strdup(typed->name());
-    )
+int32_t otio_metadata_get_double(void* obj, const char* key, double* out) {
+    if (!out) return 0;
+    try {
+        auto value = find_metadata_value(obj, key);
+        return value && metadata_double_of(*value, out) ? 1 : 0;
+    } catch (...) {
+        return 0;
+    }
 }
 
-void otio_external_ref_set_name(OtioExternalRef* ref, const char* name) {
-    if (!ref || !name) return;
+int32_t otio_metadata_get_bool(void* obj, const char* key, int32_t* out) {
+    if (!out) return 0;
     try {
-        auto typed = reinterpret_cast<otio::ExternalReference*>(ref);
-        typed->set_name(std::string(name));
+        auto value = find_metadata_value(obj, key);
+        if (!value || value->type() != typeid(bool)) return 0;
+        *out = std::any_cast<bool>(*value) ? 1 : 0;
+        return 1;
     } catch (...) {
-        // Ignore exceptions
+        return 0;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Timeline additional accessors
-// ----------------------------------------------------------------------------
+int32_t otio_metadata_set_int64(void* obj, const char* key, int64_t value, OtioError* err) {
+    OTIO_TRY_INT(err, if (store_metadata_value(obj, key, std::any(value), err) != 0) return -1;)
+}
 
-char* otio_timeline_get_name(OtioTimeline* tl) {
-    OTIO_NULL_CHECK(tl, nullptr);
-    OTIO_TRY_PTR(
-        auto typed = reinterpret_cast<otio::Timeline*>(tl);
-        return safe_strdup(typed->name());
-    )
+int32_t otio_metadata_set_double(void* obj, const char* key, double value, OtioError* err) {
+    OTIO_TRY_INT(err, if (store_metadata_value(obj, key, std::any(value), err) != 0) return -1;)
 }
 
-OtioRationalTime otio_timeline_get_global_start_time(OtioTimeline* tl) {
-    OtioRationalTime zero = {0, 1};
-    if (!tl) return zero;
+int32_t otio_metadata_set_bool(void* obj, const char* key, int32_t value, OtioError* err) {
+    OTIO_TRY_INT(err, if (store_metadata_value(obj, key, std::any(value != 0), err) != 0) return -1;)
+}
+
+int64_t otio_metadata_export(void* obj, uint8_t* buffer, size_t capacity, OtioError* err) {
+    auto owner = metadata_owner(obj);
+    if (!owner) {
+        set_error(err, 1, "Object has no metadata");
+        return -1;
+    }
     try {
-        auto typed = reinterpret_cast<otio::Timeline*>(tl);
-        auto time_opt = typed->global_start_time();
-        if (!time_opt.has_value()) return zero;
-        auto time = time_opt.value();
-        return OtioRationalTime{time.value(), time.rate()};
+        static thread_local std::string encoded;
+        encoded.clear();
+        encode_metadata_dict(encoded, owner->metadata());
+        return copy_encoded(encoded, buffer, capacity);
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
-        return zero;
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-OtioTimeRange otio_timeline_get_duration(OtioTimeline* tl, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!tl) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Timeline is null", sizeof(err->message) - 1);
-        }
-        return zero;
+int64_t otio_metadata_export_value(void* obj, const char* key, uint8_t* buffer, size_t capacity,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(key, err, -1, "Key is null");
+    if (!metadata_owner(obj)) {
+        set_error(err, 1, "Object has no metadata");
+        return -1;
     }
     try {
-        auto typed = reinterpret_cast<otio::Timeline*>(tl);
-        otio::ErrorStatus status;
-        auto duration = typed->duration(&status);
-        if (otio::is_error(status)) {
-            if (err) {
-                err->code = static_cast<int>(status.outcome);
-                strncpy(err->message, status.details.c_str(), sizeof(err->message) - 1);
-            }
-            return zero;
-        }
-        // Return as a TimeRange with start at 0
-        return OtioTimeRange{
-            OtioRationalTime{0, duration.rate()},
-            OtioRationalTime{duration.value(), duration.rate()}
-        };
+        auto value = find_metadata_value(obj, key);
+        if (!value) return 0;
+        static thread_local std::string encoded;
+        encoded.clear();
+        encode_metadata_value(encoded, *value);
+        return copy_encoded(encoded, buffer, capacity);
     } catch (const std::exception& e) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, e.what(), sizeof(err->message) - 1);
-        }
-        return zero;
+        set_error(err, 1, e.what());
+        return -1;
     } catch (...) {
-        if (err) {
-            err->code = -1;
-            strncpy(err->message, "Unknown error", sizeof(err->message) - 1);
-        }
-        return zero;
+        set_error(err, 1, "Unknown exception");
+        return -1;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Edit Algorithms
-// ----------------------------------------------------------------------------
-
-int otio_track_overwrite(OtioTrack* track, OtioClip* clip,
-    OtioTimeRange range, int remove_transitions, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+int32_t otio_metadata_import_value(void* obj, const char* key, const uint8_t* data, size_t len,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(data, err, -1, "Data is null");
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::ErrorStatus status;
-        otio::algo::overwrite(c, t, to_otio_tr(range), remove_transitions != 0, nullptr, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
+        MetadataReader in{data, len};
+        std::any value = decode_metadata_value(in, 0);
+        if (in.pos != len) {
+            set_error(err, 1, "Trailing bytes after metadata value");
             return -1;
         }
-        return 0;
+        return store_metadata_value(obj, key, std::move(value), err);
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
         return -1;
@@ -2369,478 +7759,1989 @@ int otio_track_overwrite(OtioTrack* track, OtioClip* clip,
     }
 }
 
-int otio_track_insert_at_time(OtioTrack* track, OtioClip* clip,
-    OtioRationalTime time, int remove_transitions, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto c = reinterpret_cast<otio::Clip*>(clip);
+// ----------------------------------------------------------------------------
+// Change tracking and patches
+// ----------------------------------------------------------------------------
+
+static otio::Item* item_of(otio::Composable* obj) {
+    int32_t type = object_type_of(obj);
+    if (type == OTIO_CHILD_TYPE_CLIP || type == OTIO_CHILD_TYPE_GAP ||
+        type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+        return static_cast<otio::Item*>(obj);
+    }
+    return type < 0 ? counted_dynamic_cast<otio::Item*>(obj) : nullptr;
+}
+
+// Compositions whose own fields can be patched without their children
+static otio::Composition* patchable_composition(otio::Composable* obj) {
+    int32_t type = object_type_of(obj);
+    return (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK)
+        ? static_cast<otio::Composition*>(obj) : nullptr;
+}
+
+// A child as of the last patch. The edit algorithms retime children in
+// place, so the source range is compared as well as the identity.
+struct TrackedChild {
+    Retainer<otio::Composable> item;
+    std::optional<otio::TimeRange> source_range;
+};
+
+static TrackedChild tracked_child(otio::Composable* child) {
+    auto item = item_of(child);
+    return TrackedChild{Retainer<otio::Composable>(child),
+                        item ? item->source_range() : std::optional<otio::TimeRange>()};
+}
+
+static bool same_range(const std::optional<otio::TimeRange>& a, const std::optional<otio::TimeRange>& b) {
+    if (a.has_value() != b.has_value()) return false;
+    return !a || (a->start_time() == b->start_time() && a->duration() == b->duration());
+}
+
+struct OtioChangeTracker : MutationListener {
+    // The timeline's own fields are reported on the timeline object
+    struct TimelineFields : MutationListener {
+        OtioChangeTracker* owner = nullptr;
+        void on_mutation(size_t) override;
+    };
+
+    // Borrowed: the timeline outlives the tracker. Rust owns timelines with
+    // a refcount of 0, so a Retainer here would delete it on release.
+    otio::Timeline* timeline;
+    otio::Composition* root;
+    TimelineFields timeline_fields;
+
+    // Notifications arrive on whichever thread edits the timeline
+    std::mutex mutex;
+    bool timeline_changed = false;
+    std::unordered_map<otio::Composable*, Retainer<otio::Composable>> edited;     // Own fields
+    std::unordered_map<otio::Composable*, Retainer<otio::Composable>> reshaped;   // Children
+    // Children of every composition in the tree as of the last patch. The
+    // compositions are kept alive by their parent's entry.
+    std::unordered_map<otio::Composition*, std::vector<TrackedChild>> baseline;
+
+    OtioChangeTracker(otio::Timeline* tl) : timeline(tl), root(tl->tracks()) {
+        timeline_fields.owner = this;
+        add_mutation_listener(root, this);
+        add_mutation_listener(tl, &timeline_fields);
+    }
+    ~OtioChangeTracker() override {
+        remove_mutation_listener(timeline, &timeline_fields);
+        remove_mutation_listener(root, this);
+    }
+
+    void on_mutation(size_t) override {}
+
+    void on_attributes_changed(otio::Composable* item, const std::string*) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        edited.emplace(item, Retainer<otio::Composable>(item));
+    }
+
+    void on_edited(otio::Composable* obj, bool children) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& set = children ? reshaped : edited;
+        set.emplace(obj, Retainer<otio::Composable>(obj));
+    }
+};
+
+void OtioChangeTracker::TimelineFields::on_mutation(size_t) {
+    std::lock_guard<std::mutex> lock(owner->mutex);
+    owner->timeline_changed = true;
+}
+
+// Record comp and every composition below it. Caller holds tracker->mutex.
+static void baseline_add_tree(OtioChangeTracker* tracker, otio::Composition* comp) {
+    std::vector<otio::Composition*> pending{comp};
+    while (!pending.empty()) {
+        otio::Composition* c = pending.back();
+        pending.pop_back();
+        auto& entry = tracker->baseline[c];
+        entry.clear();
+        for (const auto& child : c->children()) {
+            entry.push_back(tracked_child(child.value));
+            if (auto nested = counted_dynamic_cast<otio::Composition*>(child.value)) pending.push_back(nested);
+        }
+    }
+}
+
+// Forget comp and every composition recorded below it
+static void baseline_remove_tree(OtioChangeTracker* tracker, otio::Composition* comp) {
+    std::vector<otio::Composition*> pending{comp};
+    while (!pending.empty()) {
+        auto it = tracker->baseline.find(pending.back());
+        pending.pop_back();
+        if (it == tracker->baseline.end()) continue;
+        for (const auto& child : it->second) {
+            if (auto nested = counted_dynamic_cast<otio::Composition*>(child.item.value)) pending.push_back(nested);
+        }
+        tracker->baseline.erase(it);
+    }
+}
+
+// Child indices from the root down to obj; false if obj is not in the tree
+static bool tracked_path(OtioChangeTracker* tracker, otio::Composable* obj, std::vector<int32_t>& path) {
+    path.clear();
+    while (obj != tracker->root) {
+        otio::Composition* parent = obj->parent();
+        if (!parent) return false;
         otio::ErrorStatus status;
-        otio::algo::insert(c, t, to_otio_rt(time), remove_transitions != 0, nullptr, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
+        int index = parent->index_of_child(obj, &status);
+        if (index < 0) return false;
+        path.push_back(index);
+        obj = parent;
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+enum PatchOpKind { PATCH_TIMELINE, PATCH_FIELDS, PATCH_SPLICE, PATCH_SET };
+
+struct PatchOp {
+    std::vector<int32_t> path;
+    PatchOpKind kind;
+    otio::Composable* target = nullptr;  // FIELDS, SET: the object; SPLICE: the composition
+    int32_t start = 0;                   // SPLICE
+    int32_t remove = 0;
+    int32_t insert = 0;
+};
+
+static std::string compact_json_of(const otio::SerializableObject* obj) {
+    OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+    otio::ErrorStatus status;
+    std::string json = obj->to_json_string(&status, nullptr, 0);
+    OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+    if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+    compact_json(json);
+    return json;
+}
+
+// The composition without its children, for a FIELDS op
+static std::string fields_json_of(otio::Composition* comp) {
+    otio::Composition* empty = nullptr;
+    if (object_type_of(comp) == OTIO_CHILD_TYPE_TRACK) {
+        empty = new otio::Track(comp->name(), comp->source_range(), static_cast<otio::Track*>(comp)->kind());
+    } else {
+        empty = new otio::Stack(comp->name(), comp->source_range());
+    }
+    Retainer<otio::Composition> copy(empty);
+    copy.value->metadata() = comp->metadata();
+    copy.value->effects() = comp->effects();
+    copy.value->markers() = comp->markers();
+    copy.value->set_enabled(comp->enabled());
+    return compact_json_of(copy.value);
+}
+
+static void put_patch_path(std::string& out, const std::vector<int32_t>& path) {
+    out += "\"path\":[";
+    for (size_t i = 0; i < path.size(); ++i) {
+        if (i) out += ',';
+        out += std::to_string(path[i]);
+    }
+    out += ']';
+}
+
+// Inside the inserted range of an earlier splice, so already in the patch
+static bool patch_op_covered(const std::vector<PatchOp>& splices, const std::vector<int32_t>& path) {
+    for (const auto& splice : splices) {
+        size_t depth = splice.path.size();
+        if (path.size() <= depth || !std::equal(splice.path.begin(), splice.path.end(), path.begin())) continue;
+        if (path[depth] >= splice.start && path[depth] < splice.start + splice.insert) return true;
+    }
+    return false;
+}
+
+// Caller holds tracker->mutex
+static std::string take_tracked_patch(OtioChangeTracker* tracker) {
+    std::vector<PatchOp> ops;
+    std::vector<int32_t> path;
+    std::unordered_set<otio::Composable*> retimed;
+    // Removed from and added to the tree, applied to the baseline afterwards
+    std::vector<otio::Composition*> removed;
+    std::vector<otio::Composition*> added;
+    std::vector<otio::Composition*> relisted;
+
+    for (const auto& entry : tracker->reshaped) {
+        auto comp = counted_dynamic_cast<otio::Composition*>(entry.first);
+        auto before = comp ? tracker->baseline.find(comp) : tracker->baseline.end();
+        if (before == tracker->baseline.end() || !tracked_path(tracker, comp, path)) continue;
+        const auto& old_children = before->second;
+        const auto& children = comp->children();
+        size_t prefix = 0;
+        while (prefix < old_children.size() && prefix < children.size() &&
+               old_children[prefix].item.value == children[prefix].value) {
+            ++prefix;
+        }
+        size_t suffix = 0;
+        while (suffix < old_children.size() - prefix && suffix < children.size() - prefix &&
+               old_children[old_children.size() - 1 - suffix].item.value ==
+                   children[children.size() - 1 - suffix].value) {
+            ++suffix;
+        }
+        // Children kept in place may have been retimed
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (i >= prefix && i < children.size() - suffix) continue;
+            size_t old_i = i < prefix ? i : i - children.size() + old_children.size();
+            if (!same_range(old_children[old_i].source_range, tracked_child(children[i].value).source_range)) {
+                retimed.insert(children[i].value);
+            }
+        }
+        size_t remove = old_children.size() - prefix - suffix;
+        size_t insert = children.size() - prefix - suffix;
+        if (remove == 0 && insert == 0) continue;
+        PatchOp op{path, PATCH_SPLICE, comp, static_cast<int32_t>(prefix),
+                   static_cast<int32_t>(remove), static_cast<int32_t>(insert)};
+        ops.push_back(std::move(op));
+        for (size_t i = prefix; i < prefix + remove; ++i) {
+            if (auto nested = counted_dynamic_cast<otio::Composition*>(old_children[i].item.value)) removed.push_back(nested);
+        }
+        for (size_t i = prefix; i < prefix + insert; ++i) {
+            if (auto nested = counted_dynamic_cast<otio::Composition*>(children[i].value)) added.push_back(nested);
+        }
+        relisted.push_back(comp);
+    }
+
+    for (const auto& entry : tracker->edited) retimed.insert(entry.first);
+    for (otio::Composable* obj : retimed) {
+        if (!tracked_path(tracker, obj, path)) continue;
+        bool fields = patchable_composition(obj) != nullptr;
+        ops.push_back(PatchOp{path, fields ? PATCH_FIELDS : PATCH_SET, obj});
+        // The root has no parent entry to refresh
+        if (obj->parent()) relisted.push_back(obj->parent());
+    }
+
+    // Parents before children, a node's fields before its children
+    std::sort(ops.begin(), ops.end(), [](const PatchOp& a, const PatchOp& b) {
+        return a.path != b.path ? a.path < b.path : a.kind < b.kind;
+    });
+
+    std::string out = "{\"OTIO_PATCH\":1,\"ops\":[";
+    bool first = true;
+    auto begin_op = [&out, &first](const char* name) {
+        if (!first) out += ',';
+        first = false;
+        out += "{\"op\":\"";
+        out += name;
+        out += "\",";
+    };
+    if (tracker->timeline_changed) {
+        otio::Timeline* tl = tracker->timeline;
+        Retainer<otio::Timeline> fields(new otio::Timeline(tl->name(), tl->global_start_time(), tl->metadata()));
+        begin_op("timeline");
+        out += "\"value\":";
+        out += compact_json_of(fields.value);
+        out += '}';
+    }
+    std::vector<PatchOp> splices;
+    for (const auto& op : ops) {
+        if (patch_op_covered(splices, op.path)) continue;
+        if (op.kind == PATCH_SPLICE) {
+            begin_op("splice");
+            put_patch_path(out, op.path);
+            out += ",\"start\":" + std::to_string(op.start) + ",\"remove\":" + std::to_string(op.remove) +
+                   ",\"insert\":[";
+            auto& children = static_cast<otio::Composition*>(op.target)->children();
+            for (int32_t i = 0; i < op.insert; ++i) {
+                if (i) out += ',';
+                out += compact_json_of(children[static_cast<size_t>(op.start + i)].value);
+            }
+            out += "]}";
+            splices.push_back(op);
+        } else {
+            begin_op(op.kind == PATCH_FIELDS ? "fields" : "set");
+            put_patch_path(out, op.path);
+            out += ",\"value\":";
+            out += op.kind == PATCH_FIELDS ? fields_json_of(static_cast<otio::Composition*>(op.target))
+                                           : compact_json_of(op.target);
+            out += '}';
+        }
+    }
+    out += "]}";
+
+    // The document is complete; only now move the baseline forward. Moved
+    // compositions are in both lists, so removals go first.
+    for (otio::Composition* comp : removed) baseline_remove_tree(tracker, comp);
+    for (otio::Composition* comp : added) baseline_add_tree(tracker, comp);
+    for (otio::Composition* comp : relisted) {
+        auto& entry = tracker->baseline[comp];
+        entry.clear();
+        for (const auto& child : comp->children()) entry.push_back(tracked_child(child.value));
+    }
+    tracker->edited.clear();
+    tracker->reshaped.clear();
+    tracker->timeline_changed = false;
+    return out;
+}
+
+// One parsed op of a patch document
+struct ParsedPatchOp {
+    PatchOpKind kind = PATCH_TIMELINE;
+    std::vector<int32_t> path;
+    int32_t start = 0;
+    int32_t remove = 0;
+    std::vector<Retainer<otio::SerializableObject>> values;
+};
+
+static bool json_int_member(const std::string& s, JsonSpan span, int32_t& out) {
+    auto result = std::from_chars(s.data() + span.begin, s.data() + span.end, out);
+    return result.ec == std::errc() && result.ptr == s.data() + span.end && out >= 0;
+}
+
+static Retainer<otio::SerializableObject> parse_patch_value(const std::string& s, JsonSpan span) {
+    OTIO_STATS_SCOPE(OTIO_STAT_PARSE);
+    OTIO_STATS_BYTES(OTIO_STAT_PARSE, span.end - span.begin);
+    otio::ErrorStatus status;
+    auto obj = otio::SerializableObject::from_json_string(s.substr(span.begin, span.end - span.begin), &status);
+    if (otio::is_error(status) || !obj) throw std::invalid_argument("Invalid object in patch: " + status.full_description);
+    return Retainer<otio::SerializableObject>(obj);
+}
+
+// Every value is parsed before anything is applied
+static std::vector<ParsedPatchOp> parse_patch(const std::string& s) {
+    auto malformed = [] { throw std::invalid_argument("Malformed patch"); };
+    size_t begin = json_skip_ws(s, 0);
+    size_t end = json_skip_value(s, begin);
+    if (begin >= s.size() || s[begin] != '{' || end == std::string::npos || json_skip_ws(s, end) != s.size()) {
+        malformed();
+    }
+    std::vector<JsonMember> members;
+    if (!json_object_members(s, JsonSpan{begin, end}, members)) malformed();
+    std::vector<JsonSpan> op_spans;
+    bool versioned = false;
+    for (const auto& m : members) {
+        if (json_span_equals(s, m.key, "OTIO_PATCH")) {
+            if (!json_span_equals(s, m.value, "1")) throw std::invalid_argument("Unsupported patch version");
+            versioned = true;
+        } else if (json_span_equals(s, m.key, "ops")) {
+            if (s[m.value.begin] != '[' || !json_array_elements(s, m.value, op_spans)) malformed();
+        }
+    }
+    if (!versioned) malformed();
+
+    std::vector<ParsedPatchOp> ops;
+    for (const auto& span : op_spans) {
+        std::vector<JsonMember> fields;
+        if (s[span.begin] != '{' || !json_object_members(s, span, fields)) malformed();
+        ParsedPatchOp op;
+        bool has_kind = false;
+        for (const auto& f : fields) {
+            if (json_span_equals(s, f.key, "op")) {
+                has_kind = true;
+                if (json_span_equals(s, f.value, "\"timeline\"")) op.kind = PATCH_TIMELINE;
+                else if (json_span_equals(s, f.value, "\"fields\"")) op.kind = PATCH_FIELDS;
+                else if (json_span_equals(s, f.value, "\"splice\"")) op.kind = PATCH_SPLICE;
+                else if (json_span_equals(s, f.value, "\"set\"")) op.kind = PATCH_SET;
+                else throw std::invalid_argument("Unknown patch op");
+            } else if (json_span_equals(s, f.key, "path")) {
+                std::vector<JsonSpan> indices;
+                if (s[f.value.begin] != '[' || !json_array_elements(s, f.value, indices)) malformed();
+                for (const auto& index : indices) {
+                    int32_t i = 0;
+                    if (!json_int_member(s, index, i)) malformed();
+                    op.path.push_back(i);
+                }
+            } else if (json_span_equals(s, f.key, "start")) {
+                if (!json_int_member(s, f.value, op.start)) malformed();
+            } else if (json_span_equals(s, f.key, "remove")) {
+                if (!json_int_member(s, f.value, op.remove)) malformed();
+            } else if (json_span_equals(s, f.key, "value")) {
+                op.values.push_back(parse_patch_value(s, f.value));
+            } else if (json_span_equals(s, f.key, "insert")) {
+                std::vector<JsonSpan> values;
+                if (s[f.value.begin] != '[' || !json_array_elements(s, f.value, values)) malformed();
+                for (const auto& value : values) op.values.push_back(parse_patch_value(s, value));
+            }
+        }
+        bool one_value = op.kind != PATCH_SPLICE;
+        if (!has_kind || (one_value && op.values.size() != 1) ||
+            (op.kind == PATCH_SET && op.path.empty())) {
+            malformed();
+        }
+        for (const auto& value : op.values) {
+            bool ok = op.kind == PATCH_TIMELINE ? object_type_of(value.value) == OTIO_OBJECT_TYPE_TIMELINE
+                                                : counted_dynamic_cast<otio::Composable*>(value.value) != nullptr;
+            if (!ok) throw std::invalid_argument("Patch value has the wrong schema");
+        }
+        ops.push_back(std::move(op));
+    }
+    return ops;
+}
+
+static otio::Composable* resolve_patch_path(otio::Composition* root, const std::vector<int32_t>& path, size_t depth) {
+    otio::Composable* node = root;
+    for (size_t i = 0; i < depth; ++i) {
+        auto comp = counted_dynamic_cast<otio::Composition*>(node);
+        if (!comp || static_cast<size_t>(path[i]) >= comp->children().size()) {
+            throw std::out_of_range("Patch path does not match the timeline");
+        }
+        node = comp->children()[static_cast<size_t>(path[i])].value;
+    }
+    return node;
+}
+
+// The own fields of a timeline, as a patch replaces them
+struct TimelineFields {
+    std::string name;
+    std::optional<otio::RationalTime> global_start_time;
+    otio::AnyDictionary metadata;
+};
+
+static TimelineFields get_timeline_fields(otio::Timeline* tl) {
+    return TimelineFields{tl->name(), tl->global_start_time(), tl->metadata()};
+}
+
+static void set_timeline_fields(otio::Timeline* tl, const TimelineFields& fields) {
+    tl->set_name(fields.name);
+    tl->set_global_start_time(fields.global_start_time);
+    tl->metadata() = fields.metadata;
+    note_timeline_changed(tl);
+}
+
+// The own fields of a composition; kind only applies to tracks
+struct CompositionFields {
+    std::string name;
+    std::optional<otio::TimeRange> source_range;
+    otio::AnyDictionary metadata;
+    std::vector<Retainer<otio::Effect>> effects;
+    std::vector<Retainer<otio::Marker>> markers;
+    bool enabled;
+    std::string kind;
+};
+
+static CompositionFields get_composition_fields(otio::Composition* comp) {
+    CompositionFields fields{comp->name(), comp->source_range(), comp->metadata(), comp->effects(),
+        comp->markers(), comp->enabled(), std::string()};
+    if (object_type_of(comp) == OTIO_CHILD_TYPE_TRACK) fields.kind = static_cast<otio::Track*>(comp)->kind();
+    return fields;
+}
+
+static void set_composition_fields(otio::Composition* comp, const CompositionFields& fields) {
+    comp->set_name(fields.name);
+    comp->set_source_range(fields.source_range);
+    comp->metadata() = fields.metadata;
+    comp->effects() = fields.effects;
+    comp->markers() = fields.markers;
+    comp->set_enabled(fields.enabled);
+    if (object_type_of(comp) == OTIO_CHILD_TYPE_TRACK) static_cast<otio::Track*>(comp)->set_kind(fields.kind);
+    note_mutation(comp);
+    notify_attributes(comp, nullptr);
+}
+
+static void apply_patch_op(otio::Timeline* tl, ParsedPatchOp& op) {
+    otio::ErrorStatus status;
+    auto check = [&status] {
+        if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+    };
+    switch (op.kind) {
+    case PATCH_TIMELINE: {
+        auto fields = static_cast<otio::Timeline*>(op.values[0].value);
+        auto undo = journal_field(tl, &get_timeline_fields, &set_timeline_fields);
+        set_timeline_fields(tl, get_timeline_fields(fields));
+        journal_push(tl, std::move(undo));
+        break;
+    }
+    case PATCH_FIELDS: {
+        auto target = patchable_composition(resolve_patch_path(tl->tracks(), op.path, op.path.size()));
+        auto fields = patchable_composition(static_cast<otio::Composable*>(op.values[0].value));
+        if (!target || !fields || object_type_of(target) != object_type_of(fields)) {
+            throw std::invalid_argument("Patch fields do not match the target's schema");
+        }
+        auto undo = journal_field(target, &get_composition_fields, &set_composition_fields);
+        set_composition_fields(target, get_composition_fields(fields));
+        journal_push(target, std::move(undo));
+        break;
+    }
+    case PATCH_SPLICE: {
+        auto comp = counted_dynamic_cast<otio::Composition*>(resolve_patch_path(tl->tracks(), op.path, op.path.size()));
+        if (!comp || static_cast<size_t>(op.start) + static_cast<size_t>(op.remove) > comp->children().size()) {
+            throw std::out_of_range("Patch path does not match the timeline");
         }
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+        const auto first = comp->children().begin() + op.start;
+        std::vector<Retainer<otio::Composable>> removed(first, first + op.remove);
+        for (int32_t i = 0; i < op.remove; ++i) {
+            comp->remove_child(op.start, &status);
+            check();
+        }
+        for (size_t i = 0; i < op.values.size(); ++i) {
+            comp->insert_child(op.start + static_cast<int>(i), static_cast<otio::Composable*>(op.values[i].value), &status);
+            check();
+        }
+        note_children_changed(comp, static_cast<size_t>(op.start));
+        if (journal_wanted(comp)) {
+            journal_push(comp, std::make_unique<SpliceRecord>(comp, static_cast<size_t>(op.start),
+                op.values.size(), std::move(removed)));
+        }
+        break;
+    }
+    case PATCH_SET: {
+        auto parent = counted_dynamic_cast<otio::Composition*>(resolve_patch_path(tl->tracks(), op.path, op.path.size() - 1));
+        int32_t index = op.path.back();
+        if (!parent || static_cast<size_t>(index) >= parent->children().size()) {
+            throw std::out_of_range("Patch path does not match the timeline");
+        }
+        Retainer<otio::Composable> replaced(parent->children()[static_cast<size_t>(index)].value);
+        parent->set_child(index, static_cast<otio::Composable*>(op.values[0].value), &status);
+        check();
+        note_children_changed(parent, static_cast<size_t>(index));
+        if (journal_wanted(parent)) {
+            journal_push(parent, std::make_unique<SpliceRecord>(parent, static_cast<size_t>(index), 1,
+                std::vector<Retainer<otio::Composable>>{replaced}));
+        }
+        break;
+    }
     }
 }
 
-int otio_track_slice_at_time(OtioTrack* track, OtioRationalTime time,
-    int remove_transitions, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+OtioChangeTracker* otio_timeline_track_changes(OtioTimeline* tl, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        otio::ErrorStatus status;
-        otio::algo::slice(t, to_otio_rt(time), remove_transitions != 0, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
+        std::unique_ptr<OtioChangeTracker> tracker(new OtioChangeTracker(reinterpret_cast<otio::Timeline*>(tl)));
+        {
+            std::lock_guard<std::mutex> lock(tracker->mutex);
+            baseline_add_tree(tracker.get(), tracker->root);
         }
-        return 0;
+        return tracker.release();
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return -1;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return -1;
+        return nullptr;
     }
 }
 
-int otio_clip_slip(OtioClip* clip, OtioRationalTime delta, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::algo::slip(c, to_otio_rt(delta));
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
-    }
+void otio_change_tracker_free(OtioChangeTracker* tracker) {
+    delete tracker;
 }
 
-int otio_clip_slide(OtioClip* clip, OtioRationalTime delta, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+int32_t otio_change_tracker_has_changes(OtioChangeTracker* tracker) {
+    if (!tracker) return 0;
+    std::lock_guard<std::mutex> lock(tracker->mutex);
+    return (tracker->timeline_changed || !tracker->edited.empty() || !tracker->reshaped.empty()) ? 1 : 0;
+}
+
+char* otio_change_tracker_take_patch(OtioChangeTracker* tracker, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tracker, err, nullptr, "Change tracker is null");
     try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::algo::slide(c, to_otio_rt(delta));
-        return 0;
+        std::lock_guard<std::mutex> lock(tracker->mutex);
+        return safe_strdup(take_tracked_patch(tracker));
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return -1;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return -1;
+        return nullptr;
     }
 }
 
-int otio_clip_trim(OtioClip* clip, OtioRationalTime delta_in,
-    OtioRationalTime delta_out, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
+int otio_timeline_apply_patch(OtioTimeline* tl, const char* patch, size_t len, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, -1, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(patch, err, -1, "Patch is null");
+    OTIO_TRY_INT(err,
+        auto ops = parse_patch(std::string(patch, len));
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        // One undo step for the whole patch
+        JournalGroup group(timeline);
+        for (auto& op : ops) apply_patch_op(timeline, op);
+    )
+}
+
+// ----------------------------------------------------------------------------
+// Undo journal
+// ----------------------------------------------------------------------------
+
+OtioUndoJournal* otio_timeline_enable_undo(OtioTimeline* tl, int32_t depth, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    if (depth <= 0) {
+        set_error(err, 1, "Undo depth must be positive");
+        return nullptr;
+    }
     try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::ErrorStatus status;
-        otio::algo::trim(c, to_otio_rt(delta_in), to_otio_rt(delta_out), nullptr, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
+        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+        auto journal = std::make_unique<OtioUndoJournal>();
+        journal->timeline = timeline;
+        journal->tracks = Retainer<otio::Stack>(timeline->tracks());
+        journal->depth = static_cast<size_t>(depth);
+
+        auto& registry = undo_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (registry.journals.count(timeline) != 0 || registry.journals.count(timeline->tracks()) != 0) {
+            set_error(err, 1, "Timeline already has an undo journal");
+            return nullptr;
         }
-        return 0;
+        registry.journals.emplace(timeline, journal.get());
+        registry.journals.emplace(timeline->tracks(), journal.get());
+        registry.active.store(true, std::memory_order_release);
+        return journal.release();
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return -1;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return -1;
+        return nullptr;
     }
 }
 
-int otio_clip_ripple(OtioClip* clip, OtioRationalTime delta_in,
-    OtioRationalTime delta_out, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::ErrorStatus status;
-        otio::algo::ripple(c, to_otio_rt(delta_in), to_otio_rt(delta_out), &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
-        }
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return -1;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+void otio_undo_journal_free(OtioUndoJournal* journal) {
+    if (!journal) return;
+    {
+        auto& registry = undo_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.journals.erase(journal->timeline);
+        registry.journals.erase(journal->tracks.value);
+        registry.active.store(!registry.journals.empty(), std::memory_order_release);
     }
+    delete journal;
 }
 
-int otio_clip_roll(OtioClip* clip, OtioRationalTime delta_in,
-    OtioRationalTime delta_out, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(clip, err, -1, "Clip is null");
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::ErrorStatus status;
-        otio::algo::roll(c, to_otio_rt(delta_in), to_otio_rt(delta_out), &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
+int32_t otio_undo_journal_undo_count(OtioUndoJournal* journal) {
+    if (!journal) return 0;
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    return static_cast<int32_t>(journal->undo.size());
+}
+
+int32_t otio_undo_journal_redo_count(OtioUndoJournal* journal) {
+    if (!journal) return 0;
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    return static_cast<int32_t>(journal->redo.size());
+}
+
+void otio_undo_journal_begin_group(OtioUndoJournal* journal) {
+    if (!journal) return;
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    ++journal->open_groups;
+}
+
+void otio_undo_journal_end_group(OtioUndoJournal* journal) {
+    if (!journal) return;
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    if (journal->open_groups == 0 || --journal->open_groups > 0 || journal->group.empty()) return;
+    journal->add_step(std::move(journal->group));
+    journal->group.clear();
+}
+
+void otio_undo_journal_clear(OtioUndoJournal* journal) {
+    if (!journal) return;
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    journal->undo.clear();
+    journal->redo.clear();
+    journal->group.clear();
+}
+
+// Apply the newest undo (or redo) step, in reverse, and keep its inverse as
+// the newest redo (or undo) step. A step whose record fails partway has the
+// records already applied reverted, so the timeline is left as it was.
+static int replay_journal_step(OtioUndoJournal* journal, bool redo, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(journal, err, -1, "Undo journal is null");
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    auto& from = redo ? journal->redo : journal->undo;
+    auto& to = redo ? journal->undo : journal->redo;
+    if (journal->open_groups > 0) {
+        set_error(err, 1, "An undo group is open");
+        return -1;
+    }
+    if (from.empty()) return 0;
+    JournalStep step = std::move(from.back());
+    from.pop_back();
+    JournalStep inverse;
+    auto fail = [&](std::string message) {
+        try {
+            for (auto it = inverse.rbegin(); it != inverse.rend(); ++it) (*it)->apply();
+        } catch (...) {
+            message += "; the step could not be reverted";
         }
-        return 0;
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
+        // The timeline was edited around the journal; its history is void
+        journal->undo.clear();
+        journal->redo.clear();
+        set_error(err, 1, message.c_str());
         return -1;
+    };
+    try {
+        inverse.reserve(step.size());
+        for (auto it = step.rbegin(); it != step.rend(); ++it) inverse.push_back((*it)->apply());
+        to.push_back(std::move(inverse));
+        return 1;
+    } catch (const std::exception& e) {
+        return fail(e.what());
     } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return -1;
+        return fail("Unknown exception");
     }
 }
 
-int otio_track_remove_at_time(OtioTrack* track, OtioRationalTime time,
-    int fill_with_gap, OtioError* err) {
-    OTIO_NULL_CHECK_ERR(track, err, -1, "Track is null");
+int otio_undo_journal_undo(OtioUndoJournal* journal, OtioError* err) {
+    return replay_journal_step(journal, false, err);
+}
+
+int otio_undo_journal_redo(OtioUndoJournal* journal, OtioError* err) {
+    return replay_journal_step(journal, true, err);
+}
+
+// ----------------------------------------------------------------------------
+// Cloning
+// ----------------------------------------------------------------------------
+
+static bool clone_mode_valid(int32_t mode, OtioError* err) {
+    if (mode == OTIO_CLONE_DEEP || mode == OTIO_CLONE_SHARED) return true;
+    set_error(err, 1, "Unknown clone mode");
+    return false;
+}
+
+OtioTimeline* otio_timeline_clone(OtioTimeline* tl, int32_t mode, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    if (!clone_mode_valid(mode, err)) return nullptr;
     try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        otio::ErrorStatus status;
-        otio::algo::remove(t, to_otio_rt(time), fill_with_gap != 0, nullptr, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return -1;
-        }
-        return 0;
+        ObjectCloner cloner{mode == OTIO_CLONE_SHARED};
+        auto copy = cloner.timeline(reinterpret_cast<otio::Timeline*>(tl));
+        return reinterpret_cast<OtioTimeline*>(copy.take_value());
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return -1;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return -1;
+        return nullptr;
     }
 }
 
+OtioTrack* otio_track_clone(OtioTrack* track, int32_t mode, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    if (!clone_mode_valid(mode, err)) return nullptr;
+    return reinterpret_cast<OtioTrack*>(clone_composable(reinterpret_cast<otio::Track*>(track), mode, err));
+}
+
+OtioStack* otio_stack_clone(OtioStack* stack, int32_t mode, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    if (!clone_mode_valid(mode, err)) return nullptr;
+    return reinterpret_cast<OtioStack*>(clone_composable(reinterpret_cast<otio::Stack*>(stack), mode, err));
+}
+
+OtioClip* otio_clip_clone(OtioClip* clip, int32_t mode, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(clip, err, nullptr, "Clip is null");
+    if (!clone_mode_valid(mode, err)) return nullptr;
+    return reinterpret_cast<OtioClip*>(clone_composable(reinterpret_cast<otio::Clip*>(clip), mode, err));
+}
+
 // ----------------------------------------------------------------------------
-// Time coordinate transforms
+// Render manifests
 // ----------------------------------------------------------------------------
 
-// Helper to cast void* to Item* based on type
-static otio::Item* cast_to_item(void* ptr, int32_t type) {
-    if (!ptr) return nullptr;
-    switch (type) {
-        case OTIO_CHILD_TYPE_CLIP:
-            return reinterpret_cast<otio::Clip*>(ptr);
-        case OTIO_CHILD_TYPE_GAP:
-            return reinterpret_cast<otio::Gap*>(ptr);
-        case OTIO_CHILD_TYPE_TRACK:
-            return reinterpret_cast<otio::Track*>(ptr);
-        case OTIO_CHILD_TYPE_STACK:
-            return reinterpret_cast<otio::Stack*>(ptr);
-        default:
-            return nullptr;
+struct OtioRenderManifest {
+    double rate = 0;
+    int64_t frame_count = 0;
+    std::vector<OtioManifestRun> runs;
+    std::vector<std::string> urls;
+    std::vector<OtioManifestTransition> transitions;
+};
+
+// A composition prepared for per-frame lookups. Child ranges are computed
+// once here; per frame, finding the item under a time is a binary search.
+struct ManifestComposition {
+    struct Child {
+        otio::Item* item;
+        otio::RationalTime start;          // Start in the composition's time
+        double start_seconds;
+        double end_seconds;
+        otio::RationalTime trimmed_start;  // The child's own time at `start`
+        std::unique_ptr<ManifestComposition> nested;
+    };
+    // A transition overlaps the items on either side of its cut; the other
+    // item is sampled past its own range, into its handles.
+    struct Window {
+        otio::Transition* transition;
+        double start_seconds;
+        double cut_seconds;
+        double end_seconds;
+        int32_t outgoing;  // Child indices, -1 if the transition is at an end
+        int32_t incoming;
+    };
+
+    bool is_stack = false;
+    std::vector<Child> children;
+    std::vector<Window> windows;
+};
+
+static otio::TimeRange checked_trimmed_range(otio::Item* item) {
+    otio::ErrorStatus status;
+    auto range = item->trimmed_range(&status);
+    if (otio::is_error(status)) throw std::runtime_error(status.full_description);
+    return range;
+}
+
+static std::unique_ptr<ManifestComposition> prepare_manifest_composition(otio::Composition* comp) {
+    auto prepared = std::make_unique<ManifestComposition>();
+    prepared->is_stack = object_type_of(comp) == OTIO_CHILD_TYPE_STACK;
+    otio::RationalTime position;
+    int32_t pending_window = -1;
+    for (auto& retainer : comp->children()) {
+        otio::Composable* child = retainer.value;
+        if (object_type_of(child) == OTIO_CHILD_TYPE_TRANSITION) {
+            // Transitions only blend neighbours in a track
+            if (prepared->is_stack) continue;
+            auto transition = static_cast<otio::Transition*>(child);
+            const int32_t before = static_cast<int32_t>(prepared->children.size()) - 1;
+            prepared->windows.push_back(ManifestComposition::Window{transition,
+                (position - transition->in_offset()).to_seconds(), position.to_seconds(),
+                (position + transition->out_offset()).to_seconds(), before, -1});
+            pending_window = static_cast<int32_t>(prepared->windows.size()) - 1;
+            continue;
+        }
+        auto item = counted_dynamic_cast<otio::Item*>(child);
+        if (!item) continue;
+        auto trimmed = checked_trimmed_range(item);
+        ManifestComposition::Child entry{item, prepared->is_stack ? otio::RationalTime() : position,
+            0, 0, trimmed.start_time(), nullptr};
+        entry.start_seconds = entry.start.to_seconds();
+        entry.end_seconds = (entry.start + trimmed.duration()).to_seconds();
+        if (auto nested = counted_dynamic_cast<otio::Composition*>(item)) {
+            entry.nested = prepare_manifest_composition(nested);
+        }
+        if (pending_window >= 0) {
+            prepared->windows[static_cast<size_t>(pending_window)].incoming =
+                static_cast<int32_t>(prepared->children.size());
+            pending_window = -1;
+        }
+        prepared->children.push_back(std::move(entry));
+        if (!prepared->is_stack) position = position + trimmed.duration();
     }
+    return prepared;
 }
 
-OtioRationalTime otio_item_transformed_time(void* item, int32_t item_type,
-    OtioRationalTime time, void* to_item, int32_t to_item_type, OtioError* err) {
-    OtioRationalTime zero = {0, 1};
-
-    otio::Item* from_item = cast_to_item(item, item_type);
-    otio::Item* target_item = cast_to_item(to_item, to_item_type);
+// What one frame shows on one layer
+struct ManifestSample {
+    otio::Clip* clip = nullptr;
+    double source = 0;       // Source time at source_rate
+    double source_rate = 0;
+    int32_t url = -1;
+    otio::Transition* transition = nullptr;
+};
 
-    if (!from_item) {
-        set_error(err, 1, "Source item is null or invalid type");
-        return zero;
-    }
-    if (!target_item) {
-        set_error(err, 1, "Target item is null or invalid type");
-        return zero;
+// Run-length encodes the samples of one layer: a run continues while the
+// clip and transition stay the same and both the source time and the URL
+// index advance by a constant step.
+struct ManifestRunEncoder {
+    std::vector<OtioManifestRun>& runs;
+    int32_t layer;
+    bool open = false;
+    OtioManifestRun run{};
+
+    bool extends(int64_t frame, const ManifestSample& s, int32_t transition) {
+        if (!open || run.frame_start + run.frame_count != frame) return false;
+        if (run.clip != reinterpret_cast<OtioClip*>(s.clip) || run.transition != transition ||
+            run.source_rate != s.source_rate) {
+            return false;
+        }
+        if ((run.url_index < 0) != (s.url < 0)) return false;
+        const double k = static_cast<double>(run.frame_count);
+        if (run.frame_count == 1) {
+            run.source_step = s.source - run.source_start;
+            run.url_step = s.url < 0 ? 0 : s.url - run.url_index;
+            return true;
+        }
+        const double expected = run.source_start + k * run.source_step;
+        if (std::abs(s.source - expected) > 1e-9 * std::max(1.0, std::abs(expected))) return false;
+        return s.url < 0 || s.url == run.url_index + static_cast<int32_t>(k) * run.url_step;
     }
 
-    try {
-        otio::ErrorStatus status;
-        auto result = from_item->transformed_time(to_otio_rt(time), target_item, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return zero;
+    void add(int64_t frame, const ManifestSample& s, int32_t transition) {
+        if (extends(frame, s, transition)) {
+            ++run.frame_count;
+            return;
         }
-        return OtioRationalTime{result.value(), result.rate()};
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return zero;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return zero;
+        close();
+        run = OtioManifestRun{frame, 1, reinterpret_cast<OtioClip*>(s.clip), s.source, 0,
+            s.source_rate, s.url, 0, transition, layer};
+        open = true;
     }
-}
 
-OtioTimeRange otio_item_transformed_time_range(void* item, int32_t item_type,
-    OtioTimeRange range, void* to_item, int32_t to_item_type, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
+    void close() {
+        if (open) runs.push_back(run);
+        open = false;
+    }
+};
 
-    otio::Item* from_item = cast_to_item(item, item_type);
-    otio::Item* target_item = cast_to_item(to_item, to_item_type);
+struct ManifestBuilder {
+    OtioRenderManifest& manifest;
+    std::unordered_map<std::string, int32_t> url_index;
+    std::unordered_map<otio::Clip*, int32_t> file_urls;  // Clips with one URL for every frame
+    std::unordered_map<otio::Transition*, int32_t> transition_index;
 
-    if (!from_item) {
-        set_error(err, 1, "Source item is null or invalid type");
-        return zero;
+    int32_t intern(const std::string& url) {
+        auto found = url_index.emplace(url, static_cast<int32_t>(manifest.urls.size()));
+        if (found.second) manifest.urls.push_back(url);
+        return found.first->second;
     }
-    if (!target_item) {
-        set_error(err, 1, "Target item is null or invalid type");
-        return zero;
+
+    int32_t transition_at(otio::Transition* transition, int64_t frame) {
+        if (!transition) return -1;
+        auto found = transition_index.emplace(transition,
+            static_cast<int32_t>(manifest.transitions.size()));
+        if (found.second) {
+            manifest.transitions.push_back(
+                OtioManifestTransition{frame, 0, reinterpret_cast<OtioTransition*>(transition)});
+        }
+        auto& entry = manifest.transitions[static_cast<size_t>(found.first->second)];
+        entry.frame_count = std::max(entry.frame_count, frame - entry.frame_start + 1);
+        return found.first->second;
     }
 
-    try {
-        otio::ErrorStatus status;
-        auto result = from_item->transformed_time_range(to_otio_tr(range), target_item, &status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return zero;
+    int32_t url_of(otio::Clip* clip, double source, double rate) {
+        auto ref = clip->media_reference();
+        if (auto sequence = counted_dynamic_cast<otio::ImageSequenceReference*>(ref)) {
+            otio::ErrorStatus status;
+            int frame = sequence->frame_for_time(otio::RationalTime(source, rate), &status);
+            if (otio::is_error(status) || sequence->frame_step() == 0) return -1;
+            int image = (frame - sequence->start_frame()) / sequence->frame_step();
+            auto url = sequence->target_url_for_image_number(image, &status);
+            return otio::is_error(status) ? -1 : intern(url);
+        }
+        auto cached = file_urls.find(clip);
+        if (cached != file_urls.end()) return cached->second;
+        int32_t index = -1;
+        if (auto external = counted_dynamic_cast<otio::ExternalReference*>(ref)) {
+            index = intern(external->target_url());
+        }
+        file_urls.emplace(clip, index);
+        return index;
+    }
+
+    // `local` is in the clip's own time. Linear time warps scale the offset
+    // from the start of the clip's source range; a freeze frame is a warp
+    // by zero.
+    void sample_clip(otio::Clip* clip, otio::RationalTime trimmed_start, otio::RationalTime local,
+        ManifestSample& out) {
+        double scalar = 1;
+        for (const auto& effect : clip->effects()) {
+            if (auto warp = counted_dynamic_cast<otio::LinearTimeWarp*>(effect.value)) {
+                scalar *= warp->time_scalar();
+            }
+        }
+        const double rate = trimmed_start.rate();
+        out.clip = clip;
+        out.source_rate = rate;
+        out.source = trimmed_start.value() + (local - trimmed_start).value_rescaled_to(rate) * scalar;
+        out.url = url_of(clip, out.source, rate);
+    }
+
+    // `time` is in the composition's time, and may lie past the child's own
+    // range when sampling the far side of a transition
+    void sample_child(const ManifestComposition::Child& child, otio::RationalTime time,
+        ManifestSample& primary, ManifestSample& overlay) {
+        if (!child.item->enabled()) return;
+        auto local = time - child.start + child.trimmed_start;
+        if (child.nested) {
+            sample_composition(*child.nested, local, primary, overlay);
+        } else if (object_type_of(child.item) == OTIO_CHILD_TYPE_CLIP) {
+            sample_clip(static_cast<otio::Clip*>(child.item), child.trimmed_start, local, primary);
+        }
+    }
+
+    void sample_composition(const ManifestComposition& comp, otio::RationalTime time,
+        ManifestSample& primary, ManifestSample& overlay) {
+        const double seconds = time.to_seconds();
+        if (comp.is_stack) {
+            // The topmost child showing something wins
+            for (auto it = comp.children.rbegin(); it != comp.children.rend(); ++it) {
+                if (seconds < it->start_seconds || seconds >= it->end_seconds) continue;
+                ManifestSample p, o;
+                sample_child(*it, time, p, o);
+                if (p.clip || p.transition) {
+                    primary = p;
+                    overlay = o;
+                    return;
+                }
+            }
+            return;
+        }
+
+        auto past = std::upper_bound(comp.children.begin(), comp.children.end(), seconds,
+            [](double s, const ManifestComposition::Child& c) { return s < c.start_seconds; });
+        if (past != comp.children.begin() && seconds < std::prev(past)->end_seconds) {
+            sample_child(*std::prev(past), time, primary, overlay);
+        }
+        // Windows follow the order of their cuts and do not overlap, so the
+        // last one starting at or before `time` is the only candidate
+        auto next = std::upper_bound(comp.windows.begin(), comp.windows.end(), seconds,
+            [](double s, const ManifestComposition::Window& w) { return s < w.start_seconds; });
+        if (next == comp.windows.begin()) return;
+        const auto& window = *std::prev(next);
+        if (seconds >= window.end_seconds) return;
+        primary.transition = window.transition;
+        overlay = ManifestSample();
+        overlay.transition = window.transition;
+        const int32_t other = seconds < window.cut_seconds ? window.incoming : window.outgoing;
+        if (other >= 0) {
+            ManifestSample ignored;
+            sample_child(comp.children[static_cast<size_t>(other)], time, overlay, ignored);
+            overlay.transition = window.transition;
         }
-        return OtioTimeRange{
-            OtioRationalTime{result.start_time().value(), result.start_time().rate()},
-            OtioRationalTime{result.duration().value(), result.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return zero;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return zero;
     }
-}
+};
 
-OtioTimeRange otio_clip_range_in_parent(OtioClip* clip, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!clip) {
-        set_error(err, 1, "Clip is null");
-        return zero;
+// A parallel build samples every lane (each child of a stack, or a track
+// as a whole) in chunks of frames on the worker pool, a block of frames at
+// a time, then picks the visible lane per frame and encodes the runs on the
+// calling thread. Each chunk interns URLs into its own table, remapped when
+// merged, so the manifest is identical to a serial build's.
+constexpr int64_t kManifestBlockFrames = 8192;
+constexpr int64_t kManifestChunkFrames = 512;
+
+struct ManifestChunk {
+    OtioRenderManifest local;    // Only its URL table is used
+    std::vector<int32_t> remap;  // Local URL index -> manifest URL index
+    ManifestSample primary[kManifestChunkFrames];
+    ManifestSample overlay[kManifestChunkFrames];
+};
+
+// Workers only read the graph: prepared child ranges, effects, media
+// references and their fields. None of that changes or retains objects.
+static void sample_manifest_block(const ManifestComposition& prepared, const otio::TimeRange& tr,
+    int64_t first, int64_t last, int32_t thread_count, std::vector<std::unique_ptr<ManifestChunk>>& chunks) {
+    const size_t lanes = prepared.is_stack ? prepared.children.size() : 1;
+    const size_t per_lane = static_cast<size_t>((last - first + kManifestChunkFrames - 1) / kManifestChunkFrames);
+    chunks.resize(lanes * per_lane);
+    for (auto& chunk : chunks) {
+        if (!chunk) chunk = std::make_unique<ManifestChunk>();
+        chunk->local.urls.clear();
+        chunk->remap.clear();
     }
-    try {
-        auto c = reinterpret_cast<otio::Clip*>(clip);
-        otio::ErrorStatus status;
-        auto range = c->range_in_parent(&status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return zero;
+
+    std::mutex failure_mutex;
+    std::string failure;
+    parallel_for(chunks.size(), thread_count, [&](size_t task) {
+        ManifestChunk& chunk = *chunks[task];
+        const size_t lane = task / per_lane;
+        const int64_t begin = first + static_cast<int64_t>(task % per_lane) * kManifestChunkFrames;
+        const int64_t end = std::min(begin + kManifestChunkFrames, last);
+        ManifestBuilder builder{chunk.local, {}, {}, {}};
+        try {
+            for (int64_t i = begin; i < end; ++i) {
+                auto& primary = chunk.primary[i - begin];
+                auto& overlay = chunk.overlay[i - begin];
+                primary = overlay = ManifestSample();
+                otio::RationalTime time(tr.start_time().value() + static_cast<double>(i),
+                    tr.start_time().rate());
+                if (!prepared.is_stack) {
+                    builder.sample_composition(prepared, time, primary, overlay);
+                    continue;
+                }
+                const auto& child = prepared.children[lane];
+                const double seconds = time.to_seconds();
+                if (seconds >= child.start_seconds && seconds < child.end_seconds) {
+                    builder.sample_child(child, time, primary, overlay);
+                }
+            }
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (failure.empty()) failure = e.what();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (failure.empty()) failure = "Unknown exception";
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
-        };
-    } catch (const std::exception& e) {
-        set_error(err, 1, e.what());
-        return zero;
-    } catch (...) {
-        set_error(err, 1, "Unknown exception");
-        return zero;
-    }
+    });
+    if (!failure.empty()) throw std::runtime_error(failure);
 }
 
-OtioTimeRange otio_gap_range_in_parent(OtioGap* gap, OtioError* err) {
-    OtioTimeRange zero = {OtioRationalTime{0, 1}, OtioRationalTime{0, 1}};
-    if (!gap) {
-        set_error(err, 1, "Gap is null");
-        return zero;
-    }
+static OtioRenderManifest* build_render_manifest(otio::Composition* comp, OtioTimeRange range,
+    int32_t thread_count, OtioError* err) {
     try {
-        auto g = reinterpret_cast<otio::Gap*>(gap);
-        otio::ErrorStatus status;
-        auto range = g->range_in_parent(&status);
-        if (otio::is_error(status)) {
-            set_error(err, 1, status.full_description.c_str());
-            return zero;
+        auto tr = to_otio_tr(range);
+        const double rate = tr.start_time().rate();
+        if (!(rate > 0)) {
+            set_error(err, 1, "Range has no frame rate");
+            return nullptr;
         }
-        return OtioTimeRange{
-            OtioRationalTime{range.start_time().value(), range.start_time().rate()},
-            OtioRationalTime{range.duration().value(), range.duration().rate()}
+        const double frames = std::round(tr.duration().value_rescaled_to(rate));
+        if (!(frames >= 0) || frames > static_cast<double>(std::numeric_limits<int32_t>::max())) {
+            set_error(err, 1, "Range duration is out of bounds");
+            return nullptr;
+        }
+
+        auto prepared = prepare_manifest_composition(comp);
+        auto manifest = std::make_unique<OtioRenderManifest>();
+        manifest->rate = rate;
+        manifest->frame_count = static_cast<int64_t>(frames);
+
+        ManifestBuilder builder{*manifest, {}, {}, {}};
+        std::vector<OtioManifestRun> overlays;
+        ManifestRunEncoder layer0{manifest->runs, 0};
+        ManifestRunEncoder layer1{overlays, 1};
+        auto encode = [&](int64_t i, const ManifestSample& primary, const ManifestSample& overlay) {
+            const int32_t transition = builder.transition_at(primary.transition, i);
+            layer0.add(i, primary, transition);
+            if (overlay.transition) layer1.add(i, overlay, transition);
         };
+
+        if (worker_count(thread_count) <= 1) {
+            for (int64_t i = 0; i < manifest->frame_count; ++i) {
+                ManifestSample primary, overlay;
+                otio::RationalTime time(tr.start_time().value() + static_cast<double>(i), rate);
+                builder.sample_composition(*prepared, time, primary, overlay);
+                encode(i, primary, overlay);
+            }
+        } else {
+            const size_t lanes = prepared->is_stack ? prepared->children.size() : 1;
+            std::vector<std::unique_ptr<ManifestChunk>> chunks;
+            for (int64_t first = 0; first < manifest->frame_count; first += kManifestBlockFrames) {
+                const int64_t last = std::min(first + kManifestBlockFrames, manifest->frame_count);
+                sample_manifest_block(*prepared, tr, first, last, thread_count, chunks);
+                const size_t per_lane = chunks.size() / std::max<size_t>(lanes, 1);
+                auto global_url = [&](ManifestChunk& chunk, int32_t url) {
+                    if (url < 0) return url;
+                    chunk.remap.resize(chunk.local.urls.size(), -1);
+                    auto& mapped = chunk.remap[static_cast<size_t>(url)];
+                    if (mapped < 0) mapped = builder.intern(chunk.local.urls[static_cast<size_t>(url)]);
+                    return mapped;
+                };
+                for (int64_t i = first; i < last; ++i) {
+                    const size_t chunk_index = static_cast<size_t>((i - first) / kManifestChunkFrames);
+                    const size_t offset = static_cast<size_t>((i - first) % kManifestChunkFrames);
+                    ManifestSample primary, overlay;
+                    // The topmost lane showing something wins, as in sample_composition()
+                    for (size_t lane = lanes; lane-- > 0;) {
+                        ManifestChunk& chunk = *chunks[lane * per_lane + chunk_index];
+                        const ManifestSample& candidate = chunk.primary[offset];
+                        if (prepared->is_stack && !candidate.clip && !candidate.transition) continue;
+                        primary = candidate;
+                        overlay = chunk.overlay[offset];
+                        primary.url = global_url(chunk, primary.url);
+                        overlay.url = global_url(chunk, overlay.url);
+                        break;
+                    }
+                    encode(i, primary, overlay);
+                }
+            }
+        }
+        layer0.close();
+        layer1.close();
+
+        // Overlay runs go after the primary run that starts with them
+        auto& runs = manifest->runs;
+        runs.insert(runs.end(), overlays.begin(), overlays.end());
+        std::stable_sort(runs.begin(), runs.end(),
+            [](const OtioManifestRun& a, const OtioManifestRun& b) { return a.frame_start < b.frame_start; });
+        return manifest.release();
     } catch (const std::exception& e) {
         set_error(err, 1, e.what());
-        return zero;
+        return nullptr;
     } catch (...) {
         set_error(err, 1, "Unknown exception");
-        return zero;
+        return nullptr;
     }
 }
 
-// ----------------------------------------------------------------------------
-// Parent navigation
-// ----------------------------------------------------------------------------
+OtioRenderManifest* otio_track_build_render_manifest(OtioTrack* track, OtioTimeRange range,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    return build_render_manifest(reinterpret_cast<otio::Track*>(track), range, 1, err);
+}
 
-int32_t otio_clip_get_parent_type(OtioClip* clip) {
-    return get_parent_type_impl(reinterpret_cast<otio::Clip*>(clip));
+OtioRenderManifest* otio_stack_build_render_manifest(OtioStack* stack, OtioTimeRange range,
+    OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    return build_render_manifest(reinterpret_cast<otio::Stack*>(stack), range, 1, err);
 }
 
-void* otio_clip_get_parent(OtioClip* clip) {
-    return get_parent_impl(reinterpret_cast<otio::Clip*>(clip));
+OtioRenderManifest* otio_track_build_render_manifest_parallel(OtioTrack* track, OtioTimeRange range,
+    int32_t thread_count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(track, err, nullptr, "Track is null");
+    return build_render_manifest(reinterpret_cast<otio::Track*>(track), range, thread_count, err);
 }
 
-int32_t otio_gap_get_parent_type(OtioGap* gap) {
-    return get_parent_type_impl(reinterpret_cast<otio::Gap*>(gap));
+OtioRenderManifest* otio_stack_build_render_manifest_parallel(OtioStack* stack, OtioTimeRange range,
+    int32_t thread_count, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(stack, err, nullptr, "Stack is null");
+    return build_render_manifest(reinterpret_cast<otio::Stack*>(stack), range, thread_count, err);
 }
 
-void* otio_gap_get_parent(OtioGap* gap) {
-    return get_parent_impl(reinterpret_cast<otio::Gap*>(gap));
+void otio_render_manifest_free(OtioRenderManifest* manifest) {
+    delete manifest;
 }
 
-int32_t otio_transition_get_parent_type(OtioTransition* transition) {
-    return get_parent_type_impl(reinterpret_cast<otio::Transition*>(transition));
+double otio_render_manifest_rate(OtioRenderManifest* manifest) {
+    return manifest ? manifest->rate : 0;
 }
 
-void* otio_transition_get_parent(OtioTransition* transition) {
-    return get_parent_impl(reinterpret_cast<otio::Transition*>(transition));
+int64_t otio_render_manifest_frame_count(OtioRenderManifest* manifest) {
+    return manifest ? manifest->frame_count : 0;
 }
 
-int32_t otio_track_get_parent_type(OtioTrack* track) {
-    return get_parent_type_impl(reinterpret_cast<otio::Track*>(track));
+int32_t otio_render_manifest_runs(OtioRenderManifest* manifest, OtioManifestRun* runs, int32_t capacity) {
+    if (!manifest) return 0;
+    const size_t limit = runs && capacity > 0 ? static_cast<size_t>(capacity) : 0;
+    std::copy_n(manifest->runs.begin(), std::min(limit, manifest->runs.size()), runs);
+    return static_cast<int32_t>(manifest->runs.size());
 }
 
-void* otio_track_get_parent(OtioTrack* track) {
-    return get_parent_impl(reinterpret_cast<otio::Track*>(track));
+int32_t otio_render_manifest_transitions(OtioRenderManifest* manifest,
+    OtioManifestTransition* transitions, int32_t capacity) {
+    if (!manifest) return 0;
+    const size_t limit = transitions && capacity > 0 ? static_cast<size_t>(capacity) : 0;
+    std::copy_n(manifest->transitions.begin(), std::min(limit, manifest->transitions.size()),
+        transitions);
+    return static_cast<int32_t>(manifest->transitions.size());
 }
 
-int32_t otio_stack_get_parent_type(OtioStack* stack) {
-    return get_parent_type_impl(reinterpret_cast<otio::Stack*>(stack));
+int32_t otio_render_manifest_url_count(OtioRenderManifest* manifest) {
+    return manifest ? static_cast<int32_t>(manifest->urls.size()) : 0;
 }
 
-void* otio_stack_get_parent(OtioStack* stack) {
-    return get_parent_impl(reinterpret_cast<otio::Stack*>(stack));
+OtioStringView otio_render_manifest_url(OtioRenderManifest* manifest, int32_t index) {
+    if (!manifest || index < 0 || static_cast<size_t>(index) >= manifest->urls.size()) {
+        return OtioStringView{nullptr, 0};
+    }
+    const auto& url = manifest->urls[static_cast<size_t>(index)];
+    return OtioStringView{url.data(), url.size()};
 }
 
 // ----------------------------------------------------------------------------
-// Track Iterator (filtered track lists)
+// Fingerprints
 // ----------------------------------------------------------------------------
 
-struct OtioTrackIterator {
-    std::vector<otio::Track*> tracks;
-    size_t index;
+// Objects of schemas without a case below are fingerprinted from their JSON
+static void fingerprint_json(Fingerprint& fp, otio::SerializableObject* obj) {
+    if (!obj) return fp.word(0);
+    OTIO_STATS_SCOPE(OTIO_STAT_SERIALIZE);
+    otio::ErrorStatus status;
+    std::string json = obj->to_json_string(&status, nullptr, 0);
+    OTIO_STATS_BYTES(OTIO_STAT_SERIALIZE, json.size());
+    if (otio::is_error(status)) {
+        throw std::runtime_error("Cannot fingerprint " + obj->schema_name() + ": " + status.full_description);
+    }
+    fp.text(json);
+}
+
+static void fingerprint_dict(Fingerprint& fp, const otio::AnyDictionary& dict);
+
+// Values of the same metadata kind hash alike whatever their C++ type, as
+// in the metadata encoding
+static void fingerprint_value(Fingerprint& fp, const std::any& value) {
+    const int32_t kind = metadata_kind_of(value);
+    fp.word(static_cast<uint64_t>(kind));
+    switch (kind) {
+        case OTIO_METADATA_BOOL:
+            fp.word(std::any_cast<bool>(value) ? 1 : 0);
+            break;
+        case OTIO_METADATA_INT: {
+            int64_t i = 0;
+            metadata_int_of(value, &i);
+            fp.word(static_cast<uint64_t>(i));
+            break;
+        }
+        case OTIO_METADATA_DOUBLE: {
+            double d = 0;
+            metadata_double_of(value, &d);
+            fp.number(d);
+            break;
+        }
+        case OTIO_METADATA_STRING:
+            fp.text(std::any_cast<const std::string&>(value));
+            break;
+        case OTIO_METADATA_DICT:
+            fingerprint_dict(fp, std::any_cast<const otio::AnyDictionary&>(value));
+            break;
+        case OTIO_METADATA_ARRAY: {
+            auto& array = std::any_cast<const otio::AnyVector&>(value);
+            fp.word(array.size());
+            for (const auto& element : array) fingerprint_value(fp, element);
+            break;
+        }
+        case OTIO_METADATA_OTHER: {
+            const auto& type = value.type();
+            fp.text(metadata_other_name(value));
+            if (type == typeid(otio::RationalTime)) {
+                fp.time(std::any_cast<const otio::RationalTime&>(value));
+            } else if (type == typeid(otio::TimeRange)) {
+                fp.span(std::any_cast<const otio::TimeRange&>(value));
+            } else if (type == typeid(otio::TimeTransform)) {
+                auto& transform = std::any_cast<const otio::TimeTransform&>(value);
+                fp.time(transform.offset());
+                fp.number(transform.scale());
+                fp.number(transform.rate());
+            } else if (type == typeid(otio::SerializableObject::Retainer<>)) {
+                fingerprint_json(fp, std::any_cast<const otio::SerializableObject::Retainer<>&>(value).value);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
 
-    OtioTrackIterator() : index(0) {}
-};
+static void fingerprint_dict(Fingerprint& fp, const otio::AnyDictionary& dict) {
+    fp.word(dict.size());
+    for (const auto& entry : dict) {
+        fp.text(entry.first);
+        fingerprint_value(fp, entry.second);
+    }
+}
 
-OtioTrackIterator* otio_timeline_video_tracks(OtioTimeline* tl) {
-    if (!tl) return nullptr;
-    try {
-        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
-        auto iter = new OtioTrackIterator();
-        for (auto* track : timeline->video_tracks()) {
-            iter->tracks.push_back(track);
+static void fingerprint_media_reference(Fingerprint& fp, otio::MediaReference* ref) {
+    if (!ref) return fp.word(0);
+    const int32_t type = object_type_of(ref);
+    switch (type) {
+        case OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE:
+            fp.text(static_cast<otio::ExternalReference*>(ref)->target_url());
+            break;
+        case OTIO_OBJECT_TYPE_MISSING_REFERENCE:
+            break;
+        case OTIO_OBJECT_TYPE_GENERATOR_REFERENCE: {
+            auto generator = static_cast<otio::GeneratorReference*>(ref);
+            fp.text(generator->generator_kind());
+            fingerprint_dict(fp, generator->parameters());
+            break;
         }
-        return iter;
-    } catch (...) {
-        return nullptr;
+        case OTIO_OBJECT_TYPE_IMAGE_SEQUENCE_REFERENCE: {
+            auto sequence = static_cast<otio::ImageSequenceReference*>(ref);
+            fp.text(sequence->target_url_base());
+            fp.text(sequence->name_prefix());
+            fp.text(sequence->name_suffix());
+            fp.word(static_cast<uint64_t>(sequence->start_frame()));
+            fp.word(static_cast<uint64_t>(sequence->frame_step()));
+            fp.number(sequence->rate());
+            fp.word(static_cast<uint64_t>(sequence->frame_zero_padding()));
+            fp.word(static_cast<uint64_t>(sequence->missing_frame_policy()));
+            break;
+        }
+        default:
+            return fingerprint_json(fp, ref);
     }
+    fp.word(static_cast<uint64_t>(type));
+    fp.text(ref->name());
+    fp.span(ref->available_range());
+    auto bounds = ref->available_image_bounds();
+    fp.word(bounds ? 1 : 0);
+    if (bounds) {
+        fp.number(bounds->min.x);
+        fp.number(bounds->min.y);
+        fp.number(bounds->max.x);
+        fp.number(bounds->max.y);
+    }
+    fingerprint_dict(fp, ref->metadata());
+    fingerprint_dict(fp, ref->dynamic_fields());
 }
 
-OtioTrackIterator* otio_timeline_audio_tracks(OtioTimeline* tl) {
-    if (!tl) return nullptr;
-    try {
-        auto timeline = reinterpret_cast<otio::Timeline*>(tl);
-        auto iter = new OtioTrackIterator();
-        for (auto* track : timeline->audio_tracks()) {
-            iter->tracks.push_back(track);
+// Markers and effects
+static void fingerprint_attachment(Fingerprint& fp, otio::SerializableObjectWithMetadata* obj) {
+    const int32_t type = object_type_of(obj);
+    switch (type) {
+        case OTIO_OBJECT_TYPE_MARKER: {
+            auto marker = static_cast<otio::Marker*>(obj);
+            fp.span(marker->marked_range());
+            fp.text(marker->color());
+            fp.text(marker->comment());
+            break;
         }
-        return iter;
-    } catch (...) {
-        return nullptr;
+        case OTIO_OBJECT_TYPE_EFFECT:
+            fp.text(static_cast<otio::Effect*>(obj)->effect_name());
+            break;
+        case OTIO_OBJECT_TYPE_LINEAR_TIME_WARP:
+        case OTIO_OBJECT_TYPE_FREEZE_FRAME: {
+            auto warp = static_cast<otio::LinearTimeWarp*>(obj);
+            fp.text(warp->effect_name());
+            fp.number(warp->time_scalar());
+            break;
+        }
+        default:
+            return fingerprint_json(fp, obj);
     }
-}
+    fp.word(static_cast<uint64_t>(type));
+    fp.text(obj->name());
+    fingerprint_dict(fp, obj->metadata());
+    fingerprint_dict(fp, obj->dynamic_fields());
+}
+
+static void fingerprint_item_fields(Fingerprint& fp, otio::Item* item) {
+    fp.word(item->enabled() ? 1 : 0);
+    fp.word(item->effects().size());
+    for (const auto& effect : item->effects()) fingerprint_attachment(fp, effect.value);
+    fp.word(item->markers().size());
+    for (const auto& marker : item->markers()) fingerprint_attachment(fp, marker.value);
+}
+
+// The parts of a composable's fingerprint, kept apart so that a diff can
+// tell what changed about an item it matched
+struct ItemFingerprint {
+    uint64_t name = 0;
+    uint64_t range = 0;
+    uint64_t media = 0;
+    uint64_t metadata = 0;
+    uint64_t fields = 0;
+    uint64_t identity = 0;  // Schema and name
+    uint64_t body = 0;      // Everything but the name, children included
+    uint64_t subtree = 0;   // Everything
+};
 
-int32_t otio_track_iterator_count(OtioTrackIterator* iter) {
-    if (!iter) return 0;
-    return static_cast<int32_t>(iter->tracks.size());
+// The part edit algorithms change in place, checked before a memoized
+// fingerprint is used
+static uint64_t fingerprint_range(otio::Composable* item, int32_t type) {
+    return digest_of([&](Fingerprint& fp) {
+        if (type == OTIO_CHILD_TYPE_TRANSITION) {
+            auto transition = static_cast<otio::Transition*>(item);
+            fp.time(transition->in_offset());
+            fp.time(transition->out_offset());
+        } else if (type >= 0) {
+            fp.span(static_cast<otio::Item*>(item)->source_range());
+        }
+    });
+}
+
+// children is the digest of the children's subtree fingerprints in order,
+// 0 for anything but a track or stack
+static ItemFingerprint fingerprint_item(otio::Composable* item, int32_t type, uint64_t children) {
+    ItemFingerprint print;
+    print.name = digest_of([&](Fingerprint& fp) { fp.text(item->name()); });
+    print.metadata = digest_of([&](Fingerprint& fp) { fingerprint_dict(fp, item->metadata()); });
+    print.range = fingerprint_range(item, type);
+    print.media = digest_of([&](Fingerprint& fp) {
+        if (type != OTIO_CHILD_TYPE_CLIP) return;
+        auto clip = static_cast<otio::Clip*>(item);
+        fp.text(clip->active_media_reference_key());
+        const auto references = clip->media_references();
+        fp.word(references.size());
+        for (const auto& entry : references) {
+            fp.text(entry.first);
+            fingerprint_media_reference(fp, entry.second);
+        }
+    });
+    print.fields = digest_of([&](Fingerprint& fp) {
+        fingerprint_dict(fp, item->dynamic_fields());
+        if (type < 0) {
+            fingerprint_json(fp, item);
+        } else if (type == OTIO_CHILD_TYPE_TRANSITION) {
+            fp.text(static_cast<otio::Transition*>(item)->transition_type());
+        } else {
+            fingerprint_item_fields(fp, static_cast<otio::Item*>(item));
+            if (type == OTIO_CHILD_TYPE_TRACK) fp.text(static_cast<otio::Track*>(item)->kind());
+        }
+    });
+    print.identity = digest_of([&](Fingerprint& fp) {
+        fp.word(static_cast<uint64_t>(type));
+        fp.text(type < 0 ? item->schema_name() : std::string());
+        fp.word(print.name);
+    });
+    print.body = digest_of([&](Fingerprint& fp) {
+        fp.word(static_cast<uint64_t>(type));
+        fp.word(print.range);
+        fp.word(print.media);
+        fp.word(print.metadata);
+        fp.word(print.fields);
+        fp.word(children);
+    });
+    print.subtree = digest_of([&](Fingerprint& fp) {
+        fp.word(print.body);
+        fp.word(print.name);
+    });
+    return print;
+}
+
+// Subtree fingerprints, memoized in cache when there is one (its lock
+// held). A memoized fingerprint is used if the item's range is unchanged:
+// edit algorithms retime children in place and only report their parent.
+// A composition with forgotten children rehashes just those children and
+// its own fields, so an edit costs in proportion to its depth.
+struct FingerprintWalker {
+    OtioFingerprintCache* cache;
+
+    uint64_t subtree(otio::Composable* item) {
+        const int32_t type = object_type_of(item);
+        if (cache) {
+            auto it = cache->memo.find(item);
+            if (it != cache->memo.end() && it->second.range == fingerprint_range(item, type)) {
+                auto& entry = it->second;
+                if (entry.dirty.empty()) {
+                    ++cache->hits;
+                    return entry.subtree;
+                }
+                ++cache->misses;
+                if (update_children(static_cast<otio::Composition*>(item), entry)) {
+                    entry.subtree = fingerprint_item(item, type, entry.children.digest()).subtree;
+                    return entry.subtree;
+                }
+            } else {
+                ++cache->misses;
+            }
+        }
+        OtioFingerprintCache::Entry entry;
+        uint64_t children = 0;
+        if (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+            const auto& list = static_cast<otio::Composition*>(item)->children();
+            if (cache) {
+                entry.child_prints.reserve(list.size());
+                entry.positions.reserve(list.size());
+            }
+            for (size_t i = 0; i < list.size(); ++i) {
+                const uint64_t print = subtree(list[i].value);
+                entry.children.add(print);
+                if (cache) {
+                    entry.child_prints.push_back(print);
+                    entry.positions.emplace(list[i].value, i);
+                }
+            }
+            children = entry.children.digest();
+        }
+        const ItemFingerprint print = fingerprint_item(item, type, children);
+        if (cache) {
+            entry.item = Retainer<otio::Composable>(item);
+            entry.subtree = print.subtree;
+            entry.range = print.range;
+            cache->memo[item] = std::move(entry);
+        }
+        return print.subtree;
+    }
+
+    // Rehash the forgotten children of a memoized composition into its
+    // digest; false if its children no longer match the entry
+    bool update_children(otio::Composition* comp, OtioFingerprintCache::Entry& entry) {
+        const auto& list = comp->children();
+        if (list.size() != entry.child_prints.size()) return false;
+        for (const otio::Composable* child : entry.dirty) {
+            auto found = entry.positions.find(child);
+            if (found == entry.positions.end() || list[found->second].value != child) return false;
+        }
+        for (const otio::Composable* child : entry.dirty) {
+            const size_t at = entry.positions.find(child)->second;
+            const uint64_t print = subtree(list[at].value);
+            entry.children.replace(at, entry.child_prints[at], print);
+            entry.child_prints[at] = print;
+        }
+        entry.dirty.clear();
+        return true;
+    }
+
+    uint64_t timeline(otio::Timeline* tl) {
+        return digest_of([&](Fingerprint& fp) {
+            fp.word(OTIO_OBJECT_TYPE_TIMELINE);
+            fp.text(tl->name());
+            auto start = tl->global_start_time();
+            fp.word(start ? 1 : 0);
+            if (start) fp.time(*start);
+            fingerprint_dict(fp, tl->metadata());
+            fingerprint_dict(fp, tl->dynamic_fields());
+            fp.word(tl->tracks() ? subtree(tl->tracks()) : 0);
+        });
+    }
+};
+
+// The cache of the timeline whose tracks are (or hold) obj, locked; null
+// without one
+static std::unique_lock<std::mutex> lock_fingerprint_cache(otio::Composable* obj, OtioFingerprintCache** cache) {
+    *cache = nullptr;
+    auto& registry = fingerprint_registry();
+    if (registry.active.load(std::memory_order_relaxed) == 0) return {};
+    otio::Composable* top = obj;
+    while (otio::Composition* parent = top->parent()) top = parent;
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.caches.find(top);
+    if (it == registry.caches.end()) return {};
+    *cache = it->second;
+    return std::unique_lock<std::mutex>(it->second->mutex);
+}
+
+int otio_object_fingerprint(void* obj, uint64_t* out, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(obj, err, -1, "Object is null");
+    OTIO_NULL_CHECK_ERR(out, err, -1, "Output is null");
+    OTIO_TRY_INT(err,
+        auto so = static_cast<otio::SerializableObject*>(obj);
+        const int32_t type = object_type_of(so);
+        auto composable = type >= 0 && type < OTIO_OBJECT_TYPE_TIMELINE ? static_cast<otio::Composable*>(so)
+            : type < 0 ? counted_dynamic_cast<otio::Composable*>(so) : nullptr;
+        OtioFingerprintCache* cache = nullptr;
+        if (composable) {
+            auto lock = lock_fingerprint_cache(composable, &cache);
+            if (cache) cache->compact();
+            *out = FingerprintWalker{cache}.subtree(composable);
+        } else if (type == OTIO_OBJECT_TYPE_TIMELINE) {
+            auto tl = static_cast<otio::Timeline*>(so);
+            std::unique_lock<std::mutex> lock;
+            if (tl->tracks()) lock = lock_fingerprint_cache(tl->tracks(), &cache);
+            if (cache) cache->compact();
+            *out = FingerprintWalker{cache}.timeline(tl);
+        } else if (type >= OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE) {
+            *out = digest_of([&](Fingerprint& fp) {
+                fingerprint_media_reference(fp, static_cast<otio::MediaReference*>(so));
+            });
+        } else if (type >= 0) {
+            *out = digest_of([&](Fingerprint& fp) {
+                fingerprint_attachment(fp, static_cast<otio::SerializableObjectWithMetadata*>(so));
+            });
+        } else {
+            *out = digest_of([&](Fingerprint& fp) { fingerprint_json(fp, so); });
+        }
+    )
 }
 
-OtioTrack* otio_track_iterator_next(OtioTrackIterator* iter) {
-    if (!iter || iter->index >= iter->tracks.size()) return nullptr;
-    return reinterpret_cast<OtioTrack*>(iter->tracks[iter->index++]);
+OtioFingerprintCache* otio_timeline_enable_fingerprint_cache(OtioTimeline* tl, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(tl, err, nullptr, "Timeline is null");
+    auto timeline = reinterpret_cast<otio::Timeline*>(tl);
+    OTIO_NULL_CHECK_ERR(timeline->tracks(), err, nullptr, "Timeline has no tracks");
+    auto& registry = fingerprint_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (registry.caches.count(timeline->tracks()) != 0) {
+        set_error(err, 1, "Timeline already has a fingerprint cache");
+        return nullptr;
+    }
+    try {
+        auto cache = std::make_unique<OtioFingerprintCache>();
+        cache->timeline = timeline;
+        cache->tracks = Retainer<otio::Stack>(timeline->tracks());
+        registry.caches.emplace(cache->tracks.value, cache.get());
+        registry.active.fetch_add(1, std::memory_order_relaxed);
+        return cache.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
+    } catch (...) {
+        set_error(err, 1, "Unknown exception");
+        return nullptr;
+    }
 }
 
-void otio_track_iterator_reset(OtioTrackIterator* iter) {
-    if (iter) iter->index = 0;
+void otio_fingerprint_cache_free(OtioFingerprintCache* cache) {
+    if (!cache) return;
+    {
+        auto& registry = fingerprint_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.caches.erase(cache->tracks.value);
+        registry.active.fetch_sub(1, std::memory_order_relaxed);
+    }
+    delete cache;
 }
 
-void otio_track_iterator_free(OtioTrackIterator* iter) {
-    delete iter;
+void otio_fingerprint_cache_get_stats(OtioFingerprintCache* cache, OtioFingerprintCacheStats* stats) {
+    if (!cache || !stats) return;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->entries = static_cast<uint64_t>(cache->memo.size());
 }
 
 // ----------------------------------------------------------------------------
-// Clip Iterator (find_clips search)
+// Timeline diff
 // ----------------------------------------------------------------------------
 
-struct OtioClipIterator {
-    std::vector<otio::Clip*> clips;
-    size_t index;
+// One composable of a diffed timeline, in document order, with the parts of
+// its fingerprint
+struct DiffNode : ItemFingerprint {
+    otio::Composable* item;
+    int32_t type;      // OTIO_CHILD_TYPE_*, -1 for other schemas
+    int32_t parent;    // Node index, -1 for the root stack
+    int32_t index;     // Index in the parent
+    std::vector<int32_t> children;
 
-    OtioClipIterator() : index(0) {}
+    DiffNode(otio::Composable* i, int32_t t, int32_t p, int32_t at) : item(i), type(t), parent(p), index(at) {}
 };
 
-OtioClipIterator* otio_track_find_clips(OtioTrack* track) {
-    if (!track) return nullptr;
-    try {
-        auto t = reinterpret_cast<otio::Track*>(track);
-        auto iter = new OtioClipIterator();
+static int32_t add_diff_node(std::vector<DiffNode>& nodes, otio::Composable* item, int32_t parent, int32_t index) {
+    const auto self = static_cast<int32_t>(nodes.size());
+    const int32_t type = object_type_of(item);
+    nodes.emplace_back(item, type, parent, index);
+
+    uint64_t children = 0;
+    if (type == OTIO_CHILD_TYPE_TRACK || type == OTIO_CHILD_TYPE_STACK) {
+        const auto& list = static_cast<otio::Composition*>(item)->children();
+        std::vector<int32_t> order;
+        order.reserve(list.size());
+        for (size_t i = 0; i < list.size(); ++i) {
+            order.push_back(add_diff_node(nodes, list[i].value, self, static_cast<int32_t>(i)));
+        }
+        ChildrenDigest digest;
+        for (int32_t child : order) digest.add(nodes[static_cast<size_t>(child)].subtree);
+        children = digest.digest();
+        nodes[static_cast<size_t>(self)].children = std::move(order);
+    }
+    static_cast<ItemFingerprint&>(nodes[static_cast<size_t>(self)]) = fingerprint_item(item, type, children);
+    return self;
+}
+
+static std::vector<DiffNode> diff_nodes_of(otio::Timeline* tl) {
+    otio::Stack* tracks = tl->tracks();
+    if (!tracks) throw std::runtime_error("Timeline " + tl->name() + " has no tracks");
+    std::vector<DiffNode> nodes;
+    add_diff_node(nodes, tracks, -1, 0);
+    return nodes;
+}
+
+struct TimelineDiffer {
+    const std::vector<DiffNode>& before;
+    const std::vector<DiffNode>& after;
+    std::vector<int32_t> partner_of_before;  // -1 while unmatched
+    std::vector<int32_t> partner_of_after;
+    std::vector<char> reordered;             // By after node
+    // Unmatched children of matched compositions
+    std::vector<int32_t> loose_before;
+    std::vector<int32_t> loose_after;
+
+    TimelineDiffer(const std::vector<DiffNode>& b, const std::vector<DiffNode>& a)
+        : before(b), after(a), partner_of_before(b.size(), -1), partner_of_after(a.size(), -1),
+          reordered(a.size(), 0) {}
+
+    const DiffNode& node_before(int32_t i) const { return before[static_cast<size_t>(i)]; }
+    const DiffNode& node_after(int32_t i) const { return after[static_cast<size_t>(i)]; }
+
+    // Pair the k-th unmatched node of from with the k-th of to that has the
+    // same key, and drop the pairs from both lists. Returns the pairs.
+    std::vector<std::pair<int32_t, int32_t>> pair_by(std::vector<int32_t>& from, std::vector<int32_t>& to,
+        uint64_t DiffNode::*key, bool named_only) {
+        std::vector<std::pair<int32_t, int32_t>> pairs;
+        if (from.empty() || to.empty()) return pairs;
+        const uint64_t unnamed = digest_of([](Fingerprint& fp) { fp.text(std::string()); });
+        std::unordered_map<uint64_t, std::pair<std::vector<int32_t>, size_t>> candidates;
+        candidates.reserve(to.size());
+        for (int32_t a : to) {
+            const DiffNode& node = node_after(a);
+            if (named_only && node.name == unnamed) continue;
+            candidates[node.*key].first.push_back(a);
+        }
+        for (int32_t b : from) {
+            auto it = candidates.find(node_before(b).*key);
+            if (it == candidates.end() || it->second.second == it->second.first.size()) continue;
+            const int32_t a = it->second.first[it->second.second++];
+            partner_of_before[static_cast<size_t>(b)] = a;
+            partner_of_after[static_cast<size_t>(a)] = b;
+            pairs.emplace_back(b, a);
+        }
+        auto unmatched_before = [&](int32_t b) { return partner_of_before[static_cast<size_t>(b)] < 0; };
+        auto unmatched_after = [&](int32_t a) { return partner_of_after[static_cast<size_t>(a)] < 0; };
+        from.erase(std::stable_partition(from.begin(), from.end(), unmatched_before), from.end());
+        to.erase(std::stable_partition(to.begin(), to.end(), unmatched_after), to.end());
+        return pairs;
+    }
 
-        // Iterate through children and collect clips
-        for (auto& child : t->children()) {
-            if (auto clip = dynamic_cast<otio::Clip*>(child.value)) {
-                iter->clips.push_back(clip);
+    void link(int32_t b, int32_t a) {
+        partner_of_before[static_cast<size_t>(b)] = a;
+        partner_of_after[static_cast<size_t>(a)] = b;
+    }
+
+    // Mark the pairs (in order of before) that fall out of the longest run
+    // keeping their order in after as reordered
+    void mark_reordered(std::vector<std::pair<int32_t, int32_t>>& pairs) {
+        std::sort(pairs.begin(), pairs.end());
+        std::vector<int32_t> tails;       // Pair index ending the best run of each length
+        std::vector<int32_t> previous(pairs.size(), -1);
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            auto at = std::lower_bound(tails.begin(), tails.end(), pairs[i].second,
+                [&](int32_t tail, int32_t a) { return pairs[static_cast<size_t>(tail)].second < a; });
+            if (at != tails.begin()) previous[i] = *(at - 1);
+            if (at == tails.end()) {
+                tails.push_back(static_cast<int32_t>(i));
+            } else {
+                *at = static_cast<int32_t>(i);
             }
         }
-        return iter;
-    } catch (...) {
-        return nullptr;
+        std::vector<char> kept(pairs.size(), 0);
+        for (int32_t i = tails.empty() ? -1 : tails.back(); i >= 0; i = previous[static_cast<size_t>(i)]) {
+            kept[static_cast<size_t>(i)] = 1;
+        }
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            if (!kept[i]) reordered[static_cast<size_t>(pairs[i].second)] = 1;
+        }
     }
-}
 
-OtioClipIterator* otio_stack_find_clips(OtioStack* stack) {
-    if (!stack) return nullptr;
-    try {
-        auto s = reinterpret_cast<otio::Stack*>(stack);
-        auto iter = new OtioClipIterator();
-        find_clips_recursive(s, iter->clips);
-        return iter;
-    } catch (...) {
-        return nullptr;
+    void match(int32_t b, int32_t a) {
+        link(b, a);
+        const DiffNode& from = node_before(b);
+        const DiffNode& to = node_after(a);
+        if (from.subtree == to.subtree || from.type != to.type) return;
+        if (from.type != OTIO_CHILD_TYPE_TRACK && from.type != OTIO_CHILD_TYPE_STACK) return;
+
+        const auto& old_children = from.children;
+        const auto& new_children = to.children;
+        // Unchanged children at either end stay where they are
+        size_t head = 0;
+        const size_t common = std::min(old_children.size(), new_children.size());
+        while (head < common &&
+               node_before(old_children[head]).subtree == node_after(new_children[head]).subtree) {
+            link(old_children[head], new_children[head]);
+            ++head;
+        }
+        size_t tail = 0;
+        while (tail < common - head &&
+               node_before(old_children[old_children.size() - 1 - tail]).subtree ==
+                   node_after(new_children[new_children.size() - 1 - tail]).subtree) {
+            link(old_children[old_children.size() - 1 - tail], new_children[new_children.size() - 1 - tail]);
+            ++tail;
+        }
+
+        std::vector<int32_t> from_rest(old_children.begin() + static_cast<std::ptrdiff_t>(head),
+            old_children.end() - static_cast<std::ptrdiff_t>(tail));
+        std::vector<int32_t> to_rest(new_children.begin() + static_cast<std::ptrdiff_t>(head),
+            new_children.end() - static_cast<std::ptrdiff_t>(tail));
+        auto pairs = pair_by(from_rest, to_rest, &DiffNode::subtree, false);
+        auto by_name = pair_by(from_rest, to_rest, &DiffNode::identity, false);
+        auto renamed = pair_by(from_rest, to_rest, &DiffNode::body, false);
+        pairs.insert(pairs.end(), by_name.begin(), by_name.end());
+        pairs.insert(pairs.end(), renamed.begin(), renamed.end());
+        loose_before.insert(loose_before.end(), from_rest.begin(), from_rest.end());
+        loose_after.insert(loose_after.end(), to_rest.begin(), to_rest.end());
+
+        std::vector<std::pair<int32_t, int32_t>> positions;
+        positions.reserve(pairs.size());
+        for (const auto& entry : pairs) {
+            positions.emplace_back(node_before(entry.first).index, entry.second);
+        }
+        mark_reordered(positions);
+        for (const auto& entry : pairs) match(entry.first, entry.second);
     }
-}
 
-OtioClipIterator* otio_timeline_find_clips(OtioTimeline* timeline) {
-    if (!timeline) return nullptr;
+    // Match the loose nodes across parents. Returns whether any matched;
+    // matching moved compositions can loosen more nodes.
+    bool match_loose() {
+        std::sort(loose_before.begin(), loose_before.end());
+        std::sort(loose_after.begin(), loose_after.end());
+        auto pairs = pair_by(loose_before, loose_after, &DiffNode::subtree, false);
+        auto by_name = pair_by(loose_before, loose_after, &DiffNode::identity, true);
+        auto renamed = pair_by(loose_before, loose_after, &DiffNode::body, false);
+        pairs.insert(pairs.end(), by_name.begin(), by_name.end());
+        pairs.insert(pairs.end(), renamed.begin(), renamed.end());
+        for (const auto& entry : pairs) match(entry.first, entry.second);
+        return !pairs.empty();
+    }
+
+    int32_t changes(int32_t b, int32_t a) const {
+        const DiffNode& from = node_before(b);
+        const DiffNode& to = node_after(a);
+        int32_t bits = 0;
+        const bool same_parent = to.parent < 0 || partner_of_after[static_cast<size_t>(to.parent)] == from.parent;
+        if (!same_parent || reordered[static_cast<size_t>(a)]) bits |= OTIO_DIFF_MOVED;
+        if (from.subtree == to.subtree) return bits;
+        if (from.range != to.range) bits |= OTIO_DIFF_RETIMED;
+        if (from.media != to.media) bits |= OTIO_DIFF_MEDIA;
+        if (from.metadata != to.metadata) bits |= OTIO_DIFF_METADATA;
+        if (from.name != to.name) bits |= OTIO_DIFF_RENAMED;
+        if (from.fields != to.fields || from.type != to.type) bits |= OTIO_DIFF_FIELDS;
+        return bits;
+    }
+};
+
+struct OtioTimelineDiff {
+    int32_t timeline_changes = 0;
+    std::vector<OtioDiffOp> ops;
+};
+
+static int32_t timeline_changes_of(otio::Timeline* before, otio::Timeline* after) {
+    int32_t bits = 0;
+    if (before->name() != after->name()) bits |= OTIO_DIFF_RENAMED;
+    auto metadata = [](otio::Timeline* tl) {
+        return digest_of([&](Fingerprint& fp) { fingerprint_dict(fp, tl->metadata()); });
+    };
+    if (metadata(before) != metadata(after)) bits |= OTIO_DIFF_METADATA;
+    auto fields = [](otio::Timeline* tl) {
+        return digest_of([&](Fingerprint& fp) {
+            auto start = tl->global_start_time();
+            fp.word(start ? 1 : 0);
+            if (start) fp.time(*start);
+            fingerprint_dict(fp, tl->dynamic_fields());
+        });
+    };
+    if (fields(before) != fields(after)) bits |= OTIO_DIFF_FIELDS;
+    return bits;
+}
+
+OtioTimelineDiff* otio_timeline_diff(OtioTimeline* before, OtioTimeline* after, OtioError* err) {
+    OTIO_NULL_CHECK_ERR(before, err, nullptr, "Timeline is null");
+    OTIO_NULL_CHECK_ERR(after, err, nullptr, "Timeline is null");
     try {
-        auto tl = reinterpret_cast<otio::Timeline*>(timeline);
-        auto iter = new OtioClipIterator();
-        find_clips_recursive(tl->tracks(), iter->clips);
-        return iter;
+        auto old_tl = reinterpret_cast<otio::Timeline*>(before);
+        auto new_tl = reinterpret_cast<otio::Timeline*>(after);
+        const auto old_nodes = diff_nodes_of(old_tl);
+        const auto new_nodes = diff_nodes_of(new_tl);
+
+        TimelineDiffer differ(old_nodes, new_nodes);
+        differ.match(0, 0);
+        while (differ.match_loose()) {}
+
+        auto diff = std::make_unique<OtioTimelineDiff>();
+        diff->timeline_changes = timeline_changes_of(old_tl, new_tl);
+        auto op = [](int32_t kind, int32_t changes, const DiffNode* from, const DiffNode* to) {
+            return OtioDiffOp{kind, changes,
+                from ? from->item : nullptr, from ? from->type : -1, from && from->parent >= 0 ? from->index : -1,
+                to ? to->item : nullptr, to ? to->type : -1, to && to->parent >= 0 ? to->index : -1};
+        };
+        // The loose nodes left are the removed and added ones
+        for (int32_t b : differ.loose_before) {
+            diff->ops.push_back(op(OTIO_DIFF_REMOVED, 0, &differ.node_before(b), nullptr));
+        }
+        std::vector<char> added(new_nodes.size(), 0);
+        for (int32_t a : differ.loose_after) added[static_cast<size_t>(a)] = 1;
+        for (size_t i = 0; i < new_nodes.size(); ++i) {
+            const auto a = static_cast<int32_t>(i);
+            if (added[i]) {
+                diff->ops.push_back(op(OTIO_DIFF_ADDED, 0, nullptr, &new_nodes[i]));
+                continue;
+            }
+            const int32_t b = differ.partner_of_after[i];
+            if (b < 0) continue;
+            if (int32_t changes = differ.changes(b, a)) {
+                diff->ops.push_back(op(OTIO_DIFF_CHANGED, changes, &differ.node_before(b), &new_nodes[i]));
+            }
+        }
+        return diff.release();
+    } catch (const std::exception& e) {
+        set_error(err, 1, e.what());
+        return nullptr;
     } catch (...) {
+        set_error(err, 1, "Unknown exception");
         return nullptr;
     }
 }
 
-int32_t otio_clip_iterator_count(OtioClipIterator* iter) {
-    if (!iter) return 0;
-    return static_cast<int32_t>(iter->clips.size());
+void otio_timeline_diff_free(OtioTimelineDiff* diff) {
+    delete diff;
 }
 
-OtioClip* otio_clip_iterator_next(OtioClipIterator* iter) {
-    if (!iter || iter->index >= iter->clips.size()) return nullptr;
-    return reinterpret_cast<OtioClip*>(iter->clips[iter->index++]);
+int32_t otio_timeline_diff_timeline_changes(OtioTimelineDiff* diff) {
+    return diff ? diff->timeline_changes : 0;
 }
 
-void otio_clip_iterator_reset(OtioClipIterator* iter) {
-    if (iter) iter->index = 0;
+int32_t otio_timeline_diff_ops(OtioTimelineDiff* diff, OtioDiffOp* ops, int32_t capacity) {
+    if (!diff) return 0;
+    const size_t limit = ops && capacity > 0 ? static_cast<size_t>(capacity) : 0;
+    std::copy_n(diff->ops.begin(), std::min(limit, diff->ops.size()), ops);
+    return static_cast<int32_t>(diff->ops.size());
 }
 
-void otio_clip_iterator_free(OtioClipIterator* iter) {
-    delete iter;
+// ----------------------------------------------------------------------------
+// Instrumentation
+// ----------------------------------------------------------------------------
+
+int32_t otio_stats_supported(void) {
+#ifdef OTIO_SHIM_HAVE_STATS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int32_t otio_stats_snapshot(OtioStat* stats, int32_t capacity) {
+#ifdef OTIO_SHIM_HAVE_STATS
+    static const char* const names[OTIO_STAT_COUNT] = {
+        "parse", "serialize", "binary", "iterate", "range",
+        "transformed_time", "edit", "dynamic_cast", "strdup", "exception",
+    };
+    StatTable totals;
+    {
+        auto& registry = stats_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.totals(totals);
+        for (int32_t id = 0; id < OTIO_STAT_COUNT; ++id) {
+            for (int32_t field = 0; field < kStatFields; ++field) totals[id][field] -= registry.baseline[id][field];
+        }
+    }
+    const int32_t limit = stats && capacity > 0 ? std::min<int32_t>(capacity, OTIO_STAT_COUNT) : 0;
+    for (int32_t id = 0; id < limit; ++id) {
+        stats[id] = OtioStat{names[id], totals[id][kStatCalls], totals[id][kStatNanoseconds], totals[id][kStatBytes]};
+    }
+    return OTIO_STAT_COUNT;
+#else
+    (void)stats;
+    (void)capacity;
+    return 0;
+#endif
+}
+
+void otio_stats_reset(void) {
+#ifdef OTIO_SHIM_HAVE_STATS
+    auto& registry = stats_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.totals(registry.baseline);
+#endif
 }
 
 } // extern "C"
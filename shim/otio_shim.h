@@ -1,6 +1,7 @@
 #ifndef OTIO_SHIM_H
 #define OTIO_SHIM_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -38,6 +39,12 @@ typedef struct {
 // Timeline
 OtioTimeline* otio_timeline_create(const char* name);
 void otio_timeline_free(OtioTimeline* tl);
+// With enabled nonzero, otio_timeline_free hands this timeline to a
+// background thread that tears it down and then returns freed memory to the
+// system. Objects retained elsewhere are unaffected. Off by default.
+void otio_timeline_set_background_release(OtioTimeline* tl, int32_t enabled);
+// Block until every timeline handed to the background thread is released
+void otio_wait_for_background_releases(void);
 int otio_timeline_set_global_start_time(OtioTimeline* tl, OtioRationalTime time, OtioError* err);
 
 // Tracks (0 = video, 1 = audio)
@@ -70,6 +77,17 @@ OtioTimeline* otio_timeline_read_from_file(const char* path, OtioError* err);
 // Serialization (string-based) - caller must free returned string with otio_free_string
 char* otio_timeline_to_json_string(OtioTimeline* tl, OtioError* err);
 OtioTimeline* otio_timeline_from_json_string(const char* json, OtioError* err);
+// Same as otio_timeline_from_json_string, for a buffer of `len` bytes that
+// need not be NUL-terminated (e.g. a memory-mapped file or a Rust slice)
+OtioTimeline* otio_timeline_from_json_buffer(const char* data, size_t len, OtioError* err);
+
+// Serialization into a caller-owned sink. `write` is called with the
+// document in order, in pieces of at most 64 KiB, and returns nonzero to
+// stop (the call then fails). Nothing is allocated for the caller to free.
+typedef int32_t (*OtioWriteCallback)(void* user_data, const char* data, size_t len);
+#define OTIO_JSON_COMPACT 1  // no indentation or line breaks
+int otio_timeline_write_json(OtioTimeline* tl, int32_t flags, OtioWriteCallback write,
+                             void* user_data, OtioError* err);
 
 // Serialization with schema version targeting
 // schema_names and schema_versions are parallel arrays of length count
@@ -90,6 +108,60 @@ char* otio_timeline_to_json_string_with_schema_versions(
     OtioError* err
 );
 
+// Serialization (binary) - a compact, lossless encoding of the JSON form for
+// caches between pipeline stages. Decoding it yields the same document as
+// the JSON written with the same schema versions. schema_names,
+// schema_versions and count work as above (NULL/0 for no downgrading).
+//
+// Layout: the 8 bytes "OTIOBIN\x01", then one value. Each value is a tag byte:
+//   0 null, 1 false, 2 true
+//   3 integer (zigzag LEB128 varint), 4 double (8 bytes, IEEE 754 LE)
+//   5 string (varint length, bytes as escaped in JSON; appended to the
+//     string table), 6 string reference (varint index into the table)
+//   7 path: two string values (5 or 6), directory up to its last '/' and
+//     the rest
+//   8 object: (string key, value) pairs, then 10; 9 array: values, then 10
+//   11 RationalTime.1 object: rate and value as two doubles
+//   12 number that fits no int64 (varint length, JSON text)
+// Returns a malloc'd buffer of *len bytes; free with otio_free_bytes.
+uint8_t* otio_timeline_to_binary(
+    OtioTimeline* tl,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    size_t* len,
+    OtioError* err
+);
+OtioTimeline* otio_timeline_from_binary(const uint8_t* data, size_t len, OtioError* err);
+void otio_free_bytes(uint8_t* data);
+int otio_timeline_write_to_binary_file(
+    OtioTimeline* tl,
+    const char* path,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+);
+OtioTimeline* otio_timeline_read_from_binary_file(const char* path, OtioError* err);
+
+// Serialization (gzip) - needs the shim built with OTIO_SHIM_WITH_ZLIB. The
+// file readers above (JSON, binary, lazy and batch) detect gzip files by
+// their magic bytes and decompress them while reading, whatever their name.
+// Returns nonzero if gzip support is built in.
+int32_t otio_gzip_supported(void);
+// Write the JSON form, schema versions applied as above, compressing in
+// chunks to path. level is 0 (store) to 9 (smallest), or -1 for zlib's
+// default.
+int otio_timeline_write_to_gzip_file(
+    OtioTimeline* tl,
+    const char* path,
+    int32_t level,
+    const char** schema_names,
+    const int64_t* schema_versions,
+    int32_t count,
+    OtioError* err
+);
+
 // Metadata (string key-value pairs)
 // Getter returns malloc'd string - caller must free with otio_free_string
 // Returns NULL if key not found
@@ -202,6 +274,37 @@ int otio_track_insert_gap(OtioTrack* track, int32_t index, OtioGap* gap, OtioErr
 int otio_track_insert_stack(OtioTrack* track, int32_t index, OtioStack* stack, OtioError* err);
 int otio_track_clear_children(OtioTrack* track, OtioError* err);
 
+// Bulk child operations. items[i] is a child handle whose kind is given by
+// types[i] (OTIO_CHILD_TYPE_*). The whole batch is validated first, so an
+// invalid entry leaves the track unchanged and ownership with the caller.
+int otio_track_append_children(OtioTrack* track, void* const* items, const int32_t* types,
+    int32_t count, OtioError* err);
+// Insert the batch before index, in order; index follows insert_child rules
+int otio_track_insert_children(OtioTrack* track, int32_t index, void* const* items,
+    const int32_t* types, int32_t count, OtioError* err);
+
+// Clip descriptors: create and append many clips with one call
+typedef struct {
+    const char* key;
+    const char* value;
+} OtioMetadataPair;
+
+typedef struct {
+    const char* name;
+    OtioTimeRange source_range;
+    const char* target_url;          // NULL for no media reference
+    int32_t has_available_range;     // Non-zero to set available_range on the reference
+    OtioTimeRange available_range;
+    const OtioMetadataPair* metadata;  // Clip metadata, may be NULL when metadata_count is 0
+    int32_t metadata_count;
+} OtioClipDescriptor;
+
+// Create a clip (with an ExternalReference when target_url is set) for each
+// descriptor and append them to track in order. Every descriptor is checked
+// before anything is created, so on error the track is unchanged.
+int otio_track_append_clip_descriptors(OtioTrack* track, const OtioClipDescriptor* descriptors,
+    int32_t count, OtioError* err);
+
 // NeighborGapPolicy constants
 #define OTIO_NEIGHBOR_GAP_NEVER              0
 #define OTIO_NEIGHBOR_GAP_AROUND_TRANSITIONS 1
@@ -226,6 +329,12 @@ int otio_stack_insert_gap(OtioStack* stack, int32_t index, OtioGap* gap, OtioErr
 int otio_stack_insert_stack(OtioStack* stack, int32_t index, OtioStack* child, OtioError* err);
 int otio_stack_clear_children(OtioStack* stack, OtioError* err);
 
+// Bulk child operations; see otio_track_append_children
+int otio_stack_append_children(OtioStack* stack, void* const* items, const int32_t* types,
+    int32_t count, OtioError* err);
+int otio_stack_insert_children(OtioStack* stack, int32_t index, void* const* items,
+    const int32_t* types, int32_t count, OtioError* err);
+
 // ----------------------------------------------------------------------------
 // Marker
 // ----------------------------------------------------------------------------
@@ -241,6 +350,8 @@ char* otio_marker_get_comment(OtioMarker* marker);
 void otio_marker_set_comment(OtioMarker* marker, const char* comment);
 void otio_marker_set_metadata_string(OtioMarker* marker, const char* key, const char* value);
 char* otio_marker_get_metadata_string(OtioMarker* marker, const char* key);
+// 1 if another clip or track also holds the marker (see OTIO_CLONE_SHARED)
+int otio_marker_is_shared(OtioMarker* marker);
 
 // ----------------------------------------------------------------------------
 // Effect
@@ -335,6 +446,17 @@ int32_t otio_image_seq_ref_number_of_images(OtioImageSeqRef* ref);
 int32_t otio_image_seq_ref_frame_for_time(OtioImageSeqRef* ref, OtioRationalTime time, OtioError* err);
 char* otio_image_seq_ref_target_url_for_image_number(OtioImageSeqRef* ref, int32_t image_number, OtioError* err);
 
+// URLs of images [first_image, first_image + count) in one call, as
+// target_url_for_image_number() formats them. The URLs are written back to
+// back into `buffer`, without terminators; URL i spans
+// [offsets[i], offsets[i + 1]), so `offsets` must hold count + 1 entries.
+// Returns the total size in bytes, or -1 on error (the whole range is
+// checked before anything is written). `offsets`, when not NULL, is always
+// filled; `buffer` only when it is not NULL and buffer_size is at least the
+// total, so a call without a buffer sizes it.
+int64_t otio_image_seq_ref_target_urls(OtioImageSeqRef* ref, int32_t first_image, int32_t count,
+    char* buffer, int64_t buffer_size, int64_t* offsets, OtioError* err);
+
 // Available range
 int otio_image_seq_ref_set_available_range(OtioImageSeqRef* ref, OtioTimeRange range, OtioError* err);
 OtioTimeRange otio_image_seq_ref_get_available_range(OtioImageSeqRef* ref);
@@ -392,13 +514,18 @@ char* otio_freeze_frame_get_metadata_string(OtioFreezeFrame* effect, const char*
 // Clip Marker/Effect attachment
 // ----------------------------------------------------------------------------
 
+// The *_at getters are read-only: a marker or effect shared with a fork
+// (OTIO_CLONE_SHARED) is handed out as is. Edit through the *_at_mut
+// getters, which copy a shared one first and report the change.
 int otio_clip_add_marker(OtioClip* clip, OtioMarker* marker, OtioError* err);
 int32_t otio_clip_markers_count(OtioClip* clip);
 OtioMarker* otio_clip_marker_at(OtioClip* clip, int32_t index);
+OtioMarker* otio_clip_marker_at_mut(OtioClip* clip, int32_t index);
 
 int otio_clip_add_effect(OtioClip* clip, OtioEffect* effect, OtioError* err);
 int32_t otio_clip_effects_count(OtioClip* clip);
 OtioEffect* otio_clip_effect_at(OtioClip* clip, int32_t index);
+OtioEffect* otio_clip_effect_at_mut(OtioClip* clip, int32_t index);
 
 // Also support LinearTimeWarp as effect
 int otio_clip_add_linear_time_warp(OtioClip* clip, OtioLinearTimeWarp* effect, OtioError* err);
@@ -413,7 +540,9 @@ int otio_clip_set_generator_reference(OtioClip* clip, OtioGeneratorRef* ref, Oti
 
 int otio_track_add_marker(OtioTrack* track, OtioMarker* marker, OtioError* err);
 int32_t otio_track_markers_count(OtioTrack* track);
+// Read-only and editing getters, as for clips
 OtioMarker* otio_track_marker_at(OtioTrack* track, int32_t index);
+OtioMarker* otio_track_marker_at_mut(OtioTrack* track, int32_t index);
 
 // ----------------------------------------------------------------------------
 // Track kind
@@ -437,6 +566,30 @@ OtioTimeRange otio_stack_range_of_child_at_index(OtioStack* stack, int32_t index
 OtioTimeRange otio_track_trimmed_range(OtioTrack* track, OtioError* err);
 OtioTimeRange otio_stack_trimmed_range(OtioStack* stack, OtioError* err);
 
+// ----------------------------------------------------------------------------
+// Range cache (opt-in memoization of the time transforms above)
+// ----------------------------------------------------------------------------
+
+typedef struct OtioRangeCache OtioRangeCache;
+
+typedef struct {
+    uint64_t hits;        // Queries answered from the cache
+    uint64_t misses;      // Queries that had to compute something
+    uint64_t recomputed;  // Child ranges computed on misses
+} OtioRangeCacheStats;
+
+// While the returned handle lives, range_of_child_at_index and trimmed_range
+// on this track or stack are memoized. Child ranges are kept as a prefix that
+// is extended on demand; an edit made through this API drops only the ranges
+// from the first affected child on. Edits made directly through OTIO, or to a
+// media reference after it was attached to a clip, are not seen. At most one
+// cache per composition, which must outlive its cache.
+OtioRangeCache* otio_track_enable_range_cache(OtioTrack* track, OtioError* err);
+OtioRangeCache* otio_stack_enable_range_cache(OtioStack* stack, OtioError* err);
+// Disable caching and release the handle
+void otio_range_cache_free(OtioRangeCache* cache);
+void otio_range_cache_get_stats(OtioRangeCache* cache, OtioRangeCacheStats* stats);
+
 // ----------------------------------------------------------------------------
 // ExternalReference additional accessors
 // ----------------------------------------------------------------------------
@@ -493,6 +646,47 @@ int otio_clip_roll(OtioClip* clip, OtioRationalTime delta_in,
 int otio_track_remove_at_time(OtioTrack* track, OtioRationalTime time,
     int fill_with_gap, OtioError* err);
 
+// ----------------------------------------------------------------------------
+// Edit transactions
+// ----------------------------------------------------------------------------
+
+// Queues the track edit algorithms above and applies them as one unit.
+// Queued edits only touch the track on commit, where they run in the order
+// they were queued (each sees the track as left by the previous one), with
+// range caches, indexes and change tracking notified once at the end. If
+// any edit fails, the track's children, their source ranges and those of
+// the queued clips are restored, so the track is left as it was before the
+// commit.
+//
+// Edits queued in time order (each starting at or after the previous one)
+// on a track without a source range are applied in one pass, each costing
+// in proportion to the children around it. Other batches run each edit
+// over the whole track.
+//
+// Queuing an overwrite or insert transfers ownership of the clip to the
+// edit. The track must outlive the edit.
+typedef struct OtioTrackEdit OtioTrackEdit;
+
+OtioTrackEdit* otio_track_begin_edit(OtioTrack* track, OtioError* err);
+// Discards edits that were not committed, releasing their clips
+void otio_track_edit_free(OtioTrackEdit* edit);
+
+int otio_track_edit_overwrite(OtioTrackEdit* edit, OtioClip* clip, OtioTimeRange range,
+    int remove_transitions, OtioError* err);
+int otio_track_edit_insert_at_time(OtioTrackEdit* edit, OtioClip* clip, OtioRationalTime time,
+    int remove_transitions, OtioError* err);
+int otio_track_edit_slice_at_time(OtioTrackEdit* edit, OtioRationalTime time,
+    int remove_transitions, OtioError* err);
+int otio_track_edit_remove_at_time(OtioTrackEdit* edit, OtioRationalTime time, int fill_with_gap,
+    OtioError* err);
+// Number of edits queued since the last commit
+int32_t otio_track_edit_count(OtioTrackEdit* edit);
+
+// Apply the queued edits. Returns 0 on success, after which the edit is
+// empty and can queue more. Returns -1 on error, naming the failed edit by
+// its index, with the track rolled back and the edits still queued.
+int otio_track_edit_commit(OtioTrackEdit* edit, OtioError* err);
+
 // ----------------------------------------------------------------------------
 // Time coordinate transforms
 // ----------------------------------------------------------------------------
@@ -506,10 +700,41 @@ OtioRationalTime otio_item_transformed_time(void* item, int32_t item_type,
 OtioTimeRange otio_item_transformed_time_range(void* item, int32_t item_type,
     OtioTimeRange range, void* to_item, int32_t to_item_type, OtioError* err);
 
+// Transform count times at once. The offsets between the two items are
+// computed once for the batch, and the results match calling
+// otio_item_transformed_time for every time. Transforming a range only moves
+// its start, so these also cover otio_item_transformed_time_range.
+// Returns 0 on success, -1 on error.
+int otio_item_transformed_times(void* item, int32_t item_type, const OtioRationalTime* times,
+    int32_t count, void* to_item, int32_t to_item_type, OtioRationalTime* out, OtioError* err);
+// As above for the consecutive frames start, start + 1, ... at start's rate
+int otio_item_transformed_frames(void* item, int32_t item_type, OtioRationalTime start,
+    int32_t count, void* to_item, int32_t to_item_type, OtioRationalTime* out, OtioError* err);
+
 // Get the range of an item within its parent
 OtioTimeRange otio_clip_range_in_parent(OtioClip* clip, OtioError* err);
 OtioTimeRange otio_gap_range_in_parent(OtioGap* gap, OtioError* err);
 
+// ----------------------------------------------------------------------------
+// Object type tags
+// ----------------------------------------------------------------------------
+
+// Schema of any object handle. Composables report their OTIO_CHILD_TYPE_*
+// value (0-4); the remaining schemas use the tags below.
+#define OTIO_OBJECT_TYPE_TIMELINE                 5
+#define OTIO_OBJECT_TYPE_MARKER                   6
+#define OTIO_OBJECT_TYPE_EFFECT                   7
+#define OTIO_OBJECT_TYPE_LINEAR_TIME_WARP         8
+#define OTIO_OBJECT_TYPE_FREEZE_FRAME             9
+#define OTIO_OBJECT_TYPE_EXTERNAL_REFERENCE       10
+#define OTIO_OBJECT_TYPE_MISSING_REFERENCE        11
+#define OTIO_OBJECT_TYPE_GENERATOR_REFERENCE      12
+#define OTIO_OBJECT_TYPE_IMAGE_SEQUENCE_REFERENCE 13
+
+// Returns the tag for obj, or -1 if obj is null or of an unrecognised schema.
+// Costs a single type comparison for the built-in schemas.
+int32_t otio_object_type(void* obj);
+
 // ----------------------------------------------------------------------------
 // Parent navigation
 // ----------------------------------------------------------------------------
@@ -559,6 +784,15 @@ OtioTrack* otio_track_iterator_next(OtioTrackIterator* iter);
 void otio_track_iterator_reset(OtioTrackIterator* iter);
 void otio_track_iterator_free(OtioTrackIterator* iter);
 
+// Write the tracks into a caller-provided array instead of allocating an
+// iterator. Returns the total number of tracks, which can exceed capacity
+// (only the first capacity handles are written; tracks may be NULL to only
+// count), or -1 on error.
+int32_t otio_timeline_video_tracks_into(OtioTimeline* tl, OtioTrack** tracks, int32_t capacity,
+    OtioError* err);
+int32_t otio_timeline_audio_tracks_into(OtioTimeline* tl, OtioTrack** tracks, int32_t capacity,
+    OtioError* err);
+
 // ----------------------------------------------------------------------------
 // Clip Iterator (for clip search)
 // ----------------------------------------------------------------------------
@@ -578,6 +812,621 @@ OtioClip* otio_clip_iterator_next(OtioClipIterator* iter);
 void otio_clip_iterator_reset(OtioClipIterator* iter);
 void otio_clip_iterator_free(OtioClipIterator* iter);
 
+// Caller-array variants of the searches above, with the count protocol of
+// otio_timeline_video_tracks_into.
+int32_t otio_track_find_clips_into(OtioTrack* track, OtioClip** clips, int32_t capacity,
+    OtioError* err);
+int32_t otio_stack_find_clips_into(OtioStack* stack, OtioClip** clips, int32_t capacity,
+    OtioError* err);
+int32_t otio_timeline_find_clips_into(OtioTimeline* timeline, OtioClip** clips, int32_t capacity,
+    OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Flattened item export (single-pass walk of a whole timeline)
+// ----------------------------------------------------------------------------
+
+// Struct-of-arrays buffer filled by otio_timeline_flatten_items.
+// Every non-NULL array must have room for `capacity` entries; NULL arrays
+// are skipped. Entries are in depth-first (pre-order) order, so a parent is
+// always emitted before its children.
+typedef struct {
+    void** handles;          // Child handle, cast according to types[i]
+    int32_t* types;          // OTIO_CHILD_TYPE_* constant
+    int32_t* depths;         // 0 for tracks directly under the timeline's stack
+    int32_t* parent_indices; // Index of the parent entry, -1 for depth 0
+    OtioTimeRange* ranges;   // Range in the timeline's stack coordinate space
+    int32_t capacity;
+} OtioFlattenedItems;
+
+// Walk every item below the timeline's stack once, filling `out` (may be NULL
+// to only count). Returns the total number of items, which can exceed
+// out->capacity (only the first capacity entries are written), or -1 on error.
+int32_t otio_timeline_flatten_items(OtioTimeline* tl, OtioFlattenedItems* out, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Borrowed string views (no allocation, no otio_free_string)
+// ----------------------------------------------------------------------------
+
+// Non-owning, non-NUL-terminated view of a string. `data` is NULL when the
+// value is absent (missing key, null object); an empty string has a non-NULL
+// `data` and `len` 0.
+typedef struct {
+    const char* data;
+    size_t len;
+} OtioStringView;
+
+// Metadata views point directly into the object's metadata dictionary and
+// stay valid until that object's metadata is next modified or the object is
+// destroyed.
+OtioStringView otio_timeline_get_metadata_string_view(OtioTimeline* tl, const char* key);
+OtioStringView otio_track_get_metadata_string_view(OtioTrack* track, const char* key);
+OtioStringView otio_clip_get_metadata_string_view(OtioClip* clip, const char* key);
+OtioStringView otio_gap_get_metadata_string_view(OtioGap* gap, const char* key);
+OtioStringView otio_stack_get_metadata_string_view(OtioStack* stack, const char* key);
+OtioStringView otio_external_ref_get_metadata_string_view(OtioExternalRef* ref, const char* key);
+OtioStringView otio_marker_get_metadata_string_view(OtioMarker* marker, const char* key);
+OtioStringView otio_effect_get_metadata_string_view(OtioEffect* effect, const char* key);
+OtioStringView otio_transition_get_metadata_string_view(OtioTransition* transition, const char* key);
+OtioStringView otio_missing_ref_get_metadata_string_view(OtioMissingRef* ref, const char* key);
+OtioStringView otio_image_seq_ref_get_metadata_string_view(OtioImageSeqRef* ref, const char* key);
+OtioStringView otio_generator_ref_get_metadata_string_view(OtioGeneratorRef* ref, const char* key);
+OtioStringView otio_linear_time_warp_get_metadata_string_view(OtioLinearTimeWarp* effect, const char* key);
+OtioStringView otio_freeze_frame_get_metadata_string_view(OtioFreezeFrame* effect, const char* key);
+
+// OTIO returns names, URLs, colors and comments by value, so these views
+// point into a per-thread scratch buffer instead. A view stays valid until
+// the next call to any of the functions below on the same thread.
+OtioStringView otio_timeline_get_name_view(OtioTimeline* tl);
+OtioStringView otio_track_get_name_view(OtioTrack* track);
+OtioStringView otio_clip_get_name_view(OtioClip* clip);
+OtioStringView otio_gap_get_name_view(OtioGap* gap);
+OtioStringView otio_stack_get_name_view(OtioStack* stack);
+OtioStringView otio_transition_get_name_view(OtioTransition* transition);
+OtioStringView otio_external_ref_get_name_view(OtioExternalRef* ref);
+OtioStringView otio_external_ref_get_target_url_view(OtioExternalRef* ref);
+OtioStringView otio_marker_get_name_view(OtioMarker* marker);
+OtioStringView otio_marker_get_color_view(OtioMarker* marker);
+OtioStringView otio_marker_get_comment_view(OtioMarker* marker);
+
+// View of the next string in the iterator, valid until the iterator is freed.
+// Returns a NULL view when exhausted.
+OtioStringView otio_string_iterator_next_view(OtioStringIterator* iter);
+
+// Media reference keys of a clip as views, without an iterator. The views
+// point into a per-thread buffer and stay valid until the next call to this
+// function on the same thread. Returns the total number of keys, which can
+// exceed capacity (only the first capacity views are written; keys may be
+// NULL to only count), or -1 on error.
+int32_t otio_clip_media_reference_keys_into(OtioClip* clip, OtioStringView* keys, int32_t capacity,
+    OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Selective loading (skip subtrees at parse time, hydrate tracks on demand)
+// ----------------------------------------------------------------------------
+
+// Which parts of a document to materialize. Tracks of the timeline's stack
+// that are not selected are still created, with their name, kind, metadata,
+// markers and effects, but without children; their JSON is kept so they can
+// be hydrated later. A zeroed filter loads everything.
+typedef struct {
+    int32_t track_kinds;           // Bitmask of (1 << OTIO_TRACK_KIND_*), 0 = any kind
+    const int32_t* track_indices;  // Root-stack track indices to load, NULL = all
+    int32_t track_index_count;
+    const char** skip_schemas;     // Objects dropped from every JSON array, by schema
+    int32_t skip_schema_count;     // name ("Marker") or name and version ("Effect.1")
+} OtioLoadFilter;
+
+typedef struct OtioLazyTimeline OtioLazyTimeline;
+
+// filter may be NULL to load everything
+OtioLazyTimeline* otio_lazy_timeline_read_from_file(const char* path, const OtioLoadFilter* filter, OtioError* err);
+OtioLazyTimeline* otio_lazy_timeline_from_json_buffer(const char* data, size_t len, const OtioLoadFilter* filter, OtioError* err);
+void otio_lazy_timeline_free(OtioLazyTimeline* lazy);
+
+// Borrowed timeline, valid while the lazy handle lives
+OtioTimeline* otio_lazy_timeline_get_timeline(OtioLazyTimeline* lazy);
+// New owning handle to the timeline; free with otio_timeline_free
+OtioTimeline* otio_lazy_timeline_take_timeline(OtioLazyTimeline* lazy);
+
+// Number of tracks still waiting to be hydrated
+int32_t otio_lazy_timeline_pending_count(OtioLazyTimeline* lazy);
+// 1 if the root-stack track at index is fully loaded, 0 if pending, -1 if invalid
+int32_t otio_lazy_timeline_is_track_loaded(OtioLazyTimeline* lazy, int32_t index);
+// Parse the children of a pending track into it. No-op for loaded tracks.
+int otio_lazy_timeline_hydrate_track(OtioLazyTimeline* lazy, int32_t index, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Batch loading (parallel)
+// ----------------------------------------------------------------------------
+
+// Load `count` documents concurrently on up to thread_count threads (<= 0 uses
+// one per hardware thread). timelines[i] receives an owned timeline, or NULL
+// with errors[i] set on failure; errors may be NULL. Returns the number of
+// failed items, or -1 if the arguments are invalid.
+//
+// Thread safety: each document is parsed into its own object graph, so items
+// share no OTIO objects. The only shared state OTIO touches while reading is
+// the global TypeRegistry (schema lookup and upgrade function tables), which
+// guards every access with its own mutex; upgrade functions only rewrite the
+// dictionary of the object being read. Register any custom types or upgrade
+// functions before starting a batch so every item sees the same set.
+int32_t otio_timeline_read_from_files(
+    const char* const* paths,
+    int32_t count,
+    int32_t thread_count,
+    OtioTimeline** timelines,
+    OtioError* errors
+);
+int32_t otio_timeline_from_json_buffers(
+    const char* const* buffers,
+    const size_t* lengths,
+    int32_t count,
+    int32_t thread_count,
+    OtioTimeline** timelines,
+    OtioError* errors
+);
+
+// ----------------------------------------------------------------------------
+// Time index (time-to-item queries)
+// ----------------------------------------------------------------------------
+
+typedef struct OtioTimeIndex OtioTimeIndex;
+
+typedef struct {
+    void* handle;          // Child handle, cast according to type
+    int32_t child_type;    // OTIO_CHILD_TYPE_* constant
+    int32_t track_index;   // Timeline indexes: index of the parent track in
+                           // the root stack; -1 otherwise
+    int32_t child_index;   // Index of the item in its parent
+    OtioTimeRange range;   // Range in the indexed composition's coordinates
+} OtioTimeIndexHit;
+
+// Index the direct children of a track or stack by their range in it. A
+// timeline index covers the children of every track in the timeline's stack,
+// in stack coordinates. The index borrows its composition (or timeline), which
+// must outlive it; structural and timing edits made through this API mark it
+// stale, and the next query rebuilds it.
+OtioTimeIndex* otio_track_build_time_index(OtioTrack* track, OtioError* err);
+OtioTimeIndex* otio_stack_build_time_index(OtioStack* stack, OtioError* err);
+OtioTimeIndex* otio_timeline_build_time_index(OtioTimeline* tl, OtioError* err);
+void otio_time_index_free(OtioTimeIndex* index);
+
+// Items whose range contains time (start <= time < end). Hits are ordered by
+// start time; transitions overlap their neighbours and are reported with them.
+// Returns the total number of hits, which can exceed capacity (only the first
+// capacity hits are written; hits may be NULL to only count), or -1 on error.
+int32_t otio_time_index_query(OtioTimeIndex* index, OtioRationalTime time,
+    OtioTimeIndexHit* hits, int32_t capacity, OtioError* err);
+// Items whose range overlaps range. A zero-duration range behaves like a
+// point query at its start time.
+int32_t otio_time_index_query_range(OtioTimeIndex* index, OtioTimeRange range,
+    OtioTimeIndexHit* hits, int32_t capacity, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Search cursors (lazy, filtered find)
+// ----------------------------------------------------------------------------
+
+typedef struct OtioSearchCursor OtioSearchCursor;
+
+// Predicates an item must satisfy to be returned. All set fields must match;
+// a zeroed filter matches every composable.
+typedef struct {
+    int32_t child_types;         // Bitmask of (1 << OTIO_CHILD_TYPE_*), 0 = any type
+    int32_t has_search_range;    // Nonzero to only match items overlapping search_range
+    OtioTimeRange search_range;  // In the searched composition's coordinates
+    int32_t track_kinds;         // Bitmask of (1 << OTIO_TRACK_KIND_*) of the item's
+                                 // nearest track (itself for tracks), 0 = any kind
+    const char* metadata_key;    // Only items with this metadata key, NULL = any
+    const char* metadata_value;  // ...whose value is this string, NULL = any value
+    const char* name_prefix;     // Only items whose name starts with this, NULL = any
+    const char* target_url;      // Only clips with an external reference to this URL
+    int32_t shallow;             // Nonzero to skip the children of nested compositions
+} OtioSearchFilter;
+
+// Walk the descendants of a track, stack or timeline in depth-first order,
+// parents before their children, without collecting them up front. Subtrees
+// outside search_range are skipped. filter may be NULL to match everything.
+// The composition (or timeline) must outlive the cursor; an edit made through
+// this API while it is open ends the walk with an error until it is reset.
+OtioSearchCursor* otio_track_search(OtioTrack* track, const OtioSearchFilter* filter, OtioError* err);
+OtioSearchCursor* otio_stack_search(OtioStack* stack, const OtioSearchFilter* filter, OtioError* err);
+OtioSearchCursor* otio_timeline_search(OtioTimeline* tl, const OtioSearchFilter* filter, OtioError* err);
+void otio_search_cursor_free(OtioSearchCursor* cursor);
+
+// Next matching item and its OTIO_CHILD_TYPE_* in child_type (may be NULL).
+// Returns NULL at the end, or on error with err set.
+void* otio_search_cursor_next(OtioSearchCursor* cursor, int32_t* child_type, OtioError* err);
+// Restart the walk from the beginning
+void otio_search_cursor_reset(OtioSearchCursor* cursor);
+
+// ----------------------------------------------------------------------------
+// Asset index (inverted index over media URLs and metadata values)
+// ----------------------------------------------------------------------------
+
+typedef struct OtioAssetIndex OtioAssetIndex;
+
+typedef struct {
+    void* handle;        // Borrowed item handle
+    int32_t child_type;  // OTIO_CHILD_TYPE_*
+} OtioIndexedItem;
+
+// Map every clip of a timeline's tracks by the target URLs of its external
+// references, and every item by the string values of the given metadata keys.
+// The timeline must outlive the index. Metadata setters and media
+// reference setters of this API update it in place; adding or removing items
+// through this API makes the next query rebuild it. Changing the URL of a
+// reference that is already attached to a clip is not seen.
+OtioAssetIndex* otio_timeline_build_asset_index(OtioTimeline* tl, const char* const* metadata_keys,
+    int32_t key_count, OtioError* err);
+void otio_asset_index_free(OtioAssetIndex* index);
+
+// Items filed under url, or under value for an indexed metadata key, in
+// document order (items updated since the index was built come last).
+// Returns the total number of items, which can exceed capacity (only the
+// first capacity items are written; items may be NULL to only count), or -1
+// on error.
+int32_t otio_asset_index_find_url(OtioAssetIndex* index, const char* url,
+    OtioIndexedItem* items, int32_t capacity, OtioError* err);
+int32_t otio_asset_index_find_metadata(OtioAssetIndex* index, const char* key, const char* value,
+    OtioIndexedItem* items, int32_t capacity, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Change tracking and patches
+// ----------------------------------------------------------------------------
+
+typedef struct OtioChangeTracker OtioChangeTracker;
+
+// Record what this API changes in a timeline from now on: setters, metadata
+// setters, inserts and removals, and the edit algorithms. The timeline must
+// outlive the tracker. Like the asset index it does not see edits made
+// directly through OTIO, added or edited markers and effects, or changes to a
+// media reference after it was attached to a clip.
+OtioChangeTracker* otio_timeline_track_changes(OtioTimeline* tl, OtioError* err);
+void otio_change_tracker_free(OtioChangeTracker* tracker);
+// 1 if anything was recorded since the last patch, 0 otherwise
+int32_t otio_change_tracker_has_changes(OtioChangeTracker* tracker);
+
+// JSON patch that turns the timeline as of the previous patch (or of
+// otio_timeline_track_changes) into the current one, and start recording
+// anew. Its size follows the edits, not the timeline:
+//   {"OTIO_PATCH": 1, "ops": [op, ...]}
+// where each op is one of
+//   {"op": "timeline", "value": Timeline}    name, start time and metadata
+//                                            (its tracks are empty)
+//   {"op": "fields", "path": P, "value": T}  fields of the track or stack at
+//                                            P, T without children
+//   {"op": "splice", "path": P, "start": i, "remove": n, "insert": [...]}
+//                                            replace n children of P from i
+//   {"op": "set", "path": P, "value": item}  replace the item at P
+// A path lists child indices from the timeline's stack down (the stack
+// itself is []). Ops are in order, with paths as of after the previous ops.
+// Caller frees the result with otio_free_string; NULL on error.
+char* otio_change_tracker_take_patch(OtioChangeTracker* tracker, OtioError* err);
+
+// Apply a patch to a timeline equal to the one it was taken from. Every
+// value is parsed before anything changes; a path that doesn't match the
+// timeline fails with the ops before it applied. Returns 0 or -1.
+int otio_timeline_apply_patch(OtioTimeline* tl, const char* patch, size_t len, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Undo journal
+// ----------------------------------------------------------------------------
+
+typedef struct OtioUndoJournal OtioUndoJournal;
+
+// Record an undo step for each edit this API makes to the timeline from now
+// on, keeping the newest depth steps. A step stores the inverse of its edit
+// (the children it removed, the value a setter replaced) or, for the edit
+// algorithms, the children and source ranges of the one composition they
+// changed, so its cost follows the width of that composition rather than
+// the whole timeline. It sees what change tracking sees: markers, effects
+// and edits made directly through OTIO are not recorded, and undoing past
+// them fails where the timeline no longer matches a step. One journal per
+// timeline, which must outlive it; the journal keeps any item a step
+// removed alive.
+OtioUndoJournal* otio_timeline_enable_undo(OtioTimeline* tl, int32_t depth, OtioError* err);
+void otio_undo_journal_free(OtioUndoJournal* journal);
+int32_t otio_undo_journal_undo_count(OtioUndoJournal* journal);
+int32_t otio_undo_journal_redo_count(OtioUndoJournal* journal);
+
+// Revert the newest step and make it the newest redo step, or the reverse.
+// Listeners are notified as for the original edit, so change tracking sends
+// an undo like any edit. Any new edit clears the redo steps. Return 1 if a
+// step was applied, 0 if there was none, -1 on error: a group is open, or
+// the step does not match the timeline, which reverts the part of the step
+// already applied and clears the journal.
+int otio_undo_journal_undo(OtioUndoJournal* journal, OtioError* err);
+int otio_undo_journal_redo(OtioUndoJournal* journal, OtioError* err);
+
+// Edits between begin and end (which nest) form one step. A patch applied
+// with otio_timeline_apply_patch is always one step.
+void otio_undo_journal_begin_group(OtioUndoJournal* journal);
+void otio_undo_journal_end_group(OtioUndoJournal* journal);
+
+// Drop all steps
+void otio_undo_journal_clear(OtioUndoJournal* journal);
+
+// ----------------------------------------------------------------------------
+// Cloning
+// ----------------------------------------------------------------------------
+
+// Copies are made in memory from the object graph, without serializing.
+// OTIO_CLONE_DEEP copies everything. OTIO_CLONE_SHARED shares markers,
+// effects and media references with the original instead: cheaper for
+// forks that mostly differ in structure and metadata. This API never edits
+// a media reference once it is attached, and the *_at_mut marker and
+// effect getters copy a shared marker or effect into the tree they are
+// called on before returning it, so edits never leak between forks. The
+// read-only *_at getters leave it shared.
+// Metadata is always copied. Shared objects are kept alive by reference
+// counts that OTIO changes under each object's own lock, so forks may be
+// used and freed on different threads, as the background release does.
+#define OTIO_CLONE_DEEP   0
+#define OTIO_CLONE_SHARED 1
+
+// Each returns a new object owned by the caller (free it with the matching
+// _free, or attach it), or NULL on error. A cloned track, stack or clip has
+// no parent; a cloned timeline has no journal, tracker or index attached.
+OtioTimeline* otio_timeline_clone(OtioTimeline* tl, int32_t mode, OtioError* err);
+OtioTrack* otio_track_clone(OtioTrack* track, int32_t mode, OtioError* err);
+OtioStack* otio_stack_clone(OtioStack* stack, int32_t mode, OtioError* err);
+OtioClip* otio_clip_clone(OtioClip* clip, int32_t mode, OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Typed metadata
+// ----------------------------------------------------------------------------
+
+// Kinds of metadata values; also the tag bytes of the encoding below.
+#define OTIO_METADATA_NULL   0
+#define OTIO_METADATA_BOOL   1
+#define OTIO_METADATA_INT    2
+#define OTIO_METADATA_DOUBLE 3
+#define OTIO_METADATA_STRING 4
+#define OTIO_METADATA_DICT   5
+#define OTIO_METADATA_ARRAY  6
+#define OTIO_METADATA_OTHER  7  // Times, ranges, schema objects
+
+// These take any object handle with metadata (every OTIO_OBJECT_TYPE_* schema).
+// Unlike the string accessors above they read values in place, so numbers
+// and flags need no string conversion.
+
+// Kind of the value under key, or -1 if there is none
+int32_t otio_metadata_kind(void* obj, const char* key);
+
+// Return 1 and store the value in out if key holds a value of that kind,
+// 0 otherwise. Any integer type that fits is read as int64; floats as double.
+int32_t otio_metadata_get_int64(void* obj, const char* key, int64_t* out);
+int32_t otio_metadata_get_double(void* obj, const char* key, double* out);
+int32_t otio_metadata_get_bool(void* obj, const char* key, int32_t* out);
+
+// Return 0 on success, -1 on error (obj has no metadata)
+int32_t otio_metadata_set_int64(void* obj, const char* key, int64_t value, OtioError* err);
+int32_t otio_metadata_set_double(void* obj, const char* key, double value, OtioError* err);
+int32_t otio_metadata_set_bool(void* obj, const char* key, int32_t value, OtioError* err);
+
+// Encoding, little-endian: a tag byte, then
+//   NULL            nothing
+//   BOOL            one byte, 0 or 1
+//   INT, DOUBLE     8 bytes (int64, IEEE 754 double)
+//   STRING, OTHER   uint32 length and the bytes (OTHER: the type's name)
+//   DICT            uint32 count, then count pairs of (uint32 key length,
+//                   key bytes, value) in key order
+//   ARRAY           uint32 count, then count values
+
+// Encode all metadata of obj as one DICT value. Returns the encoded size;
+// buffer is only written if it holds that many bytes (pass NULL or 0 to
+// measure). Returns -1 on error.
+int64_t otio_metadata_export(void* obj, uint8_t* buffer, size_t capacity, OtioError* err);
+// Same for the value under key; returns 0 if there is none.
+int64_t otio_metadata_export_value(void* obj, const char* key, uint8_t* buffer, size_t capacity,
+    OtioError* err);
+// Decode exactly one value from data and store it under key. OTHER values
+// can't be decoded. Returns 0 on success, -1 on error.
+int32_t otio_metadata_import_value(void* obj, const char* key, const uint8_t* data, size_t len,
+    OtioError* err);
+
+// ----------------------------------------------------------------------------
+// Render manifests
+// ----------------------------------------------------------------------------
+
+// What every frame of a track or stack shows over a range, resolved once so
+// it can be sliced without the object graph. Frames are counted from the
+// start of the range at its rate. Within a run both the source time and the
+// URL index advance by a constant step per frame:
+//   source time of frame f = source_start + (f - frame_start) * source_step
+//   URL index of frame f   = url_index + (f - frame_start) * url_step
+// Linear time warps scale source_step, and a freeze frame makes it 0. Image
+// sequences get one URL per image (url_step 1 while playing forward
+// through new images); other references have a single URL.
+//
+// In a transition, runs for the item under the frame (layer 0) are
+// followed by runs for the item on the other side of the cut (layer 1),
+// sampled past its own range into its handles; a layer 1 run without a
+// clip is a transition from or to nothing. A stack shows the topmost child
+// with something at the frame. Disabled items show nothing.
+typedef struct OtioRenderManifest OtioRenderManifest;
+
+typedef struct {
+    int64_t frame_start;
+    int64_t frame_count;
+    OtioClip* clip;        // NULL where nothing is shown
+    double source_start;
+    double source_step;
+    double source_rate;
+    int32_t url_index;     // -1 without a URL (gaps, missing images)
+    int32_t url_step;
+    int32_t transition;    // Index into the manifest's transitions, -1 outside
+    int32_t layer;         // 0 or 1, see above
+} OtioManifestRun;
+
+typedef struct {
+    int64_t frame_start;   // Frames of the manifest the transition covers
+    int64_t frame_count;
+    OtioTransition* transition;
+} OtioManifestTransition;
+
+// range is in the track's or stack's own time. Handles in runs point into
+// the graph and are only valid while it is alive and unchanged; everything
+// else is copied into the manifest.
+OtioRenderManifest* otio_track_build_render_manifest(OtioTrack* track, OtioTimeRange range,
+    OtioError* err);
+OtioRenderManifest* otio_stack_build_render_manifest(OtioStack* stack, OtioTimeRange range,
+    OtioError* err);
+// The same manifest, built on up to thread_count threads (<= 0 uses one
+// per hardware thread). Each child of a stack, or a track as a whole, is
+// sampled in chunks of frames on the worker pool, and the topmost child is
+// picked per frame on the calling thread.
+//
+// Thread safety: workers only read the graph, so several builds, and other
+// read-only calls, can run over the same timeline at once. Nothing may
+// modify the timeline, its items or their media references and effects
+// while a build runs.
+OtioRenderManifest* otio_track_build_render_manifest_parallel(OtioTrack* track, OtioTimeRange range,
+    int32_t thread_count, OtioError* err);
+OtioRenderManifest* otio_stack_build_render_manifest_parallel(OtioStack* stack, OtioTimeRange range,
+    int32_t thread_count, OtioError* err);
+void otio_render_manifest_free(OtioRenderManifest* manifest);
+
+double otio_render_manifest_rate(OtioRenderManifest* manifest);
+int64_t otio_render_manifest_frame_count(OtioRenderManifest* manifest);
+// Runs ordered by frame_start, layer 0 first. Return the total count, which
+// can exceed capacity (only the first capacity entries are written; the
+// array may be NULL to only count).
+int32_t otio_render_manifest_runs(OtioRenderManifest* manifest, OtioManifestRun* runs, int32_t capacity);
+int32_t otio_render_manifest_transitions(OtioRenderManifest* manifest,
+    OtioManifestTransition* transitions, int32_t capacity);
+// Interned URLs; views are valid until the manifest is freed
+int32_t otio_render_manifest_url_count(OtioRenderManifest* manifest);
+OtioStringView otio_render_manifest_url(OtioRenderManifest* manifest, int32_t index);
+
+// ----------------------------------------------------------------------------
+// Fingerprints
+// ----------------------------------------------------------------------------
+
+// 64-bit content hashes of an object, computed from its fields (not from its
+// JSON) with an xxHash64-style mix. Equal content gives equal fingerprints
+// in every process and on every platform for a given version of this shim,
+// so they can key caches of derived data such as renders or conforms.
+// Names, ranges, metadata, media references, markers, effects and children
+// in order are all covered; objects of schemas this API doesn't know are
+// hashed from their JSON.
+typedef struct OtioFingerprintCache OtioFingerprintCache;
+
+typedef struct {
+    uint64_t hits;     // Subtrees whose memoized fingerprint was reused
+    uint64_t misses;   // Subtrees fingerprinted afresh
+    uint64_t entries;  // Subtrees memoized
+} OtioFingerprintCacheStats;
+
+// Fingerprint any handle: a composable (with its children), a timeline, a
+// marker, an effect or a media reference. Returns 0, or -1 on error (an
+// object of an unknown schema could not be serialized).
+int otio_object_fingerprint(void* obj, uint64_t* out, OtioError* err);
+
+// Memoize the fingerprints of the timeline's items, so that fingerprinting
+// again after an edit rehashes only the edited items and their ancestors,
+// each ancestor updating its children's digest for the one changed child.
+// Changes made through this API forget the memoized fingerprints on the
+// parent chain of the changed object. Not seen: edits made directly through
+// OTIO and changes to a media reference after it was attached to a clip; a
+// marker or effect handle obtained from an item counts as an edit of the
+// item when it is obtained. The cache keeps items it fingerprinted alive
+// until they are compacted away or the cache is freed; the timeline must
+// outlive it. One cache per timeline; returns NULL with an error if it
+// already has one.
+OtioFingerprintCache* otio_timeline_enable_fingerprint_cache(OtioTimeline* tl, OtioError* err);
+void otio_fingerprint_cache_free(OtioFingerprintCache* cache);
+void otio_fingerprint_cache_get_stats(OtioFingerprintCache* cache, OtioFingerprintCacheStats* stats);
+
+// ----------------------------------------------------------------------------
+// Timeline diff
+// ----------------------------------------------------------------------------
+
+// What changed between two revisions of a timeline, computed on the object
+// graphs. Every item is fingerprinted from its fields; subtrees with equal
+// fingerprints are skipped without looking inside. Children of a changed
+// track or stack are matched first by content, then by schema and name in
+// order, then by content apart from the name (a rename). Items left over
+// are matched across parents the same way (a move, except that unnamed
+// items don't move by name alone), and what remains was added or removed.
+// The contents of an added or removed track or stack are not listed.
+typedef struct OtioTimelineDiff OtioTimelineDiff;
+
+#define OTIO_DIFF_ADDED   0  // Only in after
+#define OTIO_DIFF_REMOVED 1  // Only in before
+#define OTIO_DIFF_CHANGED 2  // In both, changes says how
+
+// Bits of OtioDiffOp.changes and of otio_timeline_diff_timeline_changes
+#define OTIO_DIFF_MOVED    (1 << 0)  // Another parent, or reordered among its siblings
+#define OTIO_DIFF_RETIMED  (1 << 1)  // Source range, or a transition's offsets
+#define OTIO_DIFF_MEDIA    (1 << 2)  // Media references or the active key
+#define OTIO_DIFF_METADATA (1 << 3)
+#define OTIO_DIFF_RENAMED  (1 << 4)
+#define OTIO_DIFF_FIELDS   (1 << 5)  // Anything else of the item itself: enabled,
+                                     // effects, markers, kind, global start time
+
+typedef struct {
+    int32_t kind;          // OTIO_DIFF_ADDED, _REMOVED or _CHANGED
+    int32_t changes;       // OTIO_DIFF_* bits, 0 unless kind is _CHANGED
+    void* before;          // Item in before, NULL if added
+    int32_t before_type;   // OTIO_CHILD_TYPE_*, -1 for other schemas
+    int32_t before_index;  // Index in its parent, -1 for the tracks stack
+    void* after;           // Item in after, NULL if removed
+    int32_t after_type;
+    int32_t after_index;
+} OtioDiffOp;
+
+// Compare two timelines. Their stacks of tracks are always matched with
+// each other. Returns NULL on error (an object of a schema this API doesn't
+// know could not be serialized for its fingerprint).
+OtioTimelineDiff* otio_timeline_diff(OtioTimeline* before, OtioTimeline* after, OtioError* err);
+void otio_timeline_diff_free(OtioTimelineDiff* diff);
+
+// OTIO_DIFF_* bits for the timelines themselves: name, metadata, fields
+int32_t otio_timeline_diff_timeline_changes(OtioTimelineDiff* diff);
+// Removals in the order of before, then additions and changes in the order
+// of after. Handles are valid while both timelines are alive and unchanged.
+// Returns the total count, which can exceed capacity (only the first
+// capacity entries are written; ops may be NULL to only count).
+int32_t otio_timeline_diff_ops(OtioTimelineDiff* diff, OtioDiffOp* ops, int32_t capacity);
+
+// ----------------------------------------------------------------------------
+// Instrumentation
+// ----------------------------------------------------------------------------
+
+// Counters and timers of the shim's hot paths, kept per thread and summed on
+// read. Only collected when the shim is built with OTIO_SHIM_WITH_STATS;
+// without it they compile out entirely and the snapshot is empty. Ids index
+// the snapshot table.
+#define OTIO_STAT_PARSE            0  // OTIO reading JSON into objects (bytes: JSON read)
+#define OTIO_STAT_SERIALIZE        1  // OTIO writing objects as JSON (bytes: JSON written)
+#define OTIO_STAT_BINARY           2  // Binary form to or from JSON, around OTIO's parse or write
+#define OTIO_STAT_ITERATE          3  // Clip, track, search and flatten walks (not _next calls)
+#define OTIO_STAT_RANGE            4  // range_of_child_at_index, trimmed_range, range_in_parent
+#define OTIO_STAT_TRANSFORMED_TIME 5  // otio_item_transformed_time, _time_range, _times, _frames
+#define OTIO_STAT_EDIT             6  // Edit algorithms, one call per queued edit of a batch
+#define OTIO_STAT_DYNAMIC_CAST     7  // Count only
+#define OTIO_STAT_STRDUP           8  // Strings copied out (bytes: with terminators)
+#define OTIO_STAT_EXCEPTION        9  // Exceptions caught by the shim's error macros
+#define OTIO_STAT_COUNT            10
+
+typedef struct {
+    const char* name;      // Static string, "parse" for OTIO_STAT_PARSE, ...
+    uint64_t calls;
+    uint64_t nanoseconds;  // Wall time inside the calls, 0 for counts
+    uint64_t bytes;        // 0 where no bytes are counted
+} OtioStat;
+
+// Returns nonzero if the shim was built with instrumentation.
+int32_t otio_stats_supported(void);
+// Totals over all threads since the last reset, indexed by OTIO_STAT_*.
+// Returns the number of stats (OTIO_STAT_COUNT, or 0 when not built in);
+// only the first capacity are written, and stats may be NULL to only count.
+// Counters of threads running meanwhile may be a few calls behind.
+int32_t otio_stats_snapshot(OtioStat* stats, int32_t capacity);
+// Start counting from zero again, for every thread.
+void otio_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,19 @@
         } \
     }
 
+// Generate a string view getter: OtioStringView otio_<ctype>_get_<method>_view(Otio<Type>* obj)
+// The view points into the calling thread's scratch buffer (see scratch_string_view)
+#define OTIO_STRING_VIEW_GETTER(Type, ctype, method) \
+    OtioStringView otio_##ctype##_get_##method##_view(Otio##Type* obj) { \
+        if (!obj) return OtioStringView{nullptr, 0}; \
+        try { \
+            auto typed = reinterpret_cast<otio::Type*>(obj); \
+            return scratch_string_view(typed->method()); \
+        } catch (...) { \
+            return OtioStringView{nullptr, 0}; \
+        } \
+    }
+
 // ============================================================================
 // TimeRange Accessor Macros
 // ============================================================================
@@ -192,6 +205,12 @@
         return get_metadata_string_impl(reinterpret_cast<otio::Type*>(obj), key); \
     }
 
+// Generate a borrowed metadata view getter for a type
+#define OTIO_METADATA_VIEW_IMPL(Type, ctype) \
+    OtioStringView otio_##ctype##_get_metadata_string_view(Otio##Type* obj, const char* key) { \
+        return get_metadata_string_view_impl(reinterpret_cast<otio::Type*>(obj), key); \
+    }
+
 // ============================================================================
 // Type Creation/Destruction Macros
 // ============================================================================
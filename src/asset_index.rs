@@ -0,0 +1,136 @@
+//! Inverted index from media URLs and metadata values to items.
+//!
+//! An [`AssetIndex`] answers "which clips reference this file" and "which
+//! items have this metadata value" with a hash lookup instead of a walk
+//! over the whole timeline. Metadata and media reference setters of this
+//! crate keep it current.
+
+use std::ffi::CString;
+use std::marker::PhantomData;
+
+use crate::iterators::composable_from_ffi;
+use crate::{ffi, macros, Composable, OtioError, Result};
+
+/// Hash index over the media URLs and selected metadata of a timeline.
+///
+/// Built by [`Timeline::build_asset_index`](crate::Timeline::build_asset_index).
+/// Clips are filed under the target URL of each of their external
+/// references, and every item under the string value of each indexed
+/// metadata key. Setting metadata or media references through this crate
+/// updates the entry of that one item; adding or removing items makes the
+/// next query rebuild the index. Changing the URL of a reference that is
+/// already attached to a clip is not seen. The index and the items it finds
+/// borrow the timeline.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Composable, Timeline};
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let index = timeline.build_asset_index(&["vfx_id"]).unwrap();
+/// for item in index.find_url("s3://show/plates/shot_0420.exr").unwrap() {
+///     if let Composable::Clip(clip) = item {
+///         println!("{}", clip.name());
+///     }
+/// }
+/// println!("{} items", index.find_metadata("vfx_id", "VFX-0420").unwrap().len());
+/// ```
+pub struct AssetIndex<'a> {
+    ptr: *mut ffi::OtioAssetIndex,
+    _timeline: PhantomData<&'a ()>,
+}
+
+impl<'a> AssetIndex<'a> {
+    /// Initial result buffer size; the query is repeated once with the exact
+    /// size if more items match.
+    const INITIAL_CAPACITY: usize = 16;
+
+    pub(crate) fn build(open: impl FnOnce(*mut ffi::OtioError) -> *mut ffi::OtioAssetIndex) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(&mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self {
+            ptr,
+            _timeline: PhantomData,
+        })
+    }
+
+    /// Find the clips with an external reference to exactly `url`, in
+    /// document order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index has to be rebuilt and that fails.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `url` contains a NUL byte.
+    pub fn find_url(&self, url: &str) -> Result<Vec<Composable<'a>>> {
+        let c_url = CString::new(url).unwrap();
+        self.collect(|index, items, capacity, err| unsafe {
+            ffi::otio_asset_index_find_url(index, c_url.as_ptr(), items, capacity, err)
+        })
+    }
+
+    /// Find the items whose metadata has `key` set to the string `value`,
+    /// in document order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `key` was not passed to `build_asset_index`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `key` or `value` contains a NUL byte.
+    pub fn find_metadata(&self, key: &str, value: &str) -> Result<Vec<Composable<'a>>> {
+        let c_key = CString::new(key).unwrap();
+        let c_value = CString::new(value).unwrap();
+        self.collect(|index, items, capacity, err| unsafe {
+            ffi::otio_asset_index_find_metadata(index, c_key.as_ptr(), c_value.as_ptr(), items, capacity, err)
+        })
+    }
+
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    fn collect(
+        &self,
+        mut run: impl FnMut(*mut ffi::OtioAssetIndex, *mut ffi::OtioIndexedItem, i32, *mut ffi::OtioError) -> i32,
+    ) -> Result<Vec<Composable<'a>>> {
+        let empty = ffi::OtioIndexedItem {
+            handle: std::ptr::null_mut(),
+            child_type: -1,
+        };
+        let mut raw = vec![empty; Self::INITIAL_CAPACITY];
+        loop {
+            let mut err = macros::ffi_error!();
+            let total = run(self.ptr, raw.as_mut_ptr(), raw.len() as i32, &mut err);
+            if total < 0 {
+                return Err(OtioError::from(err));
+            }
+            let total = total as usize;
+            if total <= raw.len() {
+                raw.truncate(total);
+                break;
+            }
+            raw.resize(total, empty);
+        }
+        Ok(raw
+            .iter()
+            .filter_map(|item| composable_from_ffi(item.handle, item.child_type))
+            .collect())
+    }
+}
+
+impl std::fmt::Debug for AssetIndex<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("AssetIndex").finish_non_exhaustive()
+    }
+}
+
+impl Drop for AssetIndex<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_asset_index_free(self.ptr) }
+    }
+}
@@ -7,7 +7,10 @@
 //! - `build()` - Returns `Result<T>`, propagating any errors
 //! - `build_unchecked()` - Returns `T`, ignoring any errors (for convenience)
 
-use crate::{Clip, ExternalReference, HasMetadata, RationalTime, Result, TimeRange, Timeline};
+use crate::{
+    ffi, macros, Clip, ExternalReference, HasMetadata, RationalTime, Result, TimeRange, Timeline,
+    Track,
+};
 
 /// Builder for creating `Clip` instances.
 ///
@@ -264,6 +267,199 @@ impl ExternalReferenceBuilder {
     }
 }
 
+/// Builder for appending many clips to a track in one call.
+///
+/// Every string is packed into a single buffer and the clips are created on
+/// the C++ side from one descriptor array, instead of one round trip per
+/// clip, reference and metadata entry.
+///
+/// `target_url`, `available_range` and `metadata` apply to the clip most
+/// recently added with `clip`.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{ClipBatchBuilder, RationalTime, TimeRange, Track};
+///
+/// let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0));
+/// let mut batch = ClipBatchBuilder::with_capacity(1000);
+/// for i in 0..1000 {
+///     batch = batch
+///         .clip(&format!("Shot {i}"), range)
+///         .target_url(&format!("/media/shot_{i}.mov"))
+///         .metadata("reel", "A001");
+/// }
+/// let mut track = Track::new_video("V1");
+/// batch.append_to(&mut track).unwrap();
+/// ```
+#[derive(Debug, Default)]
+pub struct ClipBatchBuilder {
+    // Every string, NUL-terminated, back to back
+    strings: Vec<u8>,
+    clips: Vec<PackedClip>,
+    // Offsets of metadata keys and values in `strings`
+    metadata: Vec<(usize, usize)>,
+}
+
+#[derive(Debug)]
+struct PackedClip {
+    name: usize,
+    source_range: TimeRange,
+    target_url: Option<usize>,
+    available_range: Option<TimeRange>,
+    metadata: std::ops::Range<usize>,
+}
+
+impl ClipBatchBuilder {
+    /// Create an empty batch.
+    #[must_use]
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Create an empty batch with room for `clips` clips.
+    #[must_use]
+    pub fn with_capacity(clips: usize) -> Self {
+        Self {
+            strings: Vec::with_capacity(clips * 32),
+            clips: Vec::with_capacity(clips),
+            metadata: Vec::new(),
+        }
+    }
+
+    /// Add a clip with the required name and source range.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `name` contains a NUL byte.
+    #[must_use]
+    pub fn clip(mut self, name: &str, source_range: TimeRange) -> Self {
+        let name = self.push_str(name);
+        let start = self.metadata.len();
+        self.clips.push(PackedClip {
+            name,
+            source_range,
+            target_url: None,
+            available_range: None,
+            metadata: start..start,
+        });
+        self
+    }
+
+    /// Give the last clip an external media reference.
+    ///
+    /// # Panics
+    ///
+    /// Panics if no clip was added yet or `url` contains a NUL byte.
+    #[must_use]
+    pub fn target_url(mut self, url: &str) -> Self {
+        let url = self.push_str(url);
+        self.last_clip().target_url = Some(url);
+        self
+    }
+
+    /// Set the available range of the last clip's media reference.
+    ///
+    /// Ignored if the clip has no `target_url`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if no clip was added yet.
+    #[must_use]
+    pub fn available_range(mut self, range: TimeRange) -> Self {
+        self.last_clip().available_range = Some(range);
+        self
+    }
+
+    /// Add a metadata key-value pair to the last clip.
+    ///
+    /// # Panics
+    ///
+    /// Panics if no clip was added yet or either string contains a NUL byte.
+    #[must_use]
+    pub fn metadata(mut self, key: &str, value: &str) -> Self {
+        let pair = (self.push_str(key), self.push_str(value));
+        self.metadata.push(pair);
+        let end = self.metadata.len();
+        self.last_clip().metadata.end = end;
+        self
+    }
+
+    /// Get the number of clips in the batch.
+    #[must_use]
+    pub fn len(&self) -> usize {
+        self.clips.len()
+    }
+
+    /// Check whether the batch has no clips.
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.clips.is_empty()
+    }
+
+    /// Create every clip and append them to `track` in order.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the clips cannot be appended; the track is then
+    /// left unchanged.
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn append_to(self, track: &mut Track) -> Result<()> {
+        let base = self.strings.as_ptr();
+        let at = |offset: usize| -> *const std::ffi::c_char { unsafe { base.add(offset).cast() } };
+        let pairs: Vec<ffi::OtioMetadataPair> = self
+            .metadata
+            .iter()
+            .map(|&(key, value)| ffi::OtioMetadataPair {
+                key: at(key),
+                value: at(value),
+            })
+            .collect();
+        let descriptors: Vec<ffi::OtioClipDescriptor> = self
+            .clips
+            .iter()
+            .map(|clip| ffi::OtioClipDescriptor {
+                name: at(clip.name),
+                source_range: clip.source_range.into(),
+                target_url: clip.target_url.map_or(std::ptr::null(), at),
+                has_available_range: i32::from(clip.available_range.is_some()),
+                available_range: clip.available_range.unwrap_or(clip.source_range).into(),
+                metadata: if clip.metadata.is_empty() {
+                    std::ptr::null()
+                } else {
+                    pairs[clip.metadata.start..].as_ptr()
+                },
+                metadata_count: clip.metadata.len() as i32,
+            })
+            .collect();
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_track_append_clip_descriptors(
+                track.ptr,
+                descriptors.as_ptr(),
+                descriptors.len() as i32,
+                &mut err,
+            )
+        };
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
+    fn push_str(&mut self, s: &str) -> usize {
+        assert!(!s.as_bytes().contains(&0), "string contains a NUL byte");
+        let offset = self.strings.len();
+        self.strings.extend_from_slice(s.as_bytes());
+        self.strings.push(0);
+        offset
+    }
+
+    fn last_clip(&mut self) -> &mut PackedClip {
+        self.clips.last_mut().expect("no clip added to the batch yet")
+    }
+}
+
 // Convenience methods on the types themselves
 
 impl Clip {
@@ -0,0 +1,102 @@
+//! Change tracking and incremental patches.
+//!
+//! A [`ChangeTracker`] records which items were edited through this crate,
+//! so that saving or syncing an edit costs in proportion to the edit instead
+//! of the whole timeline. [`ChangeTracker::take_patch`] returns the changed
+//! subtrees as a small JSON document and
+//! [`Timeline::apply_patch`](crate::Timeline::apply_patch) replays it on a
+//! copy of the timeline.
+
+use crate::{ffi, ffi_string_to_rust, macros, OtioError, Result, Timeline, TimelineMut};
+
+/// Records the edits made to a timeline so they can be sent as patches.
+///
+/// Created by [`Timeline::track_changes`](crate::Timeline::track_changes).
+/// The tracker borrows the timeline for as long as it records; edit the
+/// timeline itself through [`timeline_mut`](Self::timeline_mut), and its
+/// tracks and items through their own handles. Setters, metadata setters, inserts and removals, and the edit algorithms
+/// of this crate are recorded. Markers and effects, changes to a media
+/// reference after it was attached to a clip, and anything done directly
+/// through OTIO are not.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{HasMetadata, Timeline};
+///
+/// let mut timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let mut replica = Timeline::from_json_string(&timeline.to_json_string().unwrap()).unwrap();
+///
+/// let mut changes = timeline.track_changes().unwrap();
+/// changes.timeline_mut().set_metadata("status", "approved");
+/// let patch = changes.take_patch().unwrap();
+///
+/// replica.apply_patch(&patch).unwrap();
+/// assert_eq!(replica.get_metadata("status").as_deref(), Some("approved"));
+/// ```
+pub struct ChangeTracker<'a> {
+    ptr: *mut ffi::OtioChangeTracker,
+    timeline: &'a mut Timeline,
+}
+
+impl<'a> ChangeTracker<'a> {
+    pub(crate) fn open(
+        timeline: &'a mut Timeline,
+        open: impl FnOnce(*mut ffi::OtioTimeline, *mut ffi::OtioError) -> *mut ffi::OtioChangeTracker,
+    ) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(timeline.ptr, &mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self { ptr, timeline })
+    }
+
+    /// The tracked timeline.
+    #[must_use]
+    pub fn timeline(&self) -> &Timeline {
+        self.timeline
+    }
+
+    /// The tracked timeline, lent for modification.
+    pub fn timeline_mut(&mut self) -> TimelineMut<'_> {
+        TimelineMut::new(self.timeline)
+    }
+
+    /// Whether anything was recorded since the last patch.
+    #[must_use]
+    pub fn has_changes(&self) -> bool {
+        unsafe { ffi::otio_change_tracker_has_changes(self.ptr) != 0 }
+    }
+
+    /// The patch from the timeline as of the previous patch (or as of
+    /// `track_changes`) to the current one, after which recording starts
+    /// anew.
+    ///
+    /// The patch is a JSON document of the changed subtrees keyed by their
+    /// child index paths; its format is described in `otio_shim.h`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a changed item cannot be serialized.
+    pub fn take_patch(&self) -> Result<String> {
+        let mut err = macros::ffi_error!();
+        let ptr = unsafe { ffi::otio_change_tracker_take_patch(self.ptr, &mut err) };
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(ffi_string_to_rust(ptr))
+    }
+}
+
+impl std::fmt::Debug for ChangeTracker<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ChangeTracker").finish_non_exhaustive()
+    }
+}
+
+impl Drop for ChangeTracker<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_change_tracker_free(self.ptr) }
+    }
+}
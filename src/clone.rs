@@ -0,0 +1,119 @@
+//! In-memory copies of timelines and their items.
+//!
+//! The `duplicate` methods copy the object graph directly in the shim,
+//! without a round trip through JSON. [`CloneMode::Shared`] also shares
+//! markers, effects and media references between the copy and the original,
+//! which makes forking a large timeline per variant cheap.
+
+use crate::{ffi, macros, Clip, OtioError, Result, Stack, Timeline, Track};
+
+/// How the `duplicate` methods copy.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Default)]
+pub enum CloneMode {
+    /// Copy every object, as serializing and parsing again would.
+    #[default]
+    Deep,
+    /// Copy the timeline structure and metadata, but share markers, effects
+    /// and media references with the original. This crate never edits a
+    /// media reference once it is attached to a clip, and a shared marker
+    /// or effect is copied before the shim hands it out for editing, so
+    /// edits to one fork never show in another. Reading, as through
+    /// `markers()`, leaves it shared. The shared objects are
+    /// reference counted under their own locks, so forks can be moved to
+    /// and dropped on different threads.
+    Shared,
+}
+
+impl CloneMode {
+    /// `OTIO_CLONE_*` in `otio_shim.h`.
+    fn raw(self) -> i32 {
+        match self {
+            CloneMode::Deep => 0,
+            CloneMode::Shared => 1,
+        }
+    }
+}
+
+fn duplicate<T>(clone: impl FnOnce(i32, *mut ffi::OtioError) -> *mut T, mode: CloneMode) -> Result<*mut T> {
+    let mut err = macros::ffi_error!();
+    let ptr = clone(mode.raw(), &mut err);
+    if ptr.is_null() {
+        return Err(OtioError::from(err));
+    }
+    Ok(ptr)
+}
+
+pub(crate) fn duplicate_clip(clip: *mut ffi::OtioClip, mode: CloneMode) -> Result<Clip> {
+    let ptr = duplicate(|mode, err| unsafe { ffi::otio_clip_clone(clip, mode, err) }, mode)?;
+    Ok(Clip { ptr })
+}
+
+pub(crate) fn duplicate_track(track: *mut ffi::OtioTrack, mode: CloneMode) -> Result<Track> {
+    let ptr = duplicate(|mode, err| unsafe { ffi::otio_track_clone(track, mode, err) }, mode)?;
+    Ok(Track { ptr, owned: true })
+}
+
+impl Timeline {
+    /// Copy this timeline in memory.
+    ///
+    /// The copy has no undo journal, change tracker or index attached.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of the timeline cannot be copied.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{CloneMode, HasMetadata, Timeline};
+    ///
+    /// let master = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+    /// let deliveries: Vec<Timeline> = ["imax", "uhd", "hd"]
+    ///     .into_iter()
+    ///     .map(|spec| {
+    ///         let mut fork = master.duplicate(CloneMode::Shared).unwrap();
+    ///         fork.set_metadata("delivery", spec);
+    ///         fork
+    ///     })
+    ///     .collect();
+    /// ```
+    pub fn duplicate(&self, mode: CloneMode) -> Result<Timeline> {
+        let ptr = duplicate(|mode, err| unsafe { ffi::otio_timeline_clone(self.ptr, mode, err) }, mode)?;
+        Ok(Timeline { ptr })
+    }
+}
+
+impl Track {
+    /// Copy this track and everything in it. The copy has no parent.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of the track cannot be copied.
+    pub fn duplicate(&self, mode: CloneMode) -> Result<Track> {
+        duplicate_track(self.ptr, mode)
+    }
+}
+
+impl Stack {
+    /// Copy this stack and everything in it. The copy has no parent.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of the stack cannot be copied.
+    pub fn duplicate(&self, mode: CloneMode) -> Result<Stack> {
+        let ptr = duplicate(|mode, err| unsafe { ffi::otio_stack_clone(self.ptr, mode, err) }, mode)?;
+        Ok(Stack { ptr })
+    }
+}
+
+impl Clip {
+    /// Copy this clip. The copy has no parent.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a marker, effect or media reference of the clip
+    /// cannot be copied.
+    pub fn duplicate(&self, mode: CloneMode) -> Result<Clip> {
+        duplicate_clip(self.ptr, mode)
+    }
+}
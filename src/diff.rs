@@ -0,0 +1,213 @@
+//! Structural diffs between two revisions of a timeline.
+//!
+//! [`Timeline::diff`] compares the object graphs directly: the shim
+//! fingerprints every item from its fields, skips subtrees whose
+//! fingerprints match, and matches the rest by content, then by name. The
+//! result is a short list of [`DiffOp`]s rather than a text diff of two
+//! JSON documents.
+
+use std::ops::BitOr;
+
+use crate::iterators::composable_from_ffi;
+use crate::{ffi, macros, Composable, OtioError, Result, Timeline};
+
+/// Whether an item was added, removed or changed.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum DiffKind {
+    /// Only in the after timeline.
+    Added,
+    /// Only in the before timeline.
+    Removed,
+    /// In both; [`DiffOp::changes`] says how it differs.
+    Changed,
+}
+
+/// What differs about a changed item, or about the timelines themselves.
+#[derive(Clone, Copy, PartialEq, Eq, Hash, Default)]
+pub struct DiffChanges(i32);
+
+impl DiffChanges {
+    /// In another parent, or reordered among its siblings.
+    pub const MOVED: Self = Self(1 << 0);
+    /// The source range, or the offsets of a transition.
+    pub const RETIMED: Self = Self(1 << 1);
+    /// The media references or the active reference key.
+    pub const MEDIA: Self = Self(1 << 2);
+    /// The metadata.
+    pub const METADATA: Self = Self(1 << 3);
+    /// The name.
+    pub const RENAMED: Self = Self(1 << 4);
+    /// Anything else of the item itself: whether it is enabled, its effects and
+    /// markers, a track's kind, or a timeline's global start time.
+    pub const FIELDS: Self = Self(1 << 5);
+
+    const NAMES: [(Self, &'static str); 6] = [
+        (Self::MOVED, "MOVED"),
+        (Self::RETIMED, "RETIMED"),
+        (Self::MEDIA, "MEDIA"),
+        (Self::METADATA, "METADATA"),
+        (Self::RENAMED, "RENAMED"),
+        (Self::FIELDS, "FIELDS"),
+    ];
+
+    /// Whether every change in `other` is also in `self`.
+    #[must_use]
+    pub fn contains(self, other: Self) -> bool {
+        self.0 & other.0 == other.0
+    }
+
+    /// Whether nothing differs.
+    #[must_use]
+    pub fn is_empty(self) -> bool {
+        self.0 == 0
+    }
+}
+
+impl BitOr for DiffChanges {
+    type Output = Self;
+
+    fn bitor(self, other: Self) -> Self {
+        Self(self.0 | other.0)
+    }
+}
+
+impl std::fmt::Debug for DiffChanges {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        let names: Vec<&str> = Self::NAMES
+            .iter()
+            .filter(|(change, _)| self.contains(*change))
+            .map(|(_, name)| *name)
+            .collect();
+        write!(f, "DiffChanges({})", names.join(" | "))
+    }
+}
+
+/// One added, removed or changed item.
+///
+/// The contents of an added or removed track or stack are not listed
+/// separately.
+#[derive(Debug)]
+pub struct DiffOp<'a> {
+    /// Whether the item was added, removed or changed.
+    pub kind: DiffKind,
+    /// How a changed item differs; empty unless `kind` is
+    /// [`DiffKind::Changed`].
+    pub changes: DiffChanges,
+    /// The item in the before timeline, `None` if it was added (or is of a
+    /// schema this crate has no handle type for).
+    pub before: Option<Composable<'a>>,
+    /// Its index in its parent, `None` for the stack holding the tracks.
+    pub before_index: Option<usize>,
+    /// The item in the after timeline, `None` if it was removed (or is of a
+    /// schema this crate has no handle type for).
+    pub after: Option<Composable<'a>>,
+    /// Its index in its parent, `None` for the stack holding the tracks.
+    pub after_index: Option<usize>,
+}
+
+/// The differences between two timelines.
+///
+/// Built by [`Timeline::diff`]. Removals come first, in the order of the
+/// before timeline, then additions and changes in the order of the after
+/// timeline. The item handles borrow both timelines.
+#[derive(Debug)]
+pub struct TimelineDiff<'a> {
+    timeline_changes: DiffChanges,
+    ops: Vec<DiffOp<'a>>,
+}
+
+impl TimelineDiff<'_> {
+    /// What differs about the timelines themselves: their name, metadata or
+    /// global start time.
+    #[must_use]
+    pub fn timeline_changes(&self) -> DiffChanges {
+        self.timeline_changes
+    }
+
+    /// The added, removed and changed items.
+    #[must_use]
+    pub fn ops(&self) -> &[DiffOp<'_>] {
+        &self.ops
+    }
+
+    /// Whether the timelines are the same.
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.timeline_changes.is_empty() && self.ops.is_empty()
+    }
+}
+
+impl Timeline {
+    /// Compare this timeline, as the before revision, with `after`.
+    ///
+    /// Items are fingerprinted from their fields and identical subtrees are
+    /// skipped, so the cost follows the size of the timelines but not of
+    /// their serialized form. The children of a changed track or stack are
+    /// matched by content, then by schema and name in order, then by content
+    /// apart from the name (a rename). Items left over are matched across
+    /// parents (a move), and the rest were added or removed.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of a schema the shim doesn't know
+    /// cannot be serialized for its fingerprint.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{Composable, DiffChanges, DiffKind, Timeline};
+    ///
+    /// let v1 = Timeline::read_from_file(std::path::Path::new("cut_v1.otio")).unwrap();
+    /// let v2 = Timeline::read_from_file(std::path::Path::new("cut_v2.otio")).unwrap();
+    /// for op in v1.diff(&v2).unwrap().ops() {
+    ///     let Some(Composable::Clip(clip)) = op.after.as_ref().or(op.before.as_ref()) else {
+    ///         continue;
+    ///     };
+    ///     match op.kind {
+    ///         DiffKind::Added => println!("added {}", clip.name()),
+    ///         DiffKind::Removed => println!("removed {}", clip.name()),
+    ///         DiffKind::Changed if op.changes.contains(DiffChanges::RETIMED) => {
+    ///             println!("retimed {}", clip.name());
+    ///         }
+    ///         DiffKind::Changed => {}
+    ///     }
+    /// }
+    /// ```
+    #[allow(clippy::cast_sign_loss)]
+    pub fn diff<'a>(&'a self, after: &'a Timeline) -> Result<TimelineDiff<'a>> {
+        let mut err = macros::ffi_error!();
+        let ptr = unsafe { ffi::otio_timeline_diff(self.ptr, after.ptr, &mut err) };
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+
+        let count = unsafe { ffi::otio_timeline_diff_ops(ptr, std::ptr::null_mut(), 0) };
+        let mut raw = Vec::with_capacity(count.max(0) as usize);
+        let written = unsafe { ffi::otio_timeline_diff_ops(ptr, raw.as_mut_ptr(), count) };
+        // SAFETY: the shim wrote min(total, capacity) entries
+        unsafe { raw.set_len(written.min(count).max(0) as usize) };
+        let timeline_changes = unsafe { ffi::otio_timeline_diff_timeline_changes(ptr) };
+        unsafe { ffi::otio_timeline_diff_free(ptr) };
+
+        let ops = raw
+            .iter()
+            .map(|op| DiffOp {
+                // OTIO_DIFF_ADDED, _REMOVED and _CHANGED
+                kind: match op.kind {
+                    0 => DiffKind::Added,
+                    1 => DiffKind::Removed,
+                    _ => DiffKind::Changed,
+                },
+                changes: DiffChanges(op.changes),
+                before: composable_from_ffi(op.before, op.before_type),
+                before_index: usize::try_from(op.before_index).ok(),
+                after: composable_from_ffi(op.after, op.after_type),
+                after_index: usize::try_from(op.after_index).ok(),
+            })
+            .collect();
+        Ok(TimelineDiff {
+            timeline_changes: DiffChanges(timeline_changes),
+            ops,
+        })
+    }
+}
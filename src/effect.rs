@@ -52,8 +52,10 @@ impl Effect {
 traits::impl_has_metadata!(
     Effect,
     otio_effect_set_metadata_string,
-    otio_effect_get_metadata_string
+    otio_effect_get_metadata_string,
+    otio_effect_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(Effect);
 
 impl Drop for Effect {
     fn drop(&mut self) {
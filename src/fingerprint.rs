@@ -0,0 +1,121 @@
+//! Content fingerprints and their memoization.
+//!
+//! [`HasFingerprint::fingerprint`](crate::HasFingerprint::fingerprint)
+//! hashes an object's fields and, for compositions, its children. While a
+//! [`FingerprintCache`] is alive for a timeline, the fingerprints of its items
+//! are memoized, and edits made through this crate only forget those of the
+//! edited item and its ancestors. Each ancestor rehashes just the child on
+//! the path to the edit, so fingerprinting the timeline again after an edit
+//! costs in proportion to the depth of the edit, not the size of the
+//! timeline. An edit to the children of a composition, or to its own
+//! fields, also looks up the memoized fingerprints of its other children.
+
+use std::marker::PhantomData;
+
+use crate::{ffi, macros, OtioError, Result, Timeline};
+
+pub(crate) fn fingerprint_of(ptr: *mut std::ffi::c_void) -> Result<u64> {
+    let mut err = macros::ffi_error!();
+    let mut out = 0;
+    if unsafe { ffi::otio_object_fingerprint(ptr, &mut out, &mut err) } != 0 {
+        return Err(OtioError::from(err));
+    }
+    Ok(out)
+}
+
+/// Counters reported by [`FingerprintCache::stats`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct FingerprintCacheStats {
+    /// Subtrees whose memoized fingerprint was reused.
+    pub hits: u64,
+    /// Subtrees fingerprinted afresh.
+    pub misses: u64,
+    /// Subtrees memoized.
+    pub entries: u64,
+}
+
+/// Memoizes the fingerprints of a timeline's items for as long as it lives.
+///
+/// Created by [`Timeline::enable_fingerprint_cache`], and borrows the
+/// timeline for as long as it lives. The memoized results
+/// are used by the existing `fingerprint` methods of the timeline and of
+/// everything in it. Setters, metadata setters, inserts and removals, and the
+/// edit algorithms of this crate forget what they change, and so does
+/// getting a marker or effect of an item (which can then be edited). Changes
+/// to a media reference after it was attached to a clip, and anything done
+/// directly through OTIO, are not seen.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{HasFingerprint, HasMetadata, Timeline};
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let cache = timeline.enable_fingerprint_cache().unwrap();
+/// let before = timeline.fingerprint().unwrap();
+///
+/// let mut clip = timeline.find_clips().next().unwrap();
+/// clip.set_metadata("status", "approved");
+/// // Rehashes the clip and its ancestors, not their siblings
+/// assert_ne!(timeline.fingerprint().unwrap(), before);
+/// println!("{:?}", cache.stats());
+/// ```
+pub struct FingerprintCache<'a> {
+    ptr: *mut ffi::OtioFingerprintCache,
+    _timeline: PhantomData<&'a Timeline>,
+}
+
+impl FingerprintCache<'_> {
+    /// Get the hit, miss and entry counters.
+    #[must_use]
+    pub fn stats(&self) -> FingerprintCacheStats {
+        let mut stats = ffi::OtioFingerprintCacheStats {
+            hits: 0,
+            misses: 0,
+            entries: 0,
+        };
+        unsafe { ffi::otio_fingerprint_cache_get_stats(self.ptr, &mut stats) };
+        FingerprintCacheStats {
+            hits: stats.hits,
+            misses: stats.misses,
+            entries: stats.entries,
+        }
+    }
+}
+
+impl std::fmt::Debug for FingerprintCache<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("FingerprintCache")
+            .field("stats", &self.stats())
+            .finish_non_exhaustive()
+    }
+}
+
+impl Drop for FingerprintCache<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_fingerprint_cache_free(self.ptr) }
+    }
+}
+
+impl Timeline {
+    /// Memoize the fingerprints of this timeline's items while the returned
+    /// [`FingerprintCache`] lives.
+    ///
+    /// The cache keeps the items it fingerprinted alive until it is dropped
+    /// or they have been out of the timeline across a compaction of the memo.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if caching is already enabled for this timeline.
+    pub fn enable_fingerprint_cache(&self) -> Result<FingerprintCache<'_>> {
+        let mut err = macros::ffi_error!();
+        let ptr = unsafe { ffi::otio_timeline_enable_fingerprint_cache(self.ptr, &mut err) };
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(FingerprintCache {
+            ptr,
+            _timeline: PhantomData,
+        })
+    }
+}
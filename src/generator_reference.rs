@@ -96,8 +96,10 @@ impl GeneratorReference {
 traits::impl_has_metadata!(
     GeneratorReference,
     otio_generator_ref_set_metadata_string,
-    otio_generator_ref_get_metadata_string
+    otio_generator_ref_get_metadata_string,
+    otio_generator_ref_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(GeneratorReference);
 
 impl Drop for GeneratorReference {
     fn drop(&mut self) {
@@ -1,7 +1,11 @@
 //! `ImageSequenceReference` type for VFX image sequence media.
 
-use crate::{ffi, ffi_string_to_rust, is_unset_time_range, macros, time_range_from_ffi, traits, RationalTime, Result, TimeRange};
+use crate::{
+    ffi, ffi_string_to_rust, is_unset_time_range, macros, time_range_from_ffi, traits, OtioError,
+    RationalTime, Result, TimeRange,
+};
 use std::ffi::CString;
+use std::ops::Range;
 
 /// Policy for handling missing frames in an image sequence.
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
@@ -232,6 +236,84 @@ impl ImageSequenceReference {
         Ok(ffi_string_to_rust(ptr))
     }
 
+    /// Get the target URLs of a range of image numbers in one call.
+    ///
+    /// The URLs are the same as [`Self::target_url_for_image_number`] gives,
+    /// but the parts that do not depend on the image are formatted once and
+    /// all URLs share one buffer. See [`Self::target_urls_into`] to reuse
+    /// the buffer across calls.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if any image number in the range is invalid.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{ImageSequenceReference, RationalTime, TimeRange};
+    ///
+    /// let mut seq = ImageSequenceReference::new("/renders/", "shot_", ".exr", 1001, 1, 24.0, 4);
+    /// seq.set_available_range(TimeRange::new(
+    ///     RationalTime::new(0.0, 24.0),
+    ///     RationalTime::new(240.0, 24.0),
+    /// )).unwrap();
+    /// let urls = seq.target_urls(0..seq.number_of_images()).unwrap();
+    /// let missing = urls.iter().filter(|url| !std::path::Path::new(url).exists()).count();
+    /// println!("{missing} of {} frames missing", urls.len());
+    /// ```
+    pub fn target_urls(&self, images: Range<i32>) -> Result<ImageUrls> {
+        let mut urls = ImageUrls::new();
+        self.target_urls_into(images, &mut urls)?;
+        Ok(urls)
+    }
+
+    /// Like [`Self::target_urls`], but replaces the contents of `urls`,
+    /// keeping its capacity.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if any image number in the range is invalid, in which
+    /// case `urls` is left empty.
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    pub fn target_urls_into(&self, images: Range<i32>, urls: &mut ImageUrls) -> Result<()> {
+        let count = usize::try_from(i64::from(images.end) - i64::from(images.start)).unwrap_or(0);
+        let mut data = std::mem::take(&mut urls.data).into_bytes();
+        data.clear();
+        urls.offsets.clear();
+        urls.offsets.resize(count + 1, 0);
+
+        let mut err = macros::ffi_error!();
+        let mut total = -1;
+        for _ in 0..2 {
+            total = unsafe {
+                ffi::otio_image_seq_ref_target_urls(
+                    self.ptr,
+                    images.start,
+                    count as i32,
+                    data.as_mut_ptr().cast(),
+                    data.capacity() as i64,
+                    urls.offsets.as_mut_ptr(),
+                    &mut err,
+                )
+            };
+            if total < 0 || total as usize <= data.capacity() {
+                break;
+            }
+            // Too small: the first call only sized the buffer
+            data.reserve(total as usize);
+        }
+        if total < 0 {
+            urls.offsets.clear();
+            urls.data = String::from_utf8(data).unwrap_or_default();
+            return Err(OtioError::from(err));
+        }
+        // SAFETY: the shim wrote `total` bytes, which fit in the capacity
+        unsafe { data.set_len(total as usize) };
+        urls.data = String::from_utf8(data)
+            .unwrap_or_else(|invalid| String::from_utf8_lossy(invalid.as_bytes()).into_owned());
+        Ok(())
+    }
+
     /// Get the available range of this image sequence.
     #[must_use]
     pub fn available_range(&self) -> Option<TimeRange> {
@@ -249,11 +331,58 @@ impl ImageSequenceReference {
     );
 }
 
+/// The target URLs of a range of images, sharing one buffer.
+///
+/// Returned by [`ImageSequenceReference::target_urls`]. Indices count from
+/// the first image of the range.
+#[derive(Debug, Clone, Default)]
+pub struct ImageUrls {
+    data: String,
+    offsets: Vec<i64>,
+}
+
+impl ImageUrls {
+    /// An empty set of URLs, to be filled by
+    /// [`ImageSequenceReference::target_urls_into`].
+    #[must_use]
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Number of URLs.
+    #[must_use]
+    pub fn len(&self) -> usize {
+        self.offsets.len().saturating_sub(1)
+    }
+
+    /// Whether there are no URLs.
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// The URL at `index`.
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_sign_loss)]
+    pub fn get(&self, index: usize) -> Option<&str> {
+        let start = *self.offsets.get(index)? as usize;
+        let end = *self.offsets.get(index + 1)? as usize;
+        self.data.get(start..end)
+    }
+
+    /// The URLs in order.
+    pub fn iter(&self) -> impl Iterator<Item = &str> {
+        (0..self.len()).filter_map(|index| self.get(index))
+    }
+}
+
 traits::impl_has_metadata!(
     ImageSequenceReference,
     otio_image_seq_ref_set_metadata_string,
-    otio_image_seq_ref_get_metadata_string
+    otio_image_seq_ref_get_metadata_string,
+    otio_image_seq_ref_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(ImageSequenceReference);
 
 impl Drop for ImageSequenceReference {
     fn drop(&mut self) {
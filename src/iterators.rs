@@ -12,11 +12,11 @@ use crate::time_range_from_ffi;
 use crate::{OtioError, RationalTime, Result, TimeRange};
 
 /// Child type constants (must match C header defines)
-const CHILD_TYPE_CLIP: i32 = 0;
-const CHILD_TYPE_GAP: i32 = 1;
-const CHILD_TYPE_STACK: i32 = 2;
-const CHILD_TYPE_TRACK: i32 = 3;
-const CHILD_TYPE_TRANSITION: i32 = 4;
+pub(crate) const CHILD_TYPE_CLIP: i32 = 0;
+pub(crate) const CHILD_TYPE_GAP: i32 = 1;
+pub(crate) const CHILD_TYPE_STACK: i32 = 2;
+pub(crate) const CHILD_TYPE_TRACK: i32 = 3;
+pub(crate) const CHILD_TYPE_TRANSITION: i32 = 4;
 
 /// Parent type constants (must match C header defines)
 const PARENT_TYPE_TRACK: i32 = 1;
@@ -65,6 +65,7 @@ pub enum Composable<'a> {
 /// This type is returned when iterating over children and does not own
 /// the underlying memory (which is owned by the parent composition).
 #[derive(Debug)]
+#[repr(transparent)]
 pub struct ClipRef<'a> {
     ptr: *mut ffi::OtioClip,
     _marker: PhantomData<&'a ()>,
@@ -85,6 +86,32 @@ impl ClipRef<'_> {
         ffi_string_to_rust(ptr)
     }
 
+    /// Copy this clip out of the timeline. The copy has no parent and can
+    /// be added to any track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a marker, effect or media reference of the clip
+    /// cannot be copied.
+    pub fn duplicate(&self, mode: crate::CloneMode) -> Result<crate::Clip> {
+        crate::clone::duplicate_clip(self.ptr, mode)
+    }
+
+    macros::impl_str_view!(
+        with_name,
+        otio_clip_get_name_view,
+        otio_clip_get_name,
+        "Call `f` with the name of this clip."
+    );
+
+    /// Iterate the markers on this clip, without copying any that a shared
+    /// fork also holds.
+    pub fn markers(&self) -> impl Iterator<Item = crate::MarkerRef<'_>> + '_ {
+        let ptr = self.ptr;
+        let count = unsafe { ffi::otio_clip_markers_count(ptr) };
+        crate::marker::attached_markers(count, move |i| unsafe { ffi::otio_clip_marker_at(ptr, i) })
+    }
+
     /// Get the source range of this clip.
     #[must_use]
     pub fn source_range(&self) -> TimeRange {
@@ -201,13 +228,67 @@ impl ClipRef<'_> {
         }
         Ok(time_range_from_ffi(&result))
     }
+
+    /// Transform many times from this clip's coordinate space to a target
+    /// track's space.
+    ///
+    /// The offsets between the two items are computed once, so this is much
+    /// cheaper than calling [`ClipRef::transformed_time_to_track`] for every
+    /// time, with the same results.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the items are not related in the hierarchy.
+    pub fn transformed_times_to_track(
+        &self,
+        times: &[RationalTime],
+        to_track: &TrackRef<'_>,
+    ) -> Result<Vec<RationalTime>> {
+        transform_batch(times.len(), |out, count, err| unsafe {
+            ffi::otio_item_transformed_times(
+                self.ptr.cast(),
+                CHILD_TYPE_CLIP,
+                times.as_ptr().cast(),
+                count,
+                to_track.ptr.cast(),
+                CHILD_TYPE_TRACK,
+                out,
+                err,
+            )
+        })
+    }
+}
+
+/// Run a batched transform into a vector of `count` times.
+#[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+fn transform_batch(
+    count: usize,
+    run: impl FnOnce(*mut ffi::OtioRationalTime, i32, *mut ffi::OtioError) -> i32,
+) -> Result<Vec<RationalTime>> {
+    if count > i32::MAX as usize {
+        return Err(OtioError {
+            code: 1,
+            message: "Too many times for one batch".to_string(),
+        });
+    }
+    let mut out = Vec::<RationalTime>::with_capacity(count);
+    let mut err = macros::ffi_error!();
+    if run(out.as_mut_ptr().cast(), count as i32, &mut err) != 0 {
+        return Err(OtioError::from(err));
+    }
+    // SAFETY: the shim wrote all `count` times, and RationalTime is laid out
+    // like OtioRationalTime
+    unsafe { out.set_len(count) };
+    Ok(out)
 }
 
 crate::traits::impl_has_metadata!(
     ClipRef<'_>,
     otio_clip_set_metadata_string,
-    otio_clip_get_metadata_string
+    otio_clip_get_metadata_string,
+    otio_clip_get_metadata_string_view
 );
+crate::traits::impl_has_fingerprint!(ClipRef<'_>);
 
 /// A non-owning reference to a Gap.
 #[derive(Debug)]
@@ -231,6 +312,13 @@ impl GapRef<'_> {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_gap_get_name_view,
+        otio_gap_get_name,
+        "Call `f` with the name of this gap."
+    );
+
     /// Get the parent composition of this gap.
     ///
     /// Returns `None` if the gap is not attached to a composition.
@@ -260,8 +348,10 @@ impl GapRef<'_> {
 crate::traits::impl_has_metadata!(
     GapRef<'_>,
     otio_gap_set_metadata_string,
-    otio_gap_get_metadata_string
+    otio_gap_get_metadata_string,
+    otio_gap_get_metadata_string_view
 );
+crate::traits::impl_has_fingerprint!(GapRef<'_>);
 
 /// A non-owning reference to a Transition.
 #[derive(Debug)]
@@ -285,6 +375,13 @@ impl TransitionRef<'_> {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_transition_get_name_view,
+        otio_transition_get_name,
+        "Call `f` with the name of this transition."
+    );
+
     /// Get the transition type.
     #[must_use]
     pub fn transition_type(&self) -> String {
@@ -317,8 +414,10 @@ impl TransitionRef<'_> {
 crate::traits::impl_has_metadata!(
     TransitionRef<'_>,
     otio_transition_set_metadata_string,
-    otio_transition_get_metadata_string
+    otio_transition_get_metadata_string,
+    otio_transition_get_metadata_string_view
 );
+crate::traits::impl_has_fingerprint!(TransitionRef<'_>);
 
 /// A non-owning reference to a Stack.
 #[derive(Debug)]
@@ -348,6 +447,13 @@ impl StackRef<'_> {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_stack_get_name_view,
+        otio_stack_get_name,
+        "Call `f` with the name of this stack."
+    );
+
     /// Get the number of children in this stack.
     #[must_use]
     #[allow(clippy::cast_sign_loss)]
@@ -366,11 +472,14 @@ impl StackRef<'_> {
 crate::traits::impl_has_metadata!(
     StackRef<'_>,
     otio_stack_set_metadata_string,
-    otio_stack_get_metadata_string
+    otio_stack_get_metadata_string,
+    otio_stack_get_metadata_string_view
 );
+crate::traits::impl_has_fingerprint!(StackRef<'_>);
 
 /// A non-owning reference to a Track.
 #[derive(Debug)]
+#[repr(transparent)]
 pub struct TrackRef<'a> {
     ptr: *mut ffi::OtioTrack,
     _marker: PhantomData<&'a ()>,
@@ -391,6 +500,22 @@ impl TrackRef<'_> {
         ffi_string_to_rust(ptr)
     }
 
+    /// Copy this track out of the timeline. The copy has no parent.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of the track cannot be copied.
+    pub fn duplicate(&self, mode: crate::CloneMode) -> Result<crate::Track> {
+        crate::clone::duplicate_track(self.ptr, mode)
+    }
+
+    macros::impl_str_view!(
+        with_name,
+        otio_track_get_name_view,
+        otio_track_get_name,
+        "Call `f` with the name of this track."
+    );
+
     /// Get the number of children in this track.
     #[must_use]
     #[allow(clippy::cast_sign_loss)]
@@ -423,13 +548,143 @@ impl TrackRef<'_> {
             crate::TrackKind::Video
         }
     }
+
+    /// Transform many times from this track's coordinate space to a clip's
+    /// space, for example to map output frames to source media frames.
+    ///
+    /// The offsets between the two items are computed once for the batch,
+    /// with the same results as transforming every time on its own.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the items are not related in the hierarchy.
+    pub fn transformed_times_to_clip(
+        &self,
+        times: &[RationalTime],
+        to_clip: &ClipRef<'_>,
+    ) -> Result<Vec<RationalTime>> {
+        transform_batch(times.len(), |out, count, err| unsafe {
+            ffi::otio_item_transformed_times(
+                self.ptr.cast(),
+                CHILD_TYPE_TRACK,
+                times.as_ptr().cast(),
+                count,
+                to_clip.ptr.cast(),
+                CHILD_TYPE_CLIP,
+                out,
+                err,
+            )
+        })
+    }
+
+    /// Transform `count` consecutive frames starting at `start` (at its
+    /// rate) from this track's coordinate space to a clip's space.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the items are not related in the hierarchy.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{Composable, RationalTime, Timeline};
+    ///
+    /// let timeline = Timeline::read_from_file(std::path::Path::new("reel.otio")).unwrap();
+    /// let track = timeline.video_tracks().next().unwrap();
+    /// if let Some(Composable::Clip(clip)) = track.children().next() {
+    ///     // Source frames of the first 240 frames of the track
+    ///     let start = RationalTime::new(0.0, 24.0);
+    ///     let source = track.transformed_frames_to_clip(start, 240, &clip).unwrap();
+    ///     assert_eq!(source.len(), 240);
+    /// }
+    /// ```
+    pub fn transformed_frames_to_clip(
+        &self,
+        start: RationalTime,
+        count: usize,
+        to_clip: &ClipRef<'_>,
+    ) -> Result<Vec<RationalTime>> {
+        transform_batch(count, |out, count, err| unsafe {
+            ffi::otio_item_transformed_frames(
+                self.ptr.cast(),
+                CHILD_TYPE_TRACK,
+                start.into(),
+                count,
+                to_clip.ptr.cast(),
+                CHILD_TYPE_CLIP,
+                out,
+                err,
+            )
+        })
+    }
+
+    /// Get the range of a child at the given index within this track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index is out of bounds.
+    #[allow(clippy::cast_possible_wrap, clippy::cast_possible_truncation)]
+    pub fn range_of_child_at_index(&self, index: usize) -> Result<TimeRange> {
+        let mut err = macros::ffi_error!();
+        let range = unsafe {
+            ffi::otio_track_range_of_child_at_index(self.ptr, index as i32, &mut err)
+        };
+        if err.code != 0 {
+            return Err(err.into());
+        }
+        Ok(time_range_from_ffi(&range))
+    }
+
+    /// Get the trimmed range of this track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range cannot be computed.
+    pub fn trimmed_range(&self) -> Result<TimeRange> {
+        let mut err = macros::ffi_error!();
+        let range = unsafe { ffi::otio_track_trimmed_range(self.ptr, &mut err) };
+        if err.code != 0 {
+            return Err(err.into());
+        }
+        Ok(time_range_from_ffi(&range))
+    }
+
+    /// Build a [`TimeIndex`](crate::TimeIndex) over the children of this track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range of a child cannot be computed.
+    pub fn build_time_index(&self) -> Result<crate::TimeIndex<'_>> {
+        crate::TimeIndex::build(|err| unsafe { ffi::otio_track_build_time_index(self.ptr, err) })
+    }
+
+    /// Lazily find the items in this track that match `filter`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the filter is invalid.
+    pub fn search(&self, filter: &crate::SearchFilter) -> Result<crate::SearchIter<'_>> {
+        crate::SearchIter::open(filter, |raw, err| unsafe { ffi::otio_track_search(self.ptr, raw, err) })
+    }
+
+    /// Memoize range queries on this track while the returned
+    /// [`RangeCache`](crate::RangeCache) lives.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if caching is already enabled for this track.
+    pub fn enable_range_cache(&self) -> Result<crate::RangeCache<'_>> {
+        crate::RangeCache::enable(|err| unsafe { ffi::otio_track_enable_range_cache(self.ptr, err) })
+    }
 }
 
 crate::traits::impl_has_metadata!(
     TrackRef<'_>,
     otio_track_set_metadata_string,
-    otio_track_get_metadata_string
+    otio_track_get_metadata_string,
+    otio_track_get_metadata_string_view
 );
+crate::traits::impl_has_fingerprint!(TrackRef<'_>);
 
 /// Iterator over Track children.
 pub struct TrackChildIter<'a> {
@@ -777,3 +1032,157 @@ impl Drop for TrackIter<'_> {
         }
     }
 }
+
+// ============================================================================
+// Caller-buffer exports (find_clips_into / video_tracks_into)
+// ============================================================================
+
+/// Fill `out` from one of the shim's `*_into` exports, growing it once if the
+/// first call reports more handles than fit. `out` keeps its capacity, so
+/// refilling the same vector stops allocating once it is large enough.
+///
+/// # Safety
+///
+/// `R` must be `#[repr(transparent)]` over `*mut H`.
+#[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+pub(crate) unsafe fn fill_handles<R, H>(
+    out: &mut Vec<R>,
+    mut run: impl FnMut(*mut *mut H, i32, *mut ffi::OtioError) -> i32,
+) -> Result<()> {
+    debug_assert_eq!(std::mem::size_of::<R>(), std::mem::size_of::<*mut H>());
+    out.clear();
+    loop {
+        let capacity = out.capacity().min(i32::MAX as usize);
+        let mut err = macros::ffi_error!();
+        let total = run(out.as_mut_ptr().cast(), capacity as i32, &mut err);
+        if total < 0 {
+            return Err(OtioError::from(err));
+        }
+        let total = total as usize;
+        if total <= capacity {
+            // SAFETY: the export wrote the first `total` entries, and R has
+            // the layout of a handle
+            unsafe { out.set_len(total) };
+            return Ok(());
+        }
+        out.reserve(total);
+    }
+}
+
+// =============================================================================
+// Flattened Timeline Items
+// =============================================================================
+
+/// One entry of a flattened timeline, as returned by
+/// [`Timeline::flatten_items`](crate::Timeline::flatten_items).
+#[derive(Debug)]
+pub struct FlatItem<'a> {
+    /// The item itself.
+    pub item: Composable<'a>,
+    /// Nesting depth; tracks directly under the timeline's stack are at depth 0.
+    pub depth: usize,
+    /// Index of the parent entry in the flattened list, `None` at depth 0.
+    pub parent_index: Option<usize>,
+    /// Range of the item in the timeline's stack coordinate space.
+    pub range: TimeRange,
+}
+
+/// Every item below a timeline's stack, gathered with a single FFI walk.
+///
+/// Entries are stored in depth-first order, so a parent always comes before
+/// its children and `parent_index` always points backwards.
+pub struct FlattenedItems<'a> {
+    handles: Vec<*mut std::ffi::c_void>,
+    types: Vec<i32>,
+    depths: Vec<i32>,
+    parent_indices: Vec<i32>,
+    ranges: Vec<ffi::OtioTimeRange>,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl<'a> FlattenedItems<'a> {
+    /// Initial buffer size; the walk is repeated once with the exact size if
+    /// the timeline holds more items than this.
+    const INITIAL_CAPACITY: usize = 256;
+
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    pub(crate) fn from_timeline(ptr: *mut ffi::OtioTimeline) -> Result<Self> {
+        let zero_range = ffi::OtioTimeRange {
+            start_time: ffi::OtioRationalTime { value: 0.0, rate: 1.0 },
+            duration: ffi::OtioRationalTime { value: 0.0, rate: 1.0 },
+        };
+        let mut items = Self {
+            handles: Vec::new(),
+            types: Vec::new(),
+            depths: Vec::new(),
+            parent_indices: Vec::new(),
+            ranges: Vec::new(),
+            _marker: PhantomData,
+        };
+        let mut capacity = Self::INITIAL_CAPACITY;
+        loop {
+            items.handles.resize(capacity, std::ptr::null_mut());
+            items.types.resize(capacity, -1);
+            items.depths.resize(capacity, 0);
+            items.parent_indices.resize(capacity, -1);
+            items.ranges.resize(capacity, zero_range);
+
+            let mut out = ffi::OtioFlattenedItems {
+                handles: items.handles.as_mut_ptr(),
+                types: items.types.as_mut_ptr(),
+                depths: items.depths.as_mut_ptr(),
+                parent_indices: items.parent_indices.as_mut_ptr(),
+                ranges: items.ranges.as_mut_ptr(),
+                capacity: capacity as i32,
+            };
+            let mut err = macros::ffi_error!();
+            let total = unsafe { ffi::otio_timeline_flatten_items(ptr, &mut out, &mut err) };
+            if total < 0 {
+                return Err(OtioError::from(err));
+            }
+            let total = total as usize;
+            if total <= capacity {
+                items.handles.truncate(total);
+                items.types.truncate(total);
+                items.depths.truncate(total);
+                items.parent_indices.truncate(total);
+                items.ranges.truncate(total);
+                return Ok(items);
+            }
+            capacity = total;
+        }
+    }
+
+    /// Get the number of flattened entries.
+    #[must_use]
+    pub fn len(&self) -> usize {
+        self.handles.len()
+    }
+
+    /// Check whether the timeline had no items.
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.handles.is_empty()
+    }
+
+    /// Get the entry at `index`.
+    ///
+    /// Returns `None` if the index is out of bounds.
+    #[must_use]
+    #[allow(clippy::cast_sign_loss)]
+    pub fn get(&self, index: usize) -> Option<FlatItem<'a>> {
+        let item = composable_from_ffi(*self.handles.get(index)?, self.types[index])?;
+        let parent = self.parent_indices[index];
+        Some(FlatItem {
+            item,
+            depth: self.depths[index].max(0) as usize,
+            parent_index: if parent < 0 { None } else { Some(parent as usize) },
+            range: time_range_from_ffi(&self.ranges[index]),
+        })
+    }
+
+    /// Iterate over all entries in depth-first order.
+    pub fn iter(&self) -> impl Iterator<Item = FlatItem<'a>> + '_ {
+        (0..self.len()).filter_map(move |index| self.get(index))
+    }
+}
@@ -0,0 +1,229 @@
+//! Selective timeline loading.
+//!
+//! [`LazyTimeline`] parses a document but only builds the parts selected by a
+//! [`LoadFilter`]. Tracks that were filtered out are still present, with their
+//! name, kind and metadata, but have no children until they are hydrated.
+
+use std::ffi::{c_char, CString};
+use std::mem::ManuallyDrop;
+use std::path::Path;
+
+use crate::{ffi, macros, OtioError, Result, Timeline, TimelineMut, TrackKind};
+
+/// Which parts of a document [`LazyTimeline`] should build.
+///
+/// The default filter loads everything.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{LazyTimeline, LoadFilter, TrackKind};
+///
+/// // Only video track shells are needed for a dashboard; skip all markers.
+/// let filter = LoadFilter::new()
+///     .track_kind(TrackKind::Video)
+///     .track_indices(&[])
+///     .skip_schema("Marker");
+/// let lazy = LazyTimeline::read_from_file("feature.otio".as_ref(), &filter).unwrap();
+/// for track in lazy.timeline().video_tracks() {
+///     println!("{}", track.name());
+/// }
+/// ```
+#[derive(Debug, Clone, Default)]
+pub struct LoadFilter {
+    track_kinds: i32,
+    track_indices: Option<Vec<i32>>,
+    skip_schemas: Vec<CString>,
+}
+
+impl LoadFilter {
+    /// Create a filter that loads everything.
+    #[must_use]
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Load the children of tracks of this kind.
+    ///
+    /// May be called more than once; with no kind given, every kind is loaded.
+    #[must_use]
+    pub fn track_kind(mut self, kind: TrackKind) -> Self {
+        let bit = match kind {
+            TrackKind::Video => 0,
+            TrackKind::Audio => 1,
+        };
+        self.track_kinds |= 1 << bit;
+        self
+    }
+
+    /// Only load the children of the tracks at these indices in the
+    /// timeline's stack. An empty slice loads no track children at all.
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn track_indices(mut self, indices: &[usize]) -> Self {
+        self.track_indices = Some(indices.iter().map(|&i| i as i32).collect());
+        self
+    }
+
+    /// Drop objects with this schema from every list they appear in.
+    ///
+    /// Pass a bare name (`"Marker"`) to match any version, or a versioned
+    /// name (`"Effect.1"`) to match only that version.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `schema` contains a NUL byte.
+    #[must_use]
+    pub fn skip_schema(mut self, schema: &str) -> Self {
+        self.skip_schemas.push(CString::new(schema).unwrap());
+        self
+    }
+}
+
+/// A timeline whose filtered-out tracks can be loaded later.
+///
+/// Keeps the JSON of every pending track, so memory stays proportional to
+/// what was skipped until those tracks are hydrated or the timeline is taken
+/// with [`LazyTimeline::into_timeline`].
+pub struct LazyTimeline {
+    ptr: *mut ffi::OtioLazyTimeline,
+    // Borrowed from `ptr`; never freed on its own
+    timeline: ManuallyDrop<Timeline>,
+}
+
+impl LazyTimeline {
+    /// Read a timeline from a JSON file, building only what `filter` selects.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the file cannot be read or parsed.
+    pub fn read_from_file(path: &Path, filter: &LoadFilter) -> Result<Self> {
+        let c_path = CString::new(path.to_string_lossy().as_ref()).unwrap();
+        Self::load(filter, |c_filter, err| unsafe {
+            ffi::otio_lazy_timeline_read_from_file(c_path.as_ptr(), c_filter, err)
+        })
+    }
+
+    /// Parse a timeline from a JSON buffer, building only what `filter` selects.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the JSON cannot be parsed or doesn't contain a timeline.
+    pub fn from_json_slice(json: &[u8], filter: &LoadFilter) -> Result<Self> {
+        Self::load(filter, |c_filter, err| unsafe {
+            ffi::otio_lazy_timeline_from_json_buffer(json.as_ptr().cast(), json.len(), c_filter, err)
+        })
+    }
+
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    fn load(
+        filter: &LoadFilter,
+        open: impl FnOnce(*const ffi::OtioLoadFilter, *mut ffi::OtioError) -> *mut ffi::OtioLazyTimeline,
+    ) -> Result<Self> {
+        let schemas: Vec<*const c_char> = filter.skip_schemas.iter().map(|s| s.as_ptr()).collect();
+        let (indices_ptr, indices_len) = match &filter.track_indices {
+            Some(indices) => (indices.as_ptr(), indices.len() as i32),
+            None => (std::ptr::null(), 0),
+        };
+        let c_filter = ffi::OtioLoadFilter {
+            track_kinds: filter.track_kinds,
+            track_indices: indices_ptr,
+            track_index_count: indices_len,
+            skip_schemas: if schemas.is_empty() { std::ptr::null_mut() } else { schemas.as_ptr().cast_mut() },
+            skip_schema_count: schemas.len() as i32,
+        };
+        let mut err = macros::ffi_error!();
+        let ptr = open(&c_filter, &mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        let timeline = Timeline {
+            ptr: unsafe { ffi::otio_lazy_timeline_get_timeline(ptr) },
+        };
+        Ok(Self {
+            ptr,
+            timeline: ManuallyDrop::new(timeline),
+        })
+    }
+
+    /// Get the loaded timeline.
+    #[must_use]
+    pub fn timeline(&self) -> &Timeline {
+        &self.timeline
+    }
+
+    /// Get the loaded timeline for modification.
+    ///
+    /// The timeline stays owned by this handle, so it is lent through a view
+    /// that cannot be moved out of. Adding children to a pending track makes
+    /// it impossible to hydrate.
+    pub fn timeline_mut(&mut self) -> TimelineMut<'_> {
+        TimelineMut::new(&self.timeline)
+    }
+
+    /// Get the number of tracks that still have to be hydrated.
+    #[must_use]
+    #[allow(clippy::cast_sign_loss)]
+    pub fn pending_count(&self) -> usize {
+        let count = unsafe { ffi::otio_lazy_timeline_pending_count(self.ptr) };
+        count.max(0) as usize
+    }
+
+    /// Check whether the track at `index` in the timeline's stack has its
+    /// children loaded.
+    ///
+    /// Returns `false` for pending tracks and out-of-range indices.
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn is_track_loaded(&self, index: usize) -> bool {
+        unsafe { ffi::otio_lazy_timeline_is_track_loaded(self.ptr, index as i32) == 1 }
+    }
+
+    /// Load the children of a pending track.
+    ///
+    /// Does nothing if the track is already loaded. Existing references to
+    /// the track stay valid; it is filled in place.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index is out of bounds, the pending JSON cannot
+    /// be parsed, or children were added to the track in the meantime.
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn hydrate_track(&mut self, index: usize) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result =
+            unsafe { ffi::otio_lazy_timeline_hydrate_track(self.ptr, index as i32, &mut err) };
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
+    /// Release the pending JSON and keep only the timeline.
+    ///
+    /// Tracks that were not hydrated stay empty.
+    #[must_use]
+    pub fn into_timeline(self) -> Timeline {
+        let ptr = unsafe { ffi::otio_lazy_timeline_take_timeline(self.ptr) };
+        // Dropping `self` now frees the lazy handle, which no longer owns the timeline
+        Timeline { ptr }
+    }
+}
+
+impl std::fmt::Debug for LazyTimeline {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("LazyTimeline")
+            .field("timeline", &*self.timeline)
+            .field("pending_count", &self.pending_count())
+            .finish_non_exhaustive()
+    }
+}
+
+impl Drop for LazyTimeline {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_lazy_timeline_free(self.ptr) }
+    }
+}
+
+// Safety: LazyTimeline owns its handle exclusively, like Timeline
+unsafe impl Send for LazyTimeline {}
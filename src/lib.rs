@@ -36,7 +36,7 @@ mod ffi {
 
 mod macros;
 mod traits;
-pub use traits::HasMetadata;
+pub use traits::{HasFingerprint, HasMetadata};
 
 mod types;
 pub use types::*;
@@ -44,15 +44,57 @@ pub use types::*;
 mod iterators;
 use iterators::composable_from_ffi;
 pub use iterators::{
-    ClipRef, ClipSearchIter, Composable, GapRef, ParentRef, StackChildIter, StackRef,
-    TrackChildIter, TrackIter, TrackRef, TransitionRef,
+    ClipRef, ClipSearchIter, Composable, FlatItem, FlattenedItems, GapRef, ParentRef,
+    StackChildIter, StackRef, TrackChildIter, TrackIter, TrackRef, TransitionRef,
 };
 
 mod builders;
-pub use builders::{ClipBuilder, ExternalReferenceBuilder, TimelineBuilder};
+pub use builders::{ClipBatchBuilder, ClipBuilder, ExternalReferenceBuilder, TimelineBuilder};
+
+mod lazy;
+pub use lazy::{LazyTimeline, LoadFilter};
+
+mod time_index;
+pub use time_index::{TimeIndex, TimeIndexHit};
+
+mod range_cache;
+pub use range_cache::{RangeCache, RangeCacheStats};
+
+mod search;
+pub use search::{SearchFilter, SearchIter};
+
+mod asset_index;
+pub use asset_index::AssetIndex;
+
+mod metadata;
+pub use metadata::MetadataValue;
+
+mod changes;
+pub use changes::ChangeTracker;
+
+mod render_manifest;
+pub use render_manifest::{ManifestRun, ManifestTransition, RenderManifest};
+
+mod track_edit;
+pub use track_edit::TrackEdit;
+
+mod undo;
+pub use undo::UndoJournal;
+
+mod clone;
+pub use clone::CloneMode;
+
+mod diff;
+pub use diff::{DiffChanges, DiffKind, DiffOp, TimelineDiff};
+
+mod fingerprint;
+pub use fingerprint::{FingerprintCache, FingerprintCacheStats};
+
+mod stats;
+pub use stats::{ShimStat, ShimStats};
 
 pub mod marker;
-pub use marker::Marker;
+pub use marker::{Marker, MarkerRef};
 
 mod effect;
 pub use effect::Effect;
@@ -67,7 +109,7 @@ pub mod generator_reference;
 pub use generator_reference::GeneratorReference;
 
 pub mod image_sequence_reference;
-pub use image_sequence_reference::ImageSequenceReference;
+pub use image_sequence_reference::{ImageSequenceReference, ImageUrls};
 
 mod time_effect;
 pub use time_effect::{FreezeFrame, LinearTimeWarp};
@@ -126,6 +168,102 @@ pub(crate) fn ffi_string_to_rust(ptr: *mut std::ffi::c_char) -> String {
     result
 }
 
+/// Borrow the bytes behind an FFI string view.
+///
+/// Returns `None` for a null view.
+///
+/// # Safety
+///
+/// The view must be null or point to `len` readable bytes that stay valid
+/// and unmodified for `'a`.
+pub(crate) unsafe fn bytes_from_view<'a>(view: &ffi::OtioStringView) -> Option<&'a [u8]> {
+    if view.data.is_null() {
+        return None;
+    }
+    Some(unsafe { std::slice::from_raw_parts(view.data.cast::<u8>(), view.len) })
+}
+
+thread_local! {
+    static SCRATCH_VIEW_IN_USE: std::cell::Cell<bool> = const { std::cell::Cell::new(false) };
+}
+
+/// Run `f` on a string the shim hands out through its per-thread scratch view.
+///
+/// The scratch buffer is overwritten by the next view call on this thread, so
+/// a nested call made from inside `f` falls back to the allocating getter.
+pub(crate) fn with_scratch_view<R>(
+    view: impl FnOnce() -> ffi::OtioStringView,
+    owned: impl FnOnce() -> String,
+    f: impl FnOnce(&str) -> R,
+) -> R {
+    struct Release;
+    impl Drop for Release {
+        fn drop(&mut self) {
+            SCRATCH_VIEW_IN_USE.with(|flag| flag.set(false));
+        }
+    }
+
+    if SCRATCH_VIEW_IN_USE.with(|flag| flag.replace(true)) {
+        return f(&owned());
+    }
+    let _release = Release;
+    let view = view();
+    // SAFETY: the scratch buffer is not touched again until `_release` drops.
+    match unsafe { bytes_from_view(&view) } {
+        Some(bytes) => f(&String::from_utf8_lossy(bytes)),
+        None => f(""),
+    }
+}
+
+/// Call `f` with `key` as a NUL-terminated C string.
+///
+/// Short keys are copied to the stack so lookups don't allocate. Returns
+/// `None` if the key contains an interior NUL byte.
+pub(crate) fn with_c_key<R>(key: &str, f: impl FnOnce(*const std::ffi::c_char) -> R) -> Option<R> {
+    const INLINE_KEY_LEN: usize = 64;
+    if key.as_bytes().contains(&0) {
+        return None;
+    }
+    if key.len() < INLINE_KEY_LEN {
+        let mut buf = [0u8; INLINE_KEY_LEN];
+        buf[..key.len()].copy_from_slice(key.as_bytes());
+        Some(f(buf.as_ptr().cast()))
+    } else {
+        let c_key = CString::new(key).ok()?;
+        Some(f(c_key.as_ptr()))
+    }
+}
+
+/// `OTIO_JSON_COMPACT` in `otio_shim.h`.
+const JSON_COMPACT: i32 = 1;
+
+/// Bridges `otio_timeline_write_json` to a [`std::io::Write`]. The first
+/// error or panic of the writer is kept and stops the serialization.
+struct JsonSink<'a, W> {
+    writer: &'a mut W,
+    error: Option<std::io::Error>,
+    panic: Option<Box<dyn std::any::Any + Send>>,
+}
+
+impl<W: std::io::Write> JsonSink<'_, W> {
+    unsafe extern "C" fn write(user_data: *mut std::ffi::c_void, data: *const std::ffi::c_char, len: usize) -> i32 {
+        let sink = &mut *user_data.cast::<Self>();
+        let bytes = std::slice::from_raw_parts(data.cast::<u8>(), len);
+        // Unwinding into C++ is undefined, so panics are carried across
+        match std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| sink.writer.write_all(bytes))) {
+            Ok(Ok(())) => 0,
+            Ok(Err(error)) => {
+                sink.error = Some(error);
+                1
+            }
+            Err(payload) => {
+                sink.panic = Some(payload);
+                1
+            }
+        }
+    }
+}
+
 /// Check if an FFI `RationalTime` represents an unset/sentinel value.
 ///
 /// The FFI layer uses rate=1.0, value=0.0 as a sentinel for "not set".
@@ -155,7 +293,10 @@ pub(crate) fn time_range_from_ffi(ffi_range: &ffi::OtioTimeRange) -> TimeRange {
 // ============================================================================
 
 /// A rational time value with a rate.
+// Laid out like ffi::OtioRationalTime, so slices can be handed to batched
+// shim calls without copying
 #[derive(Debug, Clone, Copy, PartialEq)]
+#[repr(C)]
 pub struct RationalTime {
     pub value: f64,
     pub rate: f64,
@@ -302,6 +443,9 @@ impl Timeline {
 
     /// Read a timeline from a JSON file.
     ///
+    /// Gzip-compressed files are detected by their content and decompressed
+    /// while reading, if the crate was built with the `gzip` feature.
+    ///
     /// # Errors
     ///
     /// Returns an error if the file cannot be read or parsed.
@@ -342,6 +486,88 @@ impl Timeline {
         Ok(result)
     }
 
+    /// Serialize this timeline as JSON into `buf`, replacing its contents.
+    ///
+    /// Unlike [`Timeline::to_json_string`], the document is not copied into
+    /// a C string first and the buffer's capacity is kept, so a buffer that
+    /// is reused across calls stops allocating once it has grown to the
+    /// largest document. With `compact` set, indentation and line breaks
+    /// are left out.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the timeline cannot be serialized.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let timeline = Timeline::new("My Timeline");
+    /// let mut buf = Vec::new();
+    /// for _ in 0..3 {
+    ///     timeline.to_json_into(&mut buf, true).unwrap();
+    ///     println!("{} bytes", buf.len());
+    /// }
+    /// ```
+    pub fn to_json_into(&self, buf: &mut Vec<u8>, compact: bool) -> Result<()> {
+        buf.clear();
+        self.write_json(buf, compact)
+    }
+
+    /// Serialize this timeline as JSON into `writer`, in pieces of at most
+    /// 64 KiB, for example the body of a chunked HTTP response. With
+    /// `compact` set, indentation and line breaks are left out.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the timeline cannot be serialized or `writer`
+    /// fails; in the latter case the writer's error message is kept and
+    /// part of the document may already have been written.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    /// use std::io::Write;
+    ///
+    /// let timeline = Timeline::new("My Timeline");
+    /// let mut out = std::io::BufWriter::new(std::io::stdout().lock());
+    /// timeline.write_json(&mut out, false).unwrap();
+    /// out.flush().unwrap();
+    /// ```
+    pub fn write_json<W: std::io::Write>(&self, writer: &mut W, compact: bool) -> Result<()> {
+        let mut sink = JsonSink {
+            writer,
+            error: None,
+            panic: None,
+        };
+        let flags = if compact { JSON_COMPACT } else { 0 };
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_timeline_write_json(
+                self.ptr,
+                flags,
+                Some(JsonSink::<W>::write),
+                std::ptr::addr_of_mut!(sink).cast(),
+                &mut err,
+            )
+        };
+        if let Some(payload) = sink.panic {
+            std::panic::resume_unwind(payload);
+        }
+        if let Some(error) = sink.error {
+            return Err(OtioError {
+                code: 1,
+                message: error.to_string(),
+            });
+        }
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
     /// Write the timeline to a JSON file with schema version targeting.
     ///
     /// The `schema_versions` parameter specifies target schema versions for
@@ -470,6 +696,198 @@ impl Timeline {
         Ok(result)
     }
 
+    /// Run `f` with the schema version pairs as the C API's parallel arrays.
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    fn with_schema_versions<R>(
+        schema_versions: &[(&str, i64)],
+        f: impl FnOnce(*mut *const std::ffi::c_char, *const i64, i32) -> R,
+    ) -> R {
+        let names: Vec<CString> = schema_versions
+            .iter()
+            .map(|(name, _)| CString::new(*name).unwrap())
+            .collect();
+        let mut name_ptrs: Vec<*const std::ffi::c_char> =
+            names.iter().map(|s| s.as_ptr()).collect();
+        let versions: Vec<i64> = schema_versions.iter().map(|(_, v)| *v).collect();
+        f(name_ptrs.as_mut_ptr(), versions.as_ptr(), schema_versions.len() as i32)
+    }
+
+    /// Serialize this timeline to the compact binary format.
+    ///
+    /// The binary form is a lossless encoding of the JSON form with repeated
+    /// strings interned and times stored as raw doubles, meant as a cache
+    /// format between pipeline stages. Read it back with
+    /// [`Timeline::from_binary`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the timeline cannot be serialized.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let timeline = Timeline::new("My Timeline");
+    /// let bytes = timeline.to_binary().unwrap();
+    /// let restored = Timeline::from_binary(&bytes).unwrap();
+    /// assert_eq!(restored.name(), "My Timeline");
+    /// ```
+    pub fn to_binary(&self) -> Result<Vec<u8>> {
+        self.to_binary_with_schema_versions(&[])
+    }
+
+    /// Serialize to the binary format with schema version targeting, like
+    /// [`Timeline::to_json_string_with_schema_versions`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if serialization fails.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a schema name contains a NUL byte.
+    pub fn to_binary_with_schema_versions(&self, schema_versions: &[(&str, i64)]) -> Result<Vec<u8>> {
+        let mut len = 0;
+        let mut err = macros::ffi_error!();
+        let ptr = Self::with_schema_versions(schema_versions, |names, versions, count| unsafe {
+            ffi::otio_timeline_to_binary(self.ptr, names, versions, count, &mut len, &mut err)
+        });
+        if ptr.is_null() {
+            return Err(err.into());
+        }
+        let result = unsafe { std::slice::from_raw_parts(ptr, len) }.to_vec();
+        unsafe { ffi::otio_free_bytes(ptr) };
+        Ok(result)
+    }
+
+    /// Deserialize a timeline from the binary format.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `data` is not a valid binary document or doesn't
+    /// contain a timeline.
+    pub fn from_binary(data: &[u8]) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = unsafe { ffi::otio_timeline_from_binary(data.as_ptr(), data.len(), &mut err) };
+        if ptr.is_null() {
+            Err(err.into())
+        } else {
+            Ok(Self { ptr })
+        }
+    }
+
+    /// Write the timeline to a file in the binary format.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the file cannot be written.
+    pub fn write_to_binary_file(&self, path: &Path) -> Result<()> {
+        self.write_to_binary_file_with_schema_versions(path, &[])
+    }
+
+    /// Write the timeline to a file in the binary format with schema
+    /// version targeting.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if serialization fails or the file cannot be written.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a schema name contains a NUL byte.
+    pub fn write_to_binary_file_with_schema_versions(
+        &self,
+        path: &Path,
+        schema_versions: &[(&str, i64)],
+    ) -> Result<()> {
+        let c_path = CString::new(path.to_string_lossy().as_ref()).unwrap();
+        let mut err = macros::ffi_error!();
+        let result = Self::with_schema_versions(schema_versions, |names, versions, count| unsafe {
+            ffi::otio_timeline_write_to_binary_file(self.ptr, c_path.as_ptr(), names, versions, count, &mut err)
+        });
+        if result != 0 {
+            Err(err.into())
+        } else {
+            Ok(())
+        }
+    }
+
+    /// Read a timeline from a file in the binary format, decompressing it
+    /// first if it is gzip-compressed (with the `gzip` feature).
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the file cannot be read or decoded.
+    pub fn read_from_binary_file(path: &Path) -> Result<Self> {
+        let c_path = CString::new(path.to_string_lossy().as_ref()).unwrap();
+        let mut err = macros::ffi_error!();
+        let ptr = unsafe { ffi::otio_timeline_read_from_binary_file(c_path.as_ptr(), &mut err) };
+        if ptr.is_null() {
+            Err(err.into())
+        } else {
+            Ok(Self { ptr })
+        }
+    }
+
+    /// Write the timeline to a gzip-compressed JSON file.
+    ///
+    /// The JSON is compressed in chunks as it is written. `level` is 0 (no
+    /// compression) to 9 (smallest), or `None` for zlib's default. Read it
+    /// back with [`Timeline::read_from_file`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `level` is above 9, or if serialization or
+    /// writing fails.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    /// use std::path::Path;
+    ///
+    /// let timeline = Timeline::new("Archive");
+    /// timeline.write_to_gzip_file(Path::new("archive.otio.gz"), Some(9)).unwrap();
+    /// let restored = Timeline::read_from_file(Path::new("archive.otio.gz")).unwrap();
+    /// ```
+    #[cfg(feature = "gzip")]
+    pub fn write_to_gzip_file(&self, path: &Path, level: Option<u32>) -> Result<()> {
+        self.write_to_gzip_file_with_schema_versions(path, level, &[])
+    }
+
+    /// Write the timeline to a gzip-compressed JSON file with schema version
+    /// targeting.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `level` is above 9, or if serialization or
+    /// writing fails.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `path` or a schema name contains a NUL byte.
+    #[cfg(feature = "gzip")]
+    pub fn write_to_gzip_file_with_schema_versions(
+        &self,
+        path: &Path,
+        level: Option<u32>,
+        schema_versions: &[(&str, i64)],
+    ) -> Result<()> {
+        let c_path = CString::new(path.to_string_lossy().as_ref()).unwrap();
+        // Out-of-range levels are reported by the shim
+        let level = level.map_or(-1, |level| i32::try_from(level).unwrap_or(i32::MAX));
+        let mut err = macros::ffi_error!();
+        let result = Self::with_schema_versions(schema_versions, |names, versions, count| unsafe {
+            ffi::otio_timeline_write_to_gzip_file(self.ptr, c_path.as_ptr(), level, names, versions, count, &mut err)
+        });
+        if result != 0 {
+            Err(err.into())
+        } else {
+            Ok(())
+        }
+    }
+
     /// Deserialize a timeline from a JSON string.
     ///
     /// # Errors
@@ -485,9 +903,33 @@ impl Timeline {
     /// let timeline = Timeline::from_json_string(json).unwrap();
     /// ```
     pub fn from_json_string(json: &str) -> Result<Self> {
-        let c_json = CString::new(json).unwrap();
+        Self::from_json_slice(json.as_bytes())
+    }
+
+    /// Deserialize a timeline from a JSON byte buffer.
+    ///
+    /// The buffer is handed to the parser as-is, without the NUL-terminated
+    /// copy `CString` would need, so this also suits memory-mapped files.
+    /// Prefer [`Timeline::read_from_file`] when reading straight from disk;
+    /// it streams the file instead of holding it in memory.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the JSON cannot be parsed or doesn't contain a timeline.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let bytes = std::fs::read("feature.otio").unwrap();
+    /// let timeline = Timeline::from_json_slice(&bytes).unwrap();
+    /// ```
+    pub fn from_json_slice(json: &[u8]) -> Result<Self> {
         let mut err = macros::ffi_error!();
-        let ptr = unsafe { ffi::otio_timeline_from_json_string(c_json.as_ptr(), &mut err) };
+        let ptr = unsafe {
+            ffi::otio_timeline_from_json_buffer(json.as_ptr().cast(), json.len(), &mut err)
+        };
         if ptr.is_null() {
             Err(err.into())
         } else {
@@ -495,6 +937,88 @@ impl Timeline {
         }
     }
 
+    /// Read many timelines concurrently.
+    ///
+    /// Files are parsed on up to `threads` worker threads (`0` uses one per
+    /// hardware thread). Results come back in the order of `paths`, and a
+    /// failure only affects its own entry. A path containing a NUL byte fails
+    /// with a "Path is null" error.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let paths = ["reel1.otio", "reel2.otio", "reel3.otio"];
+    /// for (path, result) in paths.iter().zip(Timeline::read_from_files(&paths, 0)) {
+    ///     match result {
+    ///         Ok(timeline) => println!("{path}: {}", timeline.name()),
+    ///         Err(err) => eprintln!("{path}: {err}"),
+    ///     }
+    /// }
+    /// ```
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn read_from_files<P: AsRef<Path>>(paths: &[P], threads: usize) -> Vec<Result<Self>> {
+        let c_paths: Vec<Option<CString>> = paths
+            .iter()
+            .map(|p| CString::new(p.as_ref().to_string_lossy().as_ref()).ok())
+            .collect();
+        let ptrs: Vec<*const std::ffi::c_char> = c_paths
+            .iter()
+            .map(|p| p.as_ref().map_or(std::ptr::null(), |c| c.as_ptr()))
+            .collect();
+        Self::load_batch(ptrs.len(), |timelines, errors| unsafe {
+            ffi::otio_timeline_read_from_files(
+                ptrs.as_ptr(),
+                ptrs.len() as i32,
+                i32::try_from(threads).unwrap_or(i32::MAX),
+                timelines,
+                errors,
+            );
+        })
+    }
+
+    /// Parse many JSON buffers concurrently.
+    ///
+    /// Works like [`Timeline::read_from_files`] for documents already in memory.
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn from_json_slices(buffers: &[&[u8]], threads: usize) -> Vec<Result<Self>> {
+        let ptrs: Vec<*const std::ffi::c_char> = buffers.iter().map(|b| b.as_ptr().cast()).collect();
+        let lengths: Vec<usize> = buffers.iter().map(|b| b.len()).collect();
+        Self::load_batch(ptrs.len(), |timelines, errors| unsafe {
+            ffi::otio_timeline_from_json_buffers(
+                ptrs.as_ptr(),
+                lengths.as_ptr(),
+                ptrs.len() as i32,
+                i32::try_from(threads).unwrap_or(i32::MAX),
+                timelines,
+                errors,
+            );
+        })
+    }
+
+    fn load_batch(
+        count: usize,
+        load: impl FnOnce(*mut *mut ffi::OtioTimeline, *mut ffi::OtioError),
+    ) -> Vec<Result<Self>> {
+        let mut timelines = vec![std::ptr::null_mut(); count];
+        let mut errors: Vec<ffi::OtioError> = (0..count).map(|_| macros::ffi_error!()).collect();
+        load(timelines.as_mut_ptr(), errors.as_mut_ptr());
+        timelines
+            .into_iter()
+            .zip(errors)
+            .map(|(ptr, err)| {
+                if ptr.is_null() {
+                    Err(err.into())
+                } else {
+                    Ok(Self { ptr })
+                }
+            })
+            .collect()
+    }
+
     /// Get the root stack (tracks container) for this timeline.
     ///
     /// The returned `StackRef` is a non-owning reference to the timeline's stack.
@@ -512,6 +1036,13 @@ impl Timeline {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_timeline_get_name_view,
+        otio_timeline_get_name,
+        "Call `f` with the name of this timeline."
+    );
+
     /// Get the global start time of this timeline.
     ///
     /// Returns `None` if no global start time has been set.
@@ -558,6 +1089,39 @@ impl Timeline {
         iterators::TrackIter::new(ptr)
     }
 
+    /// Collect the video tracks into `out`, replacing its contents.
+    ///
+    /// Unlike [`Timeline::video_tracks`] this allocates no iterator; reusing
+    /// the same vector makes repeated calls allocation-free.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the tracks cannot be read.
+    pub fn video_tracks_into<'a>(&'a self, out: &mut Vec<TrackRef<'a>>) -> Result<()> {
+        // SAFETY: TrackRef is a transparent track handle
+        unsafe {
+            iterators::fill_handles(out, |tracks, capacity, err| {
+                ffi::otio_timeline_video_tracks_into(self.ptr, tracks, capacity, err)
+            })
+        }
+    }
+
+    /// Collect the audio tracks into `out`, replacing its contents.
+    ///
+    /// See [`Timeline::video_tracks_into`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the tracks cannot be read.
+    pub fn audio_tracks_into<'a>(&'a self, out: &mut Vec<TrackRef<'a>>) -> Result<()> {
+        // SAFETY: TrackRef is a transparent track handle
+        unsafe {
+            iterators::fill_handles(out, |tracks, capacity, err| {
+                ffi::otio_timeline_audio_tracks_into(self.ptr, tracks, capacity, err)
+            })
+        }
+    }
+
     /// Find all clips in this timeline (recursively).
     ///
     /// Returns an iterator over all clips found in the timeline's tracks
@@ -567,9 +1131,235 @@ impl Timeline {
         let ptr = unsafe { ffi::otio_timeline_find_clips(self.ptr) };
         ClipSearchIter::new(ptr)
     }
+
+    /// Collect all clips in this timeline (recursively) into `out`,
+    /// replacing its contents.
+    ///
+    /// Unlike [`Timeline::find_clips`] this allocates no iterator; reusing
+    /// the same vector makes repeated searches allocation-free.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the tracks cannot be walked.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+    /// let mut clips = Vec::new();
+    /// for _ in 0..1000 {
+    ///     timeline.find_clips_into(&mut clips).unwrap();
+    ///     // ... inspect clips ...
+    /// }
+    /// ```
+    pub fn find_clips_into<'a>(&'a self, out: &mut Vec<ClipRef<'a>>) -> Result<()> {
+        // SAFETY: ClipRef is a transparent clip handle
+        unsafe {
+            iterators::fill_handles(out, |clips, capacity, err| {
+                ffi::otio_timeline_find_clips_into(self.ptr, clips, capacity, err)
+            })
+        }
+    }
+
+    /// Flatten every item in this timeline with a single walk.
+    ///
+    /// Returns tracks, clips, gaps, transitions and nested stacks in
+    /// depth-first order, each with its depth, parent entry and range in the
+    /// timeline's stack coordinate space. This avoids one FFI round trip per
+    /// child, and the quadratic cost of calling `range_of_child_at_index` for
+    /// every child of a long track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range of an item cannot be computed.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{Composable, Timeline};
+    ///
+    /// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+    /// for entry in timeline.flatten_items().unwrap().iter() {
+    ///     if let Composable::Clip(clip) = entry.item {
+    ///         println!("{} starts at {}", clip.name(), entry.range.start_time.value);
+    ///     }
+    /// }
+    /// ```
+    pub fn flatten_items(&self) -> Result<FlattenedItems<'_>> {
+        FlattenedItems::from_timeline(self.ptr)
+    }
+
+    /// Build a [`TimeIndex`] over the children of every track in this
+    /// timeline, in the timeline's stack coordinate space.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the timeline has no tracks or the range of an
+    /// item cannot be computed.
+    pub fn build_time_index(&self) -> Result<TimeIndex<'_>> {
+        TimeIndex::build(|err| unsafe { ffi::otio_timeline_build_time_index(self.ptr, err) })
+    }
+
+    /// Resolve what every frame of this timeline shows over `range`, in the
+    /// timeline's stack coordinate space. The topmost track with something
+    /// at a frame wins.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of an
+    /// item cannot be computed.
+    pub fn render_manifest(&self, range: TimeRange) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_stack_build_render_manifest(ffi::otio_timeline_get_tracks(self.ptr), range.into(), err)
+        })
+    }
+
+    /// Like [`Timeline::render_manifest`], but evaluated on up to `threads`
+    /// threads (0 uses one per hardware thread). Every track is sampled in
+    /// chunks of frames on a worker pool and the topmost track is picked per
+    /// frame afterwards; the manifest is the same as a serial build's.
+    ///
+    /// The workers only read the timeline, which `&self` keeps unchanged for
+    /// the duration of the call.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of an
+    /// item cannot be computed.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::{RationalTime, TimeRange, Timeline};
+    ///
+    /// let timeline = Timeline::read_from_file(std::path::Path::new("commercial.otio")).unwrap();
+    /// let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(720.0, 24.0));
+    /// let manifest = timeline.render_manifest_parallel(range, 0).unwrap();
+    /// println!("{} runs", manifest.runs().len());
+    /// ```
+    pub fn render_manifest_parallel(
+        &self,
+        range: TimeRange,
+        threads: usize,
+    ) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_stack_build_render_manifest_parallel(
+                ffi::otio_timeline_get_tracks(self.ptr),
+                range.into(),
+                i32::try_from(threads).unwrap_or(i32::MAX),
+                err,
+            )
+        })
+    }
+
+    /// Lazily find the items in this timeline's tracks that match `filter`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the filter is invalid.
+    pub fn search(&self, filter: &SearchFilter) -> Result<SearchIter<'_>> {
+        SearchIter::open(filter, |raw, err| unsafe { ffi::otio_timeline_search(self.ptr, raw, err) })
+    }
+
+    /// Build an [`AssetIndex`] over the media URLs of this timeline's clips
+    /// and the given metadata keys of all its items.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index cannot be built.
+    ///
+    /// # Panics
+    ///
+    /// Panics if a key contains a NUL byte.
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+    pub fn build_asset_index(&self, metadata_keys: &[&str]) -> Result<AssetIndex<'_>> {
+        let keys: Vec<CString> = metadata_keys.iter().map(|key| CString::new(*key).unwrap()).collect();
+        let ptrs: Vec<*const std::ffi::c_char> = keys.iter().map(|key| key.as_ptr()).collect();
+        AssetIndex::build(|err| unsafe {
+            ffi::otio_timeline_build_asset_index(self.ptr, ptrs.as_ptr(), ptrs.len() as i32, err)
+        })
+    }
+
+    /// Start recording the edits made to this timeline, to send them as
+    /// patches with [`ChangeTracker::take_patch`]. The tracker borrows the
+    /// timeline until it is dropped.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the tracker cannot be created.
+    pub fn track_changes(&mut self) -> Result<ChangeTracker<'_>> {
+        ChangeTracker::open(self, |ptr, err| unsafe { ffi::otio_timeline_track_changes(ptr, err) })
+    }
+
+    /// Apply a patch from [`ChangeTracker::take_patch`]. This timeline must
+    /// be equal to the one the patch was taken from, as of the previous
+    /// patch.
+    ///
+    /// Handles to items that the patch replaces no longer refer to items in
+    /// this timeline.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the patch is malformed or its values are not
+    /// valid OTIO objects, in which case nothing is changed, or if its paths
+    /// do not match this timeline, in which case the ops before the
+    /// mismatch have been applied.
+    pub fn apply_patch(&mut self, patch: &str) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result = unsafe { ffi::otio_timeline_apply_patch(self.ptr, patch.as_ptr().cast(), patch.len(), &mut err) };
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
+    /// Keep the last `depth` edits made to this timeline through this crate
+    /// so they can be undone and redone. An applied patch is one step. The
+    /// journal borrows the timeline until it is dropped.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `depth` is 0 or the timeline already has a
+    /// journal.
+    pub fn enable_undo(&mut self, depth: usize) -> Result<UndoJournal<'_>> {
+        let depth = i32::try_from(depth).unwrap_or(i32::MAX);
+        UndoJournal::open(self, |ptr, err| unsafe { ffi::otio_timeline_enable_undo(ptr, depth, err) })
+    }
+
+    /// Release this timeline on a background thread when it is dropped.
+    ///
+    /// Dropping a timeline of a million objects deletes them one at a time,
+    /// which can take hundreds of milliseconds. With this set, the drop only
+    /// queues the timeline; a single background thread tears it down and
+    /// then returns the freed memory to the system (with glibc). Items still
+    /// shared with another timeline, such as by
+    /// [`CloneMode::Shared`](crate::CloneMode::Shared), stay alive as usual.
+    ///
+    /// # Example
+    ///
+    /// ```no_run
+    /// use otio_rs::Timeline;
+    ///
+    /// let mut timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+    /// timeline.set_background_release(true);
+    /// drop(timeline); // returns at once
+    /// Timeline::wait_for_background_releases();
+    /// ```
+    pub fn set_background_release(&mut self, enabled: bool) {
+        unsafe { ffi::otio_timeline_set_background_release(self.ptr, i32::from(enabled)) }
+    }
+
+    /// Block until every timeline dropped with
+    /// [`Timeline::set_background_release`] has been released.
+    pub fn wait_for_background_releases() {
+        unsafe { ffi::otio_wait_for_background_releases() }
+    }
 }
 
-traits::impl_has_metadata!(Timeline, otio_timeline_set_metadata_string, otio_timeline_get_metadata_string);
+traits::impl_has_metadata!(Timeline, otio_timeline_set_metadata_string, otio_timeline_get_metadata_string, otio_timeline_get_metadata_string_view);
+traits::impl_has_fingerprint!(Timeline);
 
 impl Drop for Timeline {
     fn drop(&mut self) {
@@ -580,6 +1370,84 @@ impl Drop for Timeline {
 // Safety: Timeline is safe to send between threads
 unsafe impl Send for Timeline {}
 
+/// A timeline lent for modification by a handle that keeps owning it.
+///
+/// Returned by [`LazyTimeline::timeline_mut`], [`ChangeTracker::timeline_mut`]
+/// and [`UndoJournal::timeline_mut`]. Dereferences to the [`Timeline`] for
+/// reading and has its modifying methods, but never hands out a
+/// `&mut Timeline` that could be swapped with one that owns its pointer.
+pub struct TimelineMut<'a> {
+    ptr: *mut ffi::OtioTimeline,
+    timeline: &'a Timeline,
+}
+
+impl<'a> TimelineMut<'a> {
+    /// Only for lenders holding the timeline exclusively.
+    pub(crate) fn new(timeline: &'a Timeline) -> Self {
+        Self {
+            ptr: timeline.ptr,
+            timeline,
+        }
+    }
+
+    // A transient handle for the `&mut self` methods of Timeline; it never
+    // leaves this impl, so it cannot be moved into an owning position
+    fn lent(&mut self) -> std::mem::ManuallyDrop<Timeline> {
+        std::mem::ManuallyDrop::new(Timeline { ptr: self.ptr })
+    }
+
+    /// See [`Timeline::set_global_start_time`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the global start time cannot be set.
+    pub fn set_global_start_time(&mut self, time: RationalTime) -> Result<()> {
+        self.lent().set_global_start_time(time)
+    }
+
+    /// See [`Timeline::add_video_track`].
+    #[must_use]
+    pub fn add_video_track(&mut self, name: &str) -> Track {
+        self.lent().add_video_track(name)
+    }
+
+    /// See [`Timeline::add_audio_track`].
+    #[must_use]
+    pub fn add_audio_track(&mut self, name: &str) -> Track {
+        self.lent().add_audio_track(name)
+    }
+
+    /// See [`Timeline::apply_patch`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the patch cannot be applied.
+    pub fn apply_patch(&mut self, patch: &str) -> Result<()> {
+        self.lent().apply_patch(patch)
+    }
+}
+
+impl std::ops::Deref for TimelineMut<'_> {
+    type Target = Timeline;
+
+    fn deref(&self) -> &Timeline {
+        self.timeline
+    }
+}
+
+impl std::fmt::Debug for TimelineMut<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_tuple("TimelineMut").field(self.timeline).finish()
+    }
+}
+
+traits::impl_has_metadata!(
+    TimelineMut<'_>,
+    otio_timeline_set_metadata_string,
+    otio_timeline_get_metadata_string,
+    otio_timeline_get_metadata_string_view
+);
+
 // ============================================================================
 // Track Neighbor Types
 // ============================================================================
@@ -606,6 +1474,74 @@ pub struct Neighbors<'a> {
     pub right: Option<Composable<'a>>,
 }
 
+// ============================================================================
+// Owned Children
+// ============================================================================
+
+/// An owned item for the bulk child methods such as `Track::append_children`.
+///
+/// Each variant converts from its item type with `From`, so a batch can be
+/// built with `.into()` or `OwnedComposable::from`.
+#[derive(Debug)]
+pub enum OwnedComposable {
+    /// A clip.
+    Clip(Clip),
+    /// A gap.
+    Gap(Gap),
+    /// A nested stack.
+    Stack(Stack),
+    /// A nested track.
+    Track(Track),
+    /// A transition.
+    Transition(Transition),
+}
+
+impl OwnedComposable {
+    fn raw(&self) -> (*mut std::ffi::c_void, i32) {
+        match self {
+            Self::Clip(clip) => (clip.ptr.cast(), iterators::CHILD_TYPE_CLIP),
+            Self::Gap(gap) => (gap.ptr.cast(), iterators::CHILD_TYPE_GAP),
+            Self::Stack(stack) => (stack.ptr.cast(), iterators::CHILD_TYPE_STACK),
+            Self::Track(track) => (track.ptr.cast(), iterators::CHILD_TYPE_TRACK),
+            Self::Transition(transition) => (transition.ptr.cast(), iterators::CHILD_TYPE_TRANSITION),
+        }
+    }
+}
+
+macro_rules! impl_owned_composable_from {
+    ($($variant:ident),*) => {
+        $(
+            impl From<$variant> for OwnedComposable {
+                fn from(item: $variant) -> Self {
+                    Self::$variant(item)
+                }
+            }
+        )*
+    };
+}
+
+impl_owned_composable_from!(Clip, Gap, Stack, Track, Transition);
+
+/// Hand a batch of children to a bulk FFI call. Ownership moves to C++ only
+/// if the call succeeds; otherwise the children are dropped here.
+#[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap)]
+pub(crate) fn add_children(
+    children: impl IntoIterator<Item = OwnedComposable>,
+    add: impl FnOnce(*const *mut std::ffi::c_void, *const i32, i32, *mut ffi::OtioError) -> i32,
+) -> Result<()> {
+    let children: Vec<OwnedComposable> = children.into_iter().collect();
+    let (items, types): (Vec<_>, Vec<_>) = children.iter().map(OwnedComposable::raw).unzip();
+    let mut err = macros::ffi_error!();
+    let result = add(items.as_ptr(), types.as_ptr(), items.len() as i32, &mut err);
+    if result != 0 {
+        return Err(err.into());
+    }
+    for child in children {
+        std::mem::forget(child);
+    }
+    Ok(())
+}
+
 /// A track contains clips, gaps, and other items.
 ///
 /// Tracks can be created standalone or added to a Timeline. When created
@@ -697,6 +1633,14 @@ impl Track {
         count.max(0) as usize
     }
 
+    /// Iterate the markers on this track, without copying any that a
+    /// shared fork also holds.
+    pub fn markers(&self) -> impl Iterator<Item = MarkerRef<'_>> + '_ {
+        let ptr = self.ptr;
+        let count = unsafe { ffi::otio_track_markers_count(ptr) };
+        marker::attached_markers(count, move |i| unsafe { ffi::otio_track_marker_at(ptr, i) })
+    }
+
     /// Get the range of a child at the given index within this track.
     ///
     /// This returns the time range of the child relative to the track's
@@ -752,6 +1696,23 @@ impl Track {
         ClipSearchIter::new(ptr)
     }
 
+    /// Collect the clips that are direct children of this track into `out`,
+    /// replacing its contents.
+    ///
+    /// See [`Timeline::find_clips_into`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the children cannot be read.
+    pub fn find_clips_into<'a>(&'a self, out: &mut Vec<ClipRef<'a>>) -> Result<()> {
+        // SAFETY: ClipRef is a transparent clip handle
+        unsafe {
+            iterators::fill_handles(out, |clips, capacity, err| {
+                ffi::otio_track_find_clips_into(self.ptr, clips, capacity, err)
+            })
+        }
+    }
+
     /// Get the neighbors of a child at the given index.
     ///
     /// Returns the items immediately before and after the child at `index`.
@@ -930,9 +1891,83 @@ impl Track {
         }
         Ok(())
     }
+
+    /// Build a [`TimeIndex`] over the children of this track.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range of a child cannot be computed.
+    pub fn build_time_index(&self) -> Result<TimeIndex<'_>> {
+        TimeIndex::build(|err| unsafe { ffi::otio_track_build_time_index(self.ptr, err) })
+    }
+
+    /// Resolve what every frame of this track shows over `range`, in the
+    /// track's own time.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of a
+    /// child cannot be computed.
+    pub fn render_manifest(&self, range: TimeRange) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_track_build_render_manifest(self.ptr, range.into(), err)
+        })
+    }
+
+    /// Like [`Track::render_manifest`], but evaluated in chunks of frames on
+    /// up to `threads` threads (0 uses one per hardware thread).
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of a
+    /// child cannot be computed.
+    pub fn render_manifest_parallel(
+        &self,
+        range: TimeRange,
+        threads: usize,
+    ) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_track_build_render_manifest_parallel(
+                self.ptr,
+                range.into(),
+                i32::try_from(threads).unwrap_or(i32::MAX),
+                err,
+            )
+        })
+    }
+
+    /// Lazily find the items in this track that match `filter`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the filter is invalid.
+    pub fn search(&self, filter: &SearchFilter) -> Result<SearchIter<'_>> {
+        SearchIter::open(filter, |raw, err| unsafe { ffi::otio_track_search(self.ptr, raw, err) })
+    }
+
+    /// Memoize `range_of_child_at_index` and `trimmed_range` on this track
+    /// while the returned [`RangeCache`] lives.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if caching is already enabled for this track.
+    pub fn enable_range_cache(&self) -> Result<RangeCache<'_>> {
+        RangeCache::enable(|err| unsafe { ffi::otio_track_enable_range_cache(self.ptr, err) })
+    }
+
+    /// Start a batch of edit algorithm calls on this track, applied together
+    /// by [`TrackEdit::commit`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the batch cannot be created.
+    pub fn begin_edit(&mut self) -> Result<TrackEdit<'_>> {
+        TrackEdit::begin(|err| unsafe { ffi::otio_track_begin_edit(self.ptr, err) })
+    }
 }
 
-traits::impl_has_metadata!(Track, otio_track_set_metadata_string, otio_track_get_metadata_string);
+traits::impl_has_metadata!(Track, otio_track_set_metadata_string, otio_track_get_metadata_string, otio_track_get_metadata_string_view);
+traits::impl_has_fingerprint!(Track);
 
 impl Drop for Track {
     fn drop(&mut self) {
@@ -966,6 +2001,13 @@ impl Clip {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_clip_get_name_view,
+        otio_clip_get_name,
+        "Call `f` with the name of this clip."
+    );
+
     /// Create a new clip with the given name and source range.
     #[must_use]
     pub fn new(name: &str, source_range: TimeRange) -> Self {
@@ -1103,23 +2145,38 @@ impl Clip {
     ///
     /// Returns a list of all keys in the clip's media reference map.
     #[must_use]
-    #[allow(clippy::cast_sign_loss)]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
     pub fn media_reference_keys(&self) -> Vec<String> {
-        let iter = unsafe { ffi::otio_clip_media_reference_keys(self.ptr) };
-        if iter.is_null() {
-            return Vec::new();
-        }
-        let count = unsafe { ffi::otio_string_iterator_count(iter) } as usize;
-        let mut keys = Vec::with_capacity(count);
-        loop {
-            let ptr = unsafe { ffi::otio_string_iterator_next(iter) };
-            if ptr.is_null() {
-                break;
-            }
-            keys.push(ffi_string_to_rust(ptr));
+        // Clips rarely have more than a few references; the export is only
+        // repeated into a heap buffer if there are more than this
+        const INLINE_KEYS: usize = 8;
+        let export = |views: &mut [ffi::OtioStringView]| -> usize {
+            let mut err = macros::ffi_error!();
+            let total = unsafe {
+                ffi::otio_clip_media_reference_keys_into(self.ptr, views.as_mut_ptr(), views.len() as i32, &mut err)
+            };
+            total.max(0) as usize
+        };
+        let keys = |views: &[ffi::OtioStringView]| -> Vec<String> {
+            views
+                .iter()
+                // SAFETY: the views stay valid until the next export on this thread
+                .filter_map(|view| unsafe { bytes_from_view(view) })
+                .map(|bytes| String::from_utf8_lossy(bytes).into_owned())
+                .collect()
+        };
+        let empty = ffi::OtioStringView {
+            data: std::ptr::null(),
+            len: 0,
+        };
+        let mut inline = [empty; INLINE_KEYS];
+        let total = export(&mut inline);
+        if total <= INLINE_KEYS {
+            return keys(&inline[..total]);
         }
-        unsafe { ffi::otio_string_iterator_free(iter) };
-        keys
+        let mut heap = vec![empty; total];
+        let total = export(&mut heap).min(heap.len());
+        keys(&heap[..total])
     }
 
     /// Check if a media reference exists for the given key.
@@ -1277,6 +2334,14 @@ impl Clip {
         count.max(0) as usize
     }
 
+    /// Iterate the markers on this clip, without copying any that a
+    /// shared fork also holds.
+    pub fn markers(&self) -> impl Iterator<Item = MarkerRef<'_>> + '_ {
+        let ptr = self.ptr;
+        let count = unsafe { ffi::otio_clip_markers_count(ptr) };
+        marker::attached_markers(count, move |i| unsafe { ffi::otio_clip_marker_at(ptr, i) })
+    }
+
     /// Add an effect to this clip.
     ///
     /// # Errors
@@ -1438,7 +2503,8 @@ impl Clip {
     }
 }
 
-traits::impl_has_metadata!(Clip, otio_clip_set_metadata_string, otio_clip_get_metadata_string);
+traits::impl_has_metadata!(Clip, otio_clip_set_metadata_string, otio_clip_get_metadata_string, otio_clip_get_metadata_string_view);
+traits::impl_has_fingerprint!(Clip);
 
 /// A gap represents empty space in a track.
 pub struct Gap {
@@ -1460,7 +2526,8 @@ impl Gap {
     }
 }
 
-traits::impl_has_metadata!(Gap, otio_gap_set_metadata_string, otio_gap_get_metadata_string);
+traits::impl_has_metadata!(Gap, otio_gap_set_metadata_string, otio_gap_get_metadata_string, otio_gap_get_metadata_string_view);
+traits::impl_has_fingerprint!(Gap);
 
 /// An external reference points to a media file.
 pub struct ExternalReference {
@@ -1491,6 +2558,13 @@ impl ExternalReference {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_external_ref_get_name_view,
+        otio_external_ref_get_name,
+        "Call `f` with the name of this external reference."
+    );
+
     /// Set the name of this external reference.
     pub fn set_name(&mut self, name: &str) {
         let c_name = CString::new(name).unwrap();
@@ -1520,6 +2594,13 @@ impl ExternalReference {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_target_url,
+        otio_external_ref_get_target_url_view,
+        otio_external_ref_get_target_url,
+        "Call `f` with the target url of this external reference."
+    );
+
     /// Get the available range of this media reference.
     ///
     /// Returns `None` if no available range has been set.
@@ -1533,7 +2614,8 @@ impl ExternalReference {
     }
 }
 
-traits::impl_has_metadata!(ExternalReference, otio_external_ref_set_metadata_string, otio_external_ref_get_metadata_string);
+traits::impl_has_metadata!(ExternalReference, otio_external_ref_set_metadata_string, otio_external_ref_get_metadata_string, otio_external_ref_get_metadata_string_view);
+traits::impl_has_fingerprint!(ExternalReference);
 
 /// A stack is a composition that layers its children.
 ///
@@ -1562,6 +2644,13 @@ impl Stack {
         ffi_string_to_rust(ptr)
     }
 
+    macros::impl_str_view!(
+        with_name,
+        otio_stack_get_name_view,
+        otio_stack_get_name,
+        "Call `f` with the name of this stack."
+    );
+
     /// Create a new stack with the given name.
     #[must_use]
     pub fn new(name: &str) -> Self {
@@ -1634,9 +2723,91 @@ impl Stack {
         let ptr = unsafe { ffi::otio_stack_find_clips(self.ptr) };
         ClipSearchIter::new(ptr)
     }
+
+    /// Collect all clips in this stack (recursively) into `out`, replacing
+    /// its contents.
+    ///
+    /// See [`Timeline::find_clips_into`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the children cannot be walked.
+    pub fn find_clips_into<'a>(&'a self, out: &mut Vec<ClipRef<'a>>) -> Result<()> {
+        // SAFETY: ClipRef is a transparent clip handle
+        unsafe {
+            iterators::fill_handles(out, |clips, capacity, err| {
+                ffi::otio_stack_find_clips_into(self.ptr, clips, capacity, err)
+            })
+        }
+    }
+
+    /// Build a [`TimeIndex`] over the children of this stack.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range of a child cannot be computed.
+    pub fn build_time_index(&self) -> Result<TimeIndex<'_>> {
+        TimeIndex::build(|err| unsafe { ffi::otio_stack_build_time_index(self.ptr, err) })
+    }
+
+    /// Resolve what every frame of this stack shows over `range`, in the
+    /// stack's own time. The topmost child with something at a frame wins.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of a
+    /// child cannot be computed.
+    pub fn render_manifest(&self, range: TimeRange) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_stack_build_render_manifest(self.ptr, range.into(), err)
+        })
+    }
+
+    /// Like [`Stack::render_manifest`], but with every child sampled in
+    /// chunks of frames on up to `threads` threads (0 uses one per hardware
+    /// thread).
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the range has no frame rate, or the range of a
+    /// child cannot be computed.
+    pub fn render_manifest_parallel(
+        &self,
+        range: TimeRange,
+        threads: usize,
+    ) -> Result<RenderManifest<'_>> {
+        RenderManifest::build(|err| unsafe {
+            ffi::otio_stack_build_render_manifest_parallel(
+                self.ptr,
+                range.into(),
+                i32::try_from(threads).unwrap_or(i32::MAX),
+                err,
+            )
+        })
+    }
+
+    /// Lazily find the items in this stack that match `filter`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the filter is invalid.
+    pub fn search(&self, filter: &SearchFilter) -> Result<SearchIter<'_>> {
+        SearchIter::open(filter, |raw, err| unsafe { ffi::otio_stack_search(self.ptr, raw, err) })
+    }
+
+    /// Memoize `range_of_child_at_index` and `trimmed_range` on this stack
+    /// while the returned [`RangeCache`] lives.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if caching is already enabled for this stack.
+    pub fn enable_range_cache(&self) -> Result<RangeCache<'_>> {
+        RangeCache::enable(|err| unsafe { ffi::otio_stack_enable_range_cache(self.ptr, err) })
+    }
 }
 
-traits::impl_has_metadata!(Stack, otio_stack_set_metadata_string, otio_stack_get_metadata_string);
+traits::impl_has_metadata!(Stack, otio_stack_set_metadata_string, otio_stack_get_metadata_string, otio_stack_get_metadata_string_view);
+traits::impl_has_fingerprint!(Stack);
 
 impl Drop for Stack {
     fn drop(&mut self) {
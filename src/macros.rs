@@ -124,6 +124,48 @@ macro_rules! impl_children_count {
     };
 }
 
+/// Implements `append_children` and `insert_children` on top of the bulk FFI calls.
+macro_rules! impl_bulk_children {
+    ($append_fn:ident, $insert_fn:ident) => {
+        /// Append several children in one call.
+        ///
+        /// The whole batch is checked before anything is attached, so on
+        /// error this container is left unchanged.
+        ///
+        /// # Errors
+        ///
+        /// Returns an error if a child already has a parent or appears twice.
+        pub fn append_children(
+            &mut self,
+            children: impl IntoIterator<Item = crate::OwnedComposable>,
+        ) -> crate::Result<()> {
+            crate::add_children(children, |items, types, count, err| unsafe {
+                crate::ffi::$append_fn(self.ptr, items, types, count, err)
+            })
+        }
+
+        /// Insert several children before `index`, keeping their order.
+        ///
+        /// An index past the end appends. The existing children are shifted
+        /// once for the whole batch.
+        ///
+        /// # Errors
+        ///
+        /// Returns an error if a child already has a parent or appears twice.
+        #[allow(clippy::cast_possible_truncation)]
+        #[allow(clippy::cast_possible_wrap)]
+        pub fn insert_children(
+            &mut self,
+            index: usize,
+            children: impl IntoIterator<Item = crate::OwnedComposable>,
+        ) -> crate::Result<()> {
+            crate::add_children(children, |items, types, count, err| unsafe {
+                crate::ffi::$insert_fn(self.ptr, index as i32, items, types, count, err)
+            })
+        }
+    };
+}
+
 /// Implements all Track child operations (append/insert clip, gap, stack, transition + remove/clear).
 ///
 /// # Usage
@@ -169,6 +211,8 @@ macro_rules! impl_track_ops {
             "Insert a transition at the given index."
         );
 
+        crate::macros::impl_bulk_children!(otio_track_append_children, otio_track_insert_children);
+
         crate::macros::impl_children_count!(otio_track_children_count);
         crate::macros::impl_remove_child!(otio_track_remove_child);
         crate::macros::impl_clear_children!(otio_track_clear_children);
@@ -220,6 +264,8 @@ macro_rules! impl_stack_ops {
             "Insert a child stack at the given index."
         );
 
+        crate::macros::impl_bulk_children!(otio_stack_append_children, otio_stack_insert_children);
+
         crate::macros::impl_children_count!(otio_stack_children_count);
         crate::macros::impl_remove_child!(otio_stack_remove_child);
         crate::macros::impl_clear_children!(otio_stack_clear_children);
@@ -249,6 +295,34 @@ macro_rules! impl_string_getter {
     };
 }
 
+/// Generates a closure-based string accessor backed by a shim string view.
+///
+/// The string is lent to the closure instead of being copied into a `String`,
+/// so reading it does not allocate.
+///
+/// # Usage
+/// ```ignore
+/// impl Marker {
+///     impl_str_view!(with_color, otio_marker_get_color_view, otio_marker_get_color,
+///         "Call `f` with the marker color.");
+/// }
+/// ```
+macro_rules! impl_str_view {
+    ($method:ident, $view_fn:ident, $owned_fn:ident, $doc:expr) => {
+        #[doc = $doc]
+        ///
+        /// The string is only borrowed for the duration of `f`, which avoids
+        /// an allocation per call.
+        pub fn $method<R>(&self, f: impl FnOnce(&str) -> R) -> R {
+            crate::with_scratch_view(
+                || unsafe { crate::ffi::$view_fn(self.ptr) },
+                || crate::ffi_string_to_rust(unsafe { crate::ffi::$owned_fn(self.ptr) }),
+                f,
+            )
+        }
+    };
+}
+
 /// Generates a string setter method.
 ///
 /// # Usage
@@ -362,6 +436,7 @@ macro_rules! impl_double_setter {
 
 pub(crate) use ffi_error;
 pub(crate) use impl_append;
+pub(crate) use impl_bulk_children;
 pub(crate) use impl_children_count;
 pub(crate) use impl_clear_children;
 pub(crate) use impl_double_getter;
@@ -371,6 +446,7 @@ pub(crate) use impl_rational_time_getter;
 pub(crate) use impl_rational_time_setter;
 pub(crate) use impl_remove_child;
 pub(crate) use impl_stack_ops;
+pub(crate) use impl_str_view;
 pub(crate) use impl_string_getter;
 pub(crate) use impl_string_setter;
 pub(crate) use impl_time_range_getter;
@@ -2,6 +2,7 @@
 
 use crate::{ffi, macros, traits, TimeRange};
 use std::ffi::CString;
+use std::marker::PhantomData;
 
 /// Predefined marker colors matching OTIO's `Marker::Color` constants.
 pub mod colors {
@@ -60,7 +61,19 @@ impl Marker {
     }
 
     macros::impl_string_getter!(name, otio_marker_get_name, "Get the name of this marker.");
+    macros::impl_str_view!(
+        with_name,
+        otio_marker_get_name_view,
+        otio_marker_get_name,
+        "Call `f` with the name of this marker."
+    );
     macros::impl_string_getter!(color, otio_marker_get_color, "Get the color of this marker.");
+    macros::impl_str_view!(
+        with_color,
+        otio_marker_get_color_view,
+        otio_marker_get_color,
+        "Call `f` with the color of this marker."
+    );
     macros::impl_string_setter!(set_color, otio_marker_set_color, "Set the color of this marker.");
     macros::impl_time_range_getter!(
         marked_range,
@@ -73,14 +86,22 @@ impl Marker {
         "Set the marked range."
     );
     macros::impl_string_getter!(comment, otio_marker_get_comment, "Get the comment.");
+    macros::impl_str_view!(
+        with_comment,
+        otio_marker_get_comment_view,
+        otio_marker_get_comment,
+        "Call `f` with the comment."
+    );
     macros::impl_string_setter!(set_comment, otio_marker_set_comment, "Set the comment.");
 }
 
 traits::impl_has_metadata!(
     Marker,
     otio_marker_set_metadata_string,
-    otio_marker_get_metadata_string
+    otio_marker_get_metadata_string,
+    otio_marker_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(Marker);
 
 impl Drop for Marker {
     fn drop(&mut self) {
@@ -90,3 +111,43 @@ impl Drop for Marker {
 
 // Safety: Marker is safe to send between threads
 unsafe impl Send for Marker {}
+
+/// A non-owning, read-only view of a marker attached to a clip or track.
+///
+/// Reading through it never copies a marker that a fork made with
+/// [`CloneMode::Shared`](crate::CloneMode::Shared) shares.
+#[derive(Debug)]
+pub struct MarkerRef<'a> {
+    ptr: *mut ffi::OtioMarker,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl MarkerRef<'_> {
+    macros::impl_string_getter!(name, otio_marker_get_name, "Get the name of this marker.");
+    macros::impl_string_getter!(color, otio_marker_get_color, "Get the color of this marker.");
+    macros::impl_time_range_getter!(
+        marked_range,
+        otio_marker_get_marked_range,
+        "Get the range this marker covers."
+    );
+    macros::impl_string_getter!(comment, otio_marker_get_comment, "Get the comment.");
+
+    /// Whether another clip or track also holds this marker, as forks made
+    /// with [`CloneMode::Shared`](crate::CloneMode::Shared) do until one of
+    /// them edits it.
+    #[must_use]
+    pub fn is_shared(&self) -> bool {
+        unsafe { ffi::otio_marker_is_shared(self.ptr) != 0 }
+    }
+}
+
+/// The markers of a clip or track, read through `at`.
+pub(crate) fn attached_markers<'a>(
+    count: i32,
+    at: impl Fn(i32) -> *mut ffi::OtioMarker + 'a,
+) -> impl Iterator<Item = MarkerRef<'a>> + 'a {
+    (0..count).map(at).filter(|ptr| !ptr.is_null()).map(|ptr| MarkerRef {
+        ptr,
+        _marker: PhantomData,
+    })
+}
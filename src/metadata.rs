@@ -0,0 +1,374 @@
+//! Typed metadata values.
+//!
+//! OTIO metadata dictionaries hold numbers, flags, strings and nested
+//! dictionaries and arrays, not only strings. The typed accessors of
+//! [`HasMetadata`](crate::HasMetadata) read and write those values in place,
+//! and [`HasMetadata::all_metadata`](crate::HasMetadata::all_metadata) copies
+//! a whole dictionary across the FFI boundary in one call, as the compact
+//! encoding described in `otio_shim.h`.
+
+use std::collections::BTreeMap;
+use std::ffi::c_void;
+
+use crate::{ffi, macros, with_c_key, OtioError, Result};
+
+const TAG_NULL: u8 = 0;
+const TAG_BOOL: u8 = 1;
+const TAG_INT: u8 = 2;
+const TAG_DOUBLE: u8 = 3;
+const TAG_STRING: u8 = 4;
+const TAG_DICT: u8 = 5;
+const TAG_ARRAY: u8 = 6;
+const TAG_OTHER: u8 = 7;
+
+/// A metadata value of any kind.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Clip, HasMetadata, MetadataValue, RationalTime, TimeRange};
+///
+/// let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0));
+/// let mut clip = Clip::new("Shot", range);
+/// clip.set_metadata_i64("take", 3);
+/// clip.set_metadata_value("tags", &MetadataValue::from(vec!["hero".into(), "cgi".into()]))
+///     .unwrap();
+///
+/// assert_eq!(clip.get_metadata_i64("take"), Some(3));
+/// let all = clip.all_metadata().unwrap();
+/// assert_eq!(all["tags"].as_array().unwrap().len(), 2);
+/// ```
+#[derive(Debug, Clone, PartialEq)]
+pub enum MetadataValue {
+    /// A null value.
+    Null,
+    /// A boolean.
+    Bool(bool),
+    /// An integer.
+    Int(i64),
+    /// A floating point number.
+    Double(f64),
+    /// A string.
+    String(String),
+    /// A nested dictionary.
+    Dict(BTreeMap<String, MetadataValue>),
+    /// An array.
+    Array(Vec<MetadataValue>),
+    /// A value this crate can't represent (a time, a range or a schema
+    /// object), with the name of its type. It can be read but not set.
+    Other(String),
+}
+
+impl MetadataValue {
+    /// The boolean, if this is one.
+    #[must_use]
+    pub fn as_bool(&self) -> Option<bool> {
+        match self {
+            Self::Bool(b) => Some(*b),
+            _ => None,
+        }
+    }
+
+    /// The integer, if this is one.
+    #[must_use]
+    pub fn as_i64(&self) -> Option<i64> {
+        match self {
+            Self::Int(i) => Some(*i),
+            _ => None,
+        }
+    }
+
+    /// The number, if this is a double.
+    #[must_use]
+    pub fn as_f64(&self) -> Option<f64> {
+        match self {
+            Self::Double(d) => Some(*d),
+            _ => None,
+        }
+    }
+
+    /// The string, if this is one.
+    #[must_use]
+    pub fn as_str(&self) -> Option<&str> {
+        match self {
+            Self::String(s) => Some(s),
+            _ => None,
+        }
+    }
+
+    /// The dictionary, if this is one.
+    #[must_use]
+    pub fn as_dict(&self) -> Option<&BTreeMap<String, MetadataValue>> {
+        match self {
+            Self::Dict(dict) => Some(dict),
+            _ => None,
+        }
+    }
+
+    /// The elements, if this is an array.
+    #[must_use]
+    pub fn as_array(&self) -> Option<&[MetadataValue]> {
+        match self {
+            Self::Array(array) => Some(array),
+            _ => None,
+        }
+    }
+}
+
+impl From<bool> for MetadataValue {
+    fn from(value: bool) -> Self {
+        Self::Bool(value)
+    }
+}
+
+impl From<i64> for MetadataValue {
+    fn from(value: i64) -> Self {
+        Self::Int(value)
+    }
+}
+
+impl From<f64> for MetadataValue {
+    fn from(value: f64) -> Self {
+        Self::Double(value)
+    }
+}
+
+impl From<&str> for MetadataValue {
+    fn from(value: &str) -> Self {
+        Self::String(value.to_string())
+    }
+}
+
+impl From<String> for MetadataValue {
+    fn from(value: String) -> Self {
+        Self::String(value)
+    }
+}
+
+impl From<Vec<MetadataValue>> for MetadataValue {
+    fn from(value: Vec<MetadataValue>) -> Self {
+        Self::Array(value)
+    }
+}
+
+impl From<BTreeMap<String, MetadataValue>> for MetadataValue {
+    fn from(value: BTreeMap<String, MetadataValue>) -> Self {
+        Self::Dict(value)
+    }
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+fn encoding_error(message: &str) -> OtioError {
+    OtioError {
+        code: 1,
+        message: message.to_string(),
+    }
+}
+
+#[allow(clippy::cast_possible_truncation)]
+fn put_len(out: &mut Vec<u8>, len: usize) -> Result<()> {
+    if len > u32::MAX as usize {
+        return Err(encoding_error("Metadata value is too large to encode"));
+    }
+    out.extend_from_slice(&(len as u32).to_le_bytes());
+    Ok(())
+}
+
+fn put_bytes(out: &mut Vec<u8>, bytes: &[u8]) -> Result<()> {
+    put_len(out, bytes.len())?;
+    out.extend_from_slice(bytes);
+    Ok(())
+}
+
+fn encode(out: &mut Vec<u8>, value: &MetadataValue) -> Result<()> {
+    match value {
+        MetadataValue::Null => out.push(TAG_NULL),
+        MetadataValue::Bool(b) => out.extend_from_slice(&[TAG_BOOL, u8::from(*b)]),
+        MetadataValue::Int(i) => {
+            out.push(TAG_INT);
+            out.extend_from_slice(&i.to_le_bytes());
+        }
+        MetadataValue::Double(d) => {
+            out.push(TAG_DOUBLE);
+            out.extend_from_slice(&d.to_le_bytes());
+        }
+        MetadataValue::String(s) => {
+            out.push(TAG_STRING);
+            put_bytes(out, s.as_bytes())?;
+        }
+        MetadataValue::Dict(dict) => {
+            out.push(TAG_DICT);
+            put_len(out, dict.len())?;
+            for (key, value) in dict {
+                put_bytes(out, key.as_bytes())?;
+                encode(out, value)?;
+            }
+        }
+        MetadataValue::Array(array) => {
+            out.push(TAG_ARRAY);
+            put_len(out, array.len())?;
+            for value in array {
+                encode(out, value)?;
+            }
+        }
+        MetadataValue::Other(name) => {
+            return Err(encoding_error(&format!("Cannot set a metadata value of type {name}")));
+        }
+    }
+    Ok(())
+}
+
+struct Reader<'a> {
+    bytes: &'a [u8],
+}
+
+impl<'a> Reader<'a> {
+    fn take(&mut self, n: usize) -> Result<&'a [u8]> {
+        if self.bytes.len() < n {
+            return Err(encoding_error("Truncated metadata encoding"));
+        }
+        let (head, rest) = self.bytes.split_at(n);
+        self.bytes = rest;
+        Ok(head)
+    }
+
+    fn array<const N: usize>(&mut self) -> Result<[u8; N]> {
+        Ok(self.take(N)?.try_into().expect("took N bytes"))
+    }
+
+    fn len(&mut self) -> Result<usize> {
+        Ok(u32::from_le_bytes(self.array()?) as usize)
+    }
+
+    fn string(&mut self) -> Result<String> {
+        let len = self.len()?;
+        Ok(String::from_utf8_lossy(self.take(len)?).into_owned())
+    }
+
+    fn value(&mut self) -> Result<MetadataValue> {
+        let [tag] = self.array()?;
+        Ok(match tag {
+            TAG_NULL => MetadataValue::Null,
+            TAG_BOOL => MetadataValue::Bool(self.array::<1>()?[0] != 0),
+            TAG_INT => MetadataValue::Int(i64::from_le_bytes(self.array()?)),
+            TAG_DOUBLE => MetadataValue::Double(f64::from_le_bytes(self.array()?)),
+            TAG_STRING => MetadataValue::String(self.string()?),
+            TAG_DICT => {
+                let mut dict = BTreeMap::new();
+                for _ in 0..self.len()? {
+                    let key = self.string()?;
+                    dict.insert(key, self.value()?);
+                }
+                MetadataValue::Dict(dict)
+            }
+            TAG_ARRAY => {
+                let count = self.len()?;
+                // Every value takes at least one byte
+                let mut array = Vec::with_capacity(count.min(self.bytes.len()));
+                for _ in 0..count {
+                    array.push(self.value()?);
+                }
+                MetadataValue::Array(array)
+            }
+            TAG_OTHER => MetadataValue::Other(self.string()?),
+            _ => return Err(encoding_error("Unknown metadata tag")),
+        })
+    }
+}
+
+fn decode(bytes: &[u8]) -> Result<MetadataValue> {
+    Reader { bytes }.value()
+}
+
+// ============================================================================
+// FFI helpers for `impl_has_metadata!`
+// ============================================================================
+
+/// Initial export buffer size; the export is repeated once with the exact
+/// size if the encoding is larger.
+const INITIAL_CAPACITY: usize = 1024;
+
+/// Run an export into a growing buffer. `Ok(None)` if it wrote nothing.
+#[allow(clippy::cast_sign_loss, clippy::cast_possible_truncation)]
+fn export(mut run: impl FnMut(*mut u8, usize, *mut ffi::OtioError) -> i64) -> Result<Option<MetadataValue>> {
+    let mut buf = vec![0u8; INITIAL_CAPACITY];
+    loop {
+        let mut err = macros::ffi_error!();
+        let size = run(buf.as_mut_ptr(), buf.len(), &mut err);
+        if size < 0 {
+            return Err(OtioError::from(err));
+        }
+        let size = size as usize;
+        if size == 0 {
+            return Ok(None);
+        }
+        if size <= buf.len() {
+            return decode(&buf[..size]).map(Some);
+        }
+        buf.resize(size, 0);
+    }
+}
+
+pub(crate) fn get_i64(obj: *mut c_void, key: &str) -> Option<i64> {
+    let mut out = 0;
+    let found = with_c_key(key, |c_key| unsafe { ffi::otio_metadata_get_int64(obj, c_key, &mut out) })?;
+    (found != 0).then_some(out)
+}
+
+pub(crate) fn get_f64(obj: *mut c_void, key: &str) -> Option<f64> {
+    let mut out = 0.0;
+    let found = with_c_key(key, |c_key| unsafe { ffi::otio_metadata_get_double(obj, c_key, &mut out) })?;
+    (found != 0).then_some(out)
+}
+
+pub(crate) fn get_bool(obj: *mut c_void, key: &str) -> Option<bool> {
+    let mut out = 0;
+    let found = with_c_key(key, |c_key| unsafe { ffi::otio_metadata_get_bool(obj, c_key, &mut out) })?;
+    (found != 0).then_some(out != 0)
+}
+
+/// Run a typed setter. They only fail for handles without metadata, which
+/// the safe wrappers never hold, so errors are dropped like those of the
+/// string setter.
+pub(crate) fn set(
+    key: &str,
+    run: impl FnOnce(*const std::ffi::c_char, *mut ffi::OtioError) -> i32,
+) {
+    let c_key = std::ffi::CString::new(key).unwrap();
+    let mut err = macros::ffi_error!();
+    run(c_key.as_ptr(), &mut err);
+}
+
+pub(crate) fn get_value(obj: *mut c_void, key: &str) -> Option<MetadataValue> {
+    let c_key = std::ffi::CString::new(key).ok()?;
+    export(|buf, capacity, err| unsafe {
+        ffi::otio_metadata_export_value(obj, c_key.as_ptr(), buf, capacity, err)
+    })
+    .ok()
+    .flatten()
+}
+
+pub(crate) fn set_value(obj: *mut c_void, key: &str, value: &MetadataValue) -> Result<()> {
+    let c_key = std::ffi::CString::new(key).unwrap();
+    let mut encoded = Vec::new();
+    encode(&mut encoded, value)?;
+    let mut err = macros::ffi_error!();
+    let result = unsafe {
+        ffi::otio_metadata_import_value(obj, c_key.as_ptr(), encoded.as_ptr(), encoded.len(), &mut err)
+    };
+    if result != 0 {
+        return Err(OtioError::from(err));
+    }
+    Ok(())
+}
+
+pub(crate) fn all(obj: *mut c_void) -> Result<BTreeMap<String, MetadataValue>> {
+    match export(|buf, capacity, err| unsafe { ffi::otio_metadata_export(obj, buf, capacity, err) })? {
+        Some(MetadataValue::Dict(dict)) => Ok(dict),
+        _ => Err(encoding_error("Metadata export is not a dictionary")),
+    }
+}
+
@@ -42,8 +42,10 @@ impl Default for MissingReference {
 traits::impl_has_metadata!(
     MissingReference,
     otio_missing_ref_set_metadata_string,
-    otio_missing_ref_get_metadata_string
+    otio_missing_ref_get_metadata_string,
+    otio_missing_ref_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(MissingReference);
 
 impl Drop for MissingReference {
     fn drop(&mut self) {
@@ -0,0 +1,91 @@
+//! Opt-in memoization of child and trimmed ranges.
+//!
+//! `range_of_child_at_index` on a track re-sums every preceding sibling, so
+//! walking a long track costs O(n²). While a [`RangeCache`] is alive for a
+//! track or stack, its ranges are kept as a prefix that edits made through
+//! this crate only truncate from the first affected child on.
+
+use std::marker::PhantomData;
+
+use crate::{ffi, macros, OtioError, Result};
+
+/// Counters reported by [`RangeCache::stats`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct RangeCacheStats {
+    /// Queries answered from the cache.
+    pub hits: u64,
+    /// Queries that had to compute something.
+    pub misses: u64,
+    /// Child ranges computed on misses.
+    pub recomputed: u64,
+}
+
+/// Enables range caching on a track or stack for as long as it lives.
+///
+/// Created by [`Track::enable_range_cache`](crate::Track::enable_range_cache)
+/// or [`Stack::enable_range_cache`](crate::Stack::enable_range_cache). The
+/// cached results are used by the existing `range_of_child_at_index` and
+/// `trimmed_range` methods; dropping the handle turns caching off again. The
+/// cache borrows the handle it was enabled on.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::Timeline;
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let track = timeline.video_tracks().next().unwrap();
+/// let cache = track.enable_range_cache().unwrap();
+/// for i in 0..track.children_count() {
+///     let _ = track.range_of_child_at_index(i);
+/// }
+/// println!("{:?}", cache.stats());
+/// ```
+pub struct RangeCache<'a> {
+    ptr: *mut ffi::OtioRangeCache,
+    _target: PhantomData<&'a ()>,
+}
+
+impl RangeCache<'_> {
+    pub(crate) fn enable(open: impl FnOnce(*mut ffi::OtioError) -> *mut ffi::OtioRangeCache) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(&mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self {
+            ptr,
+            _target: PhantomData,
+        })
+    }
+
+    /// Get the hit, miss and recompute counters.
+    #[must_use]
+    pub fn stats(&self) -> RangeCacheStats {
+        let mut stats = ffi::OtioRangeCacheStats {
+            hits: 0,
+            misses: 0,
+            recomputed: 0,
+        };
+        unsafe { ffi::otio_range_cache_get_stats(self.ptr, &mut stats) };
+        RangeCacheStats {
+            hits: stats.hits,
+            misses: stats.misses,
+            recomputed: stats.recomputed,
+        }
+    }
+}
+
+impl std::fmt::Debug for RangeCache<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("RangeCache")
+            .field("stats", &self.stats())
+            .finish_non_exhaustive()
+    }
+}
+
+impl Drop for RangeCache<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_range_cache_free(self.ptr) }
+    }
+}
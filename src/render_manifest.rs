@@ -0,0 +1,238 @@
+//! Frame-to-source render manifests.
+//!
+//! A [`RenderManifest`] resolves every frame of a track, stack or timeline
+//! over a range into the clip it shows, the source time and the media URL,
+//! run-length encoded. Time warps, freeze frames, transitions and image
+//! sequences are resolved in the shim in one pass, and the result is plain
+//! data: it can be sliced, or sent to another machine, without touching the
+//! timeline again.
+
+use std::ops::Range;
+
+use crate::{ffi, macros, ClipRef, OtioError, RationalTime, Result, TransitionRef};
+
+/// A span of frames whose source time and URL advance by a constant step.
+#[derive(Debug)]
+pub struct ManifestRun<'a> {
+    /// Frames of the manifest covered by the run, counted from the start of
+    /// the range it was built for.
+    pub frames: Range<u64>,
+    /// The clip shown, `None` where nothing is (gaps, disabled items).
+    pub clip: Option<ClipRef<'a>>,
+    /// Source time of the first frame, at `source_rate`.
+    pub source_start: f64,
+    /// Source time added per frame; 0 for a freeze frame.
+    pub source_step: f64,
+    /// Rate of the clip's source range.
+    pub source_rate: f64,
+    /// URL of the first frame in [`RenderManifest::urls`], `None` without one.
+    pub url_index: Option<usize>,
+    /// Added to `url_index` per frame: 0 for a single media file, 1 while an
+    /// image sequence plays forward through new images.
+    pub url_step: i64,
+    /// Index into [`RenderManifest::transitions`], `None` outside transitions.
+    pub transition: Option<usize>,
+    /// 0 for the item under the frame; 1 for the item on the other side of a
+    /// transition's cut, sampled into its handles.
+    pub layer: u32,
+}
+
+impl ManifestRun<'_> {
+    /// Whether the run covers `frame`.
+    #[must_use]
+    pub fn contains(&self, frame: u64) -> bool {
+        self.frames.contains(&frame)
+    }
+
+    /// Source time shown at `frame`, which should be one of the run's frames.
+    #[must_use]
+    #[allow(clippy::cast_precision_loss)]
+    pub fn source_time(&self, frame: u64) -> RationalTime {
+        let offset = frame.wrapping_sub(self.frames.start) as f64;
+        RationalTime::new(self.source_start + offset * self.source_step, self.source_rate)
+    }
+
+    /// Index of the URL shown at `frame` in [`RenderManifest::urls`].
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    pub fn url_index_at(&self, frame: u64) -> Option<usize> {
+        let offset = frame.wrapping_sub(self.frames.start) as i64;
+        let index = self.url_index? as i64 + offset * self.url_step;
+        usize::try_from(index).ok()
+    }
+}
+
+/// A transition that appears in a manifest.
+#[derive(Debug)]
+pub struct ManifestTransition<'a> {
+    /// Frames of the manifest the transition covers.
+    pub frames: Range<u64>,
+    /// The transition itself.
+    pub transition: TransitionRef<'a>,
+}
+
+/// What every frame of a composition shows over a range.
+///
+/// Built by [`Track::render_manifest`](crate::Track::render_manifest),
+/// [`Stack::render_manifest`](crate::Stack::render_manifest) or
+/// [`Timeline::render_manifest`](crate::Timeline::render_manifest), or their
+/// `render_manifest_parallel` variants. Runs are ordered by their first
+/// frame. Inside a transition, the runs of layer 0
+/// are followed by those of layer 1 for the same frames. A stack shows its
+/// topmost child that has something at a frame.
+///
+/// The clip and transition handles borrow the timeline; every other field is
+/// a copy.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{RationalTime, TimeRange, Timeline};
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("reel.otio")).unwrap();
+/// let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(2400.0, 24.0));
+/// let manifest = timeline.render_manifest(range).unwrap();
+/// for run in manifest.runs_at(1200) {
+///     if let Some(url) = manifest.url_at(run, 1200) {
+///         println!("layer {}: {url} at {:?}", run.layer, run.source_time(1200));
+///     }
+/// }
+/// ```
+#[derive(Debug)]
+pub struct RenderManifest<'a> {
+    rate: f64,
+    frame_count: u64,
+    runs: Vec<ManifestRun<'a>>,
+    transitions: Vec<ManifestTransition<'a>>,
+    urls: Vec<String>,
+}
+
+/// Copy a table out with the shim's count protocol.
+#[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+fn export<T>(mut run: impl FnMut(*mut T, i32) -> i32) -> Vec<T> {
+    let count = run(std::ptr::null_mut(), 0).max(0) as usize;
+    let mut out = Vec::with_capacity(count);
+    let written = run(out.as_mut_ptr(), count as i32).max(0) as usize;
+    // SAFETY: the shim wrote min(total, capacity) entries
+    unsafe { out.set_len(written.min(count)) };
+    out
+}
+
+#[allow(clippy::cast_sign_loss)]
+fn frames(start: i64, count: i64) -> Range<u64> {
+    let start = start.max(0) as u64;
+    start..start + count.max(0) as u64
+}
+
+impl<'a> RenderManifest<'a> {
+    #[allow(clippy::cast_sign_loss)]
+    pub(crate) fn build(
+        open: impl FnOnce(*mut ffi::OtioError) -> *mut ffi::OtioRenderManifest,
+    ) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(&mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+
+        let runs = export(|runs, capacity| unsafe { ffi::otio_render_manifest_runs(ptr, runs, capacity) })
+            .into_iter()
+            .map(|run| ManifestRun {
+                frames: frames(run.frame_start, run.frame_count),
+                clip: (!run.clip.is_null()).then(|| ClipRef::new(run.clip)),
+                source_start: run.source_start,
+                source_step: run.source_step,
+                source_rate: run.source_rate,
+                url_index: usize::try_from(run.url_index).ok(),
+                url_step: i64::from(run.url_step),
+                transition: usize::try_from(run.transition).ok(),
+                layer: run.layer.max(0) as u32,
+            })
+            .collect();
+        let transitions = export(|transitions, capacity| unsafe {
+            ffi::otio_render_manifest_transitions(ptr, transitions, capacity)
+        })
+        .into_iter()
+        .map(|entry| ManifestTransition {
+            frames: frames(entry.frame_start, entry.frame_count),
+            transition: TransitionRef::new(entry.transition),
+        })
+        .collect();
+        let url_count = unsafe { ffi::otio_render_manifest_url_count(ptr) };
+        let urls = (0..url_count)
+            .map(|index| {
+                let view = unsafe { ffi::otio_render_manifest_url(ptr, index) };
+                // SAFETY: the view points into the manifest, which is freed below
+                unsafe { crate::bytes_from_view(&view) }
+                    .map(|bytes| String::from_utf8_lossy(bytes).into_owned())
+                    .unwrap_or_default()
+            })
+            .collect();
+        let manifest = Self {
+            rate: unsafe { ffi::otio_render_manifest_rate(ptr) },
+            frame_count: unsafe { ffi::otio_render_manifest_frame_count(ptr) }.max(0) as u64,
+            runs,
+            transitions,
+            urls,
+        };
+        unsafe { ffi::otio_render_manifest_free(ptr) };
+        Ok(manifest)
+    }
+
+    /// Frame rate of the manifest's frames (that of the range's start).
+    #[must_use]
+    pub fn rate(&self) -> f64 {
+        self.rate
+    }
+
+    /// Number of frames in the manifest.
+    #[must_use]
+    pub fn frame_count(&self) -> u64 {
+        self.frame_count
+    }
+
+    /// All runs, ordered by their first frame.
+    #[must_use]
+    pub fn runs(&self) -> &[ManifestRun<'a>] {
+        &self.runs
+    }
+
+    /// The transitions the runs refer to.
+    #[must_use]
+    pub fn transitions(&self) -> &[ManifestTransition<'a>] {
+        &self.transitions
+    }
+
+    /// The interned URL table.
+    #[must_use]
+    pub fn urls(&self) -> &[String] {
+        &self.urls
+    }
+
+    /// URL shown by `run` at `frame`.
+    #[must_use]
+    pub fn url_at(&self, run: &ManifestRun<'_>, frame: u64) -> Option<&str> {
+        self.urls.get(run.url_index_at(frame)?).map(String::as_str)
+    }
+
+    /// The runs covering `frame`: one, or two inside a transition (layer 0
+    /// first).
+    pub fn runs_at(&self, frame: u64) -> impl Iterator<Item = &ManifestRun<'a>> {
+        let end = self.runs.partition_point(|run| run.frames.start <= frame);
+        // The layer 0 run covering the frame is the last one starting at or
+        // before it. Layer 1 runs of the same transition can start earlier,
+        // but never before the transition's first run.
+        let primary = self.runs[..end].iter().rposition(|run| run.layer == 0);
+        let transition = primary.and_then(|index| self.runs[index].transition);
+        let mut begin = primary.unwrap_or(end);
+        if transition.is_some() {
+            while begin > 0 && self.runs[begin - 1].transition == transition {
+                begin -= 1;
+            }
+        }
+        let mut found: Vec<&ManifestRun<'a>> =
+            self.runs[begin..end].iter().filter(|run| run.contains(frame)).collect();
+        found.sort_by_key(|run| run.layer);
+        found.into_iter()
+    }
+}
@@ -0,0 +1,248 @@
+//! Lazy, filtered search over a composition tree.
+//!
+//! Unlike `find_clips`, which collects every clip before returning the first
+//! one, a [`SearchIter`] walks the tree as it is advanced and applies the
+//! predicates of a [`SearchFilter`] on the C++ side, so only matching items
+//! cross the FFI boundary.
+
+use std::ffi::CString;
+use std::marker::PhantomData;
+
+use crate::iterators::{
+    composable_from_ffi, CHILD_TYPE_CLIP, CHILD_TYPE_GAP, CHILD_TYPE_STACK, CHILD_TYPE_TRACK,
+    CHILD_TYPE_TRANSITION,
+};
+use crate::{ffi, macros, Composable, OtioError, RationalTime, Result, TimeRange, TrackKind};
+
+/// Predicates for [`Timeline::search`](crate::Timeline::search),
+/// [`Track::search`](crate::Track::search) and
+/// [`Stack::search`](crate::Stack::search).
+///
+/// Every predicate that is set must match. The default filter matches every
+/// item in the tree.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Composable, SearchFilter, Timeline};
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let filter = SearchFilter::new().clips().target_url("/media/A001_C003.mov");
+/// for item in timeline.search(&filter).unwrap() {
+///     if let Composable::Clip(clip) = item.unwrap() {
+///         println!("{}", clip.name());
+///     }
+/// }
+/// ```
+#[derive(Debug, Clone, Default)]
+pub struct SearchFilter {
+    child_types: i32,
+    range: Option<TimeRange>,
+    track_kinds: i32,
+    metadata_key: Option<CString>,
+    metadata_value: Option<CString>,
+    name_prefix: Option<CString>,
+    target_url: Option<CString>,
+    shallow: bool,
+}
+
+impl SearchFilter {
+    /// Create a filter that matches everything.
+    #[must_use]
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    fn with_type(mut self, child_type: i32) -> Self {
+        self.child_types |= 1 << child_type;
+        self
+    }
+
+    /// Match clips. Type selectors combine; with none given, every type
+    /// matches.
+    #[must_use]
+    pub fn clips(self) -> Self {
+        self.with_type(CHILD_TYPE_CLIP)
+    }
+
+    /// Match gaps.
+    #[must_use]
+    pub fn gaps(self) -> Self {
+        self.with_type(CHILD_TYPE_GAP)
+    }
+
+    /// Match transitions.
+    #[must_use]
+    pub fn transitions(self) -> Self {
+        self.with_type(CHILD_TYPE_TRANSITION)
+    }
+
+    /// Match tracks.
+    #[must_use]
+    pub fn tracks(self) -> Self {
+        self.with_type(CHILD_TYPE_TRACK)
+    }
+
+    /// Match stacks.
+    #[must_use]
+    pub fn stacks(self) -> Self {
+        self.with_type(CHILD_TYPE_STACK)
+    }
+
+    /// Only match items overlapping `range`, given in the searched
+    /// composition's coordinate space. Subtrees outside it are not visited.
+    ///
+    /// A zero-duration range matches the items active at its start time.
+    #[must_use]
+    pub fn in_range(mut self, range: TimeRange) -> Self {
+        self.range = Some(range);
+        self
+    }
+
+    /// Only match items whose nearest track (the item itself for tracks) is
+    /// of this kind. May be called more than once to allow several kinds.
+    #[must_use]
+    pub fn track_kind(mut self, kind: TrackKind) -> Self {
+        let bit = match kind {
+            TrackKind::Video => 0,
+            TrackKind::Audio => 1,
+        };
+        self.track_kinds |= 1 << bit;
+        self
+    }
+
+    /// Only match items that have this metadata key, with any value.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `key` contains a NUL byte.
+    #[must_use]
+    pub fn metadata_key(mut self, key: &str) -> Self {
+        self.metadata_key = Some(CString::new(key).unwrap());
+        self.metadata_value = None;
+        self
+    }
+
+    /// Only match items whose metadata has `key` set to the string `value`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `key` or `value` contains a NUL byte.
+    #[must_use]
+    pub fn metadata_eq(mut self, key: &str, value: &str) -> Self {
+        self.metadata_key = Some(CString::new(key).unwrap());
+        self.metadata_value = Some(CString::new(value).unwrap());
+        self
+    }
+
+    /// Only match items whose name starts with `prefix`.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `prefix` contains a NUL byte.
+    #[must_use]
+    pub fn name_prefix(mut self, prefix: &str) -> Self {
+        self.name_prefix = Some(CString::new(prefix).unwrap());
+        self
+    }
+
+    /// Only match clips whose media reference is an external reference to
+    /// exactly this URL.
+    ///
+    /// # Panics
+    ///
+    /// Panics if `url` contains a NUL byte.
+    #[must_use]
+    pub fn target_url(mut self, url: &str) -> Self {
+        self.target_url = Some(CString::new(url).unwrap());
+        self
+    }
+
+    /// Only visit the direct children of the searched composition.
+    #[must_use]
+    pub fn shallow(mut self) -> Self {
+        self.shallow = true;
+        self
+    }
+
+    /// Borrowing view for the C API; valid while `self` lives.
+    pub(crate) fn to_ffi(&self) -> ffi::OtioSearchFilter {
+        let zero = RationalTime::new(0.0, 1.0);
+        ffi::OtioSearchFilter {
+            child_types: self.child_types,
+            has_search_range: i32::from(self.range.is_some()),
+            search_range: self.range.unwrap_or(TimeRange::new(zero, zero)).into(),
+            track_kinds: self.track_kinds,
+            metadata_key: self.metadata_key.as_ref().map_or(std::ptr::null(), |s| s.as_ptr()),
+            metadata_value: self.metadata_value.as_ref().map_or(std::ptr::null(), |s| s.as_ptr()),
+            name_prefix: self.name_prefix.as_ref().map_or(std::ptr::null(), |s| s.as_ptr()),
+            target_url: self.target_url.as_ref().map_or(std::ptr::null(), |s| s.as_ptr()),
+            shallow: i32::from(self.shallow),
+        }
+    }
+}
+
+/// Iterator over the items matching a [`SearchFilter`], depth-first with
+/// parents before their children.
+///
+/// Items are found as the iterator advances. If the tree is edited through
+/// another handle while the search is running, the next item is an error and
+/// the iteration ends; [`SearchIter::reset`] starts over.
+pub struct SearchIter<'a> {
+    ptr: *mut ffi::OtioSearchCursor,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl SearchIter<'_> {
+    pub(crate) fn open(
+        filter: &SearchFilter,
+        open: impl FnOnce(*const ffi::OtioSearchFilter, *mut ffi::OtioError) -> *mut ffi::OtioSearchCursor,
+    ) -> Result<Self> {
+        let raw = filter.to_ffi();
+        let mut err = macros::ffi_error!();
+        let ptr = open(&raw, &mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self {
+            ptr,
+            _marker: PhantomData,
+        })
+    }
+
+    /// Restart the search from the beginning.
+    pub fn reset(&mut self) {
+        unsafe { ffi::otio_search_cursor_reset(self.ptr) };
+    }
+}
+
+impl<'a> Iterator for SearchIter<'a> {
+    type Item = Result<Composable<'a>>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            let mut child_type = -1;
+            let mut err = macros::ffi_error!();
+            let ptr = unsafe { ffi::otio_search_cursor_next(self.ptr, &mut child_type, &mut err) };
+            if ptr.is_null() {
+                return (err.code != 0).then(|| Err(OtioError::from(err)));
+            }
+            // Items of schemas this crate does not wrap are skipped
+            if let Some(item) = composable_from_ffi(ptr, child_type) {
+                return Some(Ok(item));
+            }
+        }
+    }
+}
+
+impl std::fmt::Debug for SearchIter<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("SearchIter").finish_non_exhaustive()
+    }
+}
+
+impl Drop for SearchIter<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_search_cursor_free(self.ptr) }
+    }
+}
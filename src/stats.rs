@@ -0,0 +1,95 @@
+//! Hot-path counters and timers of the shim.
+//!
+//! With the `stats` feature the shim counts and times its serialization,
+//! iteration, range, transformed-time and edit entry points per thread, and
+//! counts `dynamic_cast`s, copied-out strings and caught exceptions.
+//! [`ShimStats::snapshot`] sums them over all threads, ready to export to a
+//! metrics pipeline. Without the feature the instrumentation is compiled out
+//! and snapshots are empty.
+
+use std::ffi::CStr;
+
+use crate::ffi;
+
+/// One counter of a [`ShimStats`] snapshot.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ShimStat {
+    /// `"parse"`, `"serialize"`, `"binary"`, `"iterate"`, `"range"`,
+    /// `"transformed_time"`, `"edit"`, `"dynamic_cast"`, `"strdup"` or
+    /// `"exception"`; see `OTIO_STAT_*` in `otio_shim.h`.
+    pub name: &'static str,
+    /// Calls or occurrences.
+    pub calls: u64,
+    /// Wall time inside the calls, 0 for plain counts.
+    pub nanoseconds: u64,
+    /// Bytes read, written or copied, 0 where none are counted.
+    pub bytes: u64,
+}
+
+/// The shim's counters, summed over all threads since the last reset.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{ShimStats, Timeline};
+///
+/// ShimStats::reset();
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let _ = timeline.to_json_string();
+/// for stat in ShimStats::snapshot().stats() {
+///     println!("{}: {} calls, {} ns", stat.name, stat.calls, stat.nanoseconds);
+/// }
+/// ```
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct ShimStats {
+    stats: Vec<ShimStat>,
+}
+
+impl ShimStats {
+    /// Whether the shim was built with instrumentation (the `stats` feature).
+    #[must_use]
+    pub fn supported() -> bool {
+        unsafe { ffi::otio_stats_supported() != 0 }
+    }
+
+    /// Read the counters. Threads running meanwhile may be a few calls
+    /// behind.
+    #[must_use]
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    pub fn snapshot() -> Self {
+        let count = unsafe { ffi::otio_stats_snapshot(std::ptr::null_mut(), 0) }.max(0) as usize;
+        let mut raw = Vec::with_capacity(count);
+        let written = unsafe { ffi::otio_stats_snapshot(raw.as_mut_ptr(), count as i32) };
+        // SAFETY: the shim wrote min(total, capacity) entries
+        unsafe { raw.set_len((written.max(0) as usize).min(count)) };
+        let stats = raw
+            .iter()
+            .map(|stat| ShimStat {
+                // SAFETY: names are static strings of the shim
+                name: unsafe { CStr::from_ptr(stat.name) }.to_str().unwrap_or_default(),
+                calls: stat.calls,
+                nanoseconds: stat.nanoseconds,
+                bytes: stat.bytes,
+            })
+            .collect();
+        Self { stats }
+    }
+
+    /// Start counting from zero again, for every thread.
+    pub fn reset() {
+        unsafe { ffi::otio_stats_reset() }
+    }
+
+    /// All counters, in the order of the shim's `OTIO_STAT_*` ids; empty
+    /// without instrumentation.
+    #[must_use]
+    pub fn stats(&self) -> &[ShimStat] {
+        &self.stats
+    }
+
+    /// The counter called `name`.
+    #[must_use]
+    pub fn get(&self, name: &str) -> Option<&ShimStat> {
+        self.stats.iter().find(|stat| stat.name == name)
+    }
+}
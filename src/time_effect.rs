@@ -92,8 +92,10 @@ impl LinearTimeWarp {
 traits::impl_has_metadata!(
     LinearTimeWarp,
     otio_linear_time_warp_set_metadata_string,
-    otio_linear_time_warp_get_metadata_string
+    otio_linear_time_warp_get_metadata_string,
+    otio_linear_time_warp_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(LinearTimeWarp);
 
 impl Drop for LinearTimeWarp {
     fn drop(&mut self) {
@@ -140,8 +142,10 @@ impl FreezeFrame {
 traits::impl_has_metadata!(
     FreezeFrame,
     otio_freeze_frame_set_metadata_string,
-    otio_freeze_frame_get_metadata_string
+    otio_freeze_frame_get_metadata_string,
+    otio_freeze_frame_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(FreezeFrame);
 
 impl Drop for FreezeFrame {
     fn drop(&mut self) {
@@ -0,0 +1,150 @@
+//! Interval index for time-to-item queries.
+//!
+//! A [`TimeIndex`] sorts the children of a track, stack or timeline by their
+//! range once, so finding what is active at a given time is a binary search
+//! instead of a walk over every preceding child. Edits made through this
+//! crate mark the index stale, and the next query rebuilds it.
+
+use std::marker::PhantomData;
+
+use crate::iterators::composable_from_ffi;
+use crate::{ffi, macros, time_range_from_ffi, Composable, OtioError, RationalTime, Result, TimeRange};
+
+/// One item returned by a [`TimeIndex`] query.
+#[derive(Debug)]
+pub struct TimeIndexHit<'a> {
+    /// The item itself.
+    pub item: Composable<'a>,
+    /// For timeline indexes, the index of the item's track in the timeline's
+    /// stack; `None` for track and stack indexes.
+    pub track_index: Option<usize>,
+    /// Index of the item in its parent.
+    pub child_index: usize,
+    /// Range of the item in the indexed composition's coordinate space.
+    pub range: TimeRange,
+}
+
+/// Sorted interval index over the children of a composition.
+///
+/// Built by [`Track::build_time_index`](crate::Track::build_time_index),
+/// [`Stack::build_time_index`](crate::Stack::build_time_index) or
+/// [`Timeline::build_time_index`](crate::Timeline::build_time_index). The
+/// index and its hits borrow the handle it was built from, so neither can
+/// outlive the composition; hits must still not be kept across edits that
+/// remove their items.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Composable, RationalTime, Timeline};
+///
+/// let timeline = Timeline::read_from_file(std::path::Path::new("feature.otio")).unwrap();
+/// let index = timeline.build_time_index().unwrap();
+/// for hit in index.query(RationalTime::new(120.0, 24.0)).unwrap() {
+///     if let Composable::Clip(clip) = hit.item {
+///         println!("track {:?}: {}", hit.track_index, clip.name());
+///     }
+/// }
+/// ```
+pub struct TimeIndex<'a> {
+    ptr: *mut ffi::OtioTimeIndex,
+    _target: PhantomData<&'a ()>,
+}
+
+impl<'a> TimeIndex<'a> {
+    /// Initial hit buffer size; the query is repeated once with the exact
+    /// size if more items match.
+    const INITIAL_CAPACITY: usize = 16;
+
+    pub(crate) fn build(open: impl FnOnce(*mut ffi::OtioError) -> *mut ffi::OtioTimeIndex) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(&mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self {
+            ptr,
+            _target: PhantomData,
+        })
+    }
+
+    /// Find the items whose range contains `time` (start inclusive, end
+    /// exclusive), ordered by start time.
+    ///
+    /// A transition is reported together with the items it overlaps.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index is stale and the range of an item
+    /// cannot be computed while rebuilding it.
+    pub fn query(&self, time: RationalTime) -> Result<Vec<TimeIndexHit<'a>>> {
+        self.collect(|index, hits, capacity, err| unsafe {
+            ffi::otio_time_index_query(index, time.into(), hits, capacity, err)
+        })
+    }
+
+    /// Find the items whose range overlaps `range`, ordered by start time.
+    ///
+    /// A zero-duration range behaves like [`TimeIndex::query`] at its start.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the index is stale and the range of an item
+    /// cannot be computed while rebuilding it.
+    pub fn query_range(&self, range: TimeRange) -> Result<Vec<TimeIndexHit<'a>>> {
+        self.collect(|index, hits, capacity, err| unsafe {
+            ffi::otio_time_index_query_range(index, range.into(), hits, capacity, err)
+        })
+    }
+
+    #[allow(clippy::cast_possible_truncation, clippy::cast_possible_wrap, clippy::cast_sign_loss)]
+    fn collect(
+        &self,
+        mut run: impl FnMut(*mut ffi::OtioTimeIndex, *mut ffi::OtioTimeIndexHit, i32, *mut ffi::OtioError) -> i32,
+    ) -> Result<Vec<TimeIndexHit<'a>>> {
+        let empty = ffi::OtioTimeIndexHit {
+            handle: std::ptr::null_mut(),
+            child_type: -1,
+            track_index: -1,
+            child_index: 0,
+            range: TimeRange::new(RationalTime::new(0.0, 1.0), RationalTime::new(0.0, 1.0)).into(),
+        };
+        let mut raw = vec![empty; Self::INITIAL_CAPACITY];
+        loop {
+            let mut err = macros::ffi_error!();
+            let total = run(self.ptr, raw.as_mut_ptr(), raw.len() as i32, &mut err);
+            if total < 0 {
+                return Err(OtioError::from(err));
+            }
+            let total = total as usize;
+            if total <= raw.len() {
+                raw.truncate(total);
+                break;
+            }
+            raw.resize(total, empty);
+        }
+        Ok(raw
+            .iter()
+            .filter_map(|hit| {
+                Some(TimeIndexHit {
+                    item: composable_from_ffi(hit.handle, hit.child_type)?,
+                    track_index: usize::try_from(hit.track_index).ok(),
+                    child_index: hit.child_index.max(0) as usize,
+                    range: time_range_from_ffi(&hit.range),
+                })
+            })
+            .collect())
+    }
+}
+
+impl std::fmt::Debug for TimeIndex<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("TimeIndex").finish_non_exhaustive()
+    }
+}
+
+impl Drop for TimeIndex<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_time_index_free(self.ptr) }
+    }
+}
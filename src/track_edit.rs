@@ -0,0 +1,204 @@
+//! Transactional batches of track edits.
+//!
+//! A [`TrackEdit`] queues the edit algorithms of a track and applies them on
+//! commit as one unit: caches, indexes and change tracking are notified once
+//! for the whole batch, and a failed edit rolls the track back instead of
+//! leaving it half edited.
+
+use std::marker::PhantomData;
+
+use crate::{ffi, macros, Clip, OtioError, RationalTime, Result, TimeRange, Track};
+
+/// A batch of edits to one track, applied by [`TrackEdit::commit`].
+///
+/// Created by [`Track::begin_edit`](crate::Track::begin_edit). Edits are
+/// applied in the order they were queued, each to the track as left by the
+/// previous one, exactly as calling the matching [`Track`] methods in turn.
+/// When each edit starts at or after the previous one, the batch is applied
+/// in one pass over the track, each edit costing in proportion to the
+/// children around it; other batches run each edit over the whole track.
+/// Dropping the batch discards the edits that were not committed.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Clip, RationalTime, TimeRange, Timeline};
+///
+/// let mut timeline = Timeline::new("Conform");
+/// let mut track = timeline.add_video_track("V1");
+/// let mut edit = track.begin_edit().unwrap();
+/// for shot in 0..1000 {
+///     let start = RationalTime::new(f64::from(shot) * 48.0, 24.0);
+///     let range = TimeRange::new(start, RationalTime::new(24.0, 24.0));
+///     let source = TimeRange::new(RationalTime::new(0.0, 24.0), range.duration);
+///     edit.overwrite(Clip::new(&format!("shot_{shot}"), source), range, false).unwrap();
+/// }
+/// // Either every overwrite is applied or none is
+/// edit.commit().unwrap();
+/// ```
+pub struct TrackEdit<'a> {
+    ptr: *mut ffi::OtioTrackEdit,
+    _track: PhantomData<&'a mut Track>,
+}
+
+impl TrackEdit<'_> {
+    pub(crate) fn begin(
+        open: impl FnOnce(*mut ffi::OtioError) -> *mut ffi::OtioTrackEdit,
+    ) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(&mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self {
+            ptr,
+            _track: PhantomData,
+        })
+    }
+
+    /// Queue [`Track::overwrite`]. The clip is owned by the batch from now
+    /// on, and by the track once committed.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the clip is already in a composition.
+    #[allow(clippy::forget_non_drop)]
+    pub fn overwrite(
+        &mut self,
+        clip: Clip,
+        range: TimeRange,
+        remove_transitions: bool,
+    ) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_track_edit_overwrite(
+                self.ptr,
+                clip.ptr,
+                range.into(),
+                i32::from(remove_transitions),
+                &mut err,
+            )
+        };
+        if result != 0 {
+            return Err(err.into());
+        }
+        std::mem::forget(clip);
+        Ok(())
+    }
+
+    /// Queue [`Track::insert_at_time`]. The clip is owned by the batch from
+    /// now on, and by the track once committed.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the clip is already in a composition.
+    #[allow(clippy::forget_non_drop)]
+    pub fn insert_at_time(
+        &mut self,
+        clip: Clip,
+        time: RationalTime,
+        remove_transitions: bool,
+    ) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_track_edit_insert_at_time(
+                self.ptr,
+                clip.ptr,
+                time.into(),
+                i32::from(remove_transitions),
+                &mut err,
+            )
+        };
+        if result != 0 {
+            return Err(err.into());
+        }
+        std::mem::forget(clip);
+        Ok(())
+    }
+
+    /// Queue [`Track::slice_at_time`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the edit cannot be queued.
+    pub fn slice_at_time(&mut self, time: RationalTime, remove_transitions: bool) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_track_edit_slice_at_time(
+                self.ptr,
+                time.into(),
+                i32::from(remove_transitions),
+                &mut err,
+            )
+        };
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
+    /// Queue [`Track::remove_at_time`].
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the edit cannot be queued.
+    pub fn remove_at_time(&mut self, time: RationalTime, fill_with_gap: bool) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        let result = unsafe {
+            ffi::otio_track_edit_remove_at_time(
+                self.ptr,
+                time.into(),
+                i32::from(fill_with_gap),
+                &mut err,
+            )
+        };
+        if result != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+
+    /// Number of edits queued since the last commit.
+    #[must_use]
+    #[allow(clippy::cast_sign_loss)]
+    pub fn len(&self) -> usize {
+        unsafe { ffi::otio_track_edit_count(self.ptr) }.max(0) as usize
+    }
+
+    /// Whether no edits are queued.
+    #[must_use]
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Apply the queued edits to the track.
+    ///
+    /// On success the batch is empty and can queue more edits.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error naming the index of the first edit that failed. The
+    /// track is then restored to its state before the commit, and the edits
+    /// stay queued.
+    pub fn commit(&mut self) -> Result<()> {
+        let mut err = macros::ffi_error!();
+        if unsafe { ffi::otio_track_edit_commit(self.ptr, &mut err) } != 0 {
+            return Err(err.into());
+        }
+        Ok(())
+    }
+}
+
+impl std::fmt::Debug for TrackEdit<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("TrackEdit")
+            .field("len", &self.len())
+            .finish()
+    }
+}
+
+impl Drop for TrackEdit<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_track_edit_free(self.ptr) }
+    }
+}
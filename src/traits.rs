@@ -1,9 +1,15 @@
 //! Traits for OTIO types.
 
-/// Trait for types that support string metadata.
+use std::collections::BTreeMap;
+
+use crate::{MetadataValue, Result};
+
+/// Trait for types that support metadata.
 ///
-/// All OTIO objects can store arbitrary string key-value metadata pairs.
-/// This trait provides a unified interface for getting and setting metadata.
+/// All OTIO objects can store arbitrary key-value metadata pairs. Values are
+/// usually strings, but can also be numbers, booleans, or nested
+/// dictionaries and arrays ([`MetadataValue`]). This trait provides a unified
+/// interface for getting and setting metadata.
 ///
 /// # Example
 ///
@@ -27,6 +33,58 @@ pub trait HasMetadata {
     ///
     /// Returns `None` if the key doesn't exist.
     fn get_metadata(&self, key: &str) -> Option<String>;
+
+    /// Get a string metadata value, copied once from the shim's view of it.
+    ///
+    /// Unlike [`get_metadata`](Self::get_metadata) the shim allocates no
+    /// intermediate copy. Returns `None` if the key doesn't exist, the value
+    /// is not a string, or it is not valid UTF-8.
+    fn metadata_str(&self, key: &str) -> Option<String>;
+
+    /// Get an integer metadata value.
+    ///
+    /// Returns `None` if the key doesn't exist or doesn't hold an integer.
+    fn get_metadata_i64(&self, key: &str) -> Option<i64>;
+
+    /// Get a floating point metadata value.
+    ///
+    /// Returns `None` if the key doesn't exist or doesn't hold a number
+    /// stored as floating point.
+    fn get_metadata_f64(&self, key: &str) -> Option<f64>;
+
+    /// Get a boolean metadata value.
+    ///
+    /// Returns `None` if the key doesn't exist or doesn't hold a boolean.
+    fn get_metadata_bool(&self, key: &str) -> Option<bool>;
+
+    /// Set an integer metadata value.
+    fn set_metadata_i64(&mut self, key: &str, value: i64);
+
+    /// Set a floating point metadata value.
+    fn set_metadata_f64(&mut self, key: &str, value: f64);
+
+    /// Set a boolean metadata value.
+    fn set_metadata_bool(&mut self, key: &str, value: bool);
+
+    /// Get a metadata value of any kind, including nested dictionaries and
+    /// arrays.
+    ///
+    /// Returns `None` if the key doesn't exist.
+    fn get_metadata_value(&self, key: &str) -> Option<MetadataValue>;
+
+    /// Set a metadata value of any kind.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if `value` contains a [`MetadataValue::Other`].
+    fn set_metadata_value(&mut self, key: &str, value: &MetadataValue) -> Result<()>;
+
+    /// Copy the whole metadata dictionary in one call.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the metadata cannot be encoded.
+    fn all_metadata(&self) -> Result<BTreeMap<String, MetadataValue>>;
 }
 
 /// Macro to implement `HasMetadata` for a type with a pointer field.
@@ -34,7 +92,7 @@ pub trait HasMetadata {
 /// This macro generates the boilerplate code for FFI calls to get/set metadata.
 /// The getter properly frees the C-allocated string after copying.
 macro_rules! impl_has_metadata {
-    ($type:ty, $set_fn:ident, $get_fn:ident) => {
+    ($type:ty, $set_fn:ident, $get_fn:ident, $view_fn:ident) => {
         impl $crate::traits::HasMetadata for $type {
             fn set_metadata(&mut self, key: &str, value: &str) {
                 let c_key = std::ffi::CString::new(key).unwrap();
@@ -61,8 +119,105 @@ macro_rules! impl_has_metadata {
                     Some(result)
                 }
             }
+
+            fn metadata_str(&self, key: &str) -> Option<String> {
+                let view = $crate::with_c_key(key, |c_key| unsafe {
+                    $crate::ffi::$view_fn(self.ptr, c_key)
+                })?;
+                // SAFETY: the view points into this object's metadata, which
+                // another handle to the object may change, so it is copied
+                // before anything else runs.
+                let bytes = unsafe { $crate::bytes_from_view(&view) }?;
+                std::str::from_utf8(bytes).ok().map(str::to_owned)
+            }
+
+            fn get_metadata_i64(&self, key: &str) -> Option<i64> {
+                $crate::metadata::get_i64(self.ptr.cast(), key)
+            }
+
+            fn get_metadata_f64(&self, key: &str) -> Option<f64> {
+                $crate::metadata::get_f64(self.ptr.cast(), key)
+            }
+
+            fn get_metadata_bool(&self, key: &str) -> Option<bool> {
+                $crate::metadata::get_bool(self.ptr.cast(), key)
+            }
+
+            fn set_metadata_i64(&mut self, key: &str, value: i64) {
+                $crate::metadata::set(key, |c_key, err| unsafe {
+                    $crate::ffi::otio_metadata_set_int64(self.ptr.cast(), c_key, value, err)
+                });
+            }
+
+            fn set_metadata_f64(&mut self, key: &str, value: f64) {
+                $crate::metadata::set(key, |c_key, err| unsafe {
+                    $crate::ffi::otio_metadata_set_double(self.ptr.cast(), c_key, value, err)
+                });
+            }
+
+            fn set_metadata_bool(&mut self, key: &str, value: bool) {
+                $crate::metadata::set(key, |c_key, err| unsafe {
+                    $crate::ffi::otio_metadata_set_bool(self.ptr.cast(), c_key, i32::from(value), err)
+                });
+            }
+
+            fn get_metadata_value(&self, key: &str) -> Option<$crate::MetadataValue> {
+                $crate::metadata::get_value(self.ptr.cast(), key)
+            }
+
+            fn set_metadata_value(&mut self, key: &str, value: &$crate::MetadataValue) -> $crate::Result<()> {
+                $crate::metadata::set_value(self.ptr.cast(), key, value)
+            }
+
+            fn all_metadata(
+                &self,
+            ) -> $crate::Result<std::collections::BTreeMap<String, $crate::MetadataValue>> {
+                $crate::metadata::all(self.ptr.cast())
+            }
         }
     };
 }
 
 pub(crate) use impl_has_metadata;
+
+/// Trait for types that can be fingerprinted.
+///
+/// A fingerprint is a 64-bit hash of an object's content: for a track, stack
+/// or timeline, of everything below it too. Objects with equal content have
+/// equal fingerprints, in any process and on any platform for a given
+/// version of this crate, so fingerprints can key caches of derived data.
+/// See [`FingerprintCache`](crate::FingerprintCache) to fingerprint a
+/// timeline again cheaply after edits.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{HasFingerprint, HasMetadata, Timeline};
+///
+/// let mut timeline = Timeline::read_from_file(std::path::Path::new("reel.otio")).unwrap();
+/// let before = timeline.fingerprint().unwrap();
+/// timeline.set_metadata("status", "approved");
+/// assert_ne!(timeline.fingerprint().unwrap(), before);
+/// ```
+pub trait HasFingerprint {
+    /// Get the fingerprint of this object and its children.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if an object of a schema the shim doesn't know
+    /// cannot be serialized for its fingerprint.
+    fn fingerprint(&self) -> Result<u64>;
+}
+
+/// Macro to implement `HasFingerprint` for a type with a pointer field.
+macro_rules! impl_has_fingerprint {
+    ($type:ty) => {
+        impl $crate::traits::HasFingerprint for $type {
+            fn fingerprint(&self) -> $crate::Result<u64> {
+                $crate::fingerprint::fingerprint_of(self.ptr.cast())
+            }
+        }
+    };
+}
+
+pub(crate) use impl_has_fingerprint;
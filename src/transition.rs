@@ -31,6 +31,14 @@ pub struct Transition {
     pub(crate) ptr: *mut ffi::OtioTransition,
 }
 
+impl std::fmt::Debug for Transition {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("Transition")
+            .field("name", &self.name())
+            .finish()
+    }
+}
+
 impl Transition {
     /// Create a new transition.
     ///
@@ -111,8 +119,10 @@ impl Transition {
 traits::impl_has_metadata!(
     Transition,
     otio_transition_set_metadata_string,
-    otio_transition_get_metadata_string
+    otio_transition_get_metadata_string,
+    otio_transition_get_metadata_string_view
 );
+traits::impl_has_fingerprint!(Transition);
 
 impl Drop for Transition {
     fn drop(&mut self) {
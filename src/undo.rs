@@ -0,0 +1,154 @@
+//! Undo and redo.
+//!
+//! An [`UndoJournal`] keeps, for each edit made to a timeline through this
+//! crate, what it takes to reverse it: the children an insert added or a
+//! removal took out, the value a setter replaced, or the children of the one
+//! track an edit algorithm retimed. Undoing an insert, a removal or a setter
+//! costs in proportion to the edit, and undoing an edit algorithm in
+//! proportion to the width of the track it retimed; never the whole
+//! timeline, and nothing is serialized.
+
+use crate::{ffi, macros, OtioError, Result, Timeline, TimelineMut};
+
+/// The undo history of a timeline.
+///
+/// Created by [`Timeline::enable_undo`](crate::Timeline::enable_undo). The
+/// journal borrows the timeline while it records; edit the timeline itself
+/// through [`timeline_mut`](Self::timeline_mut), and its tracks and items
+/// through their own handles. It records what a [`ChangeTracker`](crate::ChangeTracker) records: markers
+/// and effects, changes to a media reference after it was attached to a
+/// clip, and anything done directly through OTIO are not. Undoing and
+/// redoing notify indexes, caches and change trackers like any other edit.
+///
+/// Items that an undone edit added, and items removed by an edit that can
+/// still be undone, are kept alive by the journal; handles to them stay
+/// valid until the journal drops the step.
+///
+/// # Example
+///
+/// ```no_run
+/// use otio_rs::{Clip, RationalTime, TimeRange, Timeline};
+///
+/// let mut timeline = Timeline::new("Cut");
+/// let mut journal = timeline.enable_undo(100).unwrap();
+/// let mut v1 = journal.timeline_mut().add_video_track("V1");
+/// let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0));
+/// v1.append_clip(Clip::new("shot_0010", range)).unwrap();
+///
+/// assert!(journal.undo().unwrap());
+/// assert_eq!(v1.children_count(), 0);
+/// assert!(journal.redo().unwrap());
+/// assert_eq!(v1.children_count(), 1);
+/// ```
+pub struct UndoJournal<'a> {
+    ptr: *mut ffi::OtioUndoJournal,
+    timeline: &'a mut Timeline,
+}
+
+impl<'a> UndoJournal<'a> {
+    pub(crate) fn open(
+        timeline: &'a mut Timeline,
+        open: impl FnOnce(*mut ffi::OtioTimeline, *mut ffi::OtioError) -> *mut ffi::OtioUndoJournal,
+    ) -> Result<Self> {
+        let mut err = macros::ffi_error!();
+        let ptr = open(timeline.ptr, &mut err);
+        if ptr.is_null() {
+            return Err(OtioError::from(err));
+        }
+        Ok(Self { ptr, timeline })
+    }
+
+    /// The journaled timeline.
+    #[must_use]
+    pub fn timeline(&self) -> &Timeline {
+        self.timeline
+    }
+
+    /// The journaled timeline, lent for modification.
+    pub fn timeline_mut(&mut self) -> TimelineMut<'_> {
+        TimelineMut::new(self.timeline)
+    }
+
+    fn replay(&mut self, step: unsafe extern "C" fn(*mut ffi::OtioUndoJournal, *mut ffi::OtioError) -> i32) -> Result<bool> {
+        let mut err = macros::ffi_error!();
+        match unsafe { step(self.ptr, &mut err) } {
+            -1 => Err(OtioError::from(err)),
+            applied => Ok(applied == 1),
+        }
+    }
+
+    /// Revert the newest step. Returns `false` if there was nothing to undo.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a group is open, or if the timeline was changed
+    /// outside the journal so that the step no longer applies; the part of
+    /// the step already applied is then reverted and the journal cleared.
+    pub fn undo(&mut self) -> Result<bool> {
+        self.replay(ffi::otio_undo_journal_undo)
+    }
+
+    /// Reapply the newest undone step. Returns `false` if there was nothing
+    /// to redo. Any new edit discards the steps that could be redone.
+    ///
+    /// # Errors
+    ///
+    /// As for [`undo`](Self::undo).
+    pub fn redo(&mut self) -> Result<bool> {
+        self.replay(ffi::otio_undo_journal_redo)
+    }
+
+    /// Number of steps that can be undone, at most the journal's depth.
+    #[must_use]
+    #[allow(clippy::cast_sign_loss)]
+    pub fn undo_count(&self) -> usize {
+        unsafe { ffi::otio_undo_journal_undo_count(self.ptr) }.max(0) as usize
+    }
+
+    /// Number of steps that can be redone.
+    #[must_use]
+    #[allow(clippy::cast_sign_loss)]
+    pub fn redo_count(&self) -> usize {
+        unsafe { ffi::otio_undo_journal_redo_count(self.ptr) }.max(0) as usize
+    }
+
+    /// Record the edits until the matching [`end_group`](Self::end_group)
+    /// as one step. Groups nest.
+    pub fn begin_group(&self) {
+        unsafe { ffi::otio_undo_journal_begin_group(self.ptr) }
+    }
+
+    /// Close the group opened by the last [`begin_group`](Self::begin_group).
+    pub fn end_group(&self) {
+        unsafe { ffi::otio_undo_journal_end_group(self.ptr) }
+    }
+
+    /// Run `edit` with its edits recorded as one step. It is lent the
+    /// timeline for edits of the timeline itself.
+    pub fn group<R>(&mut self, edit: impl FnOnce(&mut TimelineMut<'_>) -> R) -> R {
+        self.begin_group();
+        let result = edit(&mut self.timeline_mut());
+        self.end_group();
+        result
+    }
+
+    /// Drop all steps, releasing the items they keep alive.
+    pub fn clear(&mut self) {
+        unsafe { ffi::otio_undo_journal_clear(self.ptr) }
+    }
+}
+
+impl std::fmt::Debug for UndoJournal<'_> {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("UndoJournal")
+            .field("undo_count", &self.undo_count())
+            .field("redo_count", &self.redo_count())
+            .finish_non_exhaustive()
+    }
+}
+
+impl Drop for UndoJournal<'_> {
+    fn drop(&mut self) {
+        unsafe { ffi::otio_undo_journal_free(self.ptr) }
+    }
+}
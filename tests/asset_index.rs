@@ -0,0 +1,140 @@
+//! Tests for the media URL and metadata index.
+//!
+//! This file tests:
+//! - `Timeline::build_asset_index()` URL and metadata lookups
+//! - Updates from metadata setters, including typed ones
+//! - Rebuilds after items are added or removed
+
+use otio_rs::{
+    AssetIndex, Clip, Composable, ExternalReference, HasMetadata, RationalTime, Stack, TimeRange,
+    Timeline,
+};
+
+fn clip(name: &str, url: &str) -> Clip {
+    let mut clip = Clip::new(
+        name,
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0)),
+    );
+    clip.set_media_reference(ExternalReference::new(url)).unwrap();
+    clip
+}
+
+fn names(items: &[Composable<'_>]) -> Vec<String> {
+    items
+        .iter()
+        .map(|item| match item {
+            Composable::Clip(clip) => clip.name(),
+            Composable::Track(track) => track.name(),
+            Composable::Stack(stack) => stack.name(),
+            _ => "<other>".to_string(),
+        })
+        .collect()
+}
+
+fn url_names(index: &AssetIndex, url: &str) -> Vec<String> {
+    names(&index.find_url(url).unwrap())
+}
+
+fn vfx_names(index: &AssetIndex, value: &str) -> Vec<String> {
+    names(&index.find_metadata("vfx_id", value).unwrap())
+}
+
+fn sample_timeline() -> Timeline {
+    let mut timeline = Timeline::new("Assets");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.set_metadata("vfx_id", "TRACK");
+    let mut a = clip("a", "s3://plates/shot_0420.exr");
+    a.set_metadata("vfx_id", "VFX-0420");
+    v1.append_clip(a).unwrap();
+    v1.append_clip(clip("b", "s3://plates/shot_0430.exr")).unwrap();
+
+    let mut nested = Stack::new("Nested");
+    let mut c = clip("c", "s3://plates/shot_0420.exr");
+    c.set_metadata("vfx_id", "VFX-0420");
+    nested.append_clip(c).unwrap();
+    v1.append_stack(nested).unwrap();
+    timeline
+}
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+#[test]
+fn test_find_url() {
+    let timeline = sample_timeline();
+    let index = timeline.build_asset_index(&[]).unwrap();
+    assert_eq!(url_names(&index, "s3://plates/shot_0420.exr"), vec!["a", "c"]);
+    assert_eq!(url_names(&index, "s3://plates/shot_0430.exr"), vec!["b"]);
+    assert!(url_names(&index, "s3://plates/missing.exr").is_empty());
+}
+
+#[test]
+fn test_find_metadata() {
+    let timeline = sample_timeline();
+    let index = timeline.build_asset_index(&["vfx_id"]).unwrap();
+    assert_eq!(vfx_names(&index, "VFX-0420"), vec!["a", "c"]);
+    // Any item can be indexed, not only clips
+    assert_eq!(vfx_names(&index, "TRACK"), vec!["V1"]);
+    assert!(vfx_names(&index, "VFX-9999").is_empty());
+}
+
+#[test]
+fn test_unindexed_key_is_an_error() {
+    let timeline = sample_timeline();
+    let index = timeline.build_asset_index(&["vfx_id"]).unwrap();
+    assert!(index.find_metadata("reel", "A001").is_err());
+}
+
+#[test]
+fn test_many_results_grow_buffer() {
+    let mut timeline = Timeline::new("Many");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..50 {
+        v1.append_clip(clip(&format!("clip {i}"), "/media/shared.mov")).unwrap();
+    }
+    let index = timeline.build_asset_index(&[]).unwrap();
+    assert_eq!(index.find_url("/media/shared.mov").unwrap().len(), 50);
+}
+
+// ============================================================================
+// Updates
+// ============================================================================
+
+#[test]
+fn test_metadata_setter_updates_index() {
+    let timeline = sample_timeline();
+    let index = timeline.build_asset_index(&["vfx_id"]).unwrap();
+
+    let mut b = timeline.find_clips().find(|clip| clip.name() == "b").unwrap();
+    b.set_metadata("vfx_id", "VFX-0420");
+    assert_eq!(vfx_names(&index, "VFX-0420"), vec!["a", "c", "b"]);
+
+    let mut a = timeline.find_clips().find(|clip| clip.name() == "a").unwrap();
+    a.set_metadata("vfx_id", "VFX-0500");
+    assert_eq!(vfx_names(&index, "VFX-0420"), vec!["c", "b"]);
+    assert_eq!(vfx_names(&index, "VFX-0500"), vec!["a"]);
+
+    // Keys that are not indexed are ignored
+    a.set_metadata("reel", "A001");
+    assert_eq!(vfx_names(&index, "VFX-0500"), vec!["a"]);
+
+    // Only string values are indexed
+    a.set_metadata_i64("vfx_id", 500);
+    assert!(vfx_names(&index, "VFX-0500").is_empty());
+}
+
+#[test]
+fn test_structural_edits_rebuild_index() {
+    let mut timeline = Timeline::new("Edited");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("first", "/media/a.mov")).unwrap();
+    let index = timeline.build_asset_index(&[]).unwrap();
+    assert_eq!(url_names(&index, "/media/a.mov"), vec!["first"]);
+
+    v1.append_clip(clip("second", "/media/a.mov")).unwrap();
+    assert_eq!(url_names(&index, "/media/a.mov"), vec!["first", "second"]);
+
+    v1.remove_child(0).unwrap();
+    assert_eq!(url_names(&index, "/media/a.mov"), vec!["second"]);
+}
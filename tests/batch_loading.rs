@@ -0,0 +1,83 @@
+//! Tests for concurrent batch loading.
+//!
+//! This file tests:
+//! - `Timeline::read_from_files()`
+//! - `Timeline::from_json_slices()`
+
+use otio_rs::{Clip, RationalTime, TimeRange, Timeline};
+use tempfile::TempDir;
+
+fn sample_timeline(index: usize) -> Timeline {
+    let mut timeline = Timeline::new(&format!("Reel {index}"));
+    let mut track = timeline.add_video_track("V1");
+    for clip in 0..=index % 5 {
+        track
+            .append_clip(Clip::new(
+                &format!("clip_{clip}"),
+                TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0)),
+            ))
+            .unwrap();
+    }
+    timeline
+}
+
+#[test]
+fn test_read_from_files_preserves_order() {
+    let dir = TempDir::new().unwrap();
+    let paths: Vec<_> = (0..24)
+        .map(|i| {
+            let path = dir.path().join(format!("reel_{i}.otio"));
+            sample_timeline(i).write_to_file(&path).unwrap();
+            path
+        })
+        .collect();
+
+    let results = Timeline::read_from_files(&paths, 4);
+    assert_eq!(results.len(), paths.len());
+    for (i, result) in results.into_iter().enumerate() {
+        let timeline = result.unwrap();
+        assert_eq!(timeline.name(), format!("Reel {i}"));
+        assert_eq!(timeline.find_clips().count(), i % 5 + 1);
+    }
+}
+
+#[test]
+fn test_read_from_files_reports_per_file_errors() {
+    let dir = TempDir::new().unwrap();
+    let good = dir.path().join("good.otio");
+    sample_timeline(0).write_to_file(&good).unwrap();
+    let bad = dir.path().join("bad.otio");
+    std::fs::write(&bad, "not json").unwrap();
+    let missing = dir.path().join("missing.otio");
+
+    let paths = [good.clone(), bad, missing, good];
+    let results = Timeline::read_from_files(&paths, 0);
+    assert!(results[0].is_ok());
+    assert!(results[1].is_err());
+    assert!(results[2].is_err());
+    assert!(results[3].is_ok());
+    assert!(!results[1].as_ref().unwrap_err().message.is_empty());
+}
+
+#[test]
+fn test_from_json_slices() {
+    let documents: Vec<String> = (0..10).map(|i| sample_timeline(i).to_json_string().unwrap()).collect();
+    let mut buffers: Vec<&[u8]> = documents.iter().map(String::as_bytes).collect();
+    buffers.push(b"{}");
+
+    for threads in [1, 3, 0] {
+        let results = Timeline::from_json_slices(&buffers, threads);
+        assert_eq!(results.len(), 11);
+        for (i, result) in results.iter().take(10).enumerate() {
+            assert_eq!(result.as_ref().unwrap().name(), format!("Reel {i}"));
+        }
+        assert!(results[10].is_err());
+    }
+}
+
+#[test]
+fn test_batch_empty_input() {
+    let paths: [&str; 0] = [];
+    assert!(Timeline::read_from_files(&paths, 8).is_empty());
+    assert!(Timeline::from_json_slices(&[], 8).is_empty());
+}
@@ -0,0 +1,109 @@
+//! Tests for the binary serialization format.
+//!
+//! This file tests:
+//! - Lossless roundtrips against the JSON form
+//! - Schema version downgrades
+//! - File I/O and rejection of malformed input
+
+use otio_rs::{
+    Clip, ExternalReference, Gap, HasMetadata, MetadataValue, RationalTime, Stack, TimeRange,
+    Timeline,
+};
+use tempfile::NamedTempFile;
+
+fn sample_timeline() -> Timeline {
+    let mut timeline = Timeline::new("Binary");
+    timeline.set_global_start_time(RationalTime::new(86400.0, 23.976)).unwrap();
+    timeline.set_metadata_i64("episode", 104);
+    timeline.set_metadata_f64("ratio", 1.0 / 3.0);
+    timeline
+        .set_metadata_value("flags", &MetadataValue::Array(vec![true.into(), MetadataValue::Null]))
+        .unwrap();
+
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..20 {
+        let mut clip = Clip::new(
+            &format!("shot_{i:03} \"quoted\" \\ é"),
+            TimeRange::new(RationalTime::new(f64::from(i) * 0.1, 24.0), RationalTime::new(48.0, 24.0)),
+        );
+        clip.set_media_reference(ExternalReference::new(&format!("s3://show/plates/reel_a/shot_{i:03}.exr")))
+            .unwrap();
+        clip.set_metadata("vendor", "acme");
+        v1.append_clip(clip).unwrap();
+    }
+    v1.append_gap(Gap::new(RationalTime::new(12.0, 24.0))).unwrap();
+    let mut nested = Stack::new("Nested");
+    nested
+        .append_clip(Clip::new("inner", TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(1.0, 24.0))))
+        .unwrap();
+    v1.append_stack(nested).unwrap();
+    let _a1 = timeline.add_audio_track("A1");
+    timeline
+}
+
+// ============================================================================
+// Roundtrips
+// ============================================================================
+
+#[test]
+fn test_binary_roundtrip_matches_json() {
+    let timeline = sample_timeline();
+    let bytes = timeline.to_binary().unwrap();
+    let restored = Timeline::from_binary(&bytes).unwrap();
+    assert_eq!(restored.to_json_string().unwrap(), timeline.to_json_string().unwrap());
+    assert_eq!(restored.get_metadata_f64("ratio"), Some(1.0 / 3.0));
+}
+
+#[test]
+fn test_binary_is_smaller_than_json() {
+    let timeline = sample_timeline();
+    let bytes = timeline.to_binary().unwrap();
+    assert!(bytes.starts_with(b"OTIOBIN\x01"));
+    assert!(bytes.len() < timeline.to_json_string().unwrap().len() / 2);
+}
+
+#[test]
+fn test_binary_schema_version_downgrade() {
+    let timeline = sample_timeline();
+    let versions = [("Clip", 1)];
+    let bytes = timeline.to_binary_with_schema_versions(&versions).unwrap();
+    let restored = Timeline::from_binary(&bytes).unwrap();
+
+    // Same document as reading back the downgraded JSON
+    let json = timeline.to_json_string_with_schema_versions(&versions).unwrap();
+    let from_json = Timeline::from_json_string(&json).unwrap();
+    assert_eq!(restored.to_json_string().unwrap(), from_json.to_json_string().unwrap());
+}
+
+// ============================================================================
+// Files and errors
+// ============================================================================
+
+#[test]
+fn test_binary_file_roundtrip() {
+    let timeline = sample_timeline();
+    let file = NamedTempFile::with_suffix(".otiob").unwrap();
+    timeline.write_to_binary_file(file.path()).unwrap();
+    let restored = Timeline::read_from_binary_file(file.path()).unwrap();
+    assert_eq!(restored.to_json_string().unwrap(), timeline.to_json_string().unwrap());
+
+    timeline
+        .write_to_binary_file_with_schema_versions(file.path(), &[("Clip", 1)])
+        .unwrap();
+    assert!(Timeline::read_from_binary_file(file.path()).is_ok());
+}
+
+#[test]
+fn test_malformed_binary_is_rejected() {
+    let bytes = sample_timeline().to_binary().unwrap();
+    assert!(Timeline::from_binary(&[]).is_err());
+    assert!(Timeline::from_binary(b"{\"OTIO_SCHEMA\": \"Timeline.1\"}").is_err());
+    for cut in [8, bytes.len() / 2, bytes.len() - 1] {
+        assert!(Timeline::from_binary(&bytes[..cut]).is_err());
+    }
+
+    // A JSON file is not a binary file
+    let file = NamedTempFile::with_suffix(".otio").unwrap();
+    sample_timeline().write_to_file(file.path()).unwrap();
+    assert!(Timeline::read_from_binary_file(file.path()).is_err());
+}
@@ -1,4 +1,7 @@
-use otio_rs::{Clip, ExternalReference, HasMetadata, RationalTime, TimeRange, Timeline};
+use otio_rs::{
+    Clip, ClipBatchBuilder, Composable, ExternalReference, HasMetadata, RationalTime, TimeRange,
+    Timeline, Track,
+};
 
 fn make_time_range(start: f64, duration: f64, rate: f64) -> TimeRange {
     TimeRange::new(
@@ -150,6 +153,81 @@ fn test_external_ref_builder_full_chain() {
     assert_eq!(ext_ref.get_metadata("region"), Some("us-west-2".to_string()));
 }
 
+// ============ ClipBatchBuilder Tests ============
+
+#[test]
+fn test_clip_batch_appends_in_order() {
+    let mut tl = Timeline::new("batch");
+    let mut track = tl.add_video_track("V1");
+    track.append_clip(Clip::new("existing", make_time_range(0.0, 24.0, 24.0))).unwrap();
+
+    let batch = ClipBatchBuilder::with_capacity(2)
+        .clip("shot_010", make_time_range(100.0, 48.0, 24.0))
+        .target_url("/footage/shot_010.mov")
+        .available_range(make_time_range(0.0, 240.0, 24.0))
+        .metadata("reel", "A001")
+        .metadata("scene", "1")
+        .clip("shot_020", make_time_range(0.0, 24.0, 24.0))
+        .metadata("reel", "A002");
+    assert_eq!(batch.len(), 2);
+    batch.append_to(&mut track).unwrap();
+
+    let clips: Vec<_> = track
+        .children()
+        .filter_map(|c| match c {
+            Composable::Clip(clip) => Some(clip),
+            _ => None,
+        })
+        .collect();
+    assert_eq!(clips.len(), 3);
+
+    assert_eq!(clips[1].name(), "shot_010");
+    assert_eq!(clips[1].source_range(), make_time_range(100.0, 48.0, 24.0));
+    assert_eq!(clips[1].available_range().unwrap(), make_time_range(0.0, 240.0, 24.0));
+    assert_eq!(clips[1].get_metadata("reel"), Some("A001".to_string()));
+    assert_eq!(clips[1].get_metadata("scene"), Some("1".to_string()));
+
+    // No target URL: no media reference, so no available range
+    assert_eq!(clips[2].name(), "shot_020");
+    assert!(clips[2].available_range().is_err());
+    assert_eq!(clips[2].get_metadata("reel"), Some("A002".to_string()));
+    assert_eq!(clips[2].get_metadata("scene"), None);
+}
+
+#[test]
+fn test_clip_batch_roundtrips() {
+    let mut batch = ClipBatchBuilder::new();
+    for i in 0..100 {
+        batch = batch
+            .clip(&format!("clip_{i}"), make_time_range(0.0, 12.0, 24.0))
+            .target_url(&format!("/media/{i}.mov"));
+    }
+    let mut tl = Timeline::new("batch");
+    let mut track = tl.add_video_track("V1");
+    batch.append_to(&mut track).unwrap();
+    assert_eq!(track.children_count(), 100);
+
+    let json = tl.to_json_string().unwrap();
+    assert!(json.contains("/media/99.mov"));
+    let parsed = Timeline::from_json_string(&json).unwrap();
+    assert_eq!(parsed.find_clips().count(), 100);
+}
+
+#[test]
+fn test_clip_batch_empty() {
+    let mut track = Track::new_video("V1");
+    let batch = ClipBatchBuilder::new();
+    assert!(batch.is_empty());
+    batch.append_to(&mut track).unwrap();
+    assert_eq!(track.children_count(), 0);
+}
+
+#[test]
+#[should_panic(expected = "no clip added")]
+fn test_clip_batch_setter_without_clip_panics() {
+    let _ = ClipBatchBuilder::new().target_url("/media/a.mov");
+}
+
 // ============ Builder Integration Tests ============
 
 #[test]
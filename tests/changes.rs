@@ -0,0 +1,200 @@
+//! Tests for change tracking and patches.
+//!
+//! This file tests:
+//! - `Timeline::track_changes()` and `ChangeTracker::take_patch()` for
+//!   metadata, structural edits and the edit algorithms
+//! - `Timeline::apply_patch()` reproducing the edited timeline
+//! - Patch size independent of timeline size, and malformed patches
+
+use otio_rs::{ChangeTracker, Clip, Gap, HasMetadata, RationalTime, Stack, TimeRange, Timeline, Track};
+
+fn clip(name: &str) -> Clip {
+    Clip::new(
+        name,
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+    )
+}
+
+/// V1: `clips` shots and a nested stack with one clip; A1: one clip.
+fn sample_timeline(clips: usize) -> (Timeline, Track, Track) {
+    let mut timeline = Timeline::new("Tracked");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..clips {
+        v1.append_clip(clip(&format!("shot_{i}"))).unwrap();
+    }
+    let mut nested = Stack::new("Nested");
+    nested.append_clip(clip("inner")).unwrap();
+    v1.append_stack(nested).unwrap();
+    let mut a1 = timeline.add_audio_track("A1");
+    a1.append_clip(clip("music")).unwrap();
+    (timeline, v1, a1)
+}
+
+fn replica_of(timeline: &Timeline) -> Timeline {
+    Timeline::from_json_string(&timeline.to_json_string().unwrap()).unwrap()
+}
+
+/// Take a patch, apply it to `replica` and check both timelines match.
+fn sync(changes: &ChangeTracker, replica: &mut Timeline) -> String {
+    let patch = changes.take_patch().unwrap();
+    replica.apply_patch(&patch).unwrap();
+    assert_eq!(
+        replica.to_json_string().unwrap(),
+        changes.timeline().to_json_string().unwrap()
+    );
+    patch
+}
+
+// ============================================================================
+// Attributes
+// ============================================================================
+
+#[test]
+fn test_no_changes_is_an_empty_patch() {
+    let (mut timeline, _v1, _a1) = sample_timeline(3);
+    let mut replica = replica_of(&timeline);
+    let changes = timeline.track_changes().unwrap();
+    assert!(!changes.has_changes());
+    assert_eq!(sync(&changes, &mut replica), r#"{"OTIO_PATCH":1,"ops":[]}"#);
+}
+
+#[test]
+fn test_clip_metadata_patch_holds_only_that_clip() {
+    let (mut timeline, _v1, _a1) = sample_timeline(5);
+    let mut replica = replica_of(&timeline);
+    let changes = timeline.track_changes().unwrap();
+
+    let mut shot = changes.timeline().find_clips().find(|clip| clip.name() == "shot_3").unwrap();
+    shot.set_metadata("vfx_id", "VFX-0420");
+    assert!(changes.has_changes());
+
+    let patch = sync(&changes, &mut replica);
+    assert!(patch.contains("shot_3"));
+    assert!(!patch.contains("shot_2"));
+    assert!(!changes.has_changes());
+}
+
+#[test]
+fn test_track_and_timeline_fields() {
+    let (mut timeline, _v1, mut a1) = sample_timeline(3);
+    let mut replica = replica_of(&timeline);
+    let mut changes = timeline.track_changes().unwrap();
+
+    let mut edit = changes.timeline_mut();
+    edit.set_metadata("status", "approved");
+    edit.set_global_start_time(RationalTime::new(86400.0, 24.0)).unwrap();
+    a1.set_metadata_i64("channels", 2);
+
+    let patch = sync(&changes, &mut replica);
+    // The fields of a track are sent without its clips
+    assert!(!patch.contains("music"));
+    assert_eq!(replica.get_metadata("status").as_deref(), Some("approved"));
+}
+
+// ============================================================================
+// Structure and edit algorithms
+// ============================================================================
+
+#[test]
+fn test_inserts_and_removals() {
+    let (mut timeline, mut v1, _a1) = sample_timeline(4);
+    let mut replica = replica_of(&timeline);
+    let changes = timeline.track_changes().unwrap();
+
+    v1.remove_child(1).unwrap();
+    v1.append_gap(Gap::new(RationalTime::new(12.0, 24.0))).unwrap();
+    v1.insert_clip(0, clip("opening")).unwrap();
+    let patch = sync(&changes, &mut replica);
+    assert!(patch.contains("opening"));
+    assert!(!patch.contains("shot_3"));
+
+    // Later patches start from the state of the previous one
+    v1.remove_child(0).unwrap();
+    sync(&changes, &mut replica);
+}
+
+#[test]
+fn test_nested_stack_edits() {
+    let (mut timeline, _v1, mut a1) = sample_timeline(2);
+    let mut replica = replica_of(&timeline);
+    let changes = timeline.track_changes().unwrap();
+
+    let mut inner = changes.timeline().find_clips().find(|clip| clip.name() == "inner").unwrap();
+    inner.set_metadata("note", "regrade");
+    let patch = sync(&changes, &mut replica);
+    assert!(!patch.contains("shot_0"));
+
+    let mut nested = Stack::new("Second");
+    nested.append_clip(clip("deep")).unwrap();
+    a1.append_stack(nested).unwrap();
+    sync(&changes, &mut replica);
+}
+
+#[test]
+fn test_edit_algorithms() {
+    let (mut timeline, mut v1, _a1) = sample_timeline(6);
+    let mut replica = replica_of(&timeline);
+    let changes = timeline.track_changes().unwrap();
+
+    // Splits shot_2 (48..96) in place
+    v1.slice_at_time(RationalTime::new(60.0, 24.0), false).unwrap();
+    let patch = sync(&changes, &mut replica);
+    assert!(patch.contains("shot_2"));
+    assert!(!patch.contains("shot_5"));
+
+    v1.overwrite(
+        clip("overwrite"),
+        TimeRange::new(RationalTime::new(12.0, 24.0), RationalTime::new(24.0, 24.0)),
+        false,
+    )
+    .unwrap();
+    sync(&changes, &mut replica);
+
+    v1.insert_at_time(clip("inserted"), RationalTime::new(96.0, 24.0), false).unwrap();
+    v1.remove_at_time(RationalTime::new(0.0, 24.0), true).unwrap();
+    sync(&changes, &mut replica);
+}
+
+#[test]
+fn test_patch_size_follows_the_edit() {
+    let sizes: Vec<usize> = [10, 1000]
+        .into_iter()
+        .map(|clips| {
+            let (mut timeline, _v1, _a1) = sample_timeline(clips);
+            let changes = timeline.track_changes().unwrap();
+            let mut shot = changes.timeline().find_clips().find(|clip| clip.name() == "shot_5").unwrap();
+            shot.set_metadata("vfx_id", "VFX-0005");
+            changes.take_patch().unwrap().len()
+        })
+        .collect();
+    assert_eq!(sizes[0], sizes[1]);
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+#[test]
+fn test_malformed_patches_are_rejected() {
+    let (mut timeline, _v1, _a1) = sample_timeline(2);
+    let before = timeline.to_json_string().unwrap();
+    assert!(timeline.apply_patch("not json").is_err());
+    assert!(timeline.apply_patch(r#"{"ops":[]}"#).is_err());
+    assert!(timeline
+        .apply_patch(r#"{"OTIO_PATCH":1,"ops":[{"op":"set","path":[0,0],"value":{"OTIO_SCHEMA":"Bogus.1"}}]}"#)
+        .is_err());
+    assert_eq!(timeline.to_json_string().unwrap(), before);
+}
+
+#[test]
+fn test_mismatched_path_is_an_error() {
+    let (mut source, _v1, _a1) = sample_timeline(2);
+    let changes = source.track_changes().unwrap();
+    let mut shot = changes.timeline().find_clips().find(|clip| clip.name() == "music").unwrap();
+    shot.set_metadata("mix", "final");
+    let patch = changes.take_patch().unwrap();
+
+    // A1 (path [1, 0]) does not exist in an empty timeline
+    let mut empty = Timeline::new("Empty");
+    assert!(empty.apply_patch(&patch).is_err());
+}
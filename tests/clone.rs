@@ -0,0 +1,184 @@
+//! Tests for in-memory cloning.
+//!
+//! This file tests:
+//! - `Timeline::duplicate()` in deep and shared mode matching the original
+//! - Forks that are edited independently of the original and each other
+//! - Shared forks dropped on other threads, and shared markers read without
+//!   copying them
+//! - Track, stack and clip copies, including copies out of a timeline
+
+use otio_rs::marker::colors;
+use otio_rs::{
+    CloneMode, Clip, ExternalReference, HasFingerprint, HasMetadata, LinearTimeWarp, Marker,
+    RationalTime, Stack, TimeRange, Timeline,
+};
+
+fn clip(name: &str) -> Clip {
+    let mut clip = Clip::new(
+        name,
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+    );
+    clip.set_media_reference(ExternalReference::new(&format!("/media/{name}.mov"))).unwrap();
+    clip.set_metadata("vfx_id", name);
+    clip
+}
+
+/// V1: `clips` shots, one with a marker and a time warp, and a nested stack
+fn sample_timeline(clips: usize) -> Timeline {
+    let mut timeline = Timeline::new("Master");
+    timeline.set_metadata("show", "demo");
+    let mut v1 = timeline.add_video_track("V1");
+    let mut first = clip("first");
+    let range = TimeRange::new(RationalTime::new(10.0, 24.0), RationalTime::new(5.0, 24.0));
+    first.add_marker(Marker::new("Review", range, colors::RED)).unwrap();
+    first.add_linear_time_warp(LinearTimeWarp::new("Speed", 2.0)).unwrap();
+    v1.append_clip(first).unwrap();
+    for i in 0..clips {
+        v1.append_clip(clip(&format!("shot_{i}"))).unwrap();
+    }
+    let mut nested = Stack::new("Nested");
+    nested.append_clip(clip("inner")).unwrap();
+    v1.append_stack(nested).unwrap();
+    timeline
+}
+
+fn json(timeline: &Timeline) -> String {
+    timeline.to_json_string().unwrap()
+}
+
+// ============================================================================
+// Timelines
+// ============================================================================
+
+#[test]
+fn test_duplicate_matches_original() {
+    let timeline = sample_timeline(5);
+    for mode in [CloneMode::Deep, CloneMode::Shared] {
+        let copy = timeline.duplicate(mode).unwrap();
+        assert_eq!(json(&copy), json(&timeline));
+    }
+}
+
+#[test]
+fn test_forks_are_independent() {
+    let timeline = sample_timeline(3);
+    let before = json(&timeline);
+    for mode in [CloneMode::Deep, CloneMode::Shared] {
+        let mut fork = timeline.duplicate(mode).unwrap();
+        fork.set_metadata("delivery", "uhd");
+        let mut v1 = fork.video_tracks().next().unwrap();
+        v1.set_metadata("locked", "yes");
+        let mut shot = fork.find_clips().find(|clip| clip.name() == "shot_1").unwrap();
+        shot.set_metadata("vfx_id", "changed");
+        let mut v2 = fork.add_video_track("V2");
+        v2.append_clip(clip("extra")).unwrap();
+
+        assert_eq!(json(&timeline), before);
+        assert!(json(&fork).contains("changed"));
+    }
+}
+
+#[test]
+fn test_forks_of_forks() {
+    let timeline = sample_timeline(2);
+    let mut a = timeline.duplicate(CloneMode::Shared).unwrap();
+    let b = a.duplicate(CloneMode::Shared).unwrap();
+    a.set_metadata("fork", "a");
+    assert_eq!(b.get_metadata("fork"), None);
+    assert_eq!(json(&b), json(&timeline));
+
+    // Forks outlive the timeline they were made from
+    drop(timeline);
+    drop(a);
+    assert!(json(&b).contains("Review"));
+}
+
+#[test]
+fn test_shared_forks_dropped_on_other_threads() {
+    let timeline = sample_timeline(20);
+    let expected = json(&timeline);
+    let workers: Vec<_> = (0..4)
+        .map(|_| {
+            let fork = timeline.duplicate(CloneMode::Shared).unwrap();
+            std::thread::spawn(move || {
+                let copy = json(&fork);
+                drop(fork);
+                copy
+            })
+        })
+        .collect();
+    // The original keeps reading the shared markers and media references
+    // while the forks release them
+    for _ in 0..8 {
+        assert_eq!(json(&timeline), expected);
+    }
+    for worker in workers {
+        assert_eq!(worker.join().unwrap(), expected);
+    }
+    assert_eq!(json(&timeline), expected);
+}
+
+#[test]
+fn test_reading_shared_markers_keeps_them_shared() {
+    let timeline = sample_timeline(3);
+    let fork = timeline.duplicate(CloneMode::Shared).unwrap();
+    let cache = fork.enable_fingerprint_cache().unwrap();
+    let fingerprint = fork.fingerprint().unwrap();
+    let cold = cache.stats();
+
+    let first = fork.find_clips().next().unwrap();
+    let markers: Vec<_> = first.markers().collect();
+    assert_eq!(markers.len(), 1);
+    assert_eq!(markers[0].name(), "Review");
+    assert_eq!(markers[0].color(), colors::RED);
+    assert!(markers[0].is_shared());
+
+    // Reading copied nothing and left the memoized fingerprints alone
+    let original = timeline.find_clips().next().unwrap();
+    assert!(original.markers().all(|marker| marker.is_shared()));
+    assert_eq!(fork.fingerprint().unwrap(), fingerprint);
+    let warm = cache.stats();
+    assert_eq!(warm.misses, cold.misses);
+    assert_eq!(warm.hits, cold.hits + 1);
+}
+
+#[test]
+fn test_duplicate_has_no_journal() {
+    let mut timeline = sample_timeline(1);
+    let journal = timeline.enable_undo(8).unwrap();
+    let mut fork = journal.timeline().duplicate(CloneMode::Deep).unwrap();
+    assert!(fork.enable_undo(8).is_ok());
+}
+
+// ============================================================================
+// Items
+// ============================================================================
+
+#[test]
+fn test_duplicate_track_and_clip_out_of_timeline() {
+    let timeline = sample_timeline(3);
+    let v1 = timeline.video_tracks().next().unwrap();
+    let copy = v1.duplicate(CloneMode::Deep).unwrap();
+    assert_eq!(copy.children_count(), v1.children_count());
+
+    let shot = timeline.find_clips().find(|clip| clip.name() == "shot_2").unwrap();
+    let mut other = Timeline::new("Other");
+    let mut track = other.add_video_track("V1");
+    track.append_clip(shot.duplicate(CloneMode::Shared).unwrap()).unwrap();
+    assert!(json(&other).contains("/media/shot_2.mov"));
+    assert_eq!(v1.children_count(), 5);
+}
+
+#[test]
+fn test_duplicate_owned_items() {
+    let original = clip("solo");
+    let copy = original.duplicate(CloneMode::Deep).unwrap();
+    assert_eq!(copy.name(), "solo");
+    assert_eq!(copy.get_metadata("vfx_id").as_deref(), Some("solo"));
+
+    let mut stack = Stack::new("Layers");
+    stack.append_clip(original).unwrap();
+    let stack_copy = stack.duplicate(CloneMode::Shared).unwrap();
+    assert_eq!(stack_copy.children_count(), 1);
+    assert_eq!(stack_copy.name(), "Layers");
+}
@@ -0,0 +1,119 @@
+//! Tests for gzip-compressed timeline files.
+//!
+//! This file tests:
+//! - `Timeline::write_to_gzip_file()` roundtrips and compression levels
+//! - Transparent decompression in the JSON, binary, lazy and batch readers
+//! - The error reported when gzip support is not built in
+
+use otio_rs::{Clip, HasMetadata, RationalTime, TimeRange, Timeline};
+use std::io::Write;
+use tempfile::NamedTempFile;
+
+#[cfg_attr(not(feature = "gzip"), allow(dead_code))]
+fn sample_timeline() -> Timeline {
+    let mut timeline = Timeline::new("Compressed");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..200 {
+        let mut clip = Clip::new(
+            &format!("shot_{i:04}"),
+            TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+        );
+        clip.set_metadata("vendor", "acme");
+        v1.append_clip(clip).unwrap();
+    }
+    timeline
+}
+
+#[cfg(feature = "gzip")]
+mod gzip {
+    use super::*;
+    use otio_rs::{LazyTimeline, LoadFilter};
+
+    // ========================================================================
+    // Roundtrips
+    // ========================================================================
+
+    #[test]
+    fn test_gzip_roundtrip() {
+        let timeline = sample_timeline();
+        let file = NamedTempFile::with_suffix(".otio.gz").unwrap();
+        timeline.write_to_gzip_file(file.path(), None).unwrap();
+
+        let bytes = std::fs::read(file.path()).unwrap();
+        assert_eq!(&bytes[..2], &[0x1f, 0x8b]);
+        let json = timeline.to_json_string().unwrap();
+        assert!(bytes.len() < json.len() / 10);
+
+        let restored = Timeline::read_from_file(file.path()).unwrap();
+        assert_eq!(restored.to_json_string().unwrap(), json);
+    }
+
+    #[test]
+    fn test_gzip_levels() {
+        let timeline = sample_timeline();
+        let stored = NamedTempFile::new().unwrap();
+        let smallest = NamedTempFile::new().unwrap();
+        timeline.write_to_gzip_file(stored.path(), Some(0)).unwrap();
+        timeline.write_to_gzip_file(smallest.path(), Some(9)).unwrap();
+        let stored_len = std::fs::metadata(stored.path()).unwrap().len();
+        let smallest_len = std::fs::metadata(smallest.path()).unwrap().len();
+        assert!(smallest_len < stored_len);
+        assert!(Timeline::read_from_file(stored.path()).is_ok());
+
+        assert!(timeline.write_to_gzip_file(stored.path(), Some(10)).is_err());
+    }
+
+    #[test]
+    fn test_gzip_schema_versions() {
+        let timeline = sample_timeline();
+        let file = NamedTempFile::new().unwrap();
+        timeline
+            .write_to_gzip_file_with_schema_versions(file.path(), Some(1), &[("Clip", 1)])
+            .unwrap();
+        let restored = Timeline::read_from_file(file.path()).unwrap();
+        let expected = timeline.to_json_string_with_schema_versions(&[("Clip", 1)]).unwrap();
+        let expected = Timeline::from_json_string(&expected).unwrap();
+        assert_eq!(restored.to_json_string().unwrap(), expected.to_json_string().unwrap());
+    }
+
+    // ========================================================================
+    // Other readers
+    // ========================================================================
+
+    #[test]
+    fn test_other_readers_decompress() {
+        let timeline = sample_timeline();
+        let file = NamedTempFile::new().unwrap();
+        timeline.write_to_gzip_file(file.path(), None).unwrap();
+
+        let lazy = LazyTimeline::read_from_file(file.path(), &LoadFilter::new()).unwrap();
+        assert_eq!(lazy.timeline().name(), "Compressed");
+
+        let loaded = Timeline::read_from_files(&[file.path(), file.path()], 2);
+        assert!(loaded.iter().all(Result::is_ok));
+    }
+
+    #[test]
+    fn test_truncated_gzip_is_an_error() {
+        let file = NamedTempFile::new().unwrap();
+        sample_timeline().write_to_gzip_file(file.path(), None).unwrap();
+        let bytes = std::fs::read(file.path()).unwrap();
+        let mut truncated = NamedTempFile::new().unwrap();
+        truncated.write_all(&bytes[..bytes.len() / 2]).unwrap();
+        assert!(Timeline::read_from_file(truncated.path()).is_err());
+    }
+}
+
+#[cfg(not(feature = "gzip"))]
+#[test]
+fn test_gzip_file_without_support_is_an_error() {
+    // A valid gzip member holding "{}"
+    let mut file = NamedTempFile::new().unwrap();
+    file.write_all(&[
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xab, 0xae, 0x05, 0x00, 0x43,
+        0xbf, 0xa6, 0xa3, 0x02, 0x00, 0x00, 0x00,
+    ])
+    .unwrap();
+    let err = Timeline::read_from_file(file.path()).unwrap_err();
+    assert!(err.message.contains("zlib"));
+}
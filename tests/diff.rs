@@ -0,0 +1,195 @@
+//! Tests for structural diffs between timelines.
+//!
+//! This file tests:
+//! - `Timeline::diff()` on identical timelines and single edits
+//! - Items added, removed, retimed, re-referenced, renamed and moved
+//! - Changes to the timelines themselves, and added tracks
+
+use otio_rs::{
+    CloneMode, Clip, Composable, DiffChanges, DiffKind, DiffOp, ExternalReference, HasMetadata,
+    RationalTime, TimeRange, Timeline,
+};
+
+fn shot(name: &str, frames: f64, url: &str) -> Clip {
+    let mut clip = Clip::new(
+        name,
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(frames, 24.0)),
+    );
+    clip.set_media_reference(ExternalReference::new(url)).unwrap();
+    clip
+}
+
+fn clip(name: &str) -> Clip {
+    shot(name, 48.0, &format!("/media/{name}.mov"))
+}
+
+/// One video track per entry, named by its first element
+fn cut(tracks: Vec<(&str, Vec<Clip>)>) -> Timeline {
+    let mut timeline = Timeline::new("Cut");
+    for (name, clips) in tracks {
+        let mut track = timeline.add_video_track(name);
+        for clip in clips {
+            track.append_clip(clip).unwrap();
+        }
+    }
+    timeline
+}
+
+fn clips(names: &[&str]) -> Vec<Clip> {
+    names.iter().map(|name| clip(name)).collect()
+}
+
+fn name_of(item: Option<&Composable<'_>>) -> String {
+    match item {
+        Some(Composable::Clip(clip)) => clip.name(),
+        Some(Composable::Track(track)) => track.name(),
+        Some(Composable::Stack(stack)) => stack.name(),
+        _ => "<none>".to_string(),
+    }
+}
+
+/// (kind, name, changes) of every op, naming it as in after where it is
+fn summary(ops: &[DiffOp<'_>]) -> Vec<(DiffKind, String, DiffChanges)> {
+    ops.iter()
+        .map(|op| (op.kind, name_of(op.after.as_ref().or(op.before.as_ref())), op.changes))
+        .collect()
+}
+
+// ============================================================================
+// Unchanged timelines
+// ============================================================================
+
+#[test]
+fn test_identical_timelines() {
+    let before = cut(vec![("V1", clips(&["a", "b", "c"])), ("V2", clips(&["d"]))]);
+    let replica = Timeline::from_json_string(&before.to_json_string().unwrap()).unwrap();
+    assert!(before.diff(&replica).unwrap().is_empty());
+    assert!(before.diff(&before.duplicate(CloneMode::Shared).unwrap()).unwrap().is_empty());
+}
+
+#[test]
+fn test_one_edit_in_a_long_track_is_one_op() {
+    let names: Vec<String> = (0..500).map(|i| format!("shot_{i}")).collect();
+    let before = cut(vec![("V1", names.iter().map(|name| clip(name)).collect())]);
+    let after = before.duplicate(CloneMode::Deep).unwrap();
+    let mut edited = after.find_clips().find(|clip| clip.name() == "shot_120").unwrap();
+    edited.set_metadata("vfx_id", "VFX-0120");
+
+    let diff = before.diff(&after).unwrap();
+    assert_eq!(
+        summary(diff.ops()),
+        vec![(DiffKind::Changed, "shot_120".to_string(), DiffChanges::METADATA)]
+    );
+    assert_eq!(diff.ops()[0].before_index, Some(120));
+    assert_eq!(diff.ops()[0].after_index, Some(120));
+    assert!(diff.timeline_changes().is_empty());
+}
+
+// ============================================================================
+// Item changes
+// ============================================================================
+
+#[test]
+fn test_added_and_removed() {
+    let before = cut(vec![("V1", clips(&["a", "b", "c", "d"]))]);
+    let after = cut(vec![("V1", clips(&["opening", "a", "b", "d"]))]);
+    let diff = before.diff(&after).unwrap();
+    // The clips that kept their order are not reported as moved
+    assert_eq!(
+        summary(diff.ops()),
+        vec![
+            (DiffKind::Removed, "c".to_string(), DiffChanges::default()),
+            (DiffKind::Added, "opening".to_string(), DiffChanges::default()),
+        ]
+    );
+    assert_eq!(diff.ops()[0].before_index, Some(2));
+    assert_eq!(diff.ops()[1].after_index, Some(0));
+}
+
+#[test]
+fn test_retimed_and_new_media() {
+    let before = cut(vec![("V1", clips(&["a", "b", "c"]))]);
+    let after = cut(vec![(
+        "V1",
+        vec![clip("a"), shot("b", 36.0, "/media/b.mov"), shot("c", 48.0, "/media/c_v2.mov")],
+    )]);
+    assert_eq!(
+        summary(before.diff(&after).unwrap().ops()),
+        vec![
+            (DiffKind::Changed, "b".to_string(), DiffChanges::RETIMED),
+            (DiffKind::Changed, "c".to_string(), DiffChanges::MEDIA),
+        ]
+    );
+}
+
+#[test]
+fn test_renamed_clip_is_matched_by_content() {
+    let before = cut(vec![("V1", clips(&["a", "b", "c"]))]);
+    let after = cut(vec![("V1", vec![clip("a"), shot("b_v2", 48.0, "/media/b.mov"), clip("c")])]);
+    assert_eq!(
+        summary(before.diff(&after).unwrap().ops()),
+        vec![(DiffKind::Changed, "b_v2".to_string(), DiffChanges::RENAMED)]
+    );
+}
+
+#[test]
+fn test_swapped_clips_are_one_move() {
+    let before = cut(vec![("V1", clips(&["a", "b", "c", "d"]))]);
+    let after = cut(vec![("V1", clips(&["a", "c", "b", "d"]))]);
+    let diff = before.diff(&after).unwrap();
+    assert_eq!(diff.ops().len(), 1);
+    assert_eq!(diff.ops()[0].kind, DiffKind::Changed);
+    assert_eq!(diff.ops()[0].changes, DiffChanges::MOVED);
+}
+
+#[test]
+fn test_move_across_tracks() {
+    let before = cut(vec![("V1", clips(&["a", "b"])), ("V2", clips(&["c"]))]);
+    let mut moved = clip("b");
+    moved.set_metadata("note", "moved up");
+    let after = cut(vec![("V1", clips(&["a"])), ("V2", vec![clip("c"), moved])]);
+    let diff = before.diff(&after).unwrap();
+    assert_eq!(
+        summary(diff.ops()),
+        vec![(DiffKind::Changed, "b".to_string(), DiffChanges::MOVED | DiffChanges::METADATA)]
+    );
+    assert_eq!(diff.ops()[0].before_index, Some(1));
+    assert_eq!(diff.ops()[0].after_index, Some(1));
+}
+
+// ============================================================================
+// Timelines and tracks
+// ============================================================================
+
+#[test]
+fn test_timeline_changes() {
+    let before = cut(vec![("V1", clips(&["a"]))]);
+    let mut after = before.duplicate(CloneMode::Deep).unwrap();
+    after.set_metadata("status", "approved");
+    after.set_global_start_time(RationalTime::new(86400.0, 24.0)).unwrap();
+
+    let diff = before.diff(&after).unwrap();
+    assert!(diff.ops().is_empty());
+    assert_eq!(diff.timeline_changes(), DiffChanges::METADATA | DiffChanges::FIELDS);
+    assert!(!diff.is_empty());
+}
+
+#[test]
+fn test_added_track_lists_only_the_track() {
+    let before = cut(vec![("V1", clips(&["a", "b"]))]);
+    let after = cut(vec![("V1", clips(&["a", "b"])), ("V2", clips(&["c", "d", "e"]))]);
+    let diff = before.diff(&after).unwrap();
+    assert_eq!(
+        summary(diff.ops()),
+        vec![(DiffKind::Added, "V2".to_string(), DiffChanges::default())]
+    );
+    assert!(matches!(diff.ops()[0].after, Some(Composable::Track(_))));
+}
+
+#[test]
+fn test_changes_debug_lists_names() {
+    let changes = DiffChanges::MOVED | DiffChanges::MEDIA;
+    assert!(changes.contains(DiffChanges::MEDIA));
+    assert!(!changes.contains(DiffChanges::RETIMED));
+    assert_eq!(format!("{changes:?}"), "DiffChanges(MOVED | MEDIA)");
+}
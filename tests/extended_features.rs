@@ -796,6 +796,21 @@ fn test_timeline_from_json_string_invalid() {
     assert!(result.is_err());
 }
 
+#[test]
+fn test_timeline_from_json_slice_unterminated() {
+    let timeline = Timeline::new("Slice Test");
+    let json = timeline.to_json_string().unwrap();
+
+    // The slice is followed by unrelated bytes and has no NUL terminator.
+    let mut buffer = json.clone().into_bytes();
+    buffer.extend_from_slice(b"trailing garbage");
+    let restored = Timeline::from_json_slice(&buffer[..json.len()]).unwrap();
+    assert_eq!(restored.name(), "Slice Test");
+
+    assert!(Timeline::from_json_slice(&buffer).is_err());
+    assert!(Timeline::from_json_slice(&[]).is_err());
+}
+
 #[test]
 fn test_timeline_json_complex_structure() {
     let mut timeline = Timeline::new("Complex Test");
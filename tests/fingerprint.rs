@@ -0,0 +1,179 @@
+//! Tests for content fingerprints.
+//!
+//! This file tests:
+//! - `HasFingerprint::fingerprint()` on equal and edited content
+//! - `Timeline::enable_fingerprint_cache()` results and counters
+//! - Invalidation after setters, track edits, structural edits and markers
+
+use otio_rs::{
+    CloneMode, Clip, ExternalReference, FingerprintCacheStats, HasFingerprint, HasMetadata, Marker,
+    RationalTime, TimeRange, Timeline, Track, TrackKind,
+};
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn time(value: f64) -> RationalTime {
+    RationalTime::new(value, 24.0)
+}
+
+fn clip(name: &str) -> Clip {
+    let mut clip = Clip::new(name, range(0.0, 48.0));
+    clip.set_media_reference(ExternalReference::new(&format!("/media/{name}.mov"))).unwrap();
+    clip
+}
+
+/// A timeline of tracks clips long, and its video tracks
+fn sample_timeline(tracks: usize, clips: usize) -> (Timeline, Vec<Track>) {
+    let mut timeline = Timeline::new("Reel");
+    let handles = (0..tracks)
+        .map(|t| {
+            let mut track = timeline.add_video_track(&format!("V{}", t + 1));
+            for i in 0..clips {
+                track.append_clip(clip(&format!("shot_{t}_{i}"))).unwrap();
+            }
+            track
+        })
+        .collect();
+    (timeline, handles)
+}
+
+// ============================================================================
+// Fingerprints
+// ============================================================================
+
+#[test]
+fn test_equal_content_has_equal_fingerprints() {
+    let (timeline, _) = sample_timeline(2, 10);
+    let replica = Timeline::from_json_string(&timeline.to_json_string().unwrap()).unwrap();
+    let copy = timeline.duplicate(CloneMode::Deep).unwrap();
+    let fingerprint = timeline.fingerprint().unwrap();
+    assert_eq!(replica.fingerprint().unwrap(), fingerprint);
+    assert_eq!(copy.fingerprint().unwrap(), fingerprint);
+    assert_eq!(clip("a").fingerprint().unwrap(), clip("a").fingerprint().unwrap());
+}
+
+#[test]
+fn test_edits_change_the_fingerprints_above_them() {
+    let (timeline, tracks) = sample_timeline(2, 10);
+    let before = (
+        timeline.fingerprint().unwrap(),
+        tracks[0].fingerprint().unwrap(),
+        tracks[1].fingerprint().unwrap(),
+    );
+    let mut edited = timeline.find_clips().find(|clip| clip.name() == "shot_1_4").unwrap();
+    edited.set_metadata("vfx_id", "VFX-0140");
+
+    assert_ne!(timeline.fingerprint().unwrap(), before.0);
+    assert_eq!(tracks[0].fingerprint().unwrap(), before.1);
+    assert_ne!(tracks[1].fingerprint().unwrap(), before.2);
+}
+
+#[test]
+fn test_child_order_and_media_matter() {
+    let mut ab = Track::new_video("V1");
+    ab.append_clip(clip("a")).unwrap();
+    ab.append_clip(clip("b")).unwrap();
+    let mut ba = Track::new_video("V1");
+    ba.append_clip(clip("b")).unwrap();
+    ba.append_clip(clip("a")).unwrap();
+    assert_ne!(ab.fingerprint().unwrap(), ba.fingerprint().unwrap());
+
+    let mut moved = clip("a");
+    moved.set_media_reference(ExternalReference::new("/media/a_v2.mov")).unwrap();
+    assert_ne!(moved.fingerprint().unwrap(), clip("a").fingerprint().unwrap());
+}
+
+#[test]
+fn test_attachments_have_fingerprints() {
+    let marker = Marker::new("Note", range(10.0, 1.0), "RED");
+    let same = Marker::new("Note", range(10.0, 1.0), "RED");
+    let other = Marker::new("Note", range(10.0, 1.0), "GREEN");
+    assert_eq!(marker.fingerprint().unwrap(), same.fingerprint().unwrap());
+    assert_ne!(marker.fingerprint().unwrap(), other.fingerprint().unwrap());
+    let url = ExternalReference::new("/media/a.mov").fingerprint().unwrap();
+    assert_eq!(ExternalReference::new("/media/a.mov").fingerprint().unwrap(), url);
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+#[test]
+fn test_cache_reuses_untouched_subtrees() {
+    let (timeline, _) = sample_timeline(2, 50);
+    let uncached = timeline.fingerprint().unwrap();
+    let cache = timeline.enable_fingerprint_cache().unwrap();
+    assert_eq!(timeline.fingerprint().unwrap(), uncached);
+    // The stack, two tracks and their clips
+    let cold = cache.stats();
+    assert_eq!(cold, FingerprintCacheStats { hits: 0, misses: 103, entries: 103 });
+
+    assert_eq!(timeline.fingerprint().unwrap(), uncached);
+    assert_eq!(cache.stats().hits, 1);
+
+    let mut edited = timeline.find_clips().find(|clip| clip.name() == "shot_0_7").unwrap();
+    edited.set_metadata("status", "omit");
+    let edited_fingerprint = timeline.fingerprint().unwrap();
+    assert_ne!(edited_fingerprint, uncached);
+    // The stack, V1 and the clip are rehashed; V2 and the other clips of V1
+    // are not even looked up
+    let warm = cache.stats();
+    assert_eq!(warm.misses - cold.misses, 3);
+    assert_eq!(warm.hits, 1);
+    let replica = Timeline::from_json_string(&timeline.to_json_string().unwrap()).unwrap();
+    assert_eq!(replica.fingerprint().unwrap(), edited_fingerprint);
+}
+
+#[test]
+fn test_cache_follows_edits() {
+    let (cached, mut cached_tracks) = sample_timeline(2, 8);
+    let (plain, mut plain_tracks) = sample_timeline(2, 8);
+    let _cache = cached.enable_fingerprint_cache().unwrap();
+    assert_eq!(cached.fingerprint().unwrap(), plain.fingerprint().unwrap());
+
+    for tracks in [&mut cached_tracks, &mut plain_tracks] {
+        // Edit algorithms retime the neighbours of the clips they change
+        tracks[0].overwrite(clip("fix"), range(30.0, 12.0), false).unwrap();
+        tracks[0].remove_at_time(time(100.0), true).unwrap();
+        tracks[1].set_kind(TrackKind::Audio);
+        tracks[1].add_marker(Marker::new("Sync", range(0.0, 1.0), "RED")).unwrap();
+    }
+    assert_eq!(cached.fingerprint().unwrap(), plain.fingerprint().unwrap());
+    assert_eq!(cached_tracks[0].fingerprint().unwrap(), plain_tracks[0].fingerprint().unwrap());
+}
+
+#[test]
+fn test_cache_follows_structural_edits() {
+    let (cached, mut cached_tracks) = sample_timeline(2, 8);
+    let (plain, mut plain_tracks) = sample_timeline(2, 8);
+    let cache = cached.enable_fingerprint_cache().unwrap();
+    assert_eq!(cached.fingerprint().unwrap(), plain.fingerprint().unwrap());
+
+    for (timeline, tracks) in [(&cached, &mut cached_tracks), (&plain, &mut plain_tracks)] {
+        tracks[0].remove_child(2).unwrap();
+        let mut edited = timeline.find_clips().find(|clip| clip.name() == "shot_0_5").unwrap();
+        edited.set_metadata("status", "omit");
+        tracks[1].append_clip(clip("late")).unwrap();
+    }
+    assert_eq!(cached.fingerprint().unwrap(), plain.fingerprint().unwrap());
+    // Repeated edits to one clip keep matching
+    for take in 1..=2 {
+        for timeline in [&cached, &plain] {
+            let mut edited = timeline.find_clips().find(|clip| clip.name() == "shot_1_3").unwrap();
+            edited.set_metadata_i64("take", take);
+        }
+        assert_eq!(cached.fingerprint().unwrap(), plain.fingerprint().unwrap());
+    }
+    drop(cache);
+}
+
+#[test]
+fn test_one_cache_per_timeline() {
+    let (timeline, _) = sample_timeline(1, 2);
+    let cache = timeline.enable_fingerprint_cache().unwrap();
+    assert!(timeline.enable_fingerprint_cache().is_err());
+    drop(cache);
+    assert!(timeline.enable_fingerprint_cache().is_ok());
+}
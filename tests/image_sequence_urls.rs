@@ -0,0 +1,107 @@
+//! Tests for bulk image sequence URLs.
+//!
+//! This file tests:
+//! - `ImageSequenceReference::target_urls()` against
+//!   `target_url_for_image_number()` for padding, steps, signs and bases
+//! - `ImageSequenceReference::target_urls_into()` buffer reuse
+//! - Invalid ranges and sequences
+
+use otio_rs::{ImageSequenceReference, ImageUrls, RationalTime, TimeRange};
+
+fn sequence(base: &str, start_frame: i32, frame_step: i32, padding: i32) -> ImageSequenceReference {
+    let mut seq =
+        ImageSequenceReference::new(base, "shot_", ".exr", start_frame, frame_step, 24.0, padding);
+    seq.set_available_range(TimeRange::new(
+        RationalTime::new(0.0, 24.0),
+        RationalTime::new(100.0, 24.0),
+    ))
+    .unwrap();
+    seq
+}
+
+fn assert_matches_single_urls(seq: &ImageSequenceReference) {
+    let count = seq.number_of_images();
+    let urls = seq.target_urls(0..count).unwrap();
+    assert_eq!(urls.len(), usize::try_from(count).unwrap());
+    for (image, url) in (0..count).zip(urls.iter()) {
+        assert_eq!(url, seq.target_url_for_image_number(image).unwrap());
+    }
+}
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+#[test]
+fn test_urls_match_single_image_calls() {
+    assert_matches_single_urls(&sequence("/renders/", 1001, 1, 4));
+    // Frame numbers wider than the padding
+    assert_matches_single_urls(&sequence("/renders/", 95, 1, 2));
+    // No padding
+    assert_matches_single_urls(&sequence("/renders/", 1, 1, 0));
+}
+
+#[test]
+fn test_steps_and_negative_frames() {
+    let seq = sequence("/renders/", -10, 2, 4);
+    assert_matches_single_urls(&seq);
+    let urls = seq.target_urls(0..7).unwrap();
+    assert_eq!(urls.get(0), Some("/renders/shot_-0010.exr"));
+    assert_eq!(urls.get(5), Some("/renders/shot_0000.exr"));
+    assert_eq!(urls.get(6), Some("/renders/shot_0002.exr"));
+}
+
+#[test]
+fn test_base_without_trailing_slash() {
+    let seq = sequence("s3://bucket/plates", 1001, 1, 4);
+    assert_matches_single_urls(&seq);
+    assert_eq!(seq.target_urls(0..1).unwrap().get(0), Some("s3://bucket/plates/shot_1001.exr"));
+    assert_matches_single_urls(&sequence("", 1001, 1, 4));
+}
+
+#[test]
+fn test_partial_range() {
+    let seq = sequence("/renders/", 1001, 1, 4);
+    let urls = seq.target_urls(10..13).unwrap();
+    let all: Vec<_> = urls.iter().collect();
+    assert_eq!(
+        all,
+        vec!["/renders/shot_1011.exr", "/renders/shot_1012.exr", "/renders/shot_1013.exr"]
+    );
+    assert!(urls.get(3).is_none());
+    assert!(seq.target_urls(5..5).unwrap().is_empty());
+}
+
+#[test]
+fn test_buffer_is_reused() {
+    let seq = sequence("/renders/", 1001, 1, 4);
+    let mut urls = ImageUrls::new();
+    seq.target_urls_into(0..100, &mut urls).unwrap();
+    assert_eq!(urls.len(), 100);
+    seq.target_urls_into(50..52, &mut urls).unwrap();
+    assert_eq!(
+        urls.iter().collect::<Vec<_>>(),
+        vec!["/renders/shot_1051.exr", "/renders/shot_1052.exr"]
+    );
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+#[test]
+fn test_out_of_range_images_are_an_error() {
+    let seq = sequence("/renders/", 1001, 1, 4);
+    assert!(seq.target_urls(90..101).is_err());
+
+    let mut urls = ImageUrls::new();
+    seq.target_urls_into(0..3, &mut urls).unwrap();
+    assert!(seq.target_urls_into(0..200, &mut urls).is_err());
+    assert!(urls.is_empty());
+}
+
+#[test]
+fn test_sequence_without_frames_is_an_error() {
+    let seq = ImageSequenceReference::new("/renders/", "shot_", ".exr", 1001, 1, 24.0, 4);
+    assert!(seq.target_urls(0..1).is_err());
+}
@@ -0,0 +1,130 @@
+//! Tests for JSON serialization into caller-owned buffers and writers.
+//!
+//! This file tests:
+//! - `Timeline::to_json_into()` output and buffer reuse
+//! - Compact output, including whitespace inside strings
+//! - `Timeline::write_json()` chunking and writer errors
+
+use std::io::{self, Write};
+
+use otio_rs::{Clip, HasMetadata, RationalTime, TimeRange, Timeline};
+
+fn sample_timeline(clips: usize) -> Timeline {
+    let mut timeline = Timeline::new("Output");
+    timeline.set_metadata("note", "two  spaces\nand a line break");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..clips {
+        let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+        v1.append_clip(Clip::new(&format!("shot {i}"), range)).unwrap();
+    }
+    timeline
+}
+
+// ============================================================================
+// Buffers
+// ============================================================================
+
+#[test]
+fn test_to_json_into_matches_to_json_string() {
+    let timeline = sample_timeline(3);
+    let mut buf = Vec::new();
+    timeline.to_json_into(&mut buf, false).unwrap();
+    assert_eq!(String::from_utf8(buf).unwrap(), timeline.to_json_string().unwrap());
+}
+
+#[test]
+fn test_buffer_is_replaced_and_reused() {
+    let timeline = sample_timeline(50);
+    let mut buf = b"stale contents".to_vec();
+    timeline.to_json_into(&mut buf, false).unwrap();
+    assert!(buf.starts_with(b"{"));
+    let capacity = buf.capacity();
+    let len = buf.len();
+
+    let small = sample_timeline(1);
+    small.to_json_into(&mut buf, false).unwrap();
+    assert!(buf.len() < len);
+    assert_eq!(buf.capacity(), capacity);
+}
+
+// ============================================================================
+// Compact output
+// ============================================================================
+
+#[test]
+fn test_compact_output_roundtrips() {
+    let timeline = sample_timeline(3);
+    let mut compact = Vec::new();
+    timeline.to_json_into(&mut compact, true).unwrap();
+    let compact = String::from_utf8(compact).unwrap();
+    assert!(!compact.contains('\n'));
+    assert!(compact.len() < timeline.to_json_string().unwrap().len());
+
+    let restored = Timeline::from_json_string(&compact).unwrap();
+    assert_eq!(restored.to_json_string().unwrap(), timeline.to_json_string().unwrap());
+}
+
+#[test]
+fn test_compact_output_keeps_string_whitespace() {
+    let timeline = sample_timeline(1);
+    let mut compact = Vec::new();
+    timeline.to_json_into(&mut compact, true).unwrap();
+    let restored = Timeline::from_json_string(std::str::from_utf8(&compact).unwrap()).unwrap();
+    assert_eq!(
+        restored.get_metadata("note").as_deref(),
+        Some("two  spaces\nand a line break")
+    );
+    assert!(std::str::from_utf8(&compact).unwrap().contains("\"shot 0\""));
+}
+
+// ============================================================================
+// Writers
+// ============================================================================
+
+/// Records the size of every write.
+#[derive(Default)]
+struct Chunks {
+    data: Vec<u8>,
+    sizes: Vec<usize>,
+}
+
+impl Write for Chunks {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        self.data.extend_from_slice(buf);
+        self.sizes.push(buf.len());
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+#[test]
+fn test_write_json_in_chunks() {
+    let timeline = sample_timeline(500);
+    let mut chunks = Chunks::default();
+    timeline.write_json(&mut chunks, false).unwrap();
+    assert!(chunks.sizes.len() > 1);
+    assert!(chunks.sizes.iter().all(|&size| size <= 64 * 1024));
+    assert_eq!(String::from_utf8(chunks.data).unwrap(), timeline.to_json_string().unwrap());
+}
+
+struct Failing;
+
+impl Write for Failing {
+    fn write(&mut self, _buf: &[u8]) -> io::Result<usize> {
+        Err(io::Error::new(io::ErrorKind::BrokenPipe, "client went away"))
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+#[test]
+fn test_writer_error_is_returned() {
+    let timeline = sample_timeline(3);
+    let err = timeline.write_json(&mut Failing, true).unwrap_err();
+    assert!(err.message.contains("client went away"));
+}
@@ -12,8 +12,8 @@
 #![allow(clippy::drop_non_drop)]
 
 use otio_rs::{
-    marker, Clip, Gap, HasMetadata, ImageSequenceReference, Marker, RationalTime, Stack,
-    Timeline, TimeRange, Track,
+    marker, Clip, CloneMode, ExternalReference, Gap, HasMetadata, ImageSequenceReference, Marker,
+    RationalTime, Stack, Timeline, TimeRange, Track,
 };
 
 /// Stress test: Create and drop many timelines.
@@ -354,6 +354,46 @@ fn stress_test_early_drop() {
     }
 }
 
+/// Stress test: Timelines released on the background thread, including one
+/// whose stack is still held by an index when it is dropped.
+#[test]
+#[ignore = "Run with memory tools: cargo test --test memory -- --ignored"]
+fn stress_test_background_release() {
+    for iteration in 0..200 {
+        let mut timeline = Timeline::new(&format!("Background {iteration}"));
+        let mut track = timeline.add_video_track("V1");
+        for i in 0..100 {
+            let clip = Clip::new(
+                &format!("Clip {i}"),
+                TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0)),
+            );
+            track.append_clip(clip).unwrap();
+        }
+        drop(track);
+        timeline.set_background_release(true);
+        drop(timeline);
+    }
+
+    let mut timeline = Timeline::new("Held");
+    let mut track = timeline.add_video_track("V1");
+    let mut clip = Clip::new(
+        "Held clip",
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0)),
+    );
+    clip.set_metadata("vfx_id", "VFX-0001");
+    clip.set_media_reference(ExternalReference::new("/media/held.mov")).unwrap();
+    track.append_clip(clip).unwrap();
+    drop(track);
+    // The fork shares the clip's media reference with the released original
+    let fork = timeline.duplicate(CloneMode::Shared).unwrap();
+    timeline.set_background_release(true);
+    drop(timeline);
+    Timeline::wait_for_background_releases();
+    assert!(fork.to_json_string().unwrap().contains("/media/held.mov"));
+    let index = fork.build_asset_index(&["vfx_id"]).unwrap();
+    assert_eq!(index.find_url("/media/held.mov").unwrap().len(), 1);
+}
+
 /// Stress test: Audio tracks.
 #[test]
 #[ignore = "Run with memory tools: cargo test --test memory -- --ignored"]
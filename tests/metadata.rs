@@ -188,3 +188,138 @@ fn test_standalone_track_metadata() {
     assert_eq!(track.get_metadata("track_id"), Some("standalone_001".to_string()));
     assert_eq!(track.get_metadata("kind"), Some("video".to_string()));
 }
+
+/// Test metadata read through string views.
+#[test]
+fn test_metadata_str() {
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+    let mut clip = Clip::new("View Clip", range);
+    clip.set_metadata("shot", "sh010");
+    clip.set_metadata("empty", "");
+    let long_key = "k".repeat(200);
+    clip.set_metadata(&long_key, "long key value");
+
+    assert_eq!(clip.metadata_str("shot").as_deref(), Some("sh010"));
+    assert_eq!(clip.metadata_str("empty").as_deref(), Some(""));
+    assert_eq!(clip.metadata_str(&long_key).as_deref(), Some("long key value"));
+    assert_eq!(clip.metadata_str("missing"), None);
+    assert_eq!(clip.metadata_str("bad\0key"), None);
+
+    // Views agree with the owned getter after a mutation.
+    clip.set_metadata("shot", "sh020");
+    assert_eq!(clip.metadata_str("shot"), clip.get_metadata("shot"));
+}
+
+/// Test metadata views through child references.
+#[test]
+fn test_metadata_str_on_refs() {
+    let mut timeline = Timeline::new("Ref Views");
+    let mut track = timeline.add_video_track("V1");
+    track.set_metadata("department", "editorial");
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+    let mut clip = Clip::new("Shot", range);
+    clip.set_metadata("vendor", "acme");
+    track.append_clip(clip).unwrap();
+
+    let track_ref = timeline.video_tracks().next().unwrap();
+    assert_eq!(track_ref.metadata_str("department").as_deref(), Some("editorial"));
+    let clip_ref = timeline.find_clips().next().unwrap();
+    assert_eq!(clip_ref.metadata_str("vendor").as_deref(), Some("acme"));
+}
+
+/// Test closure-based name accessors.
+#[test]
+fn test_with_name_views() {
+    let timeline = Timeline::new("Named Timeline");
+    assert_eq!(timeline.with_name(str::len), "Named Timeline".len());
+    assert!(timeline.with_name(|name| name == timeline.name()));
+
+    let mut ext_ref = ExternalReference::new("/media/a_fairly_long_path/shot_010_v003.mov");
+    ext_ref.set_name("plate");
+    assert_eq!(
+        ext_ref.with_target_url(ToOwned::to_owned),
+        "/media/a_fairly_long_path/shot_010_v003.mov"
+    );
+
+    // Nested views must not clobber each other.
+    let stack = Stack::new("Outer");
+    let joined = stack.with_name(|outer| ext_ref.with_name(|inner| format!("{outer}/{inner}")));
+    assert_eq!(joined, "Outer/plate");
+}
+
+/// Test typed scalar accessors.
+#[test]
+fn test_typed_metadata_scalars() {
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+    let mut clip = Clip::new("Typed", range);
+    clip.set_metadata_i64("take", 3);
+    clip.set_metadata_f64("gain", 0.5);
+    clip.set_metadata_bool("approved", true);
+    clip.set_metadata("reel", "A001");
+
+    assert_eq!(clip.get_metadata_i64("take"), Some(3));
+    assert_eq!(clip.get_metadata_f64("gain"), Some(0.5));
+    assert_eq!(clip.get_metadata_bool("approved"), Some(true));
+
+    // Values are not converted between kinds
+    assert_eq!(clip.get_metadata_i64("gain"), None);
+    assert_eq!(clip.get_metadata_bool("take"), None);
+    assert_eq!(clip.get_metadata("take"), None);
+    assert_eq!(clip.get_metadata_i64("reel"), None);
+    assert_eq!(clip.get_metadata_i64("missing"), None);
+
+    clip.set_metadata_i64("take", -4);
+    assert_eq!(clip.get_metadata_i64("take"), Some(-4));
+}
+
+/// Test nested dictionaries and arrays, in memory and through JSON.
+#[test]
+fn test_nested_metadata_values() {
+    let mut timeline = Timeline::new("Nested Metadata");
+    let mut vendor = std::collections::BTreeMap::new();
+    vendor.insert("name".to_string(), MetadataValue::from("acme"));
+    vendor.insert("bid".to_string(), MetadataValue::Int(12));
+    let value = MetadataValue::Array(vec![
+        MetadataValue::Dict(vendor),
+        MetadataValue::Bool(false),
+        MetadataValue::Double(1.25),
+        MetadataValue::Null,
+    ]);
+    timeline.set_metadata_value("vendors", &value).unwrap();
+    timeline.set_metadata_i64("episode", 7);
+    timeline.set_metadata("show", "pilot");
+    assert_eq!(timeline.get_metadata_value("vendors"), Some(value.clone()));
+    assert_eq!(timeline.get_metadata_value("missing"), None);
+
+    let json = timeline.to_json_string().unwrap();
+    let reloaded = Timeline::from_json_string(&json).unwrap();
+    assert_eq!(reloaded.get_metadata_value("vendors"), Some(value.clone()));
+    assert_eq!(reloaded.get_metadata_i64("episode"), Some(7));
+
+    let all = reloaded.all_metadata().unwrap();
+    assert_eq!(all.keys().collect::<Vec<_>>(), vec!["episode", "show", "vendors"]);
+    assert_eq!(all["show"].as_str(), Some("pilot"));
+    assert_eq!(all["vendors"], value);
+}
+
+/// Test exporting metadata larger than the initial buffer.
+#[test]
+fn test_all_metadata_large() {
+    let mut track = Track::new_video("Large");
+    for i in 0..200 {
+        track.set_metadata(&format!("key_{i:03}"), &format!("a somewhat longer value {i}"));
+    }
+    let all = track.all_metadata().unwrap();
+    assert_eq!(all.len(), 200);
+    assert_eq!(all["key_199"].as_str(), Some("a somewhat longer value 199"));
+    assert!(Track::new_video("Empty").all_metadata().unwrap().is_empty());
+}
+
+/// Test that values of unrepresentable types can't be set.
+#[test]
+fn test_other_metadata_value_is_rejected() {
+    let mut stack = Stack::new("Rejected");
+    let value = MetadataValue::Array(vec![MetadataValue::Other("RationalTime".to_string())]);
+    assert!(stack.set_metadata_value("time", &value).is_err());
+    assert_eq!(stack.get_metadata_value("time"), None);
+}
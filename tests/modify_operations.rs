@@ -1,4 +1,7 @@
-use otio_rs::{Clip, Composable, Gap, RationalTime, Stack, TimeRange, Timeline, Track};
+use otio_rs::{
+    Clip, Composable, Gap, OwnedComposable, RationalTime, Stack, TimeRange, Timeline, Track,
+    Transition,
+};
 
 fn make_time_range(start: f64, duration: f64, rate: f64) -> TimeRange {
     TimeRange::new(
@@ -329,6 +332,107 @@ fn test_stack_clear_empty() {
     assert_eq!(stack.children_count(), 0);
 }
 
+// ============ Bulk Child Operations ============
+
+fn child_names(track: &Track) -> Vec<String> {
+    track
+        .children()
+        .map(|c| match c {
+            Composable::Clip(clip_ref) => clip_ref.name(),
+            Composable::Gap(_) => "<gap>".to_string(),
+            Composable::Transition(transition_ref) => transition_ref.name(),
+            Composable::Stack(stack_ref) => stack_ref.name(),
+            Composable::Track(track_ref) => track_ref.name(),
+        })
+        .collect()
+}
+
+#[test]
+#[allow(clippy::float_cmp)]
+fn test_track_append_children() {
+    let mut tl = Timeline::new("test");
+    let mut track = tl.add_video_track("V1");
+    track.append_clip(Clip::new("first", make_time_range(0.0, 24.0, 24.0))).unwrap();
+
+    let batch: Vec<OwnedComposable> = vec![
+        Clip::new("a", make_time_range(0.0, 24.0, 24.0)).into(),
+        Transition::dissolve("x", RationalTime::new(6.0, 24.0), RationalTime::new(6.0, 24.0)).into(),
+        Clip::new("b", make_time_range(0.0, 24.0, 24.0)).into(),
+        Gap::new(RationalTime::new(12.0, 24.0)).into(),
+        Stack::new("nested").into(),
+    ];
+    track.append_children(batch).unwrap();
+
+    assert_eq!(child_names(&track), vec!["first", "a", "x", "b", "<gap>", "nested"]);
+    let range = track.range_of_child_at_index(3).unwrap();
+    assert_eq!(range.start_time.value, 48.0);
+}
+
+#[test]
+#[allow(clippy::float_cmp)]
+fn test_track_insert_children_keeps_order() {
+    let mut track = Track::new_video("V1");
+    track.append_clip(Clip::new("head", make_time_range(0.0, 24.0, 24.0))).unwrap();
+    track.append_clip(Clip::new("tail", make_time_range(0.0, 24.0, 24.0))).unwrap();
+
+    let batch = (0..3).map(|i| Clip::new(&format!("mid{i}"), make_time_range(0.0, 24.0, 24.0)).into());
+    track.insert_children(1, batch).unwrap();
+    assert_eq!(child_names(&track), vec!["head", "mid0", "mid1", "mid2", "tail"]);
+
+    // Past the end appends
+    track
+        .insert_children(99, [Gap::new(RationalTime::new(24.0, 24.0)).into()])
+        .unwrap();
+    assert_eq!(track.children_count(), 6);
+    assert_eq!(child_names(&track)[5], "<gap>");
+
+    let range = track.range_of_child_at_index(4).unwrap();
+    assert_eq!(range.start_time.value, 96.0);
+}
+
+#[test]
+fn test_bulk_children_empty_batch() {
+    let mut track = Track::new_video("V1");
+    track.append_children(Vec::new()).unwrap();
+    track.insert_children(0, Vec::new()).unwrap();
+    assert_eq!(track.children_count(), 0);
+}
+
+#[test]
+fn test_bulk_children_rejects_attached_child() {
+    let mut tl = Timeline::new("test");
+    let attached = tl.add_video_track("V1");
+    let mut stack = Stack::new("S");
+    stack.append_clip(Clip::new("existing", make_time_range(0.0, 24.0, 24.0))).unwrap();
+
+    let batch: Vec<OwnedComposable> = vec![
+        Clip::new("ok", make_time_range(0.0, 24.0, 24.0)).into(),
+        attached.into(),
+    ];
+    assert!(stack.insert_children(0, batch).is_err());
+    // Nothing from the batch was attached
+    assert_eq!(stack.children_count(), 1);
+    assert_eq!(tl.tracks().children_count(), 1);
+}
+
+#[test]
+fn test_stack_append_and_insert_children() {
+    let mut stack = Stack::new("S");
+    stack
+        .append_children([Track::new_video("V1").into(), Track::new_audio("A1").into()])
+        .unwrap();
+    stack.insert_children(0, [Track::new_video("V0").into()]).unwrap();
+
+    let names: Vec<_> = stack
+        .children()
+        .map(|c| match c {
+            Composable::Track(track_ref) => track_ref.name(),
+            _ => String::new(),
+        })
+        .collect();
+    assert_eq!(names, vec!["V0", "V1", "A1"]);
+}
+
 // ============ Complex Scenarios ============
 
 #[test]
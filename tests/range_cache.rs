@@ -0,0 +1,184 @@
+//! Tests for cached range queries.
+//!
+//! This file tests:
+//! - `Track::enable_range_cache()` results and counters
+//! - Suffix invalidation after edits
+//! - `Stack::enable_range_cache()`
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use otio_rs::{
+    Clip, Gap, RangeCacheStats, RationalTime, Stack, TimeRange, Timeline, Track, Transition,
+};
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn track_with_clips(count: usize) -> Track {
+    let mut track = Track::new_video("V1");
+    for i in 0..count {
+        track.append_clip(Clip::new(&format!("Clip {i}"), range(0.0, 24.0))).unwrap();
+    }
+    track
+}
+
+/// `track_with_clips` as a timeline's track, and a handle to edit it with
+/// while a cache borrows the timeline
+fn timeline_with_clips(count: usize) -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Cached");
+    let mut track = timeline.add_video_track("V1");
+    for i in 0..count {
+        track.append_clip(Clip::new(&format!("Clip {i}"), range(0.0, 24.0))).unwrap();
+    }
+    (timeline, track)
+}
+
+fn all_ranges(track: &Track) -> Vec<(f64, f64)> {
+    (0..track.children_count())
+        .map(|i| {
+            let r = track.range_of_child_at_index(i).unwrap();
+            (r.start_time.value, r.duration.value)
+        })
+        .collect()
+}
+
+// ============================================================================
+// Results and counters
+// ============================================================================
+
+#[test]
+fn test_cached_ranges_match_uncached() {
+    let mut track = Track::new_video("V1");
+    track.append_clip(Clip::new("A", range(0.0, 48.0))).unwrap();
+    track
+        .append_transition(Transition::dissolve(
+            "Dissolve",
+            RationalTime::new(12.0, 24.0),
+            RationalTime::new(12.0, 24.0),
+        ))
+        .unwrap();
+    track.append_clip(Clip::new("B", range(0.0, 48.0))).unwrap();
+    track.append_gap(Gap::new(RationalTime::new(24.0, 24.0))).unwrap();
+
+    let uncached = all_ranges(&track);
+    let uncached_trimmed = track.trimmed_range().unwrap();
+    let _cache = track.enable_range_cache().unwrap();
+    assert_eq!(all_ranges(&track), uncached);
+    assert_eq!(all_ranges(&track), vec![(0.0, 48.0), (36.0, 24.0), (48.0, 48.0), (96.0, 24.0)]);
+    assert_eq!(track.trimmed_range().unwrap(), uncached_trimmed);
+}
+
+#[test]
+fn test_counters() {
+    let track = track_with_clips(10);
+    let cache = track.enable_range_cache().unwrap();
+    assert_eq!(cache.stats(), RangeCacheStats::default());
+
+    // The last index fills the whole prefix in one miss
+    assert_eq!(track.range_of_child_at_index(9).unwrap().start_time.value, 216.0);
+    assert_eq!(cache.stats(), RangeCacheStats { hits: 0, misses: 1, recomputed: 10 });
+
+    all_ranges(&track);
+    assert_eq!(cache.stats(), RangeCacheStats { hits: 10, misses: 1, recomputed: 10 });
+
+    track.trimmed_range().unwrap();
+    track.trimmed_range().unwrap();
+    assert_eq!(cache.stats(), RangeCacheStats { hits: 11, misses: 2, recomputed: 10 });
+}
+
+#[test]
+fn test_enable_twice_fails_until_dropped() {
+    let track = track_with_clips(2);
+    let cache = track.enable_range_cache().unwrap();
+    assert!(track.enable_range_cache().is_err());
+    drop(cache);
+
+    // Queries still work without a cache
+    assert_eq!(all_ranges(&track), vec![(0.0, 24.0), (24.0, 24.0)]);
+    assert!(track.enable_range_cache().is_ok());
+}
+
+// ============================================================================
+// Invalidation
+// ============================================================================
+
+#[test]
+fn test_remove_recomputes_only_suffix() {
+    let (timeline, mut track) = timeline_with_clips(10);
+    let v1 = timeline.video_tracks().next().unwrap();
+    let cache = v1.enable_range_cache().unwrap();
+    all_ranges(&track);
+    let before = cache.stats();
+
+    track.remove_child(6).unwrap();
+    let ranges = all_ranges(&track);
+    assert_eq!(ranges.len(), 9);
+    assert_eq!(ranges[8], (192.0, 24.0));
+
+    let after = cache.stats();
+    assert_eq!(after.recomputed - before.recomputed, 3);
+    assert_eq!(after.misses - before.misses, 1);
+}
+
+#[test]
+fn test_insert_and_append_invalidate() {
+    let (timeline, mut track) = timeline_with_clips(4);
+    let v1 = timeline.video_tracks().next().unwrap();
+    let cache = v1.enable_range_cache().unwrap();
+    all_ranges(&track);
+
+    track.insert_clip(1, Clip::new("Short", range(0.0, 12.0))).unwrap();
+    assert_eq!(
+        all_ranges(&track),
+        vec![(0.0, 24.0), (24.0, 12.0), (36.0, 24.0), (60.0, 24.0), (84.0, 24.0)]
+    );
+    assert_eq!(track.trimmed_range().unwrap().duration.value, 108.0);
+
+    let before = cache.stats();
+    track.append_clip(Clip::new("Tail", range(0.0, 24.0))).unwrap();
+    assert_eq!(track.range_of_child_at_index(5).unwrap().start_time.value, 108.0);
+    assert_eq!(track.trimmed_range().unwrap().duration.value, 132.0);
+    assert_eq!(cache.stats().recomputed - before.recomputed, 1);
+}
+
+#[test]
+fn test_edit_algorithm_invalidates() {
+    let (timeline, mut track) = timeline_with_clips(3);
+    let v1 = timeline.video_tracks().next().unwrap();
+    let _cache = v1.enable_range_cache().unwrap();
+    all_ranges(&track);
+
+    track.remove_at_time(RationalTime::new(30.0, 24.0), false).unwrap();
+    assert_eq!(all_ranges(&track), vec![(0.0, 24.0), (24.0, 24.0)]);
+}
+
+// ============================================================================
+// Stacks
+// ============================================================================
+
+#[test]
+fn test_stack_cache() {
+    let mut stack = Stack::new("S");
+    stack.append_clip(Clip::new("A", range(0.0, 24.0))).unwrap();
+    stack.append_clip(Clip::new("B", range(0.0, 48.0))).unwrap();
+    stack.append_clip(Clip::new("C", range(0.0, 96.0))).unwrap();
+    let cache = stack.enable_range_cache().unwrap();
+
+    assert_eq!(stack.range_of_child_at_index(1).unwrap().duration.value, 48.0);
+    assert_eq!(stack.trimmed_range().unwrap().duration.value, 96.0);
+    assert_eq!(stack.trimmed_range().unwrap().duration.value, 96.0);
+    assert_eq!(stack.range_of_child_at_index(2).unwrap().start_time.value, 0.0);
+    assert_eq!(cache.stats(), RangeCacheStats { hits: 1, misses: 3, recomputed: 3 });
+}
+
+#[test]
+fn test_standalone_track_outlives_cache() {
+    let track = track_with_clips(3);
+    let cache = track.enable_range_cache().unwrap();
+    all_ranges(&track);
+    drop(cache);
+    // The cache borrowed the track; it did not own it
+    assert_eq!(all_ranges(&track), vec![(0.0, 24.0), (24.0, 24.0), (48.0, 24.0)]);
+}
@@ -0,0 +1,281 @@
+//! Tests for render manifests.
+//!
+//! This file tests:
+//! - Run-length encoding of clips, gaps and URLs on a track
+//! - Linear time warps and image sequence URLs
+//! - Transitions (both layers) and stack compositing
+//! - `RenderManifest::runs_at()` and invalid ranges
+//! - Parallel builds matching serial ones
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use std::ops::Range;
+
+use otio_rs::{
+    Clip, ExternalReference, Gap, ImageSequenceReference, LinearTimeWarp, RationalTime,
+    RenderManifest, TimeRange, Timeline, Track, Transition,
+};
+
+fn frames(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn clip(name: &str, source: TimeRange, url: &str) -> Clip {
+    let mut clip = Clip::new(name, source);
+    clip.set_media_reference(ExternalReference::new(url)).unwrap();
+    clip
+}
+
+// ============================================================================
+// Tracks
+// ============================================================================
+
+#[test]
+fn test_clips_and_gaps_become_runs() {
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("a", frames(0.0, 48.0), "/media/a.mov")).unwrap();
+    v1.append_gap(Gap::new(RationalTime::new(12.0, 24.0))).unwrap();
+    v1.append_clip(clip("b", frames(100.0, 24.0), "/media/b.mov")).unwrap();
+
+    let manifest = v1.render_manifest(frames(0.0, 84.0)).unwrap();
+    assert_eq!(manifest.frame_count(), 84);
+    assert_eq!(manifest.rate(), 24.0);
+    assert_eq!(manifest.urls(), ["/media/a.mov", "/media/b.mov"]);
+
+    let runs = manifest.runs();
+    assert_eq!(runs.len(), 3);
+    assert_eq!(runs[0].frames, 0..48);
+    assert_eq!(runs[0].clip.as_ref().unwrap().name(), "a");
+    assert_eq!((runs[0].source_start, runs[0].source_step), (0.0, 1.0));
+    assert_eq!((runs[0].url_index, runs[0].url_step), (Some(0), 0));
+
+    assert_eq!(runs[1].frames, 48..60);
+    assert!(runs[1].clip.is_none());
+    assert_eq!(runs[1].url_index, None);
+
+    assert_eq!(runs[2].frames, 60..84);
+    assert_eq!(runs[2].source_time(70), RationalTime::new(110.0, 24.0));
+    assert_eq!(manifest.url_at(&runs[2], 70), Some("/media/b.mov"));
+}
+
+#[test]
+fn test_range_inside_the_track() {
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("a", frames(0.0, 48.0), "/media/a.mov")).unwrap();
+    v1.append_clip(clip("b", frames(100.0, 48.0), "/media/b.mov")).unwrap();
+
+    // Frames count from the start of the range
+    let manifest = v1.render_manifest(frames(40.0, 16.0)).unwrap();
+    let runs = manifest.runs();
+    assert_eq!(runs.len(), 2);
+    assert_eq!((runs[0].frames.clone(), runs[0].source_start), (0..8, 40.0));
+    assert_eq!((runs[1].frames.clone(), runs[1].source_start), (8..16, 100.0));
+}
+
+#[test]
+fn test_time_warp_scales_source_step() {
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    let mut fast = clip("fast", frames(10.0, 24.0), "/media/fast.mov");
+    fast.add_linear_time_warp(LinearTimeWarp::new("Double", 2.0)).unwrap();
+    v1.append_clip(fast).unwrap();
+    let mut held = clip("held", frames(50.0, 24.0), "/media/held.mov");
+    held.add_linear_time_warp(LinearTimeWarp::new("Hold", 0.0)).unwrap();
+    v1.append_clip(held).unwrap();
+
+    let manifest = v1.render_manifest(frames(0.0, 48.0)).unwrap();
+    let runs = manifest.runs();
+    assert_eq!(runs.len(), 2);
+    assert_eq!((runs[0].source_start, runs[0].source_step), (10.0, 2.0));
+    assert_eq!(runs[0].source_time(5), RationalTime::new(20.0, 24.0));
+    assert_eq!((runs[1].source_start, runs[1].source_step), (50.0, 0.0));
+}
+
+#[test]
+fn test_image_sequence_urls_step_per_frame() {
+    let mut seq = ImageSequenceReference::new("/renders/", "shot_", ".exr", 1001, 1, 24.0, 4);
+    seq.set_available_range(frames(0.0, 48.0)).unwrap();
+    let mut shot = Clip::new("shot", frames(0.0, 48.0));
+    shot.set_image_sequence_reference(seq).unwrap();
+
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(shot).unwrap();
+
+    let manifest = v1.render_manifest(frames(0.0, 48.0)).unwrap();
+    assert_eq!(manifest.urls().len(), 48);
+    let runs = manifest.runs();
+    assert_eq!(runs.len(), 1);
+    assert_eq!(runs[0].url_step, 1);
+    assert_eq!(manifest.url_at(&runs[0], 0), Some("/renders/shot_1001.exr"));
+    assert_eq!(manifest.url_at(&runs[0], 5), Some("/renders/shot_1006.exr"));
+}
+
+// ============================================================================
+// Transitions and stacks
+// ============================================================================
+
+#[test]
+fn test_transition_has_two_layers() {
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("a", frames(0.0, 48.0), "/media/a.mov")).unwrap();
+    let offset = RationalTime::new(6.0, 24.0);
+    v1.append_transition(Transition::dissolve("Dissolve", offset, offset)).unwrap();
+    v1.append_clip(clip("b", frames(100.0, 48.0), "/media/b.mov")).unwrap();
+
+    let manifest = v1.render_manifest(frames(0.0, 96.0)).unwrap();
+    assert_eq!(manifest.transitions().len(), 1);
+    assert_eq!(manifest.transitions()[0].frames, 42..54);
+
+    // Before the cut: a on layer 0, b sampled into its head handle
+    let at: Vec<_> = manifest.runs_at(45).collect();
+    assert_eq!(at.len(), 2);
+    assert_eq!((at[0].layer, at[0].clip.as_ref().unwrap().name()), (0, "a".to_string()));
+    assert_eq!((at[1].layer, at[1].clip.as_ref().unwrap().name()), (1, "b".to_string()));
+    assert_eq!(at[1].source_time(45), RationalTime::new(97.0, 24.0));
+    assert_eq!(at[0].transition, Some(0));
+
+    // After the cut: b on layer 0, a sampled into its tail handle
+    let at: Vec<_> = manifest.runs_at(50).collect();
+    assert_eq!(at[0].clip.as_ref().unwrap().name(), "b");
+    assert_eq!(at[1].source_time(50), RationalTime::new(50.0, 24.0));
+
+    // Outside the transition there is one run
+    assert_eq!(manifest.runs_at(60).count(), 1);
+    assert_eq!(manifest.runs_at(10).count(), 1);
+}
+
+#[test]
+fn test_timeline_shows_topmost_track() {
+    let mut timeline = Timeline::new("Manifest");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("base", frames(0.0, 48.0), "/media/base.mov")).unwrap();
+    let mut v2 = timeline.add_video_track("V2");
+    v2.append_gap(Gap::new(RationalTime::new(24.0, 24.0))).unwrap();
+    v2.append_clip(clip("over", frames(0.0, 12.0), "/media/over.mov")).unwrap();
+
+    let manifest = timeline.render_manifest(frames(0.0, 48.0)).unwrap();
+    let names: Vec<_> = manifest
+        .runs()
+        .iter()
+        .map(|run| (run.frames.clone(), run.clip.as_ref().unwrap().name()))
+        .collect();
+    assert_eq!(
+        names,
+        vec![
+            (0..24, "base".to_string()),
+            (24..36, "over".to_string()),
+            (36..48, "base".to_string()),
+        ]
+    );
+    assert_eq!(manifest.runs()[2].source_start, 36.0);
+}
+
+// ============================================================================
+// Parallel builds
+// ============================================================================
+
+type RunSummary = (Range<u64>, Option<String>, f64, f64, Option<usize>, i64, Option<usize>, u32);
+
+fn summary(manifest: &RenderManifest<'_>) -> (Vec<RunSummary>, Vec<String>, Vec<Range<u64>>) {
+    let runs = manifest
+        .runs()
+        .iter()
+        .map(|run| {
+            (
+                run.frames.clone(),
+                run.clip.as_ref().map(otio_rs::ClipRef::name),
+                run.source_start,
+                run.source_step,
+                run.url_index,
+                run.url_step,
+                run.transition,
+                run.layer,
+            )
+        })
+        .collect();
+    let transitions = manifest.transitions().iter().map(|t| t.frames.clone()).collect();
+    (runs, manifest.urls().to_vec(), transitions)
+}
+
+/// Six tracks of staggered clips, dissolves, image sequences and gaps, over
+/// more than one block of frames. Also returns V3.
+fn layered_timeline() -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Layers");
+    let mut tracks = Vec::new();
+    for layer in 0..6u32 {
+        let mut track = timeline.add_video_track(&format!("V{}", layer + 1));
+        track.append_gap(Gap::new(RationalTime::new(f64::from(layer * 37), 24.0))).unwrap();
+        for shot in 0..120u32 {
+            let duration = f64::from(24 + (shot * 7 + layer * 5) % 60);
+            let name = format!("v{layer}_{shot}");
+            if shot % 3 == 0 {
+                let prefix = format!("{name}_");
+                let mut seq =
+                    ImageSequenceReference::new("/renders/", &prefix, ".exr", 1001, 1, 24.0, 4);
+                seq.set_available_range(frames(0.0, duration + 24.0)).unwrap();
+                let mut clip = Clip::new(&name, frames(12.0, duration));
+                clip.set_image_sequence_reference(seq).unwrap();
+                track.append_clip(clip).unwrap();
+            } else {
+                let url = format!("/media/{name}.mov");
+                track.append_clip(clip(&name, frames(100.0, duration), &url)).unwrap();
+            }
+            if shot % 4 == 1 {
+                let offset = RationalTime::new(6.0, 24.0);
+                track.append_transition(Transition::dissolve("Dissolve", offset, offset)).unwrap();
+            } else if (shot + layer) % 5 == 0 {
+                track.append_gap(Gap::new(RationalTime::new(30.0, 24.0))).unwrap();
+            }
+        }
+        tracks.push(track);
+    }
+    (timeline, tracks.swap_remove(2))
+}
+
+#[test]
+fn test_parallel_timeline_matches_serial() {
+    let (timeline, _v3) = layered_timeline();
+    let range = frames(0.0, 12000.0);
+    let serial = summary(&timeline.render_manifest(range).unwrap());
+    assert!(serial.0.len() > 100);
+    for threads in [0, 1, 2, 7] {
+        let parallel = timeline.render_manifest_parallel(range, threads).unwrap();
+        assert_eq!(parallel.frame_count(), 12000);
+        assert_eq!(summary(&parallel), serial, "threads = {threads}");
+    }
+}
+
+#[test]
+fn test_parallel_track_matches_serial() {
+    let (_timeline, track) = layered_timeline();
+    let range = frames(500.0, 9000.0);
+    let serial = summary(&track.render_manifest(range).unwrap());
+    assert_eq!(summary(&track.render_manifest_parallel(range, 4).unwrap()), serial);
+}
+
+#[test]
+fn test_parallel_build_of_empty_timeline() {
+    let timeline = Timeline::new("Empty");
+    let manifest = timeline.render_manifest_parallel(frames(0.0, 48.0), 4).unwrap();
+    assert_eq!(manifest.runs().len(), 1);
+    assert!(manifest.runs()[0].clip.is_none());
+    let range = TimeRange::new(RationalTime::new(0.0, 0.0), RationalTime::new(1.0, 24.0));
+    assert!(timeline.render_manifest_parallel(range, 4).is_err());
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+#[test]
+fn test_range_without_rate_is_an_error() {
+    let mut timeline = Timeline::new("Manifest");
+    let v1 = timeline.add_video_track("V1");
+    let range = TimeRange::new(RationalTime::new(0.0, 0.0), RationalTime::new(10.0, 24.0));
+    assert!(v1.render_manifest(range).is_err());
+}
@@ -0,0 +1,189 @@
+//! Tests for lazy filtered search.
+//!
+//! This file tests:
+//! - `Timeline::search()` type, name, metadata, URL and track kind filters
+//! - Range filtering and shallow searches
+//! - Behaviour when the tree is edited during a search
+
+use otio_rs::{
+    Clip, Composable, ExternalReference, Gap, HasMetadata, RationalTime, SearchFilter, Stack,
+    TimeRange, Timeline, Track,
+};
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn clip(name: &str, url: &str, duration: f64) -> Clip {
+    let mut clip = Clip::new(name, range(0.0, duration));
+    clip.set_media_reference(ExternalReference::new(url)).unwrap();
+    clip
+}
+
+fn names(timeline: &Timeline, filter: &SearchFilter) -> Vec<String> {
+    timeline
+        .search(filter)
+        .unwrap()
+        .map(|item| match item.unwrap() {
+            Composable::Clip(clip) => clip.name(),
+            Composable::Gap(_) => "<gap>".to_string(),
+            Composable::Transition(transition) => transition.name(),
+            Composable::Track(track) => track.name(),
+            Composable::Stack(stack) => stack.name(),
+        })
+        .collect()
+}
+
+/// V1: `shot_a` [0, 24), gap [24, 48), nested stack [48, 96) { `shot_b`, `shot_c` }
+/// A1: music [0, 96)
+fn sample_timeline() -> Timeline {
+    let mut timeline = Timeline::new("Search");
+    let mut v1 = timeline.add_video_track("V1");
+    let mut a = clip("shot_a", "/media/a.mov", 24.0);
+    a.set_metadata("reel", "A001");
+    v1.append_clip(a).unwrap();
+    v1.append_gap(Gap::new(RationalTime::new(24.0, 24.0))).unwrap();
+    let mut nested = Stack::new("Nested");
+    let mut b = clip("shot_b", "/media/b.mov", 48.0);
+    b.set_metadata("reel", "A002");
+    nested.append_clip(b).unwrap();
+    nested.append_clip(clip("shot_c", "/media/a.mov", 24.0)).unwrap();
+    v1.append_stack(nested).unwrap();
+
+    let mut a1 = timeline.add_audio_track("A1");
+    a1.append_clip(clip("music", "/media/music.wav", 96.0)).unwrap();
+    timeline
+}
+
+// ============================================================================
+// Predicates
+// ============================================================================
+
+#[test]
+fn test_default_filter_walks_depth_first() {
+    let timeline = sample_timeline();
+    assert_eq!(
+        names(&timeline, &SearchFilter::new()),
+        vec!["V1", "shot_a", "<gap>", "Nested", "shot_b", "shot_c", "A1", "music"]
+    );
+}
+
+#[test]
+fn test_type_filters_combine() {
+    let timeline = sample_timeline();
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().clips()),
+        vec!["shot_a", "shot_b", "shot_c", "music"]
+    );
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().tracks().stacks()),
+        vec!["V1", "Nested", "A1"]
+    );
+    assert_eq!(names(&timeline, &SearchFilter::new().gaps()), vec!["<gap>"]);
+}
+
+#[test]
+fn test_name_and_metadata_filters() {
+    let timeline = sample_timeline();
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().name_prefix("shot_")),
+        vec!["shot_a", "shot_b", "shot_c"]
+    );
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().metadata_key("reel")),
+        vec!["shot_a", "shot_b"]
+    );
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().metadata_eq("reel", "A002")),
+        vec!["shot_b"]
+    );
+    assert!(names(&timeline, &SearchFilter::new().metadata_eq("reel", "B001")).is_empty());
+}
+
+#[test]
+fn test_target_url_filter() {
+    let timeline = sample_timeline();
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().target_url("/media/a.mov")),
+        vec!["shot_a", "shot_c"]
+    );
+}
+
+#[test]
+fn test_track_kind_filter() {
+    let timeline = sample_timeline();
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().clips().track_kind(otio_rs::TrackKind::Audio)),
+        vec!["music"]
+    );
+    // Items in a nested stack belong to the enclosing track
+    assert_eq!(
+        names(&timeline, &SearchFilter::new().track_kind(otio_rs::TrackKind::Video)),
+        vec!["V1", "shot_a", "<gap>", "Nested", "shot_b", "shot_c"]
+    );
+}
+
+// ============================================================================
+// Range and depth
+// ============================================================================
+
+#[test]
+fn test_range_filter() {
+    let timeline = sample_timeline();
+    let filter = SearchFilter::new().clips().in_range(range(30.0, 10.0));
+    assert_eq!(names(&timeline, &filter), vec!["music"]);
+
+    // Children of the nested stack are in its coordinates, which start at 48
+    let filter = SearchFilter::new().clips().in_range(range(50.0, 4.0));
+    assert_eq!(names(&timeline, &filter), vec!["shot_b", "shot_c", "music"]);
+
+    // A zero-duration range is a point; ranges are half-open
+    let filter = SearchFilter::new().clips().in_range(range(24.0, 0.0));
+    assert_eq!(names(&timeline, &filter), vec!["music"]);
+}
+
+#[test]
+fn test_shallow_search() {
+    let timeline = sample_timeline();
+    assert_eq!(names(&timeline, &SearchFilter::new().shallow()), vec!["V1", "A1"]);
+
+    let mut track = Track::new_video("Standalone");
+    let mut nested = Stack::new("Nested");
+    nested.append_clip(clip("inner", "/media/i.mov", 24.0)).unwrap();
+    track.append_clip(clip("outer", "/media/o.mov", 24.0)).unwrap();
+    track.append_stack(nested).unwrap();
+    let found: Vec<_> = track
+        .search(&SearchFilter::new().clips().shallow())
+        .unwrap()
+        .map(|item| match item.unwrap() {
+            Composable::Clip(clip) => clip.name(),
+            _ => unreachable!(),
+        })
+        .collect();
+    assert_eq!(found, vec!["outer"]);
+    // The finished search borrowed the standalone track; it did not own it
+    assert_eq!(track.children_count(), 2);
+}
+
+// ============================================================================
+// Edits during a search
+// ============================================================================
+
+#[test]
+fn test_edit_during_search_ends_with_error() {
+    let mut timeline = Timeline::new("Edited");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(clip("first", "/media/1.mov", 24.0)).unwrap();
+    v1.append_clip(clip("second", "/media/2.mov", 24.0)).unwrap();
+
+    let filter = SearchFilter::new().clips();
+    let mut search = timeline.search(&filter).unwrap();
+    assert!(search.next().unwrap().is_ok());
+
+    v1.append_clip(clip("third", "/media/3.mov", 24.0)).unwrap();
+    assert!(search.next().unwrap().is_err());
+    assert!(search.next().is_none());
+
+    search.reset();
+    assert_eq!(search.filter_map(Result::ok).count(), 3);
+}
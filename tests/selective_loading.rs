@@ -0,0 +1,213 @@
+//! Tests for selective timeline loading.
+//!
+//! This file tests:
+//! - `LoadFilter` track kind / index / schema selection
+//! - `LazyTimeline::hydrate_track()`
+//! - `LazyTimeline::into_timeline()`
+//! - `LazyTimeline::timeline_mut()`
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use otio_rs::{
+    Clip, HasMetadata, LazyTimeline, LoadFilter, Marker, RationalTime, TimeRange, Timeline,
+    TrackKind,
+};
+use tempfile::NamedTempFile;
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+/// V1 with two clips (one with a marker), A1 with three clips.
+fn sample_json() -> String {
+    let mut timeline = Timeline::new("Selective");
+    timeline.set_metadata("show", "demo");
+
+    let mut v1 = timeline.add_video_track("V1");
+    let mut clip = Clip::new("V Clip 1", range(0.0, 24.0));
+    clip.add_marker(Marker::with_default_color("Note", range(0.0, 1.0)))
+        .unwrap();
+    v1.append_clip(clip).unwrap();
+    v1.append_clip(Clip::new("V Clip 2", range(0.0, 24.0))).unwrap();
+
+    let mut a1 = timeline.add_audio_track("A1");
+    a1.set_metadata("channel", "stereo");
+    for i in 0..3 {
+        a1.append_clip(Clip::new(&format!("A Clip {i}"), range(0.0, 12.0)))
+            .unwrap();
+    }
+
+    timeline.to_json_string().unwrap()
+}
+
+fn children_counts(lazy: &LazyTimeline) -> Vec<usize> {
+    lazy.timeline()
+        .tracks()
+        .children()
+        .map(|child| match child {
+            otio_rs::Composable::Track(track) => track.children_count(),
+            _ => panic!("expected a track"),
+        })
+        .collect()
+}
+
+// ============================================================================
+// Filtering
+// ============================================================================
+
+#[test]
+fn test_default_filter_loads_everything() {
+    let json = sample_json();
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &LoadFilter::new()).unwrap();
+    assert_eq!(lazy.pending_count(), 0);
+    assert_eq!(children_counts(&lazy), vec![2, 3]);
+    assert!(lazy.is_track_loaded(0));
+    assert!(lazy.is_track_loaded(1));
+    assert!(!lazy.is_track_loaded(2));
+}
+
+#[test]
+fn test_filter_by_track_kind_keeps_shells() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_kind(TrackKind::Video);
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+
+    assert_eq!(lazy.pending_count(), 1);
+    assert_eq!(children_counts(&lazy), vec![2, 0]);
+    assert!(!lazy.is_track_loaded(1));
+
+    // Top-level data and the skipped track's own fields are still there.
+    let timeline = lazy.timeline();
+    assert_eq!(timeline.name(), "Selective");
+    assert_eq!(timeline.metadata_str("show").as_deref(), Some("demo"));
+    let audio = timeline.audio_tracks().next().unwrap();
+    assert_eq!(audio.name(), "A1");
+    assert_eq!(audio.metadata_str("channel").as_deref(), Some("stereo"));
+}
+
+#[test]
+fn test_filter_by_empty_index_list_skips_all_children() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_indices(&[]);
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    assert_eq!(lazy.pending_count(), 2);
+    assert_eq!(children_counts(&lazy), vec![0, 0]);
+    assert_eq!(lazy.timeline().video_tracks().count(), 1);
+}
+
+#[test]
+fn test_filter_index_and_kind_combine() {
+    let json = sample_json();
+    // Index 1 is the audio track, which the kind filter excludes.
+    let filter = LoadFilter::new().track_indices(&[1]).track_kind(TrackKind::Video);
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    assert_eq!(children_counts(&lazy), vec![0, 0]);
+}
+
+#[test]
+fn test_skip_schema_drops_markers() {
+    let json = sample_json();
+    assert!(json.contains("Marker."));
+
+    let filter = LoadFilter::new().skip_schema("Marker");
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    assert_eq!(children_counts(&lazy), vec![2, 3]);
+    let reserialized = lazy.into_timeline().to_json_string().unwrap();
+    assert!(!reserialized.contains("Marker."));
+    assert!(reserialized.contains("V Clip 1"));
+}
+
+// ============================================================================
+// Hydration
+// ============================================================================
+
+#[test]
+fn test_hydrate_pending_track() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_kind(TrackKind::Video);
+    let mut lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+
+    lazy.hydrate_track(1).unwrap();
+    assert_eq!(lazy.pending_count(), 0);
+    assert!(lazy.is_track_loaded(1));
+    assert_eq!(children_counts(&lazy), vec![2, 3]);
+
+    let names: Vec<_> = lazy.timeline().find_clips().map(|c| c.name()).collect();
+    assert_eq!(names, vec!["V Clip 1", "V Clip 2", "A Clip 0", "A Clip 1", "A Clip 2"]);
+
+    // Hydrating a loaded track is a no-op.
+    lazy.hydrate_track(0).unwrap();
+    lazy.hydrate_track(1).unwrap();
+    assert_eq!(children_counts(&lazy), vec![2, 3]);
+}
+
+#[test]
+fn test_hydrate_applies_schema_filter() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_indices(&[]).skip_schema("Marker.2");
+    let mut lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    lazy.hydrate_track(0).unwrap();
+    let reserialized = lazy.into_timeline().to_json_string().unwrap();
+    assert!(reserialized.contains("V Clip 1"));
+    assert!(!reserialized.contains("Marker."));
+}
+
+#[test]
+fn test_hydrate_out_of_bounds() {
+    let json = sample_json();
+    let mut lazy = LazyTimeline::from_json_slice(json.as_bytes(), &LoadFilter::new()).unwrap();
+    assert!(lazy.hydrate_track(5).is_err());
+}
+
+#[test]
+fn test_into_timeline_outlives_lazy_handle() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_kind(TrackKind::Audio);
+    let lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    let timeline = lazy.into_timeline();
+    assert_eq!(timeline.find_clips().count(), 3);
+    assert_eq!(timeline.video_tracks().next().unwrap().children_count(), 0);
+}
+
+#[test]
+fn test_timeline_mut_edits_in_place() {
+    let json = sample_json();
+    let filter = LoadFilter::new().track_kind(TrackKind::Audio);
+    let mut lazy = LazyTimeline::from_json_slice(json.as_bytes(), &filter).unwrap();
+    {
+        let mut timeline = lazy.timeline_mut();
+        timeline.set_metadata("status", "review");
+        let mut v2 = timeline.add_video_track("V2");
+        v2.append_clip(Clip::new("Added", range(0.0, 24.0))).unwrap();
+        assert_eq!(timeline.find_clips().count(), 4);
+    }
+    assert_eq!(lazy.timeline().get_metadata("status"), Some("review".to_string()));
+    // The pending V1 is untouched and still hydrates
+    lazy.hydrate_track(0).unwrap();
+    assert_eq!(lazy.timeline().find_clips().count(), 6);
+}
+
+// ============================================================================
+// Input handling
+// ============================================================================
+
+#[test]
+fn test_read_from_file() {
+    let json = sample_json();
+    let file = NamedTempFile::with_suffix(".otio").unwrap();
+    std::fs::write(file.path(), &json).unwrap();
+
+    let filter = LoadFilter::new().track_kind(TrackKind::Video);
+    let lazy = LazyTimeline::read_from_file(file.path(), &filter).unwrap();
+    assert_eq!(children_counts(&lazy), vec![2, 0]);
+}
+
+#[test]
+fn test_malformed_input() {
+    let filter = LoadFilter::new().track_kind(TrackKind::Video);
+    assert!(LazyTimeline::from_json_slice(b"{\"OTIO_SCHEMA\": \"Timeline.1\", ", &filter).is_err());
+    assert!(LazyTimeline::from_json_slice(b"", &filter).is_err());
+    assert!(LazyTimeline::from_json_slice(br#"{"OTIO_SCHEMA": "Clip.2"}"#, &filter).is_err());
+    assert!(LazyTimeline::read_from_file("/nonexistent/file.otio".as_ref(), &filter).is_err());
+}
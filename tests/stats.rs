@@ -0,0 +1,88 @@
+//! Tests for the shim's hot-path counters.
+//!
+//! This file tests:
+//! - `ShimStats::snapshot()` matching how the shim was built
+//! - Counts of parse, serialize, iteration, range and edit calls
+//! - `ShimStats::reset()`
+
+use otio_rs::{Clip, RationalTime, ShimStats, TimeRange, Timeline, Track};
+
+#[cfg_attr(not(feature = "stats"), allow(dead_code))]
+fn sample_timeline(clips: usize) -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Counted");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..clips {
+        v1.append_clip(Clip::new(
+            &format!("shot_{i}"),
+            TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+        ))
+        .unwrap();
+    }
+    (timeline, v1)
+}
+
+#[test]
+fn test_snapshot_matches_build() {
+    let snapshot = ShimStats::snapshot();
+    assert_eq!(ShimStats::supported(), cfg!(feature = "stats"));
+    if ShimStats::supported() {
+        let names: Vec<&str> = snapshot.stats().iter().map(|stat| stat.name).collect();
+        assert_eq!(
+            names,
+            [
+                "parse",
+                "serialize",
+                "binary",
+                "iterate",
+                "range",
+                "transformed_time",
+                "edit",
+                "dynamic_cast",
+                "strdup",
+                "exception",
+            ]
+        );
+    } else {
+        assert!(snapshot.stats().is_empty());
+        assert!(snapshot.get("parse").is_none());
+    }
+}
+
+#[cfg(feature = "stats")]
+mod counted {
+    use super::*;
+
+    fn calls(snapshot: &ShimStats, name: &str) -> u64 {
+        snapshot.get(name).unwrap().calls
+    }
+
+    // Other tests of this binary run alongside, so counts are compared as
+    // lower bounds; only this test resets.
+    #[test]
+    fn test_hot_paths_are_counted() {
+        let (timeline, mut v1) = sample_timeline(20);
+        let before = ShimStats::snapshot();
+
+        let json = timeline.to_json_string().unwrap();
+        let parsed = Timeline::from_json_string(&json).unwrap();
+        assert_eq!(parsed.find_clips().count(), 20);
+        let track = parsed.video_tracks().next().unwrap();
+        for i in 0..track.children_count() {
+            let _ = track.range_of_child_at_index(i).unwrap();
+        }
+        v1.slice_at_time(RationalTime::new(12.0, 24.0), false).unwrap();
+
+        let after = ShimStats::snapshot();
+        for name in ["parse", "serialize", "iterate", "edit"] {
+            assert!(calls(&after, name) > calls(&before, name), "{name}");
+        }
+        assert!(calls(&after, "range") >= calls(&before, "range") + 20);
+        let parse = after.get("parse").unwrap();
+        assert!(parse.bytes >= json.len() as u64);
+        assert!(parse.nanoseconds > 0);
+
+        ShimStats::reset();
+        let reset = ShimStats::snapshot();
+        assert!(calls(&reset, "parse") < calls(&after, "parse"));
+    }
+}
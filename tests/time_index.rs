@@ -0,0 +1,220 @@
+//! Tests for time-to-item queries.
+//!
+//! This file tests:
+//! - `Track::build_time_index()` point and range queries
+//! - `Timeline::build_time_index()` across tracks
+//! - Index invalidation after edits
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use otio_rs::{Clip, Composable, Gap, RationalTime, TimeIndexHit, TimeRange, Timeline, Track, Transition};
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn at(frame: f64) -> RationalTime {
+    RationalTime::new(frame, 24.0)
+}
+
+fn names(hits: &[TimeIndexHit<'_>]) -> Vec<String> {
+    hits.iter()
+        .map(|hit| match &hit.item {
+            Composable::Clip(clip) => clip.name(),
+            Composable::Gap(_) => "<gap>".to_string(),
+            Composable::Transition(transition) => transition.name(),
+            Composable::Track(track) => track.name(),
+            Composable::Stack(stack) => stack.name(),
+        })
+        .collect()
+}
+
+/// A [0, 48), gap [48, 72), B [72, 96)
+fn sample_track() -> Track {
+    let mut track = Track::new_video("V1");
+    track.append_clip(Clip::new("A", range(0.0, 48.0))).unwrap();
+    track.append_gap(Gap::new(at(24.0))).unwrap();
+    track.append_clip(Clip::new("B", range(10.0, 24.0))).unwrap();
+    track
+}
+
+/// The track of `sample_track` in a timeline, and a handle to edit it with
+/// while an index borrows the timeline
+fn sample_timeline() -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Edited");
+    let mut track = timeline.add_video_track("V1");
+    track.append_clip(Clip::new("A", range(0.0, 48.0))).unwrap();
+    track.append_gap(Gap::new(at(24.0))).unwrap();
+    track.append_clip(Clip::new("B", range(10.0, 24.0))).unwrap();
+    (timeline, track)
+}
+
+// ============================================================================
+// Track queries
+// ============================================================================
+
+#[test]
+fn test_point_query() {
+    let track = sample_track();
+    let index = track.build_time_index().unwrap();
+
+    let hits = index.query(at(10.0)).unwrap();
+    assert_eq!(names(&hits), vec!["A"]);
+    assert_eq!(hits[0].child_index, 0);
+    assert_eq!(hits[0].track_index, None);
+    assert_eq!(hits[0].range.duration.value, 48.0);
+
+    assert_eq!(names(&index.query(at(50.0)).unwrap()), vec!["<gap>"]);
+
+    let hits = index.query(at(80.0)).unwrap();
+    assert_eq!(names(&hits), vec!["B"]);
+    assert_eq!(hits[0].child_index, 2);
+    assert_eq!(hits[0].range.start_time.value, 72.0);
+}
+
+#[test]
+fn test_point_query_boundaries() {
+    let track = sample_track();
+    let index = track.build_time_index().unwrap();
+
+    // Ranges are half-open: an item ends where the next one starts
+    assert_eq!(names(&index.query(at(48.0)).unwrap()), vec!["<gap>"]);
+    assert_eq!(names(&index.query(at(0.0)).unwrap()), vec!["A"]);
+    assert!(index.query(at(96.0)).unwrap().is_empty());
+    assert!(index.query(at(-1.0)).unwrap().is_empty());
+}
+
+#[test]
+fn test_range_query() {
+    let track = sample_track();
+    let index = track.build_time_index().unwrap();
+
+    assert_eq!(names(&index.query_range(range(40.0, 40.0)).unwrap()), vec!["A", "<gap>", "B"]);
+    assert_eq!(names(&index.query_range(range(48.0, 24.0)).unwrap()), vec!["<gap>"]);
+    assert!(index.query_range(range(100.0, 10.0)).unwrap().is_empty());
+    // Zero duration behaves like a point query
+    assert_eq!(names(&index.query_range(range(72.0, 0.0)).unwrap()), vec!["B"]);
+}
+
+#[test]
+fn test_query_with_transition() {
+    let mut track = Track::new_video("V1");
+    track.append_clip(Clip::new("A", range(0.0, 48.0))).unwrap();
+    track
+        .append_transition(Transition::dissolve("Dissolve", at(12.0), at(12.0)))
+        .unwrap();
+    track.append_clip(Clip::new("B", range(0.0, 48.0))).unwrap();
+    let index = track.build_time_index().unwrap();
+
+    // The transition spans [36, 60) around the cut at 48
+    assert_eq!(names(&index.query(at(40.0)).unwrap()), vec!["A", "Dissolve"]);
+    assert_eq!(names(&index.query(at(50.0)).unwrap()), vec!["Dissolve", "B"]);
+    assert_eq!(names(&index.query(at(70.0)).unwrap()), vec!["B"]);
+}
+
+#[test]
+fn test_many_hits_grow_buffer() {
+    let mut timeline = Timeline::new("Wide");
+    for i in 0..40 {
+        let mut track = timeline.add_video_track(&format!("V{i}"));
+        track.append_clip(Clip::new(&format!("Clip {i}"), range(0.0, 24.0))).unwrap();
+    }
+    let index = timeline.build_time_index().unwrap();
+    let hits = index.query(at(12.0)).unwrap();
+    assert_eq!(hits.len(), 40);
+    let tracks: Vec<_> = hits.iter().map(|hit| hit.track_index.unwrap()).collect();
+    assert_eq!(tracks, (0..40).collect::<Vec<_>>());
+}
+
+// ============================================================================
+// Timeline queries
+// ============================================================================
+
+#[test]
+fn test_timeline_query_reports_tracks() {
+    let mut timeline = Timeline::new("Index");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(Clip::new("V A", range(0.0, 48.0))).unwrap();
+    v1.append_clip(Clip::new("V B", range(0.0, 48.0))).unwrap();
+    let mut a1 = timeline.add_audio_track("A1");
+    a1.append_gap(Gap::new(at(24.0))).unwrap();
+    a1.append_clip(Clip::new("A A", range(0.0, 96.0))).unwrap();
+
+    let index = timeline.build_time_index().unwrap();
+    let hits = index.query(at(60.0)).unwrap();
+    assert_eq!(names(&hits), vec!["A A", "V B"]);
+    assert_eq!(hits[0].track_index, Some(1));
+    assert_eq!(hits[0].child_index, 1);
+    assert_eq!(hits[1].track_index, Some(0));
+    assert_eq!(hits[1].range.start_time.value, 48.0);
+}
+
+#[test]
+fn test_empty_timeline_index() {
+    let timeline = Timeline::new("Empty");
+    let index = timeline.build_time_index().unwrap();
+    assert!(index.query(at(0.0)).unwrap().is_empty());
+}
+
+// ============================================================================
+// Invalidation
+// ============================================================================
+
+#[test]
+fn test_index_rebuilds_after_append_and_remove() {
+    let (timeline, mut track) = sample_timeline();
+    let v1 = timeline.video_tracks().next().unwrap();
+    let index = v1.build_time_index().unwrap();
+    assert!(index.query(at(100.0)).unwrap().is_empty());
+
+    track.append_clip(Clip::new("C", range(0.0, 24.0))).unwrap();
+    assert_eq!(names(&index.query(at(100.0)).unwrap()), vec!["C"]);
+
+    track.remove_child(0).unwrap();
+    assert_eq!(names(&index.query(at(10.0)).unwrap()), vec!["<gap>"]);
+    assert_eq!(names(&index.query(at(30.0)).unwrap()), vec!["B"]);
+}
+
+#[test]
+fn test_index_rebuilds_after_insert_and_clear() {
+    let (timeline, mut track) = sample_timeline();
+    let v1 = timeline.video_tracks().next().unwrap();
+    let index = v1.build_time_index().unwrap();
+
+    track.insert_clip(0, Clip::new("First", range(0.0, 12.0))).unwrap();
+    assert_eq!(names(&index.query(at(6.0)).unwrap()), vec!["First"]);
+    assert_eq!(names(&index.query(at(12.0)).unwrap()), vec!["A"]);
+
+    track.clear_children().unwrap();
+    assert!(index.query(at(6.0)).unwrap().is_empty());
+}
+
+#[test]
+fn test_timeline_index_sees_nested_edits() {
+    let mut timeline = Timeline::new("Nested");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(Clip::new("A", range(0.0, 24.0))).unwrap();
+    let mut a1 = timeline.add_audio_track("A1");
+    let index = timeline.build_time_index().unwrap();
+    assert!(index.query(at(30.0)).unwrap().is_empty());
+
+    // Edits to a track are reported to indexes on the timeline's stack
+    v1.append_clip(Clip::new("B", range(0.0, 24.0))).unwrap();
+    assert_eq!(names(&index.query(at(30.0)).unwrap()), vec!["B"]);
+
+    a1.append_clip(Clip::new("Audio", range(0.0, 48.0))).unwrap();
+    assert_eq!(names(&index.query(at(30.0)).unwrap()), vec!["Audio", "B"]);
+}
+
+#[test]
+fn test_index_rebuilds_after_edit_algorithm() {
+    let (timeline, mut track) = sample_timeline();
+    let v1 = timeline.video_tracks().next().unwrap();
+    let index = v1.build_time_index().unwrap();
+
+    track
+        .overwrite(Clip::new("Over", range(0.0, 24.0)), range(48.0, 24.0), false)
+        .unwrap();
+    assert_eq!(names(&index.query(at(50.0)).unwrap()), vec!["Over"]);
+}
@@ -0,0 +1,84 @@
+//! Tests for time coordinate transforms.
+//!
+//! This file tests:
+//! - `ClipRef::transformed_times_to_track()` against the single-time transform
+//! - `TrackRef::transformed_times_to_clip()` / `transformed_frames_to_clip()`
+//! - Empty batches
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use otio_rs::{Clip, ClipRef, Composable, RationalTime, TimeRange, Timeline, TrackRef};
+
+/// V1: "a" (source 0..48) then "b" (source 100..148), both at 24 fps.
+fn sample_timeline() -> Timeline {
+    let mut timeline = Timeline::new("Transforms");
+    let mut v1 = timeline.add_video_track("V1");
+    v1.append_clip(Clip::new(
+        "a",
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+    ))
+    .unwrap();
+    v1.append_clip(Clip::new(
+        "b",
+        TimeRange::new(RationalTime::new(100.0, 24.0), RationalTime::new(48.0, 24.0)),
+    ))
+    .unwrap();
+    timeline
+}
+
+fn second_clip<'a>(track: &'a TrackRef<'_>) -> ClipRef<'a> {
+    match track.children().nth(1) {
+        Some(Composable::Clip(clip)) => clip,
+        _ => panic!("expected a clip"),
+    }
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+#[test]
+fn test_clip_to_track_batch_matches_single() {
+    let timeline = sample_timeline();
+    let track = timeline.video_tracks().next().unwrap();
+    let clip = second_clip(&track);
+
+    let times: Vec<_> = (100..148).map(|frame| RationalTime::new(f64::from(frame), 24.0)).collect();
+    let batch = clip.transformed_times_to_track(&times, &track).unwrap();
+    assert_eq!(batch.len(), times.len());
+    for (time, result) in times.iter().zip(&batch) {
+        assert_eq!(*result, clip.transformed_time_to_track(*time, &track).unwrap());
+    }
+    assert_eq!(batch[0], RationalTime::new(48.0, 24.0));
+}
+
+#[test]
+fn test_track_to_clip_frames() {
+    let timeline = sample_timeline();
+    let track = timeline.video_tracks().next().unwrap();
+    let clip = second_clip(&track);
+
+    let source = track.transformed_frames_to_clip(RationalTime::new(48.0, 24.0), 48, &clip).unwrap();
+    assert_eq!(source.len(), 48);
+    assert_eq!(source[0], RationalTime::new(100.0, 24.0));
+    assert_eq!(source[47], RationalTime::new(147.0, 24.0));
+
+    let times = [RationalTime::new(60.0, 24.0), RationalTime::new(2.5, 1.0)];
+    let mapped = track.transformed_times_to_clip(&times, &clip).unwrap();
+    assert_eq!(mapped[0], RationalTime::new(112.0, 24.0));
+    // 2.5 s is frame 60 of the track; the result takes the higher rate
+    assert_eq!(mapped[1], RationalTime::new(112.0, 24.0));
+}
+
+#[test]
+fn test_empty_batch() {
+    let timeline = sample_timeline();
+    let track = timeline.video_tracks().next().unwrap();
+    let clip = second_clip(&track);
+    assert!(track.transformed_times_to_clip(&[], &clip).unwrap().is_empty());
+    assert!(track
+        .transformed_frames_to_clip(RationalTime::new(0.0, 24.0), 0, &clip)
+        .unwrap()
+        .is_empty());
+}
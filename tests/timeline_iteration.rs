@@ -2,9 +2,11 @@
 //!
 //! This file tests:
 //! - `Clip::available_range()`
-//! - `Timeline::video_tracks()` / `audio_tracks()`
+//! - `Timeline::video_tracks()` / `audio_tracks()` and their `_into` variants
+//! - `find_clips_into()` on timelines, tracks and stacks
 //! - `Track::neighbors_of()` with `NeighborGapPolicy`
 //! - Clip multi-reference support
+//! - `Timeline::flatten_items()`
 
 // Allow exact float comparisons in tests - values are known exactly
 #![allow(clippy::float_cmp)]
@@ -13,7 +15,7 @@
 
 use otio_rs::{
     Clip, Composable, ExternalReference, Gap, MissingReference, NeighborGapPolicy,
-    RationalTime, TimeRange, Timeline, TrackKind,
+    RationalTime, Stack, TimeRange, Timeline, TrackKind,
 };
 
 // ============================================================================
@@ -161,6 +163,55 @@ fn test_timeline_track_iterator_names() {
     assert!(names.contains(&"V2".to_string()));
 }
 
+#[test]
+fn test_timeline_tracks_into_match_iterators() {
+    let mut timeline = Timeline::new("Test");
+    let _ = timeline.add_video_track("V1");
+    let _ = timeline.add_audio_track("A1");
+    let _ = timeline.add_video_track("V2");
+
+    let mut tracks = Vec::new();
+    timeline.video_tracks_into(&mut tracks).unwrap();
+    let names: Vec<_> = tracks.iter().map(otio_rs::TrackRef::name).collect();
+    assert_eq!(names, timeline.video_tracks().map(|t| t.name()).collect::<Vec<_>>());
+
+    // The vector is replaced, not appended to
+    timeline.audio_tracks_into(&mut tracks).unwrap();
+    assert_eq!(tracks.len(), 1);
+    assert_eq!(tracks[0].name(), "A1");
+}
+
+#[test]
+fn test_find_clips_into_reuses_buffer() {
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+    let mut timeline = Timeline::new("Test");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..40 {
+        v1.append_clip(Clip::new(&format!("clip_{i}"), range)).unwrap();
+    }
+    v1.append_gap(Gap::new(RationalTime::new(12.0, 24.0))).unwrap();
+    let mut nested = Stack::new("Nested");
+    nested.append_clip(Clip::new("inner", range)).unwrap();
+    v1.append_stack(nested).unwrap();
+
+    let mut clips = Vec::new();
+    timeline.find_clips_into(&mut clips).unwrap();
+    assert_eq!(clips.len(), 41);
+    assert_eq!(clips[0].name(), "clip_0");
+    assert_eq!(clips[40].name(), "inner");
+    let names: Vec<_> = clips.iter().map(otio_rs::ClipRef::name).collect();
+    assert_eq!(names, timeline.find_clips().map(|c| c.name()).collect::<Vec<_>>());
+
+    let capacity = clips.capacity();
+    timeline.find_clips_into(&mut clips).unwrap();
+    assert_eq!(clips.len(), 41);
+    assert_eq!(clips.capacity(), capacity);
+
+    // A track only reports its direct children
+    v1.find_clips_into(&mut clips).unwrap();
+    assert_eq!(clips.len(), 40);
+}
+
 // ============================================================================
 // Track::neighbors_of() Tests
 // ============================================================================
@@ -623,3 +674,112 @@ fn test_schema_version_write_to_file() {
     // Clean up
     let _ = std::fs::remove_file(&path);
 }
+
+// ============================================================================
+// Timeline::flatten_items() Tests
+// ============================================================================
+
+#[test]
+fn test_flatten_items_empty_timeline() {
+    let timeline = Timeline::new("Empty");
+    let flat = timeline.flatten_items().unwrap();
+    assert!(flat.is_empty());
+    assert_eq!(flat.iter().count(), 0);
+}
+
+#[test]
+fn test_flatten_items_track_children_ranges() {
+    let mut timeline = Timeline::new("Flat");
+    let mut track = timeline.add_video_track("V1");
+    track
+        .append_clip(Clip::new(
+            "A",
+            TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+        ))
+        .unwrap();
+    track.append_gap(Gap::new(RationalTime::new(24.0, 24.0))).unwrap();
+    track
+        .append_clip(Clip::new(
+            "B",
+            TimeRange::new(RationalTime::new(10.0, 24.0), RationalTime::new(24.0, 24.0)),
+        ))
+        .unwrap();
+
+    let flat = timeline.flatten_items().unwrap();
+    assert_eq!(flat.len(), 4);
+
+    let entries: Vec<_> = flat.iter().collect();
+    assert!(matches!(entries[0].item, Composable::Track(_)));
+    assert_eq!(entries[0].depth, 0);
+    assert_eq!(entries[0].parent_index, None);
+    assert_eq!(entries[0].range.duration.value, 96.0);
+
+    let starts: Vec<f64> = entries[1..].iter().map(|e| e.range.start_time.value).collect();
+    assert_eq!(starts, vec![0.0, 48.0, 72.0]);
+    for entry in &entries[1..] {
+        assert_eq!(entry.depth, 1);
+        assert_eq!(entry.parent_index, Some(0));
+    }
+    assert!(matches!(entries[2].item, Composable::Gap(_)));
+    match &entries[3].item {
+        Composable::Clip(clip) => assert_eq!(clip.name(), "B"),
+        other => panic!("expected clip, got {other:?}"),
+    }
+
+    // Matches the per-child range query.
+    assert_eq!(
+        entries[3].range.start_time.value,
+        track.range_of_child_at_index(2).unwrap().start_time.value
+    );
+}
+
+#[test]
+fn test_flatten_items_nested_stack_offset() {
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(24.0, 24.0));
+    let mut timeline = Timeline::new("Nested");
+    let mut track = timeline.add_video_track("V1");
+    track.append_clip(Clip::new("Lead", range)).unwrap();
+
+    let mut stack = Stack::new("Inner");
+    stack
+        .append_clip(Clip::new(
+            "Layer",
+            TimeRange::new(RationalTime::new(100.0, 24.0), RationalTime::new(12.0, 24.0)),
+        ))
+        .unwrap();
+    track.append_stack(stack).unwrap();
+    let _ = timeline.add_audio_track("A1");
+
+    let flat = timeline.flatten_items().unwrap();
+    let entries: Vec<_> = flat.iter().collect();
+    // V1, Lead, Inner, Layer, A1
+    assert_eq!(entries.len(), 5);
+    assert_eq!(
+        entries.iter().map(|e| e.depth).collect::<Vec<_>>(),
+        vec![0, 1, 1, 2, 0]
+    );
+    assert_eq!(entries[3].parent_index, Some(2));
+    assert_eq!(entries[4].parent_index, None);
+
+    // The stack starts after the lead clip, so its child does too.
+    assert!(matches!(entries[2].item, Composable::Stack(_)));
+    assert_eq!(entries[2].range.start_time.value, 24.0);
+    assert_eq!(entries[3].range.start_time.value, 24.0);
+    assert_eq!(entries[3].range.duration.value, 12.0);
+}
+
+#[test]
+fn test_flatten_items_grows_past_initial_capacity() {
+    let range = TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(2.0, 24.0));
+    let mut timeline = Timeline::new("Long");
+    let mut track = timeline.add_video_track("V1");
+    for i in 0..600 {
+        track.append_clip(Clip::new(&format!("clip_{i}"), range)).unwrap();
+    }
+
+    let flat = timeline.flatten_items().unwrap();
+    assert_eq!(flat.len(), 601);
+    let last = flat.get(600).unwrap();
+    assert_eq!(last.range.start_time.value, 1198.0);
+    assert!(flat.get(601).is_none());
+}
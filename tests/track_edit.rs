@@ -0,0 +1,206 @@
+//! Tests for transactional track edits.
+//!
+//! This file tests:
+//! - `Track::begin_edit()` and `TrackEdit::commit()` matching the same edits
+//!   made one at a time
+//! - Time-ordered batches applied in one pass
+//! - Rollback when an edit fails, and discarding uncommitted edits
+//! - Range caches and change tracking seeing the committed batch
+
+// Allow exact float comparisons in tests - values are known exactly
+#![allow(clippy::float_cmp)]
+
+use otio_rs::{Clip, RationalTime, TimeRange, Timeline, Track};
+
+fn range(start: f64, duration: f64) -> TimeRange {
+    TimeRange::new(RationalTime::new(start, 24.0), RationalTime::new(duration, 24.0))
+}
+
+fn time(value: f64) -> RationalTime {
+    RationalTime::new(value, 24.0)
+}
+
+fn sample_timeline(clips: usize) -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Conform");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..clips {
+        v1.append_clip(Clip::new(&format!("shot_{i}"), range(0.0, 48.0))).unwrap();
+    }
+    (timeline, v1)
+}
+
+/// The edits of a small conform script, as plain calls or queued.
+fn conform_one_at_a_time(track: &mut Track) {
+    track.overwrite(Clip::new("fix_0", range(0.0, 12.0)), range(30.0, 12.0), false).unwrap();
+    track.insert_at_time(Clip::new("insert_0", range(0.0, 24.0)), time(100.0), false).unwrap();
+    track.slice_at_time(time(150.0), false).unwrap();
+    track.remove_at_time(time(10.0), true).unwrap();
+    track.overwrite(Clip::new("fix_1", range(5.0, 30.0)), range(200.0, 30.0), false).unwrap();
+    track.remove_at_time(time(250.0), false).unwrap();
+}
+
+fn conform_in_batch(track: &mut Track) {
+    let mut edit = track.begin_edit().unwrap();
+    edit.overwrite(Clip::new("fix_0", range(0.0, 12.0)), range(30.0, 12.0), false).unwrap();
+    edit.insert_at_time(Clip::new("insert_0", range(0.0, 24.0)), time(100.0), false).unwrap();
+    edit.slice_at_time(time(150.0), false).unwrap();
+    edit.remove_at_time(time(10.0), true).unwrap();
+    edit.overwrite(Clip::new("fix_1", range(5.0, 30.0)), range(200.0, 30.0), false).unwrap();
+    edit.remove_at_time(time(250.0), false).unwrap();
+    assert_eq!(edit.len(), 6);
+    edit.commit().unwrap();
+    assert!(edit.is_empty());
+}
+
+// ============================================================================
+// Commits
+// ============================================================================
+
+#[test]
+fn test_batch_matches_single_edits() {
+    let (single, mut single_v1) = sample_timeline(8);
+    let (batched, mut batched_v1) = sample_timeline(8);
+    conform_one_at_a_time(&mut single_v1);
+
+    let before = batched.to_json_string().unwrap();
+    {
+        // Nothing changes until the commit
+        let mut edit = batched_v1.begin_edit().unwrap();
+        edit.slice_at_time(time(24.0), false).unwrap();
+        assert_eq!(batched.to_json_string().unwrap(), before);
+    }
+    assert_eq!(batched.to_json_string().unwrap(), before);
+
+    conform_in_batch(&mut batched_v1);
+    assert_eq!(batched.to_json_string().unwrap(), single.to_json_string().unwrap());
+}
+
+#[test]
+fn test_time_ordered_batch_matches_single_edits() {
+    let (single, mut single_v1) = sample_timeline(200);
+    let (batched, mut batched_v1) = sample_timeline(200);
+    let mut edit = batched_v1.begin_edit().unwrap();
+    for shot in 0..100 {
+        let at = f64::from(shot) * 96.0;
+        let fix = || Clip::new(&format!("fix_{shot}"), range(0.0, 12.0));
+        single_v1.overwrite(fix(), range(at + 30.0, 12.0), false).unwrap();
+        edit.overwrite(fix(), range(at + 30.0, 12.0), false).unwrap();
+        single_v1.slice_at_time(time(at + 60.0), false).unwrap();
+        edit.slice_at_time(time(at + 60.0), false).unwrap();
+        if shot % 10 == 0 {
+            let insert = || Clip::new(&format!("insert_{shot}"), range(0.0, 24.0));
+            single_v1.insert_at_time(insert(), time(at + 90.0), false).unwrap();
+            edit.insert_at_time(insert(), time(at + 90.0), false).unwrap();
+            single_v1.remove_at_time(time(at + 95.0), true).unwrap();
+            edit.remove_at_time(time(at + 95.0), true).unwrap();
+        }
+    }
+    // Past the end of the track
+    single_v1.overwrite(Clip::new("tail", range(0.0, 24.0)), range(20000.0, 24.0), false).unwrap();
+    edit.overwrite(Clip::new("tail", range(0.0, 24.0)), range(20000.0, 24.0), false).unwrap();
+    edit.commit().unwrap();
+    drop(edit);
+    assert_eq!(batched.to_json_string().unwrap(), single.to_json_string().unwrap());
+}
+
+#[test]
+fn test_batch_can_be_reused_after_commit() {
+    let (timeline, mut v1) = sample_timeline(2);
+    let mut edit = v1.begin_edit().unwrap();
+    edit.slice_at_time(time(24.0), false).unwrap();
+    edit.commit().unwrap();
+    edit.slice_at_time(time(72.0), false).unwrap();
+    edit.commit().unwrap();
+    // An empty commit is a no-op
+    edit.commit().unwrap();
+    drop(edit);
+    assert_eq!(v1.children_count(), 4);
+    assert!(timeline.to_json_string().is_ok());
+}
+
+// ============================================================================
+// Rollback
+// ============================================================================
+
+#[test]
+fn test_failed_edit_rolls_back() {
+    let (timeline, mut v1) = sample_timeline(2);
+    let before = timeline.to_json_string().unwrap();
+
+    let mut edit = v1.begin_edit().unwrap();
+    edit.slice_at_time(time(24.0), false).unwrap();
+    edit.overwrite(Clip::new("fix", range(0.0, 10.0)), range(50.0, 10.0), false).unwrap();
+    for _ in 0..5 {
+        edit.remove_at_time(time(0.0), false).unwrap();
+    }
+    // The slice and overwrite leave five items, so the sixth remove fails
+    edit.remove_at_time(time(0.0), false).unwrap();
+    let err = edit.commit().unwrap_err();
+    assert!(err.message.contains("Edit 7"), "{}", err.message);
+    assert_eq!(edit.len(), 8);
+    drop(edit);
+
+    assert_eq!(timeline.to_json_string().unwrap(), before);
+    assert_eq!(v1.children_count(), 2);
+    assert_eq!(v1.trimmed_range().unwrap().duration.value, 96.0);
+}
+
+#[test]
+fn test_failed_time_ordered_edit_rolls_back() {
+    let (timeline, mut v1) = sample_timeline(4);
+    let before = timeline.to_json_string().unwrap();
+
+    let mut edit = v1.begin_edit().unwrap();
+    edit.overwrite(Clip::new("fix", range(0.0, 12.0)), range(0.0, 12.0), false).unwrap();
+    // The overwrite leaves five items, so the sixth remove fails
+    for _ in 0..6 {
+        edit.remove_at_time(time(0.0), false).unwrap();
+    }
+    let err = edit.commit().unwrap_err();
+    assert!(err.message.contains("Edit 6"), "{}", err.message);
+    // The queued clip is back as it was queued, so a retry fails the same way
+    let err = edit.commit().unwrap_err();
+    assert!(err.message.contains("Edit 6"), "{}", err.message);
+    drop(edit);
+
+    assert_eq!(timeline.to_json_string().unwrap(), before);
+    assert_eq!(v1.children_count(), 4);
+}
+
+// ============================================================================
+// Caches and change tracking
+// ============================================================================
+
+#[test]
+fn test_range_cache_sees_commit() {
+    let (timeline, mut v1) = sample_timeline(10);
+    let track = timeline.video_tracks().next().unwrap();
+    let cache = track.enable_range_cache().unwrap();
+    assert_eq!(v1.trimmed_range().unwrap().duration.value, 480.0);
+
+    let mut edit = v1.begin_edit().unwrap();
+    edit.insert_at_time(Clip::new("insert", range(0.0, 24.0)), time(48.0), false).unwrap();
+    edit.remove_at_time(time(0.0), false).unwrap();
+    edit.commit().unwrap();
+    drop(edit);
+
+    assert_eq!(v1.trimmed_range().unwrap().duration.value, 456.0);
+    let first = v1.range_of_child_at_index(0).unwrap();
+    assert_eq!((first.start_time.value, first.duration.value), (0.0, 24.0));
+    drop(cache);
+}
+
+#[test]
+fn test_change_tracking_records_commit() {
+    let (mut timeline, mut v1) = sample_timeline(6);
+    let mut replica = Timeline::from_json_string(&timeline.to_json_string().unwrap()).unwrap();
+    let changes = timeline.track_changes().unwrap();
+
+    conform_in_batch(&mut v1);
+    assert!(changes.has_changes());
+    replica.apply_patch(&changes.take_patch().unwrap()).unwrap();
+    assert_eq!(
+        replica.to_json_string().unwrap(),
+        changes.timeline().to_json_string().unwrap()
+    );
+}
@@ -0,0 +1,271 @@
+//! Tests for the undo journal.
+//!
+//! This file tests:
+//! - `Timeline::enable_undo()` and undo/redo of inserts, removals, metadata,
+//!   setters and the edit algorithms
+//! - Groups, applied patches as one step, and the depth limit
+//! - Redo history dropped by new edits, and errors
+//! - Timeline-level steps released while the timeline lives
+
+use otio_rs::{Clip, Gap, HasMetadata, RationalTime, Stack, TimeRange, Timeline, Track, UndoJournal};
+
+fn clip(name: &str) -> Clip {
+    Clip::new(
+        name,
+        TimeRange::new(RationalTime::new(0.0, 24.0), RationalTime::new(48.0, 24.0)),
+    )
+}
+
+/// V1 with `clips` shots of 48 frames
+fn sample_timeline(clips: usize) -> (Timeline, Track) {
+    let mut timeline = Timeline::new("Journaled");
+    let mut v1 = timeline.add_video_track("V1");
+    for i in 0..clips {
+        v1.append_clip(clip(&format!("shot_{i}"))).unwrap();
+    }
+    (timeline, v1)
+}
+
+fn json(timeline: &Timeline) -> String {
+    timeline.to_json_string().unwrap()
+}
+
+// ============================================================================
+// Structure
+// ============================================================================
+
+#[test]
+fn test_undo_and_redo_inserts_and_removals() {
+    let (mut timeline, mut v1) = sample_timeline(3);
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    v1.remove_child(1).unwrap();
+    v1.insert_clip(0, clip("opening")).unwrap();
+    v1.append_gap(Gap::new(RationalTime::new(12.0, 24.0))).unwrap();
+    let after = json(journal.timeline());
+    assert_eq!(journal.undo_count(), 3);
+
+    while journal.undo().unwrap() {}
+    assert_eq!(json(journal.timeline()), before);
+    assert_eq!(journal.redo_count(), 3);
+
+    while journal.redo().unwrap() {}
+    assert_eq!(json(journal.timeline()), after);
+}
+
+#[test]
+fn test_undo_clear_and_nested_stack() {
+    let (mut timeline, mut v1) = sample_timeline(4);
+    let mut nested = Stack::new("Nested");
+    nested.append_clip(clip("inner")).unwrap();
+    v1.append_stack(nested).unwrap();
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    v1.clear_children().unwrap();
+    let _a1 = journal.timeline_mut().add_audio_track("A1");
+    assert_eq!(v1.children_count(), 0);
+
+    assert!(journal.undo().unwrap());
+    assert!(journal.undo().unwrap());
+    assert_eq!(json(journal.timeline()), before);
+    assert!(!journal.undo().unwrap());
+}
+
+#[test]
+fn test_undo_edit_algorithms() {
+    let (mut timeline, mut v1) = sample_timeline(6);
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    v1.slice_at_time(RationalTime::new(60.0, 24.0), false).unwrap();
+    v1.overwrite(
+        clip("overwrite"),
+        TimeRange::new(RationalTime::new(12.0, 24.0), RationalTime::new(24.0, 24.0)),
+        false,
+    )
+    .unwrap();
+    v1.remove_at_time(RationalTime::new(0.0, 24.0), true).unwrap();
+    v1.insert_at_time(clip("inserted"), RationalTime::new(96.0, 24.0), false).unwrap();
+    let after = json(journal.timeline());
+
+    for _ in 0..4 {
+        assert!(journal.undo().unwrap());
+    }
+    assert_eq!(json(journal.timeline()), before);
+    for _ in 0..4 {
+        assert!(journal.redo().unwrap());
+    }
+    assert_eq!(json(journal.timeline()), after);
+}
+
+#[test]
+fn test_undo_track_edit_is_one_step() {
+    let (mut timeline, mut v1) = sample_timeline(4);
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    let mut edit = v1.begin_edit().unwrap();
+    edit.slice_at_time(RationalTime::new(30.0, 24.0), false).unwrap();
+    edit.remove_at_time(RationalTime::new(100.0, 24.0), true).unwrap();
+    edit.commit().unwrap();
+    drop(edit);
+
+    assert_eq!(journal.undo_count(), 1);
+    assert!(journal.undo().unwrap());
+    assert_eq!(json(journal.timeline()), before);
+}
+
+// ============================================================================
+// Attributes
+// ============================================================================
+
+#[test]
+fn test_undo_metadata_and_setters() {
+    let (mut timeline, _v1) = sample_timeline(2);
+    timeline.set_metadata("status", "draft");
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    let mut edit = journal.timeline_mut();
+    edit.set_metadata("status", "approved");
+    edit.set_global_start_time(RationalTime::new(86400.0, 24.0)).unwrap();
+    let mut shot = journal.timeline().find_clips().next().unwrap();
+    shot.set_metadata("vfx_id", "VFX-0010");
+    shot.set_metadata_i64("take", 3);
+    let shot_metadata = |journal: &UndoJournal, key: &str| {
+        journal.timeline().find_clips().next().unwrap().get_metadata(key)
+    };
+
+    assert!(journal.undo().unwrap());
+    assert_eq!(shot_metadata(&journal, "vfx_id").as_deref(), Some("VFX-0010"));
+    assert!(journal.undo().unwrap());
+    // A key that did not exist is removed again
+    assert!(shot_metadata(&journal, "vfx_id").is_none());
+    assert!(journal.undo().unwrap());
+    assert_eq!(journal.timeline().get_metadata("status").as_deref(), Some("approved"));
+    assert!(journal.undo().unwrap());
+    assert_eq!(json(journal.timeline()), before);
+    assert!(!journal.undo().unwrap());
+}
+
+// ============================================================================
+// Steps
+// ============================================================================
+
+#[test]
+fn test_group_is_one_step() {
+    let (mut timeline, mut v1) = sample_timeline(2);
+    let mut journal = timeline.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+
+    journal.group(|_| {
+        v1.append_clip(clip("a")).unwrap();
+        v1.append_clip(clip("b")).unwrap();
+        v1.set_metadata("locked", "yes");
+    });
+    assert_eq!(journal.undo_count(), 1);
+
+    // Undoing while a group is open is an error
+    journal.begin_group();
+    assert!(journal.undo().is_err());
+    journal.end_group();
+
+    assert!(journal.undo().unwrap());
+    assert_eq!(json(journal.timeline()), before);
+}
+
+#[test]
+fn test_patch_is_one_step() {
+    let (mut timeline, mut v1) = sample_timeline(3);
+    let mut replica = Timeline::from_json_string(&json(&timeline)).unwrap();
+    let patch = {
+        let changes = timeline.track_changes().unwrap();
+        v1.remove_child(0).unwrap();
+        v1.append_clip(clip("late")).unwrap();
+        changes.take_patch().unwrap()
+    };
+    let expected = json(&timeline);
+
+    let mut journal = replica.enable_undo(16).unwrap();
+    let before = json(journal.timeline());
+    journal.timeline_mut().apply_patch(&patch).unwrap();
+    assert_eq!(json(journal.timeline()), expected);
+    assert_eq!(journal.undo_count(), 1);
+    assert!(journal.undo().unwrap());
+    assert_eq!(json(journal.timeline()), before);
+}
+
+#[test]
+fn test_depth_limits_history() {
+    let (mut timeline, mut v1) = sample_timeline(0);
+    let mut journal = timeline.enable_undo(3).unwrap();
+    for i in 0..10 {
+        v1.append_clip(clip(&format!("shot_{i}"))).unwrap();
+    }
+    assert_eq!(journal.undo_count(), 3);
+    while journal.undo().unwrap() {}
+    assert_eq!(v1.children_count(), 7);
+}
+
+#[test]
+fn test_timeline_steps_released_before_the_timeline() {
+    let (mut timeline, _v1) = sample_timeline(2);
+    let mut replica = Timeline::from_json_string(&json(&timeline)).unwrap();
+    let patch = {
+        let mut changes = timeline.track_changes().unwrap();
+        changes.timeline_mut().set_metadata("status", "final");
+        changes.take_patch().unwrap()
+    };
+
+    {
+        let mut journal = replica.enable_undo(2).unwrap();
+        let mut edit = journal.timeline_mut();
+        edit.set_metadata("status", "approved");
+        edit.set_global_start_time(RationalTime::new(86400.0, 24.0)).unwrap();
+        // The third step evicts the first
+        edit.apply_patch(&patch).unwrap();
+        assert_eq!(journal.undo_count(), 2);
+
+        // A new edit discards the undone patch
+        assert!(journal.undo().unwrap());
+        journal.timeline_mut().set_metadata("status", "on hold");
+        assert_eq!(journal.redo_count(), 0);
+
+        journal.clear();
+        journal.timeline_mut().set_metadata("status", "reviewed");
+    }
+
+    // Releasing those records left the timeline alone
+    assert_eq!(replica.get_metadata("status").as_deref(), Some("reviewed"));
+    assert_eq!(replica.global_start_time(), Some(RationalTime::new(86400.0, 24.0)));
+}
+
+#[test]
+fn test_new_edit_clears_redo() {
+    let (mut timeline, mut v1) = sample_timeline(2);
+    let mut journal = timeline.enable_undo(16).unwrap();
+    v1.append_clip(clip("a")).unwrap();
+    assert!(journal.undo().unwrap());
+    assert_eq!(journal.redo_count(), 1);
+
+    v1.append_clip(clip("b")).unwrap();
+    assert_eq!(journal.redo_count(), 0);
+    assert!(!journal.redo().unwrap());
+}
+
+// ============================================================================
+// Errors
+// ============================================================================
+
+#[test]
+fn test_invalid_journals() {
+    let (mut timeline, _v1) = sample_timeline(1);
+    assert!(timeline.enable_undo(0).is_err());
+    // While the journal lives it borrows the timeline, so no second one
+    // can be enabled; a timeline gets a new journal once the old one is gone
+    let journal = timeline.enable_undo(4).unwrap();
+    drop(journal);
+    assert!(timeline.enable_undo(4).is_ok());
+}